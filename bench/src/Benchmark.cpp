@@ -0,0 +1,157 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#include "Benchmark.h"
+#include "Counters.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <pdcpp/core/FrameArena.h>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    std::chrono::nanoseconds runBatch(pdcpp::bench::Benchmark& benchmark, uint64_t iterations)
+    {
+        auto start = Clock::now();
+        for (uint64_t i = 0; i < iterations; ++i)
+        {
+            benchmark.run();
+            pdcpp::FrameArena::resetDefault();
+        }
+        return Clock::now() - start;
+    }
+
+    // Doubles as the warm up: grows the batch until it fills a sample.
+    uint64_t calibrate(pdcpp::bench::Benchmark& benchmark, std::chrono::nanoseconds sampleTime)
+    {
+        uint64_t iterations = 1;
+        while (true)
+        {
+            auto elapsed = runBatch(benchmark, iterations);
+            if (elapsed >= sampleTime || iterations >= (uint64_t(1) << 32))
+                { return iterations; }
+
+            auto scale = elapsed.count() > 0 ? 1.2 * double(sampleTime.count()) / double(elapsed.count()) : 10.0;
+            iterations = std::max(iterations + 1, uint64_t(double(iterations) * std::min(scale, 10.0)));
+        }
+    }
+
+    void writeString(std::ostream& os, const std::string& text)
+    {
+        os << '"';
+        for (auto c : text)
+        {
+            switch (c)
+            {
+                case '"': os << "\\\""; break;
+                case '\\': os << "\\\\"; break;
+                case '\n': os << "\\n"; break;
+                case '\t': os << "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20)
+                        { os << "\\u" << std::hex << std::setw(4) << std::setfill('0') << int(c) << std::dec; }
+                    else
+                        { os << c; }
+            }
+        }
+        os << '"';
+    }
+}
+
+pdcpp::bench::Benchmark::Benchmark(std::string name)
+    : m_Name(std::move(name))
+{}
+
+pdcpp::bench::Result pdcpp::bench::measure(Benchmark& benchmark, pdcpp::ApiTracer& tracer, const RunOptions& options)
+{
+    Result result;
+    result.name = benchmark.getName();
+
+    benchmark.prepare();
+    result.maxError = benchmark.measureError();
+    auto iterations = calibrate(benchmark, options.sampleTime);
+
+    std::vector<double> samples;
+    samples.reserve(static_cast<size_t>(options.nSamples));
+
+    tracer.reset();
+    setCounting(true);
+    for (int i = 0; i < options.nSamples; ++i)
+    {
+        auto elapsed = runBatch(benchmark, iterations);
+        samples.push_back(double(elapsed.count()) / double(iterations));
+    }
+    setCounting(false);
+
+    auto total = double(iterations) * options.nSamples;
+    auto& counted = counters();
+    result.iterations = iterations * static_cast<uint64_t>(options.nSamples);
+    result.allocationsPerOp = double(counted.allocations) / total;
+    result.bytesPerOp = double(counted.bytesAllocated) / total;
+    result.apiCallsPerOp = double(counted.apiCalls) / total;
+
+    for (auto& call : tracer.getStats())
+        { result.calls.push_back({call.name, double(call.calls) / total}); }
+    std::sort(result.calls.begin(), result.calls.end(), [](auto& a, auto& b) { return a.name < b.name; });
+
+    benchmark.release();
+
+    std::sort(samples.begin(), samples.end());
+    result.minNsPerOp = samples.front();
+    result.nsPerOp = samples[samples.size() / 2];
+    return result;
+}
+
+void pdcpp::bench::writeJson(std::ostream& os, const std::vector<Result>& results, const RunOptions& options)
+{
+    os << std::fixed << std::setprecision(3);
+    os << "{\n";
+    os << "  \"schema\": 1,\n";
+#ifdef NDEBUG
+    os << "  \"build\": \"release\",\n";
+#else
+    os << "  \"build\": \"debug\",\n";
+#endif
+    os << "  \"samples\": " << options.nSamples << ",\n";
+    os << "  \"sample_time_ns\": " << options.sampleTime.count() << ",\n";
+    os << "  \"benchmarks\": [";
+
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        auto& result = results[i];
+        os << (i == 0 ? "\n" : ",\n");
+        os << "    {\n";
+        os << "      \"name\": ";
+        writeString(os, result.name);
+        os << ",\n";
+        os << "      \"iterations\": " << result.iterations << ",\n";
+        os << "      \"ns_per_op\": " << result.nsPerOp << ",\n";
+        os << "      \"min_ns_per_op\": " << result.minNsPerOp << ",\n";
+        os << "      \"allocations_per_op\": " << result.allocationsPerOp << ",\n";
+        os << "      \"bytes_per_op\": " << result.bytesPerOp << ",\n";
+        os << "      \"api_calls_per_op\": " << result.apiCallsPerOp << ",\n";
+        if (result.maxError.has_value())
+            { os << "      \"max_error\": " << std::scientific << *result.maxError << std::fixed << ",\n"; }
+        os << "      \"api_calls\": {";
+        for (size_t c = 0; c < result.calls.size(); ++c)
+        {
+            os << (c == 0 ? "\n" : ",\n") << "        ";
+            writeString(os, result.calls[c].name);
+            os << ": " << result.calls[c].perOp;
+        }
+        os << (result.calls.empty() ? "}\n" : "\n      }\n");
+        os << "    }";
+    }
+
+    os << (results.empty() ? "]\n" : "\n  ]\n");
+    os << "}\n";
+}
@@ -0,0 +1,116 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+#include <pdcpp/core/ApiTracer.h>
+#include <pdcpp/core/util.h>
+
+namespace pdcpp::bench
+{
+    /**
+     * Base class of a single benchmark. `run` is the operation being measured
+     * and is called many times in a row, anything it needs should be built in
+     * `prepare`, which isn't measured. Each run is treated as a frame, and the
+     * default `FrameArena` is reset after it.
+     */
+    class Benchmark
+    {
+    public:
+        explicit Benchmark(std::string name);
+        virtual ~Benchmark() = default;
+
+        [[ nodiscard ]] const std::string& getName() const { return m_Name; }
+
+        /**
+         * Called once before measurement begins. The global API is available.
+         */
+        virtual void prepare() {};
+
+        /**
+         * Performs the operation being measured, once.
+         */
+        virtual void run() = 0;
+
+        /**
+         * Called once after measurement. Release anything built in `prepare`
+         * here, while the global API is still available.
+         */
+        virtual void release() {};
+
+        /**
+         * For benchmarks of approximations: called once after `prepare`, and
+         * returns the largest absolute error against an exact reference.
+         */
+        virtual std::optional<double> measureError() { return std::nullopt; }
+
+    private:
+        std::string m_Name;
+
+        PDCPP_DECLARE_NON_COPYABLE_NON_MOVABLE(Benchmark);
+    };
+
+    /**
+     * The measurements of a single benchmark. Times are the median and the
+     * fastest of the samples taken, everything else is averaged over every
+     * measured operation.
+     */
+    struct Result
+    {
+        struct Call
+        {
+            std::string name;
+            double perOp;
+        };
+
+        std::string name;
+        uint64_t iterations = 0;
+        double nsPerOp = 0.0;
+        double minNsPerOp = 0.0;
+        double allocationsPerOp = 0.0;
+        double bytesPerOp = 0.0;
+        double apiCallsPerOp = 0.0;
+        std::optional<double> maxError;
+        std::vector<Call> calls;
+    };
+
+    struct RunOptions
+    {
+        // The minimum time spent measuring each sample.
+        std::chrono::nanoseconds sampleTime = std::chrono::milliseconds(50);
+
+        // The number of samples taken, after a single warm up sample.
+        int nSamples = 5;
+    };
+
+    /**
+     * Measures a single benchmark, counting API calls through the tracer.
+     */
+    Result measure(Benchmark& benchmark, pdcpp::ApiTracer& tracer, const RunOptions& options);
+
+    /**
+     * Writes results as a JSON document.
+     */
+    void writeJson(std::ostream& os, const std::vector<Result>& results, const RunOptions& options);
+
+    /**
+     * Keeps the compiler from discarding a value which is computed but never
+     * read.
+     */
+    template <typename T>
+    inline void doNotOptimize(const T& value) { asm volatile("" : : "r,m"(value) : "memory"); }
+}
@@ -0,0 +1,721 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#include "Benchmarks.h"
+
+#include <array>
+#include <cmath>
+#include <numbers>
+#include <pdcpp/audio/Channel.h>
+#include <pdcpp/audio/SoundEffect.h>
+#include <pdcpp/components/FileList.h>
+#include <pdcpp/components/GridView.h>
+#include <pdcpp/components/LevelMeter.h>
+#include <pdcpp/components/TextComponent.h>
+#include <pdcpp/components/Viewport.h>
+#include <pdcpp/components/WaveformViewComponent.h>
+#include <pdcpp/core/AssetPack.h>
+#include <pdcpp/core/BufferedFileHandle.h>
+#include <pdcpp/core/Compression.h>
+#include <pdcpp/core/FastMath.h>
+#include <pdcpp/core/FileSystemCache.h>
+#include <pdcpp/core/GlobalPlaydateAPI.h>
+#include <pdcpp/core/Random.h>
+#include <pdcpp/core/SparseMap.h>
+#include <pdcpp/graphics/Font.h>
+#include <pdcpp/graphics/Graphics.h>
+#include <pdcpp/graphics/LookAndFeel.h>
+#include <pdcpp/graphics/Sprite.h>
+#include <pdcpp/host/AssetPacker.h>
+
+namespace
+{
+    const std::string k_Paragraph = "The Playdate is a handheld video game console with a crank, a black and white "
+        "screen, and a surprisingly large number of games for something which fits in a pocket. This paragraph is "
+        "long enough to wrap across several lines at most widths.";
+
+    std::vector<int16_t> makeSine(int nSamples, float cyclesPerSample)
+    {
+        std::vector<int16_t> samples(static_cast<size_t>(nSamples));
+        for (int i = 0; i < nSamples; ++i)
+        {
+            auto phase = 2.0f * std::numbers::pi_v<float> * cyclesPerSample * float(i);
+            samples[static_cast<size_t>(i)] = static_cast<int16_t>(std::sin(phase) * 0.8f * INT16_MAX);
+        }
+        return samples;
+    }
+
+    class SpriteGetCenter
+        : public pdcpp::bench::Benchmark
+    {
+    public:
+        SpriteGetCenter() : Benchmark("sprite_get_center") {}
+
+        void prepare() override
+        {
+            p_Sprite = std::make_unique<pdcpp::Sprite>();
+            p_Sprite->setBounds({100, 60, 32, 24});
+        }
+
+        void run() override { pdcpp::bench::doNotOptimize(p_Sprite->getCenter()); }
+
+        void release() override { p_Sprite.reset(); }
+
+    private:
+        std::unique_ptr<pdcpp::Sprite> p_Sprite;
+    };
+
+    class SpriteMoveByWithCollisions
+        : public pdcpp::bench::Benchmark
+    {
+    public:
+        SpriteMoveByWithCollisions() : Benchmark("sprite_move_by_with_collisions") {}
+
+        void prepare() override
+        {
+            p_Mover = makeSprite({100, 100, 16, 16});
+
+            // A ring of obstacles, the first of which the mover always overlaps.
+            for (int i = 0; i < k_NumObstacles; ++i)
+            {
+                auto angle = 2.0f * std::numbers::pi_v<float> * float(i) / k_NumObstacles;
+                auto radius = i == 0 ? 4.0f : 60.0f;
+                m_Obstacles.push_back(makeSprite({100 + radius * std::cos(angle), 100 + radius * std::sin(angle), 16, 16}));
+            }
+        }
+
+        void run() override
+        {
+            m_Direction = -m_Direction;
+            pdcpp::bench::doNotOptimize(p_Mover->moveByWithCollisions(m_Direction, 0.0f));
+        }
+
+        void release() override
+        {
+            m_Obstacles.clear();
+            p_Mover.reset();
+        }
+
+    private:
+        static std::unique_ptr<pdcpp::Sprite> makeSprite(const pdcpp::Rectangle<float>& bounds)
+        {
+            auto sprite = std::make_unique<pdcpp::Sprite>();
+            sprite->setBounds(bounds);
+            sprite->setCollideRect({0, 0, bounds.width, bounds.height});
+            sprite->addSprite();
+            return sprite;
+        }
+
+        static constexpr int k_NumObstacles = 16;
+        std::unique_ptr<pdcpp::Sprite> p_Mover;
+        std::vector<std::unique_ptr<pdcpp::Sprite>> m_Obstacles;
+        float m_Direction = 2.0f;
+    };
+
+    class FontWrapText
+        : public pdcpp::bench::Benchmark
+    {
+    public:
+        FontWrapText() : Benchmark("font_wrap_text") {}
+
+        void prepare() override { p_Font = std::make_unique<pdcpp::Font>("/System/Fonts/Asheville-Sans-14-Bold.pft"); }
+
+        void run() override { pdcpp::bench::doNotOptimize(p_Font->wrapText(k_Paragraph, 200)); }
+
+        void release() override { p_Font.reset(); }
+
+    private:
+        std::unique_ptr<pdcpp::Font> p_Font;
+    };
+
+    class LookAndFeelDrawTextComponent
+        : public pdcpp::bench::Benchmark
+    {
+    public:
+        LookAndFeelDrawTextComponent() : Benchmark("look_and_feel_draw_text_component") {}
+
+        void prepare() override
+        {
+            p_Text = std::make_unique<pdcpp::TextComponent>("The quick brown fox jumps over the lazy dog");
+            p_Text->setBounds({20, 20, 200, 40});
+        }
+
+        void run() override { pdcpp::LookAndFeel::getDefaultLookAndFeel()->drawTextComponent(*p_Text); }
+
+        void release() override { p_Text.reset(); }
+
+    private:
+        std::unique_ptr<pdcpp::TextComponent> p_Text;
+    };
+
+    class ViewportDraw
+        : public pdcpp::bench::Benchmark
+    {
+    public:
+        ViewportDraw() : Benchmark("viewport_draw") {}
+
+        void prepare() override
+        {
+            p_Viewport = std::make_unique<pdcpp::Viewport>(&m_Content);
+            m_Content.setBounds({0, 0, 200, 200});
+            p_Viewport->setBounds({50, 20, 120, 120});
+            p_Viewport->setViewPosition(40, 40);
+        }
+
+        void run() override { p_Viewport->redraw(); }
+
+        void release() override { p_Viewport.reset(); }
+
+    private:
+        class Checkerboard
+            : public pdcpp::Component
+        {
+        protected:
+            void draw() override
+            {
+                auto bounds = getBounds().toInt();
+                for (int y = 0; y < bounds.height; y += 20)
+                {
+                    for (int x = (y / 20) % 2 * 20; x < bounds.width; x += 40)
+                        { pdcpp::Graphics::fillRectangle({bounds.x + x, bounds.y + y, 20, 20}); }
+                }
+            }
+        };
+
+        Checkerboard m_Content;
+        std::unique_ptr<pdcpp::Viewport> p_Viewport;
+    };
+
+    class GridViewRefreshContent
+        : public pdcpp::bench::Benchmark
+    {
+    public:
+        GridViewRefreshContent() : Benchmark("grid_view_refresh_content") {}
+
+        void prepare() override
+        {
+            p_Grid = std::make_unique<Grid>();
+            p_Grid->setBounds({0, 0, 400, 240});
+        }
+
+        void run() override { p_Grid->refreshContent(); }
+
+        void release() override { p_Grid.reset(); }
+
+    private:
+        class Grid
+            : public pdcpp::GridView
+        {
+        public:
+            [[ nodiscard ]] int getNumRows() const override { return 8; }
+            [[ nodiscard ]] int getNumCols() const override { return 4; }
+            [[ nodiscard ]] int getRowHeight(int) const override { return 30; }
+            [[ nodiscard ]] int getColWidth(int) const override { return 100; }
+
+        protected:
+            pdcpp::Component* refreshComponentForCell(int row, int column, bool, pdcpp::Component* toUpdate) override
+            {
+                if (toUpdate != nullptr)
+                    { return toUpdate; }
+                return new pdcpp::TextComponent(std::to_string(row) + ", " + std::to_string(column));
+            }
+        };
+
+        std::unique_ptr<Grid> p_Grid;
+    };
+
+    class WaveformViewSetData
+        : public pdcpp::bench::Benchmark
+    {
+    public:
+        WaveformViewSetData() : Benchmark("waveform_view_set_data") {}
+
+        void prepare() override
+        {
+            m_Samples = makeSine(4096, 0.01f);
+            m_Waveform.setBounds({0, 80, 400, 80});
+        }
+
+        void run() override { m_Waveform.setData(m_Samples); }
+
+    private:
+        std::vector<int16_t> m_Samples;
+        pdcpp::WaveformViewComponent m_Waveform;
+    };
+
+    class LevelMeterUpdate
+        : public pdcpp::bench::Benchmark
+    {
+    public:
+        LevelMeterUpdate() : Benchmark("level_meter_update") {}
+
+        void prepare() override
+        {
+            m_Samples = makeSine(256, 0.02f);
+            p_Meter = std::make_unique<pdcpp::LevelMeter>(30);
+        }
+
+        void run() override { p_Meter->update(m_Samples.data(), static_cast<int>(m_Samples.size())); }
+
+        void release() override { p_Meter.reset(); }
+
+    private:
+        std::vector<int16_t> m_Samples;
+        std::unique_ptr<pdcpp::LevelMeter> p_Meter;
+    };
+
+    class CustomSoundEffectProcessBlock
+        : public pdcpp::bench::Benchmark
+    {
+    public:
+        explicit CustomSoundEffectProcessBlock(pdcpp::HostPlaydateAPI& host)
+            : Benchmark("custom_sound_effect_process_block")
+            , r_Host(host)
+        {}
+
+        void prepare() override
+        {
+            p_Effect = std::make_unique<Gain>();
+            p_Channel = std::make_unique<pdcpp::Channel>();
+            p_Channel->addEffect(*p_Effect);
+
+            // Adding a channel twice is harmless, so make sure it's mixed.
+            pdcpp::GlobalPlaydateAPI::get()->sound->addChannel(p_Channel->get());
+        }
+
+        // One op is one block of the sound engine, of which the effect is the
+        // only thing doing any work.
+        void run() override { r_Host.renderAudio(m_Left.data(), m_Right.data(), k_BlockSize); }
+
+        void release() override
+        {
+            p_Channel.reset();
+            p_Effect.reset();
+        }
+
+    private:
+        class Gain
+            : public pdcpp::CustomSoundEffect
+        {
+        public:
+            bool processBlock(int32_t* left, int32_t* right, int nSamples, bool) override
+            {
+                for (int i = 0; i < nSamples; ++i)
+                {
+                    left[i] /= 2;
+                    right[i] /= 2;
+                }
+                return true;
+            }
+        };
+
+        static constexpr int k_BlockSize = 256;
+        pdcpp::HostPlaydateAPI& r_Host;
+        std::unique_ptr<Gain> p_Effect;
+        std::unique_ptr<pdcpp::Channel> p_Channel;
+        std::array<int16_t, k_BlockSize> m_Left {};
+        std::array<int16_t, k_BlockSize> m_Right {};
+    };
+
+    class SparseMapIntersect
+        : public pdcpp::bench::Benchmark
+    {
+    public:
+        SparseMapIntersect() : Benchmark("sparse_map_intersect") {}
+
+        void prepare() override
+        {
+            // Scattered IDs, with every other one moving and every third one
+            // visible, like the entities of a busy scene.
+            for (uint32_t i = 0; i < k_NEntities; ++i)
+            {
+                auto id = i * 37;
+                if (i % 2 == 0)
+                    { m_Velocities.insert(id, {1.0f, 0.5f}); }
+                if (i % 3 == 0)
+                    { m_Positions.insert(id, {float(i), float(i)}); }
+            }
+        }
+
+        void run() override
+        {
+            pdcpp::intersect([](uint32_t, pdcpp::Point<float>& p, const pdcpp::Point<float>& v) { p = p + v; },
+                             m_Positions, m_Velocities);
+            pdcpp::bench::doNotOptimize(m_Positions.values().front());
+        }
+
+        void release() override
+        {
+            m_Positions.clear();
+            m_Velocities.clear();
+        }
+
+    private:
+        static constexpr uint32_t k_NEntities = 2048;
+        pdcpp::SparseMap<uint32_t, pdcpp::Point<float>> m_Positions;
+        pdcpp::SparseMap<uint32_t, pdcpp::Point<float>> m_Velocities;
+    };
+
+    class RandomFillFloats
+        : public pdcpp::bench::Benchmark
+    {
+    public:
+        RandomFillFloats() : Benchmark("random_fill_floats") {}
+
+        void run() override
+        {
+            // A burst of particle velocities.
+            m_Random.fill(m_Values, -1.0f, 1.0f);
+            pdcpp::bench::doNotOptimize(m_Values.back());
+        }
+
+    private:
+        pdcpp::Random m_Random {1234};
+        std::array<float, 256> m_Values {};
+    };
+
+    /**
+     * Parses a save-game-like file of small records, a field at a time, either
+     * with a read per field or through a `BufferedFileHandle`.
+     */
+    template <bool Buffered>
+    class FileParseFields
+        : public pdcpp::bench::Benchmark
+    {
+    public:
+        FileParseFields() : Benchmark(Buffered ? "file_parse_fields_buffered" : "file_parse_fields_unbuffered") {}
+
+        void prepare() override
+        {
+            pdcpp::BufferedFileHandle file(k_Path, kFileWrite);
+            for (uint32_t i = 0; i < k_NRecords; ++i)
+            {
+                file.writeLE(uint16_t(i));
+                file.writeLE(float(i) * 0.25f);
+            }
+        }
+
+        void run() override
+        {
+            float total = 0.0f;
+            if constexpr (Buffered)
+            {
+                pdcpp::BufferedFileHandle file(k_Path, kFileReadData);
+                for (uint32_t i = 0; i < k_NRecords; ++i)
+                {
+                    total += float(file.readLE<uint16_t>());
+                    total += file.readLE<float>();
+                }
+            }
+            else
+            {
+                pdcpp::FileHandle file(k_Path, kFileReadData);
+                for (uint32_t i = 0; i < k_NRecords; ++i)
+                {
+                    uint16_t id;
+                    float value;
+                    file.read(&id, sizeof(id));
+                    file.read(&value, sizeof(value));
+                    total += float(id) + value;
+                }
+            }
+            pdcpp::bench::doNotOptimize(total);
+        }
+
+    private:
+        static constexpr uint32_t k_NRecords = 1024;
+        static constexpr const char* k_Path = "bench_records.bin";
+    };
+
+    /**
+     * Opens and reads a batch of small assets, either as loose files or as
+     * entries in an `AssetPack`, which is how a game's startup spends its time
+     * on the card.
+     */
+    template <bool Packed>
+    class AssetOpenMany
+        : public pdcpp::bench::Benchmark
+    {
+    public:
+        explicit AssetOpenMany(pdcpp::HostPlaydateAPI& host)
+            : Benchmark(Packed ? "asset_open_many_packed" : "asset_open_many_loose")
+            , r_Host(host)
+        {}
+
+        void prepare() override
+        {
+            pdcpp::GlobalPlaydateAPI::get()->file->mkdir(k_Directory);
+            pdcpp::host::AssetPacker packer;
+            for (uint32_t i = 0; i < k_NAssets; ++i)
+            {
+                std::vector<uint8_t> data(64 + i, uint8_t(i));
+                pdcpp::FileHandle file(getPath(i), kFileWrite);
+                file.write(data.data(), static_cast<unsigned int>(data.size()));
+                packer.addData(std::move(data), getPath(i));
+            }
+            packer.write(r_Host.getDataDirectory() / k_PackPath);
+            if constexpr (Packed)
+                { p_Pack = std::make_unique<pdcpp::AssetPack>(k_PackPath); }
+        }
+
+        // One op is opening every asset and reading its first bytes. The pack
+        // itself is opened once, in `prepare`, as a game would at startup.
+        void run() override
+        {
+            uint32_t total = 0;
+            uint8_t bytes[16];
+            for (uint32_t i = 0; i < k_NAssets; ++i)
+            {
+                if constexpr (Packed)
+                {
+                    auto file = p_Pack->open(getPath(i));
+                    total += uint32_t(file->read(bytes, sizeof(bytes)));
+                }
+                else
+                {
+                    pdcpp::FileHandle file(getPath(i), kFileReadData);
+                    total += uint32_t(file.read(bytes, sizeof(bytes)));
+                }
+            }
+            pdcpp::bench::doNotOptimize(total);
+        }
+
+        void release() override { p_Pack.reset(); }
+
+    private:
+        static std::string getPath(uint32_t i)
+            { return std::string(k_Directory) + "/" + std::to_string(i) + ".bin"; }
+
+        static constexpr uint32_t k_NAssets = 128;
+        static constexpr const char* k_Directory = "bench_assets";
+        static constexpr const char* k_PackPath = "bench_assets.pdap";
+
+        pdcpp::HostPlaydateAPI& r_Host;
+        std::unique_ptr<pdcpp::AssetPack> p_Pack;
+    };
+
+    /**
+     * Builds a `FileList` of a directory of a few hundred saves, as a file
+     * browser does each time it opens, with the directory already cached or
+     * not.
+     */
+    template <bool Cached>
+    class FileListDirectory
+        : public pdcpp::bench::Benchmark
+    {
+    public:
+        FileListDirectory() : Benchmark(Cached ? "file_list_directory_cached" : "file_list_directory_uncached") {}
+
+        void prepare() override
+        {
+            pdcpp::FileHelpers::mkdir(k_Directory);
+            for (int i = 0; i < k_NFiles; ++i)
+                { pdcpp::FileHandle file(std::string(k_Directory) + "save" + std::to_string(i) + ".sav", kFileWrite); }
+        }
+
+        void run() override
+        {
+            if constexpr (!Cached)
+                { pdcpp::FileSystemCache::getDefault().clear(); }
+
+            pdcpp::FileList list(k_Directory, false, false, false);
+            pdcpp::bench::doNotOptimize(list.getNumFiles());
+        }
+
+    private:
+        static constexpr int k_NFiles = 300;
+        static constexpr const char* k_Directory = "bench_saves/";
+    };
+
+    /**
+     * Compresses or decompresses a block of level-like data, to weigh the CPU
+     * spent against the bytes saved on a load.
+     */
+    template <bool Decompress>
+    class CompressionBlock
+        : public pdcpp::bench::Benchmark
+    {
+    public:
+        CompressionBlock() : Benchmark(Decompress ? "compression_decompress_block" : "compression_compress_block") {}
+
+        void prepare() override
+        {
+            // Runs of a few tile values, with the odd one out.
+            pdcpp::Random random {99};
+            m_Raw.resize(pdcpp::Compression::k_DefaultBlockSize);
+            for (size_t i = 0; i < m_Raw.size(); ++i)
+                { m_Raw[i] = uint8_t(random.nextInt(16) == 0 ? random.nextInt(256) : (i / 12) % 6); }
+
+            m_Compressed.resize(pdcpp::Compression::getCompressedBound(m_Raw.size()));
+            m_Compressed.resize(m_Compressor.compressBlock(m_Raw.data(), m_Raw.size(),
+                                                           m_Compressed.data(), m_Compressed.size()));
+            m_Output.resize(pdcpp::Compression::getCompressedBound(m_Raw.size()));
+        }
+
+        void run() override
+        {
+            if constexpr (Decompress)
+            {
+                pdcpp::bench::doNotOptimize(pdcpp::Compression::decompressBlock(m_Compressed.data(), m_Compressed.size(),
+                                                                                m_Output.data(), m_Raw.size()));
+            }
+            else
+            {
+                pdcpp::bench::doNotOptimize(m_Compressor.compressBlock(m_Raw.data(), m_Raw.size(),
+                                                                       m_Output.data(), m_Output.size()));
+            }
+        }
+
+    private:
+        pdcpp::Compression::Compressor m_Compressor;
+        std::vector<uint8_t> m_Raw;
+        std::vector<uint8_t> m_Compressed;
+        std::vector<uint8_t> m_Output;
+    };
+
+    /**
+     * Times a math function over a batch of random inputs, and measures its
+     * error against a double-precision reference over many more, so an
+     * approximation and libm can be compared on both.
+     */
+    template <typename Function, typename Reference>
+    class MathFunction
+        : public pdcpp::bench::Benchmark
+    {
+    public:
+        MathFunction(std::string name, float minInput, float maxInput, Function function, Reference reference)
+            : Benchmark(std::move(name))
+            , m_MinInput(minInput)
+            , m_MaxInput(maxInput)
+            , m_Function(function)
+            , m_Reference(reference)
+        {}
+
+        void prepare() override
+        {
+            m_Random.fill(m_XInputs, m_MinInput, m_MaxInput);
+            m_Random.fill(m_YInputs, m_MinInput, m_MaxInput);
+        }
+
+        void run() override
+        {
+            auto sum = 0.0f;
+            for (size_t i = 0; i < k_BatchSize; ++i)
+                { sum += m_Function(m_XInputs[i], m_YInputs[i]); }
+            pdcpp::bench::doNotOptimize(sum);
+        }
+
+        std::optional<double> measureError() override
+        {
+            auto maxError = 0.0;
+            for (int i = 0; i < k_NErrorSamples; ++i)
+            {
+                auto x = m_Random.nextFloatInRange(m_MinInput, m_MaxInput);
+                auto y = m_Random.nextFloatInRange(m_MinInput, m_MaxInput);
+                auto error = std::abs(double(m_Function(x, y)) - m_Reference(double(x), double(y)));
+                maxError = std::max(maxError, error);
+            }
+            return maxError;
+        }
+
+    private:
+        static constexpr size_t k_BatchSize = 256;
+        static constexpr int k_NErrorSamples = 100000;
+
+        float m_MinInput;
+        float m_MaxInput;
+        Function m_Function;
+        Reference m_Reference;
+        pdcpp::Random m_Random {1234};
+        std::array<float, k_BatchSize> m_XInputs {};
+        std::array<float, k_BatchSize> m_YInputs {};
+    };
+
+    template <typename Function, typename Reference>
+    std::unique_ptr<pdcpp::bench::Benchmark> makeMathFunction(std::string name, float minInput, float maxInput,
+                                                             Function function, Reference reference)
+    {
+        return std::make_unique<MathFunction<Function, Reference>>(std::move(name), minInput, maxInput,
+                                                                   function, reference);
+    }
+
+    void addMathFunctions(std::vector<std::unique_ptr<pdcpp::bench::Benchmark>>& benchmarks)
+    {
+        using pdcpp::Fixed16;
+        namespace FastMath = pdcpp::FastMath;
+        constexpr auto k_TwoPi = 2.0f * std::numbers::pi_v<float>;
+
+        auto sin = [](double x, double) { return std::sin(x); };
+        benchmarks.push_back(makeMathFunction("math_sin_libm", -k_TwoPi, k_TwoPi,
+                                              [](float x, float) { return std::sin(x); }, sin));
+        benchmarks.push_back(makeMathFunction("math_sin_table", -k_TwoPi, k_TwoPi,
+                                              [](float x, float) { return FastMath::sin(x); }, sin));
+        benchmarks.push_back(makeMathFunction("math_sin_table_8bit", -k_TwoPi, k_TwoPi,
+                                              [](float x, float) { return FastMath::sin<8>(x); }, sin));
+
+        // The fixed-point versions are measured against their own input, as
+        // converting it to fixed point rounds it.
+        auto fixedSin = [](double x, double) { return std::sin(double(Fixed16(x))); };
+        benchmarks.push_back(makeMathFunction("math_sin_fixed_poly", -k_TwoPi, k_TwoPi,
+                                              [](float x, float) { return float(pdcpp::sin(Fixed16(x))); }, fixedSin));
+        benchmarks.push_back(makeMathFunction("math_sin_fixed_table", -k_TwoPi, k_TwoPi,
+                                              [](float x, float) { return float(FastMath::sin(Fixed16(x))); }, fixedSin));
+
+        auto atan2 = [](double x, double y) { return std::atan2(y, x); };
+        benchmarks.push_back(makeMathFunction("math_atan2_libm", -100.0f, 100.0f,
+                                              [](float x, float y) { return std::atan2(y, x); }, atan2));
+        benchmarks.push_back(makeMathFunction("math_atan2_table", -100.0f, 100.0f,
+                                              [](float x, float y) { return FastMath::atan2(y, x); }, atan2));
+
+        auto invSqrt = [](double x, double) { return 1.0 / std::sqrt(x); };
+        benchmarks.push_back(makeMathFunction("math_inv_sqrt_libm", 0.5f, 1000.0f,
+                                              [](float x, float) { return 1.0f / std::sqrt(x); }, invSqrt));
+        benchmarks.push_back(makeMathFunction("math_inv_sqrt_fast", 0.5f, 1000.0f,
+                                              [](float x, float) { return FastMath::invSqrt(x); }, invSqrt));
+        benchmarks.push_back(makeMathFunction("math_inv_sqrt_fast_2_iterations", 0.5f, 1000.0f,
+                                              [](float x, float) { return FastMath::invSqrt<2>(x); }, invSqrt));
+
+        // Point::rotated, as the ring menu and rotary slider use it.
+        auto rotate = [](double angle, double) { return 100.0 * std::cos(angle) + 50.0; };
+        benchmarks.push_back(makeMathFunction("math_rotate_point_libm", -k_TwoPi, k_TwoPi,
+            [](float angle, float) { return pdcpp::Point<float>(150.0f, 50.0f).rotated({50.0f, 50.0f}, angle).x; },
+            rotate));
+        benchmarks.push_back(makeMathFunction("math_rotate_point_table", -k_TwoPi, k_TwoPi,
+            [](float angle, float)
+                { return pdcpp::Point<float>(150.0f, 50.0f).rotated({50.0f, 50.0f}, angle, FastMath::useTables).x; },
+            rotate));
+    }
+}
+
+std::vector<std::unique_ptr<pdcpp::bench::Benchmark>> pdcpp::bench::createBenchmarks(pdcpp::HostPlaydateAPI& host)
+{
+    std::vector<std::unique_ptr<Benchmark>> benchmarks;
+    benchmarks.push_back(std::make_unique<SpriteGetCenter>());
+    benchmarks.push_back(std::make_unique<SpriteMoveByWithCollisions>());
+    benchmarks.push_back(std::make_unique<FontWrapText>());
+    benchmarks.push_back(std::make_unique<LookAndFeelDrawTextComponent>());
+    benchmarks.push_back(std::make_unique<ViewportDraw>());
+    benchmarks.push_back(std::make_unique<GridViewRefreshContent>());
+    benchmarks.push_back(std::make_unique<WaveformViewSetData>());
+    benchmarks.push_back(std::make_unique<LevelMeterUpdate>());
+    benchmarks.push_back(std::make_unique<CustomSoundEffectProcessBlock>(host));
+    benchmarks.push_back(std::make_unique<SparseMapIntersect>());
+    benchmarks.push_back(std::make_unique<RandomFillFloats>());
+    benchmarks.push_back(std::make_unique<FileParseFields<false>>());
+    benchmarks.push_back(std::make_unique<FileParseFields<true>>());
+    benchmarks.push_back(std::make_unique<AssetOpenMany<false>>(host));
+    benchmarks.push_back(std::make_unique<AssetOpenMany<true>>(host));
+    benchmarks.push_back(std::make_unique<FileListDirectory<false>>());
+    benchmarks.push_back(std::make_unique<FileListDirectory<true>>());
+    benchmarks.push_back(std::make_unique<CompressionBlock<false>>());
+    benchmarks.push_back(std::make_unique<CompressionBlock<true>>());
+    addMathFunctions(benchmarks);
+    return benchmarks;
+}
@@ -0,0 +1,24 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <pdcpp/host/HostPlaydateAPI.h>
+#include "Benchmark.h"
+
+namespace pdcpp::bench
+{
+    /**
+     * @returns every benchmark in the suite, in the order they should run.
+     */
+    std::vector<std::unique_ptr<Benchmark>> createBenchmarks(pdcpp::HostPlaydateAPI& host);
+}
@@ -0,0 +1,91 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#include "Counters.h"
+
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    pdcpp::bench::Counters g_Counters;
+    bool g_Counting = false;
+    int g_BackendDepth = 0;
+    void* (*g_BackendRealloc)(void*, size_t) = nullptr;
+
+    void* allocate(size_t size)
+    {
+        pdcpp::bench::noteAllocation(size);
+        if (auto ptr = std::malloc(size == 0 ? 1 : size))
+            { return ptr; }
+        throw std::bad_alloc();
+    }
+}
+
+pdcpp::bench::Counters& pdcpp::bench::counters() { return g_Counters; }
+
+void pdcpp::bench::setCounting(bool shouldCount)
+{
+    if (shouldCount)
+        { g_Counters = {}; }
+    g_Counting = shouldCount;
+}
+
+void pdcpp::bench::noteAllocation(size_t size)
+{
+    if (!g_Counting || g_BackendDepth > 0)
+        { return; }
+
+    ++g_Counters.allocations;
+    g_Counters.bytesAllocated += size;
+}
+
+void pdcpp::bench::enterBackend()
+{
+    if (g_Counting)
+        { ++g_Counters.apiCalls; }
+    ++g_BackendDepth;
+}
+
+void pdcpp::bench::exitBackend() { --g_BackendDepth; }
+
+pdcpp::bench::ReallocCountingAPI::ReallocCountingAPI(PlaydateAPI* backend)
+    : m_Api(*backend)
+    , m_System(*backend->system)
+{
+    g_BackendRealloc = backend->system->realloc;
+    m_System.realloc = [](void* ptr, size_t size)
+    {
+        // Called from within the tracer's hooks, so the depth check in
+        // `noteAllocation` doesn't apply.
+        if (g_Counting && size > 0)
+        {
+            ++g_Counters.allocations;
+            g_Counters.bytesAllocated += size;
+        }
+        return g_BackendRealloc(ptr, size);
+    };
+    m_Api.system = &m_System;
+}
+
+// Replacing the global allocation functions is the only way to see the heap
+// traffic of the standard containers the wrappers use.
+void* operator new(size_t size) { return allocate(size); }
+void* operator new[](size_t size) { return allocate(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+    { try { return allocate(size); } catch (const std::bad_alloc&) { return nullptr; } }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+    { try { return allocate(size); } catch (const std::bad_alloc&) { return nullptr; } }
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
@@ -0,0 +1,74 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#pragma once
+
+#include <pd_api.h>
+#include <cstddef>
+#include <cstdint>
+#include <pdcpp/core/util.h>
+
+namespace pdcpp::bench
+{
+    /**
+     * Running totals for everything the benchmarks report per operation
+     * besides time. The totals only move while counting is enabled.
+     */
+    struct Counters
+    {
+        uint64_t allocations = 0;
+        uint64_t bytesAllocated = 0;
+        uint64_t apiCalls = 0;
+    };
+
+    /**
+     * @returns the live counters.
+     */
+    Counters& counters();
+
+    /**
+     * Enables or disables counting, and clears the counters when enabling.
+     */
+    void setCounting(bool shouldCount);
+
+    /**
+     * Records an allocation of `size` bytes, as long as counting is enabled
+     * and the backend isn't running.
+     */
+    void noteAllocation(size_t size);
+
+    /**
+     * `enterBackend` and `exitBackend` mark the start and end of a call into
+     * the backend, and are installed as the `ApiTracer`'s call hooks. Allocations made by the host backend are
+     * not counted, as on the device they'd come from the firmware and not from
+     * the game's heap.
+     */
+    void enterBackend();
+    void exitBackend();
+
+    /**
+     * A copy of a PlaydateAPI whose `system->realloc` counts what it
+     * allocates: realloc is a call into the backend, but the memory it hands
+     * out belongs to the caller.
+     */
+    class ReallocCountingAPI
+    {
+    public:
+        explicit ReallocCountingAPI(PlaydateAPI* backend);
+
+        [[ nodiscard ]] PlaydateAPI* get() { return &m_Api; }
+
+    private:
+        PlaydateAPI m_Api {};
+        playdate_sys m_System {};
+
+        PDCPP_DECLARE_NON_COPYABLE_NON_MOVABLE(ReallocCountingAPI);
+    };
+}
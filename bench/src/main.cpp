@@ -0,0 +1,127 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <pdcpp/core/GlobalPlaydateAPI.h>
+#include <pdcpp/graphics/LookAndFeel.h>
+#include <pdcpp/host/HostPlaydateAPI.h>
+#include <pdcpp/core/ApiTracer.h>
+#include "Benchmarks.h"
+#include "Counters.h"
+
+namespace
+{
+    void printUsage()
+    {
+        std::fprintf(stderr,
+            "usage: pdcpp_bench [options]\n"
+            "  --filter <text>    only run benchmarks whose name contains <text>\n"
+            "  --out <file>       write the JSON results to <file> instead of stdout\n"
+            "  --samples <n>      number of measured samples per benchmark (default 5)\n"
+            "  --sample-ms <n>    minimum length of each sample in milliseconds (default 50)\n"
+            "  --list             print the benchmark names and exit\n");
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::string filter;
+    std::string outPath;
+    auto list = false;
+    pdcpp::bench::RunOptions options;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        auto hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--filter") == 0 && hasValue)
+            { filter = argv[++i]; }
+        else if (std::strcmp(argv[i], "--out") == 0 && hasValue)
+            { outPath = argv[++i]; }
+        else if (std::strcmp(argv[i], "--samples") == 0 && hasValue)
+            { options.nSamples = std::max(1, std::atoi(argv[++i])); }
+        else if (std::strcmp(argv[i], "--sample-ms") == 0 && hasValue)
+            { options.sampleTime = std::chrono::milliseconds(std::max(1, std::atoi(argv[++i]))); }
+        else if (std::strcmp(argv[i], "--list") == 0)
+            { list = true; }
+        else
+        {
+            printUsage();
+            return 2;
+        }
+    }
+
+    // A manual clock keeps anything time-based identical from run to run.
+    pdcpp::HostPlaydateAPI::Options hostOptions;
+    hostOptions.clockMode = pdcpp::HostPlaydateAPI::ClockMode::Manual;
+    pdcpp::HostPlaydateAPI host(hostOptions);
+
+    // Only calls are counted, timing them would add to every measurement.
+    pdcpp::bench::ReallocCountingAPI api(host.get());
+    pdcpp::GlobalPlaydateAPI::initialize(api.get(), true);
+    auto& tracer = *pdcpp::GlobalPlaydateAPI::getTracer();
+    tracer.setTimingEnabled(false);
+    tracer.setCallHooks(pdcpp::bench::enterBackend, pdcpp::bench::exitBackend);
+
+    std::vector<pdcpp::bench::Result> results;
+    {
+        auto benchmarks = pdcpp::bench::createBenchmarks(host);
+        for (auto& benchmark : benchmarks)
+        {
+            if (!filter.empty() && benchmark->getName().find(filter) == std::string::npos)
+                { continue; }
+
+            if (list)
+            {
+                std::printf("%s\n", benchmark->getName().c_str());
+                continue;
+            }
+
+            auto result = pdcpp::bench::measure(*benchmark, tracer, options);
+            std::fprintf(stderr, "%-36s %12.1f ns/op %8.2f allocs/op %8.2f api calls/op", result.name.c_str(),
+                         result.nsPerOp, result.allocationsPerOp, result.apiCallsPerOp);
+            if (result.maxError.has_value())
+                { std::fprintf(stderr, " %10.2e max error", *result.maxError); }
+            std::fprintf(stderr, "\n");
+            results.push_back(std::move(result));
+        }
+    }
+
+    pdcpp::LookAndFeel::setDefaultLookAndFeel(nullptr);
+    pdcpp::GlobalPlaydateAPI::destroyInstance();
+
+    if (list)
+        { return 0; }
+
+    if (host.getErrorCount() > 0)
+        { std::fprintf(stderr, "warning: the backend reported %d errors, the last: %s\n", host.getErrorCount(),
+                       host.getLastError().c_str()); }
+
+    if (outPath.empty())
+    {
+        pdcpp::bench::writeJson(std::cout, results, options);
+        return 0;
+    }
+
+    std::ofstream out(outPath);
+    pdcpp::bench::writeJson(out, results, options);
+    if (!out)
+    {
+        std::fprintf(stderr, "couldn't write %s\n", outPath.c_str());
+        return 1;
+    }
+    return 0;
+}
@@ -11,7 +11,9 @@
 
 #include <pd_api.h>
 #include <pdcpp/pdnewlib.h>
+#include <pdcpp/core/FrameArena.h>
 #include <pdcpp/core/GlobalPlaydateAPI.h>
+#include <pdcpp/core/Log.h>
 #include "App.h"
 
 std::unique_ptr<App> game;
@@ -19,7 +21,10 @@ std::unique_ptr<App> game;
 
 static int update(void* userdata)
 {
-    return game->update();
+    auto rv = game->update();
+    pdcpp::Log::getDefault().flush();
+    pdcpp::FrameArena::resetDefault();
+    return rv;
 };
 
 #ifdef __cplusplus
@@ -0,0 +1,97 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace pdcpp::host
+{
+    /**
+     * Builds the packs read by `pdcpp::AssetPack`, for a game's build to run
+     * over its assets before they're compiled into the bundle.
+     *
+     * Files are added under the path the game will ask for them by, and are
+     * read from disk when the pack is written. Each one's data starts on a
+     * multiple of the alignment, so entries holding arrays of numbers can be
+     * read straight into place.
+     *
+     * @code
+     * pdcpp::host::AssetPacker packer;
+     * packer.addDirectory("assets/levels", "levels");
+     * packer.addFile("assets/credits.txt", "credits.txt");
+     * if (!packer.write("Source/assets.pdap"))
+     *     { std::cerr << packer.getLastError() << std::endl; }
+     * @endcode
+     */
+    class AssetPacker
+    {
+    public:
+        /**
+         * @param alignment the byte alignment of each entry's data.
+         */
+        explicit AssetPacker(uint32_t alignment=4);
+
+        /**
+         * Adds a file from disk. Adding a second file under the same path
+         * replaces the first.
+         *
+         * @param source the file to read when the pack is written
+         * @param packPath the path the game will open it by
+         */
+        void addFile(const std::filesystem::path& source, const std::string& packPath);
+
+        /**
+         * Adds bytes from memory.
+         *
+         * @param data the entry's contents
+         * @param packPath the path the game will open it by
+         */
+        void addData(std::vector<uint8_t> data, const std::string& packPath);
+
+        /**
+         * Adds every file below a directory, under their paths relative to it,
+         * with forward slashes.
+         *
+         * @param directory the directory to add
+         * @param packPrefix a directory to put them in, in the pack
+         * @return the number of files added
+         */
+        size_t addDirectory(const std::filesystem::path& directory, const std::string& packPrefix={});
+
+        /**
+         * Writes the pack.
+         *
+         * @param destination the file to write
+         * @return false on failure, with the reason in `getLastError`
+         */
+        bool write(const std::filesystem::path& destination);
+
+        [[ nodiscard ]] size_t getNumEntries() const { return m_Sources.size(); }
+        [[ nodiscard ]] const std::string& getLastError() const { return m_LastError; }
+
+    private:
+        struct Source
+        {
+            std::string packPath;
+            std::filesystem::path file;
+            std::vector<uint8_t> data;
+        };
+
+        void add(Source source);
+
+        uint32_t m_Alignment;
+        std::vector<Source> m_Sources;
+        std::string m_LastError;
+    };
+}
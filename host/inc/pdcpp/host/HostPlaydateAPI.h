@@ -0,0 +1,283 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#pragma once
+
+#include <pd_api.h>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <string>
+#include <pdcpp/core/util.h>
+
+namespace pdcpp
+{
+    namespace host { struct Context; }
+
+    /**
+     * A host-side implementation of the PlaydateAPI function tables, so code
+     * written against pdcpp can be compiled into a desktop executable and run
+     * without the device or the simulator. This is the backend for benchmarks,
+     * profiling runs, and sanitizer builds.
+     *
+     * The backend models the device closely enough for library code to behave
+     * the same way: a 1-bit 400x240 framebuffer, bitmaps, bitmap tables,
+     * fonts (rendered with a built-in bitmap face), sprites with collision
+     * responses, a file system rooted in a temporary directory, and a sound
+     * engine which is pulled a block at a time with `renderAudio`.
+     *
+     * Only one HostPlaydateAPI may exist at a time, as the C API carries no
+     * context pointer for most of its calls. Hand the instance to
+     * `pdcpp::GlobalPlaydateAPI::initialize` the same way the device's
+     * `eventHandler` would:
+     *
+     * @code
+     * pdcpp::HostPlaydateAPI host;
+     * eventHandler(host, kEventInit, 0);
+     * for (int i = 0; i < 100; i++)
+     *     { host.runFrame(); }
+     * eventHandler(host, kEventTerminate, 0);
+     * @endcode
+     *
+     * The backend is single threaded. The sound engine only runs when
+     * `renderAudio` is called, so callers driving audio from another thread
+     * are responsible for their own locking.
+     */
+    class HostPlaydateAPI
+    {
+    public:
+        /**
+         * The source of `getCurrentTimeMilliseconds` and `getElapsedTime`.
+         * RealTime follows a steady clock, Manual only moves when the host
+         * calls `advanceTime`, which makes runs repeatable.
+         */
+        enum class ClockMode
+        {
+            RealTime,
+            Manual
+        };
+
+        /**
+         * Construction options for the host backend.
+         */
+        struct Options
+        {
+            // The directory backing the game's Data folder. When left empty,
+            // a temporary directory is created, and removed on destruction.
+            std::filesystem::path dataDirectory;
+
+            // The directory standing in for the (read-only) game bundle. When
+            // left empty, only the data directory is visible.
+            std::filesystem::path bundleDirectory;
+
+            // The clock driving the system's time functions.
+            ClockMode clockMode = ClockMode::RealTime;
+
+            // Whether `logToConsole` output should be echoed to stdout.
+            bool echoLogs = true;
+        };
+
+        /**
+         * Creates the host backend with the default options: a temporary data
+         * directory and a real-time clock.
+         */
+        HostPlaydateAPI();
+
+        /**
+         * Creates the host backend and populates its API tables.
+         *
+         * @param options the directories and clock to use.
+         */
+        explicit HostPlaydateAPI(Options options);
+
+        /**
+         * Tears down the backend, freeing any API objects which are still
+         * alive and removing the temporary data directory, if one was created.
+         */
+        ~HostPlaydateAPI();
+
+        /**
+         * @returns the API pointer to hand to game code.
+         */
+        [[ nodiscard ]] PlaydateAPI* get() const;
+
+        /**
+         * Allows the host to be passed directly to anything expecting a
+         * PlaydateAPI pointer.
+         */
+        operator PlaydateAPI*() const; // NOLINT(*-explicit-constructor)
+
+        /**
+         * Runs a single frame: calls the registered update callback, presents
+         * the framebuffer if the callback asks for it, and clears the
+         * per-frame button state.
+         *
+         * @returns the update callback's return value, or 0 when no update
+         *     callback has been set.
+         */
+        int runFrame();
+
+        /**
+         * Runs several frames in a row.
+         *
+         * @param nFrames the number of frames to run.
+         */
+        void runFrames(int nFrames);
+
+        /**
+         * @returns the number of frames run since construction.
+         */
+        [[ nodiscard ]] uint64_t getFrameCount() const;
+
+        /**
+         * Moves the manual clock forward. Has no effect in RealTime mode.
+         *
+         * @param milliseconds the amount of time to move forward.
+         */
+        void advanceTime(uint32_t milliseconds);
+
+        /**
+         * Sets the full button state, as if the player had pressed and
+         * released buttons to reach it. Pushed and released flags are
+         * accumulated until the end of the next frame, and the button
+         * callback is notified of every change.
+         *
+         * @param buttons the set of buttons which are currently held.
+         */
+        void setButtonState(PDButtons buttons);
+
+        /**
+         * Presses the given buttons, leaving the others untouched.
+         *
+         * @param buttons the buttons to press.
+         */
+        void pressButtons(PDButtons buttons);
+
+        /**
+         * Releases the given buttons, leaving the others untouched.
+         *
+         * @param buttons the buttons to release.
+         */
+        void releaseButtons(PDButtons buttons);
+
+        /**
+         * Turns the crank to the given absolute angle, by the shortest path.
+         *
+         * @param degrees the new crank angle, 0 being straight up.
+         */
+        void setCrankAngle(float degrees);
+
+        /**
+         * Docks or undocks the crank.
+         *
+         * @param docked whether the crank is now stowed.
+         */
+        void setCrankDocked(bool docked);
+
+        /**
+         * Sets the values reported by the accelerometer.
+         */
+        void setAccelerometer(float x, float y, float z);
+
+        /**
+         * Simulates the player choosing an item in the system menu.
+         * Checkmark items are toggled and options items move to their next
+         * option before the item's callback is invoked.
+         *
+         * @param index the index of the item, in the order they were added.
+         * @returns true if an item existed at that index.
+         */
+        bool selectMenuItem(int index);
+
+        /**
+         * Delivers a message to the serial message callback, if one is set.
+         *
+         * @param message the message to deliver.
+         */
+        void sendSerialMessage(const std::string& message);
+
+        /**
+         * @returns the working framebuffer, LCD_ROWSIZE bytes per row.
+         */
+        [[ nodiscard ]] const uint8_t* getFrameBuffer() const;
+
+        /**
+         * @returns the framebuffer as it was last presented with `display`.
+         */
+        [[ nodiscard ]] const uint8_t* getDisplayBuffer() const;
+
+        /**
+         * Reads a single pixel of the working framebuffer.
+         *
+         * @returns kColorWhite or kColorBlack.
+         */
+        [[ nodiscard ]] LCDSolidColor getPixel(int x, int y) const;
+
+        /**
+         * Writes the last presented frame to disk as a binary PBM image.
+         *
+         * @param path the file to write.
+         * @returns true on success.
+         */
+        bool writeScreenshot(const std::filesystem::path& path) const;
+
+        /**
+         * Pulls audio out of the sound engine. Sequences are advanced, sources
+         * are mixed through their channels and effects, and the sound clock
+         * moves forward by `nFrames` samples.
+         *
+         * @param left the buffer to fill with the left channel.
+         * @param right the buffer to fill with the right channel.
+         * @param nFrames the number of frames to render.
+         */
+        void renderAudio(int16_t* left, int16_t* right, int nFrames);
+
+        /**
+         * Feeds samples to the microphone callback, if one is set.
+         *
+         * @param samples mono samples at 44.1kHz.
+         * @param length the number of samples.
+         */
+        void pushMicrophoneSamples(int16_t* samples, int length);
+
+        /**
+         * Sets a function to call whenever game code calls `system->error`.
+         * Errors are always written to stderr.
+         */
+        void setErrorHandler(std::function<void(const std::string&)> handler);
+
+        /**
+         * @returns the number of times `system->error` has been called.
+         */
+        [[ nodiscard ]] int getErrorCount() const;
+
+        /**
+         * @returns the text of the most recent `system->error` call.
+         */
+        [[ nodiscard ]] const std::string& getLastError() const;
+
+        /**
+         * @returns the directory backing the game's Data folder.
+         */
+        [[ nodiscard ]] const std::filesystem::path& getDataDirectory() const;
+
+        /**
+         * @returns the number of bitmaps which have been allocated through the
+         *     API and not yet freed. Handy for catching leaks.
+         */
+        [[ nodiscard ]] int getLiveBitmapCount() const;
+
+    private:
+        std::unique_ptr<host::Context> p_Context;
+
+        PDCPP_DECLARE_NON_COPYABLE_NON_MOVABLE(HostPlaydateAPI);
+    };
+}
@@ -0,0 +1,165 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#include <pdcpp/host/AssetPacker.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <pdcpp/core/AssetPack.h>
+
+namespace
+{
+    void appendU32(std::vector<uint8_t>& out, uint32_t value)
+    {
+        for (int shift = 0; shift < 32; shift += 8)
+            { out.push_back(uint8_t(value >> shift)); }
+    }
+
+    bool readFile(const std::filesystem::path& path, std::vector<uint8_t>& out)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+            { return false; }
+        out.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        return !file.bad();
+    }
+}
+
+pdcpp::host::AssetPacker::AssetPacker(uint32_t alignment)
+    : m_Alignment(std::max<uint32_t>(alignment, 1))
+{}
+
+void pdcpp::host::AssetPacker::addFile(const std::filesystem::path& source, const std::string& packPath)
+    { add({packPath, source, {}}); }
+
+void pdcpp::host::AssetPacker::addData(std::vector<uint8_t> data, const std::string& packPath)
+    { add({packPath, {}, std::move(data)}); }
+
+size_t pdcpp::host::AssetPacker::addDirectory(const std::filesystem::path& directory, const std::string& packPrefix)
+{
+    std::error_code error;
+    std::vector<std::filesystem::path> files;
+    for (auto it = std::filesystem::recursive_directory_iterator(directory, error);
+         !error && it != std::filesystem::recursive_directory_iterator(); it.increment(error))
+    {
+        if (it->is_regular_file())
+            { files.push_back(it->path()); }
+    }
+
+    // Directory order varies between file systems; the pack shouldn't.
+    std::sort(files.begin(), files.end());
+    for (auto& file : files)
+    {
+        auto packPath = file.lexically_relative(directory).generic_string();
+        if (!packPrefix.empty())
+            { packPath = packPrefix + (packPrefix.back() == '/' ? "" : "/") + packPath; }
+        addFile(file, packPath);
+    }
+    return files.size();
+}
+
+bool pdcpp::host::AssetPacker::write(const std::filesystem::path& destination)
+{
+    struct Prepared
+    {
+        const Source* source;
+        std::vector<uint8_t> fileData;
+        pdcpp::AssetPack::Entry entry;
+    };
+
+    std::vector<Prepared> prepared;
+    prepared.reserve(m_Sources.size());
+    std::vector<uint8_t> paths;
+    for (auto& source : m_Sources)
+    {
+        Prepared item {&source, {}, {}};
+        if (!source.file.empty() && !readFile(source.file, item.fileData))
+        {
+            m_LastError = "Couldn't read " + source.file.string();
+            return false;
+        }
+
+        item.entry.hash = pdcpp::AssetPack::hashPath(source.packPath);
+        item.entry.pathOffset = uint32_t(paths.size());
+        item.entry.pathLength = uint32_t(source.packPath.size());
+        paths.insert(paths.end(), source.packPath.begin(), source.packPath.end());
+        prepared.push_back(std::move(item));
+    }
+
+    std::sort(prepared.begin(), prepared.end(), [](const Prepared& a, const Prepared& b)
+    {
+        if (a.entry.hash != b.entry.hash)
+            { return a.entry.hash < b.entry.hash; }
+        return a.source->packPath < b.source->packPath;
+    });
+
+    auto align = [this](uint64_t offset) { return (offset + m_Alignment - 1) / m_Alignment * m_Alignment; };
+
+    uint64_t offset = pdcpp::AssetPack::k_HeaderSize
+        + uint64_t(prepared.size()) * pdcpp::AssetPack::k_EntrySize + paths.size();
+    for (auto& item : prepared)
+    {
+        auto& data = item.source->file.empty() ? item.source->data : item.fileData;
+        offset = align(offset);
+        item.entry.offset = uint32_t(offset);
+        item.entry.size = uint32_t(data.size());
+        offset += data.size();
+    }
+
+    if (offset > std::numeric_limits<uint32_t>::max())
+    {
+        m_LastError = "The pack would be larger than 4GB";
+        return false;
+    }
+
+    std::vector<uint8_t> out;
+    out.reserve(size_t(offset));
+    appendU32(out, pdcpp::AssetPack::k_Magic);
+    appendU32(out, pdcpp::AssetPack::k_Version);
+    appendU32(out, uint32_t(prepared.size()));
+    appendU32(out, uint32_t(paths.size()));
+    appendU32(out, m_Alignment);
+    for (auto& item : prepared)
+    {
+        appendU32(out, item.entry.hash);
+        appendU32(out, item.entry.pathOffset);
+        appendU32(out, item.entry.pathLength);
+        appendU32(out, item.entry.offset);
+        appendU32(out, item.entry.size);
+    }
+    out.insert(out.end(), paths.begin(), paths.end());
+    for (auto& item : prepared)
+    {
+        auto& data = item.source->file.empty() ? item.source->data : item.fileData;
+        out.resize(item.entry.offset, 0);
+        out.insert(out.end(), data.begin(), data.end());
+    }
+
+    std::ofstream file(destination, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(out.data()), std::streamsize(out.size()));
+    if (!file)
+    {
+        m_LastError = "Couldn't write " + destination.string();
+        return false;
+    }
+    return true;
+}
+
+void pdcpp::host::AssetPacker::add(Source source)
+{
+    auto existing = std::find_if(m_Sources.begin(), m_Sources.end(),
+                                 [&](const Source& s) { return s.packPath == source.packPath; });
+    if (existing != m_Sources.end())
+        { *existing = std::move(source); }
+    else
+        { m_Sources.push_back(std::move(source)); }
+}
@@ -0,0 +1,53 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#pragma once
+
+#include <pd_api.h>
+#include "HostFile.h"
+#include "HostGraphics.h"
+#include "HostSound.h"
+#include "HostSprite.h"
+#include "HostSystem.h"
+
+namespace pdcpp::host
+{
+    /**
+     * The function tables and state behind a HostPlaydateAPI. The C API has no
+     * context pointer, so the implementation reaches this through `context()`.
+     */
+    struct Context
+    {
+        PlaydateAPI api {};
+        playdate_sys systemAPI {};
+        playdate_file fileAPI {};
+        playdate_graphics graphicsAPI {};
+        playdate_video videoAPI {};
+        playdate_sprite spriteAPI {};
+        playdate_display displayAPI {};
+        SoundTables soundAPI;
+
+        // Declared in dependency order, so sound objects go before the
+        // sprites, sprites before the bitmaps they draw, and files last.
+        SystemState system;
+        FileState files;
+        GraphicsState graphics;
+        SpriteState sprites;
+        SoundState sound;
+
+        // The live context. Only one may exist at a time.
+        inline static Context* current = nullptr;
+    };
+
+    /**
+     * @returns the live context.
+     */
+    inline Context& context() { return *Context::current; }
+}
@@ -0,0 +1,463 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#include "HostContext.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+namespace
+{
+    using pdcpp::host::context;
+    using pdcpp::host::k_SampleRate;
+    using pdcpp::host::k_Unity;
+
+    constexpr float k_Pi = std::numbers::pi_v<float>;
+
+    auto& state() { return context().sound; }
+
+    float toFloat(int32_t value) { return static_cast<float>(value) / k_Unity; }
+    int32_t toFixed(float value) { return static_cast<int32_t>(std::clamp(value, -127.0f, 127.0f) * k_Unity); }
+
+    template <typename T>
+    void clearIf(T*& pointer, const pdcpp::host::SoundObject* dying)
+    {
+        if (pointer == dying)
+            { pointer = nullptr; }
+    }
+
+    //==========================================================================
+    // playdate->sound->effect
+    SoundEffect* newEffect(effectProc* proc, void* userdata)
+    {
+        auto effect = new SoundEffect;
+        effect->proc = proc;
+        effect->userdata = userdata;
+        return state().track(effect);
+    }
+
+    void freeEffect(SoundEffect* effect) { state().destroy(effect, "freeEffect"); }
+    void setMix(SoundEffect* effect, float level) { effect->mix = std::clamp(level, 0.0f, 1.0f); }
+    void setMixModulator(SoundEffect* effect, PDSynthSignalValue* signal) { effect->mixModulator = signal; }
+    PDSynthSignalValue* getMixModulator(SoundEffect* effect) { return effect->mixModulator; }
+    void setUserdata(SoundEffect* effect, void* userdata) { effect->userdata = userdata; }
+    void* getUserdata(SoundEffect* effect) { return effect->userdata; }
+
+    //==========================================================================
+    // playdate->sound->effect->twopolefilter
+    TwoPoleFilter* newTwoPoleFilter() { return state().track(new TwoPoleFilter); }
+    void freeTwoPoleFilter(TwoPoleFilter* filter) { state().destroy(filter, "freeFilter"); }
+    void setType(TwoPoleFilter* filter, TwoPoleFilterType type) { filter->type = type; }
+    void setFrequency(TwoPoleFilter* filter, float frequency) { filter->frequency = frequency; }
+    void twoPoleSetFrequencyModulator(TwoPoleFilter* filter, PDSynthSignalValue* signal) { filter->frequencyModulator = signal; }
+    PDSynthSignalValue* twoPoleGetFrequencyModulator(TwoPoleFilter* filter) { return filter->frequencyModulator; }
+    void setGain(TwoPoleFilter* filter, float gain) { filter->gain = gain; }
+    void setResonance(TwoPoleFilter* filter, float resonance) { filter->resonance = std::clamp(resonance, 0.0f, 1.0f); }
+    void setResonanceModulator(TwoPoleFilter* filter, PDSynthSignalValue* signal) { filter->resonanceModulator = signal; }
+    PDSynthSignalValue* getResonanceModulator(TwoPoleFilter* filter) { return filter->resonanceModulator; }
+
+    //==========================================================================
+    // playdate->sound->effect->onepolefilter
+    OnePoleFilter* newOnePoleFilter() { return state().track(new OnePoleFilter); }
+    void freeOnePoleFilter(OnePoleFilter* filter) { state().destroy(filter, "freeFilter"); }
+    void setParameter(OnePoleFilter* filter, float parameter) { filter->parameter = std::clamp(parameter, -1.0f, 1.0f); }
+    void setParameterModulator(OnePoleFilter* filter, PDSynthSignalValue* signal) { filter->parameterModulator = signal; }
+    PDSynthSignalValue* getParameterModulator(OnePoleFilter* filter) { return filter->parameterModulator; }
+
+    //==========================================================================
+    // playdate->sound->effect->bitcrusher
+    BitCrusher* newBitCrusher() { return state().track(new BitCrusher); }
+    void freeBitCrusher(BitCrusher* filter) { state().destroy(filter, "freeBitCrusher"); }
+    void setAmount(BitCrusher* filter, float amount) { filter->amount = std::clamp(amount, 0.0f, 1.0f); }
+    void setAmountModulator(BitCrusher* filter, PDSynthSignalValue* signal) { filter->amountModulator = signal; }
+    PDSynthSignalValue* getAmountModulator(BitCrusher* filter) { return filter->amountModulator; }
+    void setUndersampling(BitCrusher* filter, float amount) { filter->undersampling = std::clamp(amount, 0.0f, 1.0f); }
+    void setUndersampleModulator(BitCrusher* filter, PDSynthSignalValue* signal) { filter->undersampleModulator = signal; }
+    PDSynthSignalValue* getUndersampleModulator(BitCrusher* filter) { return filter->undersampleModulator; }
+
+    //==========================================================================
+    // playdate->sound->effect->ringmodulator
+    RingModulator* newRingmod() { return state().track(new RingModulator); }
+    void freeRingmod(RingModulator* filter) { state().destroy(filter, "freeRingmod"); }
+    void ringSetFrequency(RingModulator* filter, float frequency) { filter->frequency = frequency; }
+    void ringSetFrequencyModulator(RingModulator* filter, PDSynthSignalValue* signal) { filter->frequencyModulator = signal; }
+    PDSynthSignalValue* ringGetFrequencyModulator(RingModulator* filter) { return filter->frequencyModulator; }
+
+    //==========================================================================
+    // playdate->sound->effect->delayline
+    DelayLine* newDelayLine(int length, int stereo)
+    {
+        auto line = new DelayLine;
+        line->length = std::max(length, 1);
+        line->stereo = stereo != 0;
+        line->buffer.assign(static_cast<size_t>(line->length) * 2, 0);
+        return state().track(line);
+    }
+
+    void freeDelayLine(DelayLine* filter) { state().destroy(filter, "freeDelayLine"); }
+
+    void setLength(DelayLine* d, int frames)
+    {
+        d->length = std::max(frames, 1);
+        d->buffer.assign(static_cast<size_t>(d->length) * 2, 0);
+        d->writeIndex = 0;
+    }
+
+    void setFeedback(DelayLine* d, float fb) { d->feedback = fb; }
+
+    DelayLineTap* addTap(DelayLine* d, int delay)
+    {
+        auto tap = state().track(new DelayLineTap);
+        tap->line = d;
+        tap->delay = delay;
+        context().soundAPI.channel.addSource(state().defaultChannel, tap);
+        return tap;
+    }
+
+    void freeTap(DelayLineTap* tap) { state().destroy(tap, "freeTap"); }
+    void setTapDelay(DelayLineTap* t, int frames) { t->delay = frames; }
+    void setTapDelayModulator(DelayLineTap* t, PDSynthSignalValue* mod) { t->delayModulator = mod; }
+    PDSynthSignalValue* getTapDelayModulator(DelayLineTap* t) { return t->delayModulator; }
+    void setTapChannelsFlipped(DelayLineTap* t, int flip) { t->flipped = flip != 0; }
+
+    //==========================================================================
+    // playdate->sound->effect->overdrive
+    Overdrive* newOverdrive() { return state().track(new Overdrive); }
+    void freeOverdrive(Overdrive* filter) { state().destroy(filter, "freeOverdrive"); }
+    void overdriveSetGain(Overdrive* o, float gain) { o->gain = gain; }
+    void setLimit(Overdrive* o, float limit) { o->limit = limit; }
+    void setLimitModulator(Overdrive* o, PDSynthSignalValue* mod) { o->limitModulator = mod; }
+    PDSynthSignalValue* getLimitModulator(Overdrive* o) { return o->limitModulator; }
+    void overdriveSetOffset(Overdrive* o, float offset) { o->offset = offset; }
+    void setOffsetModulator(Overdrive* o, PDSynthSignalValue* mod) { o->offsetModulator = mod; }
+    PDSynthSignalValue* getOffsetModulator(Overdrive* o) { return o->offsetModulator; }
+}
+
+//==============================================================================
+void SoundEffect::process(int32_t* left, int32_t* right, int nFrames)
+{
+    if (proc != nullptr)
+        { proc(this, left, right, nFrames, 1); }
+}
+
+void SoundEffect::forget(pdcpp::host::SoundObject* dying)
+    { clearIf(mixModulator, dying); }
+
+//==============================================================================
+void TwoPoleFilter::process(int32_t* left, int32_t* right, int nFrames)
+{
+    // A modulator value of 1 moves the cutoff the full range of the spectrum.
+    auto f = std::clamp(frequency + modulation(frequencyModulator) * (k_SampleRate / 2.0f), 10.0f,
+                        k_SampleRate * 0.45f);
+    auto r = std::clamp(resonance + modulation(resonanceModulator), 0.0f, 1.0f);
+    auto q = 0.7071f / (1.0f - 0.99f * r);
+
+    // RBJ audio EQ cookbook biquads.
+    auto w0 = 2.0f * k_Pi * f / k_SampleRate;
+    auto cosw = std::cos(w0);
+    auto alpha = std::sin(w0) / (2.0f * q);
+    auto a = std::pow(10.0f, gain / 40.0f);
+
+    float b0, b1, b2, a0, a1, a2;
+    switch (type)
+    {
+        case kFilterTypeHighPass:
+            b0 = (1.0f + cosw) / 2.0f; b1 = -(1.0f + cosw); b2 = b0;
+            a0 = 1.0f + alpha; a1 = -2.0f * cosw; a2 = 1.0f - alpha;
+            break;
+        case kFilterTypeBandPass:
+            b0 = alpha; b1 = 0.0f; b2 = -alpha;
+            a0 = 1.0f + alpha; a1 = -2.0f * cosw; a2 = 1.0f - alpha;
+            break;
+        case kFilterTypeNotch:
+            b0 = 1.0f; b1 = -2.0f * cosw; b2 = 1.0f;
+            a0 = 1.0f + alpha; a1 = -2.0f * cosw; a2 = 1.0f - alpha;
+            break;
+        case kFilterTypePEQ:
+            b0 = 1.0f + alpha * a; b1 = -2.0f * cosw; b2 = 1.0f - alpha * a;
+            a0 = 1.0f + alpha / a; a1 = -2.0f * cosw; a2 = 1.0f - alpha / a;
+            break;
+        case kFilterTypeLowShelf:
+        case kFilterTypeHighShelf:
+        {
+            auto s = type == kFilterTypeLowShelf ? 1.0f : -1.0f;
+            auto beta = 2.0f * std::sqrt(a) * alpha;
+            b0 = a * ((a + 1.0f) - s * (a - 1.0f) * cosw + beta);
+            b1 = s * 2.0f * a * ((a - 1.0f) - s * (a + 1.0f) * cosw);
+            b2 = a * ((a + 1.0f) - s * (a - 1.0f) * cosw - beta);
+            a0 = (a + 1.0f) + s * (a - 1.0f) * cosw + beta;
+            a1 = -s * 2.0f * ((a - 1.0f) + s * (a + 1.0f) * cosw);
+            a2 = (a + 1.0f) + s * (a - 1.0f) * cosw - beta;
+            break;
+        }
+        case kFilterTypeLowPass:
+        default:
+            b0 = (1.0f - cosw) / 2.0f; b1 = 1.0f - cosw; b2 = b0;
+            a0 = 1.0f + alpha; a1 = -2.0f * cosw; a2 = 1.0f - alpha;
+            break;
+    }
+
+    b0 /= a0; b1 /= a0; b2 /= a0; a1 /= a0; a2 /= a0;
+
+    int32_t* buffers[2] = {left, right};
+    for (int c = 0; c < 2; ++c)
+    {
+        // x1, x2, y1, y2
+        auto& s = state[c];
+        for (int i = 0; i < nFrames; ++i)
+        {
+            auto x = toFloat(buffers[c][i]);
+            auto y = b0 * x + b1 * s[0] + b2 * s[1] - a1 * s[2] - a2 * s[3];
+            s[1] = s[0]; s[0] = x;
+            s[3] = s[2]; s[2] = y;
+            buffers[c][i] = toFixed(y);
+        }
+    }
+}
+
+void TwoPoleFilter::forget(pdcpp::host::SoundObject* dying)
+{
+    SoundEffect::forget(dying);
+    clearIf(frequencyModulator, dying);
+    clearIf(resonanceModulator, dying);
+}
+
+void OnePoleFilter::process(int32_t* left, int32_t* right, int nFrames)
+{
+    // Negative values close a low pass, positive ones open a high pass.
+    auto p = std::clamp(parameter + modulation(parameterModulator), -1.0f, 1.0f);
+
+    int32_t* buffers[2] = {left, right};
+    for (int c = 0; c < 2; ++c)
+    {
+        auto& y = state[c];
+        for (int i = 0; i < nFrames; ++i)
+        {
+            auto x = toFloat(buffers[c][i]);
+            if (p <= 0.0f)
+            {
+                y += (1.0f + p) * (x - y);
+                buffers[c][i] = toFixed(y);
+            }
+            else
+            {
+                y += p * (x - y);
+                buffers[c][i] = toFixed(x - y);
+            }
+        }
+    }
+}
+
+void OnePoleFilter::forget(pdcpp::host::SoundObject* dying)
+{
+    SoundEffect::forget(dying);
+    clearIf(parameterModulator, dying);
+}
+
+void BitCrusher::process(int32_t* left, int32_t* right, int nFrames)
+{
+    auto a = std::clamp(amount + modulation(amountModulator), 0.0f, 1.0f);
+    auto u = std::clamp(undersampling + modulation(undersampleModulator), 0.0f, 1.0f);
+
+    // Crush down from 16 bits towards 1, holding each sample for up to 32.
+    auto bits = std::max(1, 16 - static_cast<int>(a * 15.0f));
+    auto mask = ~((1 << (25 - bits)) - 1);
+    auto hold = 1 + static_cast<int>(u * 31.0f);
+
+    for (int i = 0; i < nFrames; ++i)
+    {
+        if (holdCounter <= 0)
+        {
+            held[0] = left[i] & mask;
+            held[1] = right[i] & mask;
+            holdCounter = hold;
+        }
+        --holdCounter;
+        left[i] = held[0];
+        right[i] = held[1];
+    }
+}
+
+void BitCrusher::forget(pdcpp::host::SoundObject* dying)
+{
+    SoundEffect::forget(dying);
+    clearIf(amountModulator, dying);
+    clearIf(undersampleModulator, dying);
+}
+
+void RingModulator::process(int32_t* left, int32_t* right, int nFrames)
+{
+    auto f = frequency * std::exp2(modulation(frequencyModulator));
+    auto increment = static_cast<double>(f) / k_SampleRate;
+    for (int i = 0; i < nFrames; ++i)
+    {
+        auto m = std::sin(2.0 * std::numbers::pi * phase);
+        left[i] = static_cast<int32_t>(left[i] * m);
+        right[i] = static_cast<int32_t>(right[i] * m);
+        phase += increment;
+        phase -= std::floor(phase);
+    }
+}
+
+void RingModulator::forget(pdcpp::host::SoundObject* dying)
+{
+    SoundEffect::forget(dying);
+    clearIf(frequencyModulator, dying);
+}
+
+void DelayLine::read(int delay, int32_t& left, int32_t& right) const
+{
+    auto index = ((writeIndex - delay) % length + length) % length;
+    left = buffer[static_cast<size_t>(index) * 2];
+    right = buffer[static_cast<size_t>(index) * 2 + 1];
+}
+
+void DelayLine::process(int32_t* left, int32_t* right, int nFrames)
+{
+    for (int i = 0; i < nFrames; ++i)
+    {
+        auto slot = static_cast<size_t>(writeIndex) * 2;
+        auto delayedL = buffer[slot];
+        auto delayedR = buffer[slot + 1];
+
+        auto inL = left[i];
+        auto inR = stereo ? right[i] : left[i];
+        buffer[slot] = toFixed(toFloat(inL) + toFloat(delayedL) * feedback);
+        buffer[slot + 1] = stereo ? toFixed(toFloat(inR) + toFloat(delayedR) * feedback) : buffer[slot];
+
+        left[i] = delayedL;
+        right[i] = delayedR;
+        writeIndex = (writeIndex + 1) % length;
+    }
+}
+
+void Overdrive::process(int32_t* left, int32_t* right, int nFrames)
+{
+    auto l = std::max(limit + modulation(limitModulator), 0.0f);
+    auto o = offset + modulation(offsetModulator);
+    for (int i = 0; i < nFrames; ++i)
+    {
+        left[i] = toFixed(std::clamp(toFloat(left[i]) * gain + o, -l, l));
+        right[i] = toFixed(std::clamp(toFloat(right[i]) * gain + o, -l, l));
+    }
+}
+
+void Overdrive::forget(pdcpp::host::SoundObject* dying)
+{
+    SoundEffect::forget(dying);
+    clearIf(limitModulator, dying);
+    clearIf(offsetModulator, dying);
+}
+
+//==============================================================================
+void DelayLineTap::render(int32_t* left, int32_t* right, int nFrames)
+{
+    if (line == nullptr)
+        { return; }
+
+    // Taps render before their line's channel runs its effects, so they can
+    // only see what the line wrote in earlier blocks.
+    auto d = delay + static_cast<int>(SoundEffect::modulation(delayModulator) * static_cast<float>(line->length));
+    d = std::clamp(d, nFrames, line->length);
+
+    for (int i = 0; i < nFrames; ++i)
+    {
+        int32_t l, r;
+        line->read(d - i, l, r);
+        if (flipped)
+            { std::swap(l, r); }
+        left[i] += static_cast<int32_t>(static_cast<float>(l) * leftVolume);
+        right[i] += static_cast<int32_t>(static_cast<float>(r) * rightVolume);
+    }
+}
+
+void DelayLineTap::forget(pdcpp::host::SoundObject* dying)
+{
+    clearIf(line, dying);
+    clearIf(delayModulator, dying);
+}
+
+void pdcpp::host::populateEffectAPI(SoundTables& tables)
+{
+    auto& twopole = tables.twopolefilter;
+    twopole.newFilter = newTwoPoleFilter;
+    twopole.freeFilter = freeTwoPoleFilter;
+    twopole.setType = setType;
+    twopole.setFrequency = setFrequency;
+    twopole.setFrequencyModulator = twoPoleSetFrequencyModulator;
+    twopole.getFrequencyModulator = twoPoleGetFrequencyModulator;
+    twopole.setGain = setGain;
+    twopole.setResonance = setResonance;
+    twopole.setResonanceModulator = setResonanceModulator;
+    twopole.getResonanceModulator = getResonanceModulator;
+
+    auto& onepole = tables.onepolefilter;
+    onepole.newFilter = newOnePoleFilter;
+    onepole.freeFilter = freeOnePoleFilter;
+    onepole.setParameter = setParameter;
+    onepole.setParameterModulator = setParameterModulator;
+    onepole.getParameterModulator = getParameterModulator;
+
+    auto& bitcrusher = tables.bitcrusher;
+    bitcrusher.newBitCrusher = newBitCrusher;
+    bitcrusher.freeBitCrusher = freeBitCrusher;
+    bitcrusher.setAmount = setAmount;
+    bitcrusher.setAmountModulator = setAmountModulator;
+    bitcrusher.getAmountModulator = getAmountModulator;
+    bitcrusher.setUndersampling = setUndersampling;
+    bitcrusher.setUndersampleModulator = setUndersampleModulator;
+    bitcrusher.getUndersampleModulator = getUndersampleModulator;
+
+    auto& ringmod = tables.ringmodulator;
+    ringmod.newRingmod = newRingmod;
+    ringmod.freeRingmod = freeRingmod;
+    ringmod.setFrequency = ringSetFrequency;
+    ringmod.setFrequencyModulator = ringSetFrequencyModulator;
+    ringmod.getFrequencyModulator = ringGetFrequencyModulator;
+
+    auto& delayline = tables.delayline;
+    delayline.newDelayLine = newDelayLine;
+    delayline.freeDelayLine = freeDelayLine;
+    delayline.setLength = setLength;
+    delayline.setFeedback = setFeedback;
+    delayline.addTap = addTap;
+    delayline.freeTap = freeTap;
+    delayline.setTapDelay = setTapDelay;
+    delayline.setTapDelayModulator = setTapDelayModulator;
+    delayline.getTapDelayModulator = getTapDelayModulator;
+    delayline.setTapChannelsFlipped = setTapChannelsFlipped;
+
+    auto& overdrive = tables.overdrive;
+    overdrive.newOverdrive = newOverdrive;
+    overdrive.freeOverdrive = freeOverdrive;
+    overdrive.setGain = overdriveSetGain;
+    overdrive.setLimit = setLimit;
+    overdrive.setLimitModulator = setLimitModulator;
+    overdrive.getLimitModulator = getLimitModulator;
+    overdrive.setOffset = overdriveSetOffset;
+    overdrive.setOffsetModulator = setOffsetModulator;
+    overdrive.getOffsetModulator = getOffsetModulator;
+
+    auto& effect = tables.effect;
+    effect.newEffect = newEffect;
+    effect.freeEffect = freeEffect;
+    effect.setMix = setMix;
+    effect.setMixModulator = setMixModulator;
+    effect.getMixModulator = getMixModulator;
+    effect.setUserdata = setUserdata;
+    effect.getUserdata = getUserdata;
+    effect.twopolefilter = &tables.twopolefilter;
+    effect.onepolefilter = &tables.onepolefilter;
+    effect.bitcrusher = &tables.bitcrusher;
+    effect.ringmodulator = &tables.ringmodulator;
+    effect.delayline = &tables.delayline;
+    effect.overdrive = &tables.overdrive;
+}
@@ -0,0 +1,242 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#include "HostContext.h"
+
+#include <chrono>
+#include <ctime>
+#include <set>
+
+namespace
+{
+    using pdcpp::host::context;
+    namespace fs = std::filesystem;
+
+    // Strips any leading slashes so game paths are always relative.
+    fs::path relativePath(const char* path)
+    {
+        while (*path == '/')
+            { path++; }
+        return fs::path(path);
+    }
+
+    int fail(const std::string& message)
+    {
+        context().files.lastError = message;
+        return -1;
+    }
+
+    const char* geterr() { return context().files.lastError.c_str(); }
+
+    int listfiles(const char* path, void (*callback)(const char* path, void* userdata), void* userdata, int showhidden)
+    {
+        auto& files = context().files;
+        auto relative = relativePath(path);
+        std::set<std::string> names;
+        bool found = false;
+
+        for (auto& root : {files.dataDirectory, files.bundleDirectory})
+        {
+            if (root.empty())
+                { continue; }
+
+            std::error_code ec;
+            auto dir = root / relative;
+            if (!fs::is_directory(dir, ec))
+                { continue; }
+
+            found = true;
+            for (auto& entry : fs::directory_iterator(dir, ec))
+            {
+                auto name = entry.path().filename().string();
+                if (!showhidden && name.starts_with("."))
+                    { continue; }
+                if (entry.is_directory(ec))
+                    { name += "/"; }
+                names.insert(name);
+            }
+        }
+
+        if (!found)
+            { return fail("No such directory: " + relative.string()); }
+
+        for (auto& name : names)
+            { callback(name.c_str(), userdata); }
+        return 0;
+    }
+
+    int stat(const char* path, FileStat* stat)
+    {
+        auto found = pdcpp::host::findReadablePath(path);
+        if (!found.has_value())
+            { return fail(std::string("No such file: ") + path); }
+
+        std::error_code ec;
+        auto isDir = fs::is_directory(*found, ec);
+        stat->isdir = isDir ? 1 : 0;
+        stat->size = isDir ? 0 : static_cast<unsigned int>(fs::file_size(*found, ec));
+
+        auto written = fs::last_write_time(*found, ec);
+        auto systemTime = std::chrono::file_clock::to_sys(written);
+        auto seconds = std::chrono::system_clock::to_time_t(systemTime);
+        std::tm utc {};
+        gmtime_r(&seconds, &utc);
+        stat->m_year = utc.tm_year + 1900;
+        stat->m_month = utc.tm_mon + 1;
+        stat->m_day = utc.tm_mday;
+        stat->m_hour = utc.tm_hour;
+        stat->m_minute = utc.tm_min;
+        stat->m_second = utc.tm_sec;
+        return 0;
+    }
+
+    int mkdir(const char* path)
+    {
+        std::error_code ec;
+        auto target = pdcpp::host::dataPath(path);
+        // Like the device, this doesn't create intermediate directories.
+        if (!fs::create_directory(target, ec) && !fs::is_directory(target))
+            { return fail("Could not create directory: " + ec.message()); }
+        return 0;
+    }
+
+    int unlink(const char* name, int recursive)
+    {
+        std::error_code ec;
+        auto target = pdcpp::host::dataPath(name);
+        if (!fs::exists(target, ec))
+            { return fail(std::string("No such file: ") + name); }
+
+        if (recursive != 0)
+            { fs::remove_all(target, ec); }
+        else
+            { fs::remove(target, ec); }
+
+        if (ec)
+            { return fail("Could not remove file: " + ec.message()); }
+        return 0;
+    }
+
+    int renameFile(const char* from, const char* to)
+    {
+        std::error_code ec;
+        fs::rename(pdcpp::host::dataPath(from), pdcpp::host::dataPath(to), ec);
+        if (ec)
+            { return fail("Could not rename file: " + ec.message()); }
+        return 0;
+    }
+
+    SDFile* open(const char* name, FileOptions mode)
+    {
+        std::FILE* file = nullptr;
+        if ((mode & (kFileWrite | kFileAppend)) != 0)
+        {
+            auto target = pdcpp::host::dataPath(name);
+            file = std::fopen(target.c_str(), (mode & kFileAppend) != 0 ? "ab" : "wb");
+        }
+        else
+        {
+            auto found = pdcpp::host::findReadablePath(name, mode);
+            if (found.has_value() && !fs::is_directory(*found))
+                { file = std::fopen(found->c_str(), "rb"); }
+        }
+
+        if (file == nullptr)
+        {
+            fail(std::string("Could not open file: ") + name);
+            return nullptr;
+        }
+
+        context().files.openFiles.insert(file);
+        return file;
+    }
+
+    std::FILE* asFile(SDFile* file) { return static_cast<std::FILE*>(file); }
+
+    int close(SDFile* file)
+    {
+        auto& files = context().files;
+        if (files.openFiles.erase(asFile(file)) == 0)
+            { return fail("Attempted to close a file which isn't open"); }
+        return std::fclose(asFile(file)) == 0 ? 0 : fail("Could not close file");
+    }
+
+    int read(SDFile* file, void* buf, unsigned int len)
+    {
+        auto n = std::fread(buf, 1, len, asFile(file));
+        if (n < len && std::ferror(asFile(file)))
+            { return fail("Read failed"); }
+        return static_cast<int>(n);
+    }
+
+    int write(SDFile* file, const void* buf, unsigned int len)
+    {
+        auto n = std::fwrite(buf, 1, len, asFile(file));
+        if (n < len)
+            { return fail("Write failed"); }
+        return static_cast<int>(n);
+    }
+
+    int flush(SDFile* file) { return std::fflush(asFile(file)) == 0 ? 0 : fail("Flush failed"); }
+
+    int tell(SDFile* file) { return static_cast<int>(std::ftell(asFile(file))); }
+
+    int seek(SDFile* file, int pos, int whence)
+        { return std::fseek(asFile(file), pos, whence) == 0 ? 0 : fail("Seek failed"); }
+}
+
+pdcpp::host::FileState::~FileState()
+{
+    for (auto file : openFiles)
+        { std::fclose(file); }
+
+    if (ownsDataDirectory)
+    {
+        std::error_code ec;
+        fs::remove_all(dataDirectory, ec);
+    }
+}
+
+void pdcpp::host::populateFileAPI(playdate_file& api)
+{
+    api.geterr = geterr;
+    api.listfiles = listfiles;
+    api.stat = stat;
+    api.mkdir = mkdir;
+    api.unlink = unlink;
+    api.rename = renameFile;
+    api.open = open;
+    api.close = close;
+    api.read = read;
+    api.write = write;
+    api.flush = flush;
+    api.tell = tell;
+    api.seek = seek;
+}
+
+std::optional<std::filesystem::path> pdcpp::host::findReadablePath(const char* path, int mode)
+{
+    auto& files = context().files;
+    auto relative = relativePath(path);
+    std::error_code ec;
+
+    if ((mode & kFileReadData) != 0 && fs::exists(files.dataDirectory / relative, ec))
+        { return files.dataDirectory / relative; }
+
+    // Without a bundle, the data directory stands in for it.
+    auto& bundle = files.bundleDirectory.empty() ? files.dataDirectory : files.bundleDirectory;
+    if ((mode & kFileRead) != 0 && fs::exists(bundle / relative, ec))
+        { return bundle / relative; }
+
+    return std::nullopt;
+}
+
+std::filesystem::path pdcpp::host::dataPath(const char* path)
+    { return context().files.dataDirectory / relativePath(path); }
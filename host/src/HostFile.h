@@ -0,0 +1,58 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#pragma once
+
+#include <pd_api.h>
+#include <cstdio>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <unordered_set>
+
+namespace pdcpp::host
+{
+    /**
+     * Everything behind `playdate->file`. Game paths are resolved against a
+     * data directory, which is writable, and a bundle directory, which isn't.
+     * When no bundle directory is given, the data directory doubles as one.
+     */
+    struct FileState
+    {
+        ~FileState();
+
+        std::filesystem::path dataDirectory;
+        std::filesystem::path bundleDirectory;
+        bool ownsDataDirectory = false;
+        std::string lastError;
+        std::unordered_set<std::FILE*> openFiles;
+    };
+
+    /**
+     * Fills in the `playdate->file` function table.
+     */
+    void populateFileAPI(playdate_file& api);
+
+    /**
+     * Finds the host file backing a game path for reading.
+     *
+     * @param path the path, as game code would pass it to the API.
+     * @param mode which of kFileRead and kFileReadData to search. When both
+     *     are set the data directory is searched before the bundle.
+     * @returns the host path of an existing file, or nothing.
+     */
+    std::optional<std::filesystem::path> findReadablePath(const char* path, int mode = kFileRead | kFileReadData);
+
+    /**
+     * @returns the host path a game path maps to in the data directory,
+     *     whether or not anything exists there.
+     */
+    std::filesystem::path dataPath(const char* path);
+}
@@ -0,0 +1,251 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#include "HostContext.h"
+
+#include <algorithm>
+#include <cctype>
+#include <string>
+
+namespace
+{
+    using pdcpp::host::context;
+
+    constexpr int k_GlyphColumns = 5;
+    constexpr int k_CellWidth = 6;
+    constexpr int k_CellHeight = 8;
+
+    // The classic 5x7 LCD face for printable ASCII. Each glyph is five
+    // columns, least significant bit at the top.
+    constexpr uint8_t k_Glyphs[][k_GlyphColumns] = {
+        {0x00, 0x00, 0x00, 0x00, 0x00}, {0x00, 0x00, 0x5f, 0x00, 0x00}, {0x00, 0x07, 0x00, 0x07, 0x00},
+        {0x14, 0x7f, 0x14, 0x7f, 0x14}, {0x24, 0x2a, 0x7f, 0x2a, 0x12}, {0x23, 0x13, 0x08, 0x64, 0x62},
+        {0x36, 0x49, 0x56, 0x20, 0x50}, {0x00, 0x05, 0x03, 0x00, 0x00}, {0x00, 0x1c, 0x22, 0x41, 0x00},
+        {0x00, 0x41, 0x22, 0x1c, 0x00}, {0x14, 0x08, 0x3e, 0x08, 0x14}, {0x08, 0x08, 0x3e, 0x08, 0x08},
+        {0x00, 0x50, 0x30, 0x00, 0x00}, {0x08, 0x08, 0x08, 0x08, 0x08}, {0x00, 0x60, 0x60, 0x00, 0x00},
+        {0x20, 0x10, 0x08, 0x04, 0x02}, {0x3e, 0x51, 0x49, 0x45, 0x3e}, {0x00, 0x42, 0x7f, 0x40, 0x00},
+        {0x42, 0x61, 0x51, 0x49, 0x46}, {0x21, 0x41, 0x45, 0x4b, 0x31}, {0x18, 0x14, 0x12, 0x7f, 0x10},
+        {0x27, 0x45, 0x45, 0x45, 0x39}, {0x3c, 0x4a, 0x49, 0x49, 0x30}, {0x01, 0x71, 0x09, 0x05, 0x03},
+        {0x36, 0x49, 0x49, 0x49, 0x36}, {0x06, 0x49, 0x49, 0x29, 0x1e}, {0x00, 0x36, 0x36, 0x00, 0x00},
+        {0x00, 0x56, 0x36, 0x00, 0x00}, {0x08, 0x14, 0x22, 0x41, 0x00}, {0x14, 0x14, 0x14, 0x14, 0x14},
+        {0x00, 0x41, 0x22, 0x14, 0x08}, {0x02, 0x01, 0x51, 0x09, 0x06}, {0x32, 0x49, 0x79, 0x41, 0x3e},
+        {0x7e, 0x11, 0x11, 0x11, 0x7e}, {0x7f, 0x49, 0x49, 0x49, 0x36}, {0x3e, 0x41, 0x41, 0x41, 0x22},
+        {0x7f, 0x41, 0x41, 0x22, 0x1c}, {0x7f, 0x49, 0x49, 0x49, 0x41}, {0x7f, 0x09, 0x09, 0x09, 0x01},
+        {0x3e, 0x41, 0x49, 0x49, 0x7a}, {0x7f, 0x08, 0x08, 0x08, 0x7f}, {0x00, 0x41, 0x7f, 0x41, 0x00},
+        {0x20, 0x40, 0x41, 0x3f, 0x01}, {0x7f, 0x08, 0x14, 0x22, 0x41}, {0x7f, 0x40, 0x40, 0x40, 0x40},
+        {0x7f, 0x02, 0x0c, 0x02, 0x7f}, {0x7f, 0x04, 0x08, 0x10, 0x7f}, {0x3e, 0x41, 0x41, 0x41, 0x3e},
+        {0x7f, 0x09, 0x09, 0x09, 0x06}, {0x3e, 0x41, 0x51, 0x21, 0x5e}, {0x7f, 0x09, 0x19, 0x29, 0x46},
+        {0x46, 0x49, 0x49, 0x49, 0x31}, {0x01, 0x01, 0x7f, 0x01, 0x01}, {0x3f, 0x40, 0x40, 0x40, 0x3f},
+        {0x1f, 0x20, 0x40, 0x20, 0x1f}, {0x3f, 0x40, 0x38, 0x40, 0x3f}, {0x63, 0x14, 0x08, 0x14, 0x63},
+        {0x07, 0x08, 0x70, 0x08, 0x07}, {0x61, 0x51, 0x49, 0x45, 0x43}, {0x00, 0x7f, 0x41, 0x41, 0x00},
+        {0x02, 0x04, 0x08, 0x10, 0x20}, {0x00, 0x41, 0x41, 0x7f, 0x00}, {0x04, 0x02, 0x01, 0x02, 0x04},
+        {0x40, 0x40, 0x40, 0x40, 0x40}, {0x00, 0x01, 0x02, 0x04, 0x00}, {0x20, 0x54, 0x54, 0x54, 0x78},
+        {0x7f, 0x48, 0x44, 0x44, 0x38}, {0x38, 0x44, 0x44, 0x44, 0x20}, {0x38, 0x44, 0x44, 0x48, 0x7f},
+        {0x38, 0x54, 0x54, 0x54, 0x18}, {0x08, 0x7e, 0x09, 0x01, 0x02}, {0x0c, 0x52, 0x52, 0x52, 0x3e},
+        {0x7f, 0x08, 0x04, 0x04, 0x78}, {0x00, 0x44, 0x7d, 0x40, 0x00}, {0x20, 0x40, 0x44, 0x3d, 0x00},
+        {0x7f, 0x10, 0x28, 0x44, 0x00}, {0x00, 0x41, 0x7f, 0x40, 0x00}, {0x7c, 0x04, 0x18, 0x04, 0x78},
+        {0x7c, 0x08, 0x04, 0x04, 0x78}, {0x38, 0x44, 0x44, 0x44, 0x38}, {0x7c, 0x14, 0x14, 0x14, 0x08},
+        {0x08, 0x14, 0x14, 0x18, 0x7c}, {0x7c, 0x08, 0x04, 0x04, 0x08}, {0x48, 0x54, 0x54, 0x54, 0x20},
+        {0x04, 0x3f, 0x44, 0x40, 0x20}, {0x3c, 0x40, 0x40, 0x20, 0x7c}, {0x1c, 0x20, 0x40, 0x20, 0x1c},
+        {0x3c, 0x40, 0x30, 0x40, 0x3c}, {0x44, 0x28, 0x10, 0x28, 0x44}, {0x0c, 0x50, 0x50, 0x50, 0x3c},
+        {0x44, 0x64, 0x54, 0x4c, 0x44}, {0x00, 0x08, 0x36, 0x41, 0x00}, {0x00, 0x00, 0x7f, 0x00, 0x00},
+        {0x00, 0x41, 0x36, 0x08, 0x00}, {0x08, 0x04, 0x08, 0x10, 0x08},
+    };
+
+    LCDFont* resolveFont(LCDFont* font)
+    {
+        if (font != nullptr)
+            { return font; }
+
+        auto& graphics = context().graphics;
+        auto current = graphics.current().font;
+        return current != nullptr ? current : &graphics.systemFont;
+    }
+
+    LCDFontGlyph* glyphFor(LCDFont* font, uint32_t c)
+    {
+        auto found = font->glyphs.find(c);
+        if (found != font->glyphs.end())
+            { return found->second.get(); }
+
+        // Anything outside printable ASCII shows up as a question mark.
+        auto index = (c >= 0x20 && c <= 0x7e) ? c - 0x20 : '?' - 0x20;
+        auto scale = font->scale;
+
+        auto glyph = std::make_unique<LCDFontGlyph>();
+        glyph->bitmap = LCDBitmap(k_CellWidth * scale, k_CellHeight * scale);
+        glyph->bitmap.addMask(false);
+        glyph->advance = k_CellWidth * scale;
+
+        for (int col = 0; col < k_GlyphColumns; col++)
+        {
+            for (int row = 0; row < k_CellHeight; row++)
+            {
+                if ((k_Glyphs[index][col] & (1 << row)) == 0)
+                    { continue; }
+
+                for (int sy = 0; sy < scale; sy++)
+                {
+                    for (int sx = 0; sx < scale; sx++)
+                        { glyph->bitmap.setOpaque(col * scale + sx, row * scale + sy, true); }
+                }
+            }
+        }
+
+        auto result = glyph.get();
+        font->glyphs.emplace(c, std::move(glyph));
+        return result;
+    }
+
+    // Decodes the next character of a string in the given encoding.
+    uint32_t nextCharacter(const uint8_t*& text, PDStringEncoding encoding)
+    {
+        if (encoding == k16BitLEEncoding)
+        {
+            uint32_t c = text[0] | (text[1] << 8);
+            text += 2;
+            return c;
+        }
+
+        uint32_t c = *text++;
+        if (encoding == kASCIIEncoding || c < 0x80)
+            { return c; }
+
+        int extra = (c >= 0xf0) ? 3 : (c >= 0xe0) ? 2 : (c >= 0xc0) ? 1 : 0;
+        c &= 0x3f >> extra;
+        for (int i = 0; i < extra && (*text & 0xc0) == 0x80; i++)
+            { c = (c << 6) | (*text++ & 0x3f); }
+        return c;
+    }
+
+    // Walks a string, calling `glyph(character, x, lineIndex)` for every
+    // visible character, and returns the width of the widest line.
+    template <typename GlyphFunction>
+    int layoutText(LCDFont* font, const void* text, size_t len, PDStringEncoding encoding, int tracking,
+                   GlyphFunction glyph)
+    {
+        auto p = static_cast<const uint8_t*>(text);
+        int x = 0, widest = 0, line = 0;
+        bool lineStarted = false;
+
+        for (size_t i = 0; i < len; i++)
+        {
+            auto c = nextCharacter(p, encoding);
+            if (c == 0)
+                { break; }
+
+            if (c == '\n')
+            {
+                widest = std::max(widest, x);
+                x = 0;
+                line++;
+                lineStarted = false;
+                continue;
+            }
+
+            if (lineStarted)
+                { x += tracking; }
+            glyph(c, x, line);
+            x += glyphFor(font, c)->advance;
+            lineStarted = true;
+        }
+        return std::max(widest, x);
+    }
+
+    int parseFontSize(const char* path)
+    {
+        std::string name(path);
+        int size = 0;
+        for (size_t i = 0; i < name.size(); i++)
+        {
+            if (std::isdigit(static_cast<unsigned char>(name[i])))
+            {
+                size = std::stoi(name.substr(i));
+                while (i + 1 < name.size() && std::isdigit(static_cast<unsigned char>(name[i + 1])))
+                    { i++; }
+            }
+        }
+        return size;
+    }
+
+    LCDFont* newFont(int scale)
+    {
+        auto font = new LCDFont;
+        font->scale = std::max(scale, 1);
+        font->page.font = font;
+        context().graphics.fonts.insert(font);
+        return font;
+    }
+
+    //==========================================================================
+    void setFont(LCDFont* font) { context().graphics.current().font = font; }
+    void setTextTracking(int tracking) { context().graphics.current().tracking = tracking; }
+    int getTextTracking() { return context().graphics.current().tracking; }
+    void setTextLeading(int lineHeightAdjustment) { context().graphics.current().leading = lineHeightAdjustment; }
+
+    int drawText(const void* text, size_t len, PDStringEncoding encoding, int x, int y)
+    {
+        auto& ctx = context();
+        auto& dc = ctx.graphics.current();
+        auto font = resolveFont(nullptr);
+        auto lineHeight = k_CellHeight * font->scale + dc.leading;
+
+        return layoutText(font, text, len, encoding, dc.tracking, [&](uint32_t c, int offset, int line)
+        {
+            auto glyph = glyphFor(font, c);
+            ctx.graphicsAPI.drawBitmap(&glyph->bitmap, x + offset, y + line * lineHeight, kBitmapUnflipped);
+        });
+    }
+
+    LCDFont* loadFont(const char* path, const char**)
+    {
+        // There's no .pft parser on the host, so every font is the built-in
+        // face, scaled to roughly the size given in the font's file name.
+        auto size = parseFontSize(path);
+        return newFont((size + k_CellHeight / 2) / k_CellHeight);
+    }
+
+    LCDFontPage* getFontPage(LCDFont* font, uint32_t) { return &resolveFont(font)->page; }
+
+    LCDFontGlyph* getPageGlyph(LCDFontPage* page, uint32_t c, LCDBitmap** bitmap, int* advance)
+    {
+        auto glyph = glyphFor(page->font, c);
+        if (bitmap != nullptr) { *bitmap = &glyph->bitmap; }
+        if (advance != nullptr) { *advance = glyph->advance; }
+        return glyph;
+    }
+
+    int getGlyphKerning(LCDFontGlyph*, uint32_t, uint32_t) { return 0; }
+
+    int getTextWidth(LCDFont* font, const void* text, size_t len, PDStringEncoding encoding, int tracking)
+        { return layoutText(resolveFont(font), text, len, encoding, tracking, [](uint32_t, int, int) {}); }
+
+    uint8_t getFontHeight(LCDFont* font) { return static_cast<uint8_t>(k_CellHeight * resolveFont(font)->scale); }
+
+    LCDFont* makeFontFromData(LCDFontData*, int) { return newFont(1); }
+}
+
+void pdcpp::host::populateFontAPI(playdate_graphics& api)
+{
+    context().graphics.systemFont.page.font = &context().graphics.systemFont;
+
+    api.setFont = setFont;
+    api.setTextTracking = setTextTracking;
+    api.getTextTracking = getTextTracking;
+    api.setTextLeading = setTextLeading;
+    api.drawText = drawText;
+    api.loadFont = loadFont;
+    api.getFontPage = getFontPage;
+    api.getPageGlyph = getPageGlyph;
+    api.getGlyphKerning = getGlyphKerning;
+    api.getTextWidth = getTextWidth;
+    api.getFontHeight = getFontHeight;
+    api.makeFontFromData = makeFontFromData;
+}
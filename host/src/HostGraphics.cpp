@@ -0,0 +1,1208 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#include "HostContext.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+namespace
+{
+    using pdcpp::host::context;
+    using pdcpp::host::DrawingContext;
+    namespace fs = std::filesystem;
+
+    constexpr float k_Pi = 3.14159265f;
+
+    struct ClipRect { int left, top, right, bottom; };
+
+    int wrap(int value, int size) { return ((value % size) + size) % size; }
+
+    LCDBitmap* targetOf(DrawingContext& dc) { return dc.target != nullptr ? dc.target : &context().graphics.frame; }
+
+    ClipRect clipOf(DrawingContext& dc)
+    {
+        auto target = targetOf(dc);
+        return {std::max(dc.clip[0], 0), std::max(dc.clip[1], 0),
+                std::min(dc.clip[2], target->width), std::min(dc.clip[3], target->height)};
+    }
+
+    bool stencilAllows(const DrawingContext& dc, int x, int y)
+    {
+        auto stencil = dc.stencil;
+        if (stencil == nullptr)
+            { return true; }
+
+        if (dc.tileStencil)
+        {
+            x = wrap(x, stencil->width);
+            y = wrap(y, stencil->height);
+        }
+        else if (x < 0 || y < 0 || x >= stencil->width || y >= stencil->height)
+            { return false; }
+
+        return stencil->getPixel(x, y);
+    }
+
+    void writePixel(LCDBitmap* target, int x, int y, bool white)
+    {
+        target->setPixel(x, y, white);
+        if (target->mask != nullptr)
+            { target->setOpaque(x, y, true); }
+    }
+
+    // Writes a single pixel of a color, in target coordinates, which have
+    // already been clipped.
+    void plotColor(DrawingContext& dc, LCDBitmap* target, int x, int y, LCDColor color)
+    {
+        if (!stencilAllows(dc, x, y))
+            { return; }
+
+        switch (color)
+        {
+            case kColorBlack: writePixel(target, x, y, false); break;
+            case kColorWhite: writePixel(target, x, y, true); break;
+            case kColorClear:
+                if (target->mask != nullptr)
+                    { target->setOpaque(x, y, false); }
+                break;
+            case kColorXOR: target->setPixel(x, y, !target->getPixel(x, y)); break;
+            default:
+            {
+                auto pattern = reinterpret_cast<const uint8_t*>(color);
+                auto bit = static_cast<uint8_t>(0x80 >> (x & 7));
+                if ((pattern[8 + (y & 7)] & bit) != 0)
+                    { writePixel(target, x, y, (pattern[y & 7] & bit) != 0); }
+            }
+        }
+    }
+
+    // Fills pixels [x0, x1) of row y, in target coordinates, respecting the
+    // clip rect.
+    void fillSpan(DrawingContext& dc, int x0, int x1, int y, LCDColor color)
+    {
+        auto target = targetOf(dc);
+        auto clip = clipOf(dc);
+        if (y < clip.top || y >= clip.bottom)
+            { return; }
+
+        x0 = std::max(x0, clip.left);
+        x1 = std::min(x1, clip.right);
+        if (x0 >= x1)
+            { return; }
+
+        // Solid colors without a stencil can be written a byte at a time.
+        if ((color == kColorBlack || color == kColorWhite) && dc.stencil == nullptr)
+        {
+            auto white = color == kColorWhite;
+            auto fill = [&](std::vector<uint8_t>& bits, bool set)
+            {
+                auto row = bits.data() + y * target->rowBytes;
+                int x = x0;
+                for (; x < x1 && (x & 7) != 0; x++)
+                    { row[x >> 3] = set ? (row[x >> 3] | (0x80 >> (x & 7))) : (row[x >> 3] & ~(0x80 >> (x & 7))); }
+                if (x + 8 <= x1)
+                {
+                    auto nBytes = (x1 - x) >> 3;
+                    std::memset(row + (x >> 3), set ? 0xff : 0x00, nBytes);
+                    x += nBytes << 3;
+                }
+                for (; x < x1; x++)
+                    { row[x >> 3] = set ? (row[x >> 3] | (0x80 >> (x & 7))) : (row[x >> 3] & ~(0x80 >> (x & 7))); }
+            };
+            fill(*target->data, white);
+            if (target->mask != nullptr)
+                { fill(*target->mask, true); }
+            return;
+        }
+
+        for (int x = x0; x < x1; x++)
+            { plotColor(dc, target, x, y, color); }
+    }
+
+    void plotClipped(DrawingContext& dc, int x, int y, LCDColor color)
+    {
+        auto clip = clipOf(dc);
+        if (x >= clip.left && x < clip.right && y >= clip.top && y < clip.bottom)
+            { plotColor(dc, targetOf(dc), x, y, color); }
+    }
+
+    // Combines a single source pixel with the target according to the
+    // current draw mode.
+    void compositePixel(DrawingContext& dc, LCDBitmap* target, int x, int y, bool white)
+    {
+        if (!stencilAllows(dc, x, y))
+            { return; }
+
+        switch (dc.drawMode)
+        {
+            case kDrawModeCopy: writePixel(target, x, y, white); break;
+            case kDrawModeWhiteTransparent: if (!white) { writePixel(target, x, y, false); } break;
+            case kDrawModeBlackTransparent: if (white) { writePixel(target, x, y, true); } break;
+            case kDrawModeFillWhite: writePixel(target, x, y, true); break;
+            case kDrawModeFillBlack: writePixel(target, x, y, false); break;
+            case kDrawModeXOR: if (white) { writePixel(target, x, y, !target->getPixel(x, y)); } break;
+            case kDrawModeNXOR: if (!white) { writePixel(target, x, y, !target->getPixel(x, y)); } break;
+            case kDrawModeInverted: writePixel(target, x, y, !white); break;
+        }
+    }
+
+    // Maps a destination pixel through a flip to the source pixel it shows.
+    void applyFlip(LCDBitmapFlip flip, int width, int height, int& sx, int& sy)
+    {
+        if (flip == kBitmapFlippedX || flip == kBitmapFlippedXY) { sx = width - 1 - sx; }
+        if (flip == kBitmapFlippedY || flip == kBitmapFlippedXY) { sy = height - 1 - sy; }
+    }
+
+    // Draws a bitmap at the given target coordinates, x and y being the top
+    // left corner, with `sample` mapping each covered target pixel to a
+    // source pixel, or returning false when there isn't one.
+    template <typename Sampler>
+    void blit(DrawingContext& dc, int x0, int y0, int width, int height, const LCDBitmap* source, Sampler sample)
+    {
+        auto target = targetOf(dc);
+        auto clip = clipOf(dc);
+        auto left = std::max(x0, clip.left);
+        auto top = std::max(y0, clip.top);
+        auto right = std::min(x0 + width, clip.right);
+        auto bottom = std::min(y0 + height, clip.bottom);
+
+        for (int y = top; y < bottom; y++)
+        {
+            for (int x = left; x < right; x++)
+            {
+                int sx, sy;
+                if (!sample(x, y, sx, sy) || sx < 0 || sy < 0 || sx >= source->width || sy >= source->height)
+                    { continue; }
+                if (source->isOpaque(sx, sy))
+                    { compositePixel(dc, target, x, y, source->getPixel(sx, sy)); }
+            }
+        }
+    }
+
+    // Fills a polygon given in target coordinates, sampling at pixel centers.
+    void fillPolygonF(DrawingContext& dc, const std::vector<float>& xs, const std::vector<float>& ys,
+                      LCDColor color, LCDPolygonFillRule rule)
+    {
+        auto n = static_cast<int>(xs.size());
+        if (n < 3)
+            { return; }
+
+        auto [minY, maxY] = std::minmax_element(ys.begin(), ys.end());
+        auto clip = clipOf(dc);
+        auto top = std::max(static_cast<int>(std::floor(*minY)), clip.top);
+        auto bottom = std::min(static_cast<int>(std::ceil(*maxY)), clip.bottom);
+
+        std::vector<std::pair<float, int>> crossings;
+        for (int y = top; y < bottom; y++)
+        {
+            auto sampleY = static_cast<float>(y) + 0.5f;
+            crossings.clear();
+            for (int i = 0; i < n; i++)
+            {
+                auto j = (i + 1) % n;
+                auto ay = ys[i], by = ys[j];
+                if (ay == by || sampleY < std::min(ay, by) || sampleY >= std::max(ay, by))
+                    { continue; }
+                auto x = xs[i] + (sampleY - ay) * (xs[j] - xs[i]) / (by - ay);
+                crossings.emplace_back(x, by > ay ? 1 : -1);
+            }
+            std::sort(crossings.begin(), crossings.end());
+
+            int winding = 0;
+            for (size_t i = 0; i + 1 < crossings.size(); i++)
+            {
+                winding += crossings[i].second;
+                auto inside = rule == kPolygonFillEvenOdd ? (i % 2 == 0) : winding != 0;
+                if (!inside)
+                    { continue; }
+
+                auto x0 = static_cast<int>(std::ceil(crossings[i].first - 0.5f));
+                auto x1 = static_cast<int>(std::ceil(crossings[i + 1].first - 0.5f));
+                fillSpan(dc, x0, x1, y, color);
+            }
+        }
+    }
+
+    // Fills (or outlines, when lineWidth is positive) an ellipse or part of
+    // one, in target coordinates. Angles are degrees clockwise from 12
+    // o'clock, and equal angles mean the whole ellipse.
+    void rasterEllipse(DrawingContext& dc, int x, int y, int width, int height, int lineWidth,
+                       float startAngle, float endAngle, LCDColor color)
+    {
+        if (width <= 0 || height <= 0)
+            { return; }
+
+        auto rx = static_cast<float>(width) / 2.0f;
+        auto ry = static_cast<float>(height) / 2.0f;
+        auto cx = static_cast<float>(x) + rx;
+        auto cy = static_cast<float>(y) + ry;
+        auto irx = rx - static_cast<float>(lineWidth);
+        auto iry = ry - static_cast<float>(lineWidth);
+        auto hollow = lineWidth > 0 && irx > 0.0f && iry > 0.0f;
+
+        auto fullCircle = startAngle == endAngle || std::abs(endAngle - startAngle) >= 360.0f;
+        auto start = std::fmod(std::fmod(startAngle, 360.0f) + 360.0f, 360.0f);
+        auto end = std::fmod(std::fmod(endAngle, 360.0f) + 360.0f, 360.0f);
+
+        for (int py = y; py < y + height; py++)
+        {
+            for (int px = x; px < x + width; px++)
+            {
+                auto dx = static_cast<float>(px) + 0.5f - cx;
+                auto dy = static_cast<float>(py) + 0.5f - cy;
+                if ((dx * dx) / (rx * rx) + (dy * dy) / (ry * ry) > 1.0f)
+                    { continue; }
+                if (hollow && (dx * dx) / (irx * irx) + (dy * dy) / (iry * iry) <= 1.0f)
+                    { continue; }
+
+                if (!fullCircle)
+                {
+                    auto angle = std::atan2(dx, -dy) * 180.0f / k_Pi;
+                    if (angle < 0.0f) { angle += 360.0f; }
+                    auto inArc = start <= end ? (angle >= start && angle <= end) : (angle >= start || angle <= end);
+                    if (!inArc)
+                        { continue; }
+                }
+                plotClipped(dc, px, py, color);
+            }
+        }
+    }
+
+    void fillRectTarget(DrawingContext& dc, int x, int y, int width, int height, LCDColor color)
+    {
+        for (int row = y; row < y + height; row++)
+            { fillSpan(dc, x, x + width, row, color); }
+    }
+
+    void normalizeRect(int& x, int& y, int& width, int& height)
+    {
+        if (width < 0) { x += width; width = -width; }
+        if (height < 0) { y += height; height = -height; }
+    }
+
+    void fillBitmap(LCDBitmap* bitmap, LCDColor color)
+    {
+        if (color == kColorClear)
+        {
+            bitmap->addMask(false);
+            std::fill(bitmap->mask->begin(), bitmap->mask->end(), 0);
+            return;
+        }
+
+        DrawingContext dc;
+        dc.target = bitmap;
+        dc.clip[2] = bitmap->width;
+        dc.clip[3] = bitmap->height;
+        fillRectTarget(dc, 0, 0, bitmap->width, bitmap->height, color);
+    }
+
+    std::string& lastGraphicsError()
+    {
+        static std::string error;
+        return error;
+    }
+
+    // Reads a whitespace-and-comment separated header token from a PNM file.
+    std::string readToken(std::istream& in)
+    {
+        std::string token;
+        while (in && token.empty())
+        {
+            in >> std::ws;
+            if (in.peek() == '#')
+            {
+                std::string comment;
+                std::getline(in, comment);
+                continue;
+            }
+            in >> token;
+        }
+        return token;
+    }
+
+    // Loads a PBM (P1 or P4) or PGM (P2 or P5) image. PGM pixels darker than
+    // mid-grey become black, which is about what the Playdate compiler does.
+    std::unique_ptr<LCDBitmap> loadNetpbm(const fs::path& path)
+    {
+        std::ifstream in(path, std::ios::binary);
+        if (!in)
+            { return nullptr; }
+
+        auto magic = readToken(in);
+        if (magic != "P1" && magic != "P4" && magic != "P2" && magic != "P5")
+            { return nullptr; }
+
+        auto width = std::stoi(readToken(in));
+        auto height = std::stoi(readToken(in));
+        int maxValue = 1;
+        if (magic == "P2" || magic == "P5")
+            { maxValue = std::stoi(readToken(in)); }
+        if (width <= 0 || height <= 0 || maxValue <= 0)
+            { return nullptr; }
+
+        auto bitmap = std::make_unique<LCDBitmap>(width, height);
+        if (magic == "P4")
+        {
+            in.get();
+            auto srcRowBytes = (width + 7) / 8;
+            std::vector<char> row(srcRowBytes);
+            for (int y = 0; y < height; y++)
+            {
+                in.read(row.data(), srcRowBytes);
+                // PBM's set bits are black, the Playdate's are white.
+                for (int i = 0; i < srcRowBytes; i++)
+                    { (*bitmap->data)[y * bitmap->rowBytes + i] = static_cast<uint8_t>(~row[i]); }
+            }
+        }
+        else if (magic == "P5")
+        {
+            in.get();
+            auto bytesPerSample = maxValue > 255 ? 2 : 1;
+            std::vector<unsigned char> row(width * bytesPerSample);
+            for (int y = 0; y < height; y++)
+            {
+                in.read(reinterpret_cast<char*>(row.data()), static_cast<std::streamsize>(row.size()));
+                for (int x = 0; x < width; x++)
+                {
+                    auto value = bytesPerSample == 2 ? (row[x * 2] << 8 | row[x * 2 + 1]) : row[x];
+                    bitmap->setPixel(x, y, value * 2 >= maxValue);
+                }
+            }
+        }
+        else
+        {
+            for (int y = 0; y < height; y++)
+            {
+                for (int x = 0; x < width; x++)
+                {
+                    int value;
+                    if (magic == "P1")
+                    {
+                        char c;
+                        do { in >> c; } while (in && c != '0' && c != '1');
+                        bitmap->setPixel(x, y, c == '0');
+                    }
+                    else
+                    {
+                        in >> value;
+                        bitmap->setPixel(x, y, value * 2 >= maxValue);
+                    }
+                }
+            }
+        }
+
+        if (!in)
+            { return nullptr; }
+        return bitmap;
+    }
+
+    // Finds the image backing a game path. Compiled Playdate images are
+    // referenced without an extension, so the path is also tried with the
+    // extensions the host knows how to read.
+    std::optional<fs::path> findImage(const char* path)
+    {
+        std::string base(path);
+        if (auto found = pdcpp::host::findReadablePath(base.c_str()); found.has_value() && !fs::is_directory(*found))
+            { return found; }
+
+        auto stem = fs::path(base).replace_extension().string();
+        for (auto ext : {".pbm", ".pgm"})
+        {
+            if (auto found = pdcpp::host::findReadablePath((stem + ext).c_str()); found.has_value())
+                { return found; }
+        }
+        return std::nullopt;
+    }
+
+    std::unique_ptr<LCDBitmap> loadImage(const char* path, const char** outerr)
+    {
+        auto found = findImage(path);
+        std::unique_ptr<LCDBitmap> bitmap;
+        if (found.has_value())
+            { bitmap = loadNetpbm(*found); }
+
+        if (bitmap == nullptr)
+        {
+            lastGraphicsError() = std::string("Could not load image: ") + path;
+            if (outerr != nullptr) { *outerr = lastGraphicsError().c_str(); }
+        }
+        return bitmap;
+    }
+
+    std::unique_ptr<LCDBitmap> cropBitmap(const LCDBitmap& source, int x, int y, int width, int height)
+    {
+        auto cell = std::make_unique<LCDBitmap>(width, height);
+        if (source.mask != nullptr)
+            { cell->addMask(false); }
+
+        for (int row = 0; row < height; row++)
+        {
+            for (int col = 0; col < width; col++)
+            {
+                if (x + col >= source.width || y + row >= source.height)
+                    { continue; }
+                cell->setPixel(col, row, source.getPixel(x + col, y + row));
+                if (source.mask != nullptr)
+                    { cell->setOpaque(col, row, source.isOpaque(x + col, y + row)); }
+            }
+        }
+        return cell;
+    }
+
+    // Loads a bitmap table, either from a single sheet named
+    // `<name>-table-<width>-<height>`, or from a numbered sequence of images
+    // named `<name>-table-<n>`, which are the two layouts the Playdate
+    // compiler accepts.
+    bool loadTable(const char* path, LCDBitmapTable& table, const char** outerr)
+    {
+        auto relative = fs::path(path).replace_extension();
+        auto stem = relative.filename().string();
+        auto prefix = stem + "-table-";
+        std::map<int, std::unique_ptr<LCDBitmap>> sequence;
+
+        auto dirPath = relative.parent_path().string();
+        auto dir = pdcpp::host::findReadablePath(dirPath.empty() ? "." : dirPath.c_str());
+        std::error_code ec;
+        if (dir.has_value() && fs::is_directory(*dir, ec))
+        {
+            for (auto& entry : fs::directory_iterator(*dir, ec))
+            {
+                auto name = entry.path().stem().string();
+                if (!name.starts_with(prefix))
+                    { continue; }
+
+                auto image = loadNetpbm(entry.path());
+                if (image == nullptr)
+                    { continue; }
+
+                int cellWidth, cellHeight;
+                auto suffix = name.substr(prefix.size());
+                if (std::sscanf(suffix.c_str(), "%d-%d", &cellWidth, &cellHeight) == 2 && cellWidth > 0 && cellHeight > 0)
+                {
+                    table.cellsWide = image->width / cellWidth;
+                    table.bitmaps.clear();
+                    for (int y = 0; y + cellHeight <= image->height; y += cellHeight)
+                    {
+                        for (int x = 0; x + cellWidth <= image->width; x += cellWidth)
+                            { table.bitmaps.push_back(cropBitmap(*image, x, y, cellWidth, cellHeight)); }
+                    }
+                    return true;
+                }
+
+                int index;
+                if (std::sscanf(suffix.c_str(), "%d", &index) == 1)
+                    { sequence[index] = std::move(image); }
+            }
+        }
+
+        if (sequence.empty())
+        {
+            lastGraphicsError() = std::string("Could not load image table: ") + path;
+            if (outerr != nullptr) { *outerr = lastGraphicsError().c_str(); }
+            return false;
+        }
+
+        table.bitmaps.clear();
+        for (auto& [index, image] : sequence)
+            { table.bitmaps.push_back(std::move(image)); }
+        table.cellsWide = static_cast<int>(table.bitmaps.size());
+        return true;
+    }
+
+    //==========================================================================
+    void clear(LCDColor color)
+    {
+        auto& dc = context().graphics.current();
+        auto target = targetOf(dc);
+        fillRectTarget(dc, 0, 0, target->width, target->height, color);
+    }
+
+    void setBackgroundColor(LCDSolidColor color) { context().graphics.backgroundColor = color; }
+
+    void setStencilImage(LCDBitmap* stencil, int tile)
+    {
+        auto& dc = context().graphics.current();
+        dc.stencil = stencil;
+        dc.tileStencil = tile != 0;
+    }
+
+    void setStencil(LCDBitmap* stencil) { setStencilImage(stencil, 0); }
+
+    LCDBitmapDrawMode setDrawMode(LCDBitmapDrawMode mode)
+    {
+        auto& dc = context().graphics.current();
+        auto previous = dc.drawMode;
+        dc.drawMode = mode;
+        return previous;
+    }
+
+    void setDrawOffset(int dx, int dy)
+    {
+        auto& dc = context().graphics.current();
+        dc.offsetX = dx;
+        dc.offsetY = dy;
+    }
+
+    void setScreenClipRect(int x, int y, int width, int height)
+    {
+        normalizeRect(x, y, width, height);
+        auto& dc = context().graphics.current();
+        dc.clip[0] = x;
+        dc.clip[1] = y;
+        dc.clip[2] = x + width;
+        dc.clip[3] = y + height;
+    }
+
+    void setClipRect(int x, int y, int width, int height)
+    {
+        auto& dc = context().graphics.current();
+        setScreenClipRect(x + dc.offsetX, y + dc.offsetY, width, height);
+    }
+
+    void clearClipRect()
+    {
+        auto& dc = context().graphics.current();
+        auto target = targetOf(dc);
+        setScreenClipRect(0, 0, target->width, target->height);
+    }
+
+    void setLineCapStyle(LCDLineCapStyle endCapStyle) { context().graphics.current().lineCapStyle = endCapStyle; }
+
+    void pushContext(LCDBitmap* target)
+    {
+        auto& graphics = context().graphics;
+        auto next = graphics.current();
+        next.target = target;
+        next.offsetX = 0;
+        next.offsetY = 0;
+        next.stencil = nullptr;
+        graphics.contexts.push_back(next);
+        clearClipRect();
+    }
+
+    void popContext()
+    {
+        auto& contexts = context().graphics.contexts;
+        if (contexts.size() <= 1)
+        {
+            pdcpp::host::reportError("popContext called without a matching pushContext");
+            return;
+        }
+        contexts.pop_back();
+    }
+
+    void drawBitmap(LCDBitmap* bitmap, int x, int y, LCDBitmapFlip flip)
+    {
+        auto& dc = context().graphics.current();
+        auto width = bitmap->width;
+        auto height = bitmap->height;
+        auto x0 = x + dc.offsetX;
+        auto y0 = y + dc.offsetY;
+        blit(dc, x0, y0, width, height, bitmap, [=](int tx, int ty, int& sx, int& sy)
+        {
+            sx = tx - x0;
+            sy = ty - y0;
+            applyFlip(flip, width, height, sx, sy);
+            return true;
+        });
+    }
+
+    void tileBitmap(LCDBitmap* bitmap, int x, int y, int width, int height, LCDBitmapFlip flip)
+    {
+        normalizeRect(x, y, width, height);
+        auto& dc = context().graphics.current();
+        auto x0 = x + dc.offsetX;
+        auto y0 = y + dc.offsetY;
+        auto bw = bitmap->width;
+        auto bh = bitmap->height;
+        blit(dc, x0, y0, width, height, bitmap, [=](int tx, int ty, int& sx, int& sy)
+        {
+            sx = wrap(tx - x0, bw);
+            sy = wrap(ty - y0, bh);
+            applyFlip(flip, bw, bh, sx, sy);
+            return true;
+        });
+    }
+
+    void fillPolygonTarget(DrawingContext& dc, std::vector<float> xs, std::vector<float> ys, LCDColor color)
+        { fillPolygonF(dc, xs, ys, color, kPolygonFillNonZero); }
+
+    void drawLine(int x1, int y1, int x2, int y2, int width, LCDColor color)
+    {
+        auto& dc = context().graphics.current();
+        x1 += dc.offsetX; x2 += dc.offsetX;
+        y1 += dc.offsetY; y2 += dc.offsetY;
+
+        if (width <= 1)
+        {
+            // Bresenham, inclusive of both end points.
+            int dx = std::abs(x2 - x1), sx = x1 < x2 ? 1 : -1;
+            int dy = -std::abs(y2 - y1), sy = y1 < y2 ? 1 : -1;
+            int err = dx + dy;
+            while (true)
+            {
+                plotClipped(dc, x1, y1, color);
+                if (x1 == x2 && y1 == y2)
+                    { break; }
+                auto e2 = 2 * err;
+                if (e2 >= dy) { err += dy; x1 += sx; }
+                if (e2 <= dx) { err += dx; y1 += sy; }
+            }
+            return;
+        }
+
+        // Thick lines are a quad around the center line, plus the caps.
+        auto fx1 = static_cast<float>(x1) + 0.5f, fy1 = static_cast<float>(y1) + 0.5f;
+        auto fx2 = static_cast<float>(x2) + 0.5f, fy2 = static_cast<float>(y2) + 0.5f;
+        auto halfWidth = static_cast<float>(width) / 2.0f;
+        auto length = std::hypot(fx2 - fx1, fy2 - fy1);
+
+        auto ux = length > 0.0f ? (fx2 - fx1) / length : 1.0f;
+        auto uy = length > 0.0f ? (fy2 - fy1) / length : 0.0f;
+        auto nx = -uy * halfWidth, ny = ux * halfWidth;
+        auto extension = dc.lineCapStyle == kLineCapStyleSquare ? halfWidth : 0.0f;
+        fx1 -= ux * extension; fy1 -= uy * extension;
+        fx2 += ux * extension; fy2 += uy * extension;
+
+        if (length > 0.0f || dc.lineCapStyle == kLineCapStyleSquare)
+        {
+            fillPolygonTarget(dc, {fx1 + nx, fx2 + nx, fx2 - nx, fx1 - nx},
+                              {fy1 + ny, fy2 + ny, fy2 - ny, fy1 - ny}, color);
+        }
+
+        if (dc.lineCapStyle == kLineCapStyleRound)
+        {
+            auto capX1 = static_cast<int>(std::floor(static_cast<float>(x1) + 0.5f - halfWidth));
+            auto capY1 = static_cast<int>(std::floor(static_cast<float>(y1) + 0.5f - halfWidth));
+            auto capX2 = static_cast<int>(std::floor(static_cast<float>(x2) + 0.5f - halfWidth));
+            auto capY2 = static_cast<int>(std::floor(static_cast<float>(y2) + 0.5f - halfWidth));
+            rasterEllipse(dc, capX1, capY1, width, width, 0, 0.0f, 0.0f, color);
+            rasterEllipse(dc, capX2, capY2, width, width, 0, 0.0f, 0.0f, color);
+        }
+    }
+
+    void fillPolygon(int nPoints, int* coords, LCDColor color, LCDPolygonFillRule fillrule)
+    {
+        auto& dc = context().graphics.current();
+        std::vector<float> xs(nPoints), ys(nPoints);
+        for (int i = 0; i < nPoints; i++)
+        {
+            xs[i] = static_cast<float>(coords[i * 2] + dc.offsetX);
+            ys[i] = static_cast<float>(coords[i * 2 + 1] + dc.offsetY);
+        }
+        fillPolygonF(dc, xs, ys, color, fillrule);
+    }
+
+    void fillTriangle(int x1, int y1, int x2, int y2, int x3, int y3, LCDColor color)
+    {
+        int coords[] = {x1, y1, x2, y2, x3, y3};
+        fillPolygon(3, coords, color, kPolygonFillNonZero);
+    }
+
+    void fillRect(int x, int y, int width, int height, LCDColor color)
+    {
+        normalizeRect(x, y, width, height);
+        auto& dc = context().graphics.current();
+        fillRectTarget(dc, x + dc.offsetX, y + dc.offsetY, width, height, color);
+    }
+
+    void drawRect(int x, int y, int width, int height, LCDColor color)
+    {
+        normalizeRect(x, y, width, height);
+        if (width == 0 || height == 0)
+            { return; }
+
+        auto& dc = context().graphics.current();
+        x += dc.offsetX;
+        y += dc.offsetY;
+        fillRectTarget(dc, x, y, width, 1, color);
+        if (height > 1)
+            { fillRectTarget(dc, x, y + height - 1, width, 1, color); }
+        fillRectTarget(dc, x, y + 1, 1, height - 2, color);
+        if (width > 1)
+            { fillRectTarget(dc, x + width - 1, y + 1, 1, height - 2, color); }
+    }
+
+    void drawEllipse(int x, int y, int width, int height, int lineWidth, float startAngle, float endAngle, LCDColor color)
+    {
+        auto& dc = context().graphics.current();
+        rasterEllipse(dc, x + dc.offsetX, y + dc.offsetY, width, height, std::max(lineWidth, 1),
+                      startAngle, endAngle, color);
+    }
+
+    void fillEllipse(int x, int y, int width, int height, float startAngle, float endAngle, LCDColor color)
+    {
+        auto& dc = context().graphics.current();
+        rasterEllipse(dc, x + dc.offsetX, y + dc.offsetY, width, height, 0, startAngle, endAngle, color);
+    }
+
+    void drawScaledBitmap(LCDBitmap* bitmap, int x, int y, float xscale, float yscale)
+    {
+        if (xscale == 0.0f || yscale == 0.0f)
+            { return; }
+
+        auto& dc = context().graphics.current();
+        auto width = static_cast<int>(std::round(static_cast<float>(bitmap->width) * std::abs(xscale)));
+        auto height = static_cast<int>(std::round(static_cast<float>(bitmap->height) * std::abs(yscale)));
+        auto x0 = x + dc.offsetX;
+        auto y0 = y + dc.offsetY;
+        auto bw = bitmap->width, bh = bitmap->height;
+        blit(dc, x0, y0, width, height, bitmap, [=](int tx, int ty, int& sx, int& sy)
+        {
+            sx = static_cast<int>((static_cast<float>(tx - x0) + 0.5f) / std::abs(xscale));
+            sy = static_cast<int>((static_cast<float>(ty - y0) + 0.5f) / std::abs(yscale));
+            if (xscale < 0.0f) { sx = bw - 1 - sx; }
+            if (yscale < 0.0f) { sy = bh - 1 - sy; }
+            return true;
+        });
+    }
+
+    // Computes the axis aligned bounds of a bitmap rotated (clockwise, in
+    // degrees) and scaled about its center.
+    void rotatedBounds(const LCDBitmap* bitmap, float rotation, float xscale, float yscale, float& width, float& height)
+    {
+        auto radians = rotation * k_Pi / 180.0f;
+        auto w = static_cast<float>(bitmap->width) * std::abs(xscale);
+        auto h = static_cast<float>(bitmap->height) * std::abs(yscale);
+        auto c = std::abs(std::cos(radians)), s = std::abs(std::sin(radians));
+        width = w * c + h * s;
+        height = w * s + h * c;
+    }
+
+    // Maps a point relative to the rotation center back into source pixels.
+    bool inverseRotate(const LCDBitmap* bitmap, float px, float py, float rotation, float xscale, float yscale,
+                       float centerX, float centerY, int& sx, int& sy)
+    {
+        auto radians = rotation * k_Pi / 180.0f;
+        auto c = std::cos(radians), s = std::sin(radians);
+        auto ux = (px * c + py * s) / xscale;
+        auto uy = (-px * s + py * c) / yscale;
+        auto fx = ux + centerX * static_cast<float>(bitmap->width);
+        auto fy = uy + centerY * static_cast<float>(bitmap->height);
+        sx = static_cast<int>(std::floor(fx));
+        sy = static_cast<int>(std::floor(fy));
+        return sx >= 0 && sy >= 0 && sx < bitmap->width && sy < bitmap->height;
+    }
+
+    void drawRotatedBitmap(LCDBitmap* bitmap, int x, int y, float rotation, float centerx, float centery,
+                           float xscale, float yscale)
+    {
+        if (xscale == 0.0f || yscale == 0.0f)
+            { return; }
+
+        auto& dc = context().graphics.current();
+        float w, h;
+        rotatedBounds(bitmap, rotation, xscale, yscale, w, h);
+        // The center may be anywhere in the image, so bound generously.
+        auto reach = static_cast<int>(std::ceil(std::hypot(w, h)));
+        auto cx = static_cast<float>(x + dc.offsetX);
+        auto cy = static_cast<float>(y + dc.offsetY);
+        auto x0 = static_cast<int>(cx) - reach;
+        auto y0 = static_cast<int>(cy) - reach;
+        blit(dc, x0, y0, reach * 2, reach * 2, bitmap, [=](int tx, int ty, int& sx, int& sy)
+        {
+            return inverseRotate(bitmap, static_cast<float>(tx) + 0.5f - cx, static_cast<float>(ty) + 0.5f - cy,
+                                 rotation, xscale, yscale, centerx, centery, sx, sy);
+        });
+    }
+
+    LCDBitmap* newBitmap(int width, int height, LCDColor bgcolor)
+    {
+        auto bitmap = new LCDBitmap(std::max(width, 0), std::max(height, 0));
+        fillBitmap(bitmap, bgcolor);
+        return pdcpp::host::trackBitmap(bitmap);
+    }
+
+    void freeBitmap(LCDBitmap* bitmap)
+    {
+        if (bitmap == nullptr)
+            { return; }
+
+        if (context().graphics.bitmaps.erase(bitmap) == 0)
+        {
+            pdcpp::host::reportError("freeBitmap called on a bitmap which wasn't allocated, or was already freed");
+            return;
+        }
+        delete bitmap;
+    }
+
+    LCDBitmap* loadBitmap(const char* path, const char** outerr)
+    {
+        auto bitmap = loadImage(path, outerr);
+        return bitmap != nullptr ? pdcpp::host::trackBitmap(bitmap.release()) : nullptr;
+    }
+
+    LCDBitmap* copyBitmap(LCDBitmap* bitmap) { return pdcpp::host::trackBitmap(bitmap->clone()); }
+
+    void loadIntoBitmap(const char* path, LCDBitmap* bitmap, const char** outerr)
+    {
+        if (auto loaded = loadImage(path, outerr); loaded != nullptr)
+            { *bitmap = std::move(*loaded); }
+    }
+
+    void getBitmapData(LCDBitmap* bitmap, int* width, int* height, int* rowbytes, uint8_t** mask, uint8_t** data)
+    {
+        if (width != nullptr) { *width = bitmap->width; }
+        if (height != nullptr) { *height = bitmap->height; }
+        if (rowbytes != nullptr) { *rowbytes = bitmap->rowBytes; }
+        if (mask != nullptr) { *mask = bitmap->mask != nullptr ? bitmap->mask->data() : nullptr; }
+        if (data != nullptr) { *data = bitmap->data->data(); }
+    }
+
+    void clearBitmap(LCDBitmap* bitmap, LCDColor bgcolor) { fillBitmap(bitmap, bgcolor); }
+
+    LCDBitmap* rotatedBitmap(LCDBitmap* bitmap, float rotation, float xscale, float yscale, int* allocedSize)
+    {
+        float w, h;
+        rotatedBounds(bitmap, rotation, xscale, yscale, w, h);
+        auto width = static_cast<int>(std::ceil(w - 0.001f));
+        auto height = static_cast<int>(std::ceil(h - 0.001f));
+
+        auto result = new LCDBitmap(width, height);
+        result->addMask(false);
+        for (int y = 0; y < height; y++)
+        {
+            for (int x = 0; x < width; x++)
+            {
+                int sx, sy;
+                auto px = static_cast<float>(x) + 0.5f - static_cast<float>(width) / 2.0f;
+                auto py = static_cast<float>(y) + 0.5f - static_cast<float>(height) / 2.0f;
+                if (!inverseRotate(bitmap, px, py, rotation, xscale, yscale, 0.5f, 0.5f, sx, sy))
+                    { continue; }
+                result->setPixel(x, y, bitmap->getPixel(sx, sy));
+                result->setOpaque(x, y, bitmap->isOpaque(sx, sy));
+            }
+        }
+
+        if (allocedSize != nullptr)
+            { *allocedSize = static_cast<int>(result->data->size() + result->mask->size()); }
+        return pdcpp::host::trackBitmap(result);
+    }
+
+    LCDBitmapTable* newBitmapTable(int count, int width, int height)
+    {
+        auto table = new LCDBitmapTable;
+        table->cellsWide = count;
+        for (int i = 0; i < count; i++)
+            { table->bitmaps.push_back(std::make_unique<LCDBitmap>(width, height)); }
+        context().graphics.tables.insert(table);
+        return table;
+    }
+
+    void freeBitmapTable(LCDBitmapTable* table)
+    {
+        if (table == nullptr)
+            { return; }
+
+        if (context().graphics.tables.erase(table) == 0)
+        {
+            pdcpp::host::reportError("freeBitmapTable called on a table which wasn't allocated, or was already freed");
+            return;
+        }
+        delete table;
+    }
+
+    LCDBitmapTable* loadBitmapTable(const char* path, const char** outerr)
+    {
+        auto table = std::make_unique<LCDBitmapTable>();
+        if (!loadTable(path, *table, outerr))
+            { return nullptr; }
+        context().graphics.tables.insert(table.get());
+        return table.release();
+    }
+
+    void loadIntoBitmapTable(const char* path, LCDBitmapTable* table, const char** outerr)
+        { loadTable(path, *table, outerr); }
+
+    LCDBitmap* getTableBitmap(LCDBitmapTable* table, int idx)
+    {
+        if (idx < 0 || idx >= static_cast<int>(table->bitmaps.size()))
+            { return nullptr; }
+        return table->bitmaps[idx].get();
+    }
+
+    void getBitmapTableInfo(LCDBitmapTable* table, int* count, int* width)
+    {
+        if (count != nullptr) { *count = static_cast<int>(table->bitmaps.size()); }
+        if (width != nullptr) { *width = table->cellsWide; }
+    }
+
+    uint8_t* getFrame() { return context().graphics.frame.data->data(); }
+    uint8_t* getDisplayFrame() { return context().graphics.displayFrame.data->data(); }
+    LCDBitmap* getDebugBitmap() { return nullptr; }
+    LCDBitmap* copyFrameBufferBitmap() { return pdcpp::host::trackBitmap(context().graphics.frame.clone()); }
+    void markUpdatedRows(int, int) {}
+    void display() { pdcpp::host::presentFrame(); }
+
+    void setColorToPattern(LCDColor* color, LCDBitmap* bitmap, int x, int y)
+    {
+        auto& pattern = context().graphics.patterns.emplace_back();
+        for (int row = 0; row < 8; row++)
+        {
+            uint8_t bits = 0, mask = 0;
+            for (int col = 0; col < 8; col++)
+            {
+                auto sx = wrap(x + col, bitmap->width);
+                auto sy = wrap(y + row, bitmap->height);
+                if (bitmap->getPixel(sx, sy)) { bits |= 0x80 >> col; }
+                if (bitmap->isOpaque(sx, sy)) { mask |= 0x80 >> col; }
+            }
+            pattern[row] = bits;
+            pattern[row + 8] = mask;
+        }
+        *color = reinterpret_cast<LCDColor>(pattern.data());
+    }
+
+    int checkMaskCollision(LCDBitmap* bitmap1, int x1, int y1, LCDBitmapFlip flip1,
+                           LCDBitmap* bitmap2, int x2, int y2, LCDBitmapFlip flip2, LCDRect rect)
+    {
+        auto left = std::max({rect.left, x1, x2});
+        auto top = std::max({rect.top, y1, y2});
+        auto right = std::min({rect.right, x1 + bitmap1->width, x2 + bitmap2->width});
+        auto bottom = std::min({rect.bottom, y1 + bitmap1->height, y2 + bitmap2->height});
+
+        for (int y = top; y < bottom; y++)
+        {
+            for (int x = left; x < right; x++)
+            {
+                int sx1 = x - x1, sy1 = y - y1, sx2 = x - x2, sy2 = y - y2;
+                applyFlip(flip1, bitmap1->width, bitmap1->height, sx1, sy1);
+                applyFlip(flip2, bitmap2->width, bitmap2->height, sx2, sy2);
+                if (bitmap1->isOpaque(sx1, sy1) && bitmap2->isOpaque(sx2, sy2))
+                    { return 1; }
+            }
+        }
+        return 0;
+    }
+
+    LCDBitmap* getDisplayBufferBitmap() { return &context().graphics.displayFrame; }
+
+    int setBitmapMask(LCDBitmap* bitmap, LCDBitmap* mask)
+    {
+        if (mask->width != bitmap->width || mask->height != bitmap->height)
+            { return 0; }
+        bitmap->mask = std::make_shared<std::vector<uint8_t>>(*mask->data);
+        return 1;
+    }
+
+    LCDBitmap* getBitmapMask(LCDBitmap* bitmap)
+    {
+        if (bitmap->mask == nullptr)
+            { return nullptr; }
+
+        // The returned bitmap aliases the mask, so drawing into it edits the
+        // source's mask directly, like on the device.
+        auto view = new LCDBitmap;
+        view->width = bitmap->width;
+        view->height = bitmap->height;
+        view->rowBytes = bitmap->rowBytes;
+        view->data = bitmap->mask;
+        return pdcpp::host::trackBitmap(view);
+    }
+
+    void setPixel(int x, int y, LCDColor c)
+    {
+        auto& dc = context().graphics.current();
+        plotClipped(dc, x + dc.offsetX, y + dc.offsetY, c);
+    }
+
+    LCDSolidColor getBitmapPixel(LCDBitmap* bitmap, int x, int y)
+    {
+        if (x < 0 || y < 0 || x >= bitmap->width || y >= bitmap->height || !bitmap->isOpaque(x, y))
+            { return kColorClear; }
+        return bitmap->getPixel(x, y) ? kColorWhite : kColorBlack;
+    }
+
+    //==========================================================================
+    const char* k_VideoError = "Video playback is not supported by the host backend";
+
+    LCDVideoPlayer* loadVideo(const char*)
+    {
+        lastGraphicsError() = k_VideoError;
+        return nullptr;
+    }
+
+    void freeVideoPlayer(LCDVideoPlayer*) {}
+    int setVideoContext(LCDVideoPlayer*, LCDBitmap*) { return 0; }
+    void useScreenContext(LCDVideoPlayer*) {}
+    int renderFrame(LCDVideoPlayer*, int) { return 0; }
+    const char* getVideoError(LCDVideoPlayer*) { return k_VideoError; }
+
+    void getVideoInfo(LCDVideoPlayer*, int* outWidth, int* outHeight, float* outFrameRate, int* outFrameCount,
+                      int* outCurrentFrame)
+    {
+        if (outWidth != nullptr) { *outWidth = 0; }
+        if (outHeight != nullptr) { *outHeight = 0; }
+        if (outFrameRate != nullptr) { *outFrameRate = 0.0f; }
+        if (outFrameCount != nullptr) { *outFrameCount = 0; }
+        if (outCurrentFrame != nullptr) { *outCurrentFrame = 0; }
+    }
+
+    LCDBitmap* getVideoContext(LCDVideoPlayer*) { return nullptr; }
+
+    //==========================================================================
+    int getDisplayWidth() { return LCD_COLUMNS / static_cast<int>(context().graphics.scale); }
+    int getDisplayHeight() { return LCD_ROWS / static_cast<int>(context().graphics.scale); }
+    void setRefreshRate(float rate) { context().graphics.refreshRate = rate; }
+    void setInverted(int flag) { context().graphics.inverted = flag != 0; }
+
+    void setScale(unsigned int s)
+    {
+        if (s == 1 || s == 2 || s == 4 || s == 8)
+            { context().graphics.scale = s; }
+    }
+
+    void setMosaic(unsigned int, unsigned int) {}
+    void setFlipped(int, int) {}
+    void setOffset(int, int) {}
+}
+
+//==============================================================================
+LCDBitmap::LCDBitmap(int w, int h)
+    : width(w)
+    , height(h)
+    , rowBytes(((w + 31) / 32) * 4)
+    , data(std::make_shared<std::vector<uint8_t>>(rowBytes * h, 0))
+{}
+
+void LCDBitmap::addMask(bool opaque)
+{
+    if (mask == nullptr)
+        { mask = std::make_shared<std::vector<uint8_t>>(data->size(), opaque ? 0xff : 0x00); }
+}
+
+LCDBitmap* LCDBitmap::clone() const
+{
+    auto copy = new LCDBitmap;
+    copy->width = width;
+    copy->height = height;
+    copy->rowBytes = rowBytes;
+    copy->data = std::make_shared<std::vector<uint8_t>>(*data);
+    if (mask != nullptr)
+        { copy->mask = std::make_shared<std::vector<uint8_t>>(*mask); }
+    return copy;
+}
+
+//==============================================================================
+pdcpp::host::GraphicsState::GraphicsState()
+    : frame(LCD_COLUMNS, LCD_ROWS)
+    , displayFrame(LCD_COLUMNS, LCD_ROWS)
+    , contexts(1)
+{
+    std::fill(frame.data->begin(), frame.data->end(), 0xff);
+    std::fill(displayFrame.data->begin(), displayFrame.data->end(), 0xff);
+}
+
+pdcpp::host::GraphicsState::~GraphicsState()
+{
+    for (auto bitmap : bitmaps) { delete bitmap; }
+    for (auto table : tables) { delete table; }
+    for (auto font : fonts) { delete font; }
+}
+
+void pdcpp::host::populateGraphicsAPI(playdate_graphics& api, playdate_video& video)
+{
+    video.loadVideo = loadVideo;
+    video.freePlayer = freeVideoPlayer;
+    video.setContext = setVideoContext;
+    video.useScreenContext = useScreenContext;
+    video.renderFrame = renderFrame;
+    video.getError = getVideoError;
+    video.getInfo = getVideoInfo;
+    video.getContext = getVideoContext;
+
+    api.video = &video;
+    api.clear = clear;
+    api.setBackgroundColor = setBackgroundColor;
+    api.setStencil = setStencil;
+    api.setDrawMode = setDrawMode;
+    api.setDrawOffset = setDrawOffset;
+    api.setClipRect = setClipRect;
+    api.clearClipRect = clearClipRect;
+    api.setLineCapStyle = setLineCapStyle;
+    api.pushContext = pushContext;
+    api.popContext = popContext;
+    api.drawBitmap = drawBitmap;
+    api.tileBitmap = tileBitmap;
+    api.drawLine = drawLine;
+    api.fillTriangle = fillTriangle;
+    api.drawRect = drawRect;
+    api.fillRect = fillRect;
+    api.drawEllipse = drawEllipse;
+    api.fillEllipse = fillEllipse;
+    api.drawScaledBitmap = drawScaledBitmap;
+    api.newBitmap = newBitmap;
+    api.freeBitmap = freeBitmap;
+    api.loadBitmap = loadBitmap;
+    api.copyBitmap = copyBitmap;
+    api.loadIntoBitmap = loadIntoBitmap;
+    api.getBitmapData = getBitmapData;
+    api.clearBitmap = clearBitmap;
+    api.rotatedBitmap = rotatedBitmap;
+    api.newBitmapTable = newBitmapTable;
+    api.freeBitmapTable = freeBitmapTable;
+    api.loadBitmapTable = loadBitmapTable;
+    api.loadIntoBitmapTable = loadIntoBitmapTable;
+    api.getTableBitmap = getTableBitmap;
+    api.getFrame = getFrame;
+    api.getDisplayFrame = getDisplayFrame;
+    api.getDebugBitmap = getDebugBitmap;
+    api.copyFrameBufferBitmap = copyFrameBufferBitmap;
+    api.markUpdatedRows = markUpdatedRows;
+    api.display = display;
+    api.setColorToPattern = setColorToPattern;
+    api.checkMaskCollision = checkMaskCollision;
+    api.setScreenClipRect = setScreenClipRect;
+    api.fillPolygon = fillPolygon;
+    api.getDisplayBufferBitmap = getDisplayBufferBitmap;
+    api.drawRotatedBitmap = drawRotatedBitmap;
+    api.setBitmapMask = setBitmapMask;
+    api.getBitmapMask = getBitmapMask;
+    api.setStencilImage = setStencilImage;
+    api.setPixel = setPixel;
+    api.getBitmapPixel = getBitmapPixel;
+    api.getBitmapTableInfo = getBitmapTableInfo;
+
+    populateFontAPI(api);
+}
+
+void pdcpp::host::populateDisplayAPI(playdate_display& api)
+{
+    api.getWidth = getDisplayWidth;
+    api.getHeight = getDisplayHeight;
+    api.setRefreshRate = setRefreshRate;
+    api.setInverted = setInverted;
+    api.setScale = setScale;
+    api.setMosaic = setMosaic;
+    api.setFlipped = setFlipped;
+    api.setOffset = setOffset;
+}
+
+void pdcpp::host::presentFrame()
+{
+    auto& graphics = context().graphics;
+    *graphics.displayFrame.data = *graphics.frame.data;
+    if (graphics.inverted)
+    {
+        for (auto& byte : *graphics.displayFrame.data)
+            { byte = static_cast<uint8_t>(~byte); }
+    }
+}
+
+LCDBitmap* pdcpp::host::trackBitmap(LCDBitmap* bitmap)
+{
+    context().graphics.bitmaps.insert(bitmap);
+    return bitmap;
+}
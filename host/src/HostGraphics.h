@@ -0,0 +1,184 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#pragma once
+
+#include <pd_api.h>
+#include <array>
+#include <deque>
+#include <map>
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * The host's definition of the SDK's opaque bitmap. Pixels are stored 1-bit,
+ * MSB first, with set bits being white, exactly like the device. The mask,
+ * when present, has the same layout, with set bits being opaque. Both are
+ * shared so `getBitmapMask` can hand out a bitmap which aliases the mask.
+ */
+struct LCDBitmap
+{
+    LCDBitmap() = default;
+    LCDBitmap(int w, int h);
+
+    [[ nodiscard ]] bool getPixel(int x, int y) const
+        { return ((*data)[y * rowBytes + (x >> 3)] & (0x80 >> (x & 7))) != 0; }
+
+    void setPixel(int x, int y, bool white) { setBit(*data, x, y, white); }
+
+    [[ nodiscard ]] bool isOpaque(int x, int y) const
+        { return mask == nullptr || ((*mask)[y * rowBytes + (x >> 3)] & (0x80 >> (x & 7))) != 0; }
+
+    void setOpaque(int x, int y, bool opaque) { setBit(*mask, x, y, opaque); }
+
+    /**
+     * Gives the bitmap a mask, if it doesn't have one already.
+     *
+     * @param opaque whether the new mask should start fully opaque.
+     */
+    void addMask(bool opaque);
+
+    /**
+     * @returns a deep copy of this bitmap, including its mask.
+     */
+    [[ nodiscard ]] LCDBitmap* clone() const;
+
+    int width = 0;
+    int height = 0;
+    int rowBytes = 0;
+    std::shared_ptr<std::vector<uint8_t>> data;
+    std::shared_ptr<std::vector<uint8_t>> mask;
+
+private:
+    void setBit(std::vector<uint8_t>& bits, int x, int y, bool value) const
+    {
+        auto& byte = bits[y * rowBytes + (x >> 3)];
+        auto bit = static_cast<uint8_t>(0x80 >> (x & 7));
+        byte = value ? (byte | bit) : (byte & ~bit);
+    }
+};
+
+/**
+ * The host's definition of the SDK's opaque bitmap table.
+ */
+struct LCDBitmapTable
+{
+    int cellsWide = 0;
+    std::vector<std::unique_ptr<LCDBitmap>> bitmaps;
+};
+
+/**
+ * A glyph in the host's built-in font.
+ */
+struct LCDFontGlyph
+{
+    LCDBitmap bitmap;
+    int advance = 0;
+};
+
+/**
+ * The host doesn't split fonts into pages, so each font has a single page
+ * which points back to it.
+ */
+struct LCDFontPage
+{
+    struct LCDFont* font = nullptr;
+};
+
+/**
+ * The host's definition of the SDK's opaque font. Every font is the built-in
+ * 5x7 face, scaled up by whole pixels to approximate the requested size.
+ */
+struct LCDFont
+{
+    int scale = 1;
+    LCDFontPage page;
+    std::map<uint32_t, std::unique_ptr<LCDFontGlyph>> glyphs;
+};
+
+namespace pdcpp::host
+{
+    /**
+     * The graphics state which `pushContext` and `popContext` save and
+     * restore.
+     */
+    struct DrawingContext
+    {
+        LCDBitmap* target = nullptr;
+        LCDBitmapDrawMode drawMode = kDrawModeCopy;
+        int offsetX = 0;
+        int offsetY = 0;
+        // The clip rect, in target coordinates, as left, top, right, bottom.
+        int clip[4] = {0, 0, LCD_COLUMNS, LCD_ROWS};
+        LCDLineCapStyle lineCapStyle = kLineCapStyleButt;
+        LCDFont* font = nullptr;
+        int tracking = 0;
+        int leading = 0;
+        LCDBitmap* stencil = nullptr;
+        bool tileStencil = false;
+    };
+
+    /**
+     * Everything behind `playdate->graphics` and `playdate->display`.
+     */
+    struct GraphicsState
+    {
+        GraphicsState();
+        ~GraphicsState();
+
+        [[ nodiscard ]] DrawingContext& current() { return contexts.back(); }
+
+        LCDBitmap frame;
+        LCDBitmap displayFrame;
+        std::vector<DrawingContext> contexts;
+        LCDSolidColor backgroundColor = kColorWhite;
+
+        LCDFont systemFont;
+        std::unordered_set<LCDFont*> fonts;
+        std::unordered_set<LCDBitmap*> bitmaps;
+        std::unordered_set<LCDBitmapTable*> tables;
+        std::deque<std::array<uint8_t, 16>> patterns;
+
+        float refreshRate = 30.0f;
+        bool inverted = false;
+        unsigned int scale = 1;
+    };
+
+    /**
+     * Fills in the `playdate->graphics` and `playdate->graphics->video`
+     * function tables.
+     */
+    void populateGraphicsAPI(playdate_graphics& api, playdate_video& video);
+
+    /**
+     * Fills in the font and text functions of the `playdate->graphics`
+     * function table.
+     */
+    void populateFontAPI(playdate_graphics& api);
+
+    /**
+     * Starts tracking a bitmap allocated on behalf of game code, so it can be
+     * validated when freed, and cleaned up if it never is.
+     *
+     * @returns the bitmap, for convenience.
+     */
+    LCDBitmap* trackBitmap(LCDBitmap* bitmap);
+
+    /**
+     * Fills in the `playdate->display` function table.
+     */
+    void populateDisplayAPI(playdate_display& api);
+
+    /**
+     * Copies the working frame to the display buffer.
+     */
+    void presentFrame();
+}
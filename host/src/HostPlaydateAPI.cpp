@@ -0,0 +1,255 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#include <pdcpp/host/HostPlaydateAPI.h>
+#include "HostContext.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+
+namespace
+{
+    std::filesystem::path makeTemporaryDirectory()
+    {
+        auto pattern = (std::filesystem::temp_directory_path() / "pdcpp-host-XXXXXX").string();
+        if (mkdtemp(pattern.data()) == nullptr)
+            { throw std::runtime_error("Couldn't create a temporary data directory"); }
+        return pattern;
+    }
+}
+
+pdcpp::HostPlaydateAPI::HostPlaydateAPI()
+    : HostPlaydateAPI(Options())
+{}
+
+pdcpp::HostPlaydateAPI::HostPlaydateAPI(Options options)
+{
+    if (host::Context::current != nullptr)
+        { throw std::logic_error("Only one HostPlaydateAPI may exist at a time"); }
+
+    p_Context = std::make_unique<host::Context>();
+    host::Context::current = p_Context.get();
+    auto& ctx = *p_Context;
+
+    ctx.system.manualClock = options.clockMode == ClockMode::Manual;
+    ctx.system.echoLogs = options.echoLogs;
+
+    ctx.files.bundleDirectory = options.bundleDirectory;
+    if (options.dataDirectory.empty())
+    {
+        ctx.files.dataDirectory = makeTemporaryDirectory();
+        ctx.files.ownsDataDirectory = true;
+    }
+    else
+    {
+        std::filesystem::create_directories(options.dataDirectory);
+        ctx.files.dataDirectory = options.dataDirectory;
+    }
+
+    host::populateSystemAPI(ctx.systemAPI);
+    host::populateFileAPI(ctx.fileAPI);
+    host::populateGraphicsAPI(ctx.graphicsAPI, ctx.videoAPI);
+    host::populateFontAPI(ctx.graphicsAPI);
+    host::populateSpriteAPI(ctx.spriteAPI);
+    host::populateDisplayAPI(ctx.displayAPI);
+    host::populateSoundAPI(ctx.soundAPI);
+
+    ctx.api.system = &ctx.systemAPI;
+    ctx.api.file = &ctx.fileAPI;
+    ctx.api.graphics = &ctx.graphicsAPI;
+    ctx.api.sprite = &ctx.spriteAPI;
+    ctx.api.display = &ctx.displayAPI;
+    ctx.api.sound = &ctx.soundAPI.sound;
+
+    // There's no Lua runtime, JSON, or scoreboards on the host.
+    ctx.api.lua = nullptr;
+    ctx.api.json = nullptr;
+    ctx.api.scoreboards = nullptr;
+}
+
+pdcpp::HostPlaydateAPI::~HostPlaydateAPI()
+{
+    p_Context.reset();
+    host::Context::current = nullptr;
+}
+
+PlaydateAPI* pdcpp::HostPlaydateAPI::get() const { return &p_Context->api; }
+
+pdcpp::HostPlaydateAPI::operator PlaydateAPI*() const { return get(); }
+
+int pdcpp::HostPlaydateAPI::runFrame()
+{
+    auto& sys = p_Context->system;
+    auto result = 0;
+    if (sys.updateCallback != nullptr)
+    {
+        result = sys.updateCallback(sys.updateUserdata);
+        if (result != 0)
+            { host::presentFrame(); }
+    }
+
+    sys.pushedButtons = 0;
+    sys.releasedButtons = 0;
+
+    auto now = sys.nowMicros();
+    if (sys.frameCount > 0 && now > sys.lastFrameMicros)
+        { sys.framesPerSecond = 1000000.0f / static_cast<float>(now - sys.lastFrameMicros); }
+    sys.lastFrameMicros = now;
+    ++sys.frameCount;
+
+    return result;
+}
+
+void pdcpp::HostPlaydateAPI::runFrames(int nFrames)
+{
+    for (int i = 0; i < nFrames; ++i)
+        { runFrame(); }
+}
+
+uint64_t pdcpp::HostPlaydateAPI::getFrameCount() const { return p_Context->system.frameCount; }
+
+void pdcpp::HostPlaydateAPI::advanceTime(uint32_t milliseconds)
+{
+    auto& sys = p_Context->system;
+    if (sys.manualClock)
+        { sys.manualMicros += static_cast<uint64_t>(milliseconds) * 1000; }
+}
+
+void pdcpp::HostPlaydateAPI::setButtonState(PDButtons buttons)
+{
+    auto& sys = p_Context->system;
+    auto changed = sys.currentButtons ^ static_cast<int>(buttons);
+    auto pressed = changed & static_cast<int>(buttons);
+    auto released = changed & ~static_cast<int>(buttons);
+
+    sys.currentButtons = static_cast<int>(buttons);
+    sys.pushedButtons |= pressed;
+    sys.releasedButtons |= released;
+
+    if (sys.buttonCallback == nullptr)
+        { return; }
+
+    auto when = static_cast<uint32_t>(sys.nowMicros() / 1000);
+    for (int bit = kButtonLeft; bit <= kButtonA; bit <<= 1)
+    {
+        if ((changed & bit) != 0)
+            { sys.buttonCallback(static_cast<PDButtons>(bit), (pressed & bit) != 0, when, sys.buttonUserdata); }
+    }
+}
+
+void pdcpp::HostPlaydateAPI::pressButtons(PDButtons buttons)
+    { setButtonState(static_cast<PDButtons>(p_Context->system.currentButtons | buttons)); }
+
+void pdcpp::HostPlaydateAPI::releaseButtons(PDButtons buttons)
+    { setButtonState(static_cast<PDButtons>(p_Context->system.currentButtons & ~buttons)); }
+
+void pdcpp::HostPlaydateAPI::setCrankAngle(float degrees)
+{
+    auto& sys = p_Context->system;
+    auto angle = std::fmod(degrees, 360.0f);
+    if (angle < 0.0f)
+        { angle += 360.0f; }
+
+    auto delta = std::fmod(angle - sys.crankAngle + 540.0f, 360.0f) - 180.0f;
+    sys.crankChange += delta;
+    sys.crankAngle = angle;
+}
+
+void pdcpp::HostPlaydateAPI::setCrankDocked(bool docked) { p_Context->system.crankDocked = docked; }
+
+void pdcpp::HostPlaydateAPI::setAccelerometer(float x, float y, float z)
+{
+    auto& accelerometer = p_Context->system.accelerometer;
+    accelerometer[0] = x;
+    accelerometer[1] = y;
+    accelerometer[2] = z;
+}
+
+bool pdcpp::HostPlaydateAPI::selectMenuItem(int index)
+{
+    auto& items = p_Context->system.menuItems;
+    if (index < 0 || index >= static_cast<int>(items.size()))
+        { return false; }
+
+    auto& item = *items[static_cast<size_t>(index)];
+    if (item.type == PDMenuItem::Type::Checkmark)
+        { item.value = item.value != 0 ? 0 : 1; }
+    else if (item.type == PDMenuItem::Type::Options && !item.options.empty())
+        { item.value = (item.value + 1) % static_cast<int>(item.options.size()); }
+
+    if (item.callback != nullptr)
+        { item.callback(item.userdata); }
+    return true;
+}
+
+void pdcpp::HostPlaydateAPI::sendSerialMessage(const std::string& message)
+{
+    if (p_Context->system.serialCallback != nullptr)
+        { p_Context->system.serialCallback(message.c_str()); }
+}
+
+const uint8_t* pdcpp::HostPlaydateAPI::getFrameBuffer() const { return p_Context->graphics.frame.data->data(); }
+
+const uint8_t* pdcpp::HostPlaydateAPI::getDisplayBuffer() const
+    { return p_Context->graphics.displayFrame.data->data(); }
+
+LCDSolidColor pdcpp::HostPlaydateAPI::getPixel(int x, int y) const
+{
+    auto& frame = p_Context->graphics.frame;
+    if (x < 0 || y < 0 || x >= frame.width || y >= frame.height)
+        { return kColorWhite; }
+    return frame.getPixel(x, y) ? kColorWhite : kColorBlack;
+}
+
+bool pdcpp::HostPlaydateAPI::writeScreenshot(const std::filesystem::path& path) const
+{
+    auto& frame = p_Context->graphics.displayFrame;
+    auto file = std::fopen(path.string().c_str(), "wb");
+    if (file == nullptr)
+        { return false; }
+
+    // PBM rows are padded to whole bytes, and set bits are black.
+    std::fprintf(file, "P4\n%d %d\n", frame.width, frame.height);
+    std::vector<uint8_t> row(static_cast<size_t>((frame.width + 7) / 8));
+    auto ok = true;
+    for (int y = 0; y < frame.height && ok; ++y)
+    {
+        for (size_t i = 0; i < row.size(); ++i)
+            { row[i] = static_cast<uint8_t>(~(*frame.data)[static_cast<size_t>(y * frame.rowBytes) + i]); }
+        ok = std::fwrite(row.data(), 1, row.size(), file) == row.size();
+    }
+
+    return std::fclose(file) == 0 && ok;
+}
+
+void pdcpp::HostPlaydateAPI::renderAudio(int16_t* left, int16_t* right, int nFrames)
+    { host::renderSound(left, right, nFrames); }
+
+void pdcpp::HostPlaydateAPI::pushMicrophoneSamples(int16_t* samples, int length)
+{
+    auto& sound = p_Context->sound;
+    if (sound.micCallback != nullptr && sound.micCallback(sound.micContext, samples, length) == 0)
+        { sound.micCallback = nullptr; }
+}
+
+void pdcpp::HostPlaydateAPI::setErrorHandler(std::function<void(const std::string&)> handler)
+    { p_Context->system.errorHandler = std::move(handler); }
+
+int pdcpp::HostPlaydateAPI::getErrorCount() const { return p_Context->system.errorCount; }
+
+const std::string& pdcpp::HostPlaydateAPI::getLastError() const { return p_Context->system.lastError; }
+
+const std::filesystem::path& pdcpp::HostPlaydateAPI::getDataDirectory() const
+    { return p_Context->files.dataDirectory; }
+
+int pdcpp::HostPlaydateAPI::getLiveBitmapCount() const
+    { return static_cast<int>(p_Context->graphics.bitmaps.size()); }
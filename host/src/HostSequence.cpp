@@ -0,0 +1,630 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#include "HostContext.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+namespace
+{
+    using pdcpp::host::context;
+    using pdcpp::host::k_SampleRate;
+
+    auto& state() { return context().sound; }
+
+    //==========================================================================
+    // playdate->sound->controlsignal
+    ControlSignal* newControlSignal() { return state().track(new ControlSignal); }
+    void freeControlSignal(ControlSignal* signal) { state().destroy(signal, "freeSignal"); }
+    void clearEvents(ControlSignal* control) { control->events.clear(); }
+
+    void addEvent(ControlSignal* control, int step, float value, int interpolate)
+        { control->events[step] = {value, interpolate != 0}; }
+
+    void removeEvent(ControlSignal* control, int step) { control->events.erase(step); }
+    int getMIDIControllerNumber(ControlSignal* control) { return control->controller; }
+
+    //==========================================================================
+    // playdate->sound->track
+    SequenceTrack* newTrack() { return state().track(new SequenceTrack); }
+
+    void freeTrack(SequenceTrack* track)
+    {
+        auto signals = track->signals;
+        if (!state().destroy(track, "freeTrack"))
+            { return; }
+
+        for (auto signal : signals)
+            { state().destroy(signal, "freeTrack"); }
+    }
+
+    void setInstrument(SequenceTrack* track, PDSynthInstrument* inst) { track->instrument = inst; }
+    PDSynthInstrument* getInstrument(SequenceTrack* track) { return track->instrument; }
+
+    void addNoteEvent(SequenceTrack* track, uint32_t step, uint32_t len, MIDINote note, float velocity)
+        { track->notes.emplace(step, SequenceTrack::Note {len, note, velocity}); }
+
+    void removeNoteEvent(SequenceTrack* track, uint32_t step, MIDINote note)
+    {
+        auto [begin, end] = track->notes.equal_range(step);
+        for (auto it = begin; it != end; ++it)
+        {
+            if (it->second.note == note)
+            {
+                track->notes.erase(it);
+                return;
+            }
+        }
+    }
+
+    void clearNotes(SequenceTrack* track) { track->notes.clear(); }
+    int getControlSignalCount(SequenceTrack* track) { return static_cast<int>(track->signals.size()); }
+
+    ControlSignal* getControlSignal(SequenceTrack* track, int idx)
+    {
+        return idx >= 0 && idx < static_cast<int>(track->signals.size())
+            ? track->signals[static_cast<size_t>(idx)]
+            : nullptr;
+    }
+
+    void clearControlEvents(SequenceTrack* track)
+    {
+        for (auto signal : track->signals)
+            { signal->events.clear(); }
+    }
+
+    int getPolyphony(SequenceTrack* track)
+    {
+        // Sweep the note starts and ends, counting the most sounding at once.
+        std::vector<std::pair<uint32_t, int>> edges;
+        for (auto& [step, note] : track->notes)
+        {
+            edges.emplace_back(step, 1);
+            edges.emplace_back(step + note.length, -1);
+        }
+        std::sort(edges.begin(), edges.end());
+
+        int current = 0;
+        int most = 0;
+        for (auto& [step, change] : edges)
+        {
+            current += change;
+            most = std::max(most, current);
+        }
+        return most;
+    }
+
+    int trackActiveVoiceCount(SequenceTrack* track)
+    {
+        return track->instrument != nullptr
+            ? context().soundAPI.instrument.activeVoiceCount(track->instrument)
+            : 0;
+    }
+
+    void setMuted(SequenceTrack* track, int mute) { track->muted = mute != 0; }
+    uint32_t trackGetLength(SequenceTrack* track) { return track->length(); }
+
+    int getIndexForStep(SequenceTrack* track, uint32_t step)
+        { return static_cast<int>(std::distance(track->notes.begin(), track->notes.lower_bound(step))); }
+
+    int getNoteAtIndex(SequenceTrack* track, int index, uint32_t* outStep, uint32_t* outLen, MIDINote* outNote,
+                       float* outVelocity)
+    {
+        if (index < 0 || index >= static_cast<int>(track->notes.size()))
+            { return 0; }
+
+        auto it = std::next(track->notes.begin(), index);
+        if (outStep != nullptr) { *outStep = it->first; }
+        if (outLen != nullptr) { *outLen = it->second.length; }
+        if (outNote != nullptr) { *outNote = it->second.note; }
+        if (outVelocity != nullptr) { *outVelocity = it->second.velocity; }
+        return 1;
+    }
+
+    ControlSignal* getSignalForController(SequenceTrack* track, int controller, int create)
+        { return track->signalForController(controller, create != 0); }
+
+    //==========================================================================
+    // playdate->sound->sequence
+    SoundSequence* newSequence() { return state().track(new SoundSequence); }
+
+    void freeSequence(SoundSequence* seq)
+    {
+        std::vector<SequenceTrack*> owned;
+        for (auto& [index, track] : seq->tracks)
+        {
+            if (track->owner == seq)
+                { owned.push_back(track); }
+        }
+
+        if (!state().destroy(seq, "freeSequence"))
+            { return; }
+
+        for (auto track : owned)
+            { freeTrack(track); }
+    }
+
+    void allNotesOff(SoundSequence* seq)
+    {
+        for (auto& [index, track] : seq->tracks)
+        {
+            if (track->instrument != nullptr)
+                { context().soundAPI.instrument.allNotesOff(track->instrument, 0); }
+        }
+    }
+
+    double stepsToFrames(const SoundSequence* seq, double steps)
+        { return seq->tempo > 0.0f ? steps / seq->tempo * k_SampleRate : 0.0; }
+
+    double framesToSteps(const SoundSequence* seq, double frames) { return frames * seq->tempo / k_SampleRate; }
+
+    uint32_t getTime(SoundSequence* seq) { return static_cast<uint32_t>(stepsToFrames(seq, seq->currentStep)); }
+    void setTime(SoundSequence* seq, uint32_t time) { seq->currentStep = framesToSteps(seq, time); }
+
+    void setLoops(SoundSequence* seq, int loopstart, int loopend, int loops)
+    {
+        seq->looping = true;
+        seq->loopStart = std::max(loopstart, 0);
+        seq->loopEnd = std::max(loopend, 0);
+        seq->loops = std::max(loops, 0);
+        seq->loopsPlayed = 0;
+    }
+
+    int getTempoDeprecated(SoundSequence* seq) { return static_cast<int>(seq->tempo); }
+    void setTempo(SoundSequence* seq, float stepsPerSecond) { seq->tempo = std::max(stepsPerSecond, 0.0f); }
+    float getTempo(SoundSequence* seq) { return seq->tempo; }
+    int getTrackCount(SoundSequence* seq) { return static_cast<int>(seq->tracks.size()); }
+
+    SequenceTrack* addTrack(SoundSequence* seq)
+    {
+        auto index = seq->tracks.empty() ? 0u : seq->tracks.rbegin()->first + 1;
+        auto track = newTrack();
+        track->owner = seq;
+        seq->tracks[index] = track;
+        return track;
+    }
+
+    SequenceTrack* getTrackAtIndex(SoundSequence* seq, unsigned int index)
+    {
+        auto found = seq->tracks.find(index);
+        return found != seq->tracks.end() ? found->second : nullptr;
+    }
+
+    void setTrackAtIndex(SoundSequence* seq, SequenceTrack* track, unsigned int idx)
+    {
+        auto found = seq->tracks.find(idx);
+        if (found != seq->tracks.end() && found->second->owner == seq)
+            { found->second->owner = nullptr; }
+
+        if (track == nullptr)
+            { seq->tracks.erase(idx); }
+        else
+            { seq->tracks[idx] = track; }
+    }
+
+    int sequenceIsPlaying(SoundSequence* seq) { return seq->playing ? 1 : 0; }
+    uint32_t sequenceGetLength(SoundSequence* seq) { return seq->length(); }
+
+    void play(SoundSequence* seq, SequenceFinishedCallback finishCallback, void* userdata)
+    {
+        seq->finishCallback = finishCallback;
+        seq->finishUserdata = userdata;
+        seq->loopsPlayed = 0;
+
+        // Instruments which aren't in a channel yet get played on the default.
+        for (auto& [index, track] : seq->tracks)
+        {
+            if (track->instrument != nullptr && track->instrument->channel == nullptr)
+                { context().soundAPI.channel.addSource(state().defaultChannel, track->instrument); }
+        }
+
+        if (!seq->playing)
+        {
+            seq->playing = true;
+            state().sequences.push_back(seq);
+        }
+    }
+
+    void stop(SoundSequence* seq)
+    {
+        if (!seq->playing)
+            { return; }
+
+        seq->playing = false;
+        auto& sequences = state().sequences;
+        sequences.erase(std::remove(sequences.begin(), sequences.end(), seq), sequences.end());
+        allNotesOff(seq);
+    }
+
+    int getCurrentStep(SoundSequence* seq, int* timeOffset)
+    {
+        auto step = std::floor(seq->currentStep);
+        if (timeOffset != nullptr)
+            { *timeOffset = static_cast<int>(stepsToFrames(seq, seq->currentStep - step)); }
+        return static_cast<int>(step);
+    }
+
+    void setCurrentStep(SoundSequence* seq, int step, int timeOffset, int playNotes)
+    {
+        seq->currentStep = std::max(step, 0) + framesToSteps(seq, timeOffset);
+        if (playNotes == 0)
+            { return; }
+
+        // Start anything which should already be sounding at the new position.
+        for (auto& [index, track] : seq->tracks)
+        {
+            if (track->muted || track->instrument == nullptr)
+                { continue; }
+
+            for (auto& [start, note] : track->notes)
+            {
+                if (start > seq->currentStep)
+                    { break; }
+
+                auto remaining = start + note.length - seq->currentStep;
+                if (remaining > 0.0)
+                {
+                    track->instrument->playNote(note.note, note.velocity,
+                                                static_cast<float>(remaining / seq->tempo), 0);
+                }
+            }
+        }
+    }
+
+    //==========================================================================
+    // Standard MIDI files
+    struct MIDIReader
+    {
+        const uint8_t* data;
+        size_t size;
+        size_t pos = 0;
+
+        [[ nodiscard ]] bool atEnd() const { return pos >= size; }
+        uint8_t byte() { return pos < size ? data[pos++] : 0; }
+
+        uint32_t bigEndian(int bytes)
+        {
+            uint32_t result = 0;
+            for (int i = 0; i < bytes; ++i)
+                { result = (result << 8) | byte(); }
+            return result;
+        }
+
+        uint32_t variableLength()
+        {
+            uint32_t result = 0;
+            for (int i = 0; i < 4; ++i)
+            {
+                auto b = byte();
+                result = (result << 7) | (b & 0x7f);
+                if ((b & 0x80) == 0)
+                    { break; }
+            }
+            return result;
+        }
+    };
+
+    bool parseMIDI(SoundSequence* seq, const std::vector<uint8_t>& bytes)
+    {
+        MIDIReader file {bytes.data(), bytes.size()};
+        if (bytes.size() < 14 || std::memcmp(bytes.data(), "MThd", 4) != 0)
+            { return false; }
+
+        file.pos = 4;
+        auto headerLength = file.bigEndian(4);
+        file.bigEndian(2);
+        auto trackCount = file.bigEndian(2);
+        auto division = file.bigEndian(2);
+        file.pos = 8 + headerLength;
+
+        // SMPTE timing isn't supported.
+        if ((division & 0x8000) != 0 || division == 0)
+            { return false; }
+
+        // Steps are ticks; start at the MIDI default of 120 bpm.
+        seq->tempo = static_cast<float>(division) * 2.0f;
+
+        // Tracks are created per MIDI channel, so both format 0 and 1 files
+        // come out with one track per part.
+        std::map<int, SequenceTrack*> channels;
+        auto trackFor = [&](int channel)
+        {
+            auto& track = channels[channel];
+            if (track == nullptr)
+                { track = addTrack(seq); }
+            return track;
+        };
+
+        for (uint32_t t = 0; t < trackCount && file.pos + 8 <= file.size; ++t)
+        {
+            auto isTrack = std::memcmp(file.data + file.pos, "MTrk", 4) == 0;
+            file.pos += 4;
+            auto length = file.bigEndian(4);
+            auto end = std::min(file.size, file.pos + length);
+            if (!isTrack)
+            {
+                file.pos = end;
+                continue;
+            }
+
+            MIDIReader chunk {file.data, end, file.pos};
+            uint32_t tick = 0;
+            uint8_t status = 0;
+            std::map<std::pair<int, int>, std::pair<uint32_t, float>> sounding;
+
+            while (!chunk.atEnd())
+            {
+                tick += chunk.variableLength();
+                auto b = chunk.byte();
+                if ((b & 0x80) != 0)
+                    { status = b; }
+                else
+                    { --chunk.pos; }
+
+                if (status == 0xff)
+                {
+                    auto type = chunk.byte();
+                    auto len = chunk.variableLength();
+                    if (type == 0x51 && len == 3)
+                    {
+                        auto usPerQuarter = chunk.bigEndian(3);
+                        if (usPerQuarter > 0)
+                            { seq->tempo = static_cast<float>(division) * 1.0e6f / static_cast<float>(usPerQuarter); }
+                        len = 0;
+                    }
+                    chunk.pos += len;
+                    status = 0;
+                    continue;
+                }
+                if (status == 0xf0 || status == 0xf7)
+                {
+                    chunk.pos += chunk.variableLength();
+                    status = 0;
+                    continue;
+                }
+
+                auto kind = status & 0xf0;
+                auto channel = status & 0x0f;
+                auto a = chunk.byte();
+                auto v = (kind == 0xc0 || kind == 0xd0) ? 0 : chunk.byte();
+
+                if (kind == 0x90 && v > 0)
+                {
+                    sounding[{channel, a}] = {tick, v / 127.0f};
+                }
+                else if (kind == 0x80 || kind == 0x90)
+                {
+                    auto found = sounding.find({channel, a});
+                    if (found != sounding.end())
+                    {
+                        auto [start, velocity] = found->second;
+                        addNoteEvent(trackFor(channel), start, std::max(tick - start, 1u), a, velocity);
+                        sounding.erase(found);
+                    }
+                }
+                else if (kind == 0xb0)
+                {
+                    auto signal = trackFor(channel)->signalForController(a, true);
+                    addEvent(signal, static_cast<int>(tick), v / 127.0f, 0);
+                }
+            }
+
+            file.pos = end;
+        }
+
+        return true;
+    }
+
+    int loadMIDIFile(SoundSequence* seq, const char* path)
+    {
+        auto found = pdcpp::host::findReadablePath(path, kFileRead | kFileReadData);
+        if (!found)
+        {
+            state().lastError = std::string("File not found: ") + path;
+            return 0;
+        }
+
+        std::ifstream stream(*found, std::ios::binary);
+        std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+        if (!parseMIDI(seq, bytes))
+        {
+            state().lastError = std::string("Couldn't parse MIDI file: ") + path;
+            return 0;
+        }
+        return 1;
+    }
+}
+
+//==============================================================================
+float ControlSignal::step(int)
+{
+    if (events.empty())
+        { return 0.0f; }
+
+    auto next = events.upper_bound(static_cast<int>(std::floor(currentStep)));
+    if (next == events.begin())
+        { return next->second.value; }
+
+    auto previous = std::prev(next);
+    if (next == events.end() || !next->second.interpolate)
+        { return previous->second.value; }
+
+    auto t = static_cast<float>((currentStep - previous->first) / (next->first - previous->first));
+    return previous->second.value + (next->second.value - previous->second.value) * t;
+}
+
+//==============================================================================
+void SequenceTrack::forget(pdcpp::host::SoundObject* dying)
+{
+    if (instrument == dying) { instrument = nullptr; }
+    if (owner == dying) { owner = nullptr; }
+    signals.erase(std::remove(signals.begin(), signals.end(), dying), signals.end());
+}
+
+uint32_t SequenceTrack::length() const
+{
+    uint32_t result = 0;
+    for (auto& [step, note] : notes)
+        { result = std::max(result, step + note.length); }
+    for (auto signal : signals)
+    {
+        if (!signal->events.empty())
+            { result = std::max(result, static_cast<uint32_t>(signal->events.rbegin()->first)); }
+    }
+    return result;
+}
+
+ControlSignal* SequenceTrack::signalForController(int controller, bool create)
+{
+    for (auto signal : signals)
+    {
+        if (signal->controller == controller)
+            { return signal; }
+    }
+
+    if (!create)
+        { return nullptr; }
+
+    auto signal = context().sound.track(new ControlSignal);
+    signal->controller = controller;
+    signals.push_back(signal);
+    return signal;
+}
+
+//==============================================================================
+void SoundSequence::forget(pdcpp::host::SoundObject* dying)
+{
+    for (auto it = tracks.begin(); it != tracks.end();)
+        { it = it->second == dying ? tracks.erase(it) : std::next(it); }
+}
+
+uint32_t SoundSequence::length() const
+{
+    uint32_t result = 0;
+    for (auto& [index, track] : tracks)
+        { result = std::max(result, track->length()); }
+    return result;
+}
+
+void SoundSequence::advance(int nFrames)
+{
+    if (!playing || tempo <= 0.0f)
+        { return; }
+
+    auto now = pdcpp::host::soundTime();
+    auto framesPerStep = k_SampleRate / static_cast<double>(tempo);
+    auto remaining = static_cast<double>(nFrames) / framesPerStep;
+    auto elapsed = 0.0;
+
+    while (remaining > 0.0 && playing)
+    {
+        auto end = looping && loopEnd > loopStart ? static_cast<double>(loopEnd) : static_cast<double>(length());
+        auto span = std::min(remaining, std::max(end - currentStep, 0.0));
+
+        // Schedule every note which starts inside this span.
+        for (auto& [index, track] : tracks)
+        {
+            for (auto signal : track->signals)
+                { signal->currentStep = currentStep; }
+
+            if (track->muted || track->instrument == nullptr)
+                { continue; }
+
+            auto first = track->notes.lower_bound(static_cast<uint32_t>(std::ceil(currentStep)));
+            for (auto it = first; it != track->notes.end() && it->first < currentStep + span; ++it)
+            {
+                auto offset = (elapsed + it->first - currentStep) * framesPerStep;
+                auto when = now + static_cast<uint32_t>(offset);
+                track->instrument->playNote(it->second.note, it->second.velocity,
+                                            static_cast<float>(it->second.length / tempo), when);
+            }
+        }
+
+        currentStep += span;
+        remaining -= span;
+        elapsed += span;
+
+        if (currentStep < end)
+            { continue; }
+
+        if (looping && (loops == 0 || ++loopsPlayed < loops))
+        {
+            currentStep = loopStart;
+            if (span <= 0.0 && end <= loopStart)
+                { break; }
+            continue;
+        }
+
+        playing = false;
+        auto& sequences = context().sound.sequences;
+        sequences.erase(std::remove(sequences.begin(), sequences.end(), this), sequences.end());
+        if (finishCallback != nullptr)
+        {
+            pdcpp::host::deferCallback(this, [this, callback = finishCallback, userdata = finishUserdata]()
+                { callback(this, userdata); });
+        }
+    }
+}
+
+void pdcpp::host::populateSequenceAPI(SoundTables& tables)
+{
+    auto& controlsignal = tables.controlsignal;
+    controlsignal.newSignal = newControlSignal;
+    controlsignal.freeSignal = freeControlSignal;
+    controlsignal.clearEvents = clearEvents;
+    controlsignal.addEvent = addEvent;
+    controlsignal.removeEvent = removeEvent;
+    controlsignal.getMIDIControllerNumber = getMIDIControllerNumber;
+
+    auto& track = tables.track;
+    track.newTrack = newTrack;
+    track.freeTrack = freeTrack;
+    track.setInstrument = setInstrument;
+    track.getInstrument = getInstrument;
+    track.addNoteEvent = addNoteEvent;
+    track.removeNoteEvent = removeNoteEvent;
+    track.clearNotes = clearNotes;
+    track.getControlSignalCount = getControlSignalCount;
+    track.getControlSignal = getControlSignal;
+    track.clearControlEvents = clearControlEvents;
+    track.getPolyphony = getPolyphony;
+    track.activeVoiceCount = trackActiveVoiceCount;
+    track.setMuted = setMuted;
+    track.getLength = trackGetLength;
+    track.getIndexForStep = getIndexForStep;
+    track.getNoteAtIndex = getNoteAtIndex;
+    track.getSignalForController = getSignalForController;
+
+    auto& sequence = tables.sequence;
+    sequence.newSequence = newSequence;
+    sequence.freeSequence = freeSequence;
+    sequence.loadMIDIFile = loadMIDIFile;
+    sequence.getTime = getTime;
+    sequence.setTime = setTime;
+    sequence.setLoops = setLoops;
+    sequence.getTempo_deprecated = getTempoDeprecated;
+    sequence.setTempo = setTempo;
+    sequence.getTrackCount = getTrackCount;
+    sequence.addTrack = addTrack;
+    sequence.getTrackAtIndex = getTrackAtIndex;
+    sequence.setTrackAtIndex = setTrackAtIndex;
+    sequence.allNotesOff = allNotesOff;
+    sequence.isPlaying = sequenceIsPlaying;
+    sequence.getLength = sequenceGetLength;
+    sequence.play = play;
+    sequence.stop = stop;
+    sequence.getCurrentStep = getCurrentStep;
+    sequence.setCurrentStep = setCurrentStep;
+    sequence.getTempo = getTempo;
+}
@@ -0,0 +1,936 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#include "HostContext.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+namespace
+{
+    using pdcpp::host::context;
+    using pdcpp::host::k_BlockSize;
+    using pdcpp::host::k_SampleRate;
+    using pdcpp::host::k_Unity;
+
+    auto& state() { return context().sound; }
+
+    int32_t toFixed(float value) { return static_cast<int32_t>(value * k_Unity); }
+
+    int16_t toPCM(int32_t value)
+        { return static_cast<int16_t>(std::clamp(value >> 9, -32768, 32767)); }
+
+    template <typename T>
+    void removeFrom(std::vector<T*>& items, const pdcpp::host::SoundObject* item)
+        { items.erase(std::remove(items.begin(), items.end(), item), items.end()); }
+
+    bool detachSource(SoundSource* source)
+    {
+        if (source->channel == nullptr)
+            { return false; }
+
+        removeFrom(source->channel->sources, source);
+        source->channel = nullptr;
+        return true;
+    }
+
+    //==========================================================================
+    uint16_t readU16(const uint8_t* p) { return static_cast<uint16_t>(p[0] | (p[1] << 8)); }
+    uint32_t readU32(const uint8_t* p)
+        { return static_cast<uint32_t>(p[0] | (p[1] << 8) | (p[2] << 16)) | (static_cast<uint32_t>(p[3]) << 24); }
+
+    std::unique_ptr<AudioSample> makeSample(const uint8_t* data, size_t size, SoundFormat format, uint32_t rate)
+    {
+        auto sample = std::make_unique<AudioSample>();
+        sample->data = static_cast<uint8_t*>(std::malloc(std::max<size_t>(size, 1)));
+        std::memcpy(sample->data, data, size);
+        sample->ownsData = true;
+        sample->format = format;
+        sample->sampleRate = rate;
+        sample->byteLength = static_cast<uint32_t>(size);
+        return sample;
+    }
+
+    std::unique_ptr<AudioSample> parseWAV(const std::vector<uint8_t>& bytes)
+    {
+        if (bytes.size() < 12 || std::memcmp(bytes.data(), "RIFF", 4) != 0
+                || std::memcmp(bytes.data() + 8, "WAVE", 4) != 0)
+            { return nullptr; }
+
+        int channels = 0;
+        int bits = 0;
+        uint32_t rate = 0;
+        for (size_t pos = 12; pos + 8 <= bytes.size();)
+        {
+            auto id = bytes.data() + pos;
+            auto size = static_cast<size_t>(readU32(id + 4));
+            auto body = pos + 8;
+            size = std::min(size, bytes.size() - body);
+
+            if (std::memcmp(id, "fmt ", 4) == 0 && size >= 16)
+            {
+                // Only uncompressed PCM.
+                if (readU16(id + 8) != 1)
+                    { return nullptr; }
+                channels = readU16(id + 10);
+                rate = readU32(id + 12);
+                bits = readU16(id + 22);
+            }
+            else if (std::memcmp(id, "data", 4) == 0)
+            {
+                if ((channels != 1 && channels != 2) || (bits != 8 && bits != 16))
+                    { return nullptr; }
+
+                auto stereo = channels == 2;
+                auto format = bits == 8
+                    ? (stereo ? kSound8bitStereo : kSound8bitMono)
+                    : (stereo ? kSound16bitStereo : kSound16bitMono);
+                auto sample = makeSample(bytes.data() + body, size, format, rate);
+
+                // WAV stores 8-bit audio unsigned, the Playdate signed.
+                if (bits == 8)
+                {
+                    for (uint32_t i = 0; i < sample->byteLength; ++i)
+                        { sample->data[i] ^= 0x80; }
+                }
+                return sample;
+            }
+
+            pos = body + size + (size & 1);
+        }
+
+        return nullptr;
+    }
+
+    std::unique_ptr<AudioSample> parsePDA(const std::vector<uint8_t>& bytes)
+    {
+        constexpr size_t k_HeaderSize = 16;
+        if (bytes.size() < k_HeaderSize || std::memcmp(bytes.data(), "Playdate AUD", 12) != 0)
+            { return nullptr; }
+
+        auto rate = static_cast<uint32_t>(bytes[12] | (bytes[13] << 8) | (bytes[14] << 16));
+        auto format = static_cast<SoundFormat>(bytes[15]);
+        if (format > kSound16bitStereo)
+            { return nullptr; }
+
+        return makeSample(bytes.data() + k_HeaderSize, bytes.size() - k_HeaderSize, format, rate);
+    }
+
+    //==========================================================================
+    // playdate->sound->source
+    void sourceSetVolume(SoundSource* c, float lvol, float rvol)
+    {
+        c->leftVolume = lvol;
+        c->rightVolume = rvol;
+    }
+
+    void sourceGetVolume(SoundSource* c, float* outl, float* outr)
+    {
+        if (outl != nullptr) { *outl = c->leftVolume; }
+        if (outr != nullptr) { *outr = c->rightVolume; }
+    }
+
+    int sourceIsPlaying(SoundSource* c) { return c->isPlaying() ? 1 : 0; }
+
+    void sourceSetFinishCallback(SoundSource* c, sndCallbackProc callback, void* userdata)
+    {
+        c->finishCallback = callback;
+        c->finishUserdata = userdata;
+    }
+
+    //==========================================================================
+    // playdate->sound->sample
+    AudioSample* newSampleBuffer(int byteCount)
+    {
+        auto sample = new AudioSample;
+        sample->data = static_cast<uint8_t*>(std::calloc(std::max(byteCount, 1), 1));
+        sample->ownsData = true;
+        sample->byteLength = static_cast<uint32_t>(std::max(byteCount, 0));
+        return state().track(sample);
+    }
+
+    int loadIntoSample(AudioSample* sample, const char* path)
+    {
+        auto loaded = pdcpp::host::loadAudioFile(path);
+        if (loaded == nullptr)
+            { return 0; }
+
+        if (sample->ownsData)
+            { std::free(sample->data); }
+
+        sample->data = std::exchange(loaded->data, nullptr);
+        sample->ownsData = true;
+        sample->format = loaded->format;
+        sample->sampleRate = loaded->sampleRate;
+        sample->byteLength = loaded->byteLength;
+        return 1;
+    }
+
+    AudioSample* loadSample(const char* path)
+    {
+        auto loaded = pdcpp::host::loadAudioFile(path);
+        return loaded != nullptr ? state().track(loaded.release()) : nullptr;
+    }
+
+    AudioSample* newSampleFromData(uint8_t* data, SoundFormat format, uint32_t sampleRate, int byteCount, int shouldFreeData)
+    {
+        auto sample = new AudioSample;
+        sample->data = data;
+        sample->ownsData = shouldFreeData != 0;
+        sample->format = format;
+        sample->sampleRate = sampleRate;
+        sample->byteLength = static_cast<uint32_t>(std::max(byteCount, 0));
+        return state().track(sample);
+    }
+
+    void getSampleData(AudioSample* sample, uint8_t** data, SoundFormat* format, uint32_t* sampleRate, uint32_t* bytelength)
+    {
+        if (data != nullptr) { *data = sample->data; }
+        if (format != nullptr) { *format = sample->format; }
+        if (sampleRate != nullptr) { *sampleRate = sample->sampleRate; }
+        if (bytelength != nullptr) { *bytelength = sample->byteLength; }
+    }
+
+    void freeSample(AudioSample* sample) { state().destroy(sample, "freeSample"); }
+
+    float getSampleLength(AudioSample* sample)
+        { return static_cast<float>(sample->frameCount()) / static_cast<float>(sample->sampleRate); }
+
+    // Nothing is ever compressed on the host.
+    int decompress(AudioSample*) { return 1; }
+
+    //==========================================================================
+    // playdate->sound->sampleplayer
+    SamplePlayer* newSamplePlayer() { return state().track(new SamplePlayer); }
+
+    void freeSamplePlayer(SamplePlayer* player) { state().destroy(player, "freePlayer"); }
+
+    void setPlayerSample(SamplePlayer* player, AudioSample* sample)
+    {
+        player->sample = sample;
+        player->position = 0.0;
+        player->rangeStart = 0;
+        player->rangeEnd = 0;
+    }
+
+    int playSample(SamplePlayer* player, int repeat, float rate)
+    {
+        if (player->sample == nullptr)
+            { return 0; }
+
+        player->start(repeat, rate);
+        return 1;
+    }
+
+    int samplePlayerIsPlaying(SamplePlayer* player) { return player->isPlaying() ? 1 : 0; }
+
+    void stopPlayer(SamplePlayer* player)
+    {
+        auto wasPlaying = player->playing;
+        player->playing = false;
+        player->paused = false;
+        if (wasPlaying)
+            { player->finished(); }
+    }
+
+    void samplePlayerSetVolume(SamplePlayer* player, float left, float right) { sourceSetVolume(player, left, right); }
+    void samplePlayerGetVolume(SamplePlayer* player, float* left, float* right) { sourceGetVolume(player, left, right); }
+
+    float samplePlayerGetLength(SamplePlayer* player)
+        { return player->sample != nullptr ? getSampleLength(player->sample) : 0.0f; }
+
+    void samplePlayerSetOffset(SamplePlayer* player, float offset)
+    {
+        if (player->sample != nullptr)
+            { player->position = offset * static_cast<float>(player->sample->sampleRate); }
+    }
+
+    float samplePlayerGetOffset(SamplePlayer* player)
+    {
+        return player->sample != nullptr
+            ? static_cast<float>(player->position / player->sample->sampleRate)
+            : 0.0f;
+    }
+
+    void samplePlayerSetRate(SamplePlayer* player, float rate) { player->rate = rate; }
+    float samplePlayerGetRate(SamplePlayer* player) { return player->rate; }
+
+    void setPlayRange(SamplePlayer* player, int start, int end)
+    {
+        player->rangeStart = std::max(start, 0);
+        player->rangeEnd = std::max(end, 0);
+    }
+
+    void samplePlayerSetFinishCallback(SamplePlayer* player, sndCallbackProc callback, void* userdata)
+        { sourceSetFinishCallback(player, callback, userdata); }
+
+    void samplePlayerSetLoopCallback(SamplePlayer* player, sndCallbackProc callback, void* userdata)
+    {
+        player->loopCallback = callback;
+        player->loopUserdata = userdata;
+    }
+
+    void setPaused(SamplePlayer* player, int flag) { player->paused = flag != 0; }
+
+    //==========================================================================
+    // playdate->sound->fileplayer
+    FilePlayer* newFilePlayer() { return state().track(new FilePlayer); }
+
+    void freeFilePlayer(FilePlayer* player) { state().destroy(player, "freePlayer"); }
+
+    int loadIntoPlayer(FilePlayer* player, const char* path)
+    {
+        auto loaded = pdcpp::host::loadAudioFile(path);
+        if (loaded == nullptr)
+            { return 0; }
+
+        player->loaded = std::move(loaded);
+        setPlayerSample(player, player->loaded.get());
+        return 1;
+    }
+
+    // There's no streaming from disk, so there's no buffer to size.
+    void setBufferLength(FilePlayer*, float) {}
+
+    int playFile(FilePlayer* player, int repeat) { return playSample(player, repeat, player->rate); }
+    int filePlayerIsPlaying(FilePlayer* player) { return player->isPlaying() ? 1 : 0; }
+    void pauseFile(FilePlayer* player) { player->paused = true; }
+    void stopFile(FilePlayer* player) { stopPlayer(player); }
+    void filePlayerSetVolume(FilePlayer* player, float left, float right) { sourceSetVolume(player, left, right); }
+    void filePlayerGetVolume(FilePlayer* player, float* left, float* right) { sourceGetVolume(player, left, right); }
+    float filePlayerGetLength(FilePlayer* player) { return samplePlayerGetLength(player); }
+    void filePlayerSetOffset(FilePlayer* player, float offset) { samplePlayerSetOffset(player, offset); }
+    float filePlayerGetOffset(FilePlayer* player) { return samplePlayerGetOffset(player); }
+    void filePlayerSetRate(FilePlayer* player, float rate) { player->rate = rate; }
+    float filePlayerGetRate(FilePlayer* player) { return player->rate; }
+
+    void setLoopRange(FilePlayer* player, float start, float end)
+    {
+        auto rate = player->sample != nullptr ? static_cast<float>(player->sample->sampleRate) : 0.0f;
+        setPlayRange(player, static_cast<int>(start * rate), static_cast<int>(end * rate));
+    }
+
+    int didUnderrun(FilePlayer*) { return 0; }
+    void setStopOnUnderrun(FilePlayer*, int) {}
+
+    void filePlayerSetFinishCallback(FilePlayer* player, sndCallbackProc callback, void* userdata)
+        { sourceSetFinishCallback(player, callback, userdata); }
+
+    void filePlayerSetLoopCallback(FilePlayer* player, sndCallbackProc callback, void* userdata)
+        { samplePlayerSetLoopCallback(player, callback, userdata); }
+
+    void fadeVolume(FilePlayer* player, float left, float right, int32_t len, sndCallbackProc finishCallback, void* userdata)
+    {
+        player->fadeLeftTarget = left;
+        player->fadeRightTarget = right;
+        player->fadeRemaining = std::max(len, 1);
+        player->fadeCallback = finishCallback;
+        player->fadeUserdata = userdata;
+    }
+
+    void setMP3StreamSource(FilePlayer*, int (*)(uint8_t*, int, void*), void*, float)
+        { state().lastError = "MP3 streaming isn't supported on the host"; }
+
+    //==========================================================================
+    // playdate->sound->channel
+    SoundChannel* newChannel() { return state().track(new SoundChannel); }
+
+    void freeChannel(SoundChannel* channel)
+    {
+        if (channel == state().defaultChannel)
+        {
+            pdcpp::host::reportError("freeChannel called on the default channel");
+            return;
+        }
+        state().destroy(channel, "freeChannel");
+    }
+
+    int channelAddSource(SoundChannel* channel, SoundSource* source)
+    {
+        detachSource(source);
+        channel->sources.push_back(source);
+        source->channel = channel;
+        return 1;
+    }
+
+    int channelRemoveSource(SoundChannel* channel, SoundSource* source)
+        { return source->channel == channel && detachSource(source) ? 1 : 0; }
+
+    SoundSource* addCallbackSource(SoundChannel* channel, AudioSourceFunction* callback, void* ctx, int stereo)
+    {
+        auto source = state().track(new CallbackSource);
+        source->callback = callback;
+        source->context = ctx;
+        source->stereo = stereo != 0;
+        channelAddSource(channel, source);
+        return source;
+    }
+
+    void channelAddEffect(SoundChannel* channel, SoundEffect* effect)
+    {
+        if (effect->channel != nullptr)
+            { removeFrom(effect->channel->effects, effect); }
+
+        channel->effects.push_back(effect);
+        effect->channel = channel;
+    }
+
+    void channelRemoveEffect(SoundChannel* channel, SoundEffect* effect)
+    {
+        if (effect->channel != channel)
+            { return; }
+
+        removeFrom(channel->effects, effect);
+        effect->channel = nullptr;
+    }
+
+    void channelSetVolume(SoundChannel* channel, float volume) { channel->volume = volume; }
+    float channelGetVolume(SoundChannel* channel) { return channel->volume; }
+    void setVolumeModulator(SoundChannel* channel, PDSynthSignalValue* mod) { channel->volumeModulator = mod; }
+    PDSynthSignalValue* getVolumeModulator(SoundChannel* channel) { return channel->volumeModulator; }
+    void setPan(SoundChannel* channel, float pan) { channel->pan = std::clamp(pan, -1.0f, 1.0f); }
+    void setPanModulator(SoundChannel* channel, PDSynthSignalValue* mod) { channel->panModulator = mod; }
+    PDSynthSignalValue* getPanModulator(SoundChannel* channel) { return channel->panModulator; }
+    PDSynthSignalValue* getDryLevelSignal(SoundChannel* channel) { return &channel->dryLevel; }
+    PDSynthSignalValue* getWetLevelSignal(SoundChannel* channel) { return &channel->wetLevel; }
+
+    //==========================================================================
+    // playdate->sound
+    uint32_t getCurrentTime() { return state().time; }
+
+    SoundSource* addSource(AudioSourceFunction* callback, void* ctx, int stereo)
+        { return addCallbackSource(state().defaultChannel, callback, ctx, stereo); }
+
+    SoundChannel* getDefaultChannel() { return state().defaultChannel; }
+
+    int addChannel(SoundChannel* channel)
+    {
+        auto& channels = state().channels;
+        if (channel == state().defaultChannel || std::find(channels.begin(), channels.end(), channel) != channels.end())
+            { return 0; }
+
+        channels.push_back(channel);
+        return 1;
+    }
+
+    int removeChannel(SoundChannel* channel)
+    {
+        auto& channels = state().channels;
+        auto found = std::find(channels.begin(), channels.end(), channel);
+        if (found == channels.end())
+            { return 0; }
+
+        channels.erase(found);
+        return 1;
+    }
+
+    int setMicCallback(RecordCallback* callback, void* ctx, MicSource)
+    {
+        state().micCallback = callback;
+        state().micContext = ctx;
+        return 1;
+    }
+
+    // There are never headphones plugged in to the host.
+    void getHeadphoneState(int* headphone, int* headsetmic, void (*changeCallback)(int headphone, int micinput))
+    {
+        if (headphone != nullptr) { *headphone = 0; }
+        if (headsetmic != nullptr) { *headsetmic = 0; }
+        state().headphoneCallback = changeCallback;
+    }
+
+    void setOutputsActive(int, int) {}
+
+    int removeSource(SoundSource* source) { return detachSource(source) ? 1 : 0; }
+
+    const char* getError()
+        { return state().lastError.empty() ? nullptr : state().lastError.c_str(); }
+}
+
+//==============================================================================
+uint32_t pdcpp::host::soundTime() { return context().sound.time; }
+
+void pdcpp::host::deferCallback(SoundObject* owner, std::function<void()> callback)
+    { context().sound.pendingCallbacks.emplace_back(owner, std::move(callback)); }
+
+//==============================================================================
+float PDSynthSignalValue::getValue()
+{
+    auto now = pdcpp::host::soundTime();
+    if (!started)
+    {
+        started = true;
+        value = step(0);
+    }
+    else if (now != lastTime)
+    {
+        value = step(static_cast<int>(now - lastTime));
+    }
+
+    lastTime = now;
+    return value * scale + offset;
+}
+
+void SoundSource::finished()
+{
+    if (finishCallback == nullptr)
+        { return; }
+
+    pdcpp::host::deferCallback(this, [this, callback = finishCallback, userdata = finishUserdata]()
+        { callback(this, userdata); });
+}
+
+void CallbackSource::render(int32_t* left, int32_t* right, int nFrames)
+{
+    int16_t bufferL[k_BlockSize] = {};
+    int16_t bufferR[k_BlockSize] = {};
+    if (callback == nullptr || callback(context, bufferL, bufferR, nFrames) == 0)
+        { return; }
+
+    auto lv = static_cast<int32_t>(leftVolume * 256.0f);
+    auto rv = static_cast<int32_t>(rightVolume * 256.0f);
+    for (int i = 0; i < nFrames; ++i)
+    {
+        auto l = static_cast<int32_t>(bufferL[i]) << 9;
+        auto r = stereo ? static_cast<int32_t>(bufferR[i]) << 9 : l;
+        left[i] += (l >> 8) * lv;
+        right[i] += (r >> 8) * rv;
+    }
+}
+
+//==============================================================================
+AudioSample::~AudioSample()
+{
+    if (ownsData)
+        { std::free(data); }
+}
+
+int AudioSample::frameCount() const
+{
+    if (format > kSound16bitStereo)
+        { return 0; }
+    return static_cast<int>(byteLength / SoundFormat_bytesPerFrame(format));
+}
+
+void AudioSample::readFrame(int frame, float& left, float& right) const
+{
+    left = right = 0.0f;
+    if (frame < 0 || frame >= frameCount())
+        { return; }
+
+    auto stereo = SoundFormatIsStereo(format) != 0;
+    auto channels = stereo ? 1 : 0;
+    if (SoundFormatIs16bit(format))
+    {
+        auto samples = reinterpret_cast<const int16_t*>(data) + (frame << channels);
+        left = samples[0] / 32768.0f;
+        right = samples[channels] / 32768.0f;
+    }
+    else
+    {
+        auto samples = reinterpret_cast<const int8_t*>(data) + (frame << channels);
+        left = samples[0] / 128.0f;
+        right = samples[channels] / 128.0f;
+    }
+}
+
+//==============================================================================
+void SamplePlayer::start(int repeatCount, float playbackRate)
+{
+    repeat = repeatCount;
+    playsRemaining = std::max(repeatCount, 1);
+    rate = playbackRate;
+    playing = true;
+    paused = false;
+
+    auto end = rangeEnd > 0 ? std::min(rangeEnd, sample->frameCount()) : sample->frameCount();
+    position = rate < 0.0f ? end - 1 : rangeStart;
+}
+
+bool SamplePlayer::wrap(int start, int end)
+{
+    auto length = static_cast<double>(end - start);
+    auto fireLoopCallback = [this]()
+    {
+        if (loopCallback != nullptr)
+        {
+            pdcpp::host::deferCallback(this, [this, callback = loopCallback, userdata = loopUserdata]()
+                { callback(this, userdata); });
+        }
+    };
+
+    if (repeat < 0)
+    {
+        // Ping-pong: reflect off whichever end was hit.
+        position = position >= end ? 2.0 * end - position - 1.0 : 2.0 * start - position;
+        rate = -rate;
+        fireLoopCallback();
+        return true;
+    }
+
+    if (repeat == 0 || --playsRemaining > 0)
+    {
+        position += position >= end ? -length : length;
+        fireLoopCallback();
+        return true;
+    }
+
+    playing = false;
+    finished();
+    return false;
+}
+
+void SamplePlayer::render(int32_t* left, int32_t* right, int nFrames)
+{
+    if (!playing || paused || sample == nullptr)
+        { return; }
+
+    auto frames = sample->frameCount();
+    auto start = std::min(rangeStart, frames);
+    auto end = rangeEnd > 0 ? std::min(rangeEnd, frames) : frames;
+    if (end <= start)
+    {
+        playing = false;
+        finished();
+        return;
+    }
+
+    auto increment = rate * static_cast<double>(sample->sampleRate) / k_SampleRate;
+    for (int i = 0; i < nFrames; ++i)
+    {
+        float l, r;
+        sample->readFrame(static_cast<int>(position), l, r);
+        left[i] += toFixed(l * leftVolume);
+        right[i] += toFixed(r * rightVolume);
+
+        position += increment;
+        if ((position >= end || position < start) && !wrap(start, end))
+            { return; }
+
+        // Ping-pong flips the rate.
+        increment = rate * static_cast<double>(sample->sampleRate) / k_SampleRate;
+    }
+}
+
+void SamplePlayer::forget(pdcpp::host::SoundObject* dying)
+{
+    if (sample == dying)
+    {
+        sample = nullptr;
+        playing = false;
+    }
+}
+
+void FilePlayer::render(int32_t* left, int32_t* right, int nFrames)
+{
+    if (fadeRemaining > 0 && playing && !paused)
+    {
+        auto frames = std::min(nFrames, fadeRemaining);
+        auto fraction = static_cast<float>(frames) / static_cast<float>(fadeRemaining);
+        leftVolume += (fadeLeftTarget - leftVolume) * fraction;
+        rightVolume += (fadeRightTarget - rightVolume) * fraction;
+        fadeRemaining -= frames;
+
+        if (fadeRemaining == 0 && fadeCallback != nullptr)
+        {
+            pdcpp::host::deferCallback(this, [this, callback = fadeCallback, userdata = fadeUserdata]()
+                { callback(this, userdata); });
+        }
+    }
+
+    SamplePlayer::render(left, right, nFrames);
+}
+
+//==============================================================================
+void SoundChannel::render(int32_t* left, int32_t* right, int nFrames)
+{
+    int32_t bufferL[k_BlockSize] = {};
+    int32_t bufferR[k_BlockSize] = {};
+
+    // Sources may finish and detach while rendering.
+    auto toRender = sources;
+    for (auto source : toRender)
+        { source->render(bufferL, bufferR, nFrames); }
+
+    auto peak = [nFrames](const int32_t* l, const int32_t* r)
+    {
+        int32_t result = 0;
+        for (int i = 0; i < nFrames; ++i)
+            { result = std::max({result, std::abs(l[i]), std::abs(r[i])}); }
+        return static_cast<float>(result) / k_Unity;
+    };
+
+    dryLevel.level = peak(bufferL, bufferR);
+
+    for (auto effect : effects)
+    {
+        int32_t wetL[k_BlockSize];
+        int32_t wetR[k_BlockSize];
+        std::copy_n(bufferL, nFrames, wetL);
+        std::copy_n(bufferR, nFrames, wetR);
+        effect->process(wetL, wetR, nFrames);
+
+        auto mix = std::clamp(effect->mix * (effect->mixModulator != nullptr ? effect->mixModulator->getValue() : 1.0f), 0.0f, 1.0f);
+        auto wet = static_cast<int64_t>(mix * 65536.0f);
+        for (int i = 0; i < nFrames; ++i)
+        {
+            bufferL[i] = static_cast<int32_t>(bufferL[i] + (((wetL[i] - static_cast<int64_t>(bufferL[i])) * wet) >> 16));
+            bufferR[i] = static_cast<int32_t>(bufferR[i] + (((wetR[i] - static_cast<int64_t>(bufferR[i])) * wet) >> 16));
+        }
+    }
+
+    wetLevel.level = peak(bufferL, bufferR);
+
+    auto gain = volume * (volumeModulator != nullptr ? volumeModulator->getValue() : 1.0f);
+    auto p = std::clamp(pan + (panModulator != nullptr ? panModulator->getValue() : 0.0f), -1.0f, 1.0f);
+    auto gainL = gain * std::min(1.0f, 1.0f - p);
+    auto gainR = gain * std::min(1.0f, 1.0f + p);
+    for (int i = 0; i < nFrames; ++i)
+    {
+        left[i] += static_cast<int32_t>(static_cast<float>(bufferL[i]) * gainL);
+        right[i] += static_cast<int32_t>(static_cast<float>(bufferR[i]) * gainR);
+    }
+}
+
+void SoundChannel::forget(pdcpp::host::SoundObject* dying)
+{
+    removeFrom(sources, dying);
+    removeFrom(effects, dying);
+    if (volumeModulator == dying) { volumeModulator = nullptr; }
+    if (panModulator == dying) { panModulator = nullptr; }
+}
+
+//==============================================================================
+pdcpp::host::SoundState::SoundState()
+    : defaultChannel(track(new SoundChannel))
+{
+}
+
+pdcpp::host::SoundState::~SoundState()
+{
+    for (auto object : objects)
+        { delete object; }
+}
+
+bool pdcpp::host::SoundState::destroy(SoundObject* object, const char* kind)
+{
+    if (object == nullptr || objects.erase(object) == 0)
+    {
+        reportError("%s called on an object which wasn't allocated, or was already freed", kind);
+        return false;
+    }
+
+    std::vector<SoundObject*> dying {object};
+    if (auto channel = dynamic_cast<SoundChannel*>(object))
+    {
+        dying.push_back(&channel->dryLevel);
+        dying.push_back(&channel->wetLevel);
+        removeFrom(channels, channel);
+        for (auto source : channel->sources) { source->channel = nullptr; }
+        for (auto effect : channel->effects) { effect->channel = nullptr; }
+    }
+    if (auto source = dynamic_cast<SoundSource*>(object))
+        { detachSource(source); }
+    if (auto effect = dynamic_cast<SoundEffect*>(object); effect != nullptr && effect->channel != nullptr)
+        { removeFrom(effect->channel->effects, effect); }
+
+    removeFrom(sequences, object);
+    for (auto d : dying)
+    {
+        for (auto other : objects)
+            { other->forget(d); }
+    }
+
+    pendingCallbacks.erase(std::remove_if(pendingCallbacks.begin(), pendingCallbacks.end(),
+                                          [object](const auto& p) { return p.first == object; }),
+                           pendingCallbacks.end());
+    delete object;
+    return true;
+}
+
+//==============================================================================
+std::unique_ptr<AudioSample> pdcpp::host::loadAudioFile(const char* path)
+{
+    auto& sound = context().sound;
+    auto mode = kFileRead | kFileReadData;
+    auto found = findReadablePath(path, mode);
+    for (auto extension : {".wav", ".pda"})
+    {
+        if (!found)
+            { found = findReadablePath((std::string(path) + extension).c_str(), mode); }
+    }
+
+    if (!found)
+    {
+        sound.lastError = std::string("File not found: ") + path;
+        return nullptr;
+    }
+
+    std::ifstream stream(*found, std::ios::binary);
+    std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+
+    auto sample = parseWAV(bytes);
+    if (sample == nullptr)
+        { sample = parsePDA(bytes); }
+    if (sample == nullptr)
+        { sound.lastError = std::string("Unsupported audio file (PCM WAV or uncompressed PDA only): ") + path; }
+
+    return sample;
+}
+
+void pdcpp::host::renderSound(int16_t* left, int16_t* right, int nFrames)
+{
+    auto& sound = context().sound;
+    for (int done = 0; done < nFrames;)
+    {
+        auto n = std::min(k_BlockSize, nFrames - done);
+
+        auto sequences = sound.sequences;
+        for (auto sequence : sequences)
+            { sequence->advance(n); }
+
+        int32_t mixL[k_BlockSize] = {};
+        int32_t mixR[k_BlockSize] = {};
+        sound.defaultChannel->render(mixL, mixR, n);
+        for (auto channel : sound.channels)
+            { channel->render(mixL, mixR, n); }
+
+        for (int i = 0; i < n; ++i)
+        {
+            if (left != nullptr) { left[done + i] = toPCM(mixL[i]); }
+            if (right != nullptr) { right[done + i] = toPCM(mixR[i]); }
+        }
+
+        sound.time += static_cast<uint32_t>(n);
+        done += n;
+
+        // Callbacks may free objects, which drops their pending callbacks.
+        while (!sound.pendingCallbacks.empty())
+        {
+            auto callback = std::move(sound.pendingCallbacks.front().second);
+            sound.pendingCallbacks.erase(sound.pendingCallbacks.begin());
+            callback();
+        }
+    }
+}
+
+void pdcpp::host::populateSoundAPI(SoundTables& tables)
+{
+    auto& source = tables.source;
+    source.setVolume = sourceSetVolume;
+    source.getVolume = sourceGetVolume;
+    source.isPlaying = sourceIsPlaying;
+    source.setFinishCallback = sourceSetFinishCallback;
+
+    auto& sample = tables.sample;
+    sample.newSampleBuffer = newSampleBuffer;
+    sample.loadIntoSample = loadIntoSample;
+    sample.load = loadSample;
+    sample.newSampleFromData = newSampleFromData;
+    sample.getData = getSampleData;
+    sample.freeSample = freeSample;
+    sample.getLength = getSampleLength;
+    sample.decompress = decompress;
+
+    auto& sampleplayer = tables.sampleplayer;
+    sampleplayer.newPlayer = newSamplePlayer;
+    sampleplayer.freePlayer = freeSamplePlayer;
+    sampleplayer.setSample = setPlayerSample;
+    sampleplayer.play = playSample;
+    sampleplayer.isPlaying = samplePlayerIsPlaying;
+    sampleplayer.stop = stopPlayer;
+    sampleplayer.setVolume = samplePlayerSetVolume;
+    sampleplayer.getVolume = samplePlayerGetVolume;
+    sampleplayer.getLength = samplePlayerGetLength;
+    sampleplayer.setOffset = samplePlayerSetOffset;
+    sampleplayer.setRate = samplePlayerSetRate;
+    sampleplayer.setPlayRange = setPlayRange;
+    sampleplayer.setFinishCallback = samplePlayerSetFinishCallback;
+    sampleplayer.setLoopCallback = samplePlayerSetLoopCallback;
+    sampleplayer.getOffset = samplePlayerGetOffset;
+    sampleplayer.getRate = samplePlayerGetRate;
+    sampleplayer.setPaused = setPaused;
+
+    auto& fileplayer = tables.fileplayer;
+    fileplayer.newPlayer = newFilePlayer;
+    fileplayer.freePlayer = freeFilePlayer;
+    fileplayer.loadIntoPlayer = loadIntoPlayer;
+    fileplayer.setBufferLength = setBufferLength;
+    fileplayer.play = playFile;
+    fileplayer.isPlaying = filePlayerIsPlaying;
+    fileplayer.pause = pauseFile;
+    fileplayer.stop = stopFile;
+    fileplayer.setVolume = filePlayerSetVolume;
+    fileplayer.getVolume = filePlayerGetVolume;
+    fileplayer.getLength = filePlayerGetLength;
+    fileplayer.setOffset = filePlayerSetOffset;
+    fileplayer.setRate = filePlayerSetRate;
+    fileplayer.setLoopRange = setLoopRange;
+    fileplayer.didUnderrun = didUnderrun;
+    fileplayer.setFinishCallback = filePlayerSetFinishCallback;
+    fileplayer.setLoopCallback = filePlayerSetLoopCallback;
+    fileplayer.getOffset = filePlayerGetOffset;
+    fileplayer.getRate = filePlayerGetRate;
+    fileplayer.setStopOnUnderrun = setStopOnUnderrun;
+    fileplayer.fadeVolume = fadeVolume;
+    fileplayer.setMP3StreamSource = setMP3StreamSource;
+
+    auto& channel = tables.channel;
+    channel.newChannel = newChannel;
+    channel.freeChannel = freeChannel;
+    channel.addSource = channelAddSource;
+    channel.removeSource = channelRemoveSource;
+    channel.addCallbackSource = addCallbackSource;
+    channel.addEffect = channelAddEffect;
+    channel.removeEffect = channelRemoveEffect;
+    channel.setVolume = channelSetVolume;
+    channel.getVolume = channelGetVolume;
+    channel.setVolumeModulator = setVolumeModulator;
+    channel.getVolumeModulator = getVolumeModulator;
+    channel.setPan = setPan;
+    channel.setPanModulator = setPanModulator;
+    channel.getPanModulator = getPanModulator;
+    channel.getDryLevelSignal = getDryLevelSignal;
+    channel.getWetLevelSignal = getWetLevelSignal;
+
+    populateSynthAPI(tables);
+    populateEffectAPI(tables);
+    populateSequenceAPI(tables);
+
+    auto& sound = tables.sound;
+    sound.channel = &tables.channel;
+    sound.fileplayer = &tables.fileplayer;
+    sound.sample = &tables.sample;
+    sound.sampleplayer = &tables.sampleplayer;
+    sound.synth = &tables.synth;
+    sound.sequence = &tables.sequence;
+    sound.effect = &tables.effect;
+    sound.lfo = &tables.lfo;
+    sound.envelope = &tables.envelope;
+    sound.source = &tables.source;
+    sound.controlsignal = &tables.controlsignal;
+    sound.track = &tables.track;
+    sound.instrument = &tables.instrument;
+    sound.getCurrentTime = getCurrentTime;
+    sound.addSource = addSource;
+    sound.getDefaultChannel = getDefaultChannel;
+    sound.addChannel = addChannel;
+    sound.removeChannel = removeChannel;
+    sound.setMicCallback = setMicCallback;
+    sound.getHeadphoneState = getHeadphoneState;
+    sound.setOutputsActive = setOutputsActive;
+    sound.removeSource = removeSource;
+    sound.signal = &tables.signal;
+    sound.getError = getError;
+}
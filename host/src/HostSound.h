@@ -0,0 +1,689 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#pragma once
+
+#include <pd_api.h>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace pdcpp::host
+{
+    constexpr int k_SampleRate = 44100;
+
+    // The most frames the engine renders at once. Signals and sequences are
+    // updated once per block, like the device's audio interrupt.
+    constexpr int k_BlockSize = 256;
+
+    // 1.0 in the Q8.24 format used by the mixing buffers.
+    constexpr float k_Unity = 16777216.0f;
+
+    /**
+     * The base of every sound engine object, so they can be tracked, and told
+     * when another object they might point at is freed.
+     */
+    struct SoundObject
+    {
+        virtual ~SoundObject() = default;
+
+        /**
+         * Called on every live object when another is freed, so dangling
+         * references can be dropped.
+         */
+        virtual void forget(SoundObject*) {}
+    };
+
+    /**
+     * @returns the sound engine's clock, in samples.
+     */
+    uint32_t soundTime();
+
+    /**
+     * Queues a callback to run once the current block has been rendered,
+     * so user code never runs in the middle of mixing. The callback is
+     * dropped if its owner is freed before then.
+     */
+    void deferCallback(SoundObject* owner, std::function<void()> callback);
+}
+
+//==============================================================================
+/**
+ * The base of every modulation source. Values are computed lazily, stepping
+ * the signal forward by however much time has passed since it was last read.
+ */
+struct PDSynthSignalValue
+    : pdcpp::host::SoundObject
+{
+    /**
+     * @returns the scaled and offset value at the engine's current time.
+     */
+    float getValue();
+
+    /**
+     * Advances the signal.
+     *
+     * @param frames the number of samples since the last step.
+     * @returns the raw value of the signal.
+     */
+    virtual float step(int frames) = 0;
+
+    virtual void noteOn(MIDINote, float, float) {}
+    virtual void noteOff(int, int) {}
+
+    float scale = 1.0f;
+    float offset = 0.0f;
+    uint32_t lastTime = 0;
+    bool started = false;
+    float value = 0.0f;
+};
+
+struct PDSynthLFO
+    : PDSynthSignalValue
+{
+    float step(int frames) override;
+    void noteOn(MIDINote, float, float) override;
+
+    LFOType type = kLFOTypeSine;
+    float rate = 1.0f;
+    float phase = 0.0f;
+    float startPhase = 0.0f;
+    float center = 0.0f;
+    float depth = 1.0f;
+    std::vector<float> arpeggio;
+    float (*function)(PDSynthLFO* lfo, void* userdata) = nullptr;
+    void* functionUserdata = nullptr;
+    bool interpolate = false;
+    float holdoff = 0.0f;
+    float rampTime = 0.0f;
+    float elapsed = 0.0f;
+    bool retrigger = false;
+    bool global = false;
+    float heldValue = 0.0f;
+    float previousValue = 0.0f;
+    uint32_t noise = 0x12345678;
+};
+
+struct PDSynthEnvelope
+    : PDSynthSignalValue
+{
+    enum class Stage { Idle, Attack, Decay, Sustain, Release };
+
+    float step(int frames) override;
+    void noteOn(MIDINote note, float velocity, float length) override;
+    void noteOff(int stopped, int offset) override;
+
+    /**
+     * Advances the envelope by a single sample.
+     *
+     * @returns the envelope's level, scaled by velocity.
+     */
+    float tick();
+
+    float attack = 0.0f;
+    float decay = 0.0f;
+    float sustain = 1.0f;
+    float release = 0.0f;
+    bool legato = false;
+    bool retrigger = false;
+    float curvature = 0.0f;
+    float velocitySensitivity = 1.0f;
+    float rateScaling = 0.0f;
+    MIDINote rateScalingStart = 0.0f;
+    MIDINote rateScalingEnd = 127.0f;
+
+    Stage stage = Stage::Idle;
+    float level = 0.0f;
+    float releaseFrom = 0.0f;
+    float velocity = 1.0f;
+    float rateMultiplier = 1.0f;
+    bool drivenBySynth = false;
+};
+
+struct PDSynthSignal
+    : PDSynthSignalValue
+{
+    ~PDSynthSignal() override;
+    float step(int frames) override;
+    void noteOn(MIDINote note, float velocity, float length) override;
+    void noteOff(int stopped, int offset) override;
+    void forget(pdcpp::host::SoundObject* dying) override;
+
+    signalStepFunc stepFunction = nullptr;
+    signalNoteOnFunc noteOnFunction = nullptr;
+    signalNoteOffFunc noteOffFunction = nullptr;
+    signalDeallocFunc deallocFunction = nullptr;
+    void* userdata = nullptr;
+    PDSynthSignalValue* source = nullptr;
+};
+
+struct ControlSignal
+    : PDSynthSignalValue
+{
+    float step(int frames) override;
+
+    struct Event { float value; bool interpolate; };
+    std::map<int, Event> events;
+    int controller = -1;
+    double currentStep = 0.0;
+};
+
+//==============================================================================
+/**
+ * The base of everything which can be added to a channel.
+ */
+struct SoundSource
+    : pdcpp::host::SoundObject
+{
+    /**
+     * Adds the source's output to the given Q8.24 buffers.
+     */
+    virtual void render(int32_t* left, int32_t* right, int nFrames) = 0;
+
+    [[ nodiscard ]] virtual bool isPlaying() const = 0;
+
+    /**
+     * Queues the finish callback, if there is one.
+     */
+    void finished();
+
+    float leftVolume = 1.0f;
+    float rightVolume = 1.0f;
+    sndCallbackProc* finishCallback = nullptr;
+    void* finishUserdata = nullptr;
+    SoundChannel* channel = nullptr;
+};
+
+struct CallbackSource
+    : SoundSource
+{
+    void render(int32_t* left, int32_t* right, int nFrames) override;
+    [[ nodiscard ]] bool isPlaying() const override { return active; }
+
+    AudioSourceFunction* callback = nullptr;
+    void* context = nullptr;
+    bool stereo = false;
+    bool active = true;
+};
+
+struct AudioSample
+    : pdcpp::host::SoundObject
+{
+    ~AudioSample() override;
+
+    [[ nodiscard ]] int frameCount() const;
+
+    /**
+     * Reads a frame as floats, duplicating mono samples to both sides.
+     */
+    void readFrame(int frame, float& left, float& right) const;
+
+    uint8_t* data = nullptr;
+    bool ownsData = false;
+    SoundFormat format = kSound16bitMono;
+    uint32_t sampleRate = pdcpp::host::k_SampleRate;
+    uint32_t byteLength = 0;
+};
+
+struct SamplePlayer
+    : SoundSource
+{
+    void render(int32_t* left, int32_t* right, int nFrames) override;
+    [[ nodiscard ]] bool isPlaying() const override { return playing; }
+    void forget(pdcpp::host::SoundObject* dying) override;
+
+    /**
+     * Starts playback.
+     *
+     * @param repeatCount 0 loops forever, -1 loops back and forth forever,
+     *     anything else plays the sample that many times.
+     */
+    void start(int repeatCount, float playbackRate);
+
+    /**
+     * Handles reaching either end of the play range.
+     *
+     * @returns false once playback is over.
+     */
+    bool wrap(int start, int end);
+
+    AudioSample* sample = nullptr;
+    bool playing = false;
+    bool paused = false;
+    int repeat = 1;
+    int playsRemaining = 0;
+    float rate = 1.0f;
+    double position = 0.0;
+    int rangeStart = 0;
+    int rangeEnd = 0;
+    sndCallbackProc* loopCallback = nullptr;
+    void* loopUserdata = nullptr;
+};
+
+struct FilePlayer
+    : SamplePlayer
+{
+    void render(int32_t* left, int32_t* right, int nFrames) override;
+
+    std::unique_ptr<AudioSample> loaded;
+    int fadeRemaining = 0;
+    float fadeLeftTarget = 0.0f;
+    float fadeRightTarget = 0.0f;
+    sndCallbackProc* fadeCallback = nullptr;
+    void* fadeUserdata = nullptr;
+};
+
+struct PDSynth
+    : SoundSource
+{
+    PDSynth();
+    ~PDSynth() override;
+
+    void render(int32_t* left, int32_t* right, int nFrames) override;
+    [[ nodiscard ]] bool isPlaying() const override { return playing || pendingStart; }
+    void forget(pdcpp::host::SoundObject* dying) override;
+
+    void startNote();
+    void releaseNote();
+
+    /**
+     * Renders a stretch of frames with no note events in it.
+     */
+    void renderFrames(int32_t* left, int32_t* right, int nFrames);
+
+    /**
+     * Advances the oscillator, sample, or wavetable by one frame.
+     *
+     * @returns the next value, in the range -1 to 1.
+     */
+    [[ nodiscard ]] float oscillate(float frequency);
+
+    SoundWaveform waveform = kWaveformSquare;
+    PDSynthEnvelope envelope;
+    bool hasEnvelope = true;
+
+    synthRenderFunc generatorRender = nullptr;
+    synthNoteOnFunc generatorNoteOn = nullptr;
+    synthReleaseFunc generatorRelease = nullptr;
+    synthSetParameterFunc generatorSetParameter = nullptr;
+    synthDeallocFunc generatorDealloc = nullptr;
+    synthCopyUserdata generatorCopy = nullptr;
+    void* generatorUserdata = nullptr;
+    bool generatorStereo = false;
+
+    AudioSample* sample = nullptr;
+    uint32_t sustainStart = 0;
+    uint32_t sustainEnd = 0;
+    std::vector<float> wavetable;
+
+    float transpose = 0.0f;
+    float bend = 0.0f;
+    PDSynthSignalValue* frequencyModulator = nullptr;
+    PDSynthSignalValue* amplitudeModulator = nullptr;
+    std::map<int, PDSynthSignalValue*> parameterModulators;
+    std::map<int, float> parameters;
+
+    bool playing = false;
+    bool released = false;
+    float frequency = 440.0f;
+    float velocity = 1.0f;
+    int64_t remaining = -1;
+
+    bool pendingStart = false;
+    uint32_t startTime = 0;
+    float pendingFrequency = 0.0f;
+    float pendingVelocity = 0.0f;
+    float pendingLength = -1.0f;
+    bool pendingStop = false;
+    uint32_t stopTime = 0;
+
+    double phase = 0.0;
+    double samplePosition = 0.0;
+    uint32_t noise = 0x2545f491;
+
+    PDSynthInstrument* instrument = nullptr;
+    MIDINote note = 0.0f;
+    uint64_t voiceAge = 0;
+};
+
+struct PDSynthInstrument
+    : SoundSource
+{
+    void render(int32_t* left, int32_t* right, int nFrames) override;
+    [[ nodiscard ]] bool isPlaying() const override;
+    void forget(pdcpp::host::SoundObject* dying) override;
+
+    /**
+     * Plays a note on a free voice covering it, stealing the oldest voice
+     * when they're all busy.
+     *
+     * @returns the voice's synth, or nullptr if no voice covers the note.
+     */
+    PDSynth* playNote(MIDINote note, float velocity, float length, uint32_t when);
+
+    struct Voice
+    {
+        PDSynth* synth;
+        MIDINote rangeStart;
+        MIDINote rangeEnd;
+        float transpose;
+    };
+
+    std::vector<Voice> voices;
+    float pitchBend = 0.0f;
+    float pitchBendRange = 2.0f;
+    float transpose = 0.0f;
+    uint64_t nextVoiceAge = 0;
+};
+
+struct DelayLineTap
+    : SoundSource
+{
+    void render(int32_t* left, int32_t* right, int nFrames) override;
+    [[ nodiscard ]] bool isPlaying() const override { return line != nullptr; }
+    void forget(pdcpp::host::SoundObject* dying) override;
+
+    DelayLine* line = nullptr;
+    int delay = 0;
+    PDSynthSignalValue* delayModulator = nullptr;
+    bool flipped = false;
+};
+
+//==============================================================================
+/**
+ * The base of every effect. The built-in effects override `process`, custom
+ * effects call back into the user's `effectProc`.
+ */
+struct SoundEffect
+    : pdcpp::host::SoundObject
+{
+    virtual void process(int32_t* left, int32_t* right, int nFrames);
+    void forget(pdcpp::host::SoundObject* dying) override;
+
+    /**
+     * @returns a modulator's value, or 0 when there isn't one.
+     */
+    static float modulation(PDSynthSignalValue* mod) { return mod != nullptr ? mod->getValue() : 0.0f; }
+
+    effectProc* proc = nullptr;
+    void* userdata = nullptr;
+    float mix = 1.0f;
+    PDSynthSignalValue* mixModulator = nullptr;
+    SoundChannel* channel = nullptr;
+};
+
+struct TwoPoleFilter
+    : SoundEffect
+{
+    void process(int32_t* left, int32_t* right, int nFrames) override;
+    void forget(pdcpp::host::SoundObject* dying) override;
+
+    TwoPoleFilterType type = kFilterTypeLowPass;
+    float frequency = 1000.0f;
+    float gain = 0.0f;
+    float resonance = 0.0f;
+    PDSynthSignalValue* frequencyModulator = nullptr;
+    PDSynthSignalValue* resonanceModulator = nullptr;
+    float state[2][4] = {};
+};
+
+struct OnePoleFilter
+    : SoundEffect
+{
+    void process(int32_t* left, int32_t* right, int nFrames) override;
+    void forget(pdcpp::host::SoundObject* dying) override;
+
+    float parameter = 0.0f;
+    PDSynthSignalValue* parameterModulator = nullptr;
+    float state[2] = {};
+};
+
+struct BitCrusher
+    : SoundEffect
+{
+    void process(int32_t* left, int32_t* right, int nFrames) override;
+    void forget(pdcpp::host::SoundObject* dying) override;
+
+    float amount = 0.0f;
+    float undersampling = 0.0f;
+    PDSynthSignalValue* amountModulator = nullptr;
+    PDSynthSignalValue* undersampleModulator = nullptr;
+    int32_t held[2] = {};
+    int holdCounter = 0;
+};
+
+struct RingModulator
+    : SoundEffect
+{
+    void process(int32_t* left, int32_t* right, int nFrames) override;
+    void forget(pdcpp::host::SoundObject* dying) override;
+
+    float frequency = 440.0f;
+    PDSynthSignalValue* frequencyModulator = nullptr;
+    double phase = 0.0;
+};
+
+struct DelayLine
+    : SoundEffect
+{
+    void process(int32_t* left, int32_t* right, int nFrames) override;
+
+    /**
+     * @returns a frame from the past, `delay` frames before the write head.
+     */
+    void read(int delay, int32_t& left, int32_t& right) const;
+
+    std::vector<int32_t> buffer;
+    int length = 0;
+    bool stereo = false;
+    int writeIndex = 0;
+    float feedback = 0.0f;
+};
+
+struct Overdrive
+    : SoundEffect
+{
+    void process(int32_t* left, int32_t* right, int nFrames) override;
+    void forget(pdcpp::host::SoundObject* dying) override;
+
+    float gain = 1.0f;
+    float limit = 1.0f;
+    float offset = 0.0f;
+    PDSynthSignalValue* limitModulator = nullptr;
+    PDSynthSignalValue* offsetModulator = nullptr;
+};
+
+//==============================================================================
+/**
+ * Reports the peak level of the last block a channel rendered.
+ */
+struct LevelSignal
+    : PDSynthSignalValue
+{
+    float step(int) override { return level; }
+
+    float level = 0.0f;
+};
+
+struct SoundChannel
+    : pdcpp::host::SoundObject
+{
+    void render(int32_t* left, int32_t* right, int nFrames);
+    void forget(pdcpp::host::SoundObject* dying) override;
+
+    std::vector<SoundSource*> sources;
+    std::vector<SoundEffect*> effects;
+    float volume = 1.0f;
+    float pan = 0.0f;
+    PDSynthSignalValue* volumeModulator = nullptr;
+    PDSynthSignalValue* panModulator = nullptr;
+    LevelSignal dryLevel;
+    LevelSignal wetLevel;
+};
+
+struct SequenceTrack
+    : pdcpp::host::SoundObject
+{
+    void forget(pdcpp::host::SoundObject* dying) override;
+
+    [[ nodiscard ]] uint32_t length() const;
+
+    /**
+     * @returns the control signal for a MIDI controller, creating it if
+     *     asked to, or nullptr.
+     */
+    ControlSignal* signalForController(int controller, bool create);
+
+    struct Note
+    {
+        uint32_t length;
+        MIDINote note;
+        float velocity;
+    };
+
+    PDSynthInstrument* instrument = nullptr;
+    std::multimap<uint32_t, Note> notes;
+    std::vector<ControlSignal*> signals;
+    bool muted = false;
+    SoundSequence* owner = nullptr;
+};
+
+struct SoundSequence
+    : pdcpp::host::SoundObject
+{
+    void forget(pdcpp::host::SoundObject* dying) override;
+
+    /**
+     * Moves the sequence forward, scheduling the notes which fall inside
+     * the block on the tracks' instruments.
+     */
+    void advance(int nFrames);
+
+    [[ nodiscard ]] uint32_t length() const;
+
+    std::map<unsigned int, SequenceTrack*> tracks;
+    float tempo = 4.0f;
+    bool playing = false;
+    double currentStep = 0.0;
+    int loopStart = 0;
+    int loopEnd = 0;
+    bool looping = false;
+    int loops = 0;
+    int loopsPlayed = 0;
+    SequenceFinishedCallback finishCallback = nullptr;
+    void* finishUserdata = nullptr;
+};
+
+namespace pdcpp::host
+{
+    /**
+     * The function tables making up `playdate->sound`.
+     */
+    struct SoundTables
+    {
+        playdate_sound sound {};
+        playdate_sound_channel channel {};
+        playdate_sound_fileplayer fileplayer {};
+        playdate_sound_sample sample {};
+        playdate_sound_sampleplayer sampleplayer {};
+        playdate_sound_synth synth {};
+        playdate_sound_sequence sequence {};
+        playdate_sound_effect effect {};
+        playdate_sound_effect_twopolefilter twopolefilter {};
+        playdate_sound_effect_onepolefilter onepolefilter {};
+        playdate_sound_effect_bitcrusher bitcrusher {};
+        playdate_sound_effect_ringmodulator ringmodulator {};
+        playdate_sound_effect_delayline delayline {};
+        playdate_sound_effect_overdrive overdrive {};
+        playdate_sound_lfo lfo {};
+        playdate_sound_envelope envelope {};
+        playdate_sound_source source {};
+        playdate_control_signal controlsignal {};
+        playdate_sound_track track {};
+        playdate_sound_instrument instrument {};
+        playdate_sound_signal signal {};
+    };
+
+    /**
+     * Everything behind `playdate->sound`.
+     */
+    struct SoundState
+    {
+        SoundState();
+        ~SoundState();
+
+        /**
+         * Starts tracking a newly allocated object.
+         */
+        template <typename T>
+        T* track(T* object)
+        {
+            objects.insert(object);
+            return object;
+        }
+
+        /**
+         * Stops tracking an object, tells every other object it's going
+         * away, then deletes it.
+         *
+         * @returns false if the object wasn't being tracked.
+         */
+        bool destroy(SoundObject* object, const char* kind);
+
+        std::unordered_set<SoundObject*> objects;
+        SoundChannel* defaultChannel = nullptr;
+        std::vector<SoundChannel*> channels;
+        std::vector<SoundSequence*> sequences;
+        uint32_t time = 0;
+        std::vector<std::pair<SoundObject*, std::function<void()>>> pendingCallbacks;
+
+        RecordCallback* micCallback = nullptr;
+        void* micContext = nullptr;
+        void (*headphoneCallback)(int headphone, int micinput) = nullptr;
+        std::string lastError;
+    };
+
+    /**
+     * Fills in all of the `playdate->sound` function tables.
+     */
+    void populateSoundAPI(SoundTables& tables);
+
+    /**
+     * Fills in the synth, instrument, signal, LFO, and envelope tables.
+     */
+    void populateSynthAPI(SoundTables& tables);
+
+    /**
+     * Fills in the effect tables.
+     */
+    void populateEffectAPI(SoundTables& tables);
+
+    /**
+     * Fills in the sequence, track, and control signal tables.
+     */
+    void populateSequenceAPI(SoundTables& tables);
+
+    /**
+     * Loads a sample from a WAV or Playdate audio file.
+     *
+     * @returns the sample, or nullptr on failure.
+     */
+    std::unique_ptr<AudioSample> loadAudioFile(const char* path);
+
+    /**
+     * Renders audio into the given buffers, block by block.
+     */
+    void renderSound(int16_t* left, int16_t* right, int nFrames);
+}
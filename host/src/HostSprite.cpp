@@ -0,0 +1,907 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#include "HostContext.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <optional>
+
+namespace
+{
+    using pdcpp::host::context;
+
+    constexpr float k_Delta = 1e-10f;
+    constexpr float k_Infinity = std::numeric_limits<float>::infinity();
+
+    auto& state() { return context().sprites; }
+
+    int roundToInt(float value) { return static_cast<int>(std::lround(value)); }
+
+    float positionX(const LCDSprite* s) { return s->bounds.x + s->bounds.width * s->centerX; }
+    float positionY(const LCDSprite* s) { return s->bounds.y + s->bounds.height * s->centerY; }
+
+    // The offset from a sprite's position to the top left of its collide rect.
+    float collideOffsetX(const LCDSprite* s) { return s->collideRect.x - s->bounds.width * s->centerX; }
+    float collideOffsetY(const LCDSprite* s) { return s->collideRect.y - s->bounds.height * s->centerY; }
+
+    PDRect worldCollideRect(const LCDSprite* s)
+    {
+        return {s->bounds.x + s->collideRect.x, s->bounds.y + s->collideRect.y,
+                s->collideRect.width, s->collideRect.height};
+    }
+
+    bool isCollidable(const LCDSprite* s)
+    {
+        return s->inDisplayList && s->collisionsEnabled && s->hasCollideRect
+            && s->collideRect.width > 0.0f && s->collideRect.height > 0.0f;
+    }
+
+    void markDirty(LCDSprite* s)
+    {
+        if (!s->inDisplayList)
+            { return; }
+
+        auto& dc = context().graphics.current();
+        auto ox = s->ignoresDrawOffset ? 0 : dc.offsetX;
+        auto oy = s->ignoresDrawOffset ? 0 : dc.offsetY;
+        auto left = static_cast<int>(std::floor(s->bounds.x)) + ox;
+        auto top = static_cast<int>(std::floor(s->bounds.y)) + oy;
+        auto right = static_cast<int>(std::ceil(s->bounds.x + s->bounds.width)) + ox;
+        auto bottom = static_cast<int>(std::ceil(s->bounds.y + s->bounds.height)) + oy;
+        state().dirtyRects.push_back({left, right, top, bottom});
+    }
+
+    void sortDisplayList()
+    {
+        std::stable_sort(state().displayList.begin(), state().displayList.end(), [](auto* a, auto* b)
+        {
+            if (a->zIndex != b->zIndex)
+                { return a->zIndex < b->zIndex; }
+            return a->sequence < b->sequence;
+        });
+    }
+
+    // Sets the bounds so the sprite's center lands on the given position.
+    void placeAt(LCDSprite* s, float x, float y)
+    {
+        markDirty(s);
+        s->bounds.x = x - s->bounds.width * s->centerX;
+        s->bounds.y = y - s->bounds.height * s->centerY;
+        markDirty(s);
+    }
+
+    template <typename T>
+    T* copyOut(const std::vector<T>& items, int* len)
+    {
+        *len = static_cast<int>(items.size());
+        if (items.empty())
+            { return nullptr; }
+
+        auto out = static_cast<T*>(std::malloc(sizeof(T) * items.size()));
+        std::copy(items.begin(), items.end(), out);
+        return out;
+    }
+
+    //==========================================================================
+    // The collision code is a port of bump.lua's, which is what the Playdate
+    // SDK's sprite collisions are modelled on.
+    struct Collision
+    {
+        LCDSprite* other = nullptr;
+        SpriteCollisionResponseType type = kCollisionTypeFreeze;
+        bool overlaps = false;
+        float ti = 0.0f;
+        float moveX = 0.0f, moveY = 0.0f;
+        int normalX = 0, normalY = 0;
+        float touchX = 0.0f, touchY = 0.0f;
+        PDRect itemRect {};
+        PDRect otherRect {};
+    };
+
+    struct SegmentHit
+    {
+        float ti1, ti2;
+        int nx1, ny1, nx2, ny2;
+    };
+
+    int sign(float x) { return x > 0.0f ? 1 : (x < 0.0f ? -1 : 0); }
+
+    float nearest(float x, float a, float b) { return std::abs(a - x) < std::abs(b - x) ? a : b; }
+
+    // Liang-Barsky clipping of the segment (x1, y1) -> (x2, y2) against a rect.
+    std::optional<SegmentHit> segmentIntersectionIndices(PDRect r, float x1, float y1, float x2, float y2,
+                                                         float ti1, float ti2)
+    {
+        auto dx = x2 - x1, dy = y2 - y1;
+        int nx1 = 0, ny1 = 0, nx2 = 0, ny2 = 0;
+
+        for (int side = 0; side < 4; side++)
+        {
+            float p, q;
+            int nx, ny;
+            switch (side)
+            {
+                case 0: nx = -1; ny = 0; p = -dx; q = x1 - r.x; break;
+                case 1: nx = 1; ny = 0; p = dx; q = r.x + r.width - x1; break;
+                case 2: nx = 0; ny = -1; p = -dy; q = y1 - r.y; break;
+                default: nx = 0; ny = 1; p = dy; q = r.y + r.height - y1; break;
+            }
+
+            if (p == 0.0f)
+            {
+                if (q <= 0.0f)
+                    { return std::nullopt; }
+                continue;
+            }
+
+            auto t = q / p;
+            if (p < 0.0f)
+            {
+                if (t > ti2) { return std::nullopt; }
+                if (t > ti1) { ti1 = t; nx1 = nx; ny1 = ny; }
+            }
+            else
+            {
+                if (t < ti1) { return std::nullopt; }
+                if (t < ti2) { ti2 = t; nx2 = nx; ny2 = ny; }
+            }
+        }
+        return SegmentHit {ti1, ti2, nx1, ny1, nx2, ny2};
+    }
+
+    std::optional<Collision> detectCollision(PDRect a, PDRect b, float goalX, float goalY)
+    {
+        auto dx = goalX - a.x, dy = goalY - a.y;
+        // The Minkowski difference of the two rects.
+        PDRect diff {b.x - a.x - a.width, b.y - a.y - a.height, a.width + b.width, a.height + b.height};
+
+        Collision col;
+        bool hit = false;
+
+        auto containsOrigin = -diff.x > k_Delta && -diff.y > k_Delta
+                           && diff.x + diff.width > k_Delta && diff.y + diff.height > k_Delta;
+        if (containsOrigin)
+        {
+            // The item was already intersecting the other.
+            auto px = nearest(0.0f, diff.x, diff.x + diff.width);
+            auto py = nearest(0.0f, diff.y, diff.y + diff.height);
+            auto wi = std::min(a.width, std::abs(px));
+            auto hi = std::min(a.height, std::abs(py));
+            col.ti = -wi * hi;
+            col.overlaps = true;
+            hit = true;
+        }
+        else
+        {
+            auto seg = segmentIntersectionIndices(diff, 0.0f, 0.0f, dx, dy, -k_Infinity, k_Infinity);
+            // The item tunnels into the other, ignoring grazing contact with
+            // a corner.
+            if (seg.has_value() && seg->ti1 < 1.0f && std::abs(seg->ti1 - seg->ti2) >= k_Delta
+                && (0.0f < seg->ti1 + k_Delta || (seg->ti1 == 0.0f && seg->ti2 > 0.0f)))
+            {
+                col.ti = seg->ti1;
+                col.normalX = seg->nx1;
+                col.normalY = seg->ny1;
+                col.overlaps = false;
+                hit = true;
+            }
+        }
+
+        if (!hit)
+            { return std::nullopt; }
+
+        if (col.overlaps)
+        {
+            if (dx == 0.0f && dy == 0.0f)
+            {
+                // Intersecting and not moving, use the minimum displacement.
+                auto px = nearest(0.0f, diff.x, diff.x + diff.width);
+                auto py = nearest(0.0f, diff.y, diff.y + diff.height);
+                if (std::abs(px) < std::abs(py)) { py = 0.0f; } else { px = 0.0f; }
+                col.normalX = sign(px);
+                col.normalY = sign(py);
+                col.touchX = a.x + px;
+                col.touchY = a.y + py;
+            }
+            else
+            {
+                // Intersecting and moving, back out the way we came.
+                auto seg = segmentIntersectionIndices(diff, 0.0f, 0.0f, dx, dy, -k_Infinity, 1.0f);
+                if (!seg.has_value())
+                    { return std::nullopt; }
+                col.normalX = seg->nx1;
+                col.normalY = seg->ny1;
+                col.touchX = a.x + dx * seg->ti1;
+                col.touchY = a.y + dy * seg->ti1;
+            }
+        }
+        else
+        {
+            col.touchX = a.x + dx * col.ti;
+            col.touchY = a.y + dy * col.ti;
+        }
+
+        col.moveX = dx;
+        col.moveY = dy;
+        col.itemRect = a;
+        col.otherRect = b;
+        return col;
+    }
+
+    float squareDistance(PDRect a, PDRect b)
+    {
+        auto dx = a.x - b.x + (a.width - b.width) / 2.0f;
+        auto dy = a.y - b.y + (a.height - b.height) / 2.0f;
+        return dx * dx + dy * dy;
+    }
+
+    std::vector<Collision> project(LCDSprite* item, PDRect rect, float goalX, float goalY,
+                                   const std::unordered_set<LCDSprite*>& visited)
+    {
+        std::vector<Collision> collisions;
+        for (auto other : state().displayList)
+        {
+            if (other == item || !isCollidable(other) || visited.contains(other))
+                { continue; }
+
+            auto otherRect = worldCollideRect(other);
+            auto col = detectCollision(rect, otherRect, goalX, goalY);
+            if (!col.has_value())
+                { continue; }
+
+            col->other = other;
+            col->type = item->collisionResponse != nullptr ? item->collisionResponse(item, other) : kCollisionTypeFreeze;
+            collisions.push_back(*col);
+        }
+
+        std::sort(collisions.begin(), collisions.end(), [](const Collision& a, const Collision& b)
+        {
+            if (a.ti == b.ti)
+                { return squareDistance(a.itemRect, a.otherRect) < squareDistance(b.itemRect, b.otherRect); }
+            return a.ti < b.ti;
+        });
+        return collisions;
+    }
+
+    // Resolves a move of the item's collide rect to (goalX, goalY), returning
+    // the collisions along the way, and leaving the final rect position in
+    // goalX and goalY.
+    std::vector<Collision> check(LCDSprite* item, float& goalX, float& goalY)
+    {
+        std::vector<Collision> results;
+        if (!item->collisionsEnabled || !item->hasCollideRect)
+            { return results; }
+
+        std::unordered_set<LCDSprite*> visited {item};
+        auto rect = worldCollideRect(item);
+        auto projected = project(item, rect, goalX, goalY, visited);
+
+        while (!projected.empty())
+        {
+            auto col = projected.front();
+            results.push_back(col);
+            visited.insert(col.other);
+
+            switch (col.type)
+            {
+                case kCollisionTypeFreeze:
+                    goalX = col.touchX;
+                    goalY = col.touchY;
+                    projected.clear();
+                    continue;
+
+                case kCollisionTypeOverlap:
+                    break;
+
+                case kCollisionTypeSlide:
+                    if (col.moveX != 0.0f || col.moveY != 0.0f)
+                    {
+                        if (col.normalX != 0) { goalX = col.touchX; } else { goalY = col.touchY; }
+                    }
+                    rect.x = col.touchX;
+                    rect.y = col.touchY;
+                    break;
+
+                case kCollisionTypeBounce:
+                {
+                    auto bx = col.touchX, by = col.touchY;
+                    if (col.moveX != 0.0f || col.moveY != 0.0f)
+                    {
+                        auto bnx = goalX - col.touchX, bny = goalY - col.touchY;
+                        if (col.normalX == 0) { bny = -bny; } else { bnx = -bnx; }
+                        bx = col.touchX + bnx;
+                        by = col.touchY + bny;
+                    }
+                    rect.x = col.touchX;
+                    rect.y = col.touchY;
+                    goalX = bx;
+                    goalY = by;
+                    break;
+                }
+            }
+            projected = project(item, rect, goalX, goalY, visited);
+        }
+        return results;
+    }
+
+    SpriteCollisionInfo* resolveMove(LCDSprite* sprite, float goalX, float goalY, float* actualX, float* actualY,
+                                     int* len, bool applyMove)
+    {
+        auto offsetX = collideOffsetX(sprite);
+        auto offsetY = collideOffsetY(sprite);
+        auto rectGoalX = goalX + offsetX;
+        auto rectGoalY = goalY + offsetY;
+
+        auto collisions = check(sprite, rectGoalX, rectGoalY);
+        auto finalX = collisions.empty() ? goalX : rectGoalX - offsetX;
+        auto finalY = collisions.empty() ? goalY : rectGoalY - offsetY;
+
+        if (actualX != nullptr) { *actualX = finalX; }
+        if (actualY != nullptr) { *actualY = finalY; }
+        if (applyMove)
+            { placeAt(sprite, finalX, finalY); }
+
+        std::vector<SpriteCollisionInfo> infos;
+        for (auto& col : collisions)
+        {
+            SpriteCollisionInfo info {};
+            info.sprite = sprite;
+            info.other = col.other;
+            info.responseType = col.type;
+            info.overlaps = col.overlaps ? 1 : 0;
+            info.ti = col.ti;
+            info.move = {col.moveX, col.moveY};
+            info.normal = {col.normalX, col.normalY};
+            info.touch = {col.touchX - offsetX, col.touchY - offsetY};
+            info.spriteRect = col.itemRect;
+            info.otherRect = col.otherRect;
+            infos.push_back(info);
+        }
+
+        int count = 0;
+        auto result = copyOut(infos, &count);
+        if (len != nullptr) { *len = count; }
+        return result;
+    }
+
+    bool rectsIntersect(PDRect a, PDRect b)
+        { return a.x < b.x + b.width && b.x < a.x + a.width && a.y < b.y + b.height && b.y < a.y + a.height; }
+
+    //==========================================================================
+    void setAlwaysRedraw(int flag) { state().alwaysRedraw = flag != 0; }
+    void addDirtyRect(LCDRect dirtyRect) { state().dirtyRects.push_back(dirtyRect); }
+
+    void drawSprite(LCDSprite* s, const LCDRect& region, int offsetX, int offsetY)
+    {
+        auto& gfx = context().graphicsAPI;
+        auto ox = s->ignoresDrawOffset ? 0 : offsetX;
+        auto oy = s->ignoresDrawOffset ? 0 : offsetY;
+
+        auto left = region.left, top = region.top, right = region.right, bottom = region.bottom;
+        if (s->hasClipRect)
+        {
+            left = std::max(left, s->clipRect.left);
+            top = std::max(top, s->clipRect.top);
+            right = std::min(right, s->clipRect.right);
+            bottom = std::min(bottom, s->clipRect.bottom);
+        }
+        if (left >= right || top >= bottom)
+            { return; }
+
+        gfx.setDrawOffset(ox, oy);
+        gfx.setScreenClipRect(left, top, right - left, bottom - top);
+        if (s->stencilPattern != nullptr)
+            { gfx.setStencilImage(s->stencilPattern.get(), 1); }
+        else
+            { gfx.setStencilImage(s->stencil, s->tileStencil ? 1 : 0); }
+
+        if (s->image != nullptr)
+        {
+            auto previous = gfx.setDrawMode(s->drawMode);
+            gfx.drawBitmap(s->image, roundToInt(s->bounds.x), roundToInt(s->bounds.y), s->flip);
+            gfx.setDrawMode(previous);
+        }
+        else if (s->drawFunction != nullptr)
+        {
+            PDRect drawRect {static_cast<float>(left - ox), static_cast<float>(top - oy),
+                             static_cast<float>(right - left), static_cast<float>(bottom - top)};
+            s->drawFunction(s, s->bounds, drawRect);
+        }
+    }
+
+    void drawSprites()
+    {
+        auto& sprites = state();
+        auto& ctx = context();
+
+        // The dirty areas are merged into one region, which is redrawn.
+        LCDRect region {0, 0, 0, 0};
+        if (sprites.alwaysRedraw)
+            { region = {0, LCD_COLUMNS, 0, LCD_ROWS}; }
+        else if (!sprites.dirtyRects.empty())
+        {
+            region = sprites.dirtyRects.front();
+            for (auto& r : sprites.dirtyRects)
+            {
+                region.left = std::min(region.left, r.left);
+                region.top = std::min(region.top, r.top);
+                region.right = std::max(region.right, r.right);
+                region.bottom = std::max(region.bottom, r.bottom);
+            }
+            region.left = std::max(region.left, 0);
+            region.top = std::max(region.top, 0);
+            region.right = std::min(region.right, LCD_COLUMNS);
+            region.bottom = std::min(region.bottom, LCD_ROWS);
+        }
+        sprites.dirtyRects.clear();
+
+        if (region.left >= region.right || region.top >= region.bottom)
+            { return; }
+
+        auto& dc = ctx.graphics.current();
+        auto offsetX = dc.offsetX, offsetY = dc.offsetY;
+        auto& gfx = ctx.graphicsAPI;
+        gfx.pushContext(nullptr);
+
+        if (ctx.graphics.backgroundColor != kColorClear)
+            { gfx.fillRect(region.left, region.top, region.right - region.left, region.bottom - region.top,
+                           ctx.graphics.backgroundColor); }
+
+        auto list = sprites.displayList;
+        for (auto s : list)
+        {
+            if (s->visible)
+                { drawSprite(s, region, offsetX, offsetY); }
+        }
+        gfx.popContext();
+    }
+
+    void updateAndDrawSprites()
+    {
+        auto list = state().displayList;
+        for (auto s : list)
+        {
+            if (state().sprites.contains(s) && s->inDisplayList && s->updatesEnabled && s->updateFunction != nullptr)
+                { s->updateFunction(s); }
+        }
+        drawSprites();
+    }
+
+    LCDSprite* newSprite()
+    {
+        auto s = new LCDSprite;
+        state().sprites.insert(s);
+        return s;
+    }
+
+    void removeSprite(LCDSprite* s)
+    {
+        if (!s->inDisplayList)
+            { return; }
+
+        markDirty(s);
+        s->inDisplayList = false;
+        std::erase(state().displayList, s);
+    }
+
+    void freeSprite(LCDSprite* s)
+    {
+        if (s == nullptr)
+            { return; }
+
+        if (!state().sprites.contains(s))
+        {
+            pdcpp::host::reportError("freeSprite called on a sprite which wasn't allocated, or was already freed");
+            return;
+        }
+        removeSprite(s);
+        state().sprites.erase(s);
+        delete s;
+    }
+
+    LCDSprite* copy(LCDSprite* s)
+    {
+        auto c = newSprite();
+        c->bounds = s->bounds;
+        c->centerX = s->centerX;
+        c->centerY = s->centerY;
+        c->collideRect = s->collideRect;
+        c->hasCollideRect = s->hasCollideRect;
+        c->image = s->image;
+        c->flip = s->flip;
+        c->drawMode = s->drawMode;
+        c->zIndex = s->zIndex;
+        c->updatesEnabled = s->updatesEnabled;
+        c->collisionsEnabled = s->collisionsEnabled;
+        c->visible = s->visible;
+        c->opaque = s->opaque;
+        c->ignoresDrawOffset = s->ignoresDrawOffset;
+        c->tag = s->tag;
+        c->clipRect = s->clipRect;
+        c->hasClipRect = s->hasClipRect;
+        c->stencil = s->stencil;
+        c->tileStencil = s->tileStencil;
+        if (s->stencilPattern != nullptr)
+            { c->stencilPattern.reset(s->stencilPattern->clone()); }
+        c->updateFunction = s->updateFunction;
+        c->drawFunction = s->drawFunction;
+        c->collisionResponse = s->collisionResponse;
+        c->userdata = s->userdata;
+        return c;
+    }
+
+    void addSprite(LCDSprite* s)
+    {
+        if (s->inDisplayList)
+            { return; }
+
+        s->inDisplayList = true;
+        s->sequence = state().nextSequence++;
+        state().displayList.push_back(s);
+        sortDisplayList();
+        markDirty(s);
+    }
+
+    void removeSprites(LCDSprite** sprites, int count)
+    {
+        for (int i = 0; i < count; i++)
+            { removeSprite(sprites[i]); }
+    }
+
+    void removeAllSprites()
+    {
+        auto list = state().displayList;
+        for (auto s : list)
+            { removeSprite(s); }
+    }
+
+    int getSpriteCount() { return static_cast<int>(state().displayList.size()); }
+
+    void setBounds(LCDSprite* s, PDRect bounds)
+    {
+        markDirty(s);
+        s->bounds = bounds;
+        markDirty(s);
+    }
+
+    PDRect getBounds(LCDSprite* s) { return s->bounds; }
+    void moveTo(LCDSprite* s, float x, float y) { placeAt(s, x, y); }
+    void moveBy(LCDSprite* s, float dx, float dy) { placeAt(s, positionX(s) + dx, positionY(s) + dy); }
+
+    void setSize(LCDSprite* s, float width, float height)
+    {
+        auto x = positionX(s), y = positionY(s);
+        markDirty(s);
+        s->bounds.width = width;
+        s->bounds.height = height;
+        placeAt(s, x, y);
+    }
+
+    void setImage(LCDSprite* s, LCDBitmap* image, LCDBitmapFlip flip)
+    {
+        s->image = image;
+        s->flip = flip;
+        if (image != nullptr)
+            { setSize(s, static_cast<float>(image->width), static_cast<float>(image->height)); }
+        markDirty(s);
+    }
+
+    LCDBitmap* getImage(LCDSprite* s) { return s->image; }
+
+    void setZIndex(LCDSprite* s, int16_t zIndex)
+    {
+        s->zIndex = zIndex;
+        sortDisplayList();
+        markDirty(s);
+    }
+
+    int16_t getZIndex(LCDSprite* s) { return s->zIndex; }
+    void setDrawMode(LCDSprite* s, LCDBitmapDrawMode mode) { s->drawMode = mode; markDirty(s); }
+    void setImageFlip(LCDSprite* s, LCDBitmapFlip flip) { s->flip = flip; markDirty(s); }
+    LCDBitmapFlip getImageFlip(LCDSprite* s) { return s->flip; }
+
+    void setStencilImage(LCDSprite* s, LCDBitmap* stencil, int tile)
+    {
+        s->stencil = stencil;
+        s->tileStencil = tile != 0;
+        s->stencilPattern = nullptr;
+        markDirty(s);
+    }
+
+    void setStencil(LCDSprite* s, LCDBitmap* stencil) { setStencilImage(s, stencil, 0); }
+
+    void setStencilPattern(LCDSprite* s, uint8_t pattern[8])
+    {
+        s->stencilPattern = std::make_unique<LCDBitmap>(8, 8);
+        for (int row = 0; row < 8; row++)
+            { (*s->stencilPattern->data)[row * s->stencilPattern->rowBytes] = pattern[row]; }
+        markDirty(s);
+    }
+
+    void clearStencil(LCDSprite* s)
+    {
+        s->stencil = nullptr;
+        s->stencilPattern = nullptr;
+        markDirty(s);
+    }
+
+    void setClipRect(LCDSprite* s, LCDRect clipRect)
+    {
+        s->clipRect = clipRect;
+        s->hasClipRect = true;
+        markDirty(s);
+    }
+
+    void clearClipRect(LCDSprite* s)
+    {
+        s->hasClipRect = false;
+        markDirty(s);
+    }
+
+    void setClipRectsInRange(LCDRect clipRect, int startZ, int endZ)
+    {
+        for (auto s : state().displayList)
+        {
+            if (s->zIndex >= startZ && s->zIndex <= endZ)
+                { setClipRect(s, clipRect); }
+        }
+    }
+
+    void clearClipRectsInRange(int startZ, int endZ)
+    {
+        for (auto s : state().displayList)
+        {
+            if (s->zIndex >= startZ && s->zIndex <= endZ)
+                { clearClipRect(s); }
+        }
+    }
+
+    void setUpdatesEnabled(LCDSprite* s, int flag) { s->updatesEnabled = flag != 0; }
+    int updatesEnabled(LCDSprite* s) { return s->updatesEnabled ? 1 : 0; }
+    void setCollisionsEnabled(LCDSprite* s, int flag) { s->collisionsEnabled = flag != 0; }
+    int collisionsEnabled(LCDSprite* s) { return s->collisionsEnabled ? 1 : 0; }
+
+    void setVisible(LCDSprite* s, int flag)
+    {
+        s->visible = flag != 0;
+        markDirty(s);
+    }
+
+    int isVisible(LCDSprite* s) { return s->visible ? 1 : 0; }
+    void setOpaque(LCDSprite* s, int flag) { s->opaque = flag != 0; }
+    void markSpriteDirty(LCDSprite* s) { markDirty(s); }
+    void setTag(LCDSprite* s, uint8_t tag) { s->tag = tag; }
+    uint8_t getTag(LCDSprite* s) { return s->tag; }
+
+    void setIgnoresDrawOffset(LCDSprite* s, int flag)
+    {
+        markDirty(s);
+        s->ignoresDrawOffset = flag != 0;
+        markDirty(s);
+    }
+
+    void setUpdateFunction(LCDSprite* s, LCDSpriteUpdateFunction* func) { s->updateFunction = func; }
+    void setDrawFunction(LCDSprite* s, LCDSpriteDrawFunction* func) { s->drawFunction = func; markDirty(s); }
+
+    void getPosition(LCDSprite* s, float* x, float* y)
+    {
+        if (x != nullptr) { *x = positionX(s); }
+        if (y != nullptr) { *y = positionY(s); }
+    }
+
+    void resetCollisionWorld() {}
+
+    void setCollideRect(LCDSprite* s, PDRect collideRect)
+    {
+        s->collideRect = collideRect;
+        s->hasCollideRect = true;
+    }
+
+    PDRect getCollideRect(LCDSprite* s) { return s->collideRect; }
+
+    void clearCollideRect(LCDSprite* s)
+    {
+        s->collideRect = {0.0f, 0.0f, 0.0f, 0.0f};
+        s->hasCollideRect = false;
+    }
+
+    void setCollisionResponseFunction(LCDSprite* s, LCDSpriteCollisionFilterProc* func)
+        { s->collisionResponse = func; }
+
+    SpriteCollisionInfo* checkCollisions(LCDSprite* s, float goalX, float goalY, float* actualX, float* actualY, int* len)
+        { return resolveMove(s, goalX, goalY, actualX, actualY, len, false); }
+
+    SpriteCollisionInfo* moveWithCollisions(LCDSprite* s, float goalX, float goalY, float* actualX, float* actualY,
+                                            int* len)
+        { return resolveMove(s, goalX, goalY, actualX, actualY, len, true); }
+
+    template <typename Predicate>
+    LCDSprite** querySprites(int* len, Predicate predicate)
+    {
+        std::vector<LCDSprite*> found;
+        for (auto s : state().displayList)
+        {
+            if (isCollidable(s) && predicate(worldCollideRect(s)))
+                { found.push_back(s); }
+        }
+        return copyOut(found, len);
+    }
+
+    LCDSprite** querySpritesAtPoint(float x, float y, int* len)
+    {
+        return querySprites(len, [=](PDRect r)
+            { return x >= r.x && x < r.x + r.width && y >= r.y && y < r.y + r.height; });
+    }
+
+    LCDSprite** querySpritesInRect(float x, float y, float width, float height, int* len)
+        { return querySprites(len, [=](PDRect r) { return rectsIntersect(r, {x, y, width, height}); }); }
+
+    LCDSprite** querySpritesAlongLine(float x1, float y1, float x2, float y2, int* len)
+    {
+        return querySprites(len, [=](PDRect r)
+            { return segmentIntersectionIndices(r, x1, y1, x2, y2, 0.0f, 1.0f).has_value(); });
+    }
+
+    SpriteQueryInfo* querySpriteInfoAlongLine(float x1, float y1, float x2, float y2, int* len)
+    {
+        std::vector<SpriteQueryInfo> found;
+        for (auto s : state().displayList)
+        {
+            if (!isCollidable(s))
+                { continue; }
+
+            auto seg = segmentIntersectionIndices(worldCollideRect(s), x1, y1, x2, y2, 0.0f, 1.0f);
+            if (!seg.has_value())
+                { continue; }
+
+            SpriteQueryInfo info {};
+            info.sprite = s;
+            info.ti1 = seg->ti1;
+            info.ti2 = seg->ti2;
+            info.entryPoint = {x1 + (x2 - x1) * seg->ti1, y1 + (y2 - y1) * seg->ti1};
+            info.exitPoint = {x1 + (x2 - x1) * seg->ti2, y1 + (y2 - y1) * seg->ti2};
+            found.push_back(info);
+        }
+
+        std::sort(found.begin(), found.end(), [](auto& a, auto& b) { return a.ti1 < b.ti1; });
+        return copyOut(found, len);
+    }
+
+    LCDSprite** overlappingSprites(LCDSprite* sprite, int* len)
+    {
+        if (!isCollidable(sprite))
+        {
+            *len = 0;
+            return nullptr;
+        }
+
+        auto rect = worldCollideRect(sprite);
+        std::vector<LCDSprite*> found;
+        for (auto s : state().displayList)
+        {
+            if (s != sprite && isCollidable(s) && rectsIntersect(rect, worldCollideRect(s)))
+                { found.push_back(s); }
+        }
+        return copyOut(found, len);
+    }
+
+    LCDSprite** allOverlappingSprites(int* len)
+    {
+        // Consecutive pairs of the returned array overlap each other.
+        std::vector<LCDSprite*> found;
+        auto& list = state().displayList;
+        for (size_t i = 0; i < list.size(); i++)
+        {
+            for (size_t j = i + 1; j < list.size(); j++)
+            {
+                if (isCollidable(list[i]) && isCollidable(list[j])
+                    && rectsIntersect(worldCollideRect(list[i]), worldCollideRect(list[j])))
+                {
+                    found.push_back(list[i]);
+                    found.push_back(list[j]);
+                }
+            }
+        }
+        return copyOut(found, len);
+    }
+
+    void setUserdata(LCDSprite* s, void* userdata) { s->userdata = userdata; }
+    void* getUserdata(LCDSprite* s) { return s->userdata; }
+
+    void setCenter(LCDSprite* s, float x, float y)
+    {
+        auto px = positionX(s), py = positionY(s);
+        s->centerX = x;
+        s->centerY = y;
+        placeAt(s, px, py);
+    }
+
+    void getCenter(LCDSprite* s, float* x, float* y)
+    {
+        if (x != nullptr) { *x = s->centerX; }
+        if (y != nullptr) { *y = s->centerY; }
+    }
+}
+
+pdcpp::host::SpriteState::~SpriteState()
+{
+    for (auto sprite : sprites)
+        { delete sprite; }
+}
+
+void pdcpp::host::populateSpriteAPI(playdate_sprite& api)
+{
+    api.setAlwaysRedraw = setAlwaysRedraw;
+    api.addDirtyRect = addDirtyRect;
+    api.drawSprites = drawSprites;
+    api.updateAndDrawSprites = updateAndDrawSprites;
+    api.newSprite = newSprite;
+    api.freeSprite = freeSprite;
+    api.copy = copy;
+    api.addSprite = addSprite;
+    api.removeSprite = removeSprite;
+    api.removeSprites = removeSprites;
+    api.removeAllSprites = removeAllSprites;
+    api.getSpriteCount = getSpriteCount;
+    api.setBounds = setBounds;
+    api.getBounds = getBounds;
+    api.moveTo = moveTo;
+    api.moveBy = moveBy;
+    api.setImage = setImage;
+    api.getImage = getImage;
+    api.setSize = setSize;
+    api.setZIndex = setZIndex;
+    api.getZIndex = getZIndex;
+    api.setDrawMode = setDrawMode;
+    api.setImageFlip = setImageFlip;
+    api.getImageFlip = getImageFlip;
+    api.setStencil = setStencil;
+    api.setClipRect = setClipRect;
+    api.clearClipRect = clearClipRect;
+    api.setClipRectsInRange = setClipRectsInRange;
+    api.clearClipRectsInRange = clearClipRectsInRange;
+    api.setUpdatesEnabled = setUpdatesEnabled;
+    api.updatesEnabled = updatesEnabled;
+    api.setCollisionsEnabled = setCollisionsEnabled;
+    api.collisionsEnabled = collisionsEnabled;
+    api.setVisible = setVisible;
+    api.isVisible = isVisible;
+    api.setOpaque = setOpaque;
+    api.markDirty = markSpriteDirty;
+    api.setTag = setTag;
+    api.getTag = getTag;
+    api.setIgnoresDrawOffset = setIgnoresDrawOffset;
+    api.setUpdateFunction = setUpdateFunction;
+    api.setDrawFunction = setDrawFunction;
+    api.getPosition = getPosition;
+    api.resetCollisionWorld = resetCollisionWorld;
+    api.setCollideRect = setCollideRect;
+    api.getCollideRect = getCollideRect;
+    api.clearCollideRect = clearCollideRect;
+    api.setCollisionResponseFunction = setCollisionResponseFunction;
+    api.checkCollisions = checkCollisions;
+    api.moveWithCollisions = moveWithCollisions;
+    api.querySpritesAtPoint = querySpritesAtPoint;
+    api.querySpritesInRect = querySpritesInRect;
+    api.querySpritesAlongLine = querySpritesAlongLine;
+    api.querySpriteInfoAlongLine = querySpriteInfoAlongLine;
+    api.overlappingSprites = overlappingSprites;
+    api.allOverlappingSprites = allOverlappingSprites;
+    api.setStencilPattern = setStencilPattern;
+    api.clearStencil = clearStencil;
+    api.setUserdata = setUserdata;
+    api.getUserdata = getUserdata;
+    api.setStencilImage = setStencilImage;
+    api.setCenter = setCenter;
+    api.getCenter = getCenter;
+}
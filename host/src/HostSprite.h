@@ -0,0 +1,81 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#pragma once
+
+#include <pd_api.h>
+#include <cstdint>
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * The host's definition of the SDK's opaque sprite. Bounds are stored with
+ * their origin at the top left, the position reported by `getPosition` is
+ * wherever the sprite's center falls inside them.
+ */
+struct LCDSprite
+{
+    PDRect bounds {0.0f, 0.0f, 0.0f, 0.0f};
+    float centerX = 0.5f;
+    float centerY = 0.5f;
+
+    PDRect collideRect {0.0f, 0.0f, 0.0f, 0.0f};
+    bool hasCollideRect = false;
+
+    LCDBitmap* image = nullptr;
+    LCDBitmapFlip flip = kBitmapUnflipped;
+    LCDBitmapDrawMode drawMode = kDrawModeCopy;
+    int16_t zIndex = 0;
+    uint64_t sequence = 0;
+
+    bool inDisplayList = false;
+    bool updatesEnabled = true;
+    bool collisionsEnabled = true;
+    bool visible = true;
+    bool opaque = false;
+    bool ignoresDrawOffset = false;
+    uint8_t tag = 0;
+
+    LCDRect clipRect {0, 0, 0, 0};
+    bool hasClipRect = false;
+
+    LCDBitmap* stencil = nullptr;
+    bool tileStencil = false;
+    std::unique_ptr<LCDBitmap> stencilPattern;
+
+    LCDSpriteUpdateFunction* updateFunction = nullptr;
+    LCDSpriteDrawFunction* drawFunction = nullptr;
+    LCDSpriteCollisionFilterProc* collisionResponse = nullptr;
+    void* userdata = nullptr;
+};
+
+namespace pdcpp::host
+{
+    /**
+     * Everything behind `playdate->sprite`: the display list, dirty regions,
+     * and collision world.
+     */
+    struct SpriteState
+    {
+        ~SpriteState();
+
+        std::vector<LCDSprite*> displayList;
+        std::unordered_set<LCDSprite*> sprites;
+        std::vector<LCDRect> dirtyRects;
+        uint64_t nextSequence = 0;
+        bool alwaysRedraw = false;
+    };
+
+    /**
+     * Fills in the `playdate->sprite` function table.
+     */
+    void populateSpriteAPI(playdate_sprite& api);
+}
@@ -0,0 +1,940 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#include "HostContext.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+namespace
+{
+    using pdcpp::host::context;
+    using pdcpp::host::k_BlockSize;
+    using pdcpp::host::k_SampleRate;
+    using pdcpp::host::k_Unity;
+
+    constexpr float k_TwoPi = 2.0f * std::numbers::pi_v<float>;
+
+    // Samples are tuned so that playing middle C plays them at their own rate.
+    constexpr float k_SampleBaseFrequency = 261.6256f;
+
+    auto& state() { return context().sound; }
+
+    float random(uint32_t& seed)
+    {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        return static_cast<float>(seed) / 2147483648.0f - 1.0f;
+    }
+
+    int32_t signedDelta(uint32_t a, uint32_t b) { return static_cast<int32_t>(a - b); }
+
+    //==========================================================================
+    // playdate->sound->signal
+    PDSynthSignal* newSignal(signalStepFunc step, signalNoteOnFunc noteOn, signalNoteOffFunc noteOff,
+                             signalDeallocFunc dealloc, void* userdata)
+    {
+        auto signal = new PDSynthSignal;
+        signal->stepFunction = step;
+        signal->noteOnFunction = noteOn;
+        signal->noteOffFunction = noteOff;
+        signal->deallocFunction = dealloc;
+        signal->userdata = userdata;
+        return state().track(signal);
+    }
+
+    void freeSignal(PDSynthSignal* signal) { state().destroy(signal, "freeSignal"); }
+
+    // Every kind of signal is handed to these, not just custom ones.
+    float signalGetValue(PDSynthSignal* signal) { return static_cast<PDSynthSignalValue*>(signal)->getValue(); }
+    void setValueScale(PDSynthSignal* signal, float scale) { static_cast<PDSynthSignalValue*>(signal)->scale = scale; }
+    void setValueOffset(PDSynthSignal* signal, float offset) { static_cast<PDSynthSignalValue*>(signal)->offset = offset; }
+
+    PDSynthSignal* newSignalForValue(PDSynthSignalValue* value)
+    {
+        auto signal = new PDSynthSignal;
+        signal->source = value;
+        return state().track(signal);
+    }
+
+    //==========================================================================
+    // playdate->sound->lfo
+    PDSynthLFO* newLFO(LFOType type)
+    {
+        auto lfo = new PDSynthLFO;
+        lfo->type = type;
+        return state().track(lfo);
+    }
+
+    void freeLFO(PDSynthLFO* lfo) { state().destroy(lfo, "freeLFO"); }
+    void lfoSetType(PDSynthLFO* lfo, LFOType type) { lfo->type = type; }
+    void lfoSetRate(PDSynthLFO* lfo, float rate) { lfo->rate = rate; }
+    void lfoSetPhase(PDSynthLFO* lfo, float phase) { lfo->phase = phase - std::floor(phase); }
+    void lfoSetCenter(PDSynthLFO* lfo, float center) { lfo->center = center; }
+    void lfoSetDepth(PDSynthLFO* lfo, float depth) { lfo->depth = depth; }
+
+    void setArpeggiation(PDSynthLFO* lfo, int nSteps, float* steps)
+        { lfo->arpeggio.assign(steps, steps + std::max(nSteps, 0)); }
+
+    void lfoSetFunction(PDSynthLFO* lfo, float (*lfoFunc)(PDSynthLFO*, void*), void* userdata, int interpolate)
+    {
+        lfo->function = lfoFunc;
+        lfo->functionUserdata = userdata;
+        lfo->interpolate = interpolate != 0;
+    }
+
+    void lfoSetDelay(PDSynthLFO* lfo, float holdoff, float ramptime)
+    {
+        lfo->holdoff = holdoff;
+        lfo->rampTime = ramptime;
+    }
+
+    void lfoSetRetrigger(PDSynthLFO* lfo, int flag) { lfo->retrigger = flag != 0; }
+    float lfoGetValue(PDSynthLFO* lfo) { return lfo->getValue(); }
+    void lfoSetGlobal(PDSynthLFO* lfo, int global) { lfo->global = global != 0; }
+    void lfoSetStartPhase(PDSynthLFO* lfo, float phase) { lfo->startPhase = phase - std::floor(phase); }
+
+    //==========================================================================
+    // playdate->sound->envelope
+    PDSynthEnvelope* newEnvelope(float attack, float decay, float sustain, float release)
+    {
+        auto envelope = new PDSynthEnvelope;
+        envelope->attack = attack;
+        envelope->decay = decay;
+        envelope->sustain = sustain;
+        envelope->release = release;
+        return state().track(envelope);
+    }
+
+    void freeEnvelope(PDSynthEnvelope* env) { state().destroy(env, "freeEnvelope"); }
+    void setAttack(PDSynthEnvelope* env, float attack) { env->attack = std::max(attack, 0.0f); }
+    void setDecay(PDSynthEnvelope* env, float decay) { env->decay = std::max(decay, 0.0f); }
+    void setSustain(PDSynthEnvelope* env, float sustain) { env->sustain = std::clamp(sustain, 0.0f, 1.0f); }
+    void setRelease(PDSynthEnvelope* env, float release) { env->release = std::max(release, 0.0f); }
+    void setLegato(PDSynthEnvelope* env, int flag) { env->legato = flag != 0; }
+    void envelopeSetRetrigger(PDSynthEnvelope* env, int flag) { env->retrigger = flag != 0; }
+    float envelopeGetValue(PDSynthEnvelope* env) { return env->getValue(); }
+    void setCurvature(PDSynthEnvelope* env, float amount) { env->curvature = std::clamp(amount, 0.0f, 1.0f); }
+    void setVelocitySensitivity(PDSynthEnvelope* env, float velsens) { env->velocitySensitivity = velsens; }
+
+    void setRateScaling(PDSynthEnvelope* env, float scaling, MIDINote start, MIDINote end)
+    {
+        env->rateScaling = scaling;
+        env->rateScalingStart = start;
+        env->rateScalingEnd = end;
+    }
+
+    //==========================================================================
+    // playdate->sound->synth
+    PDSynth* newSynth() { return state().track(new PDSynth); }
+    void freeSynth(PDSynth* synth) { state().destroy(synth, "freeSynth"); }
+
+    void setWaveform(PDSynth* synth, SoundWaveform wave)
+    {
+        synth->waveform = wave;
+        synth->sample = nullptr;
+        synth->wavetable.clear();
+    }
+
+    void setGenerator(PDSynth* synth, int flags, synthRenderFunc render, synthNoteOnFunc noteOn,
+                      synthReleaseFunc release, synthSetParameterFunc setparam, synthDeallocFunc dealloc,
+                      synthCopyUserdata copyUserdata, void* userdata)
+    {
+        if (synth->generatorDealloc != nullptr)
+            { synth->generatorDealloc(synth->generatorUserdata); }
+
+        synth->generatorStereo = (flags & SYNTHFLAG_STEREO) != 0;
+        synth->generatorRender = render;
+        synth->generatorNoteOn = noteOn;
+        synth->generatorRelease = release;
+        synth->generatorSetParameter = setparam;
+        synth->generatorDealloc = dealloc;
+        synth->generatorCopy = copyUserdata;
+        synth->generatorUserdata = userdata;
+    }
+
+    void setGeneratorDeprecated(PDSynth* synth, int stereo, synthRenderFunc render, synthNoteOnFunc noteOn,
+                                synthReleaseFunc release, synthSetParameterFunc setparam,
+                                synthDeallocFunc dealloc, void* userdata)
+    {
+        setGenerator(synth, stereo != 0 ? SYNTHFLAG_STEREO : 0, render, noteOn, release, setparam, dealloc,
+                     nullptr, userdata);
+    }
+
+    void synthSetSample(PDSynth* synth, AudioSample* sample, uint32_t sustainStart, uint32_t sustainEnd)
+    {
+        synth->sample = sample;
+        synth->sustainStart = sustainStart;
+        synth->sustainEnd = sustainEnd;
+        synth->wavetable.clear();
+    }
+
+    void setAttackTime(PDSynth* synth, float attack) { setAttack(&synth->envelope, attack); }
+    void setDecayTime(PDSynth* synth, float decay) { setDecay(&synth->envelope, decay); }
+    void setSustainLevel(PDSynth* synth, float sustain) { setSustain(&synth->envelope, sustain); }
+    void setReleaseTime(PDSynth* synth, float release) { setRelease(&synth->envelope, release); }
+    void synthSetTranspose(PDSynth* synth, float halfSteps) { synth->transpose = halfSteps; }
+    void setFrequencyModulator(PDSynth* synth, PDSynthSignalValue* mod) { synth->frequencyModulator = mod; }
+    PDSynthSignalValue* getFrequencyModulator(PDSynth* synth) { return synth->frequencyModulator; }
+    void setAmplitudeModulator(PDSynth* synth, PDSynthSignalValue* mod) { synth->amplitudeModulator = mod; }
+    PDSynthSignalValue* getAmplitudeModulator(PDSynth* synth) { return synth->amplitudeModulator; }
+
+    bool isPhysicalModel(const PDSynth* synth) { return synth->waveform >= kWaveformPOPhase; }
+
+    int getParameterCount(PDSynth* synth) { return isPhysicalModel(synth) ? 2 : 0; }
+
+    int setParameter(PDSynth* synth, int parameter, float value)
+    {
+        if (synth->generatorSetParameter != nullptr)
+            { return synth->generatorSetParameter(synth->generatorUserdata, parameter, value); }
+
+        if (parameter < 0 || parameter >= getParameterCount(synth))
+            { return 0; }
+
+        synth->parameters[parameter] = value;
+        return 1;
+    }
+
+    void setParameterModulator(PDSynth* synth, int parameter, PDSynthSignalValue* mod)
+        { synth->parameterModulators[parameter] = mod; }
+
+    PDSynthSignalValue* getParameterModulator(PDSynth* synth, int parameter)
+    {
+        auto found = synth->parameterModulators.find(parameter);
+        return found != synth->parameterModulators.end() ? found->second : nullptr;
+    }
+
+    void schedule(PDSynth* synth, float freq, MIDINote note, float vel, float len, uint32_t when)
+    {
+        synth->pendingStart = true;
+        synth->startTime = when == 0 ? pdcpp::host::soundTime() : when;
+        synth->pendingFrequency = freq;
+        synth->pendingVelocity = vel;
+        synth->pendingLength = len;
+        synth->pendingStop = false;
+        synth->note = note;
+    }
+
+    void playNote(PDSynth* synth, float freq, float vel, float len, uint32_t when)
+        { schedule(synth, freq, pd_frequencyToNote(freq), vel, len, when); }
+
+    void playMIDINote(PDSynth* synth, MIDINote note, float vel, float len, uint32_t when)
+        { schedule(synth, pd_noteToFrequency(note), note, vel, len, when); }
+
+    void synthNoteOff(PDSynth* synth, uint32_t when)
+    {
+        synth->pendingStop = true;
+        synth->stopTime = when == 0 ? pdcpp::host::soundTime() : when;
+    }
+
+    void synthStop(PDSynth* synth)
+    {
+        auto wasPlaying = synth->playing;
+        synth->playing = false;
+        synth->pendingStart = false;
+        synth->pendingStop = false;
+        synth->envelope.stage = PDSynthEnvelope::Stage::Idle;
+        synth->envelope.level = 0.0f;
+
+        if (synth->generatorRelease != nullptr)
+            { synth->generatorRelease(synth->generatorUserdata, 1); }
+        if (wasPlaying)
+            { synth->finished(); }
+    }
+
+    void synthSetVolume(PDSynth* synth, float left, float right)
+    {
+        synth->leftVolume = left;
+        synth->rightVolume = right;
+    }
+
+    void synthGetVolume(PDSynth* synth, float* left, float* right)
+    {
+        if (left != nullptr) { *left = synth->leftVolume; }
+        if (right != nullptr) { *right = synth->rightVolume; }
+    }
+
+    int synthIsPlaying(PDSynth* synth) { return synth->isPlaying() ? 1 : 0; }
+
+    PDSynthEnvelope* getEnvelope(PDSynth* synth) { return synth->hasEnvelope ? &synth->envelope : nullptr; }
+
+    // Only the first cell of the table is used; there's no 2D scanning.
+    int setWavetable(PDSynth* synth, AudioSample* sample, int log2size, int columns, int rows)
+    {
+        auto size = 1 << std::clamp(log2size, 0, 16);
+        if (sample == nullptr || columns < 1 || rows < 0 || sample->frameCount() < size)
+            { return 0; }
+
+        synth->wavetable.resize(static_cast<size_t>(size));
+        for (int i = 0; i < size; ++i)
+        {
+            float l, r;
+            sample->readFrame(i, l, r);
+            synth->wavetable[static_cast<size_t>(i)] = (l + r) * 0.5f;
+        }
+        synth->sample = nullptr;
+        return 1;
+    }
+
+    PDSynth* copySynth(PDSynth* synth)
+    {
+        auto copy = new PDSynth;
+        copy->waveform = synth->waveform;
+        copy->envelope.attack = synth->envelope.attack;
+        copy->envelope.decay = synth->envelope.decay;
+        copy->envelope.sustain = synth->envelope.sustain;
+        copy->envelope.release = synth->envelope.release;
+        copy->envelope.legato = synth->envelope.legato;
+        copy->envelope.retrigger = synth->envelope.retrigger;
+        copy->envelope.curvature = synth->envelope.curvature;
+        copy->envelope.velocitySensitivity = synth->envelope.velocitySensitivity;
+        copy->envelope.rateScaling = synth->envelope.rateScaling;
+        copy->envelope.rateScalingStart = synth->envelope.rateScalingStart;
+        copy->envelope.rateScalingEnd = synth->envelope.rateScalingEnd;
+        copy->hasEnvelope = synth->hasEnvelope;
+
+        copy->generatorRender = synth->generatorRender;
+        copy->generatorNoteOn = synth->generatorNoteOn;
+        copy->generatorRelease = synth->generatorRelease;
+        copy->generatorSetParameter = synth->generatorSetParameter;
+        copy->generatorDealloc = synth->generatorDealloc;
+        copy->generatorCopy = synth->generatorCopy;
+        copy->generatorStereo = synth->generatorStereo;
+        copy->generatorUserdata = synth->generatorCopy != nullptr
+            ? synth->generatorCopy(synth->generatorUserdata)
+            : synth->generatorUserdata;
+
+        copy->sample = synth->sample;
+        copy->sustainStart = synth->sustainStart;
+        copy->sustainEnd = synth->sustainEnd;
+        copy->wavetable = synth->wavetable;
+        copy->transpose = synth->transpose;
+        copy->frequencyModulator = synth->frequencyModulator;
+        copy->amplitudeModulator = synth->amplitudeModulator;
+        copy->parameterModulators = synth->parameterModulators;
+        copy->parameters = synth->parameters;
+        copy->leftVolume = synth->leftVolume;
+        copy->rightVolume = synth->rightVolume;
+        return state().track(copy);
+    }
+
+    void clearEnvelope(PDSynth* synth) { synth->hasEnvelope = false; }
+
+    //==========================================================================
+    // playdate->sound->instrument
+    PDSynthInstrument* newInstrument() { return state().track(new PDSynthInstrument); }
+    void freeInstrument(PDSynthInstrument* inst) { state().destroy(inst, "freeInstrument"); }
+
+    int addVoice(PDSynthInstrument* inst, PDSynth* synth, MIDINote rangeStart, MIDINote rangeEnd, float transpose)
+    {
+        if (synth->instrument != nullptr)
+            { synth->instrument->forget(synth); }
+
+        // Voices are rendered by their instrument, not a channel.
+        if (synth->channel != nullptr)
+        {
+            synth->channel->forget(synth);
+            synth->channel = nullptr;
+        }
+
+        inst->voices.push_back({synth, rangeStart, rangeEnd, transpose});
+        synth->instrument = inst;
+        return 1;
+    }
+
+    PDSynth* instrumentPlayNote(PDSynthInstrument* inst, float frequency, float vel, float len, uint32_t when)
+        { return inst->playNote(pd_frequencyToNote(frequency), vel, len, when); }
+
+    PDSynth* instrumentPlayMIDINote(PDSynthInstrument* inst, MIDINote note, float vel, float len, uint32_t when)
+        { return inst->playNote(note, vel, len, when); }
+
+    void setPitchBend(PDSynthInstrument* inst, float bend) { inst->pitchBend = std::clamp(bend, -1.0f, 1.0f); }
+    void setPitchBendRange(PDSynthInstrument* inst, float halfSteps) { inst->pitchBendRange = halfSteps; }
+    void instrumentSetTranspose(PDSynthInstrument* inst, float halfSteps) { inst->transpose = halfSteps; }
+
+    void instrumentNoteOff(PDSynthInstrument* inst, MIDINote note, uint32_t when)
+    {
+        for (auto& voice : inst->voices)
+        {
+            if (voice.synth->isPlaying() && voice.synth->note == note)
+                { synthNoteOff(voice.synth, when); }
+        }
+    }
+
+    void instrumentAllNotesOff(PDSynthInstrument* inst, uint32_t when)
+    {
+        for (auto& voice : inst->voices)
+        {
+            if (voice.synth->isPlaying())
+                { synthNoteOff(voice.synth, when); }
+        }
+    }
+
+    void instrumentSetVolume(PDSynthInstrument* inst, float left, float right)
+    {
+        inst->leftVolume = left;
+        inst->rightVolume = right;
+    }
+
+    void instrumentGetVolume(PDSynthInstrument* inst, float* left, float* right)
+    {
+        if (left != nullptr) { *left = inst->leftVolume; }
+        if (right != nullptr) { *right = inst->rightVolume; }
+    }
+
+    int activeVoiceCount(PDSynthInstrument* inst)
+    {
+        return static_cast<int>(std::count_if(inst->voices.begin(), inst->voices.end(),
+                                              [](const auto& v) { return v.synth->isPlaying(); }));
+    }
+}
+
+//==============================================================================
+float PDSynthLFO::step(int frames)
+{
+    auto seconds = static_cast<float>(frames) / k_SampleRate;
+    elapsed += seconds;
+
+    auto advanced = phase + rate * seconds;
+    auto wrapped = std::floor(advanced) >= 1.0f;
+    phase = advanced - std::floor(advanced);
+
+    if (wrapped || (frames == 0 && !started))
+    {
+        if (type == kLFOTypeSampleAndHold)
+            { heldValue = random(noise); }
+        else if (type == kLFOTypeFunction && function != nullptr)
+        {
+            previousValue = heldValue;
+            heldValue = function(this, functionUserdata);
+        }
+    }
+
+    float raw;
+    switch (type)
+    {
+        case kLFOTypeSquare: raw = phase < 0.5f ? 1.0f : -1.0f; break;
+        case kLFOTypeTriangle: raw = phase < 0.5f ? 4.0f * phase - 1.0f : 3.0f - 4.0f * phase; break;
+        case kLFOTypeSine: raw = std::sin(k_TwoPi * phase); break;
+        case kLFOTypeSampleAndHold: raw = heldValue; break;
+        case kLFOTypeSawtoothUp: raw = 2.0f * phase - 1.0f; break;
+        case kLFOTypeSawtoothDown: raw = 1.0f - 2.0f * phase; break;
+        case kLFOTypeArpeggiator:
+        {
+            // Arpeggios are in half steps, modulators in octaves.
+            if (arpeggio.empty())
+                { return center; }
+            auto index = std::min(static_cast<size_t>(phase * arpeggio.size()), arpeggio.size() - 1);
+            return center + arpeggio[index] / 12.0f;
+        }
+        case kLFOTypeFunction:
+            return interpolate ? previousValue + (heldValue - previousValue) * phase : heldValue;
+        default: raw = 0.0f; break;
+    }
+
+    if (elapsed < holdoff)
+        { return center; }
+
+    auto ramp = rampTime > 0.0f ? std::min(1.0f, (elapsed - holdoff) / rampTime) : 1.0f;
+    return center + depth * ramp * raw;
+}
+
+void PDSynthLFO::noteOn(MIDINote, float, float)
+{
+    if (!retrigger)
+        { return; }
+
+    phase = startPhase;
+    elapsed = 0.0f;
+}
+
+//==============================================================================
+float PDSynthEnvelope::tick()
+{
+    auto perSample = [this](float seconds) { return 1.0f / (seconds * k_SampleRate / rateMultiplier); };
+
+    switch (stage)
+    {
+        case Stage::Idle:
+            level = 0.0f;
+            break;
+        case Stage::Attack:
+            level = attack > 0.0f ? level + perSample(attack) : 1.0f;
+            if (level >= 1.0f)
+            {
+                level = 1.0f;
+                stage = Stage::Decay;
+            }
+            break;
+        case Stage::Decay:
+            level = decay > 0.0f ? level - (1.0f - sustain) * perSample(decay) : sustain;
+            if (level <= sustain)
+            {
+                level = sustain;
+                stage = Stage::Sustain;
+            }
+            break;
+        case Stage::Sustain:
+            level = sustain;
+            break;
+        case Stage::Release:
+            level = release > 0.0f ? level - releaseFrom * perSample(release) : 0.0f;
+            if (level <= 0.0f)
+            {
+                level = 0.0f;
+                stage = Stage::Idle;
+            }
+            break;
+    }
+
+    auto shaped = level + (level * level * level - level) * curvature;
+    return shaped * (1.0f - velocitySensitivity + velocitySensitivity * velocity);
+}
+
+float PDSynthEnvelope::step(int frames)
+{
+    // A synth's own envelope is ticked by the synth as it renders.
+    if (drivenBySynth)
+        { return level * (1.0f - velocitySensitivity + velocitySensitivity * velocity); }
+
+    auto result = tick();
+    for (int i = 1; i < frames && stage != Stage::Idle && stage != Stage::Sustain; ++i)
+        { result = tick(); }
+    return result;
+}
+
+void PDSynthEnvelope::noteOn(MIDINote note, float noteVelocity, float)
+{
+    velocity = noteVelocity;
+
+    rateMultiplier = 1.0f;
+    if (rateScaling != 0.0f && rateScalingEnd > rateScalingStart)
+    {
+        auto t = std::clamp((note - rateScalingStart) / (rateScalingEnd - rateScalingStart), 0.0f, 1.0f);
+        rateMultiplier = std::max(0.01f, 1.0f + rateScaling * t);
+    }
+
+    if (legato && stage != Stage::Idle && stage != Stage::Release)
+        { return; }
+
+    if (retrigger)
+        { level = 0.0f; }
+    stage = Stage::Attack;
+}
+
+void PDSynthEnvelope::noteOff(int, int)
+{
+    if (stage == Stage::Idle)
+        { return; }
+
+    releaseFrom = std::max(level, 1e-6f);
+    stage = Stage::Release;
+}
+
+//==============================================================================
+PDSynthSignal::~PDSynthSignal()
+{
+    if (deallocFunction != nullptr)
+        { deallocFunction(userdata); }
+}
+
+float PDSynthSignal::step(int frames)
+{
+    if (source != nullptr)
+        { return source->getValue(); }
+    if (stepFunction == nullptr)
+        { return 0.0f; }
+
+    auto ioFrames = frames;
+    auto interpolated = 0.0f;
+    return stepFunction(userdata, &ioFrames, &interpolated);
+}
+
+void PDSynthSignal::noteOn(MIDINote note, float velocity, float length)
+{
+    if (source != nullptr)
+        { source->noteOn(note, velocity, length); }
+    else if (noteOnFunction != nullptr)
+        { noteOnFunction(userdata, note, velocity, length); }
+}
+
+void PDSynthSignal::noteOff(int stopped, int offset)
+{
+    if (source != nullptr)
+        { source->noteOff(stopped, offset); }
+    else if (noteOffFunction != nullptr)
+        { noteOffFunction(userdata, stopped, offset); }
+}
+
+void PDSynthSignal::forget(pdcpp::host::SoundObject* dying)
+{
+    if (source == dying)
+        { source = nullptr; }
+}
+
+//==============================================================================
+PDSynth::PDSynth()
+{
+    envelope.drivenBySynth = true;
+}
+
+PDSynth::~PDSynth()
+{
+    if (generatorDealloc != nullptr)
+        { generatorDealloc(generatorUserdata); }
+}
+
+void PDSynth::forget(pdcpp::host::SoundObject* dying)
+{
+    if (sample == dying)
+    {
+        sample = nullptr;
+        playing = false;
+    }
+    if (frequencyModulator == dying) { frequencyModulator = nullptr; }
+    if (amplitudeModulator == dying) { amplitudeModulator = nullptr; }
+    if (instrument == dying) { instrument = nullptr; }
+    for (auto& [parameter, mod] : parameterModulators)
+    {
+        if (mod == dying)
+            { mod = nullptr; }
+    }
+}
+
+void PDSynth::startNote()
+{
+    pendingStart = false;
+    playing = true;
+    released = false;
+    frequency = pendingFrequency;
+    velocity = pendingVelocity;
+    remaining = pendingLength > 0.0f ? static_cast<int64_t>(pendingLength * k_SampleRate) : -1;
+    samplePosition = 0.0;
+
+    envelope.noteOn(note, velocity, pendingLength);
+    for (auto mod : {frequencyModulator, amplitudeModulator})
+    {
+        if (mod != nullptr)
+            { mod->noteOn(note, velocity, pendingLength); }
+    }
+    if (generatorNoteOn != nullptr)
+        { generatorNoteOn(generatorUserdata, note, velocity, pendingLength); }
+}
+
+void PDSynth::releaseNote()
+{
+    if (!playing || released)
+        { return; }
+
+    released = true;
+    envelope.noteOff(0, 0);
+    for (auto mod : {frequencyModulator, amplitudeModulator})
+    {
+        if (mod != nullptr)
+            { mod->noteOff(0, 0); }
+    }
+    if (generatorRelease != nullptr)
+        { generatorRelease(generatorUserdata, 0); }
+
+    if (!hasEnvelope && generatorRender == nullptr)
+    {
+        playing = false;
+        finished();
+    }
+}
+
+float PDSynth::oscillate(float f)
+{
+    if (sample != nullptr)
+    {
+        float l, r;
+        sample->readFrame(static_cast<int>(samplePosition), l, r);
+        samplePosition += f / k_SampleBaseFrequency * static_cast<double>(sample->sampleRate) / k_SampleRate;
+
+        if (!released && sustainEnd > sustainStart && samplePosition >= sustainEnd)
+            { samplePosition -= sustainEnd - sustainStart; }
+        else if (samplePosition >= sample->frameCount())
+        {
+            playing = false;
+            finished();
+        }
+        return (l + r) * 0.5f;
+    }
+
+    auto p = static_cast<float>(phase);
+    phase += f / k_SampleRate;
+    phase -= std::floor(phase);
+
+    if (!wavetable.empty())
+        { return wavetable[std::min(static_cast<size_t>(p * wavetable.size()), wavetable.size() - 1)]; }
+
+    // The physical-model waveforms are approximated by their closest basic
+    // shape.
+    switch (waveform)
+    {
+        case kWaveformSquare:
+        case kWaveformPODigital: return p < 0.5f ? 1.0f : -1.0f;
+        case kWaveformTriangle:
+        case kWaveformPOVosim: return p < 0.5f ? 4.0f * p - 1.0f : 3.0f - 4.0f * p;
+        case kWaveformSine:
+        case kWaveformPOPhase: return std::sin(k_TwoPi * p);
+        case kWaveformNoise: return random(noise);
+        case kWaveformSawtooth: return 2.0f * p - 1.0f;
+        default: return 0.0f;
+    }
+}
+
+void PDSynth::renderFrames(int32_t* left, int32_t* right, int nFrames)
+{
+    if (!playing || nFrames <= 0)
+        { return; }
+
+    auto octaves = (transpose + bend) / 12.0f
+        + (frequencyModulator != nullptr ? frequencyModulator->getValue() : 0.0f);
+    auto f = frequency * std::exp2(octaves);
+    auto amplitude = amplitudeModulator != nullptr ? amplitudeModulator->getValue() : 1.0f;
+    if (!hasEnvelope)
+        { amplitude *= velocity; }
+
+    int32_t generatedL[k_BlockSize] = {};
+    int32_t generatedR[k_BlockSize] = {};
+    if (generatorRender != nullptr)
+    {
+        auto rate = static_cast<uint32_t>(f / k_SampleRate * 4294967296.0);
+        auto rendered = generatorRender(generatorUserdata, generatedL, generatorStereo ? generatedR : nullptr,
+                                        nFrames, rate, 0);
+        if (!generatorStereo)
+            { std::copy_n(generatedL, nFrames, generatedR); }
+        if (rendered == 0 && released)
+        {
+            playing = false;
+            finished();
+            return;
+        }
+    }
+
+    for (int i = 0; i < nFrames && playing; ++i)
+    {
+        auto gain = amplitude * (hasEnvelope ? envelope.tick() : 1.0f);
+        float l, r;
+        if (generatorRender != nullptr)
+        {
+            l = static_cast<float>(generatedL[i]) / k_Unity;
+            r = static_cast<float>(generatedR[i]) / k_Unity;
+        }
+        else
+        {
+            l = r = oscillate(f);
+        }
+
+        left[i] += static_cast<int32_t>(l * gain * leftVolume * k_Unity);
+        right[i] += static_cast<int32_t>(r * gain * rightVolume * k_Unity);
+
+        if (hasEnvelope && released && envelope.stage == PDSynthEnvelope::Stage::Idle)
+        {
+            playing = false;
+            finished();
+        }
+    }
+}
+
+void PDSynth::render(int32_t* left, int32_t* right, int nFrames)
+{
+    auto start = pdcpp::host::soundTime();
+    for (int pos = 0; pos < nFrames;)
+    {
+        auto now = start + static_cast<uint32_t>(pos);
+        auto next = nFrames;
+
+        if (pendingStart)
+        {
+            auto until = signedDelta(startTime, now);
+            if (until <= 0)
+            {
+                startNote();
+                continue;
+            }
+            next = std::min(next, pos + until);
+        }
+
+        if (pendingStop && !pendingStart)
+        {
+            auto until = signedDelta(stopTime, now);
+            if (until <= 0)
+            {
+                pendingStop = false;
+                releaseNote();
+                continue;
+            }
+            next = std::min(next, pos + until);
+        }
+
+        if (playing && !released && remaining >= 0)
+        {
+            if (remaining == 0)
+            {
+                releaseNote();
+                continue;
+            }
+            next = static_cast<int>(std::min<int64_t>(next, pos + remaining));
+        }
+
+        renderFrames(left + pos, right + pos, next - pos);
+        if (remaining > 0)
+            { remaining = std::max<int64_t>(0, remaining - (next - pos)); }
+        pos = next;
+    }
+}
+
+//==============================================================================
+void PDSynthInstrument::render(int32_t* left, int32_t* right, int nFrames)
+{
+    int32_t bufferL[k_BlockSize] = {};
+    int32_t bufferR[k_BlockSize] = {};
+    for (auto& voice : voices)
+    {
+        voice.synth->bend = pitchBend * pitchBendRange + transpose + voice.transpose;
+        voice.synth->render(bufferL, bufferR, nFrames);
+    }
+
+    for (int i = 0; i < nFrames; ++i)
+    {
+        left[i] += static_cast<int32_t>(static_cast<float>(bufferL[i]) * leftVolume);
+        right[i] += static_cast<int32_t>(static_cast<float>(bufferR[i]) * rightVolume);
+    }
+}
+
+bool PDSynthInstrument::isPlaying() const
+{
+    return std::any_of(voices.begin(), voices.end(), [](const auto& v) { return v.synth->isPlaying(); });
+}
+
+void PDSynthInstrument::forget(pdcpp::host::SoundObject* dying)
+{
+    voices.erase(std::remove_if(voices.begin(), voices.end(), [dying](const auto& v) { return v.synth == dying; }),
+                 voices.end());
+}
+
+PDSynth* PDSynthInstrument::playNote(MIDINote note, float velocity, float length, uint32_t when)
+{
+    Voice* chosen = nullptr;
+    for (auto& voice : voices)
+    {
+        if (note < voice.rangeStart || (voice.rangeEnd > voice.rangeStart && note > voice.rangeEnd))
+            { continue; }
+
+        // Prefer a free voice, otherwise steal the one playing longest.
+        if (!voice.synth->isPlaying())
+        {
+            chosen = &voice;
+            break;
+        }
+        if (chosen == nullptr || voice.synth->voiceAge < chosen->synth->voiceAge)
+            { chosen = &voice; }
+    }
+
+    if (chosen == nullptr)
+        { return nullptr; }
+
+    auto synth = chosen->synth;
+    synth->voiceAge = nextVoiceAge++;
+    playMIDINote(synth, note, velocity, length, when);
+    return synth;
+}
+
+void pdcpp::host::populateSynthAPI(SoundTables& tables)
+{
+    auto& signal = tables.signal;
+    signal.newSignal = newSignal;
+    signal.freeSignal = freeSignal;
+    signal.getValue = signalGetValue;
+    signal.setValueScale = setValueScale;
+    signal.setValueOffset = setValueOffset;
+    signal.newSignalForValue = newSignalForValue;
+
+    auto& lfo = tables.lfo;
+    lfo.newLFO = newLFO;
+    lfo.freeLFO = freeLFO;
+    lfo.setType = lfoSetType;
+    lfo.setRate = lfoSetRate;
+    lfo.setPhase = lfoSetPhase;
+    lfo.setCenter = lfoSetCenter;
+    lfo.setDepth = lfoSetDepth;
+    lfo.setArpeggiation = setArpeggiation;
+    lfo.setFunction = lfoSetFunction;
+    lfo.setDelay = lfoSetDelay;
+    lfo.setRetrigger = lfoSetRetrigger;
+    lfo.getValue = lfoGetValue;
+    lfo.setGlobal = lfoSetGlobal;
+    lfo.setStartPhase = lfoSetStartPhase;
+
+    auto& envelope = tables.envelope;
+    envelope.newEnvelope = newEnvelope;
+    envelope.freeEnvelope = freeEnvelope;
+    envelope.setAttack = setAttack;
+    envelope.setDecay = setDecay;
+    envelope.setSustain = setSustain;
+    envelope.setRelease = setRelease;
+    envelope.setLegato = setLegato;
+    envelope.setRetrigger = envelopeSetRetrigger;
+    envelope.getValue = envelopeGetValue;
+    envelope.setCurvature = setCurvature;
+    envelope.setVelocitySensitivity = setVelocitySensitivity;
+    envelope.setRateScaling = setRateScaling;
+
+    auto& synth = tables.synth;
+    synth.newSynth = newSynth;
+    synth.freeSynth = freeSynth;
+    synth.setWaveform = setWaveform;
+    synth.setGenerator_deprecated = setGeneratorDeprecated;
+    synth.setSample = synthSetSample;
+    synth.setAttackTime = setAttackTime;
+    synth.setDecayTime = setDecayTime;
+    synth.setSustainLevel = setSustainLevel;
+    synth.setReleaseTime = setReleaseTime;
+    synth.setTranspose = synthSetTranspose;
+    synth.setFrequencyModulator = setFrequencyModulator;
+    synth.getFrequencyModulator = getFrequencyModulator;
+    synth.setAmplitudeModulator = setAmplitudeModulator;
+    synth.getAmplitudeModulator = getAmplitudeModulator;
+    synth.getParameterCount = getParameterCount;
+    synth.setParameter = setParameter;
+    synth.setParameterModulator = setParameterModulator;
+    synth.getParameterModulator = getParameterModulator;
+    synth.playNote = playNote;
+    synth.playMIDINote = playMIDINote;
+    synth.noteOff = synthNoteOff;
+    synth.stop = synthStop;
+    synth.setVolume = synthSetVolume;
+    synth.getVolume = synthGetVolume;
+    synth.isPlaying = synthIsPlaying;
+    synth.getEnvelope = getEnvelope;
+    synth.setWavetable = setWavetable;
+    synth.setGenerator = setGenerator;
+    synth.copy = copySynth;
+    synth.clearEnvelope = clearEnvelope;
+
+    auto& instrument = tables.instrument;
+    instrument.newInstrument = newInstrument;
+    instrument.freeInstrument = freeInstrument;
+    instrument.addVoice = addVoice;
+    instrument.playNote = instrumentPlayNote;
+    instrument.playMIDINote = instrumentPlayMIDINote;
+    instrument.setPitchBend = setPitchBend;
+    instrument.setPitchBendRange = setPitchBendRange;
+    instrument.setTranspose = instrumentSetTranspose;
+    instrument.noteOff = instrumentNoteOff;
+    instrument.allNotesOff = instrumentAllNotesOff;
+    instrument.setVolume = instrumentSetVolume;
+    instrument.getVolume = instrumentGetVolume;
+    instrument.activeVoiceCount = activeVoiceCount;
+}
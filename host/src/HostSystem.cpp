@@ -0,0 +1,398 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#include "HostContext.h"
+
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+
+namespace
+{
+    using pdcpp::host::context;
+
+    // The Playdate epoch starts on 1/1/2000, 946684800 seconds after Unix's.
+    constexpr int64_t k_PlaydateEpochOffset = 946684800;
+
+    // Howard Hinnant's days-from-civil, used to convert dates without relying
+    // on the host's time zone.
+    int64_t daysFromCivil(int64_t y, unsigned m, unsigned d)
+    {
+        y -= m <= 2;
+        const int64_t era = (y >= 0 ? y : y - 399) / 400;
+        const auto yoe = static_cast<unsigned>(y - era * 400);
+        const unsigned doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+        const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+        return era * 146097 + static_cast<int64_t>(doe) - 719468;
+    }
+
+    void civilFromDays(int64_t z, int& year, unsigned& month, unsigned& day)
+    {
+        z += 719468;
+        const int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+        const auto doe = static_cast<unsigned>(z - era * 146097);
+        const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+        const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+        const unsigned mp = (5 * doy + 2) / 153;
+        day = doy - (153 * mp + 2) / 5 + 1;
+        month = mp < 10 ? mp + 3 : mp - 9;
+        year = static_cast<int>(static_cast<int64_t>(yoe) + era * 400 + (month <= 2));
+    }
+
+    void* hostRealloc(void* ptr, size_t size)
+    {
+        if (size == 0)
+        {
+            std::free(ptr);
+            return nullptr;
+        }
+        return std::realloc(ptr, size);
+    }
+
+    int vaFormatString(char** outstr, const char* fmt, va_list args)
+    {
+        va_list copy;
+        va_copy(copy, args);
+        auto length = std::vsnprintf(nullptr, 0, fmt, copy);
+        va_end(copy);
+
+        if (length < 0)
+        {
+            *outstr = nullptr;
+            return length;
+        }
+
+        *outstr = static_cast<char*>(std::malloc(length + 1));
+        std::vsnprintf(*outstr, length + 1, fmt, args);
+        return length;
+    }
+
+    int formatString(char** ret, const char* fmt, ...)
+    {
+        va_list args;
+        va_start(args, fmt);
+        auto length = vaFormatString(ret, fmt, args);
+        va_end(args);
+        return length;
+    }
+
+    void logToConsole(const char* fmt, ...)
+    {
+        if (!context().system.echoLogs)
+            { return; }
+
+        va_list args;
+        va_start(args, fmt);
+        std::vprintf(fmt, args);
+        va_end(args);
+        std::printf("\n");
+        std::fflush(stdout);
+    }
+
+    void error(const char* fmt, ...)
+    {
+        char* message = nullptr;
+        va_list args;
+        va_start(args, fmt);
+        vaFormatString(&message, fmt, args);
+        va_end(args);
+
+        auto& sys = context().system;
+        sys.errorCount++;
+        sys.lastError = message != nullptr ? message : fmt;
+        std::free(message);
+
+        std::fprintf(stderr, "error: %s\n", sys.lastError.c_str());
+        std::fflush(stderr);
+
+        if (sys.errorHandler)
+            { sys.errorHandler(sys.lastError); }
+    }
+
+    decltype(kPDLanguageEnglish) getLanguage() { return kPDLanguageEnglish; }
+
+    unsigned int getCurrentTimeMilliseconds()
+        { return static_cast<unsigned int>(context().system.nowMicros() / 1000); }
+
+    unsigned int getSecondsSinceEpoch(unsigned int* milliseconds)
+    {
+        auto now = std::chrono::system_clock::now().time_since_epoch();
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(now).count();
+        if (milliseconds != nullptr)
+            { *milliseconds = static_cast<unsigned int>(ms % 1000); }
+        return static_cast<unsigned int>(ms / 1000 - k_PlaydateEpochOffset);
+    }
+
+    void drawFPS(int x, int y)
+    {
+        auto& ctx = context();
+        char text[16];
+        auto len = std::snprintf(text, sizeof(text), "%d", static_cast<int>(ctx.system.framesPerSecond + 0.5f));
+        auto width = ctx.graphicsAPI.getTextWidth(nullptr, text, len, kASCIIEncoding, 0) + 4;
+        auto height = ctx.graphicsAPI.getFontHeight(nullptr) + 2;
+
+        ctx.graphicsAPI.pushContext(nullptr);
+        ctx.graphicsAPI.fillRect(x, y, width, height, kColorWhite);
+        ctx.graphicsAPI.setDrawMode(kDrawModeCopy);
+        ctx.graphicsAPI.setFont(nullptr);
+        ctx.graphicsAPI.drawText(text, len, kASCIIEncoding, x + 2, y + 1);
+        ctx.graphicsAPI.popContext();
+    }
+
+    void setUpdateCallback(PDCallbackFunction* update, void* userdata)
+    {
+        context().system.updateCallback = update;
+        context().system.updateUserdata = userdata;
+    }
+
+    void getButtonState(PDButtons* current, PDButtons* pushed, PDButtons* released)
+    {
+        auto& sys = context().system;
+        if (current != nullptr) { *current = static_cast<PDButtons>(sys.currentButtons); }
+        if (pushed != nullptr) { *pushed = static_cast<PDButtons>(sys.pushedButtons); }
+        if (released != nullptr) { *released = static_cast<PDButtons>(sys.releasedButtons); }
+    }
+
+    void setPeripheralsEnabled(PDPeripherals) {}
+
+    void getAccelerometer(float* outx, float* outy, float* outz)
+    {
+        auto& sys = context().system;
+        if (outx != nullptr) { *outx = sys.accelerometer[0]; }
+        if (outy != nullptr) { *outy = sys.accelerometer[1]; }
+        if (outz != nullptr) { *outz = sys.accelerometer[2]; }
+    }
+
+    float getCrankChange()
+    {
+        auto& sys = context().system;
+        auto change = sys.crankChange;
+        sys.crankChange = 0.0f;
+        return change;
+    }
+
+    float getCrankAngle() { return context().system.crankAngle; }
+    int isCrankDocked() { return context().system.crankDocked ? 1 : 0; }
+
+    int setCrankSoundsDisabled(int flag)
+    {
+        auto previous = context().system.crankSoundsDisabled;
+        context().system.crankSoundsDisabled = flag;
+        return previous;
+    }
+
+    int getFlipped() { return 0; }
+    void setAutoLockDisabled(int) {}
+
+    void setMenuImage(LCDBitmap* bitmap, int xOffset)
+    {
+        context().system.menuImage = bitmap;
+        context().system.menuImageOffset = xOffset;
+    }
+
+    PDMenuItem* addItem(std::unique_ptr<PDMenuItem> item)
+    {
+        auto& items = context().system.menuItems;
+        if (items.size() >= 3)
+        {
+            pdcpp::host::reportError("Cannot add more than three menu items");
+            return nullptr;
+        }
+        items.push_back(std::move(item));
+        return items.back().get();
+    }
+
+    PDMenuItem* addMenuItem(const char* title, PDMenuItemCallbackFunction* callback, void* userdata)
+    {
+        auto item = std::make_unique<PDMenuItem>();
+        item->title = title;
+        item->callback = callback;
+        item->userdata = userdata;
+        return addItem(std::move(item));
+    }
+
+    PDMenuItem* addCheckmarkMenuItem(const char* title, int value, PDMenuItemCallbackFunction* callback, void* userdata)
+    {
+        auto item = std::make_unique<PDMenuItem>();
+        item->type = PDMenuItem::Type::Checkmark;
+        item->title = title;
+        item->value = value != 0 ? 1 : 0;
+        item->callback = callback;
+        item->userdata = userdata;
+        return addItem(std::move(item));
+    }
+
+    PDMenuItem* addOptionsMenuItem(const char* title, const char** optionTitles, int optionsCount,
+                                   PDMenuItemCallbackFunction* f, void* userdata)
+    {
+        auto item = std::make_unique<PDMenuItem>();
+        item->type = PDMenuItem::Type::Options;
+        item->title = title;
+        for (int i = 0; i < optionsCount; i++)
+            { item->options.emplace_back(optionTitles[i]); }
+        item->callback = f;
+        item->userdata = userdata;
+        return addItem(std::move(item));
+    }
+
+    void removeAllMenuItems() { context().system.menuItems.clear(); }
+
+    void removeMenuItem(PDMenuItem* menuItem)
+    {
+        auto& items = context().system.menuItems;
+        std::erase_if(items, [menuItem](auto& item) { return item.get() == menuItem; });
+    }
+
+    int getMenuItemValue(PDMenuItem* menuItem) { return menuItem->value; }
+
+    void setMenuItemValue(PDMenuItem* menuItem, int value)
+    {
+        if (menuItem->type == PDMenuItem::Type::Options && !menuItem->options.empty())
+            { value = std::clamp(value, 0, static_cast<int>(menuItem->options.size()) - 1); }
+        menuItem->value = value;
+    }
+
+    const char* getMenuItemTitle(PDMenuItem* menuItem) { return menuItem->title.c_str(); }
+    void setMenuItemTitle(PDMenuItem* menuItem, const char* title) { menuItem->title = title; }
+    void* getMenuItemUserdata(PDMenuItem* menuItem) { return menuItem->userdata; }
+    void setMenuItemUserdata(PDMenuItem* menuItem, void* ud) { menuItem->userdata = ud; }
+
+    int getReduceFlashing() { return 0; }
+
+    float getElapsedTime()
+    {
+        auto& sys = context().system;
+        return static_cast<float>(sys.nowMicros() - sys.elapsedStartMicros) / 1000000.0f;
+    }
+
+    void resetElapsedTime() { context().system.elapsedStartMicros = context().system.nowMicros(); }
+
+    float getBatteryPercentage() { return 100.0f; }
+    float getBatteryVoltage() { return 4.2f; }
+    int32_t getTimezoneOffset() { return 0; }
+    int shouldDisplay24HourTime() { return 0; }
+
+    void convertEpochToDateTime(uint32_t epoch, PDDateTime* datetime)
+    {
+        auto seconds = static_cast<int64_t>(epoch) + k_PlaydateEpochOffset;
+        auto days = seconds / 86400;
+        auto secondOfDay = seconds % 86400;
+
+        int year;
+        unsigned month, day;
+        civilFromDays(days, year, month, day);
+
+        datetime->year = static_cast<uint16_t>(year);
+        datetime->month = static_cast<uint8_t>(month);
+        datetime->day = static_cast<uint8_t>(day);
+        // 1/1/1970 was a Thursday, weekdays count from Monday = 1.
+        datetime->weekday = static_cast<uint8_t>((days + 3) % 7 + 1);
+        datetime->hour = static_cast<uint8_t>(secondOfDay / 3600);
+        datetime->minute = static_cast<uint8_t>(secondOfDay / 60 % 60);
+        datetime->second = static_cast<uint8_t>(secondOfDay % 60);
+    }
+
+    uint32_t convertDateTimeToEpoch(PDDateTime* datetime)
+    {
+        auto days = daysFromCivil(datetime->year, datetime->month, datetime->day);
+        auto seconds = days * 86400 + datetime->hour * 3600 + datetime->minute * 60 + datetime->second;
+        return static_cast<uint32_t>(seconds - k_PlaydateEpochOffset);
+    }
+
+    void clearICache() {}
+
+    void setButtonCallback(PDButtonCallbackFunction* cb, void* buttonud, int)
+    {
+        context().system.buttonCallback = cb;
+        context().system.buttonUserdata = buttonud;
+    }
+
+    void setSerialMessageCallback(void (*callback)(const char* data)) { context().system.serialCallback = callback; }
+
+    int parseString(const char* str, const char* format, ...)
+    {
+        va_list args;
+        va_start(args, format);
+        auto result = std::vsscanf(str, format, args);
+        va_end(args);
+        return result;
+    }
+}
+
+uint64_t pdcpp::host::SystemState::nowMicros() const
+{
+    if (manualClock)
+        { return manualMicros; }
+
+    auto elapsed = std::chrono::steady_clock::now() - clockStart;
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+}
+
+void pdcpp::host::populateSystemAPI(playdate_sys& api)
+{
+    api.realloc = hostRealloc;
+    api.formatString = formatString;
+    api.logToConsole = logToConsole;
+    api.error = error;
+    api.getLanguage = getLanguage;
+    api.getCurrentTimeMilliseconds = getCurrentTimeMilliseconds;
+    api.getSecondsSinceEpoch = getSecondsSinceEpoch;
+    api.drawFPS = drawFPS;
+    api.setUpdateCallback = setUpdateCallback;
+    api.getButtonState = getButtonState;
+    api.setPeripheralsEnabled = setPeripheralsEnabled;
+    api.getAccelerometer = getAccelerometer;
+    api.getCrankChange = getCrankChange;
+    api.getCrankAngle = getCrankAngle;
+    api.isCrankDocked = isCrankDocked;
+    api.setCrankSoundsDisabled = setCrankSoundsDisabled;
+    api.getFlipped = getFlipped;
+    api.setAutoLockDisabled = setAutoLockDisabled;
+    api.setMenuImage = setMenuImage;
+    api.addMenuItem = addMenuItem;
+    api.addCheckmarkMenuItem = addCheckmarkMenuItem;
+    api.addOptionsMenuItem = addOptionsMenuItem;
+    api.removeAllMenuItems = removeAllMenuItems;
+    api.removeMenuItem = removeMenuItem;
+    api.getMenuItemValue = getMenuItemValue;
+    api.setMenuItemValue = setMenuItemValue;
+    api.getMenuItemTitle = getMenuItemTitle;
+    api.setMenuItemTitle = setMenuItemTitle;
+    api.getMenuItemUserdata = getMenuItemUserdata;
+    api.setMenuItemUserdata = setMenuItemUserdata;
+    api.getReduceFlashing = getReduceFlashing;
+    api.getElapsedTime = getElapsedTime;
+    api.resetElapsedTime = resetElapsedTime;
+    api.getBatteryPercentage = getBatteryPercentage;
+    api.getBatteryVoltage = getBatteryVoltage;
+    api.getTimezoneOffset = getTimezoneOffset;
+    api.shouldDisplay24HourTime = shouldDisplay24HourTime;
+    api.convertEpochToDateTime = convertEpochToDateTime;
+    api.convertDateTimeToEpoch = convertDateTimeToEpoch;
+    api.clearICache = clearICache;
+    api.setButtonCallback = setButtonCallback;
+    api.setSerialMessageCallback = setSerialMessageCallback;
+    api.vaFormatString = vaFormatString;
+    api.parseString = parseString;
+}
+
+void pdcpp::host::reportError(const char* fmt, ...)
+{
+    char* message = nullptr;
+    va_list args;
+    va_start(args, fmt);
+    vaFormatString(&message, fmt, args);
+    va_end(args);
+
+    context().systemAPI.error("%s", message != nullptr ? message : fmt);
+    std::free(message);
+}
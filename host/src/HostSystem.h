@@ -0,0 +1,99 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#pragma once
+
+#include <pd_api.h>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * The host's definition of the SDK's opaque menu item.
+ */
+struct PDMenuItem
+{
+    enum class Type
+    {
+        Basic,
+        Checkmark,
+        Options
+    };
+
+    Type type = Type::Basic;
+    std::string title;
+    std::vector<std::string> options;
+    int value = 0;
+    PDMenuItemCallbackFunction* callback = nullptr;
+    void* userdata = nullptr;
+};
+
+namespace pdcpp::host
+{
+    /**
+     * Everything behind `playdate->system`: the clocks, the update loop,
+     * input state, the system menu, and error reporting.
+     */
+    struct SystemState
+    {
+        /**
+         * @returns the microseconds since the backend was created, according
+         *     to whichever clock is in use.
+         */
+        [[ nodiscard ]] uint64_t nowMicros() const;
+
+        bool manualClock = false;
+        std::chrono::steady_clock::time_point clockStart = std::chrono::steady_clock::now();
+        uint64_t manualMicros = 0;
+        uint64_t elapsedStartMicros = 0;
+
+        PDCallbackFunction* updateCallback = nullptr;
+        void* updateUserdata = nullptr;
+        uint64_t frameCount = 0;
+        uint64_t lastFrameMicros = 0;
+        float framesPerSecond = 0.0f;
+
+        int currentButtons = 0;
+        int pushedButtons = 0;
+        int releasedButtons = 0;
+        PDButtonCallbackFunction* buttonCallback = nullptr;
+        void* buttonUserdata = nullptr;
+
+        float crankAngle = 0.0f;
+        float crankChange = 0.0f;
+        bool crankDocked = false;
+        int crankSoundsDisabled = 0;
+        float accelerometer[3] = {0.0f, 0.0f, 1.0f};
+
+        std::vector<std::unique_ptr<PDMenuItem>> menuItems;
+        LCDBitmap* menuImage = nullptr;
+        int menuImageOffset = 0;
+
+        void (*serialCallback)(const char* data) = nullptr;
+
+        bool echoLogs = true;
+        int errorCount = 0;
+        std::string lastError;
+        std::function<void(const std::string&)> errorHandler;
+    };
+
+    /**
+     * Fills in the `playdate->system` function table.
+     */
+    void populateSystemAPI(playdate_sys& api);
+
+    /**
+     * Reports a problem found inside the backend through `system->error`, so
+     * it's counted and handled exactly like an error raised by game code.
+     */
+    void reportError(const char* fmt, ...);
+}
@@ -9,10 +9,10 @@
  */
 
 #pragma once
-#include <functional>
 #include <string>
 #include <pd_api.h>
 #include "SequenceTrack.h"
+#include "../core/InplaceFunction.h"
 #include "../core/util.h"
 
 
@@ -21,6 +21,8 @@ namespace pdcpp
     class SoundSequence
     {
     public:
+        using CompleteCallback = pdcpp::InplaceFunction<void(pdcpp::SoundSequence*)>;
+
         /**
          * Creates a new Sequence. Sequences comprise one or more tracks, and
          * provides an API to manage them as a unit. Load a MIDI file, or build
@@ -61,7 +63,7 @@ namespace pdcpp
          *     without a callback will disable any callback that was previously
          *     set.
          */
-        void play(std::function<void(pdcpp::SoundSequence*)> completeCallback=[](auto*){});
+        void play(CompleteCallback completeCallback=[](auto*){});
 
         /**
          * Stops/Pauses the sequence. Note that calling this function will hit
@@ -168,7 +170,7 @@ namespace pdcpp
         void allNotesOff();
     private:
         static void playCompleteShim(::SoundSequence*, void* usrData);
-        std::function<void(pdcpp::SoundSequence*)> m_Callback;
+        CompleteCallback m_Callback;
         ::SoundSequence* p_Sequence;
 
         PDCPP_DECLARE_NON_COPYABLE(SoundSequence);
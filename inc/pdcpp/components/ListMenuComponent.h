@@ -14,7 +14,7 @@ namespace pdcpp
     {
     public:
         explicit ListMenuComponent
-            (std::vector<MenuItem> menu, std::function<void()> nonAction = [](){}, bool horizontal=false);
+            (std::vector<MenuItem> menu, Action nonAction = [](){}, bool horizontal=false);
 
     private:
         bool m_Horiz;
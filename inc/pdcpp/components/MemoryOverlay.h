@@ -0,0 +1,45 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#pragma once
+
+#include <pdcpp/components/Component.h>
+
+namespace pdcpp
+{
+    class MemoryOverlay
+        : public Component
+    {
+    public:
+        /**
+         * Shows what the `pdcpp::MemoryTracker` knows, one row per tag with
+         * the total on top. Each row is labelled with the kilobytes in use,
+         * and has a bar of the memory in use against the tag's budget with a
+         * tick at the high water mark. Tags without a budget are drawn
+         * against their high water mark instead. The total row shows the
+         * allocations made so far this frame.
+         *
+         * Draw it last, on top of everything else, and give it a height of at
+         * least `getIdealHeight()`.
+         */
+        MemoryOverlay() = default;
+
+        /**
+         * @returns the height needed to show every tag.
+         */
+        [[ nodiscard ]] int getIdealHeight() const;
+
+    protected:
+        void draw() override;
+
+    private:
+        [[ nodiscard ]] int getRowHeight() const;
+    };
+}
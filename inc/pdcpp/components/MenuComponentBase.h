@@ -4,8 +4,8 @@
 
 #pragma once
 #include <variant>
-#include <functional>
 #include <pdcpp/components/Component.h>
+#include <pdcpp/core/InplaceFunction.h>
 #include <pdcpp/graphics/Font.h>
 
 
@@ -15,17 +15,18 @@ namespace pdcpp
     {
     public:
         using Icon = std::variant<std::string, pdcpp::Component*>;
+        using Action = pdcpp::InplaceFunction<void()>;
 
         struct MenuItem
         {
             pdcpp::MenuComponentBase::Icon icon;
-            std::function<void()> action;
+            Action action;
 
            [[ nodiscard ]] pdcpp::Rectangle<float> getBounds(pdcpp::Font& font) const;
         };
 
         explicit MenuComponentBase(
-            std::vector <MenuItem> menu, std::function<void()> nonAction = []()
+            std::vector <MenuItem> menu, Action nonAction = []()
         {});
 
         void setSelectedIndex(int i);
@@ -40,7 +41,7 @@ namespace pdcpp
 
     private:
         std::vector<MenuItem> m_Menu;
-        std::function<void()> m_AbortAction;
+        Action m_AbortAction;
         int m_Selected;
     };
 }
\ No newline at end of file
@@ -0,0 +1,54 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#pragma once
+
+#include <pdcpp/components/Component.h>
+
+namespace pdcpp
+{
+    class ProfilerOverlay
+        : public Component
+    {
+    public:
+        /**
+         * A compact bar chart of the `pdcpp::Profiler`'s zones, one row per
+         * zone with the frame itself on top. Bars show the average time per
+         * frame against the frame budget, with a tick at the maximum, and each
+         * row is labelled with the average in milliseconds.
+         *
+         * Draw it last, on top of everything else, and give it a height of at
+         * least `getIdealHeight()`.
+         *
+         * @param budgetMs the time represented by a full bar, 20ms for a game
+         *     running at 50 fps.
+         * @param nFrames the number of recent frames to summarize, or 0 for
+         *     every frame the profiler holds.
+         */
+        explicit ProfilerOverlay(float budgetMs=20.0f, int nFrames=0);
+
+        void setBudgetMs(float budgetMs) { m_BudgetMs = budgetMs; }
+        [[ nodiscard ]] float getBudgetMs() const { return m_BudgetMs; }
+
+        /**
+         * @returns the height needed to show every zone registered so far.
+         */
+        [[ nodiscard ]] int getIdealHeight() const;
+
+    protected:
+        void draw() override;
+
+    private:
+        [[ nodiscard ]] int getRowHeight() const;
+
+        float m_BudgetMs;
+        int m_NFrames;
+    };
+}
@@ -13,7 +13,7 @@ namespace pdcpp
     {
     public:
         explicit RingMenuComponent(
-            std::vector<MenuItem> menu, std::function<void()> nonAction=[](){}, float rotationDegrees = 0.0f);
+            std::vector<MenuItem> menu, Action nonAction=[](){}, float rotationDegrees = 0.0f);
 
         static void drawSplitCircle(
             const pdcpp::Rectangle<int>& bounds, int thickness, int nSplits, int select, float rotationDegrees);
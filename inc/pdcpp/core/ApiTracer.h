@@ -0,0 +1,142 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#pragma once
+
+#include <pd_api.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "util.h"
+
+namespace pdcpp
+{
+    /**
+     * A copy of a `PlaydateAPI` whose functions count, and optionally time,
+     * each call before handing it on to the real API. It's what
+     * `GlobalPlaydateAPI::initialize` installs when asked to trace, and what
+     * `GlobalPlaydateAPI::getTracer` returns.
+     *
+     * The system, file, graphics, sprite, display, and sound tables are
+     * traced, along with the sound channel, effect, source, sample, sample
+     * player, synth, and LFO tables. Everything else, including the variadic
+     * logging and formatting functions, goes straight through untraced.
+     *
+     * The counters are shared by every tracer, so only make one at a time.
+     */
+    class ApiTracer
+    {
+    public:
+        /**
+         * The calls made to one function of the API. Times are in
+         * microseconds, and include any callbacks the API makes back into the
+         * game from within the call.
+         */
+        struct FunctionStats
+        {
+            const char* name;
+            uint64_t calls;
+            uint64_t timeUs;
+            uint32_t lastFrameCalls;
+            uint32_t lastFrameTimeUs;
+        };
+
+        /**
+         * Builds the traced tables around the given API.
+         *
+         * @param backend the API to which every call is forwarded. It must
+         *     outlive the tracer.
+         */
+        explicit ApiTracer(PlaydateAPI* backend);
+        ~ApiTracer();
+
+        /**
+         * @returns the traced API, to be used in place of the backend.
+         */
+        [[ nodiscard ]] PlaydateAPI* get() { return &m_Api; }
+
+        /**
+         * @returns the API being traced. Calls made through it aren't counted.
+         */
+        [[ nodiscard ]] PlaydateAPI* getBackend() const { return p_Backend; }
+
+        /**
+         * Timing reads the clock twice per call, which costs considerably more
+         * than counting alone. It's enabled by default.
+         */
+        void setTimingEnabled(bool shouldTime);
+
+        /**
+         * Sets functions called on entering and leaving every traced call,
+         * which is useful for telling the game's own work from the API's. Pass
+         * `nullptr` for either to remove it.
+         */
+        void setCallHooks(void (*onEnter)(), void (*onExit)());
+
+        /**
+         * Closes the current frame: the calls made since the last `endFrame`
+         * become the "last frame" figures in the stats.
+         */
+        void endFrame();
+
+        /**
+         * Clears every counter, and the frame count.
+         */
+        void reset();
+
+        /**
+         * @returns the number of frames closed with `endFrame` since the last
+         *     reset.
+         */
+        [[ nodiscard ]] uint32_t getNumFrames() const { return m_NFrames; }
+
+        /**
+         * @returns the total number of traced calls since the last reset.
+         */
+        [[ nodiscard ]] uint64_t getTotalCalls() const;
+
+        /**
+         * @returns the stats for each function that has been called since the
+         *     last reset, most called first.
+         */
+        [[ nodiscard ]] std::vector<FunctionStats> getStats() const;
+
+        /**
+         * Writes the stats as CSV, one row per function, to a file in the
+         * game's data folder. The file is written through the backend, so
+         * writing it doesn't show up in the results.
+         *
+         * @param path the path of the file to write.
+         * @returns true if the whole report was written.
+         */
+        bool writeReport(const std::string& path) const;
+
+    private:
+        PlaydateAPI* p_Backend;
+        PlaydateAPI m_Api {};
+        playdate_sys m_System {};
+        playdate_file m_File {};
+        playdate_graphics m_Graphics {};
+        playdate_sprite m_Sprite {};
+        playdate_display m_Display {};
+        playdate_sound m_Sound {};
+        playdate_sound_channel m_Channel {};
+        playdate_sound_effect m_Effect {};
+        playdate_sound_source m_Source {};
+        playdate_sound_sample m_Sample {};
+        playdate_sound_sampleplayer m_SamplePlayer {};
+        playdate_sound_synth m_Synth {};
+        playdate_sound_lfo m_LFO {};
+
+        uint32_t m_NFrames = 0;
+
+        PDCPP_DECLARE_NON_COPYABLE_NON_MOVABLE(ApiTracer);
+    };
+}
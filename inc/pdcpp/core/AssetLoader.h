@@ -0,0 +1,244 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <queue>
+#include <string>
+#include <utility>
+#include <vector>
+#include "FrameBudget.h"
+#include "util.h"
+
+namespace pdcpp
+{
+    class Image;
+    class ImageTable;
+    class Font;
+    class AudioSample;
+
+    /**
+     * Loads assets a few at a time from the game's update, rather than all at
+     * once, so a level's worth of assets doesn't stall the game. Each request
+     * gets a handle straight away, which resolves to the loaded asset once
+     * the loader gets to it.
+     *
+     * Requests with a higher priority are loaded first, and requests of the
+     * same priority in the order they were made. Asking for a path which is
+     * already loading, or already loaded and still held by a handle, shares
+     * that load rather than starting another. Loads whose handles have all
+     * been dropped before the loader gets to them are skipped.
+     *
+     * A single asset can't be loaded in pieces, so the budget is checked
+     * between loads, and one large asset can still overrun it. At least one
+     * load happens per update, so loading always makes progress.
+     *
+     * usage:
+     *      auto& loader = pdcpp::AssetLoader::getDefault();
+     *      auto background = loader.loadImage("images/background", 10);
+     *      auto music = loader.loadSample("audio/theme.pda");
+     *      ...
+     *      loader.update();  // once per frame
+     *      drawLoadingBar(loader.getProgress().getFraction());
+     *      if (background.isReady())
+     *          { background.get()->draw({0, 0}); }
+     */
+    class AssetLoader
+    {
+    public:
+        enum class State
+        {
+            Queued,
+            Loaded,
+            Failed
+        };
+
+        /**
+         * How far through the loads requested since the loader was last
+         * idle it has got. Failed loads count as completed.
+         */
+        struct Progress
+        {
+            uint32_t completed = 0;
+            uint32_t failed = 0;
+            uint32_t total = 0;
+
+            [[ nodiscard ]] float getFraction() const { return total == 0 ? 1.0f : float(completed) / float(total); }
+        };
+
+    private:
+        struct SlotBase
+        {
+            virtual ~SlotBase() = default;
+            virtual void load() = 0;
+
+            std::string path;
+            State state = State::Queued;
+            long nQueued = 0;
+        };
+
+        template <typename T>
+        struct Slot
+            : public SlotBase
+        {
+            void load() override
+            {
+                value = loader(path);
+                state = value != nullptr ? State::Loaded : State::Failed;
+                loader = nullptr;
+            }
+
+            std::function<std::unique_ptr<T>(const std::string&)> loader;
+            std::shared_ptr<T> value;
+        };
+
+    public:
+        /**
+         * Refers to an asset requested from an `AssetLoader`. Handles are
+         * cheap to copy, and keep the asset alive for as long as any of them
+         * do.
+         */
+        template <typename T>
+        class Handle
+        {
+        public:
+            Handle() = default;
+
+            [[ nodiscard ]] State getState() const { return p_Slot == nullptr ? State::Failed : p_Slot->state; }
+            [[ nodiscard ]] bool isReady() const { return getState() == State::Loaded; }
+            [[ nodiscard ]] bool isFailed() const { return getState() == State::Failed; }
+            [[ nodiscard ]] bool isQueued() const { return getState() == State::Queued; }
+
+            /**
+             * @returns the asset, or nullptr if it hasn't loaded.
+             */
+            [[ nodiscard ]] T* get() const { return p_Slot == nullptr ? nullptr : p_Slot->value.get(); }
+
+            /**
+             * @returns shared ownership of the asset, which can outlive the
+             *     handle, or nullptr if it hasn't loaded.
+             */
+            [[ nodiscard ]] std::shared_ptr<T> share() const { return p_Slot == nullptr ? nullptr : p_Slot->value; }
+
+            [[ nodiscard ]] const std::string& getPath() const { return p_Slot->path; }
+
+        private:
+            friend class AssetLoader;
+            explicit Handle(std::shared_ptr<Slot<T>> slot) : p_Slot(std::move(slot)) {}
+
+            std::shared_ptr<Slot<T>> p_Slot;
+        };
+
+        /**
+         * A function which loads an asset from a path, returning nullptr if it
+         * can't.
+         */
+        template <typename T>
+        using LoadFunction = std::function<std::unique_ptr<T>(const std::string&)>;
+
+        /**
+         * @param frameBudgetMs the time loads may take each update.
+         */
+        explicit AssetLoader(float frameBudgetMs=k_DefaultFrameBudgetMs);
+
+        Handle<Image> loadImage(const std::string& path, int priority=0);
+        Handle<ImageTable> loadImageTable(const std::string& path, int priority=0);
+        Handle<Font> loadFont(const std::string& path, int priority=0);
+
+        /**
+         * Loads a sample, either a .pda through the system, or a .wav through
+         * `WavFile`.
+         */
+        Handle<AudioSample> loadSample(const std::string& path, int priority=0);
+
+        /**
+         * Requests an asset of any type, using the given function to load it.
+         * Requests for the same type and path share a load.
+         */
+        template <typename T>
+        Handle<T> load(const std::string& path, LoadFunction<T> loadFunction, int priority=0)
+        {
+            auto key = std::make_pair(typeId<T>(), path);
+            if (auto existing = m_Slots[key].lock())
+            {
+                // Already in hand. Bump the priority of a queued one if need
+                // be, the old queue entry will be skipped.
+                if (existing->state == State::Queued)
+                    { enqueue(existing, priority, false); }
+                return Handle<T>(std::static_pointer_cast<Slot<T>>(existing));
+            }
+
+            auto slot = std::make_shared<Slot<T>>();
+            slot->path = path;
+            slot->loader = std::move(loadFunction);
+            m_Slots[key] = slot;
+            enqueue(slot, priority, true);
+            return Handle<T>(std::move(slot));
+        }
+
+        /**
+         * Performs queued loads, highest priority first, until the queue is
+         * empty or the budget is spent. Call it once per update.
+         */
+        void update();
+
+        /**
+         * @returns true if nothing is waiting to load.
+         */
+        [[ nodiscard ]] bool isIdle() const { return m_Queue.empty(); }
+
+        [[ nodiscard ]] const Progress& getProgress() const { return m_Progress; }
+
+        void setFrameBudget(float budgetMs);
+        [[ nodiscard ]] float getFrameBudget() const { return m_Budget.getBudget(); }
+
+        /**
+         * @returns the loader shared by the library.
+         */
+        static AssetLoader& getDefault();
+
+        static constexpr float k_DefaultFrameBudgetMs = 8.0f;
+
+    private:
+        struct Request
+        {
+            int priority;
+            uint32_t sequence;
+            std::shared_ptr<SlotBase> slot;
+
+            bool operator< (const Request& other) const
+            {
+                // Highest priority first, then first come, first served.
+                if (priority != other.priority)
+                    { return priority < other.priority; }
+                return sequence > other.sequence;
+            }
+        };
+
+        void enqueue(std::shared_ptr<SlotBase> slot, int priority, bool isNewLoad);
+
+        static size_t nextTypeId() { static size_t next = 0; return next++; }
+
+        template <typename T>
+        static size_t typeId() { static const size_t id = nextTypeId(); return id; }
+
+        std::priority_queue<Request> m_Queue;
+        std::map<std::pair<size_t, std::string>, std::weak_ptr<SlotBase>> m_Slots;
+        Progress m_Progress;
+        uint32_t m_NextSequence = 0;
+        FrameBudget m_Budget;
+
+        PDCPP_DECLARE_NON_COPYABLE_NON_MOVABLE(AssetLoader);
+    };
+}
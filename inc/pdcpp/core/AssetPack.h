@@ -0,0 +1,202 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <pd_api.h>
+#include "File.h"
+#include "util.h"
+
+namespace pdcpp
+{
+    /**
+     * Many files packed into one, with an index, so a game with hundreds of
+     * small assets opens and stats one file at startup instead of hundreds.
+     * Packs are built on the host, with `pdcpp::host::AssetPacker`.
+     *
+     * Opening a pack reads its header and index, and nothing else. Entries are
+     * found by path with a binary search on their hashes, and read through an
+     * `AssetPack::File`, which works like a read-only `FileHandle` over just
+     * that entry, and can be handed to a `PlaydateFileStreamBuffer`.
+     *
+     * The pack keeps its file open, and every `AssetPack::File` reads through
+     * it, so it must outlive them. The pack only seeks when a read isn't
+     * carrying on from where the last one stopped.
+     *
+     * The format, all little-endian:
+     *  - a header: the magic "PDAP", the version, the number of entries, the
+     *    size of the path table, and the alignment of the data;
+     *  - the index: an `Entry` per file, sorted by hash, then path;
+     *  - the path table: every entry's path, back to back;
+     *  - the data, each entry starting on a multiple of the alignment.
+     *
+     * usage:
+     *      pdcpp::AssetPack pack("assets.pdap");
+     *      if (auto file = pack.open("levels/1.bin"))
+     *      {
+     *          auto nTiles = file->getSize() / sizeof(Tile);
+     *          ...
+     *      }
+     */
+    class AssetPack
+    {
+    public:
+        /**
+         * An entry in the index. Offsets are from the start of the pack.
+         */
+        struct Entry
+        {
+            uint32_t hash;
+            uint32_t pathOffset;
+            uint32_t pathLength;
+            uint32_t offset;
+            uint32_t size;
+        };
+
+        /**
+         * A read-only view of one entry, with the same interface as a
+         * `FileHandle`. Positions are relative to the start of the entry.
+         */
+        class File
+        {
+        public:
+            /**
+             * Reads bytes from the entry.
+             *
+             * @param buffer a pointer to the buffer to fill
+             * @param length the number of bytes to read
+             * @return how many bytes were read, which is less than `length`
+             *     at the end of the entry, or -1 on failure.
+             */
+            int read(void* buffer, unsigned int length);
+
+            /**
+             * Packs are read-only, so this always fails.
+             *
+             * @return -1
+             */
+            int write(void*, unsigned int) { return -1; }
+
+            /**
+             * Moves the read head within the entry.
+             *
+             * @return 0 on success, -1 if the position would be outside it.
+             */
+            int seek(int position, FileHandle::Whence whence);
+
+            [[ nodiscard ]] int tell() const { return m_Position; }
+            [[ nodiscard ]] bool isOpen() const { return p_Pack != nullptr; }
+            [[ nodiscard ]] uint32_t getSize() const { return m_Entry.size; }
+
+            /**
+             * @return a FileStat block for the entry, with its size.
+             */
+            [[ nodiscard ]] const FileStat& getDetails() const { return m_Stat; }
+
+        private:
+            friend class AssetPack;
+            File(AssetPack* pack, const Entry& entry);
+
+            AssetPack* p_Pack;
+            Entry m_Entry;
+            FileStat m_Stat{};
+            int m_Position = 0;
+        };
+
+        /**
+         * Opens a pack and reads its index.
+         *
+         * @param path the path of the pack, in the game's bundle or data folder
+         */
+        explicit AssetPack(const std::string& path);
+
+        /**
+         * @return true if the pack opened and its index was read.
+         */
+        [[ nodiscard ]] bool isLoaded() const { return m_Loaded; }
+
+        /**
+         * @return the entry stored under the path, or nullptr.
+         */
+        [[ nodiscard ]] const Entry* find(std::string_view path) const;
+
+        [[ nodiscard ]] bool contains(std::string_view path) const { return find(path) != nullptr; }
+
+        /**
+         * Opens an entry for reading.
+         *
+         * @return a `File` for the entry, or nothing if there's no such entry.
+         */
+        [[ nodiscard ]] std::optional<File> open(std::string_view path);
+
+        /**
+         * Reads a whole entry into memory.
+         *
+         * @return the entry's bytes, or nothing if there's no such entry or it
+         *     couldn't be read.
+         */
+        [[ nodiscard ]] std::optional<std::vector<uint8_t>> load(std::string_view path);
+
+        /**
+         * Opens an entry as a stream buffer, for `std::istream` based parsers.
+         *
+         * @return the stream buffer, or nullptr if there's no such entry.
+         */
+        template <size_t Size>
+        [[ nodiscard ]] std::unique_ptr<PlaydateFileStreamBuffer<Size, File>> makeStreamBuffer(std::string_view path)
+        {
+            auto file = open(path);
+            if (!file)
+                { return nullptr; }
+            return std::make_unique<PlaydateFileStreamBuffer<Size, File>>(std::move(*file));
+        }
+
+        [[ nodiscard ]] size_t getNumEntries() const { return m_Entries.size(); }
+        [[ nodiscard ]] const Entry& getEntry(size_t i) const { return m_Entries[i]; }
+        [[ nodiscard ]] std::string_view getPath(const Entry& entry) const;
+
+        /**
+         * The hash entries are indexed by: 32-bit FNV-1a of the path's bytes.
+         */
+        static constexpr uint32_t hashPath(std::string_view path)
+        {
+            uint32_t hash = 2166136261u;
+            for (auto c : path)
+            {
+                hash ^= uint8_t(c);
+                hash *= 16777619u;
+            }
+            return hash;
+        }
+
+        static constexpr uint32_t k_Magic = 0x50414450; // "PDAP", read little-endian
+        static constexpr uint32_t k_Version = 1;
+        static constexpr uint32_t k_HeaderSize = 5 * sizeof(uint32_t);
+        static constexpr uint32_t k_EntrySize = 5 * sizeof(uint32_t);
+
+    private:
+        // Reads from an absolute offset in the pack.
+        int readAt(uint32_t offset, void* buffer, unsigned int length);
+
+        pdcpp::FileHandle m_Handle;
+        std::vector<Entry> m_Entries;
+        std::vector<char> m_Paths;
+        uint32_t m_HeadPosition = 0;
+        bool m_Loaded = false;
+
+        PDCPP_DECLARE_NON_COPYABLE_NON_MOVABLE(AssetPack);
+    };
+}
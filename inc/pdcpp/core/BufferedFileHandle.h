@@ -0,0 +1,205 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <pd_api.h>
+#include "File.h"
+#include "util.h"
+
+namespace pdcpp
+{
+    /**
+     * A `FileHandle` which reads ahead and gathers writes in a buffer, so that
+     * parsing a file a few bytes at a time, or writing one out a field at a
+     * time, makes one call into the file system per buffer-full rather than
+     * one per field. Reads and writes larger than the buffer go straight
+     * through.
+     *
+     * The position is tracked here, so `tell` is free, and seeking within
+     * what's already been read ahead doesn't touch the file at all.
+     *
+     * Writes are only guaranteed to be in the file after `flush`, which is
+     * called on destruction, or before anything which needs the file to be up
+     * to date, like reading or seeking outside the buffer.
+     *
+     * Failed reads and writes are sticky: `hasFailed` reports whether any
+     * have failed since the file was opened.
+     *
+     * usage:
+     *      pdcpp::BufferedFileHandle file("level1.bin", kFileRead);
+     *      auto version = file.readLE<uint16_t>();
+     *      auto nTiles = file.readLE<uint32_t>();
+     *      ...
+     *      if (file.hasFailed())
+     *          { return std::nullopt; }
+     */
+    class BufferedFileHandle
+    {
+    public:
+        static constexpr size_t k_DefaultBufferSize = 4096;
+
+        /**
+         * Opens a file, with a buffer of the given size.
+         *
+         * @param path the path of the file to open
+         * @param mode the PlaydateSDK FileOptions for the opening mode to use
+         * @param bufferSize the size of the buffer, in bytes
+         */
+        BufferedFileHandle(const std::string& path, FileOptions mode, size_t bufferSize=k_DefaultBufferSize);
+
+        // Destructor. Flushes any pending writes and closes the file.
+        ~BufferedFileHandle();
+
+        /**
+         * Reads bytes from the file, from the buffer where possible.
+         *
+         * @param buffer a pointer to the buffer to fill
+         * @param length the number of bytes to read
+         * @return how many bytes were read, which is less than `length` at
+         *     the end of the file, or -1 on failure.
+         */
+        int read(void* buffer, unsigned int length);
+
+        /**
+         * Writes bytes to the file, by way of the buffer if they fit.
+         *
+         * @param buffer a pointer to the bytes to write
+         * @param length the number of bytes to write
+         * @return how many bytes were accepted, or -1 on failure.
+         */
+        int write(const void* buffer, unsigned int length);
+
+        /**
+         * Writes any buffered bytes out to the file.
+         *
+         * @return false if the file system didn't take all of them.
+         */
+        bool flush();
+
+        /**
+         * Moves the read/write head. Moving within what's been read ahead
+         * is done in the buffer.
+         *
+         * @param position N bytes relative to the `whence` setting to move the
+         *     read/write head.
+         * @param whence the reference position (end, current, or absolute)
+         * @return 0 on success, -1 on failure.
+         */
+        int seek(int position, FileHandle::Whence whence);
+
+        /**
+         * @return the current position of the read/write head, without asking
+         *     the file system.
+         */
+        [[ nodiscard ]] int tell() const { return m_Position; }
+
+        /**
+         * Reads a little-endian number. On a short read the result is 0, and
+         * `hasFailed` is set.
+         */
+        template <typename T>
+        T readLE()
+        {
+            static_assert(std::is_arithmetic_v<T>, "readLE reads numbers");
+
+            uint8_t bytes[sizeof(T)];
+            if (m_ReadEnd - m_ReadPos >= sizeof(T))
+            {
+                std::memcpy(bytes, m_Buffer.data() + m_ReadPos, sizeof(T));
+                m_ReadPos += sizeof(T);
+                m_Position += int(sizeof(T));
+            }
+            else if (read(bytes, sizeof(T)) != int(sizeof(T)))
+            {
+                m_Failed = true;
+                return T(0);
+            }
+
+            return fromLittleEndian<T>(bytes);
+        }
+
+        /**
+         * Writes a number, little-endian.
+         *
+         * @return false if it couldn't be written.
+         */
+        template <typename T>
+        bool writeLE(T value)
+        {
+            static_assert(std::is_arithmetic_v<T>, "writeLE writes numbers");
+
+            uint8_t bytes[sizeof(T)];
+            toLittleEndian(value, bytes);
+            return write(bytes, sizeof(T)) == int(sizeof(T));
+        }
+
+        /**
+         * @return true if a read or write has failed or come up short since
+         *     the file was opened.
+         */
+        [[ nodiscard ]] bool hasFailed() const { return m_Failed; }
+
+        [[ nodiscard ]] bool isOpen() const { return m_Handle.isOpen(); }
+        [[ nodiscard ]] size_t getBufferSize() const { return m_Buffer.size(); }
+
+        /**
+         * @return the PlaydateSDK FileStat block describing the file as it
+         *     was when it was opened.
+         */
+        [[ nodiscard ]] const FileStat& getDetails() const { return m_Handle.getDetails(); }
+
+    private:
+        // Throws away read-ahead, putting the file's head back where this
+        // handle's is.
+        bool discardReadAhead();
+
+        template <typename T>
+        static T fromLittleEndian(const uint8_t* bytes)
+        {
+            uint8_t ordered[sizeof(T)];
+            for (size_t i = 0; i < sizeof(T); ++i)
+                { ordered[i] = std::endian::native == std::endian::little ? bytes[i] : bytes[sizeof(T) - 1 - i]; }
+
+            T value;
+            std::memcpy(&value, ordered, sizeof(T));
+            return value;
+        }
+
+        template <typename T>
+        static void toLittleEndian(T value, uint8_t* bytes)
+        {
+            uint8_t native[sizeof(T)];
+            std::memcpy(native, &value, sizeof(T));
+            for (size_t i = 0; i < sizeof(T); ++i)
+                { bytes[i] = std::endian::native == std::endian::little ? native[i] : native[sizeof(T) - 1 - i]; }
+        }
+
+        FileHandle m_Handle;
+        std::vector<uint8_t> m_Buffer;
+
+        // Read-ahead occupies [m_ReadPos, m_ReadEnd) of the buffer, and
+        // pending writes [0, m_WriteEnd). Only one is ever in use.
+        size_t m_ReadPos = 0;
+        size_t m_ReadEnd = 0;
+        size_t m_WriteEnd = 0;
+
+        int m_Position = 0;
+        bool m_Failed = false;
+
+        PDCPP_DECLARE_NON_COPYABLE_NON_MOVABLE(BufferedFileHandle);
+    };
+}
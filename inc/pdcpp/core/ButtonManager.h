@@ -9,9 +9,9 @@
  */
 #pragma once
 
-#include <functional>
 #include <vector>
 #include <pd_api.h>
+#include "InplaceFunction.h"
 #include "Timer.h"
 
 namespace pdcpp
@@ -74,6 +74,12 @@ namespace pdcpp
          */
         void removeListener(Listener* toRemove);
 
+    protected:
+        /**
+         * Tells every listener about a button state, if any of it is active.
+         */
+        void notify(PDButtons current, PDButtons pressed, PDButtons released);
+
     private:
         std::vector<Listener*> m_Listeners;
 
@@ -83,6 +89,8 @@ namespace pdcpp
         : public pdcpp::Timer
     {
     public:
+        using Action = pdcpp::InplaceFunction<void()>;
+
         /**
          * Creates a KeyRepeatTimer. These timers take a function in the
          * `keyPressed which will be hit once on key-press, once after the
@@ -106,7 +114,7 @@ namespace pdcpp
          *     used to changing the action without interrupting the repetition
          *     such as a user changing directions on a D-pad to a diagonal.
          */
-        void keyPressed(std::function<void()> action, bool resetTimer=true);
+        void keyPressed(Action action, bool resetTimer=true);
 
         /**
          * Stops and resets the timer to its 'ready' state.
@@ -116,7 +124,7 @@ namespace pdcpp
     private:
         void timerCallback() override;
 
-        std::function<void()> m_OnKeyRepeat;
+        Action m_OnKeyRepeat;
         int m_InitialDelay, m_RepeatDelay;
     };
 }
@@ -0,0 +1,356 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <vector>
+#include <pd_api.h>
+#include "File.h"
+#include "MemoryTracker.h"
+#include "util.h"
+
+/**
+ * A byte-oriented LZ codec, for level data, baked bitmaps, and saves which
+ * would otherwise be stored raw. Decoding is a few copies per sequence, so on
+ * loads bound by the SD card, reading half the bytes more than pays for it.
+ *
+ * Blocks use the LZ4 block format. Compressed files and buffers are framed:
+ *  - a header: the magic "PDLZ", the version, the block size, and the size
+ *    of the data once decompressed, all little-endian u32s;
+ *  - the blocks, each a little-endian u32 of its stored size, with the top
+ *    bit set if it was stored raw, then its bytes.
+ *
+ * Every block decompresses to the block size, but the last, without
+ * reference to any other, so a reader only ever needs one block's worth of
+ * window, and can seek by skipping whole blocks.
+ *
+ * Nothing here but the file functions and `Reader`'s default handle needs
+ * the Playdate API, so the host side of a build can compress with the same
+ * code the game decompresses with.
+ */
+namespace pdcpp::Compression
+{
+    constexpr uint32_t k_Magic = 0x5a4c4450; // "PDLZ", read little-endian
+    constexpr uint32_t k_Version = 1;
+    constexpr uint32_t k_HeaderSize = 4 * sizeof(uint32_t);
+    constexpr uint32_t k_DefaultBlockSize = 16 * 1024;
+    constexpr uint32_t k_MaxBlockSize = 64 * 1024;
+
+    /**
+     * @return the most a block of `size` bytes can take up once compressed.
+     */
+    constexpr size_t getCompressedBound(size_t size) { return size + size / 255 + 16; }
+
+    /**
+     * Compresses single blocks. It holds the table of recent positions the
+     * search uses, 8KB, so keep one around rather than making one per block.
+     */
+    class Compressor
+    {
+    public:
+        Compressor();
+
+        /**
+         * Compresses a block of up to `k_MaxBlockSize` bytes.
+         *
+         * @param source the bytes to compress
+         * @param size the number of bytes, at most `k_MaxBlockSize`
+         * @param destination where to write the compressed block
+         * @param capacity the size of `destination`. At least
+         *     `getCompressedBound(size)` always suffices.
+         * @return the size of the compressed block, or 0 if it didn't fit.
+         */
+        size_t compressBlock(const void* source, size_t size, void* destination, size_t capacity);
+
+    private:
+        std::vector<uint16_t> m_Table;
+    };
+
+    /**
+     * Decompresses a single block into a caller's buffer.
+     *
+     * @param source the compressed block
+     * @param size the size of the compressed block
+     * @param destination where to write the decompressed bytes
+     * @param capacity the size of `destination`
+     * @return the number of bytes decompressed, or -1 if the block is corrupt
+     *     or doesn't fit.
+     */
+    int decompressBlock(const void* source, size_t size, void* destination, size_t capacity);
+
+    /**
+     * Compresses a buffer into a frame.
+     *
+     * @param data the bytes to compress
+     * @param size the number of bytes
+     * @param blockSize the size of the blocks, at most `k_MaxBlockSize`.
+     *     Smaller blocks need less memory to read and seek faster, bigger
+     *     ones compress better.
+     */
+    std::vector<uint8_t> compress(const void* data, size_t size, uint32_t blockSize=k_DefaultBlockSize);
+
+    /**
+     * @return the size of a frame's data once decompressed, or nothing if it
+     *     isn't a frame.
+     */
+    std::optional<uint32_t> getDecompressedSize(const void* frame, size_t size);
+
+    /**
+     * Decompresses a frame into a caller's buffer.
+     *
+     * @return the number of bytes decompressed, or -1 if the frame is corrupt
+     *     or doesn't fit.
+     */
+    int decompress(const void* frame, size_t size, void* destination, size_t capacity);
+
+    /**
+     * Compresses a buffer into a file, in the data folder.
+     *
+     * @return false if the file couldn't be written.
+     */
+    bool saveFile(const std::string& path, const void* data, size_t size, uint32_t blockSize=k_DefaultBlockSize);
+
+    /**
+     * Reads and decompresses a whole file.
+     *
+     * @return its data, or nothing if it couldn't be read or is corrupt.
+     */
+    std::optional<std::vector<uint8_t>> loadFile(const std::string& path);
+
+    namespace detail
+    {
+        struct FrameHeader
+        {
+            uint32_t blockSize;
+            uint32_t size;
+        };
+
+        constexpr uint32_t k_RawBlock = 0x80000000;
+
+        std::optional<FrameHeader> readHeader(const uint8_t* bytes);
+        void writeU32(uint8_t* bytes, uint32_t value);
+
+        inline uint32_t readU32(const uint8_t* bytes)
+            { return uint32_t(bytes[0]) | uint32_t(bytes[1]) << 8 | uint32_t(bytes[2]) << 16 | uint32_t(bytes[3]) << 24; }
+    }
+
+    /**
+     * Reads a compressed file as if it weren't, with `FileHandle`'s read,
+     * seek, and tell, so it can stand in for one in a
+     * `PlaydateFileStreamBuffer`. `Handle` is the compressed file, and can be
+     * anything with `FileHandle`'s interface, like an `AssetPack::File`.
+     *
+     * One block is decompressed at a time. Seeking is free within it, costs a
+     * read per block skipped going forward, and starts again from the first
+     * block going back. Reads of whole blocks are decompressed straight into
+     * the caller's buffer.
+     *
+     * usage:
+     *      pdcpp::PlaydateFileStreamBuffer<256, pdcpp::Compression::Reader<>> buffer("level1.lz");
+     *      std::istream stream(&buffer);
+     *      ...
+     */
+    template <typename Handle=pdcpp::FileHandle>
+    class Reader
+    {
+    public:
+        /**
+         * Opens a compressed file.
+         *
+         * @param path the path of the compressed file
+         * @param mode the PlaydateSDK FileOptions to open it with, which must
+         *     be a reading mode.
+         */
+        explicit Reader(const std::string& path, FileOptions mode=kFileRead)
+            : Reader(Handle(path, mode))
+        {}
+
+        /**
+         * @param handle the compressed file, positioned at its header.
+         */
+        explicit Reader(Handle&& handle)
+            : m_Handle(std::move(handle))
+        {
+            uint8_t header[k_HeaderSize];
+            if (!m_Handle.isOpen() || m_Handle.read(header, k_HeaderSize) != int(k_HeaderSize))
+                { return; }
+
+            auto frame = detail::readHeader(header);
+            if (!frame)
+                { return; }
+
+            m_Frame = *frame;
+            m_Stat.size = frame->size;
+            m_DataStart = m_Handle.tell();
+
+            pdcpp::ScopedMemoryTag tag(pdcpp::MemoryTag::Files);
+            m_Block.resize(m_Frame.blockSize);
+            m_Compressed.resize(getCompressedBound(m_Frame.blockSize));
+            m_Valid = true;
+        }
+
+        /**
+         * Reads decompressed bytes.
+         *
+         * @return how many bytes were read, which is less than `length` at
+         *     the end, or -1 if the file is corrupt or couldn't be read.
+         */
+        int read(void* buffer, unsigned int length)
+        {
+            if (!m_Valid)
+                { return -1; }
+
+            auto out = static_cast<uint8_t*>(buffer);
+            length = std::min(length, m_Stat.size - m_Position);
+            unsigned int copied = 0;
+            while (copied < length)
+            {
+                if (m_Position >= m_BlockStart && m_Position < m_BlockStart + m_BlockLength)
+                {
+                    auto offset = m_Position - m_BlockStart;
+                    auto n = std::min(m_BlockLength - offset, length - copied);
+                    std::memcpy(out + copied, m_Block.data() + offset, n);
+                    copied += n;
+                    m_Position += n;
+                    continue;
+                }
+
+                auto index = m_Position / m_Frame.blockSize;
+                auto blockLength = getBlockLength(index);
+                auto direct = m_Position % m_Frame.blockSize == 0 && length - copied >= blockLength;
+                if (!direct)
+                    { m_BlockLength = 0; }
+                if (!loadBlock(index, direct ? out + copied : m_Block.data()))
+                    { return copied > 0 ? int(copied) : -1; }
+
+                if (direct)
+                {
+                    copied += blockLength;
+                    m_Position += blockLength;
+                }
+                else
+                {
+                    m_BlockStart = index * m_Frame.blockSize;
+                    m_BlockLength = blockLength;
+                }
+            }
+            return int(copied);
+        }
+
+        /**
+         * Compressed files are read-only, so this always fails.
+         *
+         * @return -1
+         */
+        int write(void*, unsigned int) { return -1; }
+
+        /**
+         * Moves the read head, in the decompressed data.
+         *
+         * @return 0 on success, -1 if the position would be outside it.
+         */
+        int seek(int position, FileHandle::Whence whence)
+        {
+            int64_t target = position;
+            if (whence == FileHandle::CURRENT)
+                { target += m_Position; }
+            else if (whence == FileHandle::END)
+                { target += m_Stat.size; }
+
+            if (!m_Valid || target < 0 || target > int64_t(m_Stat.size))
+                { return -1; }
+
+            // The block is found when it's read.
+            m_Position = uint32_t(target);
+            return 0;
+        }
+
+        [[ nodiscard ]] int tell() const { return int(m_Position); }
+
+        /**
+         * @return true if the file opened and is compressed.
+         */
+        [[ nodiscard ]] bool isOpen() const { return m_Valid; }
+
+        /**
+         * @return a FileStat block with the decompressed size.
+         */
+        [[ nodiscard ]] const FileStat& getDetails() const { return m_Stat; }
+
+    private:
+        [[ nodiscard ]] uint32_t getBlockLength(uint32_t index) const
+            { return std::min(m_Frame.blockSize, m_Stat.size - index * m_Frame.blockSize); }
+
+        // Decompresses a block into `destination`, which has room for it,
+        // skipping the blocks in between or starting over as needed.
+        bool loadBlock(uint32_t index, uint8_t* destination)
+        {
+            if (index < m_NextBlock)
+            {
+                if (m_Handle.seek(m_DataStart, FileHandle::SET) != 0)
+                    { return false; }
+                m_NextBlock = 0;
+            }
+
+            while (true)
+            {
+                uint8_t header[4];
+                if (m_Handle.read(header, 4) != 4)
+                    { return false; }
+
+                auto word = detail::readU32(header);
+                auto stored = word & ~detail::k_RawBlock;
+                if (m_NextBlock < index)
+                {
+                    if (m_Handle.seek(int(stored), FileHandle::CURRENT) != 0)
+                        { return false; }
+                    ++m_NextBlock;
+                    continue;
+                }
+
+                // Whatever happens next, the head is past this block's header.
+                m_NextBlock = k_UnknownBlock;
+                auto length = getBlockLength(index);
+                if ((word & detail::k_RawBlock) != 0)
+                {
+                    if (stored != length || m_Handle.read(destination, length) != int(length))
+                        { return false; }
+                }
+                else if (stored > m_Compressed.size()
+                         || m_Handle.read(m_Compressed.data(), stored) != int(stored)
+                         || decompressBlock(m_Compressed.data(), stored, destination, length) != int(length))
+                    { return false; }
+
+                m_NextBlock = index + 1;
+                return true;
+            }
+        }
+
+        // Forces the next block read to start over.
+        static constexpr uint32_t k_UnknownBlock = 0xffffffff;
+
+        Handle m_Handle;
+        FileStat m_Stat{};
+        detail::FrameHeader m_Frame{};
+        std::vector<uint8_t> m_Block;
+        std::vector<uint8_t> m_Compressed;
+        int m_DataStart = 0;
+        uint32_t m_NextBlock = 0;
+        uint32_t m_BlockStart = 0;
+        uint32_t m_BlockLength = 0;
+        uint32_t m_Position = 0;
+        bool m_Valid = false;
+    };
+}
@@ -59,6 +59,12 @@ namespace pdcpp
          */
         void removeListener(Listener* toRemove);
 
+    protected:
+        /**
+         * Tells every listener about crank movement, if it moved.
+         */
+        void notify(float absolute, float delta);
+
     private:
         std::vector<Listener*> m_Listeners;
     };
@@ -0,0 +1,255 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include "Fixed.h"
+
+/**
+ * Table-based approximations of the trig functions, and a fast inverse square
+ * root, for code which calls them every frame and doesn't need libm's
+ * precision.
+ *
+ * The tables are built at compile time, one per resolution used, and are
+ * linearly interpolated. `TableBits` sets the resolution: a table has
+ * 2^TableBits entries, and takes four bytes per entry. At the default of 10,
+ * sin and cos are good to about 1e-5, and atan2 to about 3e-7, better than a
+ * pixel at any size the screen can show. Run the `math_` benchmarks to see
+ * what each costs on a given build.
+ *
+ * Angles are in radians, and should stay within a few million of zero; the
+ * further out they get, the less of a float is left for the fraction of a
+ * turn.
+ */
+namespace pdcpp::FastMath
+{
+    constexpr int k_DefaultTableBits = 10;
+
+    /**
+     * Passed to the geometry functions with a `FastMath` overload, like
+     * `Point::rotated`, to choose the table-based version.
+     */
+    struct UseTables {};
+    inline constexpr UseTables useTables {};
+
+    struct SinCos
+    {
+        float sin;
+        float cos;
+    };
+
+    namespace detail
+    {
+        constexpr double k_Pi = 3.14159265358979323846;
+
+        // Good to the last bit of a double over [-pi/2, pi/2], which is all
+        // the table builder asks of it.
+        constexpr double taylorSin(double x)
+        {
+            auto term = x;
+            auto sum = x;
+            for (int n = 1; n < 15; ++n)
+            {
+                term *= -x * x / double((2 * n) * (2 * n + 1));
+                sum += term;
+            }
+            return sum;
+        }
+
+        constexpr double sinOfTurn(double turn)
+        {
+            // Mirror into [-1/4, 1/4] of a turn.
+            if (turn > 0.5)
+                { turn -= 1.0; }
+            if (turn > 0.25)
+                { turn = 0.5 - turn; }
+            else if (turn < -0.25)
+                { turn = -0.5 - turn; }
+            return taylorSin(turn * 2.0 * k_Pi);
+        }
+
+        constexpr double squareRoot(double x)
+        {
+            auto guess = x > 1.0 ? x : 1.0;
+            for (int i = 0; i < 64; ++i)
+                { guess = 0.5 * (guess + x / guess); }
+            return guess;
+        }
+
+        // atan over [0, 1], halving the angle twice so the series converges
+        // quickly.
+        constexpr double seriesAtan(double z)
+        {
+            for (int i = 0; i < 2; ++i)
+                { z = z / (1.0 + squareRoot(1.0 + z * z)); }
+
+            auto power = z;
+            auto sum = 0.0;
+            for (int n = 0; n < 30; ++n)
+            {
+                sum += (n % 2 == 0 ? power : -power) / double(2 * n + 1);
+                power *= z * z;
+            }
+            return sum * 4.0;
+        }
+
+        template <int TableBits>
+        struct Tables
+        {
+            static_assert(TableBits >= 4 && TableBits <= 16, "FastMath tables need between 4 and 16 bits");
+
+            static constexpr int k_Size = 1 << TableBits;
+
+            // A whole turn of sine, plus one entry to interpolate towards.
+            static constexpr auto k_Sin = []()
+            {
+                std::array<float, k_Size + 1> table {};
+                for (int i = 0; i <= k_Size; ++i)
+                    { table[size_t(i)] = float(sinOfTurn(double(i % k_Size) / k_Size)); }
+                return table;
+            }();
+
+            // The same, with 30 bits of fraction, for `Fixed`.
+            static constexpr auto k_SinQ30 = []()
+            {
+                std::array<int32_t, k_Size + 1> table {};
+                for (int i = 0; i <= k_Size; ++i)
+                {
+                    auto value = sinOfTurn(double(i % k_Size) / k_Size) * double(1 << 30);
+                    table[size_t(i)] = int32_t(value < 0 ? value - 0.5 : value + 0.5);
+                }
+                return table;
+            }();
+
+            // atan over [0, 1].
+            static constexpr auto k_Atan = []()
+            {
+                std::array<float, k_Size + 1> table {};
+                for (int i = 0; i <= k_Size; ++i)
+                    { table[size_t(i)] = float(seriesAtan(double(i) / k_Size)); }
+                return table;
+            }();
+        };
+
+        template <int TableBits>
+        float lookUpSin(float turns)
+        {
+            using Table = Tables<TableBits>;
+
+            const auto scaled = turns * float(Table::k_Size);
+            auto whole = static_cast<int32_t>(scaled);
+            if (scaled < float(whole))
+                { --whole; }
+
+            const auto fraction = scaled - float(whole);
+            const auto index = static_cast<size_t>(static_cast<uint32_t>(whole) & (Table::k_Size - 1));
+            const auto a = Table::k_Sin[index];
+            return a + (Table::k_Sin[index + 1] - a) * fraction;
+        }
+
+        template <int TableBits>
+        int64_t lookUpSinQ30(uint32_t phase)
+        {
+            using Table = Tables<TableBits>;
+            constexpr int k_FractionBits = 32 - TableBits;
+
+            const auto index = static_cast<size_t>(phase >> k_FractionBits);
+            const auto fraction = int64_t(phase & ((uint32_t(1) << k_FractionBits) - 1));
+            const auto a = int64_t(Table::k_SinQ30[index]);
+            return a + (((int64_t(Table::k_SinQ30[index + 1]) - a) * fraction) >> k_FractionBits);
+        }
+
+        constexpr float k_TurnsPerRadian = float(1.0 / (2.0 * k_Pi));
+    }
+
+    template <int TableBits = k_DefaultTableBits>
+    [[ nodiscard ]] float sin(float radians)
+        { return detail::lookUpSin<TableBits>(radians * detail::k_TurnsPerRadian); }
+
+    template <int TableBits = k_DefaultTableBits>
+    [[ nodiscard ]] float cos(float radians)
+        { return detail::lookUpSin<TableBits>(radians * detail::k_TurnsPerRadian + 0.25f); }
+
+    /**
+     * The sine and cosine of the same angle, which is cheaper than asking for
+     * them separately.
+     */
+    template <int TableBits = k_DefaultTableBits>
+    [[ nodiscard ]] SinCos sinCos(float radians)
+    {
+        const auto turns = radians * detail::k_TurnsPerRadian;
+        return {detail::lookUpSin<TableBits>(turns), detail::lookUpSin<TableBits>(turns + 0.25f)};
+    }
+
+    /**
+     * @returns the angle of the point (x, y) from the x axis, in radians
+     *     between -pi and pi.
+     */
+    template <int TableBits = k_DefaultTableBits>
+    [[ nodiscard ]] float atan2(float y, float x)
+    {
+        using Table = detail::Tables<TableBits>;
+        constexpr auto k_Pi = float(detail::k_Pi);
+
+        const auto ax = x < 0 ? -x : x;
+        const auto ay = y < 0 ? -y : y;
+        if (ax == 0 && ay == 0)
+            { return 0; }
+
+        // Fold into the first octant, where the ratio is between 0 and 1.
+        const auto isSteep = ay > ax;
+        const auto scaled = (isSteep ? ax / ay : ay / ax) * float(Table::k_Size);
+        const auto index = std::min(static_cast<int>(scaled), Table::k_Size - 1);
+        const auto a = Table::k_Atan[size_t(index)];
+        auto angle = a + (Table::k_Atan[size_t(index) + 1] - a) * (scaled - float(index));
+
+        if (isSteep)
+            { angle = k_Pi / 2 - angle; }
+        if (x < 0)
+            { angle = k_Pi - angle; }
+        return y < 0 ? -angle : angle;
+    }
+
+    template <int TableBits = k_DefaultTableBits, int I, int F>
+    [[ nodiscard ]] Fixed<I, F> sin(Fixed<I, F> radians)
+        { return Fixed<I, F>::fromQ30(detail::lookUpSinQ30<TableBits>(pdcpp::detail::toPhase(radians))); }
+
+    template <int TableBits = k_DefaultTableBits, int I, int F>
+    [[ nodiscard ]] Fixed<I, F> cos(Fixed<I, F> radians)
+    {
+        const auto phase = pdcpp::detail::toPhase(radians) + (uint32_t(1) << 30);
+        return Fixed<I, F>::fromQ30(detail::lookUpSinQ30<TableBits>(phase));
+    }
+
+    /**
+     * 1 / sqrt(x), from a guess made by treating the float's bits as an
+     * integer, refined by Newton's method. One iteration is good to about
+     * 0.2%, two to about 0.0005%. Only meaningful for positive, normal x.
+     */
+    template <int Iterations = 1>
+    [[ nodiscard ]] constexpr float invSqrt(float x)
+    {
+        auto y = std::bit_cast<float>(0x5f375a86u - (std::bit_cast<uint32_t>(x) >> 1));
+        for (int i = 0; i < Iterations; ++i)
+            { y = y * (1.5f - 0.5f * x * y * y); }
+        return y;
+    }
+
+    /**
+     * sqrt(x) by way of `invSqrt`, or 0 for anything not positive.
+     */
+    template <int Iterations = 1>
+    [[ nodiscard ]] constexpr float sqrt(float x)
+        { return x > 0 ? x * invSqrt<Iterations>(x) : 0.0f; }
+}
@@ -9,6 +9,8 @@
  */
 
 #pragma once
+#include <algorithm>
+#include <cstring>
 #include <memory>
 #include <streambuf>
 #include <string>
@@ -87,9 +89,23 @@ namespace pdcpp
          */
         [[ nodiscard ]] const FileStat& getDetails() const;
 
+        /**
+         * @return true if the file opened.
+         */
+        [[ nodiscard ]] bool isOpen() const { return p_File != nullptr; }
+
         FileStat m_Stat{};
         SDFile* p_File;
 
+    private:
+        // Closes the file, if it's open, and has the cache forget it if it
+        // was written.
+        void close();
+
+        // The path of a file opened to write, so the cache can forget it once
+        // it's been written. Empty for files opened to read.
+        std::string m_WrittenPath;
+
         PDCPP_DECLARE_NON_COPYABLE(FileHandle);
     };
 
@@ -98,7 +114,8 @@ namespace pdcpp
     public:
         /**
          * Returns a list of files in the directory, if it exists and is a
-         * directory, otherwise an error will print to the console.
+         * directory, otherwise an empty list.
+         * Listings are kept by `FileSystemCache::getDefault()`.
          *
          * @param dirPath the path of which to list the contents
          * @param showHidden optionally include hidden files in the list.
@@ -126,6 +143,16 @@ namespace pdcpp
          */
         static int rename(const std::string& from, const std::string& to);
 
+        /**
+         * Deletes a file, or a directory.
+         *
+         * @param path the file or directory to delete
+         * @param recursive delete a directory's contents too. Without this, only
+         *     empty directories can be deleted.
+         * @return 0 on success, -1 on failure.
+         */
+        static int unlink(const std::string& path, bool recursive=false);
+
         /**
          * Stats a path to indicate whether the file exists and is not a
          * directory.
@@ -136,7 +163,8 @@ namespace pdcpp
         static bool fileExists(const std::string& path);
 
         /**
-         * Run stat on a file without opening it
+         * Run stat on a file without opening it, or find it in
+         * `FileSystemCache::getDefault()` if it's been stat-ed before.
          *
          * @param path the path to stat
          * @return a FileStat object describing the file
@@ -154,33 +182,258 @@ namespace pdcpp
         static std::string parentDir(const std::string& fileOrDirname);
     };
 
-    template <std::size_t Size>
-    struct PlaydateReadFileStreamBuffer
-        : std::streambuf
+    /**
+     * A `std::streambuf` over a Playdate file, so `std::istream` and
+     * `std::ostream` based code can read and write files in place, through a
+     * fixed buffer of `Size` bytes, rather than loading them whole.
+     *
+     * The buffer holds either read-ahead or pending writes. Switching from one
+     * to the other writes out, or gives back, what it holds. Reads and writes
+     * of at least `Size` bytes go straight to the file. Seeking within the
+     * read-ahead, and asking for the position, don't touch the file system.
+     *
+     * Anything with `FileHandle`'s `read`, `write`, `seek`, `tell`,
+     * `getDetails`, and `isOpen` can stand in for the file, like an
+     * `AssetPack::File`.
+     *
+     * usage:
+     *      auto buffer = pdcpp::PlaydateFileStreamBuffer<512>::makeStreamBuffer("levels.txt");
+     *      std::istream stream(buffer.get());
+     *      std::string line;
+     *      while (std::getline(stream, line))
+     *          { parseLevel(line); }
+     */
+    template <std::size_t Size, typename Handle=pdcpp::FileHandle>
+    class PlaydateFileStreamBuffer
+        : public std::streambuf
     {
-        explicit PlaydateReadFileStreamBuffer(const std::string& filename)
-            : m_Handle(filename, kFileRead)
-        {}
+    public:
+        /**
+         * @param filename the path of the file to open
+         * @param mode the PlaydateSDK FileOptions for the opening mode to use
+         */
+        explicit PlaydateFileStreamBuffer(const std::string& filename, FileOptions mode=kFileRead)
+            : m_Handle(filename, mode)
+        {
+            setg(m_Buffer, m_Buffer, m_Buffer);
+            if ((mode & kFileAppend) != 0)
+                { m_FilePosition = m_Handle.getDetails().size; }
+        }
 
-        int underflow() override
+        /**
+         * @param handle an open file to stream, from its current position.
+         */
+        explicit PlaydateFileStreamBuffer(Handle&& handle)
+            : m_Handle(std::move(handle))
         {
-            if (m_EOF)
+            setg(m_Buffer, m_Buffer, m_Buffer);
+            m_FilePosition = m_Handle.tell();
+        }
+
+        // Destructor. Writes out anything pending.
+        ~PlaydateFileStreamBuffer() override { leavePutMode(); }
+
+        [[ nodiscard ]] bool isOpen() const { return m_Handle.isOpen(); }
+
+        static std::unique_ptr<PlaydateFileStreamBuffer> makeStreamBuffer
+            (const std::string& filepath, FileOptions mode=kFileRead)
+        { return std::make_unique<PlaydateFileStreamBuffer>(filepath, mode); }
+
+    protected:
+        int_type underflow() override
+        {
+            if (gptr() < egptr())
+                { return traits_type::to_int_type(*gptr()); }
+
+            if (!isOpen() || !leavePutMode())
                 { return traits_type::eof(); }
 
-            auto read_size = m_Handle.read(m_Buffer, Size);
-            if (read_size < Size)
-                { m_EOF = true; }
+            // Only a read of nothing is the end; short reads happen on the way.
+            auto nRead = m_Handle.read(m_Buffer, Size);
+            if (nRead <= 0)
+            {
+                setg(m_Buffer, m_Buffer, m_Buffer);
+                return traits_type::eof();
+            }
 
-            setg(m_Buffer, m_Buffer, m_Buffer + read_size);
-            return *gptr();
+            m_FilePosition += nRead;
+            setg(m_Buffer, m_Buffer, m_Buffer + nRead);
+            return traits_type::to_int_type(*gptr());
         }
 
-        static std::unique_ptr<PlaydateReadFileStreamBuffer<Size>> makeStreamBuffer(const std::string& filepath)
-        { return std::make_unique<PlaydateReadFileStreamBuffer<Size>>(filepath); }
+        int_type overflow(int_type ch) override
+        {
+            if (!isOpen() || !enterPutMode())
+                { return traits_type::eof(); }
+
+            if (pptr() == epptr() && !flushPut())
+                { return traits_type::eof(); }
+
+            if (!traits_type::eq_int_type(ch, traits_type::eof()))
+            {
+                *pptr() = traits_type::to_char_type(ch);
+                pbump(1);
+            }
+            return traits_type::not_eof(ch);
+        }
+
+        int sync() override { return flushPut() ? 0 : -1; }
+
+        std::streamsize xsgetn(char* s, std::streamsize count) override
+        {
+            std::streamsize copied = std::min<std::streamsize>(egptr() - gptr(), count);
+            std::memcpy(s, gptr(), size_t(copied));
+            gbump(int(copied));
+
+            auto remaining = count - copied;
+            if (remaining == 0)
+                { return copied; }
+
+            if (remaining < std::streamsize(Size))
+                { return copied + std::streambuf::xsgetn(s + copied, remaining); }
+
+            if (!isOpen() || !leavePutMode())
+                { return copied; }
+
+            // The file system can return less than was asked for before the
+            // end of the file, so keep going until it returns nothing.
+            while (remaining > 0)
+            {
+                auto nRead = m_Handle.read(s + copied, (unsigned int)remaining);
+                if (nRead <= 0)
+                    { break; }
+                m_FilePosition += nRead;
+                copied += nRead;
+                remaining -= nRead;
+            }
+            return copied;
+        }
+
+        std::streamsize xsputn(const char* s, std::streamsize count) override
+        {
+            if (count < std::streamsize(Size))
+                { return std::streambuf::xsputn(s, count); }
+
+            if (!isOpen() || !enterPutMode() || !flushPut())
+                { return 0; }
+
+            auto nWritten = m_Handle.write(const_cast<char*>(s), (unsigned int)count);
+            if (nWritten <= 0)
+                { return 0; }
+
+            m_FilePosition += nWritten;
+            return nWritten;
+        }
+
+        pos_type seekoff(off_type offset, std::ios_base::seekdir dir, std::ios_base::openmode which) override
+        {
+            if (!isOpen())
+                { return pos_type(off_type(-1)); }
+
+            if (dir == std::ios_base::cur)
+                { return seekpos(pos_type(getPosition() + offset), which); }
+
+            if (dir == std::ios_base::beg)
+                { return seekpos(pos_type(offset), which); }
+
+            // Only the file system knows where the end is now.
+            if (!leavePutMode() || !discardReadAhead() || m_Handle.seek(int(offset), pdcpp::FileHandle::END) != 0)
+                { return pos_type(off_type(-1)); }
+
+            m_FilePosition = m_Handle.tell();
+            return pos_type(m_FilePosition);
+        }
+
+        pos_type seekpos(pos_type position, std::ios_base::openmode) override
+        {
+            auto target = off_type(position);
+            if (!isOpen() || target < 0)
+                { return pos_type(off_type(-1)); }
+
+            if (target == getPosition())
+                { return position; }
+
+            auto bufferStart = m_FilePosition - (egptr() - eback());
+            if (pbase() == nullptr && target >= bufferStart && target <= m_FilePosition)
+            {
+                setg(eback(), eback() + (target - bufferStart), egptr());
+                return position;
+            }
+
+            if (!leavePutMode() || m_Handle.seek(int(target), pdcpp::FileHandle::SET) != 0)
+                { return pos_type(off_type(-1)); }
+
+            m_FilePosition = target;
+            setg(m_Buffer, m_Buffer, m_Buffer);
+            return position;
+        }
 
     private:
-        pdcpp::FileHandle m_Handle;
+        // Where the stream is, as opposed to where the file's head is.
+        off_type getPosition() const
+        {
+            if (pbase() != nullptr)
+                { return m_FilePosition + (pptr() - pbase()); }
+            return m_FilePosition - (egptr() - gptr());
+        }
+
+        bool flushPut()
+        {
+            if (pbase() == nullptr || pptr() == pbase())
+                { return true; }
+
+            auto pending = int(pptr() - pbase());
+            auto nWritten = m_Handle.write(m_Buffer, (unsigned int)pending);
+            if (nWritten > 0)
+                { m_FilePosition += nWritten; }
+
+            setp(m_Buffer, m_Buffer + Size);
+            return nWritten == pending;
+        }
+
+        // Gives back unread read-ahead, putting the file's head back where
+        // the stream is.
+        bool discardReadAhead()
+        {
+            auto unread = egptr() - gptr();
+            setg(m_Buffer, m_Buffer, m_Buffer);
+            if (unread == 0)
+                { return true; }
+
+            m_FilePosition -= unread;
+            return m_Handle.seek(int(m_FilePosition), pdcpp::FileHandle::SET) == 0;
+        }
+
+        bool enterPutMode()
+        {
+            if (pbase() != nullptr)
+                { return true; }
+
+            if (!discardReadAhead())
+                { return false; }
+
+            setp(m_Buffer, m_Buffer + Size);
+            return true;
+        }
+
+        bool leavePutMode()
+        {
+            if (pbase() == nullptr)
+                { return true; }
+
+            auto flushed = flushPut();
+            setp(nullptr, nullptr);
+            return flushed;
+        }
+
+        Handle m_Handle;
         char m_Buffer[Size] = {0};
-        bool m_EOF = false;
+
+        // Where the file's head is.
+        off_type m_FilePosition = 0;
     };
+
+    // The read-only name this stream buffer had before it could seek and write.
+    template <std::size_t Size>
+    using PlaydateReadFileStreamBuffer = PlaydateFileStreamBuffer<Size>;
 }
@@ -0,0 +1,117 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#pragma once
+
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <pd_api.h>
+#include "util.h"
+
+namespace pdcpp
+{
+    /**
+     * Remembers directory listings and file stats, so browsing a directory, or
+     * opening a file, doesn't go back to the file system for what it was told
+     * last time. `FileHelpers` and `FileHandle` go through the default cache.
+     *
+     * Anything done to the file system through pdcpp, like opening a file to
+     * write, `FileHelpers::mkdir`, `unlink`, and `rename`, drops what it
+     * changes from the cache. Changes made through the C API directly aren't
+     * seen, and need an `invalidate` of their own.
+     *
+     * Once a directory's listing is cached, stats of paths which aren't in it
+     * are answered without asking the file system.
+     *
+     * The number of stats kept is capped, see `setMaxStats`. Listings aren't,
+     * as there are only as many as there are directories visited.
+     *
+     * usage:
+     *      auto& cache = pdcpp::FileSystemCache::getDefault();
+     *      for (auto& name : cache.listFiles("saves/"))  // one call, the first time
+     *          { ... }
+     */
+    class FileSystemCache
+    {
+    public:
+        FileSystemCache() = default;
+
+        /**
+         * Lists a directory, from the cache if it's been listed before.
+         * Subdirectories end with a '/'.
+         *
+         * @param directory the directory to list
+         * @param showHidden include files starting with '.'
+         * @return the names in the directory, in the order the system listed
+         *     them, which stay valid until the cache next changes, or nullptr,
+         *     quietly, if it couldn't be listed.
+         */
+        const std::vector<std::string>* listFiles(const std::string& directory, bool showHidden=false);
+
+        /**
+         * Stats a path, from the cache if it's been stat-ed before. Failures
+         * aren't cached.
+         *
+         * @return the path's FileStat, or nothing if it doesn't exist.
+         */
+        std::optional<FileStat> stat(const std::string& path);
+
+        /**
+         * Forgets a path, everything below it, and its parent's listing.
+         * Call this after changing a file through the C API.
+         */
+        void invalidate(const std::string& path);
+
+        // Forgets everything.
+        void clear();
+
+        /**
+         * Sets how many stats are kept, after which one is dropped for each
+         * new one. Dropping them only costs a call to stat them again.
+         */
+        void setMaxStats(size_t maxStats);
+        [[ nodiscard ]] size_t getMaxStats() const { return m_MaxStats; }
+
+        static constexpr size_t k_DefaultMaxStats = 256;
+
+        /**
+         * @return the number of calls into the file system the cache has made,
+         *     for checking how much it's saving.
+         */
+        [[ nodiscard ]] size_t getNumApiCalls() const { return m_NumApiCalls; }
+
+        /**
+         * @return the cache shared by the library.
+         */
+        static FileSystemCache& getDefault();
+
+    private:
+        struct Listing
+        {
+            std::vector<std::string> visible;
+            std::vector<std::string> all;
+            bool hasHidden = false;
+        };
+
+        // Directories are keyed with a trailing '/', or empty for the root.
+        static std::string directoryKey(const std::string& directory);
+        static std::string parentKey(const std::string& path);
+        static std::string entryName(const std::string& path);
+
+        std::unordered_map<std::string, Listing> m_Listings;
+        std::unordered_map<std::string, FileStat> m_Stats;
+        size_t m_NumApiCalls = 0;
+        size_t m_MaxStats = k_DefaultMaxStats;
+
+        PDCPP_DECLARE_NON_COPYABLE_NON_MOVABLE(FileSystemCache);
+    };
+}
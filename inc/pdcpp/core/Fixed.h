@@ -0,0 +1,320 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <compare>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+
+namespace pdcpp
+{
+    /**
+     * A signed fixed-point number, with `IntBits` bits of integer, including
+     * the sign, and `FracBits` bits of fraction, in a 32-bit integer.
+     *
+     * Everything is done with integer arithmetic, so the same inputs give
+     * bit-for-bit the same results on the device, the simulator, and any
+     * other machine, which floats don't promise. Use it for simulations which
+     * are replayed or compared across platforms, and anywhere the result is
+     * only going to be truncated to a pixel anyway.
+     *
+     * Integers convert implicitly, floats explicitly, as they may lose
+     * precision. The usual operators wrap on overflow, like integers; use the
+     * saturating versions where a value could get out of range. Division by
+     * zero saturates.
+     *
+     * usage:
+     *      using pdcpp::Fixed16;
+     *      pdcpp::Point<Fixed16> position {10, 20};
+     *      auto velocity = pdcpp::Point<Fixed16>(Fixed16(1.5f), Fixed16(0.25f));
+     *      position = position + velocity;
+     *      auto pixel = position.toInt();
+     */
+    template <int IntBits, int FracBits>
+    class Fixed
+    {
+        static_assert(IntBits >= 2 && FracBits >= 1 && IntBits + FracBits == 32,
+                      "Fixed needs at least two integer bits, one fractional bit, and 32 bits in total");
+
+    public:
+        using Raw = int32_t;
+
+        static constexpr int k_IntBits = IntBits;
+        static constexpr int k_FracBits = FracBits;
+        static constexpr Raw k_One = Raw(1) << FracBits;
+
+        constexpr Fixed() = default;
+
+        /**
+         * Makes a whole number. Values outside of the range wrap.
+         */
+        template <std::integral I>
+        constexpr Fixed(I value)  // NOLINT(*-explicit-constructor)
+            : m_Raw(static_cast<Raw>(static_cast<uint32_t>(value) << FracBits))
+        {}
+
+        /**
+         * Makes the nearest fixed-point number to a float, saturating values
+         * outside of the range.
+         */
+        template <std::floating_point F>
+        constexpr explicit Fixed(F value)
+        {
+            const auto scaled = static_cast<double>(value) * k_One;
+            if (scaled >= double(std::numeric_limits<Raw>::max()))
+                { m_Raw = std::numeric_limits<Raw>::max(); }
+            else if (scaled <= double(std::numeric_limits<Raw>::min()))
+                { m_Raw = std::numeric_limits<Raw>::min(); }
+            else
+                { m_Raw = static_cast<Raw>(scaled < 0 ? scaled - 0.5 : scaled + 0.5); }
+        }
+
+        /**
+         * Makes a fixed-point number from its underlying integer.
+         */
+        [[ nodiscard ]] static constexpr Fixed fromRaw(Raw raw)
+        {
+            Fixed rv;
+            rv.m_Raw = raw;
+            return rv;
+        }
+
+        [[ nodiscard ]] constexpr Raw raw() const { return m_Raw; }
+
+        [[ nodiscard ]] static constexpr Fixed lowest() { return fromRaw(std::numeric_limits<Raw>::min()); }
+        [[ nodiscard ]] static constexpr Fixed max() { return fromRaw(std::numeric_limits<Raw>::max()); }
+        [[ nodiscard ]] static constexpr Fixed epsilon() { return fromRaw(1); }
+        [[ nodiscard ]] static constexpr Fixed pi() { return Fixed(3.14159265358979323846); }
+
+        /**
+         * @returns the whole part, rounded towards zero, like converting a
+         *     float.
+         */
+        [[ nodiscard ]] constexpr int toInt() const { return (m_Raw + (m_Raw < 0 ? k_One - 1 : 0)) >> FracBits; }
+
+        [[ nodiscard ]] constexpr int floorToInt() const { return m_Raw >> FracBits; }
+        [[ nodiscard ]] constexpr int ceilToInt() const { return static_cast<int>((int64_t(m_Raw) + k_One - 1) >> FracBits); }
+        [[ nodiscard ]] constexpr int roundToInt() const { return static_cast<int>((int64_t(m_Raw) + k_One / 2) >> FracBits); }
+
+        [[ nodiscard ]] constexpr float toFloat() const { return static_cast<float>(m_Raw) / static_cast<float>(k_One); }
+
+        template <std::integral I>
+        [[ nodiscard ]] constexpr explicit operator I() const { return static_cast<I>(toInt()); }
+
+        template <std::floating_point F>
+        [[ nodiscard ]] constexpr explicit operator F() const { return static_cast<F>(m_Raw) / static_cast<F>(k_One); }
+
+        [[ nodiscard ]] friend constexpr Fixed operator+ (Fixed a, Fixed b)
+            { return fromRaw(static_cast<Raw>(static_cast<uint32_t>(a.m_Raw) + static_cast<uint32_t>(b.m_Raw))); }
+
+        [[ nodiscard ]] friend constexpr Fixed operator- (Fixed a, Fixed b)
+            { return fromRaw(static_cast<Raw>(static_cast<uint32_t>(a.m_Raw) - static_cast<uint32_t>(b.m_Raw))); }
+
+        [[ nodiscard ]] friend constexpr Fixed operator- (Fixed a)
+            { return fromRaw(static_cast<Raw>(0u - static_cast<uint32_t>(a.m_Raw))); }
+
+        [[ nodiscard ]] friend constexpr Fixed operator* (Fixed a, Fixed b)
+            { return fromRaw(static_cast<Raw>((int64_t(a.m_Raw) * b.m_Raw) >> FracBits)); }
+
+        [[ nodiscard ]] friend constexpr Fixed operator/ (Fixed a, Fixed b)
+        {
+            if (b.m_Raw == 0)
+                { return a.m_Raw < 0 ? lowest() : max(); }
+            return fromRaw(static_cast<Raw>((int64_t(a.m_Raw) * k_One) / b.m_Raw));
+        }
+
+        constexpr Fixed& operator+= (Fixed other) { return *this = *this + other; }
+        constexpr Fixed& operator-= (Fixed other) { return *this = *this - other; }
+        constexpr Fixed& operator*= (Fixed other) { return *this = *this * other; }
+        constexpr Fixed& operator/= (Fixed other) { return *this = *this / other; }
+
+        friend constexpr bool operator== (const Fixed&, const Fixed&) = default;
+        friend constexpr std::strong_ordering operator<=> (const Fixed&, const Fixed&) = default;
+
+        [[ nodiscard ]] static constexpr Fixed saturatingAdd(Fixed a, Fixed b)
+            { return saturate(int64_t(a.m_Raw) + b.m_Raw); }
+
+        [[ nodiscard ]] static constexpr Fixed saturatingSub(Fixed a, Fixed b)
+            { return saturate(int64_t(a.m_Raw) - b.m_Raw); }
+
+        [[ nodiscard ]] static constexpr Fixed saturatingMul(Fixed a, Fixed b)
+            { return saturate((int64_t(a.m_Raw) * b.m_Raw) >> FracBits); }
+
+        [[ nodiscard ]] static constexpr Fixed saturatingDiv(Fixed a, Fixed b)
+        {
+            if (b.m_Raw == 0)
+                { return a.m_Raw < 0 ? lowest() : max(); }
+            return saturate((int64_t(a.m_Raw) * k_One) / b.m_Raw);
+        }
+
+        /**
+         * @returns the nearest fixed-point number to a raw value with 30 bits
+         *     of fraction, which is what the math functions work in.
+         */
+        [[ nodiscard ]] static constexpr Fixed fromQ30(int64_t q30)
+        {
+            if constexpr (FracBits >= 30)
+                { return fromRaw(static_cast<Raw>(q30)); }
+            else
+                { return fromRaw(static_cast<Raw>((q30 + (int64_t(1) << (29 - FracBits))) >> (30 - FracBits))); }
+        }
+
+    private:
+        static constexpr Fixed saturate(int64_t raw)
+        {
+            return fromRaw(static_cast<Raw>(std::clamp<int64_t>(raw, std::numeric_limits<Raw>::min(),
+                                                                std::numeric_limits<Raw>::max())));
+        }
+
+        Raw m_Raw = 0;
+    };
+
+    /**
+     * 16 bits of integer and 16 of fraction: whole numbers to +/-32767, in
+     * steps of 1/65536. Plenty for positions on a 400x240 screen.
+     */
+    using Fixed16 = Fixed<16, 16>;
+
+    namespace detail
+    {
+        constexpr int64_t q30(double value) { return static_cast<int64_t>(value * double(1 << 30) + (value < 0 ? -0.5 : 0.5)); }
+
+        constexpr uint64_t isqrt(uint64_t value)
+        {
+            uint64_t result = 0;
+            uint64_t bit = uint64_t(1) << 62;
+            while (bit > value)
+                { bit >>= 2; }
+
+            while (bit != 0)
+            {
+                if (value >= result + bit)
+                {
+                    value -= result + bit;
+                    result = (result >> 1) + bit;
+                }
+                else
+                    { result >>= 1; }
+                bit >>= 2;
+            }
+            return result;
+        }
+
+        // sin of a phase where 2^32 is a full turn, with 30 bits of fraction.
+        constexpr int64_t sinQ30(uint32_t phase)
+        {
+            // A Taylor series of sin(z * pi / 2) over a quarter turn, good to
+            // a few millionths, mirrored into the other three.
+            constexpr int64_t k_Coefficients[] = {q30(1.5707963267948966), q30(-0.6459640975062462),
+                                                  q30(0.0796926262461670), q30(-0.0046817541353187),
+                                                  q30(0.0001604411847874)};
+            constexpr uint32_t k_Quarter = uint32_t(1) << 30;
+
+            const auto quadrant = phase >> 30;
+            int64_t z = phase & (k_Quarter - 1);
+            if ((quadrant & 1) != 0)
+                { z = k_Quarter - z; }
+
+            const auto z2 = (z * z) >> 30;
+            auto sum = k_Coefficients[4];
+            for (int i = 3; i >= 0; --i)
+                { sum = k_Coefficients[i] + ((sum * z2) >> 30); }
+            sum = (sum * z) >> 30;
+
+            return quadrant >= 2 ? -sum : sum;
+        }
+
+        // atan of a ratio in [0, 1], with 30 bits of fraction.
+        constexpr int64_t atanQ30(int64_t z)
+        {
+            // Abramowitz and Stegun 4.4.49, good to a few hundred-millionths.
+            constexpr int64_t k_Coefficients[] = {q30(1.0), q30(-0.3333314528), q30(0.1999355085),
+                                                  q30(-0.1420889944), q30(0.1065626393), q30(-0.0752896400),
+                                                  q30(0.0429096138), q30(-0.0161657367), q30(0.0028662257)};
+
+            const auto z2 = (z * z) >> 30;
+            auto sum = k_Coefficients[8];
+            for (int i = 7; i >= 0; --i)
+                { sum = k_Coefficients[i] + ((sum * z2) >> 30); }
+            return (sum * z) >> 30;
+        }
+
+        // The phase, where 2^32 is a full turn, of an angle in radians.
+        template <int I, int F>
+        constexpr uint32_t toPhase(Fixed<I, F> radians)
+        {
+            // 2^34 / 2pi, two bits more than a turn per radian, which is as
+            // much as fits in the product.
+            constexpr auto k_TurnsPerRadian = static_cast<int64_t>(17179869184.0 / 6.283185307179586 + 0.5);
+            return static_cast<uint32_t>((int64_t(radians.raw()) * k_TurnsPerRadian) >> (F + 2));
+        }
+    }
+
+    template <int I, int F>
+    [[ nodiscard ]] constexpr Fixed<I, F> abs(Fixed<I, F> value)
+        { return value < Fixed<I, F>() ? Fixed<I, F>::saturatingSub(Fixed<I, F>(), value) : value; }
+
+    /**
+     * @returns the square root, to the nearest step below, or 0 for anything
+     *     not positive.
+     */
+    template <int I, int F>
+    [[ nodiscard ]] constexpr Fixed<I, F> sqrt(Fixed<I, F> value)
+    {
+        if (value.raw() <= 0)
+            { return {}; }
+        return Fixed<I, F>::fromRaw(static_cast<int32_t>(detail::isqrt(uint64_t(value.raw()) << F)));
+    }
+
+    /**
+     * @returns sqrt(x * x + y * y), without the squares overflowing.
+     */
+    template <int I, int F>
+    [[ nodiscard ]] constexpr Fixed<I, F> hypot(Fixed<I, F> x, Fixed<I, F> y)
+    {
+        const auto ax = uint64_t(x.raw() < 0 ? -int64_t(x.raw()) : x.raw());
+        const auto ay = uint64_t(y.raw() < 0 ? -int64_t(y.raw()) : y.raw());
+        const auto root = detail::isqrt(ax * ax + ay * ay);
+        return Fixed<I, F>::fromRaw(static_cast<int32_t>(std::min<uint64_t>(root, std::numeric_limits<int32_t>::max())));
+    }
+
+    template <int I, int F>
+    [[ nodiscard ]] constexpr Fixed<I, F> sin(Fixed<I, F> radians)
+        { return Fixed<I, F>::fromQ30(detail::sinQ30(detail::toPhase(radians))); }
+
+    template <int I, int F>
+    [[ nodiscard ]] constexpr Fixed<I, F> cos(Fixed<I, F> radians)
+        { return Fixed<I, F>::fromQ30(detail::sinQ30(detail::toPhase(radians) + (uint32_t(1) << 30))); }
+
+    /**
+     * @returns the angle of the point (x, y) from the x axis, in radians
+     *     between -pi and pi.
+     */
+    template <int I, int F>
+    [[ nodiscard ]] constexpr Fixed<I, F> atan2(Fixed<I, F> y, Fixed<I, F> x)
+    {
+        constexpr auto k_Pi = detail::q30(3.14159265358979323846);
+
+        const auto ax = x.raw() < 0 ? -int64_t(x.raw()) : int64_t(x.raw());
+        const auto ay = y.raw() < 0 ? -int64_t(y.raw()) : int64_t(y.raw());
+        if (ax == 0 && ay == 0)
+            { return {}; }
+
+        auto angle = ay <= ax
+            ? detail::atanQ30((ay << 30) / ax)
+            : k_Pi / 2 - detail::atanQ30((ax << 30) / ay);
+        if (x.raw() < 0)
+            { angle = k_Pi - angle; }
+        return Fixed<I, F>::fromQ30(y.raw() < 0 ? -angle : angle);
+    }
+}
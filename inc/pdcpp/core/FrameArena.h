@@ -0,0 +1,156 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "util.h"
+
+namespace pdcpp
+{
+    class FrameArena
+    {
+    public:
+        /**
+         * Running figures for an arena. Allocation counts are since the last
+         * `reset`, the high water mark is for the life of the arena.
+         */
+        struct Stats
+        {
+            size_t capacity = 0;
+            size_t bytesInUse = 0;
+            size_t highWaterMark = 0;
+            uint32_t allocations = 0;
+            uint32_t heapFallbacks = 0;
+        };
+
+        /**
+         * A bump allocator for scratch memory which only needs to live until
+         * the end of the frame. Allocating is a pointer increment, freeing is
+         * a no-op (except for the most recent allocation, which is given
+         * back), and `reset` reclaims everything at once.
+         *
+         * Allocations which don't fit fall back to the heap and are counted as
+         * such in the stats, so an arena that's too small is slow, not broken.
+         * The first fallback after each reset logs a warning, as it usually
+         * means the arena is never being reset.
+         *
+         * Arenas aren't thread safe, don't share one with the audio callbacks.
+         *
+         * @param capacityBytes the size of the arena's single block of memory.
+         */
+        explicit FrameArena(size_t capacityBytes);
+
+        /**
+         * @returns memory for `bytes` bytes aligned to `alignment`, which must
+         *     be a power of 2 no greater than `alignof(std::max_align_t)`.
+         */
+        [[ nodiscard ]] void* allocate(size_t bytes, size_t alignment=alignof(std::max_align_t));
+
+        /**
+         * Returns memory to the arena. Only the most recent allocation is
+         * actually reclaimed before a reset, anything that came from the heap
+         * is freed.
+         */
+        void deallocate(void* ptr, size_t bytes);
+
+        /**
+         * Reclaims every allocation at once. Anything still using memory from
+         * the arena is left dangling, so call this where nothing is, like at
+         * the very end of your update.
+         */
+        void reset();
+
+        /**
+         * @returns true if the pointer lies within the arena's block.
+         */
+        [[ nodiscard ]] bool owns(const void* ptr) const;
+
+        [[ nodiscard ]] const Stats& getStats() const { return m_Stats; }
+
+        /**
+         * @returns the arena the library uses for its own per-call scratch
+         *     containers. Reset it once a frame with `resetDefault`.
+         */
+        static FrameArena& getDefault();
+
+        /**
+         * Resets the default arena. Call this at the end of every update.
+         */
+        static void resetDefault() { getDefault().reset(); }
+
+        /**
+         * @returns the number of allocations which haven't been given back
+         *     yet. Unlike the stats, this isn't cleared by `reset`.
+         */
+        [[ nodiscard ]] uint32_t getNumLive() const { return m_Live; }
+
+        /**
+         * Replaces the default arena with a new one of the given size. This
+         * is refused while anything still holds memory from the current one,
+         * as that would be left pointing at freed memory.
+         *
+         * @returns true if the arena was replaced.
+         */
+        static bool setDefaultCapacity(size_t capacityBytes);
+
+        static constexpr size_t k_DefaultCapacity = 16 * 1024;
+
+    private:
+        std::unique_ptr<std::byte[]> p_Block;
+        size_t m_Capacity;
+        size_t m_Offset = 0;
+        size_t m_LastOffset = 0;
+        uint32_t m_Live = 0;
+        bool m_HasWarned = false;
+        Stats m_Stats;
+
+        PDCPP_DECLARE_NON_COPYABLE_NON_MOVABLE(FrameArena);
+    };
+
+    /**
+     * A standard allocator which draws from a `FrameArena`, the default one
+     * unless told otherwise. Containers using it must not outlive the frame.
+     *
+     * usage:
+     *      pdcpp::ArenaVector<int> scratch;  // memory comes from the default arena
+     */
+    template <typename T>
+    class ArenaAllocator
+    {
+    public:
+        using value_type = T;
+
+        ArenaAllocator() noexcept : p_Arena(&FrameArena::getDefault()) {}
+        explicit ArenaAllocator(FrameArena& arena) noexcept : p_Arena(&arena) {}
+
+        template <typename U>
+        ArenaAllocator(const ArenaAllocator<U>& other) noexcept : p_Arena(other.getArena()) {} // NOLINT (*-explicit-constructor)
+
+        [[ nodiscard ]] T* allocate(size_t n)
+            { return static_cast<T*>(p_Arena->allocate(n * sizeof(T), alignof(T))); }
+
+        void deallocate(T* ptr, size_t n) noexcept { p_Arena->deallocate(ptr, n * sizeof(T)); }
+
+        [[ nodiscard ]] FrameArena* getArena() const noexcept { return p_Arena; }
+
+        template <typename U>
+        bool operator==(const ArenaAllocator<U>& other) const noexcept { return p_Arena == other.getArena(); }
+
+    private:
+        FrameArena* p_Arena;
+    };
+
+    template <typename T>
+    using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+}
@@ -0,0 +1,65 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace pdcpp
+{
+    /**
+     * Measures the time spent on some piece of a frame's work against a
+     * budget, for things like the `TaskScheduler` which do as much as they
+     * can each frame and leave the rest for the next.
+     *
+     * It keeps its own start time, rather than relying on the profiler's
+     * clock or the system's elapsed time, both of which other code can reset.
+     * The millisecond clock is the authority, and the elapsed time is only
+     * used for the fraction of a millisecond, while it agrees with it. Both
+     * are read from the uninterposed API, so a budget still runs out while an
+     * `InputPlayer` is replaying recorded time.
+     *
+     * usage:
+     *      m_Budget.start();
+     *      while (hasWork() && !m_Budget.isSpent())
+     *          { doSomeWork(); }
+     */
+    class FrameBudget
+    {
+    public:
+        /**
+         * @param budgetMs how long the work may take each frame.
+         */
+        explicit FrameBudget(float budgetMs);
+
+        /**
+         * Starts measuring, call it at the start of each frame's work.
+         */
+        void start();
+
+        /**
+         * @returns the time since `start`, in microseconds.
+         */
+        [[ nodiscard ]] uint32_t getElapsedUs() const;
+
+        /**
+         * @returns true if the time since `start` has reached the budget.
+         */
+        [[ nodiscard ]] bool isSpent() const { return getElapsedUs() >= m_BudgetUs; }
+
+        void setBudget(float budgetMs);
+        [[ nodiscard ]] float getBudget() const { return static_cast<float>(m_BudgetUs) / 1000.0f; }
+
+    private:
+        uint32_t m_BudgetUs = 0;
+        uint32_t m_StartMs = 0;
+        float m_StartSeconds = 0.0f;
+    };
+}
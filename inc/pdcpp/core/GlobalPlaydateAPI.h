@@ -10,10 +10,13 @@
 
 #pragma once
 #include <pd_api.h>
+#include <memory>
 #include "util.h"
 
 namespace pdcpp
 {
+    class ApiTracer;
+
     /**
      * This class allows for global access to the underlying Playdate C API
      * without having to pass it around to every single object. This class
@@ -28,10 +31,16 @@ namespace pdcpp
          * already exist. This should be called in the init section of the
          * `eventShim` and nowhere else.
          *
+         * When tracing, every call made through `get()` is counted and timed
+         * by an `ApiTracer` sitting between the library and the C API. It's
+         * meant for finding redundant calls, and adds overhead to every call,
+         * so leave it off in release builds.
+         *
          * @param pd_api A pointer to the `PlaydateAPI` object
+         * @param traceApiCalls optionally trace calls made through `get()`
          * @return
          */
-        static GlobalPlaydateAPI* initialize(PlaydateAPI* pd_api);
+        static GlobalPlaydateAPI* initialize(PlaydateAPI* pd_api, bool traceApiCalls=false);
 
         /**
          * This is the method that you'll probably call the most from this
@@ -42,6 +51,31 @@ namespace pdcpp
          */
         inline static PlaydateAPI* get() { return instance->pd; };
 
+        /**
+         * @return the tracer installed by `initialize`, or nullptr if calls
+         *     aren't being traced.
+         */
+        static ApiTracer* getTracer();
+
+        /**
+         * Routes every call made through `get()` to another API, usually a
+         * copy of the current one with a few functions replaced, as the
+         * `InputPlayer` does. Restore the previous API, which is returned,
+         * when done, and undo interpositions in the reverse order.
+         *
+         * @param api the API to use in place of the current one.
+         * @return the API which was in use.
+         */
+        static PlaydateAPI* interpose(PlaydateAPI* api);
+
+        /**
+         * @return the API as it was before anything was interposed. Use it to
+         *     measure how long things really take, as an `InputPlayer`
+         *     replaying recorded time holds `getCurrentTimeMilliseconds` still
+         *     for the whole frame.
+         */
+        inline static PlaydateAPI* getUninterposed() { return instance->p_Uninterposed; }
+
         /**
          * Destroys the underlying instance. Must be called in the terminate
          * section of of the `eventShim` and nowhere else.
@@ -54,9 +88,12 @@ namespace pdcpp
          * @param pd_api a pointer to the Playdate C API struct.
          */
         explicit GlobalPlaydateAPI(PlaydateAPI* pd_api);
+        ~GlobalPlaydateAPI();
 
         static GlobalPlaydateAPI* instance;
+        std::unique_ptr<ApiTracer> p_Tracer;
         PlaydateAPI* pd;
+        PlaydateAPI* p_Uninterposed;
 
         PDCPP_DECLARE_NON_COPYABLE_NON_MOVABLE(GlobalPlaydateAPI);
     };
@@ -0,0 +1,206 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace pdcpp
+{
+    /**
+     * The default capacity of an `InplaceFunction`, in bytes: room for a lambda
+     * which captures `this` and a few more pointers or numbers. It's a fixed
+     * size rather than a count of pointers, so whatever fits on the host fits
+     * on the device too.
+     */
+    inline constexpr size_t k_InplaceFunctionCapacity = 32;
+
+    template <typename Signature, size_t Capacity=k_InplaceFunctionCapacity>
+    class InplaceFunction;
+
+    namespace detail
+    {
+        template <typename Fn>
+        inline constexpr bool isStdFunction = false;
+
+        template <typename Sig>
+        inline constexpr bool isStdFunction<std::function<Sig>> = true;
+    }
+
+    /**
+     * A callable wrapper like `std::function`, except that what it wraps is
+     * always stored inside it, in `Capacity` bytes, so it never allocates.
+     * Wrapping a callable which doesn't fit is a compile error, rather than a
+     * hidden trip to the heap; capture less, capture a pointer to the state
+     * instead, or raise the capacity.
+     *
+     * Callables which are trivially copyable, like most lambdas capturing
+     * references, pointers, and numbers, are copied and moved as plain bytes.
+     *
+     * A `std::function` is a callable like any other, so one can still be
+     * passed anywhere an `InplaceFunction` is taken, as long as it fits. It
+     * will allocate just as it did before.
+     *
+     * usage:
+     *      pdcpp::InplaceFunction<void(int)> onScore = [this](int points) { m_Score += points; };
+     *      onScore(10);
+     */
+    template <typename R, typename... Args, size_t Capacity>
+    class InplaceFunction<R(Args...), Capacity>
+    {
+    public:
+        InplaceFunction() = default;
+        InplaceFunction(std::nullptr_t) {}
+
+        /**
+         * Wraps a copy of a callable. Null function pointers and empty
+         * `std::function`s make an empty `InplaceFunction`.
+         */
+        template <typename F, typename Fn=std::decay_t<F>,
+                  typename=std::enable_if_t<!std::is_same_v<Fn, InplaceFunction> && std::is_invocable_r_v<R, Fn&, Args...>>>
+        InplaceFunction(F&& callable)
+        {
+            static_assert(sizeof(Fn) <= Capacity,
+                "The callable doesn't fit in this InplaceFunction. Capture less, or raise its Capacity.");
+            static_assert(alignof(Fn) <= alignof(std::max_align_t), "The callable is over-aligned for an InplaceFunction.");
+            static_assert(std::is_copy_constructible_v<Fn>, "An InplaceFunction's callable must be copyable.");
+
+            if constexpr (std::is_pointer_v<Fn> || std::is_member_pointer_v<Fn> || detail::isStdFunction<Fn>)
+            {
+                if (callable == nullptr)
+                    { return; }
+            }
+
+            ::new (static_cast<void*>(m_Storage)) Fn(std::forward<F>(callable));
+            p_Invoke = &invoke<Fn>;
+            if constexpr (!std::is_trivially_copyable_v<Fn>)
+                { p_Manage = &manage<Fn>; }
+        }
+
+        InplaceFunction(const InplaceFunction& other) { copyFrom(other); }
+        InplaceFunction(InplaceFunction&& other) noexcept { moveFrom(other); }
+        ~InplaceFunction() { reset(); }
+
+        InplaceFunction& operator=(const InplaceFunction& other)
+        {
+            if (this != &other)
+            {
+                reset();
+                copyFrom(other);
+            }
+            return *this;
+        }
+
+        InplaceFunction& operator=(InplaceFunction&& other) noexcept
+        {
+            if (this != &other)
+            {
+                reset();
+                moveFrom(other);
+            }
+            return *this;
+        }
+
+        InplaceFunction& operator=(std::nullptr_t)
+        {
+            reset();
+            return *this;
+        }
+
+        /**
+         * Calls the wrapped callable, which must not be empty.
+         */
+        R operator()(Args... args) const
+        {
+            assert(p_Invoke != nullptr && "Called an empty InplaceFunction");
+            return p_Invoke(m_Storage, std::forward<Args>(args)...);
+        }
+
+        explicit operator bool() const { return p_Invoke != nullptr; }
+        friend bool operator==(const InplaceFunction& f, std::nullptr_t) { return f.p_Invoke == nullptr; }
+
+        static constexpr size_t k_Capacity = Capacity;
+
+    private:
+        enum class Operation { Copy, Move, Destroy };
+
+        using Invoker = R (*)(void*, Args&&...);
+        using Manager = void (*)(Operation, void* dest, void* source);
+
+        template <typename Fn>
+        static R invoke(void* storage, Args&&... args)
+        {
+            if constexpr (std::is_void_v<R>)
+                { std::invoke(*static_cast<Fn*>(storage), std::forward<Args>(args)...); }
+            else
+                { return std::invoke(*static_cast<Fn*>(storage), std::forward<Args>(args)...); }
+        }
+
+        template <typename Fn>
+        static void manage(Operation op, void* dest, void* source)
+        {
+            switch (op)
+            {
+                case Operation::Copy:
+                    ::new (dest) Fn(*static_cast<const Fn*>(source));
+                    break;
+                case Operation::Move:
+                    ::new (dest) Fn(std::move(*static_cast<Fn*>(source)));
+                    static_cast<Fn*>(source)->~Fn();
+                    break;
+                case Operation::Destroy:
+                    static_cast<Fn*>(dest)->~Fn();
+                    break;
+            }
+        }
+
+        void copyFrom(const InplaceFunction& other)
+        {
+            if (other.p_Manage != nullptr)
+                { other.p_Manage(Operation::Copy, m_Storage, other.m_Storage); }
+            else if (other.p_Invoke != nullptr)
+                { std::memcpy(m_Storage, other.m_Storage, Capacity); }
+
+            p_Invoke = other.p_Invoke;
+            p_Manage = other.p_Manage;
+        }
+
+        void moveFrom(InplaceFunction& other)
+        {
+            if (other.p_Manage != nullptr)
+                { other.p_Manage(Operation::Move, m_Storage, other.m_Storage); }
+            else if (other.p_Invoke != nullptr)
+                { std::memcpy(m_Storage, other.m_Storage, Capacity); }
+
+            p_Invoke = std::exchange(other.p_Invoke, nullptr);
+            p_Manage = std::exchange(other.p_Manage, nullptr);
+        }
+
+        void reset()
+        {
+            if (p_Manage != nullptr)
+                { p_Manage(Operation::Destroy, m_Storage, nullptr); }
+            p_Invoke = nullptr;
+            p_Manage = nullptr;
+        }
+
+        // Mutable, as std::function, so that `operator()` can be const while
+        // still calling mutable lambdas.
+        alignas(std::max_align_t) mutable std::byte m_Storage[Capacity];
+        Invoker p_Invoke = nullptr;
+        Manager p_Manage = nullptr;
+    };
+}
@@ -12,6 +12,7 @@
 #include <deque>
 #include <pdcpp/core/ButtonManager.h>
 #include "CrankManager.h"
+#include "InputQueue.h"
 #include <pdcpp/core/util.h>
 
 namespace pdcpp
@@ -55,6 +56,16 @@ namespace pdcpp
          */
         [[ nodiscard ]] virtual bool wantsCrankBeforeButtons() const { return false; };
 
+        /**
+         * Called by a context manager dispatching from an `InputQueue`, for
+         * each input event in the order they happened, just before the usual
+         * `buttonStateChanged` or `crankStateChanged` call for the same event.
+         * Override it for the event's timestamp.
+         *
+         * @param event the input event, with the system time it happened.
+         */
+        virtual void inputEventReceived(const pdcpp::InputEvent& /*event*/) {}
+
     protected:
         /**
          * Allows for cascading context ownership. Use this to push a context
@@ -98,6 +109,29 @@ namespace pdcpp
          */
         void update();
 
+        /**
+         * Dispatches input from a queue rather than polling, so each button
+         * press and release, and each crank movement, reaches the context
+         * separately and in the order it happened, even if several happened
+         * in one frame. `wantsCrankBeforeButtons` has no effect while a queue
+         * is in use, as the events are already in order.
+         *
+         * Each button event is delivered as a `buttonStateChanged` with one
+         * button pressed or released. In frames with no button events, a held
+         * button is still reported once, as when polling. After the queue is
+         * drained, any button the system disagrees about, because its event
+         * was dropped or it was held before the queue was used, is reported
+         * in one more `buttonStateChanged`.
+         *
+         * The manager polls the queue in `update`, but doesn't attach it.
+         *
+         * @param queue the queue to dispatch from, or nullptr to go back to
+         *     polling.
+         */
+        void useInputQueue(InputQueue* queue);
+
+        [[ nodiscard ]] InputQueue* getInputQueue() const { return p_Queue; }
+
         /**
          * Push a new context onto the stack. The previous context will be
          * notified its context has exited, and the new context will be notified
@@ -133,6 +167,10 @@ namespace pdcpp
         [[ nodiscard ]] InputContext* getCurrentContext() const;
 
     private:
+        void dispatchQueuedInput();
+
         std::deque<InputContext*> m_ContextStack;
+        InputQueue* p_Queue = nullptr;
+        int m_QueuedButtons = 0;
     };
 }
@@ -0,0 +1,158 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+#include <pd_api.h>
+#include "util.h"
+
+namespace pdcpp
+{
+    /**
+     * A single change in the input, and when it happened.
+     */
+    struct InputEvent
+    {
+        enum class Type : uint8_t
+        {
+            ButtonPressed,
+            ButtonReleased,
+            CrankMoved
+        };
+
+        Type type;
+
+        // System time of the change, in milliseconds, on the same clock as
+        // `getCurrentTimeMilliseconds`.
+        uint32_t timeMs;
+
+        // The one button which changed, for button events.
+        PDButtons button;
+
+        // The crank's absolute angle, and how far it moved, for crank events.
+        float crankAngle;
+        float crankDelta;
+
+        [[ nodiscard ]] bool isButton() const { return type != Type::CrankMoved; }
+    };
+
+    /**
+     * Records button presses and releases, and crank movement, in the order
+     * they happened and with the time they happened, for games which need to
+     * know more than what changed since the last frame. Several presses of a
+     * button between two frames are each recorded, rather than merged.
+     *
+     * Once attached, button events come from the system's button callback,
+     * which timestamps each one to the millisecond. Unattached, `poll` falls
+     * back on the once-per-frame button state, and stamps what it finds with
+     * the time of the poll. The crank has no callback, so its movement is
+     * always recorded by `poll`, once per frame.
+     *
+     * Events are kept in a ring buffer of fixed size, allocated up front. If
+     * it fills up, new events are dropped and counted, so drain it every
+     * frame.
+     *
+     * usage:
+     *      pdcpp::InputQueue input;
+     *      input.attach();
+     *      ...
+     *      // in the update:
+     *      input.poll();
+     *      while (auto event = input.pop())
+     *      {
+     *          if (event->type == pdcpp::InputEvent::Type::ButtonPressed)
+     *              { judge(event->button, event->timeMs - songStartMs); }
+     *      }
+     */
+    class InputQueue
+    {
+    public:
+        /**
+         * @param capacity the most events the queue can hold.
+         */
+        explicit InputQueue(size_t capacity=k_DefaultCapacity);
+        ~InputQueue();
+
+        /**
+         * Installs this queue as the system's button callback. Only one queue
+         * can be attached at a time, and attaching one detaches any other.
+         */
+        void attach();
+
+        /**
+         * Removes the button callback, if this queue installed it.
+         */
+        void detach();
+
+        [[ nodiscard ]] bool isAttached() const { return s_Attached == this; }
+
+        /**
+         * Records the crank's movement, and the button changes too if the
+         * queue isn't attached. Call it once per update, before draining the
+         * queue.
+         */
+        void poll();
+
+        /**
+         * Records a button change. Called by the button callback, and useful
+         * for feeding recorded or simulated input.
+         *
+         * @returns false if the queue was full, and the event dropped.
+         */
+        bool pushButton(PDButtons button, bool pressed, uint32_t timeMs);
+
+        /**
+         * Records crank movement.
+         *
+         * @returns false if the queue was full, and the event dropped.
+         */
+        bool pushCrank(float angle, float delta, uint32_t timeMs);
+
+        /**
+         * Removes and returns the oldest event, if there is one.
+         */
+        std::optional<InputEvent> pop();
+
+        /**
+         * @returns the oldest event, without removing it, or nullptr.
+         */
+        [[ nodiscard ]] const InputEvent* peek() const;
+
+        void clear();
+
+        [[ nodiscard ]] size_t size() const { return m_Count; }
+        [[ nodiscard ]] bool empty() const { return m_Count == 0; }
+        [[ nodiscard ]] size_t getCapacity() const { return m_Events.size(); }
+
+        /**
+         * @returns the number of events dropped because the queue was full.
+         */
+        [[ nodiscard ]] uint32_t getNumDropped() const { return m_NDropped; }
+
+        static constexpr size_t k_DefaultCapacity = 64;
+
+    private:
+        static int buttonCallback(PDButtons button, int down, uint32_t when, void* userdata);
+
+        bool push(const InputEvent& event);
+
+        std::vector<InputEvent> m_Events;
+        size_t m_Head = 0;
+        size_t m_Count = 0;
+        uint32_t m_NDropped = 0;
+
+        static InputQueue* s_Attached;
+
+        PDCPP_DECLARE_NON_COPYABLE_NON_MOVABLE(InputQueue);
+    };
+}
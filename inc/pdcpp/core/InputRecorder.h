@@ -0,0 +1,180 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <pd_api.h>
+#include "File.h"
+#include "util.h"
+
+namespace pdcpp
+{
+    class InputSubstitution;
+
+    /**
+     * Everything the game reads about the input in one frame.
+     */
+    struct InputFrame
+    {
+        // The system time at the start of the frame, in milliseconds.
+        uint32_t timeMs = 0;
+
+        PDButtons current = static_cast<PDButtons>(0);
+        PDButtons pressed = static_cast<PDButtons>(0);
+        PDButtons released = static_cast<PDButtons>(0);
+
+        float crankAngle = 0.0f;
+        float crankChange = 0.0f;
+        bool crankDocked = false;
+    };
+
+    /**
+     * Records the input of every frame to a file, for an `InputPlayer` to
+     * play back later, so that exactly the same session can be run on
+     * different builds and their frame times compared.
+     *
+     * Each `update` samples the buttons and crank once, and for the rest of
+     * the frame the system's `getButtonState`, `getCrankChange`,
+     * `getCrankAngle`, and `isCrankDocked` answer with what was sampled, so
+     * the game sees just what was recorded. That covers the `ButtonManager`,
+     * `CrankManager`, and anything which hands their values to a
+     * `ClickCounter`. Button callbacks aren't recorded, so an attached
+     * `InputQueue` won't replay; leave it unattached to have it poll.
+     *
+     * Frames are kept in memory and written a few kilobytes at a time. An idle
+     * frame takes two bytes.
+     *
+     * usage:
+     *      pdcpp::InputRecorder recorder("session.pdir", seed);
+     *      pdcpp::Random random(seed);
+     *      ...
+     *      // first thing in the update:
+     *      recorder.update();
+     */
+    class InputRecorder
+    {
+    public:
+        /**
+         * Starts recording to a file in the game's data folder.
+         *
+         * @param path the file to record to. It's overwritten.
+         * @param seed a number stored with the recording for the game's own
+         *     use, typically the seed of its random number generators, so
+         *     playback can use the same one.
+         */
+        explicit InputRecorder(const std::string& path, uint32_t seed=0);
+        ~InputRecorder();
+
+        /**
+         * Samples this frame's input and records it. Call it first thing in
+         * every update, before anything reads the input.
+         */
+        void update();
+
+        /**
+         * Writes out anything not yet written, closes the file, and gives the
+         * system's input functions back. Called on destruction.
+         */
+        void stop();
+
+        [[ nodiscard ]] bool isRecording() const { return p_File != nullptr; }
+        [[ nodiscard ]] uint32_t getNumFrames() const { return m_NFrames; }
+
+    private:
+        void flush();
+
+        std::unique_ptr<FileHandle> p_File;
+        std::unique_ptr<InputSubstitution> p_Substitution;
+        std::vector<uint8_t> m_Buffer;
+        InputFrame m_Previous;
+        uint32_t m_NFrames = 0;
+
+        PDCPP_DECLARE_NON_COPYABLE_NON_MOVABLE(InputRecorder);
+    };
+
+    /**
+     * Plays back a recording made by an `InputRecorder`. While playing, the
+     * system's button and crank functions answer with the recorded frame
+     * instead of the real input, and by default `getCurrentTimeMilliseconds`
+     * steps through the recorded frame times too, so timers fire on the same
+     * frames as they did when recording. Frame budgets and the profiler keep
+     * to the real clock, so replayed work is spread and measured as it was
+     * live.
+     *
+     * The whole recording is read when the player is made, so playback adds
+     * no file access to the frames being measured. Once the last frame has
+     * played, the real input takes over again.
+     *
+     * usage:
+     *      pdcpp::InputPlayer player("session.pdir");
+     *      pdcpp::Random random(player.getSeed());
+     *      ...
+     *      // first thing in the update:
+     *      if (!player.update())
+     *          { finishBenchmark(); }
+     */
+    class InputPlayer
+    {
+    public:
+        /**
+         * Loads a recording from the game's data folder, or its bundle.
+         *
+         * @param path the recording to play
+         * @param replayTime whether `getCurrentTimeMilliseconds` should replay
+         *     the recorded times, offset to start from now.
+         */
+        explicit InputPlayer(const std::string& path, bool replayTime=true);
+        ~InputPlayer();
+
+        /**
+         * Moves on to the next recorded frame. Call it first thing in every
+         * update, before anything reads the input.
+         *
+         * @return false once the recording has finished, or if it couldn't be
+         *     loaded.
+         */
+        bool update();
+
+        /**
+         * Stops playback, and gives the system's input functions back. Called
+         * on destruction.
+         */
+        void stop();
+
+        [[ nodiscard ]] bool isLoaded() const { return m_Loaded; }
+        [[ nodiscard ]] bool isFinished() const { return m_Offset >= m_Data.size(); }
+        [[ nodiscard ]] uint32_t getSeed() const { return m_Seed; }
+
+        /**
+         * @return the number of frames played so far.
+         */
+        [[ nodiscard ]] uint32_t getFrame() const { return m_NFrames; }
+
+    private:
+        bool readFrame(InputFrame& frame);
+
+        std::unique_ptr<InputSubstitution> p_Substitution;
+        std::vector<uint8_t> m_Data;
+        size_t m_Offset = 0;
+        InputFrame m_Frame;
+        uint32_t m_Seed = 0;
+        uint32_t m_NFrames = 0;
+        uint32_t m_StartMs = 0;
+        uint32_t m_FirstFrameMs = 0;
+        bool m_ReplayTime;
+        bool m_Loaded = false;
+
+        PDCPP_DECLARE_NON_COPYABLE_NON_MOVABLE(InputPlayer);
+    };
+}
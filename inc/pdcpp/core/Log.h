@@ -0,0 +1,298 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "util.h"
+
+/**
+ * Log calls below `PDCPP_LOG_LEVEL` are compiled out entirely, arguments and
+ * all. The `PDCPP_LOG_LEVEL` CMake option sets it for everything linking
+ * against `pdcpp`: 0 for everything, 1 from info up, which is the default, 2
+ * from warnings up, and 3 for errors only. Errors are how the library reports
+ * failures, so they're never compiled out.
+ */
+#ifndef PDCPP_LOG_LEVEL
+    #define PDCPP_LOG_LEVEL 1
+#endif
+
+// The format must be a string literal, as only a pointer to it is kept.
+#define PDCPP_LOG_AT(level, format, ...) \
+    pdcpp::Log::getDefault().write(level, "" format __VA_OPT__(,) __VA_ARGS__)
+
+#if PDCPP_LOG_LEVEL <= 0
+    #define PDCPP_LOG_DEBUG(format, ...) PDCPP_LOG_AT(pdcpp::Log::Level::Debug, format __VA_OPT__(,) __VA_ARGS__)
+#else
+    #define PDCPP_LOG_DEBUG(format, ...) ((void)0)
+#endif
+
+#if PDCPP_LOG_LEVEL <= 1
+    #define PDCPP_LOG_INFO(format, ...) PDCPP_LOG_AT(pdcpp::Log::Level::Info, format __VA_OPT__(,) __VA_ARGS__)
+#else
+    #define PDCPP_LOG_INFO(format, ...) ((void)0)
+#endif
+
+#if PDCPP_LOG_LEVEL <= 2
+    #define PDCPP_LOG_WARNING(format, ...) PDCPP_LOG_AT(pdcpp::Log::Level::Warning, format __VA_OPT__(,) __VA_ARGS__)
+#else
+    #define PDCPP_LOG_WARNING(format, ...) ((void)0)
+#endif
+
+#define PDCPP_LOG_ERROR(format, ...) PDCPP_LOG_AT(pdcpp::Log::Level::Error, format __VA_OPT__(,) __VA_ARGS__)
+
+namespace pdcpp
+{
+    class FileHandle;
+
+    /**
+     * A log which doesn't format anything when it's written to. A log call
+     * copies the pointer to its format string, and its arguments as they
+     * are, into a fixed ring buffer; `flush`, at the end of the frame or
+     * whenever there's time, formats them printf-style and sends them to the
+     * console, and optionally a file.
+     *
+     * Use it through the `PDCPP_LOG_` macros, which compile out below
+     * `PDCPP_LOG_LEVEL`:
+     *
+     *      PDCPP_LOG_WARNING("Couldn't find %s, using %d", path, fallback);
+     *      ...
+     *      // at the end of every update
+     *      pdcpp::Log::getDefault().flush();
+     *
+     * Arguments can be numbers, enums, pointers, C strings, `std::string`s,
+     * and `std::string_view`s. Strings are copied, up to 255 bytes, as they
+     * may not last until the flush. Everything is flushed through
+     * `system->logToConsole`, except errors, which can't wait: they flush
+     * whatever is pending, to keep the order, and go straight to
+     * `system->error` as they're written.
+     *
+     * When the buffer is full, new messages are dropped, and the number
+     * dropped is logged at the next flush.
+     *
+     * The log isn't safe to write to from the audio callback.
+     */
+    class Log
+    {
+    public:
+        enum class Level : uint8_t
+        {
+            Debug,
+            Info,
+            Warning,
+            Error,
+        };
+
+        /**
+         * @param capacity the size of the ring buffer, in bytes.
+         */
+        explicit Log(size_t capacity=k_DefaultCapacity);
+        ~Log();
+
+        /**
+         * Records a message, to be formatted at the next flush, or, for an
+         * error, formats and outputs it now.
+         *
+         * @param level the level of the message
+         * @param format a printf-style format, which must outlive the flush;
+         *     a string literal.
+         */
+        template <typename... Args>
+        void write(Level level, const char* format, const Args&... args)
+        {
+            if (level < m_MinimumLevel)
+                { return; }
+
+            static_assert(sizeof...(Args) <= 255, "Too many arguments for one log message");
+            const size_t size = k_RecordHeaderSize + (0 + ... + getArgumentSize(args));
+            if (level == Level::Error)
+            {
+                std::vector<uint8_t> record(size);
+                writeRecord(record.data(), level, format, args...);
+                writeNow(record.data(), size);
+                return;
+            }
+
+            auto record = beginRecord(size);
+            if (record != nullptr)
+                { writeRecord(record, level, format, args...); }
+        }
+
+        /**
+         * Formats and outputs everything recorded so far.
+         *
+         * @param maxMessages the most to output now, to spread the work of a
+         *     busy frame out.
+         */
+        void flush(size_t maxMessages=std::numeric_limits<size_t>::max());
+
+        /**
+         * Messages below this level are ignored when they're written, on top
+         * of the compile-time `PDCPP_LOG_LEVEL`.
+         */
+        void setMinimumLevel(Level level) { m_MinimumLevel = level; }
+        [[ nodiscard ]] Level getMinimumLevel() const { return m_MinimumLevel; }
+
+        void setConsoleEnabled(bool enabled) { m_ConsoleEnabled = enabled; }
+
+        /**
+         * Also writes flushed messages, a line each, to a file in the data
+         * folder, which is replaced. An empty path stops writing to a file.
+         */
+        void setLogFile(const std::string& path);
+
+        /**
+         * @return how many messages are waiting for the next flush.
+         */
+        [[ nodiscard ]] size_t getNumPending() const { return m_NumPending; }
+
+        /**
+         * @return how many messages have been dropped, over the life of the
+         *     log, for want of room in the buffer.
+         */
+        [[ nodiscard ]] size_t getNumDropped() const { return m_TotalDropped; }
+
+        /**
+         * @return the log the `PDCPP_LOG_` macros write to.
+         */
+        static Log& getDefault();
+
+        static constexpr size_t k_DefaultCapacity = 4096;
+        static constexpr size_t k_MaxLineLength = 256;
+        static constexpr size_t k_MaxStringLength = 255;
+
+    private:
+        enum ArgumentType : uint8_t
+        {
+            Int,
+            Unsigned,
+            Double,
+            Pointer,
+            String,
+        };
+
+        // A record is its format pointer, its level, its argument count, and
+        // then each argument as a type byte followed by its value: 8 bytes
+        // for numbers and pointers, and a length byte and the bytes for
+        // strings.
+        static constexpr size_t k_RecordHeaderSize = sizeof(const char*) + 2;
+
+        static size_t getStringSize(std::string_view s) { return 2 + std::min(s.size(), k_MaxStringLength); }
+
+        template <typename T>
+        static size_t getArgumentSize(const T& arg)
+        {
+            if constexpr (std::is_convertible_v<const T&, std::string_view>)
+                { return getStringSize(toStringView(arg)); }
+            else
+                { return 9; }
+        }
+
+        template <typename T>
+        static std::string_view toStringView(const T& arg)
+        {
+            if constexpr (std::is_convertible_v<const T&, const char*>)
+            {
+                const char* s = arg;
+                return s != nullptr ? std::string_view(s) : std::string_view("(null)");
+            }
+            else
+                { return std::string_view(arg); }
+        }
+
+        template <typename T>
+        static void writeArgument(uint8_t*& out, const T& arg)
+        {
+            if constexpr (std::is_convertible_v<const T&, std::string_view>)
+            {
+                auto s = toStringView(arg);
+                auto length = std::min(s.size(), k_MaxStringLength);
+                *out++ = String;
+                *out++ = uint8_t(length);
+                std::memcpy(out, s.data(), length);
+                out += length;
+            }
+            else if constexpr (std::is_floating_point_v<T>)
+                { writeValue(out, Double, double(arg)); }
+            else if constexpr (std::is_enum_v<T>)
+                { writeArgument(out, static_cast<std::underlying_type_t<T>>(arg)); }
+            else if constexpr (std::is_integral_v<T> && std::is_unsigned_v<T> && !std::is_same_v<T, bool>)
+                { writeValue(out, Unsigned, uint64_t(arg)); }
+            else if constexpr (std::is_integral_v<T>)
+                { writeValue(out, Int, int64_t(arg)); }
+            else
+            {
+                static_assert(std::is_pointer_v<T> || std::is_null_pointer_v<T>,
+                    "Log arguments must be numbers, enums, pointers, or strings");
+                writeValue(out, Pointer, reinterpret_cast<uintptr_t>(static_cast<const void*>(arg)));
+            }
+        }
+
+        template <typename T>
+        static void writeValue(uint8_t*& out, ArgumentType type, T value)
+        {
+            static_assert(sizeof(T) <= 8);
+            *out++ = type;
+            std::memset(out, 0, 8);
+            std::memcpy(out, &value, sizeof(T));
+            out += 8;
+        }
+
+        template <typename... Args>
+        static void writeRecord(uint8_t* record, Level level, const char* format, const Args&... args)
+        {
+            std::memcpy(record, &format, sizeof(format));
+            record[sizeof(format)] = uint8_t(level);
+            record[sizeof(format) + 1] = uint8_t(sizeof...(Args));
+
+            [[ maybe_unused ]] auto out = record + k_RecordHeaderSize;
+            (writeArgument(out, args), ...);
+        }
+
+        // Reserves room for a record, or returns nullptr, and counts a drop,
+        // if there isn't any.
+        uint8_t* beginRecord(size_t size);
+
+        // Flushes everything pending, then formats and outputs the record.
+        void writeNow(const uint8_t* record, size_t size);
+
+        // Formats a record into `m_Line`, and returns its length.
+        size_t formatRecord(const uint8_t* record, size_t size, Level& level);
+
+        void output(Level level, const char* line, size_t length);
+
+        // Records are stored with a two-byte size in front. A size of zero
+        // marks the rest of the buffer as unused, and the next record as
+        // being at the start.
+        std::vector<uint8_t> m_Buffer;
+        size_t m_Head = 0;
+        size_t m_Tail = 0;
+        size_t m_Used = 0;
+        size_t m_NumPending = 0;
+        size_t m_NumDropped = 0;
+        size_t m_TotalDropped = 0;
+
+        Level m_MinimumLevel = Level::Debug;
+        bool m_ConsoleEnabled = true;
+        std::unique_ptr<pdcpp::FileHandle> p_File;
+        std::array<char, k_MaxLineLength> m_Line {};
+
+        PDCPP_DECLARE_NON_COPYABLE_NON_MOVABLE(Log);
+    };
+}
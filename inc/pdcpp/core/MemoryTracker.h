@@ -0,0 +1,174 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "util.h"
+
+namespace pdcpp
+{
+    /**
+     * The subsystems memory is accounted to. Allocations made outside of any
+     * `ScopedMemoryTag` count as `General`.
+     */
+    enum class MemoryTag : uint8_t
+    {
+        General,
+        Graphics,
+        Audio,
+        Components,
+        Files,
+        NumTags
+    };
+
+    class MemoryTracker
+    {
+    public:
+        /**
+         * What's known about the memory owned by one tag. Allocation counts
+         * for the frame are cleared by `endFrame`, everything else since the
+         * last `resetStats`.
+         */
+        struct TagStats
+        {
+            size_t bytesInUse = 0;
+            size_t highWaterMark = 0;
+            size_t budget = 0;
+            uint32_t allocations = 0;
+            uint32_t frees = 0;
+            uint32_t frameAllocations = 0;
+        };
+
+        /**
+         * Called when an allocation takes a tag over its budget, with the tag
+         * and the bytes it now has in use.
+         */
+        using BudgetCallback = void (*)(MemoryTag tag, size_t bytesInUse);
+
+        /**
+         * Allocates memory accounted to the given tag. Once the
+         * `GlobalPlaydateAPI` has been initialized this goes through
+         * `pd->system->realloc`, before then through `malloc`.
+         *
+         * When the library is built with `PDCPP_TRACK_ALLOCATIONS`, the global
+         * `operator new` and `operator delete` come here too, with the tag of
+         * the innermost `ScopedMemoryTag`.
+         *
+         * @returns the memory, or nullptr if there isn't enough.
+         */
+        [[ nodiscard ]] static void* allocate(size_t bytes, MemoryTag tag);
+
+        /**
+         * As `allocate`, for memory aligned to more than
+         * `alignof(std::max_align_t)`. This backs the aligned forms of
+         * `operator new`.
+         *
+         * @param alignment a power of 2.
+         */
+        [[ nodiscard ]] static void* allocate(size_t bytes, size_t alignment, MemoryTag tag);
+
+        /**
+         * Frees memory from either `allocate`, crediting the tag it was
+         * allocated under. Anything else is a bug, and asserts.
+         */
+        static void deallocate(void* ptr);
+
+        /**
+         * @returns the stats for a single tag.
+         */
+        [[ nodiscard ]] static const TagStats& getStats(MemoryTag tag);
+
+        /**
+         * @returns the stats for every tag summed together. The high water
+         *     mark is of the total, not the sum of each tag's.
+         */
+        [[ nodiscard ]] static const TagStats& getTotalStats();
+
+        /**
+         * @returns a short, human readable name for the tag.
+         */
+        [[ nodiscard ]] static const char* getTagName(MemoryTag tag);
+
+        /**
+         * Sets the most a tag should have in use at once. 0, the default,
+         * means no budget.
+         */
+        static void setBudget(MemoryTag tag, size_t bytes);
+
+        /**
+         * Sets a function to call whenever a tag goes over its budget, which
+         * is a good place for a breakpoint, or a failed test.
+         */
+        static void setBudgetCallback(BudgetCallback callback);
+
+        /**
+         * @returns true if the tag's high water mark has ever exceeded its
+         *     budget since the last `resetStats`.
+         */
+        [[ nodiscard ]] static bool hasExceededBudget(MemoryTag tag);
+
+        /**
+         * @returns true if any tag has exceeded its budget.
+         */
+        [[ nodiscard ]] static bool hasExceededAnyBudget();
+
+        /**
+         * Clears the per-frame allocation counts. Call it once per update.
+         */
+        static void endFrame();
+
+        /**
+         * Clears the counts and the high water marks, keeping the budgets and
+         * the bytes currently in use.
+         */
+        static void resetStats();
+
+        /**
+         * @returns the tag new allocations are currently made under.
+         */
+        [[ nodiscard ]] static MemoryTag getCurrentTag();
+
+        /**
+         * Hands the tracker the system's realloc. `GlobalPlaydateAPI` does this
+         * as part of its initialization, there's no need to call it yourself.
+         */
+        static void setSystemRealloc(void* (*systemRealloc)(void*, size_t));
+
+    private:
+        friend class ScopedMemoryTag;
+        static MemoryTag s_CurrentTag;
+    };
+
+    /**
+     * Accounts allocations made by `MemoryTracker`, or by `operator new` when
+     * tracking allocations, to a tag for as long as it's alive. Tags nest,
+     * the innermost wins.
+     *
+     * usage:
+     *      pdcpp::ScopedMemoryTag tag(pdcpp::MemoryTag::Audio);
+     *      m_Samples.resize(n);  // counted as audio
+     */
+    class ScopedMemoryTag
+    {
+    public:
+        explicit ScopedMemoryTag(MemoryTag tag)
+            : m_Previous(MemoryTracker::s_CurrentTag)
+            { MemoryTracker::s_CurrentTag = tag; }
+
+        ~ScopedMemoryTag() { MemoryTracker::s_CurrentTag = m_Previous; }
+
+    private:
+        MemoryTag m_Previous;
+
+        PDCPP_DECLARE_NON_COPYABLE_NON_MOVABLE(ScopedMemoryTag);
+    };
+}
@@ -0,0 +1,240 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "util.h"
+
+/**
+ * Profiling zones are only compiled in when `PDCPP_PROFILING` is defined to a
+ * non-zero value, which the `PDCPP_ENABLE_PROFILER` CMake option does for
+ * everything linking against `pdcpp`. Otherwise `PDCPP_PROFILE_SCOPE`
+ * expands to nothing, and costs nothing.
+ */
+#ifndef PDCPP_PROFILING
+    #define PDCPP_PROFILING 0
+#endif
+
+#define PDCPP_PROFILER_CONCAT_IMPL(a, b) a##b
+#define PDCPP_PROFILER_CONCAT(a, b) PDCPP_PROFILER_CONCAT_IMPL(a, b)
+
+#if PDCPP_PROFILING
+    /**
+     * Measures the time from this line to the end of the enclosing scope, and
+     * adds it to the zone with the given name. The name must be a string
+     * literal, or otherwise outlive the program.
+     */
+    #define PDCPP_PROFILE_SCOPE(name) \
+        static pdcpp::Profiler::Zone PDCPP_PROFILER_CONCAT(pdcpp_profilerZone_, __LINE__)(name); \
+        pdcpp::Profiler::ScopedZone PDCPP_PROFILER_CONCAT(pdcpp_profilerScope_, __LINE__)(PDCPP_PROFILER_CONCAT(pdcpp_profilerZone_, __LINE__))
+
+    /**
+     * As `PDCPP_PROFILE_SCOPE`, for code run from the audio callbacks. These
+     * zones never touch the profiler's own state, so they're safe to use
+     * while the main thread is recording or reading it.
+     */
+    #define PDCPP_PROFILE_AUDIO_SCOPE(name) \
+        static pdcpp::Profiler::AudioZone PDCPP_PROFILER_CONCAT(pdcpp_profilerZone_, __LINE__)(name); \
+        pdcpp::Profiler::ScopedAudioZone PDCPP_PROFILER_CONCAT(pdcpp_profilerScope_, __LINE__)(PDCPP_PROFILER_CONCAT(pdcpp_profilerZone_, __LINE__))
+#else
+    #define PDCPP_PROFILE_SCOPE(name)
+    #define PDCPP_PROFILE_AUDIO_SCOPE(name)
+#endif
+
+namespace pdcpp
+{
+    /**
+     * Collects the time spent in named zones of code, frame by frame. Mark
+     * zones with `PDCPP_PROFILE_SCOPE`, and call `endFrame` once at the end of
+     * every update. The last `k_MaxFrames` frames are kept in a fixed ring
+     * buffer, so recording never allocates.
+     *
+     * Zones measure inclusive time, and a zone entered again while it's
+     * already running (a `Component` redrawing its children, say) is only
+     * counted once, at the outermost level.
+     *
+     * Zones in audio callbacks must use `PDCPP_PROFILE_AUDIO_SCOPE`, which
+     * adds to a pair of atomic counters the profiler collects in `endFrame`.
+     * The audio runs alongside the game, so their per-frame figures are
+     * approximate.
+     *
+     * IMPORTANT: with the default clock, `endFrame` calls
+     * `pd->system->resetElapsedTime`, so `getElapsedTime` only measures from
+     * the last `endFrame` while the profiler is in use. Give the profiler a
+     * clock of its own with `setTimeSource` if you need elapsed time too.
+     */
+    class Profiler
+    {
+    public:
+        static constexpr int k_MaxZones = 32;
+        static constexpr int k_MaxFrames = 64;
+        static constexpr int k_MaxAudioZones = 8;
+
+        /**
+         * A named region of code. Zones register themselves with the profiler
+         * the first time they're constructed, and there is room for
+         * `k_MaxZones` of them. Any more are silently ignored.
+         */
+        class Zone
+        {
+        public:
+            explicit Zone(const char* name);
+
+            [[ nodiscard ]] const char* getName() const { return p_Name; }
+
+        private:
+            friend class Profiler;
+            const char* p_Name;
+            int m_Index;
+            int m_Depth = 0;
+
+            PDCPP_DECLARE_NON_COPYABLE_NON_MOVABLE(Zone);
+        };
+
+        /**
+         * Times a zone from construction to destruction.
+         */
+        class ScopedZone
+        {
+        public:
+            explicit ScopedZone(Zone& zone);
+            ~ScopedZone();
+
+        private:
+            Zone& r_Zone;
+            uint32_t m_Start;
+
+            PDCPP_DECLARE_NON_COPYABLE_NON_MOVABLE(ScopedZone);
+        };
+
+        /**
+         * A zone for the audio context. It adds up its time and calls in
+         * atomics, and the main thread registers it as an ordinary zone and
+         * moves its figures into the frame in `endFrame`. There's room for
+         * `k_MaxAudioZones` of them.
+         */
+        class AudioZone
+        {
+        public:
+            explicit AudioZone(const char* name);
+
+            [[ nodiscard ]] const char* getName() const { return p_Name; }
+
+        private:
+            friend class Profiler;
+            const char* p_Name;
+            int m_Index = -1;
+            int m_Depth = 0;
+            std::atomic<uint32_t> m_PendingUs = 0;
+            std::atomic<uint32_t> m_PendingCalls = 0;
+
+            PDCPP_DECLARE_NON_COPYABLE_NON_MOVABLE(AudioZone);
+        };
+
+        /**
+         * Times an audio zone from construction to destruction. A measurement
+         * which spans the default clock being reset is dropped.
+         */
+        class ScopedAudioZone
+        {
+        public:
+            explicit ScopedAudioZone(AudioZone& zone);
+            ~ScopedAudioZone();
+
+        private:
+            AudioZone& r_Zone;
+            uint32_t m_Start;
+
+            PDCPP_DECLARE_NON_COPYABLE_NON_MOVABLE(ScopedAudioZone);
+        };
+
+        /**
+         * Summary of a zone over the frames held by the profiler, in
+         * microseconds per frame. Frames in which the zone wasn't entered
+         * count as 0.
+         */
+        struct Stats
+        {
+            const char* name = nullptr;
+            uint32_t minUs = 0;
+            uint32_t avgUs = 0;
+            uint32_t maxUs = 0;
+            float avgCalls = 0.0f;
+        };
+
+        /**
+         * A function returning a monotonic time in microseconds. Wrapping is
+         * fine, only differences are used.
+         */
+        using TimeSource = uint32_t (*)();
+
+        /**
+         * Closes the current frame and stores it in the history. Call it once
+         * per update, after everything you want measured.
+         *
+         * With the default clock this resets the system's elapsed time.
+         */
+        static void endFrame();
+
+        /**
+         * Clears the history, and the frame in progress.
+         */
+        static void reset();
+
+        /**
+         * Replaces the clock used to time zones and frames. By default the
+         * profiler uses `pd->system->getElapsedTime`, which can be swapped for
+         * a hardware cycle counter or, off-device, a high resolution clock.
+         * Pass `nullptr` to return to the default. Audio zones call it from
+         * the audio context.
+         *
+         * The default clock calls `resetElapsedTime` at the end of every
+         * frame to keep its precision, so don't rely on elapsed time
+         * elsewhere while profiling with it.
+         */
+        static void setTimeSource(TimeSource source);
+
+        /**
+         * @returns the current time from the profiler's clock, in
+         *     microseconds.
+         */
+        static uint32_t now();
+
+        /**
+         * @returns the number of zones registered so far.
+         */
+        [[ nodiscard ]] static int getNumZones();
+
+        /**
+         * @returns the stats for the nth registered zone over the last
+         *     `nFrames` frames, or all the frames held if 0.
+         */
+        [[ nodiscard ]] static Stats getZoneStats(int zoneIndex, int nFrames=0);
+
+        /**
+         * @returns the stats for the full frame, measured from one `endFrame`
+         *     call to the next.
+         */
+        [[ nodiscard ]] static Stats getFrameStats(int nFrames=0);
+
+        /**
+         * @returns the number of complete frames currently held, up to
+         *     `k_MaxFrames`.
+         */
+        [[ nodiscard ]] static int getNumFrames();
+
+    private:
+        static void record(Zone& zone, uint32_t elapsedUs);
+        static void collectAudioZones();
+    };
+}
@@ -10,15 +10,25 @@
 
 #pragma once
 
+#include <cstdint>
+#include <limits>
+#include <span>
+
 namespace pdcpp
 {
     /**
-     * A Simple Random number generator that can isolate instances of the C
-     * standard library's `rand` and `srand` functions. Limited randomness.
+     * A small, fast random number generator, xoshiro128**, with 128 bits of
+     * state and no shared global state, so instances don't disturb each
+     * other, or `rand`. Satisfies `std::uniform_random_bit_generator`, so it
+     * can drive the standard distributions and `std::shuffle` too.
+     *
+     * Not suitable for anything cryptographic.
      */
     class Random
     {
     public:
+        using result_type = uint32_t;
+
         /**
          * Make a new random number generator. Will seed from the current
          * device time.
@@ -26,16 +36,62 @@ namespace pdcpp
         Random();
 
         /**
-         * Make a new random number generator with an explicit seed.
+         * Make a new random number generator with an explicit seed. The same
+         * seed always gives the same sequence.
          * @param seed the new seed to use
          */
         explicit Random(unsigned int seed);
 
+        /**
+         * Restarts the sequence from a new seed.
+         */
+        void setSeed(unsigned int seed);
+
         /**
          * Generate a new random number
-         * @return an unsigned random integer
+         * @return an unsigned random integer, using all 32 bits
+         */
+        unsigned int next()
+        {
+            const auto result = rotl(m_State[1] * 5, 7) * 9;
+            const auto t = m_State[1] << 9;
+
+            m_State[2] ^= m_State[0];
+            m_State[3] ^= m_State[1];
+            m_State[1] ^= m_State[2];
+            m_State[0] ^= m_State[3];
+            m_State[2] ^= t;
+            m_State[3] = rotl(m_State[3], 11);
+
+            return result;
+        }
+
+        result_type operator()() { return next(); }
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+        /**
+         * Generates an unbiased random integer below a bound, without a
+         * division in all but the rarest cases.
+         *
+         * @param bound one more than the largest value wanted
+         * @return a random integer in [0, bound), or 0 if bound is 0
+         */
+        uint32_t nextInt(uint32_t bound);
+
+        /**
+         * Generates an unbiased random integer between two values.
+         *
+         * @param minValue the smallest value wanted
+         * @param maxValue the largest value wanted
+         * @return a random integer in [minValue, maxValue]
          */
-        unsigned int next();
+        int32_t nextIntInRange(int32_t minValue, int32_t maxValue);
+
+        /**
+         * @return a random float in [0, 1)
+         */
+        float nextFloat() { return static_cast<float>(next() >> 8) * 0x1.0p-24f; }
 
         /**
          * Generates a random floating-point number between a minimum and
@@ -45,10 +101,46 @@ namespace pdcpp
          * @param maxValue the maximum value of the number
          * @return a random float within the range
          */
-        float nextFloatInRange(float minValue, float maxValue);
+        float nextFloatInRange(float minValue, float maxValue) { return nextFloat() * (maxValue - minValue) + minValue; }
+
+        /**
+         * @return true or false, with even odds.
+         */
+        bool nextBool() { return (next() >> 31) != 0; }
+
+        /**
+         * Fills a buffer with raw random bits, for noise and the like.
+         */
+        void fill(std::span<uint32_t> values);
+
+        /**
+         * Fills a buffer with random floats in [minValue, maxValue).
+         */
+        void fill(std::span<float> values, float minValue=0.0f, float maxValue=1.0f);
+
+        /**
+         * Fills a buffer with random integers in [minValue, maxValue].
+         */
+        void fill(std::span<int32_t> values, int32_t minValue, int32_t maxValue);
+
+        /**
+         * Advances the sequence by 2^64 numbers. Copying a generator and
+         * jumping the copy gives a second, independent stream, good for up to
+         * 2^64 numbers before it meets the first.
+         */
+        void jump();
+
+        /**
+         * Advances the sequence by 2^96 numbers, for making independent
+         * generators which can each `jump` to make streams of their own.
+         */
+        void longJump();
 
     private:
-        unsigned int seed;
-    };
+        static constexpr uint32_t rotl(uint32_t x, int k) { return (x << k) | (x >> (32 - k)); }
 
+        void jumpBy(const uint32_t (&polynomial)[4]);
+
+        uint32_t m_State[4];
+    };
 }
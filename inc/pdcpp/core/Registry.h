@@ -0,0 +1,233 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "SparseMap.h"
+#include "SparseSet.h"
+#include "util.h"
+
+namespace pdcpp
+{
+    /**
+     * An entity is nothing but an ID, the components attached to it in a
+     * `Registry` are what give it meaning.
+     *
+     * The low bits are an index, which is reused once the entity is
+     * destroyed, and the high bits a version, which is bumped every time it
+     * is, so a handle to a destroyed entity never refers to the one which
+     * took its place.
+     */
+    using Entity = uint32_t;
+
+    /**
+     * Stores components by type, one pool per type, where each pool keeps its
+     * components packed in a single contiguous array. Systems then run over
+     * `view`s of the entities which have every component they're interested
+     * in, which is a tight loop over a few arrays, rather than a virtual call
+     * for every object in the game.
+     *
+     * usage:
+     *      pdcpp::Registry registry;
+     *      auto ball = registry.create();
+     *      registry.emplace<Velocity>(ball, 1.0f, 0.5f);
+     *      registry.emplace<pdcpp::Transform>(ball, 200.0f, 120.0f);
+     *
+     *      registry.view<pdcpp::Transform, Velocity>().each([](auto e, auto& t, auto& v)
+     *      {
+     *          t.x += v.dx;
+     *          t.y += v.dy;
+     *      });
+     */
+    class Registry
+    {
+    public:
+        /**
+         * Components are keyed by the entity's index, without its version,
+         * which keeps the pools' sparse arrays small.
+         */
+        template <typename T>
+        using Pool = SparseMap<Entity, T>;
+
+        static constexpr uint32_t k_IndexBits = 20;
+        static constexpr Entity k_IndexMask = (Entity(1) << k_IndexBits) - 1;
+        static constexpr uint32_t k_MaxEntities = uint32_t(1) << k_IndexBits;
+
+        [[ nodiscard ]] static constexpr Entity indexOf(Entity entity) { return entity & k_IndexMask; }
+        [[ nodiscard ]] static constexpr uint32_t versionOf(Entity entity) { return entity >> k_IndexBits; }
+
+        /**
+         * Iterates over the entities which have every one of the component
+         * types, smallest pool first. Adding or removing those components
+         * while iterating isn't allowed.
+         */
+        template <typename... Ts>
+        class View
+        {
+        public:
+            View(const Registry& registry, Pool<Ts>&... pools) : r_Registry(registry), m_Pools(pools...) {}
+
+            /**
+             * Calls `fn(entity, components...)` for each entity in the view.
+             */
+            template <typename Fn>
+            void each(Fn&& fn)
+            {
+                auto withEntity = [&](Entity index, auto&... components)
+                    { fn(r_Registry.entityAt(index), components...); };
+                std::apply([&](auto&... pools) { pdcpp::intersect(withEntity, pools...); }, m_Pools);
+            }
+
+        private:
+            const Registry& r_Registry;
+            std::tuple<Pool<Ts>&...> m_Pools;
+        };
+
+        Registry() = default;
+
+        /**
+         * @returns a new entity with no components. The indices of destroyed
+         *     entities are reused, with a new version.
+         */
+        [[ nodiscard ]] Entity create();
+
+        /**
+         * Destroys the entity along with all of its components. Does nothing
+         * if it's already been destroyed.
+         */
+        void destroy(Entity entity);
+
+        /**
+         * @returns false if the entity has been destroyed, even if its index
+         *     has since been reused.
+         */
+        [[ nodiscard ]] bool isAlive(Entity entity) const
+        {
+            auto index = indexOf(entity);
+            return m_Alive.has(index) && m_Versions[index] == versionOf(entity);
+        }
+
+        /**
+         * @returns the number of living entities.
+         */
+        [[ nodiscard ]] size_t size() const { return m_Alive.size(); }
+
+        /**
+         * Destroys every entity and component. The pools themselves stay, as
+         * do the versions, so handles from before are still seen as dead.
+         */
+        void clear();
+
+        /**
+         * Constructs a component on the entity, which must be alive,
+         * replacing the one it already has of the same type.
+         *
+         * @returns the component.
+         */
+        template <typename T, typename... Args>
+        T& emplace(Entity entity, Args&&... args)
+        {
+            assert(isAlive(entity));
+            return pool<T>().emplace(indexOf(entity), std::forward<Args>(args)...);
+        }
+
+        /**
+         * Removes a component from the entity.
+         *
+         * @returns true if the entity had one.
+         */
+        template <typename T>
+        bool remove(Entity entity) { return isAlive(entity) && pool<T>().erase(indexOf(entity)); }
+
+        template <typename T>
+        [[ nodiscard ]] bool has(Entity entity) { return isAlive(entity) && pool<T>().has(indexOf(entity)); }
+
+        /**
+         * @returns the entity's component, which it must have.
+         */
+        template <typename T>
+        [[ nodiscard ]] T& get(Entity entity)
+        {
+            assert(isAlive(entity));
+            return pool<T>().get(indexOf(entity));
+        }
+
+        /**
+         * @returns the entity's component, or nullptr if it doesn't have one,
+         *     or has been destroyed.
+         */
+        template <typename T>
+        [[ nodiscard ]] T* tryGet(Entity entity) { return isAlive(entity) ? pool<T>().find(indexOf(entity)) : nullptr; }
+
+        /**
+         * @returns the pool of components of the given type, creating it if
+         *     need be.
+         */
+        template <typename T>
+        [[ nodiscard ]] Pool<T>& pool()
+        {
+            auto id = typeId<T>();
+            if (id >= m_Pools.size())
+                { m_Pools.resize(id + 1); }
+            if (m_Pools[id] == nullptr)
+                { m_Pools[id] = std::make_unique<TypedPool<T>>(); }
+            return static_cast<TypedPool<T>*>(m_Pools[id].get())->components;
+        }
+
+        /**
+         * @returns a view over the entities with all of the component types.
+         */
+        template <typename... Ts>
+        [[ nodiscard ]] View<Ts...> view() { return View<Ts...>(*this, pool<Ts>()...); }
+
+    private:
+        static constexpr uint32_t k_VersionMask = (uint32_t(1) << (32 - k_IndexBits)) - 1;
+
+        [[ nodiscard ]] Entity entityAt(Entity index) const { return index | (Entity(m_Versions[index]) << k_IndexBits); }
+
+        // Type erasure just deep enough to destroy an entity's components
+        // without knowing their types.
+        struct PoolBase
+        {
+            virtual ~PoolBase() = default;
+            virtual void erase(Entity entity) = 0;
+            virtual void clear() = 0;
+        };
+
+        template <typename T>
+        struct TypedPool
+            : public PoolBase
+        {
+            void erase(Entity entity) override { components.erase(entity); }
+            void clear() override { components.clear(); }
+            Pool<T> components;
+        };
+
+        // Hands out a small, dense index for each component type, without
+        // RTTI.
+        static size_t nextTypeId() { static size_t next = 0; return next++; }
+
+        template <typename T>
+        static size_t typeId() { static const size_t id = nextTypeId(); return id; }
+
+        // The indices of the living entities, and the current version of
+        // every index which has been handed out.
+        SparseSet<Entity> m_Alive;
+        std::vector<uint16_t> m_Versions;
+        std::vector<Entity> m_FreeIds;
+        std::vector<std::unique_ptr<PoolBase>> m_Pools;
+
+        PDCPP_DECLARE_NON_COPYABLE(Registry);
+    };
+}
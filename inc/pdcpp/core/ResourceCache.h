@@ -0,0 +1,262 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include "util.h"
+
+namespace pdcpp
+{
+    class Image;
+    class ImageTable;
+    class Font;
+    class AudioSample;
+
+    /**
+     * The bytes of memory a resource holds, as counted against a
+     * `ResourceCache`'s budget: an image's rows times its height, doubled
+     * for a mask, the sum of a table's images, and a sample's data. Fonts
+     * don't expose their size, and count as nothing.
+     */
+    [[ nodiscard ]] size_t getResourceSize(const Image& image);
+    [[ nodiscard ]] size_t getResourceSize(const ImageTable& table);
+    [[ nodiscard ]] size_t getResourceSize(const Font& font);
+    [[ nodiscard ]] size_t getResourceSize(const AudioSample& sample);
+
+    /**
+     * Shares loaded resources by path. Asking for a path which is already
+     * cached hands out another reference to the same resource, rather than
+     * loading it again.
+     *
+     * The cache keeps every resource it's loaded until it goes over its
+     * memory budget, at which point it evicts resources nothing outside the
+     * cache refers to any more, least recently used first. Resources still in
+     * use are never evicted, so the cache can stay over budget until they're
+     * released, and `trim` is called or another resource is added.
+     *
+     * usage:
+     *      pdcpp::ResourceCache<pdcpp::Image> images(64 * 1024);
+     *      auto player = images.get("images/player");  // loads
+     *      auto again = images.get("images/player");   // shares
+     */
+    template <typename T>
+    class ResourceCache
+    {
+    public:
+        /**
+         * A function which loads a resource from a path, returning nullptr if
+         * it can't.
+         */
+        using LoadFunction = std::function<std::unique_ptr<T>(const std::string&)>;
+
+        /**
+         * A function returning the bytes of memory a resource holds.
+         */
+        using SizeFunction = std::function<size_t(const T&)>;
+
+        struct Stats
+        {
+            size_t bytesCached = 0;
+            size_t budget = 0;
+            size_t entries = 0;
+            uint32_t hits = 0;
+            uint32_t misses = 0;
+            uint32_t evictions = 0;
+        };
+
+        /**
+         * @param budgetBytes the most memory the cache should hold, or 0 for
+         *     no limit.
+         * @param loadFunction how to load a resource. By default it's
+         *     constructed from the path, and discarded if it converts to
+         *     false.
+         * @param sizeFunction how to measure a resource. By default, with
+         *     `getResourceSize`.
+         */
+        explicit ResourceCache(size_t budgetBytes=0,
+                               LoadFunction loadFunction=loadFromPath,
+                               SizeFunction sizeFunction=sizeOf)
+            : m_Load(std::move(loadFunction))
+            , m_Size(std::move(sizeFunction))
+        { m_Stats.budget = budgetBytes; }
+
+        /**
+         * @returns the resource at the path, loading it if it isn't cached,
+         *     or nullptr if it can't be loaded.
+         */
+        std::shared_ptr<T> get(const std::string& path)
+        {
+            if (auto cached = find(path))
+                { return cached; }
+
+            ++m_Stats.misses;
+            auto loaded = m_Load(path);
+            if (loaded == nullptr)
+                { return nullptr; }
+            return insert(path, std::move(loaded));
+        }
+
+        /**
+         * @returns the resource at the path if it's cached, and nullptr
+         *     otherwise. Never loads anything.
+         */
+        std::shared_ptr<T> find(const std::string& path)
+        {
+            auto found = m_Index.find(path);
+            if (found == m_Index.end())
+                { return nullptr; }
+
+            ++m_Stats.hits;
+            m_Entries.splice(m_Entries.begin(), m_Entries, found->second);
+            return found->second->resource;
+        }
+
+        /**
+         * Adds a resource loaded elsewhere, like by an `AssetLoader`,
+         * replacing any already cached at the path. A null resource, like a
+         * failed load, isn't cached, and leaves the cache as it was.
+         *
+         * @returns the cached resource, or nullptr if it was null.
+         */
+        std::shared_ptr<T> insert(const std::string& path, std::shared_ptr<T> resource)
+        {
+            if (resource == nullptr)
+                { return nullptr; }
+
+            erase(path);
+
+            auto bytes = m_Size(*resource);
+            m_Entries.push_front({path, std::move(resource), bytes});
+            m_Index[path] = m_Entries.begin();
+            m_Stats.bytesCached += bytes;
+            m_Stats.entries = m_Entries.size();
+
+            // Hold on to it while trimming, it's about to be handed out.
+            auto inserted = m_Entries.front().resource;
+            trim();
+            return inserted;
+        }
+
+        /**
+         * Drops the resource at the path from the cache. Anything still
+         * referring to it keeps it alive.
+         */
+        void erase(const std::string& path)
+        {
+            auto found = m_Index.find(path);
+            if (found == m_Index.end())
+                { return; }
+
+            m_Stats.bytesCached -= found->second->bytes;
+            m_Entries.erase(found->second);
+            m_Index.erase(found);
+            m_Stats.entries = m_Entries.size();
+        }
+
+        /**
+         * Evicts unused resources, least recently used first, until the cache
+         * is within its budget or only resources in use remain.
+         */
+        void trim()
+        {
+            if (m_Stats.budget > 0)
+                { evict(m_Stats.budget); }
+        }
+
+        /**
+         * Evicts every resource nothing outside the cache refers to, whatever
+         * the budget. Good to call between scenes.
+         */
+        void evictUnused() { evict(0); }
+
+        /**
+         * Drops every resource from the cache.
+         */
+        void clear()
+        {
+            m_Entries.clear();
+            m_Index.clear();
+            m_Stats.bytesCached = 0;
+            m_Stats.entries = 0;
+        }
+
+        /**
+         * Changes the budget, evicting resources if the cache is now over it.
+         */
+        void setBudget(size_t budgetBytes)
+        {
+            m_Stats.budget = budgetBytes;
+            trim();
+        }
+
+        [[ nodiscard ]] const Stats& getStats() const { return m_Stats; }
+
+    private:
+        struct Entry
+        {
+            std::string path;
+            std::shared_ptr<T> resource;
+            size_t bytes;
+        };
+
+        static std::unique_ptr<T> loadFromPath(const std::string& path)
+        {
+            auto resource = std::make_unique<T>(path);
+            if constexpr (std::is_constructible_v<bool, const T&>)
+            {
+                if (!static_cast<bool>(*resource))
+                    { return nullptr; }
+            }
+            return resource;
+        }
+
+        static size_t sizeOf(const T& resource) { return getResourceSize(resource); }
+
+        // Evicts from the least recently used end until the cache holds no
+        // more than `limit`, 0 meaning evict everything unused.
+        void evict(size_t limit)
+        {
+            if (limit > 0 && m_Stats.bytesCached <= limit)
+                { return; }
+
+            auto it = m_Entries.end();
+            while (it != m_Entries.begin())
+            {
+                --it;
+                if (limit > 0 && m_Stats.bytesCached <= limit)
+                    { break; }
+                if (it->resource.use_count() > 1)
+                    { continue; }
+
+                ++m_Stats.evictions;
+                m_Stats.bytesCached -= it->bytes;
+                m_Index.erase(it->path);
+                it = m_Entries.erase(it);
+            }
+            m_Stats.entries = m_Entries.size();
+        }
+
+        std::list<Entry> m_Entries;
+        std::unordered_map<std::string, typename std::list<Entry>::iterator> m_Index;
+        LoadFunction m_Load;
+        SizeFunction m_Size;
+        Stats m_Stats;
+
+        PDCPP_DECLARE_NON_COPYABLE_NON_MOVABLE(ResourceCache);
+    };
+}
@@ -0,0 +1,371 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "util.h"
+
+namespace pdcpp
+{
+    class Serializer;
+    class Deserializer;
+
+    namespace detail
+    {
+        template <typename T>
+        inline constexpr bool isVector = false;
+
+        template <typename T, typename A>
+        inline constexpr bool isVector<std::vector<T, A>> = true;
+
+        template <typename T>
+        inline constexpr bool isOptional = false;
+
+        template <typename T>
+        inline constexpr bool isOptional<std::optional<T>> = true;
+
+        template <typename T>
+        concept HasSerialize = requires(const T& value, Serializer& out) { value.serialize(out); };
+
+        template <typename T>
+        concept HasDeserialize = requires(T& value, Deserializer& in) { value.deserialize(in); };
+
+        // Numbers are stored little-endian, so on a little-endian machine,
+        // which the Playdate and most hosts are, they can be copied as a block.
+        template <typename T>
+        inline constexpr bool isBlockCopyable = (std::is_arithmetic_v<T> || std::is_enum_v<T>)
+            ? std::endian::native == std::endian::little
+            : std::is_trivially_copyable_v<T> && !HasSerialize<T>;
+    }
+
+    /**
+     * Writes values into a compact, versioned, little-endian binary buffer,
+     * for save games and the like, to be read back with a `Deserializer`.
+     *
+     * Numbers, enums, and bools are written little-endian; `std::string`,
+     * `std::vector`, and `std::optional` of anything writable are written
+     * with their lengths; types with a `serialize(Serializer&) const` member
+     * are written by it; and any other trivially copyable struct is written
+     * as a single block of its bytes, as are vectors of them. Those blocks
+     * are in the machine's layout, so change such a struct only along with
+     * the version.
+     *
+     * The buffer starts with a header holding the version given here, the
+     * size of what follows, and a checksum of both, so a save which was cut
+     * short, or is from something else entirely, isn't read.
+     *
+     * `saveToFile` writes to a temporary file, then renames it over the save,
+     * so a crash part way through never leaves a corrupt save behind.
+     *
+     * usage:
+     *      pdcpp::Serializer out(k_SaveVersion);
+     *      out.write(m_Level);
+     *      out.write(m_PlayerName);
+     *      out.write(m_Inventory);
+     *      out.saveToFile("save.bin");
+     */
+    class Serializer
+    {
+    public:
+        /**
+         * @param version the version of the layout being written, which the
+         *     `Deserializer` will report, for reading older saves.
+         */
+        explicit Serializer(uint32_t version);
+
+        /**
+         * Writes a value.
+         */
+        template <typename T>
+        Serializer& write(const T& value)
+        {
+            if constexpr (std::is_same_v<T, std::string>)
+            {
+                writeLength(value.size());
+                writeBytes(value.data(), value.size());
+            }
+            else if constexpr (detail::isVector<T>)
+            {
+                writeLength(value.size());
+                if constexpr (detail::isBlockCopyable<typename T::value_type> && !std::is_same_v<T, std::vector<bool>>)
+                    { writeBytes(value.data(), value.size() * sizeof(typename T::value_type)); }
+                else
+                {
+                    for (const auto& element : value)
+                        { write(static_cast<const typename T::value_type&>(element)); }
+                }
+            }
+            else if constexpr (detail::isOptional<T>)
+            {
+                write(value.has_value());
+                if (value.has_value())
+                    { write(*value); }
+            }
+            else if constexpr (detail::HasSerialize<T>)
+                { value.serialize(*this); }
+            else if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>)
+            {
+                uint8_t bytes[sizeof(T)];
+                std::memcpy(bytes, &value, sizeof(T));
+                if constexpr (std::endian::native != std::endian::little)
+                    { std::reverse(bytes, bytes + sizeof(T)); }
+                writeBytes(bytes, sizeof(T));
+            }
+            else
+            {
+                static_assert(std::is_trivially_copyable_v<T> && !std::is_pointer_v<T>,
+                    "Serializer can't write this type. Give it a serialize(Serializer&) const member.");
+                writeBytes(&value, sizeof(T));
+            }
+            return *this;
+        }
+
+        /**
+         * Writes raw bytes, with no length.
+         */
+        void writeBytes(const void* data, size_t size);
+
+        /**
+         * Writes a length or count, taking a byte for anything under 128.
+         */
+        void writeLength(uint64_t length);
+
+        /**
+         * Fills in the header.
+         *
+         * @return the whole buffer, header and all.
+         */
+        const std::vector<uint8_t>& finish();
+
+        /**
+         * Writes the buffer to a file, in the data folder, by way of a
+         * temporary file which is renamed over it once it's complete.
+         *
+         * @return false if the file couldn't be written, in which case any
+         *     existing file is untouched.
+         */
+        bool saveToFile(const std::string& path);
+
+        static constexpr uint32_t k_Magic = 0x56534450; // "PDSV", read little-endian
+        static constexpr uint32_t k_HeaderSize = 4 * sizeof(uint32_t);
+
+    private:
+        std::vector<uint8_t> m_Data;
+        uint32_t m_Version;
+
+        PDCPP_DECLARE_NON_COPYABLE(Serializer);
+    };
+
+    /**
+     * Reads back what a `Serializer` wrote, straight out of one buffer, so
+     * loading a save is one read from the file system, however many fields
+     * it has.
+     *
+     * Values are read in the order they were written. Failures are sticky:
+     * once a read runs off the end or finds nonsense, it and every read after
+     * it leave their values untouched, and `hasFailed` reports it, so a load
+     * can read everything and check once at the end.
+     *
+     * Older layouts are read by checking `getVersion`, or with `readSince`,
+     * which only reads fields which were in the version being read.
+     *
+     * usage:
+     *      auto in = pdcpp::Deserializer::fromFile("save.bin");
+     *      m_Level = in.readValue<int32_t>();
+     *      in.read(m_PlayerName);
+     *      in.readSince(2, m_Inventory);  // added in version 2
+     *      if (in.hasFailed())
+     *          { startNewGame(); }
+     */
+    class Deserializer
+    {
+    public:
+        /**
+         * Reads from a buffer, which the deserializer keeps.
+         */
+        explicit Deserializer(std::vector<uint8_t> data);
+
+        /**
+         * Reads from someone else's buffer, like an `AssetPack` entry, which
+         * must outlive the deserializer.
+         */
+        Deserializer(const void* data, size_t size);
+
+        Deserializer(Deserializer&& other) noexcept = default;
+
+        /**
+         * Reads a whole file, in one read, and checks its header.
+         */
+        static Deserializer fromFile(const std::string& path);
+
+        /**
+         * Reads a value.
+         *
+         * @return false if it couldn't be read, now or before.
+         */
+        template <typename T>
+        bool read(T& value)
+        {
+            if (m_Failed)
+                { return false; }
+
+            if constexpr (std::is_same_v<T, std::string>)
+            {
+                auto view = readStringView();
+                if (!m_Failed)
+                    { value.assign(view); }
+            }
+            else if constexpr (detail::isVector<T>)
+            {
+                using Element = typename T::value_type;
+                auto count = readLength();
+                if constexpr (detail::isBlockCopyable<Element> && !std::is_same_v<T, std::vector<bool>>)
+                {
+                    if (count > getRemaining() / sizeof(Element))
+                        { return fail(); }
+                    T elements(count);
+                    readBytes(elements.data(), count * sizeof(Element));
+                    value = std::move(elements);
+                }
+                else
+                {
+                    // Every element takes at least a byte, which bounds a
+                    // nonsense count before anything is allocated for it.
+                    if (count > getRemaining())
+                        { return fail(); }
+                    T elements;
+                    elements.reserve(count);
+                    for (uint64_t i = 0; i < count && !m_Failed; ++i)
+                    {
+                        Element element {};
+                        read(element);
+                        elements.push_back(std::move(element));
+                    }
+                    if (!m_Failed)
+                        { value = std::move(elements); }
+                }
+            }
+            else if constexpr (detail::isOptional<T>)
+            {
+                bool present = false;
+                if (!read(present))
+                    { return false; }
+
+                if (!present)
+                    { value.reset(); }
+                else
+                {
+                    typename T::value_type contained {};
+                    if (read(contained))
+                        { value = std::move(contained); }
+                }
+            }
+            else if constexpr (detail::HasDeserialize<T>)
+                { value.deserialize(*this); }
+            else if constexpr (std::is_same_v<T, bool>)
+            {
+                uint8_t byte = 0;
+                readBytes(&byte, 1);
+                if (byte > 1)
+                    { return fail(); }
+                if (!m_Failed)
+                    { value = byte != 0; }
+            }
+            else if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>)
+            {
+                uint8_t bytes[sizeof(T)];
+                if (readBytes(bytes, sizeof(T)))
+                {
+                    if constexpr (std::endian::native != std::endian::little)
+                        { std::reverse(bytes, bytes + sizeof(T)); }
+                    std::memcpy(&value, bytes, sizeof(T));
+                }
+            }
+            else
+            {
+                static_assert(std::is_trivially_copyable_v<T> && !std::is_pointer_v<T>,
+                    "Deserializer can't read this type. Give it a deserialize(Deserializer&) member.");
+                readBytes(&value, sizeof(T));
+            }
+            return !m_Failed;
+        }
+
+        /**
+         * Reads a value, or returns `fallback` if it can't be.
+         */
+        template <typename T>
+        T readValue(T fallback={})
+        {
+            read(fallback);
+            return fallback;
+        }
+
+        /**
+         * Reads a value which was added in `version`, leaving it as it is if
+         * what's being read is older.
+         *
+         * @return false if it should have been there and couldn't be read.
+         */
+        template <typename T>
+        bool readSince(uint32_t version, T& value)
+            { return m_Version < version ? !m_Failed : read(value); }
+
+        /**
+         * Reads a string without copying it.
+         *
+         * @return a view into the buffer, which lasts as long as it does.
+         */
+        std::string_view readStringView();
+
+        /**
+         * Reads raw bytes, written with `Serializer::writeBytes`.
+         */
+        bool readBytes(void* destination, size_t size);
+
+        /**
+         * Reads a length written with `Serializer::writeLength`.
+         */
+        uint64_t readLength();
+
+        /**
+         * @return the version the data was written with.
+         */
+        [[ nodiscard ]] uint32_t getVersion() const { return m_Version; }
+
+        /**
+         * @return true if the header was bad, or a read has failed.
+         */
+        [[ nodiscard ]] bool hasFailed() const { return m_Failed; }
+
+        [[ nodiscard ]] size_t getRemaining() const { return m_Size - m_Position; }
+
+    private:
+        void readHeader();
+        bool fail();
+
+        std::vector<uint8_t> m_Owned;
+        const uint8_t* p_Data = nullptr;
+        size_t m_Size = 0;
+        size_t m_Position = 0;
+        uint32_t m_Version = 0;
+        bool m_Failed = false;
+
+        PDCPP_DECLARE_NON_COPYABLE(Deserializer);
+    };
+}
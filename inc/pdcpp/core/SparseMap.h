@@ -0,0 +1,311 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <ranges>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+#include "util.h"
+
+namespace pdcpp
+{
+    /**
+     * A sparse set of unsigned integer keys, each with a value. Like
+     * `SparseSet`, the keys live in a dense array, which a sparse array maps
+     * back into, so lookups, insertions, and erasures are constant time. The
+     * values live in a second dense array kept in lockstep with the keys, so
+     * iterating them is a walk over contiguous memory.
+     *
+     * Unlike `SparseSet`, the sparse array is split into pages of `PageBytes`
+     * bytes which are only allocated once a key falls within them, and are
+     * released again once they're empty, so large, scattered keys don't cost
+     * memory for every key below them.
+     *
+     * Erasing swaps the last element into the erased one's place, so it
+     * invalidates pointers and references to the last value, and changes the
+     * order of iteration.
+     *
+     * @tparam K an unsigned integer key type
+     * @tparam V the type of the values
+     * @tparam PageBytes the size of each page of the sparse array
+     */
+    template <typename K, typename V, size_t PageBytes = 4096>
+    class SparseMap
+    {
+        static_assert(std::is_unsigned<K>::value, "SparseMap keys must be unsigned integers");
+
+        using Index = uint32_t;
+        static constexpr Index k_Empty = std::numeric_limits<Index>::max();
+        static constexpr size_t k_PageSize = PageBytes / sizeof(Index);
+        static_assert(k_PageSize > 0 && (k_PageSize & (k_PageSize - 1)) == 0, "PageBytes must give a power of 2 entries");
+
+    public:
+        SparseMap() = default;
+
+        [[ nodiscard ]] size_t size() const { return m_Keys.size(); }
+        [[ nodiscard ]] bool empty() const { return m_Keys.empty(); }
+
+        /**
+         * @returns the number of pages of the sparse array currently
+         *     allocated.
+         */
+        [[ nodiscard ]] size_t allocatedPages() const { return m_NPages; }
+
+        /**
+         * Reserves room in the dense arrays. The sparse pages are always
+         * allocated on demand.
+         */
+        void reserve(size_t n)
+        {
+            m_Keys.reserve(n);
+            m_Values.reserve(n);
+        }
+
+        /**
+         * Removes every element, and releases every page.
+         */
+        void clear()
+        {
+            m_Keys.clear();
+            m_Values.clear();
+            m_Pages.clear();
+            m_PageCounts.clear();
+            m_NPages = 0;
+        }
+
+        [[ nodiscard ]] bool has(K key) const { return indexOf(key) != k_Empty; }
+
+        /**
+         * @returns a pointer to the key's value, or nullptr if it isn't in the
+         *     map.
+         */
+        [[ nodiscard ]] V* find(K key)
+        {
+            auto index = indexOf(key);
+            return index == k_Empty ? nullptr : &m_Values[index];
+        }
+
+        [[ nodiscard ]] const V* find(K key) const
+        {
+            auto index = indexOf(key);
+            return index == k_Empty ? nullptr : &m_Values[index];
+        }
+
+        /**
+         * @returns the key's value. The key must be in the map.
+         */
+        [[ nodiscard ]] V& get(K key)
+        {
+            auto index = indexOf(key);
+            assert(index != k_Empty);
+            return m_Values[index];
+        }
+
+        [[ nodiscard ]] const V& get(K key) const
+        {
+            auto index = indexOf(key);
+            assert(index != k_Empty);
+            return m_Values[index];
+        }
+
+        /**
+         * Constructs a value for the key in place, or if the key is already in
+         * the map, assigns a value constructed from the arguments to it.
+         *
+         * @returns the key's value.
+         */
+        template <typename... Args>
+        V& emplace(K key, Args&&... args)
+        {
+            auto& slot = slotFor(key);
+            if (slot != k_Empty)
+            {
+                m_Values[slot] = V(std::forward<Args>(args)...);
+                return m_Values[slot];
+            }
+
+            assert(m_Keys.size() < k_Empty);
+            slot = static_cast<Index>(m_Keys.size());
+            ++m_PageCounts[pageOf(key)];
+            m_Keys.push_back(key);
+            return m_Values.emplace_back(std::forward<Args>(args)...);
+        }
+
+        /**
+         * Adds the key with the given value, replacing its value if it's
+         * already in the map.
+         *
+         * @returns the key's value.
+         */
+        V& insert(K key, V value) { return emplace(key, std::move(value)); }
+
+        /**
+         * Adds each key with the value at the same position in `values`,
+         * replacing the values of keys already in the map. Stops at the end of
+         * the shorter range.
+         */
+        template <RangeOf<K> Keys, RangeOf<V> Values>
+        void insert(Keys&& keys, Values&& values)
+        {
+            if constexpr (std::ranges::sized_range<Keys>)
+                { reserve(size() + std::ranges::size(keys)); }
+
+            auto value = std::ranges::begin(values);
+            auto valuesEnd = std::ranges::end(values);
+            for (auto key = std::ranges::begin(keys); key != std::ranges::end(keys) && value != valuesEnd; ++key, ++value)
+                { emplace(static_cast<K>(*key), *value); }
+        }
+
+        /**
+         * Removes the key and its value, if it's in the map.
+         *
+         * @returns true if the key was removed.
+         */
+        bool erase(K key)
+        {
+            auto index = indexOf(key);
+            if (index == k_Empty)
+                { return false; }
+
+            auto last = static_cast<Index>(m_Keys.size() - 1);
+            if (index != last)
+            {
+                m_Keys[index] = m_Keys[last];
+                m_Values[index] = std::move(m_Values[last]);
+                slotFor(m_Keys[index]) = index;
+            }
+
+            m_Keys.pop_back();
+            m_Values.pop_back();
+            releaseSlot(key);
+            return true;
+        }
+
+        /**
+         * Removes every key in the range that's in the map.
+         *
+         * @returns the number of keys removed.
+         */
+        template <RangeOf<K> Keys>
+        size_t erase(Keys&& keys)
+        {
+            size_t nErased = 0;
+            for (auto&& key : keys)
+                { nErased += erase(static_cast<K>(key)) ? 1 : 0; }
+            return nErased;
+        }
+
+        /**
+         * @returns the keys, in the same order as `values()`.
+         */
+        [[ nodiscard ]] std::span<const K> keys() const { return m_Keys; }
+
+        /**
+         * @returns the values, in the same order as `keys()`.
+         */
+        [[ nodiscard ]] std::span<V> values() { return m_Values; }
+        [[ nodiscard ]] std::span<const V> values() const { return m_Values; }
+
+        /**
+         * Calls `fn(key, value)` for every element.
+         */
+        template <typename Fn>
+        void forEach(Fn&& fn)
+        {
+            for (size_t i = 0; i < m_Keys.size(); ++i)
+                { fn(m_Keys[i], m_Values[i]); }
+        }
+
+    private:
+        [[ nodiscard ]] static size_t pageOf(K key) { return static_cast<size_t>(key) / k_PageSize; }
+        [[ nodiscard ]] static size_t offsetOf(K key) { return static_cast<size_t>(key) & (k_PageSize - 1); }
+
+        [[ nodiscard ]] Index indexOf(K key) const
+        {
+            auto page = pageOf(key);
+            if (page >= m_Pages.size() || m_Pages[page] == nullptr)
+                { return k_Empty; }
+            return m_Pages[page][offsetOf(key)];
+        }
+
+        // Returns the key's entry in the sparse array, allocating its page if
+        // need be.
+        Index& slotFor(K key)
+        {
+            auto page = pageOf(key);
+            if (page >= m_Pages.size())
+            {
+                m_Pages.resize(page + 1);
+                m_PageCounts.resize(page + 1, 0);
+            }
+
+            if (m_Pages[page] == nullptr)
+            {
+                m_Pages[page] = std::make_unique<Index[]>(k_PageSize);
+                std::fill_n(m_Pages[page].get(), k_PageSize, k_Empty);
+                ++m_NPages;
+            }
+
+            return m_Pages[page][offsetOf(key)];
+        }
+
+        void releaseSlot(K key)
+        {
+            auto page = pageOf(key);
+            m_Pages[page][offsetOf(key)] = k_Empty;
+            if (--m_PageCounts[page] == 0)
+            {
+                m_Pages[page].reset();
+                --m_NPages;
+            }
+        }
+
+        std::vector<K> m_Keys;
+        std::vector<V> m_Values;
+        std::vector<std::unique_ptr<Index[]>> m_Pages;
+        std::vector<Index> m_PageCounts;
+        size_t m_NPages = 0;
+    };
+
+    /**
+     * Calls `fn(key, values...)` for every key found in all of the given maps,
+     * with a reference to the key's value in each. Walks the smallest map and
+     * looks the key up in the rest, so the cost is proportional to the size
+     * of the smallest. Don't add or remove elements from the maps in `fn`.
+     *
+     * usage:
+     *      pdcpp::intersect([](auto id, Point<float>& p, const Point<float>& v) { p = p + v; }, positions, velocities);
+     */
+    template <typename Fn, typename K, typename... Vs, size_t... Pages>
+    void intersect(Fn&& fn, SparseMap<K, Vs, Pages>&... maps)
+    {
+        static_assert(sizeof...(Vs) > 0, "intersect needs at least one map");
+
+        std::array<std::span<const K>, sizeof...(Vs)> keys { maps.keys()... };
+        auto smallest = std::min_element(keys.begin(), keys.end(), [](auto& a, auto& b) { return a.size() < b.size(); });
+
+        for (auto key : *smallest)
+        {
+            auto found = std::make_tuple(maps.find(key)...);
+            auto inAll = std::apply([](auto*... ptrs) { return ((ptrs != nullptr) && ...); }, found);
+            if (inAll)
+                { std::apply([&](auto*... ptrs) { fn(key, *ptrs...); }, found); }
+        }
+    }
+}
@@ -9,11 +9,10 @@
  */
 
 #pragma once
-#include <functional>
 #include <pd_api.h>
-#include <functional>
 #include <string>
 #include <vector>
+#include "InplaceFunction.h"
 
 
 namespace pdcpp
@@ -47,6 +46,8 @@ namespace pdcpp
             : public ItemBase
         {
         public:
+            using Callback = pdcpp::InplaceFunction<void()>;
+
             /**
              * Creates a new basic system menu item with a title. Inherit from
              * this class and implement the callback to handle when user selects
@@ -56,11 +57,11 @@ namespace pdcpp
              * @param callback a function which will be called when the user
              *    selects the system menu item.
              */
-            explicit BasicItem(const std::string& title, std::function<void()> callback);
+            explicit BasicItem(const std::string& title, Callback callback);
 
         private:
             static void shim(void* usrData);
-            std::function<void()> callback;
+            Callback callback;
         };
 
 
@@ -68,6 +69,8 @@ namespace pdcpp
             : public ItemBase
         {
         public:
+            using Callback = pdcpp::InplaceFunction<void(bool)>;
+
             /**
              * Creates a new item in the system menu with a title, and a box
              * which can be checked/unchecked by the user.
@@ -77,7 +80,7 @@ namespace pdcpp
              * @param callback a function which will be called with the checked
              *     status when the user interacts with the system menu item
              */
-            CheckmarkItem(const std::string& title, bool isChecked, std::function<void(bool)> callback);
+            CheckmarkItem(const std::string& title, bool isChecked, Callback callback);
 
             /**
              * Change the state of the checkmark in the menu item. Changing the
@@ -94,7 +97,7 @@ namespace pdcpp
 
         private:
             static void shim(void* usrData);
-            std::function<void(bool)> callback;
+            Callback callback;
         };
 
 
@@ -102,6 +105,8 @@ namespace pdcpp
             : public ItemBase
         {
         public:
+            using Callback = pdcpp::InplaceFunction<void(const std::string&, int)>;
+
             /**
              * Creates a new item in the system menu which can be set to one of
              * a number of values. Note that these options are displayed on the
@@ -118,7 +123,7 @@ namespace pdcpp
             OptionsItem(
                 const std::string& title,
                 std::vector<std::string> options,
-                std::function<void(const std::string&, int)> callback,
+                Callback callback,
                 int startingIndex=0);
 
             /**
@@ -143,7 +148,7 @@ namespace pdcpp
             static void shim(void* usrData);
             std::vector<std::string> m_Options;
             std::vector<const char*> m_CStrings;
-            std::function<void(const std::string&, int)> callback;
+            Callback callback;
         };
     };
 }
\ No newline at end of file
@@ -0,0 +1,218 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#pragma once
+
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <utility>
+#include <vector>
+#include "FrameBudget.h"
+#include "TimerService.h"
+#include "util.h"
+
+namespace pdcpp
+{
+    /**
+     * A coroutine which a `TaskScheduler` runs a piece at a time, so work too
+     * big for one frame can be spread over several without threads. Between
+     * pieces a task suspends itself with `co_await pdcpp::nextFrame()`,
+     * `co_await pdcpp::waitMs(n)`, or `co_await pdcpp::yieldIfOverBudget()`.
+     *
+     * A task can also `co_await` another task, which runs the other one to
+     * completion, suspensions and all, before carrying on.
+     *
+     * Tasks do nothing until they're spawned on a scheduler, and any
+     * references they take as arguments must outlive them.
+     *
+     * usage:
+     *      pdcpp::Task loadLevel(Level& level)
+     *      {
+     *          for (auto& path : level.getImagePaths())
+     *          {
+     *              level.addImage(pdcpp::Image(path));
+     *              co_await pdcpp::yieldIfOverBudget();
+     *          }
+     *          co_await buildCollisionMap(level);
+     *      }
+     *
+     *      pdcpp::TaskScheduler::getDefault().spawn(loadLevel(m_Level));
+     */
+    class Task
+    {
+    public:
+        struct promise_type;
+        using Handle = std::coroutine_handle<promise_type>;
+
+        struct FinalAwaiter
+        {
+            [[ nodiscard ]] bool await_ready() const noexcept { return false; }
+            std::coroutine_handle<> await_suspend(Handle finished) noexcept;
+            void await_resume() const noexcept {}
+        };
+
+        struct promise_type
+        {
+            Task get_return_object() { return Task(Handle::from_promise(*this)); }
+            std::suspend_always initial_suspend() noexcept { return {}; }
+            FinalAwaiter final_suspend() noexcept { return {}; }
+            void return_void() {}
+            void unhandled_exception() { std::terminate(); }
+
+            // Whatever's awaiting this task, to be resumed when it finishes.
+            std::coroutine_handle<> continuation;
+        };
+
+        Task() = default;
+        ~Task();
+
+        Task(Task&& other) noexcept : m_Handle(std::exchange(other.m_Handle, {})) {}
+        Task& operator= (Task&& other) noexcept;
+
+        /**
+         * @returns true if the task has run to the end.
+         */
+        [[ nodiscard ]] bool isDone() const { return !m_Handle || m_Handle.done(); }
+
+        // Awaiting a task starts it straight away, and carries on once it's
+        // done.
+        [[ nodiscard ]] bool await_ready() const noexcept { return isDone(); }
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept;
+        void await_resume() const noexcept {}
+
+    private:
+        friend class TaskScheduler;
+        explicit Task(Handle handle) : m_Handle(handle) {}
+
+        Handle m_Handle;
+
+        PDCPP_DECLARE_NON_COPYABLE(Task);
+    };
+
+    /**
+     * Runs spawned `Task`s from the game's update, giving them no more than a
+     * set amount of time each frame. Tasks which are ready to run take turns,
+     * and once the budget is spent the rest wait for the next frame, though at
+     * least one always runs so that every task makes progress eventually.
+     *
+     * The budget can only be honoured between pieces of a task, so tasks
+     * doing long loops should `co_await pdcpp::yieldIfOverBudget()` as they go.
+     */
+    class TaskScheduler
+    {
+    public:
+        /**
+         * @param frameBudgetMs the time tasks may take each update.
+         */
+        explicit TaskScheduler(float frameBudgetMs=k_DefaultFrameBudgetMs);
+        ~TaskScheduler();
+
+        /**
+         * Hands a task to the scheduler, which will start it on its next
+         * `update`, and own it until it finishes.
+         */
+        void spawn(Task task);
+
+        /**
+         * Runs the tasks which are ready, until they've all suspended or the
+         * budget is spent. Call it once per update.
+         */
+        void update();
+
+        /**
+         * Destroys every task, finished or not. Don't call it from within a
+         * task.
+         */
+        void cancelAll();
+
+        void setFrameBudget(float budgetMs);
+        [[ nodiscard ]] float getFrameBudget() const { return m_Budget.getBudget(); }
+
+        /**
+         * @returns true if this frame's budget has been spent. Only meaningful
+         *     during `update`.
+         */
+        [[ nodiscard ]] bool isOverBudget() const;
+
+        /**
+         * @returns the number of unfinished tasks.
+         */
+        [[ nodiscard ]] size_t getNumTasks() const { return m_Tasks.size(); }
+
+        /**
+         * @returns the scheduler running tasks right now, or nullptr outside
+         *     of any scheduler's `update`.
+         */
+        [[ nodiscard ]] static TaskScheduler* getCurrent() { return s_Current; }
+
+        /**
+         * @returns the scheduler shared by the library.
+         */
+        static TaskScheduler& getDefault();
+
+        static constexpr float k_DefaultFrameBudgetMs = 4.0f;
+
+    private:
+        friend struct NextFrameAwaiter;
+        friend struct WaitAwaiter;
+        friend struct BudgetAwaiter;
+
+        std::vector<Task> m_Tasks;
+        std::vector<std::coroutine_handle<>> m_Ready;
+        std::vector<std::coroutine_handle<>> m_NextFrame;
+        size_t m_NextReady = 0;
+        TimerService m_Timers;
+        FrameBudget m_Budget;
+
+        static TaskScheduler* s_Current;
+
+        PDCPP_DECLARE_NON_COPYABLE_NON_MOVABLE(TaskScheduler);
+    };
+
+    struct NextFrameAwaiter
+    {
+        [[ nodiscard ]] bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> task) const;
+        void await_resume() const noexcept {}
+    };
+
+    struct WaitAwaiter
+    {
+        [[ nodiscard ]] bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> task) const;
+        void await_resume() const noexcept {}
+
+        uint32_t delayMs;
+    };
+
+    struct BudgetAwaiter
+    {
+        [[ nodiscard ]] bool await_ready() const;
+        void await_suspend(std::coroutine_handle<> task) const;
+        void await_resume() const noexcept {}
+    };
+
+    /**
+     * Suspends the task until the scheduler's next `update`.
+     */
+    [[ nodiscard ]] inline NextFrameAwaiter nextFrame() { return {}; }
+
+    /**
+     * Suspends the task for at least `delayMs` milliseconds.
+     */
+    [[ nodiscard ]] inline WaitAwaiter waitMs(uint32_t delayMs) { return {delayMs}; }
+
+    /**
+     * Suspends the task until the next frame if this frame's budget has been
+     * spent, and otherwise carries straight on.
+     */
+    [[ nodiscard ]] inline BudgetAwaiter yieldIfOverBudget() { return {}; }
+}
@@ -10,6 +10,7 @@
 
 #pragma once
 
+#include "TimerService.h"
 
 namespace pdcpp
 {
@@ -24,11 +25,15 @@ namespace pdcpp
          * triggered exactly on the time interval. This makes it ideal for
          * longer-term measurements where some jitter is acceptable.
          *
+         * Timers can't be copied or moved, as a service they've been handed
+         * to calls back into them where they were.
+         *
          * @param intervalMs the number of milliseconds to allow to elapse
          *     triggering the callback
          * @param startEnabled optionally defer the enablement of the timer
          */
         explicit Timer(unsigned int intervalMs, bool startEnabled=true);
+        virtual ~Timer();
 
         /**
          * Change the interval of this timer, optionally resetting the timer.
@@ -53,10 +58,20 @@ namespace pdcpp
 
         /**
          * Check the time and fire the callback if the time has elapsed. Higher
-         * tick rates will ensure better timing accuracy.
+         * tick rates will ensure better timing accuracy. Does nothing once the
+         * timer is using a `TimerService`.
          */
         void tick();
 
+        /**
+         * Hands the timer over to a `TimerService`, which will call the
+         * `timerCallback` from its `update`, so the timer no longer needs to be
+         * `tick`'d.
+         *
+         * @param service the service to use, by default the shared one.
+         */
+        void useService(TimerService& service=TimerService::getDefault());
+
     protected:
         /**
          * Pure virtual. Will be called after the interval has elapsed.
@@ -64,8 +79,14 @@ namespace pdcpp
         virtual void timerCallback() = 0;
 
     private:
+        void schedule();
+
         unsigned int m_LastMilliseconds, m_Interval;
         bool m_Enabled;
+        TimerService* p_Service = nullptr;
+        TimerHandle m_Handle;
+
+        PDCPP_DECLARE_NON_COPYABLE_NON_MOVABLE(Timer);
     };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -84,6 +105,7 @@ namespace pdcpp
          * @param startEnabled optionally defer the enablement of the timer
          */
         explicit FrameTimer(unsigned int nFrames, bool startEnabled=true);
+        virtual ~FrameTimer();
 
         /**
          * Changes the number of tick calls before hitting the callback,
@@ -109,10 +131,20 @@ namespace pdcpp
 
         /**
          * Call this to advance the timer. Once the timer has been `tick`'d
-         * the set number of times, the `timerCallback` will be hit
+         * the set number of times, the `timerCallback` will be hit. Does
+         * nothing once the timer is using a `TimerService`.
          */
         void tick();
 
+        /**
+         * Hands the timer over to a `TimerService`, which will count its
+         * `update` calls as the timer's frames, so the timer no longer needs
+         * to be `tick`'d.
+         *
+         * @param service the service to use, by default the shared one.
+         */
+        void useService(TimerService& service=TimerService::getDefault());
+
     protected:
         /**
          * Pure virtual. Will be called after the number of ticks/frames has
@@ -121,7 +153,13 @@ namespace pdcpp
         virtual void timerCallback() = 0;
 
     private:
+        void schedule();
+
         unsigned int m_NFrames, m_FramesRemaining;
         bool m_Enabled;
+        TimerService* p_Service = nullptr;
+        TimerHandle m_Handle;
+
+        PDCPP_DECLARE_NON_COPYABLE_NON_MOVABLE(FrameTimer);
     };
 }
@@ -0,0 +1,168 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include "util.h"
+
+namespace pdcpp
+{
+    class TimerService;
+
+    /**
+     * Refers to a timer scheduled with a `TimerService`. Handles are cheap to
+     * copy, and once their timer has fired for the last time or been
+     * cancelled they go stale, rather than referring to whatever timer takes
+     * its place. A default constructed handle refers to nothing.
+     */
+    class TimerHandle
+    {
+    public:
+        TimerHandle() = default;
+
+        /**
+         * Cancels the timer, if it's still pending. Safe to call from within
+         * the timer's own callback.
+         */
+        void cancel();
+
+        /**
+         * @returns true if the timer has yet to fire, or is repeating and
+         *     hasn't been cancelled.
+         */
+        [[ nodiscard ]] bool isPending() const;
+
+    private:
+        friend class TimerService;
+        TimerHandle(TimerService* service, uint64_t id) : p_Service(service), m_Id(id) {}
+
+        TimerService* p_Service = nullptr;
+        uint64_t m_Id = 0;
+    };
+
+    /**
+     * Runs any number of timers off a single read of the clock per frame.
+     * Timers live in a hierarchical timing wheel, so `update` costs in
+     * proportion to the timers which are due, not to the timers which exist.
+     *
+     * Timers can count milliseconds or calls to `update`, and fire once or
+     * repeatedly. A repeating timer which has fallen more than a period
+     * behind fires once, and then picks up its original phase, rather than
+     * firing for each missed period.
+     *
+     * The existing `Timer` and `FrameTimer` classes can be handed to a
+     * service with their `useService` method, after which their `tick` does
+     * nothing and the service drives them instead.
+     *
+     * usage:
+     *      auto& timers = pdcpp::TimerService::getDefault();
+     *      auto blink = timers.every(500, [this](){ toggleCursor(); });
+     *      timers.afterFrames(3, [this](){ shake(false); });
+     *      ...
+     *      timers.update();  // once per frame
+     *      ...
+     *      blink.cancel();
+     */
+    class TimerService
+    {
+    public:
+        using Callback = std::function<void()>;
+
+        /**
+         * Creates a service, reading the clock to start from.
+         */
+        TimerService();
+        ~TimerService();
+
+        /**
+         * Calls the callback once, after at least `delayMs` milliseconds.
+         * The delay starts now, not at the last `update`, so the clock is
+         * read to schedule it. On a service updated with a clock of your
+         * own, it starts at the last `update` instead.
+         */
+        TimerHandle after(uint32_t delayMs, Callback callback);
+
+        /**
+         * Calls the callback every `intervalMs` milliseconds until cancelled,
+         * starting from now, as with `after`.
+         */
+        TimerHandle every(uint32_t intervalMs, Callback callback);
+
+        /**
+         * Calls the callback once, after `nFrames` calls to `update`.
+         */
+        TimerHandle afterFrames(uint32_t nFrames, Callback callback);
+
+        /**
+         * Calls the callback every `nFrames` calls to `update` until cancelled.
+         */
+        TimerHandle everyFrames(uint32_t nFrames, Callback callback);
+
+        /**
+         * Cancels a pending timer. Does nothing if the handle is stale, or from
+         * another service.
+         */
+        void cancel(const TimerHandle& handle);
+
+        [[ nodiscard ]] bool isPending(const TimerHandle& handle) const;
+
+        /**
+         * Cancels every pending timer.
+         */
+        void cancelAll();
+
+        /**
+         * Reads the clock, advances a frame, and fires every timer which is
+         * due. Call it once per update.
+         */
+        void update();
+
+        /**
+         * Like `update`, but with the time provided rather than read from the
+         * system, for running on a clock of your own.
+         *
+         * @param nowMs the current time, on the same clock as previous calls.
+         */
+        void update(uint32_t nowMs);
+
+        /**
+         * @returns the number of timers waiting to fire.
+         */
+        [[ nodiscard ]] size_t getNumPending() const;
+
+        /**
+         * @returns the service shared by the library and by `Timer`s and
+         *     `FrameTimer`s which don't name one of their own. It's never
+         *     destroyed, so global timers can outlive everything else.
+         */
+        static TimerService& getDefault();
+
+    private:
+        class Wheel;
+
+        TimerHandle schedule(Wheel& wheel, uint32_t delay, uint32_t interval, Callback callback);
+        Wheel* wheelFor(uint64_t id) const;
+        void advance(uint32_t nowMs);
+
+        // How long it's been since the last update, if the service is on
+        // the system clock.
+        [[ nodiscard ]] uint32_t getTimeSinceUpdate() const;
+
+        std::unique_ptr<Wheel> p_Clock;
+        std::unique_ptr<Wheel> p_Frames;
+        uint32_t m_LastMs;
+        bool m_OnSystemClock = true;
+
+        PDCPP_DECLARE_NON_COPYABLE_NON_MOVABLE(TimerService);
+    };
+}
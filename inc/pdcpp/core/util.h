@@ -9,6 +9,7 @@
  */
 #pragma once
 #include <algorithm>
+#include <cmath>
 #include <optional>
 #include <sstream>
 
@@ -10,6 +10,7 @@
 
 #pragma once
 #include <string>
+#include <string_view>
 #include <vector>
 #include <pd_api.h>
 #include <pdcpp/graphics/Rectangle.h>
@@ -141,7 +142,18 @@ namespace pdcpp
          */
         pdcpp::Image getGlyphImage(uint32_t c);
 
+        /**
+         * @return the LCDFont* used by this Font, nullptr if it failed to load.
+         */
+        [[ nodiscard ]] operator LCDFont*() const { return m_Font; }; // NOLINT(*-explicit-constructor)
+
     private:
+        // Calls `fn(line, broken)` for each line of the wrapped text. The line
+        // is a view into the text, without the newline, and `broken` is false
+        // only for a last line which runs to the end of the text.
+        template <typename Fn>
+        void forEachWrappedLine(std::string_view text, int maxWidth, Fn&& fn) const;
+
         int m_Tracking, m_Leading;
         LCDFont* m_Font;
     };
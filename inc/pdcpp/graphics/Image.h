@@ -9,9 +9,9 @@
  */
 #pragma once
 
-#include <functional>
 #include <string>
 #include <pd_api.h>
+#include <pdcpp/core/InplaceFunction.h>
 #include <pdcpp/core/util.h>
 #include "Point.h"
 #include "Rectangle.h"
@@ -21,6 +21,10 @@ namespace pdcpp
     class Image
     {
     public:
+        // Only called while drawing, never kept, so there's room for lambdas
+        // capturing plenty by reference.
+        using DrawFunction = pdcpp::InplaceFunction<void(), 128>;
+
         /**
          * Creates a new Image with a specific height and width, optionally
          * filled with a color.
@@ -164,6 +168,29 @@ namespace pdcpp
          */
         [[ nodiscard ]] RawBitmapData getBitmapData() const;
 
+        /**
+         * Describes an image by pointing into its bitmap data rather than
+         * copying it. `mask` is nullptr if the image has no mask, and each row
+         * is `rowBytes` long, which may include padding past the image's
+         * width.
+         */
+        struct BitmapDataView
+        {
+            pdcpp::Rectangle<int> bounds;
+            int rowBytes;
+            uint8_t* mask;
+            uint8_t* data;
+        };
+
+        /**
+         * Like `getBitmapData`, but without copying or allocating anything.
+         * The view is only valid for as long as the image is, and writes
+         * through it change the image.
+         *
+         * @returns a view of the bitmap data of this image
+         */
+        [[ nodiscard ]] BitmapDataView getBitmapDataView() const;
+
         /**
          * Gets the color of the pixel at (x, y).
          *
@@ -226,7 +253,7 @@ namespace pdcpp
          * @return the drawn image
          */
         static Image drawAsImage
-            (const PDRect& bounds, const std::function<void()>& drawFunc, LCDSolidColor fillColor=kColorClear);
+            (const PDRect& bounds, const DrawFunction& drawFunc, LCDSolidColor fillColor=kColorClear);
 
         /**
          * Provides access to the underlying LCDBitmap for use with the C API.
@@ -38,6 +38,12 @@ namespace pdcpp
 
         [[ nodiscard ]] LCDBitmap* operator[](int index) const;
 
+        /**
+         * @return the LCDBitmapTable* owned by this ImageTable, nullptr if it
+         *     failed to load.
+         */
+        [[ nodiscard ]] operator LCDBitmapTable*() const { return p_Table; }; // NOLINT(*-explicit-constructor)
+
     private:
         LCDBitmapTable* p_Table;
         PDCPP_DECLARE_NON_COPYABLE(ImageTable);
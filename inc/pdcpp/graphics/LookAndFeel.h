@@ -10,6 +10,7 @@
 #pragma once
 #include <map>
 #include <pd_api.h>
+#include <pdcpp/core/ResourceCache.h>
 #include <pdcpp/graphics/Rectangle.h>
 #include <pdcpp/components/TextComponent.h>
 #include <pdcpp/graphics/Font.h>
@@ -49,7 +50,7 @@ namespace pdcpp
         std::map<int, pdcpp::Color> m_Colors;
 
         // "Globals"
-        static std::map<std::string, Font> g_Fonts;
+        static ResourceCache<Font> g_Fonts;
         static LookAndFeel* defaultLookAndFeel;
     };
 
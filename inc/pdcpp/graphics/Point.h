@@ -10,6 +10,9 @@
 
 #pragma once
 #include <cmath>
+#include <cstdlib>
+#include <type_traits>
+#include <pdcpp/core/FastMath.h>
 
 namespace pdcpp
 {
@@ -26,26 +29,44 @@ namespace pdcpp
 
         /**
          * calculates the absolute distance between this point and another.
+         * For non-arithmetic types like `Fixed`, the distance is found with
+         * the type's own `hypot`, and only the result converted to float.
          *
          * @param other: the other point from which distance will be measured
          * @return the absolute distance between this point and the `other`.
          */
         [[ nodiscard ]] float distance(const Point<T>& other) const
         {
-            auto a2 = ::powf(::abs(other.x - x), 2);
-            auto b2 = ::powf(::abs(other.y - y), 2);
-            return ::sqrtf(a2 + b2);
+            if constexpr (std::is_arithmetic_v<T>)
+            {
+                auto a2 = ::powf(::abs(other.x - x), 2);
+                auto b2 = ::powf(::abs(other.y - y), 2);
+                return ::sqrtf(a2 + b2);
+            }
+            else
+                { return static_cast<float>(hypot(other.x - x, other.y - y)); }
         }
 
         /**
          * Rotates a point around a center.
          *
          * @param center: the center point of rotation
-         * @param radians: how many radians (clockwise) this point will rotate
+         * @param radians: how many radians (clockwise) this point will rotate.
+         *     For non-arithmetic types like `Fixed`, this is converted to `T`,
+         *     and the rotation done with the type's own `sin` and `cos`.
          * @return A new point, rotated.
          */
         [[ nodiscard ]] Point<T> rotated(const Point<T>& center, float radians) const;
 
+        /**
+         * Rotates a point around a center, using the `FastMath` tables rather
+         * than libm.
+         *
+         * usage:
+         *      auto tip = hand.rotated(center, angle, pdcpp::FastMath::useTables);
+         */
+        [[ nodiscard ]] Point<T> rotated(const Point<T>& center, float radians, FastMath::UseTables) const;
+
         [[ nodiscard ]] Point<T> withX(T newX) const;
         [[ nodiscard ]] Point<T> withY(T newY) const;
 
@@ -65,7 +86,10 @@ namespace pdcpp
 
     template<typename T>
     Point<T> Point<T>::abs() const
-    { return Point<T>(T(std::fabs(x)), T(std::fabs(y))); }
+    {
+        using std::abs;
+        return Point<T>(abs(x), abs(y));
+    }
 
     template<typename T>
     Point<T> Point<T>::withX(T newX) const
@@ -82,11 +106,37 @@ namespace pdcpp
     template<typename T>
     Point<T> Point<T>::rotated(const Point<T>& center, float radians) const
     {
-        float c = ::cosf(radians);
-        float s = ::sinf(radians);
         auto p = *this - center;
-
-        return Point<T>(p.x * c - p.y * s, p.x * s + p.y * c) + center;
+        if constexpr (std::is_arithmetic_v<T>)
+        {
+            float c = ::cosf(radians);
+            float s = ::sinf(radians);
+            return Point<T>(p.x * c - p.y * s, p.x * s + p.y * c) + center;
+        }
+        else
+        {
+            const auto angle = T(radians);
+            const auto c = cos(angle);
+            const auto s = sin(angle);
+            return Point<T>(p.x * c - p.y * s, p.x * s + p.y * c) + center;
+        }
     }
 
-}
\ No newline at end of file
+    template<typename T>
+    Point<T> Point<T>::rotated(const Point<T>& center, float radians, FastMath::UseTables) const
+    {
+        auto p = *this - center;
+        if constexpr (std::is_arithmetic_v<T>)
+        {
+            const auto [s, c] = FastMath::sinCos(radians);
+            return Point<T>(p.x * c - p.y * s, p.x * s + p.y * c) + center;
+        }
+        else
+        {
+            const auto angle = T(radians);
+            const auto c = FastMath::cos(angle);
+            const auto s = FastMath::sin(angle);
+            return Point<T>(p.x * c - p.y * s, p.x * s + p.y * c) + center;
+        }
+    }
+}
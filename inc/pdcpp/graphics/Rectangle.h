@@ -11,6 +11,7 @@
 #include <algorithm>
 #include <pd_api.h>
 #include <cassert>
+#include <type_traits>
 #include "Point.h"
 #include "pdcpp/core/util.h"
 
@@ -66,8 +67,20 @@ namespace pdcpp
         [[ nodiscard ]] Rectangle<T> withOrigin(const pdcpp::Point<T>& newOrigin) const;
         [[ nodiscard ]] Rectangle<T> withCenter(const pdcpp::Point<T>& newCenter) const;
 
+        /**
+         * Places the rectangle at the given angle from the ellipse's center,
+         * as far out as it can go while staying inside. Types libm can't
+         * handle, like `Fixed`, use the `FastMath` version.
+         */
         [[ nodiscard ]] Rectangle<T> withEdgeInEllipse(const pdcpp::Rectangle<T>& ellipse, float angle);
 
+        /**
+         * `withEdgeInEllipse`, using one `FastMath` table lookup for the sine
+         * and cosine, and `FastMath::sqrt`, rather than libm.
+         */
+        [[ nodiscard ]] Rectangle<T> withEdgeInEllipse(const pdcpp::Rectangle<T>& ellipse, float angle,
+                                                       FastMath::UseTables) const;
+
         [[ nodiscard ]] Rectangle<T> withWidth(T newWidth) const;
         [[ nodiscard ]] Rectangle<T> withHeight(T newHeight) const;
 
@@ -168,8 +181,8 @@ namespace pdcpp
     template<typename T>
     void Rectangle<T>::setCenter(Point<T> center)
     {
-        x = center.x - (width / 2.0f);
-        y = center.y - (height / 2.0f);
+        x = center.x - width / T(2);
+        y = center.y - height / T(2);
     }
 
     template<typename T>
@@ -206,22 +219,22 @@ namespace pdcpp
     
     template<typename T>
     Point<T> Rectangle<T>::getCenter() const
-        { return {x + T(width / 2.0f), y + T(height / 2.0f)}; }
+        { return {x + width / T(2), y + height / T(2)}; }
 
     template<typename T>
     Rectangle<T> Rectangle<T>::getOverlap(const Rectangle<T>& other) const
     {
         const auto overlapStartX = std::max<T>(x, other.x);
         const auto overlapEndX = std::min<T>(other.x + other.width, x + width);
-        const auto overlapLenX = std::max<T>(0.0f, overlapEndX - overlapStartX);
+        const auto overlapLenX = std::max<T>(T(0), overlapEndX - overlapStartX);
 
         const auto overlapStartY = std::max<T>(other.y, y);
         const auto overlapEndY = std::min<T>(other.y + other.height, y + height);
-        const auto overlapLenY = std::max<T>(0.0f, overlapEndY - overlapStartY);
+        const auto overlapLenY = std::max<T>(T(0), overlapEndY - overlapStartY);
 
         return Rectangle<T>(
-            overlapLenX > 0 ? overlapStartX : 0.0f,
-            overlapLenY > 0 ? overlapStartY : 0.0f,
+            overlapLenX > T(0) ? overlapStartX : T(0),
+            overlapLenY > T(0) ? overlapStartY : T(0),
             overlapLenX,
             overlapLenY
         );
@@ -268,18 +281,65 @@ namespace pdcpp
     template<typename T>
     Rectangle<T> Rectangle<T>::withEdgeInEllipse(const pdcpp::Rectangle<T>& ellipse, float angle)
     {
-        auto a = ellipse.width / 2;
-        auto b = ellipse.height / 2;
-        auto radius = (a * b) / std::sqrt(std::pow(b * std::cos(angle), 2) + std::pow(a * std::sin(angle), 2));
-
-        auto m = std::floor(2.0f * angle / kPI);
-        auto theta = std::pow(-1, m) * T(angle - std::floor((m + 1) / 2.0f) * kPI);
-        b = width * std::cos(theta) + height * std::sin(theta);
-        auto d = std::pow(b, 2) + 4 * std::pow(radius, 2) - std::pow(width, 2) - std::pow(height, 2);
-
-        d = (std::sqrt(d) - b) / 2.0f;
-        auto newCenter = pdcpp::Point<T>(d * std::cos(angle), d * std::sin(angle));
-        newCenter = ellipse.getCenter() + newCenter;
-        return withCenter(newCenter);
+        // libm has nothing for non-arithmetic types like `Fixed`, so they go
+        // through the tables.
+        if constexpr (!std::is_arithmetic_v<T>)
+            { return withEdgeInEllipse(ellipse, angle, FastMath::useTables); }
+        else
+        {
+            auto a = ellipse.width / 2;
+            auto b = ellipse.height / 2;
+            auto radius = (a * b) / std::sqrt(std::pow(b * std::cos(angle), 2) + std::pow(a * std::sin(angle), 2));
+
+            auto m = std::floor(2.0f * angle / kPI);
+            auto theta = std::pow(-1, m) * T(angle - std::floor((m + 1) / 2.0f) * kPI);
+            b = width * std::cos(theta) + height * std::sin(theta);
+            auto d = std::pow(b, 2) + 4 * std::pow(radius, 2) - std::pow(width, 2) - std::pow(height, 2);
+
+            d = (std::sqrt(d) - b) / 2.0f;
+            auto newCenter = pdcpp::Point<T>(d * std::cos(angle), d * std::sin(angle));
+            newCenter = ellipse.getCenter() + newCenter;
+            return withCenter(newCenter);
+        }
     };
+
+    template<typename T>
+    Rectangle<T> Rectangle<T>::withEdgeInEllipse(const pdcpp::Rectangle<T>& ellipse, float angle,
+                                                 FastMath::UseTables) const
+    {
+        const auto [s, c] = FastMath::sinCos(angle);
+
+        // The half sizes, and the reach below, are kept in T as they are in
+        // the libm version, so integer rectangles land on the same pixels.
+        const auto a = ellipse.width / 2;
+        const auto b = ellipse.height / 2;
+        const auto w = float(width);
+        const auto h = float(height);
+        const auto bc = float(b) * c;
+        const auto as = float(a) * s;
+        const auto radius = float(a) * float(b) * FastMath::invSqrt<2>(bc * bc + as * as);
+
+        T reach;
+        if constexpr (std::is_integral_v<T>)
+        {
+            // The libm version truncates the folded angle to an integer, which
+            // is matched here at the cost of a second lookup.
+            const auto m = std::floor(2.0f * angle / kPI);
+            const auto folded = float(T(angle - std::floor((m + 1) / 2.0f) * kPI));
+            const auto [foldedS, foldedC] = FastMath::sinCos(std::fmod(m, 2.0f) == 0.0f ? folded : -folded);
+            reach = T(w * foldedC + h * foldedS);
+        }
+        else
+        {
+            // The angle folded into [-pi/2, pi/2) and mirrored to be positive,
+            // has the magnitudes of the angle's cosine and sine.
+            reach = T(w * std::abs(c) + h * std::abs(s));
+        }
+
+        const auto r = float(reach);
+        const auto d = (FastMath::sqrt<2>(r * r + 4.0f * radius * radius - w * w - h * h) - r) / 2.0f;
+
+        const auto newCenter = pdcpp::Point<T>(T(d * c), T(d * s));
+        return withCenter(ellipse.getCenter() + newCenter);
+    }
 }
@@ -0,0 +1,94 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#pragma once
+
+#include <pd_api.h>
+#include <pdcpp/core/Registry.h>
+#include <pdcpp/core/util.h>
+
+namespace pdcpp
+{
+    /**
+     * Where an entity is. The `SpriteSystem` moves the entity's sprite here.
+     */
+    struct Transform
+    {
+        float x = 0.0f;
+        float y = 0.0f;
+    };
+
+    /**
+     * A bare `LCDSprite` owned by an entity. Unlike a `pdcpp::Sprite` it has no
+     * update, draw, or collision callbacks, it only draws its image wherever
+     * the entity's `Transform` says it should be.
+     *
+     * The sprite is added to the display list when the component is made, and
+     * removed and freed when it's destroyed, as it will be when it's removed
+     * from the entity or the entity is destroyed.
+     */
+    class SpriteComponent
+    {
+    public:
+        /**
+         * @param image the bitmap to draw, which must outlive the component.
+         * @param zIndex the sprite's z index.
+         * @param flip how the bitmap should be flipped.
+         */
+        explicit SpriteComponent(LCDBitmap* image, int16_t zIndex=0, LCDBitmapFlip flip=kBitmapUnflipped);
+        ~SpriteComponent();
+
+        SpriteComponent(SpriteComponent&& other) noexcept;
+        SpriteComponent& operator= (SpriteComponent&& other) noexcept;
+
+        /**
+         * @returns the underlying sprite, for anything this doesn't cover.
+         */
+        [[ nodiscard ]] LCDSprite* getSprite() const { return p_Sprite; }
+
+    private:
+        friend class SpriteSystem;
+        LCDSprite* p_Sprite;
+        float m_SyncedX;
+        float m_SyncedY;
+
+        PDCPP_DECLARE_NON_COPYABLE(SpriteComponent);
+    };
+
+    /**
+     * Moves the sprite of every entity with both a `Transform` and a
+     * `SpriteComponent` to where its transform is, skipping those which
+     * haven't moved since the last sync. Call `sync` once per frame, after
+     * your systems have run and before the sprites are drawn.
+     *
+     * usage:
+     *      pdcpp::SpriteSystem sprites(registry);
+     *      ...
+     *      sprites.sync();
+     *      pdcpp::Sprite::updateAndRedrawAllSprites();
+     */
+    class SpriteSystem
+    {
+    public:
+        explicit SpriteSystem(Registry& registry) : r_Registry(registry) {}
+
+        /**
+         * Pushes changed transforms to their sprites.
+         *
+         * @returns the number of sprites which were moved.
+         */
+        size_t sync();
+
+    private:
+        Registry& r_Registry;
+
+        PDCPP_DECLARE_NON_COPYABLE_NON_MOVABLE(SpriteSystem);
+    };
+}
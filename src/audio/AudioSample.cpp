@@ -9,6 +9,7 @@
  */
 #include <pdcpp/audio/AudioSample.h>
 #include <pdcpp/core/GlobalPlaydateAPI.h>
+#include <pdcpp/core/Log.h>
 #include <pdcpp/audio/WavFile.h>
 
 
@@ -16,10 +17,7 @@ pdcpp::AudioSample::AudioSample(const std::string& filepath)
     : p_Sample(pdcpp::GlobalPlaydateAPI::get()->sound->sample->load(filepath.c_str()))
 {
     if (p_Sample == nullptr)
-    {
-        auto errmsg = "Failed to load audio file at path " + filepath;
-        pdcpp::GlobalPlaydateAPI::get()->system->error(errmsg.c_str());
-    }
+        { PDCPP_LOG_ERROR("Failed to load audio file at path %s", filepath); }
 }
 
 pdcpp::AudioSample::AudioSample(uint8_t* data, SoundFormat format, uint32_t sampleRate, int byteCount, bool shouldOwnData)
@@ -94,13 +92,10 @@ float pdcpp::AudioSample::getLengthInSeconds() const
 
 std::optional<std::unique_ptr<pdcpp::AudioSample>> pdcpp::AudioSample::loadSampleFromFile(const std::string& filename)
 {
-    auto pd = pdcpp::GlobalPlaydateAPI::get();
     std::optional<std::unique_ptr<pdcpp::AudioSample>> rv = std::nullopt;
-    const std::string failMsg = "WARN: failed to open " + filename;
     if (filename.ends_with(".pda")) { rv = std::make_unique<AudioSample>(filename); }
     else if (filename.ends_with(".wav")) { rv = pdcpp::WavFile::loadFromFile(filename); }
-    else { pd->system->logToConsole(failMsg.c_str()); }
-    if (!rv) { pd->system->logToConsole(failMsg.c_str()); }
+    if (!rv) { PDCPP_LOG_WARNING("failed to open %s", filename); }
     return rv;
 }
 
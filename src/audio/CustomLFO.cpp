@@ -10,12 +10,14 @@
 
 #include <pdcpp/audio/CustomLFO.h>
 #include <pdcpp/core/GlobalPlaydateAPI.h>
+#include <pdcpp/core/Profiler.h>
 
 
 float lfoCShimFunction(PDSynthLFO*, void* userData)
 {
     if (userData == nullptr)
         { return 0.0; }
+    PDCPP_PROFILE_AUDIO_SCOPE("CustomLFO::nextValue");
     auto thisPtr = reinterpret_cast<pdcpp::CustomLFO*>(userData);
     return thisPtr->nextValue();
 }
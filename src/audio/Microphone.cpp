@@ -4,9 +4,11 @@
 
 #include "pdcpp/audio/Microphone.h"
 #include "pdcpp/core/GlobalPlaydateAPI.h"
+#include "pdcpp/core/Profiler.h"
 
 static int recordingShim(void *context, int16_t* data, int len)
 {
+    PDCPP_PROFILE_AUDIO_SCOPE("Microphone::dataReceived");
     auto _this = static_cast<pdcpp::Microphone*>(context);
     _this->dataReceived(data, len);
     return _this->isRecording() ? 1 : 0;
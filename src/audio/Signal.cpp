@@ -10,6 +10,7 @@
 
 #include "pdcpp/audio/Signal.h"
 #include <pdcpp/core/GlobalPlaydateAPI.h>
+#include <pdcpp/core/Profiler.h>
 
 float pdcpp::Signal::getValue() const
 {
@@ -28,6 +29,7 @@ void pdcpp::Signal::setScale(float scale)
 
 float stepShim(void* userdata, int* iosamples, float* ifval)
 {
+    PDCPP_PROFILE_AUDIO_SCOPE("CustomSignal::step");
     auto thisPtr = static_cast<pdcpp::CustomSignal*>(userdata);
     return thisPtr->step(iosamples, ifval);
 };
@@ -10,6 +10,7 @@
 
 #include <pdcpp/audio/SoundEffect.h>
 #include "pdcpp/core/GlobalPlaydateAPI.h"
+#include "pdcpp/core/Profiler.h"
 
 void pdcpp::SoundEffect::setMixModulator(const pdcpp::Signal& mod)
     { pdcpp::GlobalPlaydateAPI::get()->sound->effect->setMixModulator(*this, mod); }
@@ -18,6 +19,7 @@ void pdcpp::SoundEffect::setWetDryMix(float mix)
 
 int effectProcBridge(SoundEffect* e, int32_t* left, int32_t* right, int nsamples, int bufactive)
 {
+    PDCPP_PROFILE_AUDIO_SCOPE("CustomSoundEffect::processBlock");
     auto thisPtr = static_cast<pdcpp::CustomSoundEffect*>(pdcpp::GlobalPlaydateAPI::get()->sound->effect->getUserdata(e));
     return thisPtr->processBlock(left, right, nsamples, bufactive);
 }
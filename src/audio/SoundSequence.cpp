@@ -8,6 +8,7 @@
  *  Original author: MrBZapp
  */
 #include <pdcpp/core/GlobalPlaydateAPI.h>
+#include <pdcpp/core/Log.h>
 #include <pdcpp/audio/SoundSequence.h>
 
 
@@ -37,10 +38,7 @@ bool pdcpp::SoundSequence::loadMidiFile(const std::string& filepath)
 {
     auto err = pdcpp::GlobalPlaydateAPI::get()->sound->sequence->loadMIDIFile(p_Sequence, filepath.c_str());
     if (err == 0)
-    {
-        auto msg = "Failed to load " + filepath + ". " + pdcpp::GlobalPlaydateAPI::get()->file->geterr();
-        pdcpp::GlobalPlaydateAPI::get()->system->error(msg.c_str());
-    }
+        { PDCPP_LOG_ERROR("Failed to load %s. %s", filepath, pdcpp::GlobalPlaydateAPI::get()->file->geterr()); }
     return err;
 }
 
@@ -89,9 +87,9 @@ uint32_t pdcpp::SoundSequence::getLength()
     return pdcpp::GlobalPlaydateAPI::get()->sound->sequence->getLength(p_Sequence);
 }
 
-void pdcpp::SoundSequence::play(std::function<void(pdcpp::SoundSequence*)> completeCallback)
+void pdcpp::SoundSequence::play(CompleteCallback completeCallback)
 {
-    m_Callback = completeCallback;
+    m_Callback = std::move(completeCallback);
     pdcpp::GlobalPlaydateAPI::get()->sound->sequence->play(p_Sequence, playCompleteShim, this);
 }
 
@@ -10,6 +10,7 @@
 
 #include <pdcpp/audio/Synthesizer.h>
 #include <pdcpp/core/GlobalPlaydateAPI.h>
+#include <pdcpp/core/Log.h>
 
 pdcpp::Synthesizer::Synthesizer()
     : p_Instrument(pdcpp::GlobalPlaydateAPI::get()->sound->instrument->newInstrument())
@@ -37,7 +38,7 @@ void pdcpp::Synthesizer::addVoice(const pdcpp::SynthesizerVoice& voice, MIDINote
     auto pd = pdcpp::GlobalPlaydateAPI::get();
     auto err = pd->sound->instrument->addVoice(p_Instrument, voice, lowNote, hiNote, transpose);
     if (err == 0)
-        { pd->system->error("Failed to add voice to instrument"); }
+        { PDCPP_LOG_ERROR("Failed to add voice to instrument"); }
 }
 pdcpp::SynthesizerVoiceContainer pdcpp::Synthesizer::noteOn(MIDINote note, float vel, float len, uint32_t when)
     { return pdcpp::SynthesizerVoiceContainer(pdcpp::GlobalPlaydateAPI::get()->sound->instrument->playMIDINote(p_Instrument, note, vel, len, when)); }
@@ -10,6 +10,8 @@
 
 #include <pdcpp/audio/SynthesizerVoice.h>
 #include <pdcpp/core/GlobalPlaydateAPI.h>
+#include <pdcpp/core/Log.h>
+#include <pdcpp/core/Profiler.h>
 
 namespace pdcpp
 {
@@ -19,6 +21,7 @@ namespace pdcpp
         static int render(void* obj,  int32_t* left, int32_t* right, int nsamples, uint32_t rate, int32_t drate)
         {
             if (obj == nullptr) { return 0; }
+            PDCPP_PROFILE_AUDIO_SCOPE("CustomSynthGenerator::renderBlock");
             auto thisPtr = static_cast<pdcpp::CustomSynthGenerator*>(obj);
             return thisPtr->renderBlock(left, right, nsamples, rate, drate);
         };
@@ -84,10 +87,7 @@ void pdcpp:: SynthesizerVoiceContainer::setWavetable(const AudioSample& sample,
     auto err = pdcpp::GlobalPlaydateAPI::get()->sound->synth->setWavetable(p_Synth, sample, log2size, nColumns, nRows);
 
     if (err == 0)
-    {
-        auto errMsg = "Failed to set wavetable, dimensions don't match the sample size.";
-        pdcpp::GlobalPlaydateAPI::get()->system->error(errMsg);
-    }
+        { PDCPP_LOG_ERROR("Failed to set wavetable, dimensions don't match the sample size."); }
 }
 
 pdcpp:: SynthesizerVoiceContainer::operator ::SoundSource*() const
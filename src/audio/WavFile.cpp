@@ -3,61 +3,95 @@
 //
 
 #include "pdcpp/audio/WavFile.h"
-#include "pdcpp/core/File.h"
-
-struct WAVHeader {
-    char riff[4] = {'R', 'I', 'F', 'F'};
-    uint32_t chunkSize;
-    char wave[4] = {'W', 'A', 'V', 'E'};
-    char fmt[4] = {'f', 'm', 't', ' '};
-    uint32_t fmtChunkSize;
-    uint16_t audioFormat;
-    uint16_t numChannels;
-    uint32_t sampleRate;
-    uint32_t byteRate;
-    uint16_t blockAlign;
-    uint16_t bitsPerSample;
-    char data[4] = {'d', 'a', 't', 'a'};
-    uint32_t dataSize;
-};
+#include "pdcpp/core/BufferedFileHandle.h"
+#include "pdcpp/core/MemoryTracker.h"
+
+#include <tuple>
+
+namespace
+{
+    // RIFF chunk ids, as read little-endian.
+    constexpr uint32_t fourCC(const char (&id)[5])
+        { return uint32_t(id[0]) | uint32_t(id[1]) << 8 | uint32_t(id[2]) << 16 | uint32_t(id[3]) << 24; }
+
+    constexpr uint32_t k_Riff = fourCC("RIFF");
+    constexpr uint32_t k_Wave = fourCC("WAVE");
+    constexpr uint32_t k_Fmt = fourCC("fmt ");
+    constexpr uint32_t k_Data = fourCC("data");
+
+    constexpr uint32_t k_FmtChunkSize = 16;
+}
 
 
 std::optional<std::unique_ptr<pdcpp::AudioSample>> pdcpp::WavFile::loadFromFile(const std::string& filename)
 {
-    WAVHeader header{};
-    auto handle = pdcpp::FileHandle(filename, FileOptions::kFileReadData);
-    handle.read(&header, sizeof(WAVHeader));
+    pdcpp::ScopedMemoryTag tag(pdcpp::MemoryTag::Audio);
+    pdcpp::BufferedFileHandle file(filename, FileOptions::kFileReadData);
+    if (!file.isOpen()) { return std::nullopt; }
 
-    const auto riff = std::string(header.riff, header.riff + 4);
-    const auto wave = std::string(header.wave, header.wave + 4);
-    const auto fmtStr = std::string(header.fmt, header.fmt + 3);
-    const auto dataStr = std::string(header.data, header.data + 4);
+    if (file.readLE<uint32_t>() != k_Riff) { return std::nullopt; }
+    std::ignore = file.readLE<uint32_t>(); // RIFF chunk size
+    if (file.readLE<uint32_t>() != k_Wave) { return std::nullopt; }
 
-    if (riff != "RIFF") { return std::nullopt; }
-    if (wave != "WAVE") { return std::nullopt; }
-    if (fmtStr != "fmt") { return std::nullopt; }
-    if (dataStr != "data") { return std::nullopt; }
-    if (header.audioFormat != 1) { return std::nullopt; } // Must be PCM format
-    if (!(header.bitsPerSample == 8 || header.bitsPerSample == 16)) { return std::nullopt; }
-    if (header.numChannels > 2) { return std::nullopt; }
+    uint16_t audioFormat = 0;
+    uint16_t numChannels = 0;
+    uint32_t sampleRate = 0;
+    uint16_t bitsPerSample = 0;
+    uint32_t dataSize = 0;
+    const auto fileSize = file.getDetails().size;
 
-    std::vector<uint8_t> data(header.dataSize, 0);
+    // Walk the chunks up to the data, skipping any besides the format, like
+    // LIST. Skips within the read-ahead don't touch the file system.
+    while (true)
+    {
+        auto chunkId = file.readLE<uint32_t>();
+        dataSize = file.readLE<uint32_t>();
+        if (file.hasFailed()) { return std::nullopt; }
 
-    handle.read(data.data(), header.dataSize);
+        // A chunk running past the end of the file is corrupt, and its size
+        // can't be trusted to skip by, or to allocate for.
+        if (dataSize > fileSize - uint32_t(file.tell())) { return std::nullopt; }
+
+        if (chunkId == k_Data) { break; }
+
+        // Chunks are padded to an even number of bytes.
+        auto skip = dataSize + (dataSize & 1);
+        if (chunkId == k_Fmt)
+        {
+            if (dataSize < k_FmtChunkSize) { return std::nullopt; }
+            audioFormat = file.readLE<uint16_t>();
+            numChannels = file.readLE<uint16_t>();
+            sampleRate = file.readLE<uint32_t>();
+            std::ignore = file.readLE<uint32_t>(); // byte rate
+            std::ignore = file.readLE<uint16_t>(); // block align
+            bitsPerSample = file.readLE<uint16_t>();
+            skip -= k_FmtChunkSize;
+        }
+
+        if (file.seek(int(skip), pdcpp::FileHandle::CURRENT) != 0) { return std::nullopt; }
+    }
+
+    if (audioFormat != 1) { return std::nullopt; } // Must be PCM format
+    if (!(bitsPerSample == 8 || bitsPerSample == 16)) { return std::nullopt; }
+    if (numChannels == 0 || numChannels > 2) { return std::nullopt; }
+
+    // The data is almost all of the file, so this mostly bypasses the buffer.
+    std::vector<uint8_t> data(dataSize, 0);
+    if (file.read(data.data(), dataSize) != int(dataSize)) { return std::nullopt; }
 
     SoundFormat fmt;
 
-    switch(header.bitsPerSample)
+    switch(bitsPerSample)
     {
         case 8:
-            fmt = header.numChannels == 1 ? SoundFormat::kSound8bitMono : SoundFormat::kSound8bitStereo;
+            fmt = numChannels == 1 ? SoundFormat::kSound8bitMono : SoundFormat::kSound8bitStereo;
             break;
         case 16:
-            fmt = header.numChannels == 1 ? SoundFormat::kSound16bitMono : SoundFormat::kSound16bitStereo;
+            fmt = numChannels == 1 ? SoundFormat::kSound16bitMono : SoundFormat::kSound16bitStereo;
             break;
     }
 
-    auto rv = std::make_unique<AudioSampleWithData>(data, fmt, header.sampleRate);
+    auto rv = std::make_unique<AudioSampleWithData>(data, fmt, sampleRate);
     return rv;
 }
 
@@ -65,22 +99,24 @@ void
 pdcpp::WavFile::saveToFile(const std::string& filename, uint8_t* data, uint32_t nBytes, SoundFormat fmt, uint32_t
 sampleRate)
 {
-    WAVHeader header{
-        .chunkSize=nBytes + 36,
-        .fmtChunkSize=16,
-        .audioFormat=1,
-        .numChannels=uint16_t(SoundFormatIsStereo(fmt) ? 2 : 1),
-        .sampleRate=uint16_t(sampleRate),
-        .byteRate=uint16_t(SoundFormat_bytesPerFrame(fmt) * sampleRate),
-        .blockAlign=uint16_t(SoundFormat_bytesPerFrame(fmt)),
-        .bitsPerSample=uint16_t(SoundFormatIs16bit(fmt) ? 16 : 8),
-        .dataSize=nBytes
-    };
-
-    auto handle = pdcpp::FileHandle(filename, FileOptions::kFileWrite);
-
-    handle.write(&header, sizeof(WAVHeader));
-    handle.write(data, nBytes);
+    const auto bytesPerFrame = uint32_t(SoundFormat_bytesPerFrame(fmt));
+    pdcpp::BufferedFileHandle file(filename, FileOptions::kFileWrite);
+
+    // The header is gathered into one write, and the data goes straight out.
+    file.writeLE(k_Riff);
+    file.writeLE(nBytes + 36);
+    file.writeLE(k_Wave);
+    file.writeLE(k_Fmt);
+    file.writeLE(k_FmtChunkSize);
+    file.writeLE(uint16_t(1)); // PCM
+    file.writeLE(uint16_t(SoundFormatIsStereo(fmt) ? 2 : 1));
+    file.writeLE(sampleRate);
+    file.writeLE(bytesPerFrame * sampleRate);
+    file.writeLE(uint16_t(bytesPerFrame));
+    file.writeLE(uint16_t(SoundFormatIs16bit(fmt) ? 16 : 8));
+    file.writeLE(k_Data);
+    file.writeLE(nBytes);
+    file.write(data, nBytes);
 }
 
 void pdcpp::WavFile::saveToFile(const std::string& name, const AudioSample& sample)
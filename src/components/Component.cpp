@@ -12,6 +12,8 @@
 #include <cassert>
 #include "pdcpp/components/Component.h"
 #include "pdcpp/graphics/LookAndFeel.h"
+#include "pdcpp/core/MemoryTracker.h"
+#include "pdcpp/core/Profiler.h"
 
 
 void pdcpp::Component::setBounds(pdcpp::Rectangle<float> bounds)
@@ -24,6 +26,7 @@ pdcpp::Rectangle<float> pdcpp::Component::getBounds() const { return m_Bounds; }
 
 void pdcpp::Component::redraw()
 {
+    PDCPP_PROFILE_SCOPE("Component::redraw");
     draw();
     for (auto* child : m_Children)
         { child->redraw(); }
@@ -37,6 +40,7 @@ void pdcpp::Component::addChildComponent(Component* child)
     // Don't add components to more than one parent
     assert(child->p_Parent == nullptr);
 
+    pdcpp::ScopedMemoryTag tag(pdcpp::MemoryTag::Components);
     m_Children.emplace_back(child);
     child->p_Parent = this;
     child->lookAndFeelChanged();
@@ -8,7 +8,9 @@
 #include "pdcpp/graphics/Colors.h"
 #include "pdcpp/graphics/LookAndFeel.h"
 #include "pdcpp/core/File.h"
+#include "pdcpp/core/FileSystemCache.h"
 #include "pdcpp/core/GlobalPlaydateAPI.h"
+#include "pdcpp/core/MemoryTracker.h"
 
 
 std::string pdcpp::FileList::kParentDir = "../";
@@ -32,13 +34,18 @@ public:
 
 pdcpp::FileList::FileList(const std::string& rootDir, bool showDirectories, bool showHidden, bool includeParentDir)
 {
+    pdcpp::ScopedMemoryTag tag(pdcpp::MemoryTag::Files);
     if (includeParentDir && showDirectories)
         { m_Items.push_back(kParentDir); }
 
-    for (const auto& f : pdcpp::FileHelpers::listFilesInDirectory(rootDir, showHidden))
+    // Directories are listed with a trailing '/', so nothing needs stat-ing.
+    auto listing = pdcpp::FileSystemCache::getDefault().listFiles(rootDir, showHidden);
+    if (listing == nullptr)
+        { return; }
+
+    for (const auto& f : *listing)
     {
-        auto details = pdcpp::FileHelpers::stat(rootDir + f);
-        if (!showDirectories && details.isdir) { continue; }
+        if (!showDirectories && f.ends_with('/')) { continue; }
 
         m_Items.push_back(f);
     }
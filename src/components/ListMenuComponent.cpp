@@ -67,7 +67,7 @@ private:
 };
 
 pdcpp::ListMenuComponent::ListMenuComponent
-(std::vector<MenuItem> menu, std::function<void()> nonAction, bool horizontal)
+(std::vector<MenuItem> menu, Action nonAction, bool horizontal)
     : MenuComponentBase(std::move(menu), std::move(nonAction))
     , m_Horiz(horizontal)
 { setCellFocus(-1, -1, false, false); }
@@ -0,0 +1,71 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <pdcpp/components/MemoryOverlay.h>
+#include <pdcpp/core/MemoryTracker.h>
+#include <pdcpp/graphics/Colors.h>
+#include <pdcpp/graphics/Graphics.h>
+#include <pdcpp/graphics/LookAndFeel.h>
+
+int pdcpp::MemoryOverlay::getRowHeight() const
+    { return getLookAndFeel()->getDefaultFont().getFontHeight() + 2; }
+
+int pdcpp::MemoryOverlay::getIdealHeight() const
+    { return (static_cast<int>(pdcpp::MemoryTag::NumTags) + 1) * getRowHeight() + 2; }
+
+void pdcpp::MemoryOverlay::draw()
+{
+    auto bounds = getBounds().toInt();
+    auto& font = getLookAndFeel()->getDefaultFont();
+    auto rowHeight = getRowHeight();
+    auto labelWidth = bounds.width / 2;
+    auto barWidth = bounds.width - labelWidth - 4;
+
+    pdcpp::Graphics::fillRectangle(bounds, pdcpp::Colors::white);
+    pdcpp::Graphics::drawRectangle(bounds, pdcpp::Colors::black);
+
+    auto drawRow = [&](int row, const char* label, const pdcpp::MemoryTracker::TagStats& stats)
+    {
+        auto y = bounds.y + 1 + row * rowHeight;
+        if (y + rowHeight > bounds.y + bounds.height)
+            { return; }
+
+        font.drawText(label, bounds.x + 2, y + 1);
+
+        auto scale = float(stats.budget > 0 ? stats.budget : std::max<size_t>(stats.highWaterMark, 1));
+        auto toPx = [&](size_t bytes) { return int(std::min(1.0f, float(bytes) / scale) * float(barWidth)); };
+        auto barX = bounds.x + labelWidth;
+        auto overBudget = stats.budget > 0 && stats.bytesInUse > stats.budget;
+
+        pdcpp::Graphics::drawRectangle({barX, y + 2, barWidth, rowHeight - 4}, pdcpp::Colors::black);
+        pdcpp::Graphics::fillRectangle({barX, y + 2, toPx(stats.bytesInUse), rowHeight - 4},
+                                       overBudget ? pdcpp::Colors::solid50GrayA : pdcpp::Colors::black);
+
+        auto highX = barX + toPx(stats.highWaterMark);
+        pdcpp::Graphics::drawLine({highX, y + 1}, {highX, y + rowHeight - 2}, 1, kColorXOR);
+    };
+
+    char label[48];
+    auto& total = pdcpp::MemoryTracker::getTotalStats();
+    std::snprintf(label, sizeof(label), "total %.1fk %lu/f", float(total.bytesInUse) / 1024.0f,
+                  static_cast<unsigned long>(total.frameAllocations));
+    drawRow(0, label, total);
+
+    for (int i = 0; i < static_cast<int>(pdcpp::MemoryTag::NumTags); ++i)
+    {
+        auto tag = static_cast<pdcpp::MemoryTag>(i);
+        auto& stats = pdcpp::MemoryTracker::getStats(tag);
+        std::snprintf(label, sizeof(label), "%s %.1fk", pdcpp::MemoryTracker::getTagName(tag),
+                      float(stats.bytesInUse) / 1024.0f);
+        drawRow(i + 1, label, stats);
+    }
+}
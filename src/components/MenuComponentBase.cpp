@@ -5,7 +5,7 @@
 #include "pdcpp/components/MenuComponentBase.h"
 #include "pdcpp/core/util.h"
 
-pdcpp::MenuComponentBase::MenuComponentBase(std::vector<MenuItem> menu, std::function<void()> nonAction)
+pdcpp::MenuComponentBase::MenuComponentBase(std::vector<MenuItem> menu, Action nonAction)
     : m_Menu(std::move(menu))
     , m_AbortAction(std::move(nonAction))
     , m_Selected(-1)
@@ -0,0 +1,64 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <pdcpp/components/ProfilerOverlay.h>
+#include <pdcpp/core/Profiler.h>
+#include <pdcpp/graphics/Colors.h>
+#include <pdcpp/graphics/Graphics.h>
+#include <pdcpp/graphics/LookAndFeel.h>
+
+pdcpp::ProfilerOverlay::ProfilerOverlay(float budgetMs, int nFrames)
+    : m_BudgetMs(budgetMs)
+    , m_NFrames(nFrames)
+{}
+
+int pdcpp::ProfilerOverlay::getRowHeight() const
+    { return getLookAndFeel()->getDefaultFont().getFontHeight() + 2; }
+
+int pdcpp::ProfilerOverlay::getIdealHeight() const
+    { return (pdcpp::Profiler::getNumZones() + 1) * getRowHeight() + 2; }
+
+void pdcpp::ProfilerOverlay::draw()
+{
+    auto bounds = getBounds().toInt();
+    auto& font = getLookAndFeel()->getDefaultFont();
+    auto rowHeight = getRowHeight();
+    auto labelWidth = bounds.width / 2;
+    auto barWidth = bounds.width - labelWidth - 4;
+    auto budgetUs = m_BudgetMs * 1000.0f;
+
+    pdcpp::Graphics::fillRectangle(bounds, pdcpp::Colors::white);
+    pdcpp::Graphics::drawRectangle(bounds, pdcpp::Colors::black);
+
+    auto drawRow = [&](int row, const pdcpp::Profiler::Stats& stats)
+    {
+        auto y = bounds.y + 1 + row * rowHeight;
+        if (y + rowHeight > bounds.y + bounds.height)
+            { return; }
+
+        char label[48];
+        std::snprintf(label, sizeof(label), "%s %.2f", stats.name, float(stats.avgUs) / 1000.0f);
+        font.drawText(label, bounds.x + 2, y + 1);
+
+        auto barX = bounds.x + labelWidth;
+        auto toPx = [&](uint32_t us) { return int(std::min(1.0f, float(us) / budgetUs) * float(barWidth)); };
+        pdcpp::Graphics::drawRectangle({barX, y + 2, barWidth, rowHeight - 4}, pdcpp::Colors::black);
+        pdcpp::Graphics::fillRectangle({barX, y + 2, toPx(stats.avgUs), rowHeight - 4}, pdcpp::Colors::black);
+
+        auto maxX = barX + toPx(stats.maxUs);
+        pdcpp::Graphics::drawLine({maxX, y + 1}, {maxX, y + rowHeight - 2}, 1, kColorXOR);
+    };
+
+    drawRow(0, pdcpp::Profiler::getFrameStats(m_NFrames));
+    for (int i = 0; i < pdcpp::Profiler::getNumZones(); ++i)
+        { drawRow(i + 1, pdcpp::Profiler::getZoneStats(i, m_NFrames)); }
+}
@@ -33,18 +33,18 @@ void pdcpp::RingMenuComponent::drawSplitCircle(const pdcpp::Rectangle<int>& boun
         pdcpp::Graphics::drawEllipse(bounds, 2, startAngle, endAngle);
         pdcpp::Graphics::drawEllipse(innerBounds, 2, startAngle, endAngle);
 
-        auto lineStart = outerPoint.rotated(center, pdcpp::degToRad(startAngle));
-        auto lineEnd = innerPoint.rotated(center, pdcpp::degToRad(startAngle));
+        auto lineStart = outerPoint.rotated(center, pdcpp::degToRad(startAngle), pdcpp::FastMath::useTables);
+        auto lineEnd = innerPoint.rotated(center, pdcpp::degToRad(startAngle), pdcpp::FastMath::useTables);
         pdcpp::Graphics::drawLine(lineStart, lineEnd, 2);
 
-        lineStart = outerPoint.rotated(center, pdcpp::degToRad(endAngle));
-        lineEnd = innerPoint.rotated(center, pdcpp::degToRad(endAngle));
+        lineStart = outerPoint.rotated(center, pdcpp::degToRad(endAngle), pdcpp::FastMath::useTables);
+        lineEnd = innerPoint.rotated(center, pdcpp::degToRad(endAngle), pdcpp::FastMath::useTables);
         pdcpp::Graphics::drawLine(lineStart, lineEnd, 2);
     }
 }
 
 pdcpp::RingMenuComponent::RingMenuComponent(
-    std::vector<MenuItem> menu, std::function<void()> nonAction, float rotationDegrees)
+    std::vector<MenuItem> menu, Action nonAction, float rotationDegrees)
     : MenuComponentBase(std::move(menu), std::move(nonAction))
     , m_Rotation(rotationDegrees)
 {}
@@ -72,7 +72,8 @@ pdcpp::Image pdcpp::RingMenuComponent::buildPreRenderedImage()
         for (auto& item : menu)
         {
             auto iconBounds = item.getBounds(getLookAndFeel()->getDefaultFont());
-            iconBounds = iconBounds.withEdgeInEllipse(bounds.reduced(thickness + gap),  pdcpp::degToRad(currentAngle - 90));
+            iconBounds = iconBounds.withEdgeInEllipse(bounds.reduced(thickness + gap), pdcpp::degToRad(currentAngle - 90),
+                                                      pdcpp::FastMath::useTables);
 
             std::visit(
                 Overload
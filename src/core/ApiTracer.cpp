@@ -0,0 +1,365 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#include <pdcpp/core/ApiTracer.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <type_traits>
+
+#define PDCPP_TRACE_SYSTEM_FUNCTIONS(X) \
+    X(realloc) X(getLanguage) X(getCurrentTimeMilliseconds) X(getSecondsSinceEpoch) X(drawFPS) \
+    X(setUpdateCallback) X(getButtonState) X(setPeripheralsEnabled) X(getAccelerometer) X(getCrankChange) \
+    X(getCrankAngle) X(isCrankDocked) X(setCrankSoundsDisabled) X(getFlipped) X(setAutoLockDisabled) \
+    X(setMenuImage) X(addMenuItem) X(addCheckmarkMenuItem) X(addOptionsMenuItem) X(removeAllMenuItems) \
+    X(removeMenuItem) X(getMenuItemValue) X(setMenuItemValue) X(getMenuItemTitle) X(setMenuItemTitle) \
+    X(getMenuItemUserdata) X(setMenuItemUserdata) X(getReduceFlashing) X(getElapsedTime) X(resetElapsedTime) \
+    X(getBatteryPercentage) X(getBatteryVoltage) X(getTimezoneOffset) X(shouldDisplay24HourTime) \
+    X(convertEpochToDateTime) X(convertDateTimeToEpoch) X(clearICache) X(setButtonCallback) \
+    X(setSerialMessageCallback) X(vaFormatString)
+
+#define PDCPP_TRACE_FILE_FUNCTIONS(X) \
+    X(geterr) X(listfiles) X(stat) X(mkdir) X(unlink) X(rename) X(open) X(close) X(read) X(write) X(flush) \
+    X(tell) X(seek)
+
+#define PDCPP_TRACE_GRAPHICS_FUNCTIONS(X) \
+    X(clear) X(setBackgroundColor) X(setStencil) X(setDrawMode) X(setDrawOffset) X(setClipRect) X(clearClipRect) \
+    X(setLineCapStyle) X(setFont) X(setTextTracking) X(pushContext) X(popContext) X(drawBitmap) X(tileBitmap) \
+    X(drawLine) X(fillTriangle) X(drawRect) X(fillRect) X(drawEllipse) X(fillEllipse) X(drawScaledBitmap) \
+    X(drawText) X(newBitmap) X(freeBitmap) X(loadBitmap) X(copyBitmap) X(loadIntoBitmap) X(getBitmapData) \
+    X(clearBitmap) X(rotatedBitmap) X(newBitmapTable) X(freeBitmapTable) X(loadBitmapTable) \
+    X(loadIntoBitmapTable) X(getTableBitmap) X(loadFont) X(getFontPage) X(getPageGlyph) X(getGlyphKerning) \
+    X(getTextWidth) X(getFrame) X(getDisplayFrame) X(getDebugBitmap) X(copyFrameBufferBitmap) \
+    X(markUpdatedRows) X(display) X(setColorToPattern) X(checkMaskCollision) X(setScreenClipRect) \
+    X(fillPolygon) X(getFontHeight) X(getDisplayBufferBitmap) X(drawRotatedBitmap) X(setTextLeading) \
+    X(setBitmapMask) X(getBitmapMask) X(setStencilImage) X(makeFontFromData) X(getTextTracking) X(setPixel) \
+    X(getBitmapPixel) X(getBitmapTableInfo)
+
+#define PDCPP_TRACE_SPRITE_FUNCTIONS(X) \
+    X(setAlwaysRedraw) X(addDirtyRect) X(drawSprites) X(updateAndDrawSprites) X(newSprite) X(freeSprite) \
+    X(copy) X(addSprite) X(removeSprite) X(removeSprites) X(removeAllSprites) X(getSpriteCount) X(setBounds) \
+    X(getBounds) X(moveTo) X(moveBy) X(setImage) X(getImage) X(setSize) X(setZIndex) X(getZIndex) \
+    X(setDrawMode) X(setImageFlip) X(getImageFlip) X(setStencil) X(setClipRect) X(clearClipRect) \
+    X(setClipRectsInRange) X(clearClipRectsInRange) X(setUpdatesEnabled) X(updatesEnabled) \
+    X(setCollisionsEnabled) X(collisionsEnabled) X(setVisible) X(isVisible) X(setOpaque) X(markDirty) \
+    X(setTag) X(getTag) X(setIgnoresDrawOffset) X(setUpdateFunction) X(setDrawFunction) X(getPosition) \
+    X(resetCollisionWorld) X(setCollideRect) X(getCollideRect) X(clearCollideRect) \
+    X(setCollisionResponseFunction) X(checkCollisions) X(moveWithCollisions) X(querySpritesAtPoint) \
+    X(querySpritesInRect) X(querySpritesAlongLine) X(querySpriteInfoAlongLine) X(overlappingSprites) \
+    X(allOverlappingSprites) X(setStencilPattern) X(clearStencil) X(setUserdata) X(getUserdata) \
+    X(setStencilImage) X(setCenter) X(getCenter)
+
+#define PDCPP_TRACE_DISPLAY_FUNCTIONS(X) \
+    X(getWidth) X(getHeight) X(setRefreshRate) X(setInverted) X(setScale) X(setMosaic) X(setFlipped) X(setOffset)
+
+#define PDCPP_TRACE_SOUND_FUNCTIONS(X) \
+    X(getCurrentTime) X(addSource) X(getDefaultChannel) X(addChannel) X(removeChannel) X(setMicCallback) \
+    X(getHeadphoneState) X(setOutputsActive) X(removeSource) X(getError)
+
+#define PDCPP_TRACE_CHANNEL_FUNCTIONS(X) \
+    X(newChannel) X(freeChannel) X(addSource) X(removeSource) X(addCallbackSource) X(addEffect) X(removeEffect) \
+    X(setVolume) X(getVolume) X(setVolumeModulator) X(getVolumeModulator) X(setPan) X(setPanModulator) \
+    X(getPanModulator) X(getDryLevelSignal) X(getWetLevelSignal)
+
+#define PDCPP_TRACE_EFFECT_FUNCTIONS(X) \
+    X(newEffect) X(freeEffect) X(setMix) X(setMixModulator) X(getMixModulator) X(setUserdata) X(getUserdata)
+
+#define PDCPP_TRACE_SOURCE_FUNCTIONS(X) \
+    X(setVolume) X(getVolume) X(isPlaying) X(setFinishCallback)
+
+#define PDCPP_TRACE_SAMPLE_FUNCTIONS(X) \
+    X(newSampleBuffer) X(loadIntoSample) X(load) X(newSampleFromData) X(getData) X(freeSample) X(getLength) \
+    X(decompress)
+
+#define PDCPP_TRACE_SAMPLEPLAYER_FUNCTIONS(X) \
+    X(newPlayer) X(freePlayer) X(setSample) X(play) X(isPlaying) X(stop) X(setVolume) X(getVolume) X(getLength) \
+    X(setOffset) X(setRate) X(setPlayRange) X(setFinishCallback) X(setLoopCallback) X(getOffset) X(getRate) \
+    X(setPaused)
+
+#define PDCPP_TRACE_SYNTH_FUNCTIONS(X) \
+    X(newSynth) X(freeSynth) X(setWaveform) X(setSample) X(setAttackTime) X(setDecayTime) X(setSustainLevel) \
+    X(setReleaseTime) X(setTranspose) X(setFrequencyModulator) X(getFrequencyModulator) X(setAmplitudeModulator) \
+    X(getAmplitudeModulator) X(getParameterCount) X(setParameter) X(setParameterModulator) \
+    X(getParameterModulator) X(playNote) X(playMIDINote) X(noteOff) X(stop) X(setVolume) X(getVolume) \
+    X(isPlaying) X(getEnvelope) X(setWavetable) X(setGenerator) X(copy) X(clearEnvelope)
+
+#define PDCPP_TRACE_LFO_FUNCTIONS(X) \
+    X(newLFO) X(freeLFO) X(setType) X(setRate) X(setPhase) X(setCenter) X(setDepth) X(setArpeggiation) \
+    X(setFunction) X(setDelay) X(setRetrigger) X(getValue) X(setGlobal) X(setStartPhase)
+
+
+namespace
+{
+    struct Record
+    {
+        uint64_t calls;
+        uint64_t timeUs;
+        uint32_t frameCalls;
+        uint32_t frameTimeUs;
+        uint32_t lastFrameCalls;
+        uint32_t lastFrameTimeUs;
+    };
+
+    struct Counter
+    {
+        const char* name;
+        Record* record;
+    };
+
+    std::vector<Counter> g_Counters;
+    bool g_Timing = true;
+    void (*g_OnEnter)() = nullptr;
+    void (*g_OnExit)() = nullptr;
+
+    // The backend's tables, one per table type, for the thunks to call into.
+    template <typename Table>
+    Table g_Backend {};
+
+    float backendSeconds() { return g_Backend<playdate_sys>.getElapsedTime(); }
+
+    // Marks the start and end of a traced call, and times it if asked.
+    class TracedCall
+    {
+    public:
+        explicit TracedCall(Record& record)
+            : r_Record(record)
+            , m_Start(g_Timing ? backendSeconds() : 0.0f)
+        {
+            ++r_Record.calls;
+            ++r_Record.frameCalls;
+            if (g_OnEnter != nullptr)
+                { g_OnEnter(); }
+        }
+
+        ~TracedCall()
+        {
+            if (g_OnExit != nullptr)
+                { g_OnExit(); }
+
+            // The elapsed time can be reset from within the call, in which
+            // case the call goes untimed.
+            if (!g_Timing)
+                { return; }
+            auto us = static_cast<uint32_t>(std::max(0.0f, backendSeconds() - m_Start) * 1000000.0f);
+            r_Record.timeUs += us;
+            r_Record.frameTimeUs += us;
+        }
+
+    private:
+        Record& r_Record;
+        float m_Start;
+    };
+
+    template <auto Member>
+    struct Thunk;
+
+    template <typename Table, typename R, typename... Args, R (*Table::*Member)(Args...)>
+    struct Thunk<Member>
+    {
+        inline static Record record {};
+
+        static R call(Args... args)
+        {
+            TracedCall traced(record);
+            return (g_Backend<Table>.*Member)(args...);
+        }
+    };
+}
+
+pdcpp::ApiTracer::ApiTracer(PlaydateAPI* backend)
+    : p_Backend(backend)
+{
+    auto trace = []<typename Table>(Table& table, const Table* source)
+    {
+        g_Backend<Table> = *source;
+        table = *source;
+    };
+
+    trace(m_System, backend->system);
+    trace(m_File, backend->file);
+    trace(m_Graphics, backend->graphics);
+    trace(m_Sprite, backend->sprite);
+    trace(m_Display, backend->display);
+    trace(m_Sound, backend->sound);
+    trace(m_Channel, backend->sound->channel);
+    trace(m_Effect, backend->sound->effect);
+    trace(m_Source, backend->sound->source);
+    trace(m_Sample, backend->sound->sample);
+    trace(m_SamplePlayer, backend->sound->sampleplayer);
+    trace(m_Synth, backend->sound->synth);
+    trace(m_LFO, backend->sound->lfo);
+
+    g_Counters.clear();
+
+    // The lists name members from recent SDKs. Checking for each one inside
+    // a template means a table from an older SDK just goes without them,
+    // rather than failing to compile.
+#define PDCPP_TRACE_WRAP(table, name, member) \
+    [&]<typename Table>(Table& t) \
+    { \
+        if constexpr (requires { t.member; }) \
+        { \
+            if (t.member != nullptr) \
+            { \
+                using Traced = Thunk<&Table::member>; \
+                t.member = &Traced::call; \
+                g_Counters.push_back({name "." #member, &Traced::record}); \
+            } \
+        } \
+    }(table);
+
+#define PDCPP_TRACE_SYSTEM(member) PDCPP_TRACE_WRAP(m_System, "system", member)
+#define PDCPP_TRACE_FILE(member) PDCPP_TRACE_WRAP(m_File, "file", member)
+#define PDCPP_TRACE_GRAPHICS(member) PDCPP_TRACE_WRAP(m_Graphics, "graphics", member)
+#define PDCPP_TRACE_SPRITE(member) PDCPP_TRACE_WRAP(m_Sprite, "sprite", member)
+#define PDCPP_TRACE_DISPLAY(member) PDCPP_TRACE_WRAP(m_Display, "display", member)
+#define PDCPP_TRACE_SOUND(member) PDCPP_TRACE_WRAP(m_Sound, "sound", member)
+#define PDCPP_TRACE_CHANNEL(member) PDCPP_TRACE_WRAP(m_Channel, "sound.channel", member)
+#define PDCPP_TRACE_EFFECT(member) PDCPP_TRACE_WRAP(m_Effect, "sound.effect", member)
+#define PDCPP_TRACE_SOURCE(member) PDCPP_TRACE_WRAP(m_Source, "sound.source", member)
+#define PDCPP_TRACE_SAMPLE(member) PDCPP_TRACE_WRAP(m_Sample, "sound.sample", member)
+#define PDCPP_TRACE_SAMPLEPLAYER(member) PDCPP_TRACE_WRAP(m_SamplePlayer, "sound.sampleplayer", member)
+#define PDCPP_TRACE_SYNTH(member) PDCPP_TRACE_WRAP(m_Synth, "sound.synth", member)
+#define PDCPP_TRACE_LFO(member) PDCPP_TRACE_WRAP(m_LFO, "sound.lfo", member)
+
+    PDCPP_TRACE_SYSTEM_FUNCTIONS(PDCPP_TRACE_SYSTEM)
+    PDCPP_TRACE_FILE_FUNCTIONS(PDCPP_TRACE_FILE)
+    PDCPP_TRACE_GRAPHICS_FUNCTIONS(PDCPP_TRACE_GRAPHICS)
+    PDCPP_TRACE_SPRITE_FUNCTIONS(PDCPP_TRACE_SPRITE)
+    PDCPP_TRACE_DISPLAY_FUNCTIONS(PDCPP_TRACE_DISPLAY)
+    PDCPP_TRACE_SOUND_FUNCTIONS(PDCPP_TRACE_SOUND)
+    PDCPP_TRACE_CHANNEL_FUNCTIONS(PDCPP_TRACE_CHANNEL)
+    PDCPP_TRACE_EFFECT_FUNCTIONS(PDCPP_TRACE_EFFECT)
+    PDCPP_TRACE_SOURCE_FUNCTIONS(PDCPP_TRACE_SOURCE)
+    PDCPP_TRACE_SAMPLE_FUNCTIONS(PDCPP_TRACE_SAMPLE)
+    PDCPP_TRACE_SAMPLEPLAYER_FUNCTIONS(PDCPP_TRACE_SAMPLEPLAYER)
+    PDCPP_TRACE_SYNTH_FUNCTIONS(PDCPP_TRACE_SYNTH)
+    PDCPP_TRACE_LFO_FUNCTIONS(PDCPP_TRACE_LFO)
+
+#undef PDCPP_TRACE_LFO
+#undef PDCPP_TRACE_SYNTH
+#undef PDCPP_TRACE_SAMPLEPLAYER
+#undef PDCPP_TRACE_SAMPLE
+#undef PDCPP_TRACE_SOURCE
+#undef PDCPP_TRACE_EFFECT
+#undef PDCPP_TRACE_CHANNEL
+#undef PDCPP_TRACE_SOUND
+#undef PDCPP_TRACE_DISPLAY
+#undef PDCPP_TRACE_SPRITE
+#undef PDCPP_TRACE_GRAPHICS
+#undef PDCPP_TRACE_FILE
+#undef PDCPP_TRACE_SYSTEM
+#undef PDCPP_TRACE_WRAP
+
+    m_Sound.channel = &m_Channel;
+    m_Sound.effect = &m_Effect;
+    m_Sound.source = &m_Source;
+    m_Sound.sample = &m_Sample;
+    m_Sound.sampleplayer = &m_SamplePlayer;
+    m_Sound.synth = &m_Synth;
+    m_Sound.lfo = &m_LFO;
+
+    m_Api = *backend;
+    m_Api.system = &m_System;
+    m_Api.file = &m_File;
+    m_Api.graphics = &m_Graphics;
+    m_Api.sprite = &m_Sprite;
+    m_Api.display = &m_Display;
+    m_Api.sound = &m_Sound;
+
+    reset();
+}
+
+pdcpp::ApiTracer::~ApiTracer()
+{
+    g_Counters.clear();
+    g_OnEnter = nullptr;
+    g_OnExit = nullptr;
+    g_Timing = true;
+}
+
+void pdcpp::ApiTracer::setTimingEnabled(bool shouldTime) { g_Timing = shouldTime; }
+
+void pdcpp::ApiTracer::setCallHooks(void (*onEnter)(), void (*onExit)())
+{
+    g_OnEnter = onEnter;
+    g_OnExit = onExit;
+}
+
+void pdcpp::ApiTracer::endFrame()
+{
+    for (auto& counter : g_Counters)
+    {
+        auto& record = *counter.record;
+        record.lastFrameCalls = record.frameCalls;
+        record.lastFrameTimeUs = record.frameTimeUs;
+        record.frameCalls = 0;
+        record.frameTimeUs = 0;
+    }
+    ++m_NFrames;
+}
+
+void pdcpp::ApiTracer::reset()
+{
+    for (auto& counter : g_Counters)
+        { *counter.record = {}; }
+    m_NFrames = 0;
+}
+
+uint64_t pdcpp::ApiTracer::getTotalCalls() const
+{
+    uint64_t total = 0;
+    for (auto& counter : g_Counters)
+        { total += counter.record->calls; }
+    return total;
+}
+
+std::vector<pdcpp::ApiTracer::FunctionStats> pdcpp::ApiTracer::getStats() const
+{
+    std::vector<FunctionStats> result;
+    for (auto& counter : g_Counters)
+    {
+        auto& record = *counter.record;
+        if (record.calls > 0)
+            { result.push_back({counter.name, record.calls, record.timeUs, record.lastFrameCalls, record.lastFrameTimeUs}); }
+    }
+
+    std::sort(result.begin(), result.end(), [](auto& a, auto& b) { return a.calls > b.calls; });
+    return result;
+}
+
+bool pdcpp::ApiTracer::writeReport(const std::string& path) const
+{
+    auto file = p_Backend->file;
+    auto handle = file->open(path.c_str(), kFileWrite);
+    if (handle == nullptr)
+        { return false; }
+
+    auto written = true;
+    auto writeLine = [&](const char* line, int length)
+    {
+        if (length > 0)
+            { written = file->write(handle, line, static_cast<unsigned int>(length)) == length && written; }
+    };
+
+    char line[160];
+    writeLine(line, std::snprintf(line, sizeof(line), "function,calls,time_us,calls_per_frame,last_frame_calls,last_frame_time_us\n"));
+    for (auto& stats : getStats())
+    {
+        auto perFrame = m_NFrames > 0 ? double(stats.calls) / m_NFrames : 0.0;
+        writeLine(line, std::snprintf(line, sizeof(line), "%s,%llu,%llu,%.2f,%lu,%lu\n", stats.name,
+                                      static_cast<unsigned long long>(stats.calls),
+                                      static_cast<unsigned long long>(stats.timeUs), perFrame,
+                                      static_cast<unsigned long>(stats.lastFrameCalls),
+                                      static_cast<unsigned long>(stats.lastFrameTimeUs)));
+    }
+
+    return file->close(handle) == 0 && written;
+}
@@ -0,0 +1,115 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#include <pdcpp/core/AssetLoader.h>
+
+#include <algorithm>
+#include <pdcpp/audio/AudioSample.h>
+#include <pdcpp/core/Profiler.h>
+#include <pdcpp/graphics/Font.h>
+#include <pdcpp/graphics/Image.h>
+#include <pdcpp/graphics/ImageTable.h>
+
+namespace
+{
+    std::unique_ptr<pdcpp::AssetLoader> g_DefaultLoader;
+
+    // The wrappers load in their constructors, and are left holding nullptr
+    // when they fail.
+    template <typename T>
+    std::unique_ptr<T> loadWrapper(const std::string& path)
+    {
+        auto asset = std::make_unique<T>(path);
+        return static_cast<bool>(*asset) ? std::move(asset) : nullptr;
+    }
+}
+
+pdcpp::AssetLoader::AssetLoader(float frameBudgetMs)
+    : m_Budget(frameBudgetMs)
+{}
+
+pdcpp::AssetLoader::Handle<pdcpp::Image> pdcpp::AssetLoader::loadImage(const std::string& path, int priority)
+    { return load<Image>(path, loadWrapper<Image>, priority); }
+
+pdcpp::AssetLoader::Handle<pdcpp::ImageTable> pdcpp::AssetLoader::loadImageTable(const std::string& path, int priority)
+    { return load<ImageTable>(path, loadWrapper<ImageTable>, priority); }
+
+pdcpp::AssetLoader::Handle<pdcpp::Font> pdcpp::AssetLoader::loadFont(const std::string& path, int priority)
+    { return load<Font>(path, loadWrapper<Font>, priority); }
+
+pdcpp::AssetLoader::Handle<pdcpp::AudioSample> pdcpp::AssetLoader::loadSample(const std::string& path, int priority)
+{
+    auto loadFunction = [](const std::string& samplePath) -> std::unique_ptr<AudioSample>
+    {
+        auto sample = AudioSample::loadSampleFromFile(samplePath);
+        if (!sample.has_value() || *sample == nullptr || static_cast<::AudioSample*>(**sample) == nullptr)
+            { return nullptr; }
+        return std::move(*sample);
+    };
+    return load<AudioSample>(path, loadFunction, priority);
+}
+
+void pdcpp::AssetLoader::update()
+{
+    PDCPP_PROFILE_SCOPE("AssetLoader::update");
+
+    m_Budget.start();
+    auto loadedOne = false;
+    while (!m_Queue.empty() && !(loadedOne && m_Budget.isSpent()))
+    {
+        auto slot = m_Queue.top().slot;
+        m_Queue.pop();
+        --slot->nQueued;
+
+        // Already loaded from a higher priority request for the same path.
+        if (slot->state != State::Queued)
+            { continue; }
+
+        // Nothing but the queue wants it any more.
+        if (slot.use_count() == 1 + slot->nQueued)
+        {
+            slot->state = State::Failed;
+            --m_Progress.total;
+            continue;
+        }
+
+        slot->load();
+        loadedOne = true;
+        ++m_Progress.completed;
+        if (slot->state == State::Failed)
+            { ++m_Progress.failed; }
+    }
+
+    if (m_Queue.empty())
+        { std::erase_if(m_Slots, [](const auto& entry) { return entry.second.expired(); }); }
+}
+
+void pdcpp::AssetLoader::setFrameBudget(float budgetMs) { m_Budget.setBudget(budgetMs); }
+
+pdcpp::AssetLoader& pdcpp::AssetLoader::getDefault()
+{
+    if (g_DefaultLoader == nullptr)
+        { g_DefaultLoader = std::make_unique<AssetLoader>(); }
+    return *g_DefaultLoader;
+}
+
+void pdcpp::AssetLoader::enqueue(std::shared_ptr<SlotBase> slot, int priority, bool isNewLoad)
+{
+    if (isNewLoad)
+    {
+        // Progress starts over with the first request after going idle.
+        if (m_Progress.completed == m_Progress.total)
+            { m_Progress = {}; }
+        ++m_Progress.total;
+    }
+
+    ++slot->nQueued;
+    m_Queue.push({priority, m_NextSequence++, std::move(slot)});
+}
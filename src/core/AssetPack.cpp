@@ -0,0 +1,173 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#include <pdcpp/core/AssetPack.h>
+
+#include <algorithm>
+#include <limits>
+#include <pdcpp/core/Log.h>
+#include <pdcpp/core/MemoryTracker.h>
+
+namespace
+{
+    uint32_t readU32(const uint8_t* bytes)
+        { return uint32_t(bytes[0]) | uint32_t(bytes[1]) << 8 | uint32_t(bytes[2]) << 16 | uint32_t(bytes[3]) << 24; }
+
+    // Forces the next read to seek.
+    constexpr uint32_t k_UnknownPosition = std::numeric_limits<uint32_t>::max();
+}
+
+pdcpp::AssetPack::AssetPack(const std::string& path)
+    : m_Handle(path, static_cast<FileOptions>(kFileRead | kFileReadData))
+{
+    if (!m_Handle.isOpen())
+        { return; }
+
+    uint8_t header[k_HeaderSize];
+    if (m_Handle.read(header, k_HeaderSize) != int(k_HeaderSize)
+        || readU32(header) != k_Magic
+        || readU32(header + 4) != k_Version)
+    {
+        PDCPP_LOG_ERROR("%s is not an asset pack", path);
+        return;
+    }
+
+    const auto nEntries = readU32(header + 8);
+    const auto pathsSize = readU32(header + 12);
+
+    // The counts are checked against the file before anything is allocated
+    // for them, as a corrupt header could ask for gigabytes, or overflow on
+    // the device.
+    const auto packSize = m_Handle.getDetails().size;
+    const auto afterHeader = packSize > k_HeaderSize ? packSize - k_HeaderSize : 0;
+    if (nEntries > afterHeader / k_EntrySize || pathsSize > afterHeader - nEntries * k_EntrySize)
+    {
+        PDCPP_LOG_ERROR("The index of %s is truncated", path);
+        return;
+    }
+    const auto indexSize = size_t(nEntries) * k_EntrySize;
+
+    // The index and the paths are read in one go.
+    pdcpp::ScopedMemoryTag tag(pdcpp::MemoryTag::Files);
+    std::vector<uint8_t> index(indexSize + pathsSize);
+    if (m_Handle.read(index.data(), static_cast<unsigned int>(index.size())) != int(index.size()))
+    {
+        PDCPP_LOG_ERROR("The index of %s is truncated", path);
+        return;
+    }
+
+    m_Entries.reserve(nEntries);
+    for (uint32_t i = 0; i < nEntries; ++i)
+    {
+        auto bytes = index.data() + size_t(i) * k_EntrySize;
+        Entry entry {readU32(bytes), readU32(bytes + 4), readU32(bytes + 8), readU32(bytes + 12), readU32(bytes + 16)};
+        if (uint64_t(entry.pathOffset) + entry.pathLength > pathsSize
+            || uint64_t(entry.offset) + entry.size > packSize)
+        {
+            PDCPP_LOG_ERROR("The index of %s is corrupt", path);
+            m_Entries.clear();
+            return;
+        }
+        m_Entries.push_back(entry);
+    }
+
+    m_Paths.assign(index.begin() + std::ptrdiff_t(indexSize), index.end());
+    m_HeadPosition = k_HeaderSize + uint32_t(index.size());
+    m_Loaded = true;
+}
+
+const pdcpp::AssetPack::Entry* pdcpp::AssetPack::find(std::string_view path) const
+{
+    const auto hash = hashPath(path);
+    auto it = std::lower_bound(m_Entries.begin(), m_Entries.end(), hash,
+                               [](const Entry& entry, uint32_t h) { return entry.hash < h; });
+
+    for (; it != m_Entries.end() && it->hash == hash; ++it)
+    {
+        if (getPath(*it) == path)
+            { return &*it; }
+    }
+    return nullptr;
+}
+
+std::optional<pdcpp::AssetPack::File> pdcpp::AssetPack::open(std::string_view path)
+{
+    auto entry = find(path);
+    if (entry == nullptr)
+        { return std::nullopt; }
+    return File(this, *entry);
+}
+
+std::optional<std::vector<uint8_t>> pdcpp::AssetPack::load(std::string_view path)
+{
+    auto file = open(path);
+    if (!file)
+        { return std::nullopt; }
+
+    std::vector<uint8_t> data(file->getSize());
+    if (file->read(data.data(), static_cast<unsigned int>(data.size())) != int(data.size()))
+        { return std::nullopt; }
+    return data;
+}
+
+std::string_view pdcpp::AssetPack::getPath(const Entry& entry) const
+    { return {m_Paths.data() + entry.pathOffset, entry.pathLength}; }
+
+int pdcpp::AssetPack::readAt(uint32_t offset, void* buffer, unsigned int length)
+{
+    if (m_HeadPosition != offset)
+    {
+        if (m_Handle.seek(int(offset), FileHandle::SET) != 0)
+        {
+            m_HeadPosition = k_UnknownPosition;
+            return -1;
+        }
+        m_HeadPosition = offset;
+    }
+
+    auto nRead = m_Handle.read(buffer, length);
+    m_HeadPosition = nRead >= 0 ? m_HeadPosition + uint32_t(nRead) : k_UnknownPosition;
+    return nRead;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+pdcpp::AssetPack::File::File(AssetPack* pack, const Entry& entry)
+    : p_Pack(pack)
+    , m_Entry(entry)
+{ m_Stat.size = entry.size; }
+
+int pdcpp::AssetPack::File::read(void* buffer, unsigned int length)
+{
+    auto remaining = m_Entry.size - uint32_t(m_Position);
+    length = std::min(length, remaining);
+    if (length == 0)
+        { return 0; }
+
+    auto nRead = p_Pack->readAt(m_Entry.offset + uint32_t(m_Position), buffer, length);
+    if (nRead > 0)
+        { m_Position += nRead; }
+    return nRead;
+}
+
+int pdcpp::AssetPack::File::seek(int position, FileHandle::Whence whence)
+{
+    int64_t target = position;
+    if (whence == FileHandle::CURRENT)
+        { target += m_Position; }
+    else if (whence == FileHandle::END)
+        { target += m_Entry.size; }
+
+    if (target < 0 || target > int64_t(m_Entry.size))
+        { return -1; }
+
+    m_Position = int(target);
+    return 0;
+}
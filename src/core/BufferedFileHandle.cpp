@@ -0,0 +1,189 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#include <pdcpp/core/BufferedFileHandle.h>
+
+#include <algorithm>
+#include <pdcpp/core/MemoryTracker.h>
+
+pdcpp::BufferedFileHandle::BufferedFileHandle(const std::string& path, FileOptions mode, size_t bufferSize)
+    : m_Handle(path, mode)
+{
+    pdcpp::ScopedMemoryTag tag(pdcpp::MemoryTag::Files);
+    m_Buffer.resize(std::max<size_t>(bufferSize, 1));
+
+    if ((mode & kFileAppend) != 0)
+        { m_Position = int(getDetails().size); }
+}
+
+pdcpp::BufferedFileHandle::~BufferedFileHandle()
+{
+    if (isOpen())
+        { flush(); }
+}
+
+int pdcpp::BufferedFileHandle::read(void* buffer, unsigned int length)
+{
+    if (!isOpen() || !flush())
+    {
+        m_Failed = true;
+        return -1;
+    }
+
+    auto out = static_cast<uint8_t*>(buffer);
+    size_t copied = 0;
+    while (copied < length)
+    {
+        auto available = m_ReadEnd - m_ReadPos;
+        if (available > 0)
+        {
+            auto n = std::min<size_t>(available, length - copied);
+            std::memcpy(out + copied, m_Buffer.data() + m_ReadPos, n);
+            m_ReadPos += n;
+            copied += n;
+            continue;
+        }
+
+        // What's left is at least a buffer-full, so skip the copy through
+        // the buffer. The file system can return less than was asked for
+        // before the end of the file, so keep going until it returns nothing.
+        auto remaining = length - copied;
+        if (remaining >= m_Buffer.size())
+        {
+            m_ReadPos = 0;
+            m_ReadEnd = 0;
+            auto n = m_Handle.read(out + copied, static_cast<unsigned int>(remaining));
+            if (n < 0)
+            {
+                m_Failed = true;
+                if (copied == 0) { return -1; }
+                break;
+            }
+            if (n == 0)
+                { break; }
+            copied += size_t(n);
+            continue;
+        }
+
+        auto n = m_Handle.read(m_Buffer.data(), static_cast<unsigned int>(m_Buffer.size()));
+        m_ReadPos = 0;
+        m_ReadEnd = n > 0 ? size_t(n) : 0;
+        if (n <= 0)
+        {
+            if (n < 0)
+            {
+                m_Failed = true;
+                if (copied == 0) { return -1; }
+            }
+            break;
+        }
+    }
+
+    m_Position += int(copied);
+    return int(copied);
+}
+
+int pdcpp::BufferedFileHandle::write(const void* buffer, unsigned int length)
+{
+    if (!isOpen() || !discardReadAhead())
+    {
+        m_Failed = true;
+        return -1;
+    }
+
+    if (m_WriteEnd + length > m_Buffer.size() && !flush())
+        { return -1; }
+
+    // Too big to gather, so it goes straight out.
+    if (length >= m_Buffer.size())
+    {
+        auto n = m_Handle.write(const_cast<void*>(buffer), length);
+        if (n != int(length))
+        {
+            m_Failed = true;
+            pdcpp::FileHelpers::handleError("Failed to write to file.");
+        }
+        if (n > 0)
+            { m_Position += n; }
+        return n;
+    }
+
+    std::memcpy(m_Buffer.data() + m_WriteEnd, buffer, length);
+    m_WriteEnd += length;
+    m_Position += int(length);
+    return int(length);
+}
+
+bool pdcpp::BufferedFileHandle::flush()
+{
+    if (m_WriteEnd == 0)
+        { return true; }
+
+    auto n = m_Handle.write(m_Buffer.data(), static_cast<unsigned int>(m_WriteEnd));
+    auto success = n == int(m_WriteEnd);
+    m_WriteEnd = 0;
+
+    if (!success)
+    {
+        m_Failed = true;
+        pdcpp::FileHelpers::handleError("Failed to write to file.");
+    }
+    return success;
+}
+
+int pdcpp::BufferedFileHandle::seek(int position, FileHandle::Whence whence)
+{
+    if (!isOpen())
+        { return -1; }
+
+    // The end may have moved since the file was opened, so only the file
+    // system knows where it is.
+    if (whence == FileHandle::END)
+    {
+        if (!flush() || !discardReadAhead() || m_Handle.seek(position, FileHandle::END) != 0)
+            { return -1; }
+        m_Position = m_Handle.tell();
+        return 0;
+    }
+
+    auto target = whence == FileHandle::SET ? position : m_Position + position;
+    if (target < 0)
+        { return -1; }
+
+    if (m_ReadEnd > 0)
+    {
+        auto bufferStart = m_Position - int(m_ReadPos);
+        if (target >= bufferStart && target <= bufferStart + int(m_ReadEnd))
+        {
+            m_ReadPos = size_t(target - bufferStart);
+            m_Position = target;
+            return 0;
+        }
+    }
+
+    if (!flush())
+        { return -1; }
+
+    m_ReadPos = 0;
+    m_ReadEnd = 0;
+    if (m_Handle.seek(target, FileHandle::SET) != 0)
+        { return -1; }
+
+    m_Position = target;
+    return 0;
+}
+
+bool pdcpp::BufferedFileHandle::discardReadAhead()
+{
+    auto unread = m_ReadEnd - m_ReadPos;
+    m_ReadPos = 0;
+    m_ReadEnd = 0;
+    return unread == 0 || m_Handle.seek(m_Position, FileHandle::SET) == 0;
+}
@@ -18,7 +18,11 @@ void pdcpp::ButtonManager::checkStateAndNotify()
 {
     PDButtons current, pressed, released;
     GlobalPlaydateAPI::get()->system->getButtonState(&current, &pressed, &released);
+    notify(current, pressed, released);
+}
 
+void pdcpp::ButtonManager::notify(PDButtons current, PDButtons pressed, PDButtons released)
+{
     if (current || pressed || released)
     {
         for (auto* l: m_Listeners)
@@ -51,7 +55,7 @@ pdcpp::KeyRepeatTimer::KeyRepeatTimer(int initialDelayMs, int repeatDelayMs)
     , m_RepeatDelay(repeatDelayMs)
 {}
 
-void pdcpp::KeyRepeatTimer::keyPressed(std::function<void()> action, bool resetTimer)
+void pdcpp::KeyRepeatTimer::keyPressed(Action action, bool resetTimer)
 {
     action();
     m_OnKeyRepeat = std::move(action);
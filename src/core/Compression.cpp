@@ -0,0 +1,335 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#include <pdcpp/core/Compression.h>
+
+namespace
+{
+    constexpr int k_HashBits = 12;
+    constexpr size_t k_MinMatch = 4;
+
+    // The format's end rules: the last five bytes are always literals, and
+    // no match starts within twelve bytes of the end.
+    constexpr size_t k_LastLiterals = 5;
+    constexpr size_t k_MatchFindLimit = 12;
+
+    uint32_t read32(const uint8_t* bytes)
+    {
+        uint32_t value;
+        std::memcpy(&value, bytes, sizeof(value));
+        return value;
+    }
+
+    uint32_t hash(uint32_t sequence) { return (sequence * 2654435761u) >> (32 - k_HashBits); }
+
+    // Writes a length's continuation bytes, after the 15 in its token.
+    bool writeLength(uint8_t*& out, const uint8_t* end, size_t length)
+    {
+        for (; length >= 255; length -= 255)
+        {
+            if (out >= end)
+                { return false; }
+            *out++ = 255;
+        }
+        if (out >= end)
+            { return false; }
+        *out++ = uint8_t(length);
+        return true;
+    }
+
+    bool writeSequence(uint8_t*& out, const uint8_t* end, const uint8_t* literals, size_t nLiterals,
+                       size_t offset, size_t matchLength)
+    {
+        if (out >= end)
+            { return false; }
+
+        auto token = out++;
+        *token = uint8_t(std::min<size_t>(nLiterals, 15) << 4);
+        if (nLiterals >= 15 && !writeLength(out, end, nLiterals - 15))
+            { return false; }
+
+        if (size_t(end - out) < nLiterals)
+            { return false; }
+        std::memcpy(out, literals, nLiterals);
+        out += nLiterals;
+
+        // The last sequence is just literals.
+        if (matchLength == 0)
+            { return true; }
+
+        if (end - out < 2)
+            { return false; }
+        *out++ = uint8_t(offset);
+        *out++ = uint8_t(offset >> 8);
+
+        matchLength -= k_MinMatch;
+        *token |= uint8_t(std::min<size_t>(matchLength, 15));
+        return matchLength < 15 || writeLength(out, end, matchLength - 15);
+    }
+
+    // Reads a length's continuation bytes.
+    bool readLength(const uint8_t*& in, const uint8_t* end, size_t& length)
+    {
+        uint8_t byte;
+        do
+        {
+            if (in >= end)
+                { return false; }
+            byte = *in++;
+            length += byte;
+        } while (byte == 255);
+        return true;
+    }
+}
+
+pdcpp::Compression::Compressor::Compressor()
+{
+    pdcpp::ScopedMemoryTag tag(pdcpp::MemoryTag::Files);
+    m_Table.resize(size_t(1) << k_HashBits);
+}
+
+size_t pdcpp::Compression::Compressor::compressBlock(const void* source, size_t size, void* destination, size_t capacity)
+{
+    if (size > k_MaxBlockSize)
+        { return 0; }
+
+    auto src = static_cast<const uint8_t*>(source);
+    auto out = static_cast<uint8_t*>(destination);
+    auto outEnd = out + capacity;
+
+    // Positions are 16 bits, which is why blocks are at most 64KB. Stale
+    // entries from the last block are harmless, as every candidate is checked.
+    std::fill(m_Table.begin(), m_Table.end(), uint16_t(0));
+
+    size_t anchor = 0;
+    if (size > k_MatchFindLimit)
+    {
+        const auto findLimit = size - k_MatchFindLimit;
+        const auto matchLimit = size - k_LastLiterals;
+        size_t position = 1;
+        m_Table[hash(read32(src))] = 0;
+
+        // The step grows while nothing matches, so incompressible data is
+        // skipped through quickly.
+        size_t misses = 0;
+        while (position < findLimit)
+        {
+            auto sequence = read32(src + position);
+            auto& slot = m_Table[hash(sequence)];
+            size_t candidate = slot;
+            slot = uint16_t(position);
+
+            if (candidate >= position || read32(src + candidate) != sequence)
+            {
+                position += 1 + (misses++ >> 6);
+                continue;
+            }
+            misses = 0;
+
+            while (position > anchor && candidate > 0 && src[position - 1] == src[candidate - 1])
+            {
+                --position;
+                --candidate;
+            }
+
+            auto length = k_MinMatch;
+            while (position + length < matchLimit && src[candidate + length] == src[position + length])
+                { ++length; }
+
+            if (!writeSequence(out, outEnd, src + anchor, position - anchor, position - candidate, length))
+                { return 0; }
+
+            position += length;
+            anchor = position;
+            if (position - 2 < findLimit)
+                { m_Table[hash(read32(src + position - 2))] = uint16_t(position - 2); }
+        }
+    }
+
+    if (!writeSequence(out, outEnd, src + anchor, size - anchor, 0, 0))
+        { return 0; }
+    return size_t(out - static_cast<uint8_t*>(destination));
+}
+
+int pdcpp::Compression::decompressBlock(const void* source, size_t size, void* destination, size_t capacity)
+{
+    auto in = static_cast<const uint8_t*>(source);
+    auto inEnd = in + size;
+    auto out = static_cast<uint8_t*>(destination);
+    auto outStart = out;
+    auto outEnd = out + capacity;
+
+    while (in < inEnd)
+    {
+        auto token = *in++;
+
+        size_t nLiterals = token >> 4;
+        if (nLiterals == 15 && !readLength(in, inEnd, nLiterals))
+            { return -1; }
+        if (nLiterals > size_t(inEnd - in) || nLiterals > size_t(outEnd - out))
+            { return -1; }
+        std::memcpy(out, in, nLiterals);
+        in += nLiterals;
+        out += nLiterals;
+
+        if (in == inEnd)
+            { return int(out - outStart); }
+
+        if (inEnd - in < 2)
+            { return -1; }
+        size_t offset = size_t(in[0]) | size_t(in[1]) << 8;
+        in += 2;
+        if (offset == 0 || offset > size_t(out - outStart))
+            { return -1; }
+
+        size_t length = token & 15;
+        if (length == 15 && !readLength(in, inEnd, length))
+            { return -1; }
+        length += k_MinMatch;
+        if (length > size_t(outEnd - out))
+            { return -1; }
+
+        // Overlapping matches repeat what they've just written, so they go a
+        // byte at a time.
+        auto match = out - offset;
+        if (offset >= length)
+            { std::memcpy(out, match, length); }
+        else
+        {
+            for (size_t i = 0; i < length; ++i)
+                { out[i] = match[i]; }
+        }
+        out += length;
+    }
+
+    // A block always ends with literals.
+    return -1;
+}
+
+std::vector<uint8_t> pdcpp::Compression::compress(const void* data, size_t size, uint32_t blockSize)
+{
+    blockSize = std::clamp<uint32_t>(blockSize, 1, k_MaxBlockSize);
+    auto src = static_cast<const uint8_t*>(data);
+
+    pdcpp::ScopedMemoryTag tag(pdcpp::MemoryTag::Files);
+    std::vector<uint8_t> frame(k_HeaderSize);
+    detail::writeU32(frame.data(), k_Magic);
+    detail::writeU32(frame.data() + 4, k_Version);
+    detail::writeU32(frame.data() + 8, blockSize);
+    detail::writeU32(frame.data() + 12, uint32_t(size));
+
+    Compressor compressor;
+    std::vector<uint8_t> block(getCompressedBound(blockSize));
+    for (size_t start = 0; start < size; start += blockSize)
+    {
+        auto length = std::min<size_t>(blockSize, size - start);
+        auto stored = compressor.compressBlock(src + start, length, block.data(), block.size());
+
+        // Anything which didn't shrink is kept as it was.
+        auto raw = stored == 0 || stored >= length;
+        auto word = raw ? uint32_t(length) | detail::k_RawBlock : uint32_t(stored);
+        auto bytes = raw ? src + start : block.data();
+        auto nBytes = raw ? length : stored;
+
+        auto at = frame.size();
+        frame.resize(at + 4 + nBytes);
+        detail::writeU32(frame.data() + at, word);
+        std::memcpy(frame.data() + at + 4, bytes, nBytes);
+    }
+    return frame;
+}
+
+std::optional<uint32_t> pdcpp::Compression::getDecompressedSize(const void* frame, size_t size)
+{
+    if (size < k_HeaderSize)
+        { return std::nullopt; }
+    auto header = detail::readHeader(static_cast<const uint8_t*>(frame));
+    if (!header)
+        { return std::nullopt; }
+    return header->size;
+}
+
+int pdcpp::Compression::decompress(const void* frame, size_t size, void* destination, size_t capacity)
+{
+    auto in = static_cast<const uint8_t*>(frame);
+    auto header = size >= k_HeaderSize ? detail::readHeader(in) : std::nullopt;
+    if (!header || header->size > capacity)
+        { return -1; }
+
+    auto out = static_cast<uint8_t*>(destination);
+    size_t at = k_HeaderSize;
+    for (uint32_t done = 0; done < header->size;)
+    {
+        if (size - at < 4)
+            { return -1; }
+        auto word = detail::readU32(in + at);
+        auto stored = word & ~detail::k_RawBlock;
+        at += 4;
+        if (stored > size - at)
+            { return -1; }
+
+        auto length = std::min(header->blockSize, header->size - done);
+        if ((word & detail::k_RawBlock) != 0)
+        {
+            if (stored != length)
+                { return -1; }
+            std::memcpy(out + done, in + at, length);
+        }
+        else if (decompressBlock(in + at, stored, out + done, length) != int(length))
+            { return -1; }
+
+        at += stored;
+        done += length;
+    }
+    return int(header->size);
+}
+
+bool pdcpp::Compression::saveFile(const std::string& path, const void* data, size_t size, uint32_t blockSize)
+{
+    auto frame = compress(data, size, blockSize);
+    pdcpp::FileHandle file(path, kFileWrite);
+    if (!file.isOpen())
+        { return false; }
+
+    if (file.write(frame.data(), static_cast<unsigned int>(frame.size())) != int(frame.size()))
+    {
+        pdcpp::FileHelpers::handleError("Failed to write " + path);
+        return false;
+    }
+    return true;
+}
+
+std::optional<std::vector<uint8_t>> pdcpp::Compression::loadFile(const std::string& path)
+{
+    Reader<> reader(path, kFileReadData);
+    if (!reader.isOpen())
+        { return std::nullopt; }
+
+    pdcpp::ScopedMemoryTag tag(pdcpp::MemoryTag::Files);
+    std::vector<uint8_t> data(reader.getDetails().size);
+    if (reader.read(data.data(), static_cast<unsigned int>(data.size())) != int(data.size()))
+        { return std::nullopt; }
+    return data;
+}
+
+std::optional<pdcpp::Compression::detail::FrameHeader> pdcpp::Compression::detail::readHeader(const uint8_t* bytes)
+{
+    FrameHeader header {readU32(bytes + 8), readU32(bytes + 12)};
+    if (readU32(bytes) != k_Magic || readU32(bytes + 4) != k_Version
+        || header.blockSize == 0 || header.blockSize > k_MaxBlockSize)
+        { return std::nullopt; }
+    return header;
+}
+
+void pdcpp::Compression::detail::writeU32(uint8_t* bytes, uint32_t value)
+{
+    for (int i = 0; i < 4; ++i)
+        { bytes[i] = uint8_t(value >> (8 * i)); }
+}
@@ -10,14 +10,20 @@
 
 #include <pdcpp/core/GlobalPlaydateAPI.h>
 #include <pdcpp/core/CrankManager.h>
+#include <algorithm>
 #include <cassert>
 
 void pdcpp::CrankManager::checkStateAndNotify()
 {
     auto delta = pdcpp::GlobalPlaydateAPI::get()->system->getCrankChange();
+    if (delta != 0)
+        { notify(pdcpp::GlobalPlaydateAPI::get()->system->getCrankAngle(), delta); }
+}
+
+void pdcpp::CrankManager::notify(float absolute, float delta)
+{
     if (delta != 0)
     {
-        auto absolute = pdcpp::GlobalPlaydateAPI::get()->system->getCrankAngle();
         for (auto* l: m_Listeners)
             { l->crankStateChanged(absolute, delta); }
     }
@@ -9,10 +9,19 @@
  */
 
 #include <pdcpp/core/File.h>
+#include <pdcpp/core/FileSystemCache.h>
 #include <pdcpp/core/GlobalPlaydateAPI.h>
+#include <pdcpp/core/Log.h>
+#include <pdcpp/core/MemoryTracker.h>
 
 pdcpp::FileHandle::FileHandle(const std::string& path, FileOptions mode)
 {
+    if ((mode & (kFileWrite | kFileAppend)) != 0)
+    {
+        m_WrittenPath = path;
+        pdcpp::FileSystemCache::getDefault().invalidate(path);
+    }
+
     auto pd = pdcpp::GlobalPlaydateAPI::get();
     p_File = pd->file->open(path.c_str(), mode);
 
@@ -25,20 +34,38 @@ pdcpp::FileHandle::FileHandle(const std::string& path, FileOptions mode)
 pdcpp::FileHandle::FileHandle(pdcpp::FileHandle&& other) noexcept
     : m_Stat(other.m_Stat)
     , p_File(other.p_File)
+    , m_WrittenPath(std::move(other.m_WrittenPath))
 { other.p_File = nullptr; }
 
 pdcpp::FileHandle& pdcpp::FileHandle::operator=(pdcpp::FileHandle&& other) noexcept
 {
+    if (this == &other)
+        { return *this; }
+
+    close();
     m_Stat = other.m_Stat;
     p_File = other.p_File;
+    m_WrittenPath = std::move(other.m_WrittenPath);
     other.p_File = nullptr;
     return *this;
 }
 
-pdcpp::FileHandle::~FileHandle()
+pdcpp::FileHandle::~FileHandle() { close(); }
+
+void pdcpp::FileHandle::close()
 {
     if (p_File != nullptr)
-    { pdcpp::GlobalPlaydateAPI::get()->file->close(p_File); }
+    {
+        pdcpp::GlobalPlaydateAPI::get()->file->close(p_File);
+        p_File = nullptr;
+    }
+
+    // Whatever was cached while it was open has the old size.
+    if (!m_WrittenPath.empty())
+    {
+        pdcpp::FileSystemCache::getDefault().invalidate(m_WrittenPath);
+        m_WrittenPath.clear();
+    }
 }
 
 int pdcpp::FileHandle::read(void* buffer, unsigned int len)
@@ -63,52 +90,50 @@ int pdcpp::FileHandle::seek(int position, pdcpp::FileHandle::Whence whence)
 int pdcpp::FileHandle::tell() const { return pdcpp::GlobalPlaydateAPI::get()->file->tell(p_File); }
 
 void pdcpp::FileHelpers::handleError(const std::string& msg)
-{
-    auto pd = pdcpp::GlobalPlaydateAPI::get();
-    auto errStr = msg + " -- " + pd->file->geterr();
-    pd->system->error(errStr.c_str());
-}
+    { PDCPP_LOG_ERROR("%s -- %s", msg, pdcpp::GlobalPlaydateAPI::get()->file->geterr()); }
 
 std::vector<std::string> pdcpp::FileHelpers::listFilesInDirectory(const std::string& dirPath, bool showHidden)
 {
-    auto pd = pdcpp::GlobalPlaydateAPI::get();
-
-    std::vector<std::string> rv;
-    pd->file->listfiles(dirPath.c_str(), [](const char* dirName, void* userData)
-    {
-        auto v = static_cast<std::vector<std::string>*>(userData);
-        v->emplace_back(dirName);
-    }, &rv, showHidden);
-
-    return rv;
+    pdcpp::ScopedMemoryTag tag(pdcpp::MemoryTag::Files);
+    auto listing = pdcpp::FileSystemCache::getDefault().listFiles(dirPath, showHidden);
+    return listing != nullptr ? *listing : std::vector<std::string>();
 }
 
 bool pdcpp::FileHelpers::fileExists(const std::string& path)
 {
-    FileStat stat;
-    stat.isdir = true;
-    return pdcpp::GlobalPlaydateAPI::get()->file->stat(path.c_str(), &stat) == 0 && !stat.isdir;
+    auto stat = pdcpp::FileSystemCache::getDefault().stat(path);
+    return stat.has_value() && !stat->isdir;
 }
 
 int pdcpp::FileHelpers::mkdir(const std::string& path)
 {
+    pdcpp::FileSystemCache::getDefault().invalidate(path);
     return pdcpp::GlobalPlaydateAPI::get()->file->mkdir(path.c_str());
 }
 
 int pdcpp::FileHelpers::rename(const std::string& from, const std::string& to)
 {
-    return 0;
+    auto& cache = pdcpp::FileSystemCache::getDefault();
+    cache.invalidate(from);
+    cache.invalidate(to);
+    return pdcpp::GlobalPlaydateAPI::get()->file->rename(from.c_str(), to.c_str());
 }
 
-FileStat pdcpp::FileHelpers::stat(const std::string& path)
+int pdcpp::FileHelpers::unlink(const std::string& path, bool recursive)
 {
-    FileStat rv;
-
-    auto pd = pdcpp::GlobalPlaydateAPI::get();
-    if (pd->file->stat(path.c_str(), &rv) < 0)
-        { pdcpp::FileHelpers::handleError("Failed to stat file: " + path); }
+    pdcpp::FileSystemCache::getDefault().invalidate(path);
+    return pdcpp::GlobalPlaydateAPI::get()->file->unlink(path.c_str(), recursive ? 1 : 0);
+}
 
-    return rv;
+FileStat pdcpp::FileHelpers::stat(const std::string& path)
+{
+    auto stat = pdcpp::FileSystemCache::getDefault().stat(path);
+    if (!stat.has_value())
+    {
+        pdcpp::FileHelpers::handleError("Failed to stat file: " + path);
+        return {};
+    }
+    return *stat;
 }
 
 std::string pdcpp::FileHelpers::parentDir(const std::string& fileOrDirname)
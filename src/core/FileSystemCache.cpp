@@ -0,0 +1,135 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#include <pdcpp/core/FileSystemCache.h>
+
+#include <algorithm>
+#include <memory>
+#include <pdcpp/core/GlobalPlaydateAPI.h>
+#include <pdcpp/core/MemoryTracker.h>
+
+namespace
+{
+    std::unique_ptr<pdcpp::FileSystemCache> g_DefaultCache;
+
+    std::string withoutTrailingSlash(const std::string& path)
+        { return path.ends_with('/') ? path.substr(0, path.size() - 1) : path; }
+}
+
+const std::vector<std::string>* pdcpp::FileSystemCache::listFiles(const std::string& directory, bool showHidden)
+{
+    auto key = directoryKey(directory);
+    auto found = m_Listings.find(key);
+    if (found != m_Listings.end() && (found->second.hasHidden || !showHidden))
+        { return showHidden ? &found->second.all : &found->second.visible; }
+
+    pdcpp::ScopedMemoryTag tag(pdcpp::MemoryTag::Files);
+    std::vector<std::string> names;
+    ++m_NumApiCalls;
+    auto result = pdcpp::GlobalPlaydateAPI::get()->file->listfiles(key.c_str(), [](const char* name, void* userData)
+    {
+        static_cast<std::vector<std::string>*>(userData)->emplace_back(name);
+    }, &names, showHidden);
+
+    // Listing a directory which isn't there is how callers find out, so
+    // it's not an error worth reporting.
+    if (result != 0)
+        { return nullptr; }
+
+    auto& listing = m_Listings[key];
+    listing.hasHidden = showHidden;
+    listing.visible.clear();
+    std::copy_if(names.begin(), names.end(), std::back_inserter(listing.visible),
+                 [](const std::string& name) { return !name.starts_with('.'); });
+    listing.all = showHidden ? std::move(names) : std::vector<std::string>();
+
+    return showHidden ? &listing.all : &listing.visible;
+}
+
+std::optional<FileStat> pdcpp::FileSystemCache::stat(const std::string& path)
+{
+    auto key = withoutTrailingSlash(path);
+    auto found = m_Stats.find(key);
+    if (found != m_Stats.end())
+        { return found->second; }
+
+    // If the parent's been listed, anything not in it doesn't exist.
+    auto listing = m_Listings.find(parentKey(key));
+    auto name = entryName(key);
+    if (listing != m_Listings.end() && (listing->second.hasHidden || !name.starts_with('.')))
+    {
+        auto& names = listing->second.hasHidden ? listing->second.all : listing->second.visible;
+        if (std::find(names.begin(), names.end(), name) == names.end()
+            && std::find(names.begin(), names.end(), name + "/") == names.end())
+            { return std::nullopt; }
+    }
+
+    FileStat stat {};
+    ++m_NumApiCalls;
+    if (pdcpp::GlobalPlaydateAPI::get()->file->stat(key.c_str(), &stat) != 0)
+        { return std::nullopt; }
+
+    // Stats are cheap to get again, so once there are too many, whichever
+    // one is handiest makes room.
+    pdcpp::ScopedMemoryTag tag(pdcpp::MemoryTag::Files);
+    if (m_Stats.size() >= m_MaxStats && !m_Stats.empty())
+        { m_Stats.erase(m_Stats.begin()); }
+    m_Stats.emplace(std::move(key), stat);
+    return stat;
+}
+
+void pdcpp::FileSystemCache::invalidate(const std::string& path)
+{
+    auto key = withoutTrailingSlash(path);
+    auto isAffected = [&key](const std::string& cached)
+    {
+        return key.empty() || cached == key
+            || (cached.starts_with(key) && cached[key.size()] == '/');
+    };
+
+    std::erase_if(m_Stats, [&](const auto& entry) { return isAffected(entry.first); });
+    std::erase_if(m_Listings, [&](const auto& entry) { return isAffected(entry.first); });
+    m_Listings.erase(parentKey(key));
+}
+
+void pdcpp::FileSystemCache::setMaxStats(size_t maxStats)
+{
+    m_MaxStats = std::max<size_t>(maxStats, 1);
+    while (m_Stats.size() > m_MaxStats)
+        { m_Stats.erase(m_Stats.begin()); }
+}
+
+void pdcpp::FileSystemCache::clear()
+{
+    m_Listings.clear();
+    m_Stats.clear();
+}
+
+pdcpp::FileSystemCache& pdcpp::FileSystemCache::getDefault()
+{
+    if (g_DefaultCache == nullptr)
+        { g_DefaultCache = std::make_unique<FileSystemCache>(); }
+    return *g_DefaultCache;
+}
+
+std::string pdcpp::FileSystemCache::directoryKey(const std::string& directory)
+    { return directory.empty() || directory.ends_with('/') ? directory : directory + "/"; }
+
+std::string pdcpp::FileSystemCache::parentKey(const std::string& path)
+{
+    auto slash = path.find_last_of('/');
+    return slash == std::string::npos ? std::string() : path.substr(0, slash + 1);
+}
+
+std::string pdcpp::FileSystemCache::entryName(const std::string& path)
+{
+    auto slash = path.find_last_of('/');
+    return slash == std::string::npos ? path : path.substr(slash + 1);
+}
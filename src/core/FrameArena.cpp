@@ -0,0 +1,113 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#include <pdcpp/core/FrameArena.h>
+#include <pdcpp/core/Log.h>
+
+#include <algorithm>
+#include <new>
+
+namespace
+{
+    std::unique_ptr<pdcpp::FrameArena> g_DefaultArena;
+}
+
+pdcpp::FrameArena::FrameArena(size_t capacityBytes)
+    : p_Block(std::make_unique<std::byte[]>(capacityBytes))
+    , m_Capacity(capacityBytes)
+{
+    m_Stats.capacity = m_Capacity;
+}
+
+void* pdcpp::FrameArena::allocate(size_t bytes, size_t alignment)
+{
+    ++m_Stats.allocations;
+    ++m_Live;
+
+    auto base = reinterpret_cast<uintptr_t>(p_Block.get());
+    auto aligned = (base + m_Offset + alignment - 1) & ~(uintptr_t(alignment) - 1);
+    auto start = static_cast<size_t>(aligned - base);
+
+    if (start + bytes > m_Capacity)
+    {
+        ++m_Stats.heapFallbacks;
+        if (!m_HasWarned)
+        {
+            PDCPP_LOG_WARNING("FrameArena: out of room for %u bytes, falling back to the heap. Is it reset every frame?",
+                              static_cast<uint32_t>(bytes));
+            m_HasWarned = true;
+        }
+        return ::operator new(bytes);
+    }
+
+    m_LastOffset = m_Offset;
+    m_Offset = start + bytes;
+    m_Stats.bytesInUse = m_Offset;
+    m_Stats.highWaterMark = std::max(m_Stats.highWaterMark, m_Offset);
+    return p_Block.get() + start;
+}
+
+void pdcpp::FrameArena::deallocate(void* ptr, size_t bytes)
+{
+    if (ptr == nullptr)
+        { return; }
+
+    if (m_Live > 0)
+        { --m_Live; }
+
+    if (!owns(ptr))
+    {
+        ::operator delete(ptr);
+        return;
+    }
+
+    // Only the top of the stack can be given back.
+    if (static_cast<std::byte*>(ptr) + bytes == p_Block.get() + m_Offset)
+    {
+        m_Offset = m_LastOffset;
+        m_Stats.bytesInUse = m_Offset;
+    }
+}
+
+void pdcpp::FrameArena::reset()
+{
+    m_Offset = 0;
+    m_LastOffset = 0;
+    m_Stats.bytesInUse = 0;
+    m_Stats.allocations = 0;
+    m_Stats.heapFallbacks = 0;
+    m_HasWarned = false;
+}
+
+bool pdcpp::FrameArena::owns(const void* ptr) const
+{
+    auto p = static_cast<const std::byte*>(ptr);
+    return p >= p_Block.get() && p < p_Block.get() + m_Capacity;
+}
+
+pdcpp::FrameArena& pdcpp::FrameArena::getDefault()
+{
+    if (g_DefaultArena == nullptr)
+        { g_DefaultArena = std::make_unique<FrameArena>(k_DefaultCapacity); }
+    return *g_DefaultArena;
+}
+
+bool pdcpp::FrameArena::setDefaultCapacity(size_t capacityBytes)
+{
+    if (g_DefaultArena != nullptr && g_DefaultArena->m_Live > 0)
+    {
+        PDCPP_LOG_ERROR("FrameArena: can't resize the default arena while %u allocations are using it",
+                        g_DefaultArena->m_Live);
+        return false;
+    }
+
+    g_DefaultArena = std::make_unique<FrameArena>(capacityBytes);
+    return true;
+}
@@ -0,0 +1,49 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#include <pdcpp/core/FrameBudget.h>
+
+#include <algorithm>
+#include <pdcpp/core/GlobalPlaydateAPI.h>
+
+pdcpp::FrameBudget::FrameBudget(float budgetMs)
+    { setBudget(budgetMs); }
+
+void pdcpp::FrameBudget::start()
+{
+    auto sys = pdcpp::GlobalPlaydateAPI::getUninterposed()->system;
+    m_StartMs = sys->getCurrentTimeMilliseconds();
+    m_StartSeconds = sys->getElapsedTime();
+}
+
+uint32_t pdcpp::FrameBudget::getElapsedUs() const
+{
+    auto sys = pdcpp::GlobalPlaydateAPI::getUninterposed()->system;
+
+    // Unsigned subtraction keeps this right across the clock wrapping.
+    auto elapsedMs = sys->getCurrentTimeMilliseconds() - m_StartMs;
+    auto elapsedUs = static_cast<uint64_t>(elapsedMs) * 1000;
+
+    // The elapsed time is finer, but it may have been reset since `start`,
+    // and as a float it gets coarser the longer it runs, so it's only
+    // trusted while it's within a millisecond of the millisecond clock.
+    auto fineSeconds = sys->getElapsedTime() - m_StartSeconds;
+    if (fineSeconds >= 0.0f)
+    {
+        auto fineUs = static_cast<uint64_t>(fineSeconds * 1000000.0f);
+        if (fineUs + 1000 > elapsedUs && fineUs < elapsedUs + 1000)
+            { elapsedUs = fineUs; }
+    }
+
+    return static_cast<uint32_t>(std::min<uint64_t>(elapsedUs, UINT32_MAX));
+}
+
+void pdcpp::FrameBudget::setBudget(float budgetMs)
+    { m_BudgetUs = static_cast<uint32_t>(std::max(budgetMs, 0.0f) * 1000.0f); }
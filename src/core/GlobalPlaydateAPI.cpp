@@ -9,20 +9,50 @@
  */
 
 #include <pdcpp/core/GlobalPlaydateAPI.h>
+#include <pdcpp/core/ApiTracer.h>
+#include <pdcpp/core/Log.h>
+#include <pdcpp/core/MemoryTracker.h>
+#include <utility>
 
 pdcpp::GlobalPlaydateAPI* pdcpp::GlobalPlaydateAPI::instance = nullptr;
 
 pdcpp::GlobalPlaydateAPI::GlobalPlaydateAPI(PlaydateAPI* pd_api)
     : pd(pd_api)
+    , p_Uninterposed(pd_api)
 {}
 
-pdcpp::GlobalPlaydateAPI* pdcpp::GlobalPlaydateAPI::initialize(PlaydateAPI* pd_api)
+pdcpp::GlobalPlaydateAPI::~GlobalPlaydateAPI() = default;
+
+pdcpp::GlobalPlaydateAPI* pdcpp::GlobalPlaydateAPI::initialize(PlaydateAPI* pd_api, bool traceApiCalls)
 {
     if (instance == nullptr)
-        { instance = new GlobalPlaydateAPI(pd_api); }
+    {
+        pdcpp::MemoryTracker::setSystemRealloc(pd_api->system->realloc);
+        instance = new GlobalPlaydateAPI(pd_api);
+        if (traceApiCalls)
+        {
+            instance->p_Tracer = std::make_unique<ApiTracer>(pd_api);
+            instance->pd = instance->p_Tracer->get();
+            instance->p_Uninterposed = instance->pd;
+        }
+    }
 
     return instance;
 }
 
-void pdcpp::GlobalPlaydateAPI::destroyInstance() { delete instance; }
+pdcpp::ApiTracer* pdcpp::GlobalPlaydateAPI::getTracer()
+    { return instance != nullptr ? instance->p_Tracer.get() : nullptr; }
+
+PlaydateAPI* pdcpp::GlobalPlaydateAPI::interpose(PlaydateAPI* api)
+    { return std::exchange(instance->pd, api); }
+
+void pdcpp::GlobalPlaydateAPI::destroyInstance()
+{
+    // Anything still in the log goes out while there's an API to send it to.
+    if (instance != nullptr)
+        { pdcpp::Log::getDefault().flush(); }
+
+    delete instance;
+    instance = nullptr;
+}
 
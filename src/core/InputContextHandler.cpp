@@ -9,6 +9,8 @@
  */
 
 #include <pdcpp/core/InputContext.h>
+#include <pdcpp/core/GlobalPlaydateAPI.h>
+#include <pdcpp/core/Profiler.h>
 
 void pdcpp::InputContext::popContext()
 {
@@ -31,7 +33,10 @@ pdcpp::InputContextManager::InputContextManager(InputContext* baseContext)
 
 void pdcpp::InputContextManager::update()
 {
-    if (m_ContextStack.back()->wantsCrankBeforeButtons())
+    PDCPP_PROFILE_SCOPE("InputContextManager::update");
+    if (p_Queue != nullptr)
+        { dispatchQueuedInput(); }
+    else if (m_ContextStack.back()->wantsCrankBeforeButtons())
     {
         pdcpp::CrankManager::checkStateAndNotify();
         pdcpp::ButtonManager::checkStateAndNotify();
@@ -43,6 +48,56 @@ void pdcpp::InputContextManager::update()
     }
 }
 
+void pdcpp::InputContextManager::useInputQueue(InputQueue* queue)
+{
+    p_Queue = queue;
+    m_QueuedButtons = 0;
+}
+
+void pdcpp::InputContextManager::dispatchQueuedInput()
+{
+    p_Queue->poll();
+
+    const auto none = static_cast<PDButtons>(0);
+    auto sawButtons = false;
+    while (auto event = p_Queue->pop())
+    {
+        // The context may change as events are handled, so look it up each
+        // time.
+        getCurrentContext()->inputEventReceived(*event);
+
+        switch (event->type)
+        {
+            case InputEvent::Type::ButtonPressed:
+                m_QueuedButtons |= event->button;
+                pdcpp::ButtonManager::notify(static_cast<PDButtons>(m_QueuedButtons), event->button, none);
+                sawButtons = true;
+                break;
+            case InputEvent::Type::ButtonReleased:
+                m_QueuedButtons &= ~event->button;
+                pdcpp::ButtonManager::notify(static_cast<PDButtons>(m_QueuedButtons), none, event->button);
+                sawButtons = true;
+                break;
+            case InputEvent::Type::CrankMoved:
+                pdcpp::CrankManager::notify(event->crankAngle, event->crankDelta);
+                break;
+        }
+    }
+
+    // Presses dropped from a full queue, or buttons held from before the
+    // queue was in use, would otherwise leave the held buttons wrong for good,
+    // so they're brought back in line with the system's once the queue is
+    // drained.
+    PDButtons current;
+    pdcpp::GlobalPlaydateAPI::get()->system->getButtonState(&current, nullptr, nullptr);
+    auto pressed = static_cast<PDButtons>(current & ~m_QueuedButtons);
+    auto released = static_cast<PDButtons>(m_QueuedButtons & ~current);
+    m_QueuedButtons = current;
+
+    if (pressed != none || released != none || !sawButtons)
+        { pdcpp::ButtonManager::notify(current, pressed, released); }
+}
+
 void pdcpp::InputContextManager::pushContext(InputContext* newContext)
 {
     if (!m_ContextStack.empty())
@@ -0,0 +1,123 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#include <pdcpp/core/InputQueue.h>
+
+#include <algorithm>
+#include <pdcpp/core/GlobalPlaydateAPI.h>
+
+pdcpp::InputQueue* pdcpp::InputQueue::s_Attached = nullptr;
+
+pdcpp::InputQueue::InputQueue(size_t capacity)
+    : m_Events(std::max<size_t>(capacity, 1))
+{}
+
+pdcpp::InputQueue::~InputQueue() { detach(); }
+
+void pdcpp::InputQueue::attach()
+{
+    s_Attached = this;
+    pdcpp::GlobalPlaydateAPI::get()->system->setButtonCallback(buttonCallback, this, static_cast<int>(getCapacity()));
+}
+
+void pdcpp::InputQueue::detach()
+{
+    if (!isAttached())
+        { return; }
+
+    s_Attached = nullptr;
+    pdcpp::GlobalPlaydateAPI::get()->system->setButtonCallback(nullptr, nullptr, 0);
+}
+
+void pdcpp::InputQueue::poll()
+{
+    auto system = pdcpp::GlobalPlaydateAPI::get()->system;
+    auto now = system->getCurrentTimeMilliseconds();
+
+    if (!isAttached())
+    {
+        PDButtons current, pressed, released;
+        system->getButtonState(&current, &pressed, &released);
+
+        for (int bit = kButtonLeft; bit <= kButtonA; bit <<= 1)
+        {
+            auto button = static_cast<PDButtons>(bit);
+            auto wasPressed = (pressed & bit) != 0;
+            auto wasReleased = (released & bit) != 0;
+
+            // Both in one frame: whichever left it in its current state came
+            // second.
+            if (wasPressed && wasReleased && (current & bit) != 0)
+            {
+                pushButton(button, false, now);
+                pushButton(button, true, now);
+            }
+            else
+            {
+                if (wasPressed)
+                    { pushButton(button, true, now); }
+                if (wasReleased)
+                    { pushButton(button, false, now); }
+            }
+        }
+    }
+
+    auto delta = system->getCrankChange();
+    if (delta != 0)
+        { pushCrank(system->getCrankAngle(), delta, now); }
+}
+
+bool pdcpp::InputQueue::pushButton(PDButtons button, bool pressed, uint32_t timeMs)
+{
+    auto type = pressed ? InputEvent::Type::ButtonPressed : InputEvent::Type::ButtonReleased;
+    return push({type, timeMs, button, 0.0f, 0.0f});
+}
+
+bool pdcpp::InputQueue::pushCrank(float angle, float delta, uint32_t timeMs)
+    { return push({InputEvent::Type::CrankMoved, timeMs, static_cast<PDButtons>(0), angle, delta}); }
+
+std::optional<pdcpp::InputEvent> pdcpp::InputQueue::pop()
+{
+    if (m_Count == 0)
+        { return std::nullopt; }
+
+    auto event = m_Events[m_Head];
+    m_Head = (m_Head + 1) % m_Events.size();
+    --m_Count;
+    return event;
+}
+
+const pdcpp::InputEvent* pdcpp::InputQueue::peek() const
+    { return m_Count == 0 ? nullptr : &m_Events[m_Head]; }
+
+void pdcpp::InputQueue::clear()
+{
+    m_Head = 0;
+    m_Count = 0;
+}
+
+int pdcpp::InputQueue::buttonCallback(PDButtons button, int down, uint32_t when, void* userdata)
+{
+    static_cast<InputQueue*>(userdata)->pushButton(button, down != 0, when);
+    return 0;
+}
+
+bool pdcpp::InputQueue::push(const InputEvent& event)
+{
+    if (m_Count == m_Events.size())
+    {
+        ++m_NDropped;
+        return false;
+    }
+
+    m_Events[(m_Head + m_Count) % m_Events.size()] = event;
+    ++m_Count;
+    return true;
+}
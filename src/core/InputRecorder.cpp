@@ -0,0 +1,321 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#include <pdcpp/core/InputRecorder.h>
+
+#include <cassert>
+#include <cstring>
+#include <utility>
+#include <pdcpp/core/GlobalPlaydateAPI.h>
+#include <pdcpp/core/Log.h>
+
+namespace
+{
+    // A recording is a header of the magic, the version, and the seed,
+    // followed by the frames, until the end of the file. Each frame is a byte
+    // of flags, the milliseconds since the previous frame as a varint, then
+    // the three button bytes if they changed, and the crank's angle and change
+    // as floats if it moved.
+    constexpr uint8_t k_Magic[4] = {'P', 'D', 'I', 'R'};
+    constexpr uint8_t k_Version = 1;
+    constexpr size_t k_HeaderSize = sizeof(k_Magic) + 1 + sizeof(uint32_t);
+
+    constexpr uint8_t k_ButtonsChanged = 1 << 0;
+    constexpr uint8_t k_CrankMoved = 1 << 1;
+    constexpr uint8_t k_CrankDocked = 1 << 2;
+
+    // Recorded frames are written once they've built up to this.
+    constexpr size_t k_FlushBytes = 4096;
+
+    void writeVarint(std::vector<uint8_t>& out, uint32_t value)
+    {
+        while (value >= 0x80)
+        {
+            out.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<uint8_t>(value));
+    }
+
+    bool readVarint(const std::vector<uint8_t>& in, size_t& offset, uint32_t& value)
+    {
+        value = 0;
+        for (int shift = 0; shift < 35 && offset < in.size(); shift += 7)
+        {
+            auto byte = in[offset++];
+            value |= uint32_t(byte & 0x7f) << shift;
+            if ((byte & 0x80) == 0)
+                { return true; }
+        }
+        return false;
+    }
+
+    template <typename T>
+    void writeRaw(std::vector<uint8_t>& out, T value)
+    {
+        uint8_t bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        out.insert(out.end(), bytes, bytes + sizeof(T));
+    }
+
+    template <typename T>
+    bool readRaw(const std::vector<uint8_t>& in, size_t& offset, T& value)
+    {
+        if (in.size() - offset < sizeof(T))
+            { return false; }
+        std::memcpy(&value, in.data() + offset, sizeof(T));
+        offset += sizeof(T);
+        return true;
+    }
+}
+
+/**
+ * A copy of the API whose input functions answer with a given frame, for as
+ * long as it exists. There can only be one at a time.
+ */
+class pdcpp::InputSubstitution
+{
+public:
+    explicit InputSubstitution(bool substituteTime)
+        : p_Previous(pdcpp::GlobalPlaydateAPI::get())
+        , m_System(*p_Previous->system)
+        , m_Api(*p_Previous)
+    {
+        assert(s_Active == nullptr && "Only one InputRecorder or InputPlayer can run at a time");
+        s_Active = this;
+
+        m_System.getButtonState = getButtonState;
+        m_System.getCrankChange = getCrankChange;
+        m_System.getCrankAngle = getCrankAngle;
+        m_System.isCrankDocked = isCrankDocked;
+        if (substituteTime)
+            { m_System.getCurrentTimeMilliseconds = getCurrentTimeMilliseconds; }
+        m_Api.system = &m_System;
+        pdcpp::GlobalPlaydateAPI::interpose(&m_Api);
+    }
+
+    ~InputSubstitution()
+    {
+        pdcpp::GlobalPlaydateAPI::interpose(p_Previous);
+        s_Active = nullptr;
+    }
+
+    /**
+     * @returns the system functions being substituted.
+     */
+    [[ nodiscard ]] const playdate_sys* getReal() const { return p_Previous->system; }
+
+    void setFrame(const pdcpp::InputFrame& frame, uint32_t timeMs)
+    {
+        m_Frame = frame;
+        m_TimeMs = timeMs;
+        m_CrankChangeRead = false;
+    }
+
+private:
+    static void getButtonState(PDButtons* current, PDButtons* pressed, PDButtons* released)
+    {
+        if (current != nullptr) { *current = s_Active->m_Frame.current; }
+        if (pressed != nullptr) { *pressed = s_Active->m_Frame.pressed; }
+        if (released != nullptr) { *released = s_Active->m_Frame.released; }
+    }
+
+    // Like the real thing, the change is used up by reading it.
+    static float getCrankChange()
+        { return std::exchange(s_Active->m_CrankChangeRead, true) ? 0.0f : s_Active->m_Frame.crankChange; }
+
+    static float getCrankAngle() { return s_Active->m_Frame.crankAngle; }
+    static int isCrankDocked() { return s_Active->m_Frame.crankDocked ? 1 : 0; }
+    static unsigned int getCurrentTimeMilliseconds() { return s_Active->m_TimeMs; }
+
+    PlaydateAPI* p_Previous;
+    playdate_sys m_System;
+    PlaydateAPI m_Api;
+    pdcpp::InputFrame m_Frame;
+    uint32_t m_TimeMs = 0;
+    bool m_CrankChangeRead = false;
+
+    static InputSubstitution* s_Active;
+};
+
+pdcpp::InputSubstitution* pdcpp::InputSubstitution::s_Active = nullptr;
+
+////////////////////////////////////////////////////////////////////////////////
+
+pdcpp::InputRecorder::InputRecorder(const std::string& path, uint32_t seed)
+    : p_File(std::make_unique<FileHandle>(path, kFileWrite))
+{
+    if (!p_File->isOpen())
+    {
+        p_File.reset();
+        return;
+    }
+
+    m_Buffer.reserve(k_FlushBytes + 64);
+    m_Buffer.insert(m_Buffer.end(), std::begin(k_Magic), std::end(k_Magic));
+    m_Buffer.push_back(k_Version);
+    writeRaw(m_Buffer, seed);
+}
+
+pdcpp::InputRecorder::~InputRecorder() { stop(); }
+
+void pdcpp::InputRecorder::update()
+{
+    if (!isRecording())
+        { return; }
+
+    if (p_Substitution == nullptr)
+        { p_Substitution = std::make_unique<InputSubstitution>(false); }
+
+    auto real = p_Substitution->getReal();
+    InputFrame frame;
+    frame.timeMs = real->getCurrentTimeMilliseconds();
+    real->getButtonState(&frame.current, &frame.pressed, &frame.released);
+    frame.crankChange = real->getCrankChange();
+    frame.crankAngle = real->getCrankAngle();
+    frame.crankDocked = real->isCrankDocked() != 0;
+    p_Substitution->setFrame(frame, frame.timeMs);
+
+    uint8_t flags = frame.crankDocked ? k_CrankDocked : 0;
+    if (frame.current != m_Previous.current || frame.pressed != 0 || frame.released != 0)
+        { flags |= k_ButtonsChanged; }
+    if (frame.crankChange != 0.0f || frame.crankAngle != m_Previous.crankAngle)
+        { flags |= k_CrankMoved; }
+
+    m_Buffer.push_back(flags);
+    writeVarint(m_Buffer, frame.timeMs - m_Previous.timeMs);
+    if ((flags & k_ButtonsChanged) != 0)
+    {
+        m_Buffer.push_back(static_cast<uint8_t>(frame.current));
+        m_Buffer.push_back(static_cast<uint8_t>(frame.pressed));
+        m_Buffer.push_back(static_cast<uint8_t>(frame.released));
+    }
+    if ((flags & k_CrankMoved) != 0)
+    {
+        writeRaw(m_Buffer, frame.crankAngle);
+        writeRaw(m_Buffer, frame.crankChange);
+    }
+
+    m_Previous = frame;
+    ++m_NFrames;
+
+    if (m_Buffer.size() >= k_FlushBytes)
+        { flush(); }
+}
+
+void pdcpp::InputRecorder::stop()
+{
+    if (isRecording())
+    {
+        flush();
+        p_File.reset();
+    }
+    p_Substitution.reset();
+}
+
+void pdcpp::InputRecorder::flush()
+{
+    if (!m_Buffer.empty())
+        { p_File->write(m_Buffer.data(), static_cast<unsigned int>(m_Buffer.size())); }
+    m_Buffer.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+pdcpp::InputPlayer::InputPlayer(const std::string& path, bool replayTime)
+    : m_ReplayTime(replayTime)
+{
+    FileHandle file(path, static_cast<FileOptions>(kFileRead | kFileReadData));
+    if (!file.isOpen())
+        { return; }
+
+    m_Data.resize(file.getDetails().size);
+    if (file.read(m_Data.data(), static_cast<unsigned int>(m_Data.size())) != static_cast<int>(m_Data.size())
+        || m_Data.size() < k_HeaderSize
+        || std::memcmp(m_Data.data(), k_Magic, sizeof(k_Magic)) != 0
+        || m_Data[sizeof(k_Magic)] != k_Version)
+    {
+        PDCPP_LOG_ERROR("%s is not an input recording", path);
+        m_Data.clear();
+        return;
+    }
+
+    m_Offset = sizeof(k_Magic) + 1;
+    readRaw(m_Data, m_Offset, m_Seed);
+    m_Loaded = true;
+}
+
+pdcpp::InputPlayer::~InputPlayer() { stop(); }
+
+bool pdcpp::InputPlayer::update()
+{
+    auto next = m_Frame;
+    if (!m_Loaded || !readFrame(next))
+    {
+        stop();
+        return false;
+    }
+    m_Frame = next;
+
+    if (p_Substitution == nullptr)
+    {
+        m_StartMs = pdcpp::GlobalPlaydateAPI::get()->system->getCurrentTimeMilliseconds();
+        m_FirstFrameMs = m_Frame.timeMs;
+        p_Substitution = std::make_unique<InputSubstitution>(m_ReplayTime);
+    }
+
+    p_Substitution->setFrame(m_Frame, m_StartMs + (m_Frame.timeMs - m_FirstFrameMs));
+    ++m_NFrames;
+    return true;
+}
+
+void pdcpp::InputPlayer::stop()
+{
+    p_Substitution.reset();
+    m_Offset = m_Data.size();
+}
+
+bool pdcpp::InputPlayer::readFrame(InputFrame& frame)
+{
+    if (m_Offset >= m_Data.size())
+        { return false; }
+
+    auto flags = m_Data[m_Offset++];
+    uint32_t elapsedMs;
+    if (!readVarint(m_Data, m_Offset, elapsedMs))
+        { return false; }
+    frame.timeMs += elapsedMs;
+    frame.crankDocked = (flags & k_CrankDocked) != 0;
+
+    if ((flags & k_ButtonsChanged) != 0)
+    {
+        uint8_t buttons[3];
+        if (!readRaw(m_Data, m_Offset, buttons))
+            { return false; }
+        frame.current = static_cast<PDButtons>(buttons[0]);
+        frame.pressed = static_cast<PDButtons>(buttons[1]);
+        frame.released = static_cast<PDButtons>(buttons[2]);
+    }
+    else
+    {
+        frame.pressed = static_cast<PDButtons>(0);
+        frame.released = static_cast<PDButtons>(0);
+    }
+
+    if ((flags & k_CrankMoved) != 0)
+    {
+        if (!readRaw(m_Data, m_Offset, frame.crankAngle) || !readRaw(m_Data, m_Offset, frame.crankChange))
+            { return false; }
+    }
+    else
+        { frame.crankChange = 0.0f; }
+
+    return true;
+}
@@ -0,0 +1,313 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#include <pdcpp/core/Log.h>
+
+#include <cctype>
+#include <cstdio>
+#include <pdcpp/core/File.h>
+#include <pdcpp/core/GlobalPlaydateAPI.h>
+
+namespace
+{
+    std::unique_ptr<pdcpp::Log> g_DefaultLog;
+
+    uint16_t readSize(const uint8_t* bytes) { return uint16_t(bytes[0] | bytes[1] << 8); }
+
+    void writeSize(uint8_t* bytes, size_t size)
+    {
+        bytes[0] = uint8_t(size);
+        bytes[1] = uint8_t(size >> 8);
+    }
+
+    const char* getPrefix(pdcpp::Log::Level level)
+    {
+        switch (level)
+        {
+            case pdcpp::Log::Level::Debug: return "DEBUG: ";
+            case pdcpp::Log::Level::Warning: return "WARN: ";
+            case pdcpp::Log::Level::Error: return "ERROR: ";
+            default: return "";
+        }
+    }
+
+    // Appends to a line, truncating at its end.
+    struct LineWriter
+    {
+        char* line;
+        size_t capacity;
+        size_t length = 0;
+
+        void put(char c)
+        {
+            if (length + 1 < capacity)
+                { line[length++] = c; }
+        }
+
+        void put(const char* s, size_t n)
+        {
+            for (size_t i = 0; i < n; ++i)
+                { put(s[i]); }
+        }
+
+        template <typename T>
+        void print(const char* spec, T value)
+        {
+            auto room = capacity - length;
+            auto n = std::snprintf(line + length, room, spec, value);
+            if (n > 0)
+                { length += std::min(size_t(n), room - 1); }
+        }
+    };
+}
+
+pdcpp::Log::Log(size_t capacity)
+    : m_Buffer(std::max<size_t>(capacity, 64))
+{}
+
+pdcpp::Log::~Log() = default;
+
+uint8_t* pdcpp::Log::beginRecord(size_t size)
+{
+    const auto total = size + 2;
+    const auto capacity = m_Buffer.size();
+    if (m_NumPending == 0)
+    {
+        m_Head = 0;
+        m_Tail = 0;
+    }
+
+    // Once the head has wrapped, the free space is what's between it and
+    // the tail. Until then, it's after the head, and before the tail.
+    size_t at;
+    bool wrapped = m_NumPending > 0 && m_Head <= m_Tail;
+    if (wrapped ? total <= m_Tail - m_Head : total <= capacity - m_Head)
+        { at = m_Head; }
+    else if (!wrapped && total <= m_Tail)
+    {
+        if (capacity - m_Head >= 2)
+            { writeSize(m_Buffer.data() + m_Head, 0); }
+        at = 0;
+    }
+    else
+    {
+        ++m_NumDropped;
+        ++m_TotalDropped;
+        return nullptr;
+    }
+
+    writeSize(m_Buffer.data() + at, total);
+    m_Head = at + total;
+    ++m_NumPending;
+    return m_Buffer.data() + at + 2;
+}
+
+void pdcpp::Log::flush(size_t maxMessages)
+{
+    // Only what's there now; anything logged while flushing waits for the
+    // next one.
+    auto count = std::min(m_NumPending, maxMessages);
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (m_Buffer.size() - m_Tail < 2 || readSize(m_Buffer.data() + m_Tail) == 0)
+            { m_Tail = 0; }
+
+        auto size = readSize(m_Buffer.data() + m_Tail);
+        Level level;
+        auto length = formatRecord(m_Buffer.data() + m_Tail + 2, size - 2, level);
+
+        m_Tail += size;
+        --m_NumPending;
+        output(level, m_Line.data(), length);
+    }
+
+    if (m_NumDropped > 0)
+    {
+        auto length = std::snprintf(m_Line.data(), m_Line.size(), "WARN: %u log messages dropped", unsigned(m_NumDropped));
+        m_NumDropped = 0;
+        output(Level::Warning, m_Line.data(), std::min(size_t(std::max(length, 0)), m_Line.size() - 1));
+    }
+}
+
+void pdcpp::Log::writeNow(const uint8_t* record, size_t size)
+{
+    flush();
+
+    Level level;
+    auto length = formatRecord(record, size, level);
+    output(level, m_Line.data(), length);
+}
+
+void pdcpp::Log::setLogFile(const std::string& path)
+{
+    p_File.reset();
+    if (path.empty())
+        { return; }
+
+    p_File = std::make_unique<pdcpp::FileHandle>(path, kFileWrite);
+    if (!p_File->isOpen())
+        { p_File.reset(); }
+}
+
+pdcpp::Log& pdcpp::Log::getDefault()
+{
+    if (g_DefaultLog == nullptr)
+        { g_DefaultLog = std::make_unique<Log>(); }
+    return *g_DefaultLog;
+}
+
+size_t pdcpp::Log::formatRecord(const uint8_t* record, size_t size, Level& level)
+{
+    const char* format;
+    std::memcpy(&format, record, sizeof(format));
+    level = Level(record[sizeof(format)]);
+    auto nArgs = record[sizeof(format) + 1];
+
+    const uint8_t* arg = record + k_RecordHeaderSize;
+    const uint8_t* end = record + size;
+
+    LineWriter out {m_Line.data(), m_Line.size()};
+    auto prefix = getPrefix(level);
+    out.put(prefix, std::strlen(prefix));
+
+    for (auto f = format; *f != '\0'; ++f)
+    {
+        if (*f != '%')
+        {
+            out.put(*f);
+            continue;
+        }
+        if (f[1] == '%')
+        {
+            out.put('%');
+            ++f;
+            continue;
+        }
+
+        // Flags, width, and precision are kept; length modifiers are
+        // replaced, as every argument was widened when it was recorded.
+        char spec[24] = "%";
+        size_t nSpec = 1;
+        auto p = f + 1;
+        for (; *p != '\0' && (std::strchr("-+ #0.", *p) != nullptr || std::isdigit(*p)); ++p)
+        {
+            if (nSpec < sizeof(spec) - 5)
+                { spec[nSpec++] = *p; }
+        }
+        for (; *p != '\0' && std::strchr("hljztLq", *p) != nullptr; ++p) {}
+
+        auto conversion = *p;
+        if (conversion == '\0')
+            { break; }
+        f = p;
+
+        if (nArgs == 0 || arg >= end)
+        {
+            out.put("<?>", 3);
+            continue;
+        }
+        --nArgs;
+
+        auto type = ArgumentType(*arg++);
+        if (type == String)
+        {
+            auto length = size_t(*arg++);
+            if (conversion == 's')
+            {
+                // Precision still applies, so it's printed through a copy.
+                char text[k_MaxStringLength + 1];
+                std::memcpy(text, arg, length);
+                text[length] = '\0';
+                std::strcpy(spec + nSpec, "s");
+                out.print(spec, static_cast<const char*>(text));
+            }
+            else
+                { out.put(reinterpret_cast<const char*>(arg), length); }
+            arg += length;
+            continue;
+        }
+
+        uint64_t bits;
+        std::memcpy(&bits, arg, sizeof(bits));
+        arg += 8;
+
+        double asDouble;
+        std::memcpy(&asDouble, &bits, sizeof(asDouble));
+        auto asInt = static_cast<long long>(bits);
+        auto asUnsigned = static_cast<unsigned long long>(bits);
+        if (type == Double)
+        {
+            asInt = static_cast<long long>(asDouble);
+            asUnsigned = static_cast<unsigned long long>(asInt);
+        }
+        else
+            { asDouble = type == Int ? double(asInt) : double(asUnsigned); }
+
+        switch (conversion)
+        {
+            case 'd': case 'i':
+                std::strcpy(spec + nSpec, "lld");
+                out.print(spec, asInt);
+                break;
+            case 'u': case 'o': case 'x': case 'X':
+                spec[nSpec++] = 'l';
+                spec[nSpec++] = 'l';
+                spec[nSpec++] = conversion;
+                spec[nSpec] = '\0';
+                out.print(spec, asUnsigned);
+                break;
+            case 'c':
+                std::strcpy(spec + nSpec, "c");
+                out.print(spec, int(asInt));
+                break;
+            case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+                spec[nSpec++] = conversion;
+                spec[nSpec] = '\0';
+                out.print(spec, asDouble);
+                break;
+            case 'p':
+                out.print("%p", reinterpret_cast<const void*>(uintptr_t(bits)));
+                break;
+            default:
+                // A number for a string: print it as best it can be.
+                if (type == Double)
+                    { out.print("%g", asDouble); }
+                else if (type == Pointer)
+                    { out.print("%p", reinterpret_cast<const void*>(uintptr_t(bits))); }
+                else if (type == Unsigned)
+                    { out.print("%llu", asUnsigned); }
+                else
+                    { out.print("%lld", asInt); }
+                break;
+        }
+    }
+
+    m_Line[out.length] = '\0';
+    return out.length;
+}
+
+void pdcpp::Log::output(Level level, const char* line, size_t length)
+{
+    if (m_ConsoleEnabled)
+    {
+        auto pd = pdcpp::GlobalPlaydateAPI::get();
+        if (level == Level::Error)
+            { pd->system->error("%s", line); }
+        else
+            { pd->system->logToConsole("%s", line); }
+    }
+
+    if (p_File != nullptr)
+    {
+        p_File->write(const_cast<char*>(line), static_cast<unsigned int>(length));
+        char newline = '\n';
+        p_File->write(&newline, 1);
+    }
+}
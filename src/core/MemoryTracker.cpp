@@ -0,0 +1,250 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#include <pdcpp/core/MemoryTracker.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    constexpr auto k_NumTags = static_cast<size_t>(pdcpp::MemoryTag::NumTags);
+    constexpr uint16_t k_Magic = 0x9d7c;
+    constexpr uint16_t k_AlignedMagic = 0x9d7d;
+
+    // Sits in front of every allocation, and keeps it aligned. Over-aligned
+    // allocations start somewhere inside their block, and keep a pointer to
+    // the start of it just in front of the header.
+    struct alignas(alignof(std::max_align_t)) Header
+    {
+        size_t size;
+        uint16_t magic;
+        uint8_t tag;
+        bool fromSystem;
+    };
+
+    pdcpp::MemoryTracker::TagStats g_Stats[k_NumTags];
+    pdcpp::MemoryTracker::TagStats g_Total;
+    pdcpp::MemoryTracker::BudgetCallback g_BudgetCallback = nullptr;
+    void* (*g_SystemRealloc)(void*, size_t) = nullptr;
+
+    void noteAllocation(pdcpp::MemoryTracker::TagStats& stats, size_t size)
+    {
+        stats.bytesInUse += size;
+        stats.highWaterMark = std::max(stats.highWaterMark, stats.bytesInUse);
+        ++stats.allocations;
+        ++stats.frameAllocations;
+    }
+
+    void noteFree(pdcpp::MemoryTracker::TagStats& stats, size_t size)
+    {
+        stats.bytesInUse -= std::min(stats.bytesInUse, size);
+        ++stats.frees;
+    }
+
+    void* allocateRaw(size_t total, bool fromSystem)
+        { return fromSystem ? g_SystemRealloc(nullptr, total) : std::malloc(total); }
+
+    void* track(Header* header, size_t bytes, pdcpp::MemoryTag tag, bool fromSystem, uint16_t magic)
+    {
+        header->size = bytes;
+        header->magic = magic;
+        header->tag = static_cast<uint8_t>(tag);
+        header->fromSystem = fromSystem;
+
+        auto& stats = g_Stats[header->tag];
+        auto wasWithinBudget = stats.budget == 0 || stats.bytesInUse <= stats.budget;
+        noteAllocation(stats, bytes);
+        noteAllocation(g_Total, bytes);
+
+        if (wasWithinBudget && stats.budget > 0 && stats.bytesInUse > stats.budget && g_BudgetCallback != nullptr)
+            { g_BudgetCallback(tag, stats.bytesInUse); }
+
+        return header + 1;
+    }
+}
+
+pdcpp::MemoryTag pdcpp::MemoryTracker::s_CurrentTag = pdcpp::MemoryTag::General;
+
+void* pdcpp::MemoryTracker::allocate(size_t bytes, MemoryTag tag)
+{
+    auto fromSystem = g_SystemRealloc != nullptr;
+    auto raw = allocateRaw(sizeof(Header) + bytes, fromSystem);
+    if (raw == nullptr)
+        { return nullptr; }
+
+    return track(static_cast<Header*>(raw), bytes, tag, fromSystem, k_Magic);
+}
+
+void* pdcpp::MemoryTracker::allocate(size_t bytes, size_t alignment, MemoryTag tag)
+{
+    if (alignment <= alignof(Header))
+        { return allocate(bytes, tag); }
+
+    auto fromSystem = g_SystemRealloc != nullptr;
+    auto raw = allocateRaw(sizeof(void*) + sizeof(Header) + alignment + bytes, fromSystem);
+    if (raw == nullptr)
+        { return nullptr; }
+
+    // The header is a multiple of its own alignment, so one right in front of
+    // an aligned pointer is aligned too.
+    auto first = reinterpret_cast<uintptr_t>(raw) + sizeof(void*) + sizeof(Header);
+    auto aligned = (first + alignment - 1) & ~(uintptr_t(alignment) - 1);
+    auto header = reinterpret_cast<Header*>(aligned) - 1;
+    reinterpret_cast<void**>(header)[-1] = raw;
+    return track(header, bytes, tag, fromSystem, k_AlignedMagic);
+}
+
+void pdcpp::MemoryTracker::deallocate(void* ptr)
+{
+    if (ptr == nullptr)
+        { return; }
+
+    auto header = static_cast<Header*>(ptr) - 1;
+    if ((header->magic != k_Magic && header->magic != k_AlignedMagic) || header->tag >= k_NumTags)
+    {
+        // Not ours, or freed twice. There's no telling how to free it, so in
+        // a release build it leaks.
+        assert(false && "MemoryTracker::deallocate was given memory it didn't allocate");
+        return;
+    }
+
+    noteFree(g_Stats[header->tag], header->size);
+    noteFree(g_Total, header->size);
+
+    void* block = header;
+    if (header->magic == k_AlignedMagic)
+        { block = reinterpret_cast<void**>(header)[-1]; }
+
+    header->magic = 0;
+    if (header->fromSystem)
+        { g_SystemRealloc(block, 0); }
+    else
+        { std::free(block); }
+}
+
+const pdcpp::MemoryTracker::TagStats& pdcpp::MemoryTracker::getStats(MemoryTag tag)
+    { return g_Stats[std::min(static_cast<size_t>(tag), k_NumTags - 1)]; }
+
+const pdcpp::MemoryTracker::TagStats& pdcpp::MemoryTracker::getTotalStats() { return g_Total; }
+
+const char* pdcpp::MemoryTracker::getTagName(MemoryTag tag)
+{
+    switch (tag)
+    {
+        case MemoryTag::General: return "general";
+        case MemoryTag::Graphics: return "graphics";
+        case MemoryTag::Audio: return "audio";
+        case MemoryTag::Components: return "components";
+        case MemoryTag::Files: return "files";
+        default: return "unknown";
+    }
+}
+
+void pdcpp::MemoryTracker::setBudget(MemoryTag tag, size_t bytes)
+{
+    if (tag < MemoryTag::NumTags)
+        { g_Stats[static_cast<size_t>(tag)].budget = bytes; }
+}
+
+void pdcpp::MemoryTracker::setBudgetCallback(BudgetCallback callback) { g_BudgetCallback = callback; }
+
+bool pdcpp::MemoryTracker::hasExceededBudget(MemoryTag tag)
+{
+    auto& stats = getStats(tag);
+    return stats.budget > 0 && stats.highWaterMark > stats.budget;
+}
+
+bool pdcpp::MemoryTracker::hasExceededAnyBudget()
+{
+    for (size_t i = 0; i < k_NumTags; ++i)
+    {
+        if (hasExceededBudget(static_cast<MemoryTag>(i)))
+            { return true; }
+    }
+    return false;
+}
+
+void pdcpp::MemoryTracker::endFrame()
+{
+    for (auto& stats : g_Stats)
+        { stats.frameAllocations = 0; }
+    g_Total.frameAllocations = 0;
+}
+
+void pdcpp::MemoryTracker::resetStats()
+{
+    auto reset = [](TagStats& stats)
+    {
+        stats.highWaterMark = stats.bytesInUse;
+        stats.allocations = 0;
+        stats.frees = 0;
+        stats.frameAllocations = 0;
+    };
+
+    for (auto& stats : g_Stats)
+        { reset(stats); }
+    reset(g_Total);
+}
+
+pdcpp::MemoryTag pdcpp::MemoryTracker::getCurrentTag() { return s_CurrentTag; }
+
+void pdcpp::MemoryTracker::setSystemRealloc(void* (*systemRealloc)(void*, size_t))
+    { g_SystemRealloc = systemRealloc; }
+
+#if PDCPP_TRACK_ALLOCATIONS
+// Every allocation in the game goes through the tracker, under whichever tag
+// is current. Memory allocated before the API is up comes from malloc, and the
+// header remembers which is which.
+namespace
+{
+    void* trackedNew(size_t size, std::align_val_t alignment=std::align_val_t(alignof(std::max_align_t))) noexcept
+    {
+        return pdcpp::MemoryTracker::allocate(size == 0 ? 1 : size, static_cast<size_t>(alignment),
+                                              pdcpp::MemoryTracker::getCurrentTag());
+    }
+
+    void* trackedNewOrFail(size_t size, std::align_val_t alignment=std::align_val_t(alignof(std::max_align_t)))
+    {
+        if (auto ptr = trackedNew(size, alignment))
+            { return ptr; }
+#if __cpp_exceptions
+        throw std::bad_alloc();
+#else
+        std::abort();
+#endif
+    }
+}
+
+void* operator new(size_t size) { return trackedNewOrFail(size); }
+void* operator new[](size_t size) { return trackedNewOrFail(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return trackedNew(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return trackedNew(size); }
+void* operator new(size_t size, std::align_val_t alignment) { return trackedNewOrFail(size, alignment); }
+void* operator new[](size_t size, std::align_val_t alignment) { return trackedNewOrFail(size, alignment); }
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+    { return trackedNew(size, alignment); }
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+    { return trackedNew(size, alignment); }
+void operator delete(void* ptr) noexcept { pdcpp::MemoryTracker::deallocate(ptr); }
+void operator delete[](void* ptr) noexcept { pdcpp::MemoryTracker::deallocate(ptr); }
+void operator delete(void* ptr, size_t) noexcept { pdcpp::MemoryTracker::deallocate(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { pdcpp::MemoryTracker::deallocate(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { pdcpp::MemoryTracker::deallocate(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { pdcpp::MemoryTracker::deallocate(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { pdcpp::MemoryTracker::deallocate(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { pdcpp::MemoryTracker::deallocate(ptr); }
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept { pdcpp::MemoryTracker::deallocate(ptr); }
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept { pdcpp::MemoryTracker::deallocate(ptr); }
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { pdcpp::MemoryTracker::deallocate(ptr); }
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { pdcpp::MemoryTracker::deallocate(ptr); }
+#endif
@@ -0,0 +1,256 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#include <pdcpp/core/Profiler.h>
+#include <pdcpp/core/GlobalPlaydateAPI.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+    using Profiler = pdcpp::Profiler;
+
+    struct FrameRecord
+    {
+        uint32_t frameUs;
+        uint32_t zoneUs[Profiler::k_MaxZones];
+        uint16_t zoneCalls[Profiler::k_MaxZones];
+    };
+
+    struct ProfilerState
+    {
+        const char* zoneNames[Profiler::k_MaxZones] {};
+        int nZones = 0;
+
+        FrameRecord current {};
+        FrameRecord history[Profiler::k_MaxFrames] {};
+        int nextFrame = 0;
+        int nFrames = 0;
+        uint32_t frameStart = 0;
+        bool frameStarted = false;
+
+        // Read from the audio context too.
+        std::atomic<Profiler::TimeSource> timeSource = nullptr;
+
+        // The default clock is the system's elapsed time, which is a float
+        // in seconds. It's reset every frame to keep its precision, and the
+        // time up to the reset is kept here.
+        uint32_t elapsedBaseUs = 0;
+    };
+
+    ProfilerState g_State;
+
+    // Audio zones are constructed in the audio context, so they claim a slot
+    // here and leave registering them as zones to the main thread.
+    std::atomic<Profiler::AudioZone*> g_AudioZones[Profiler::k_MaxAudioZones] {};
+    std::atomic<int> g_NumAudioZones = 0;
+
+    uint32_t elapsedTimeMicroseconds()
+    {
+        auto seconds = pdcpp::GlobalPlaydateAPI::getUninterposed()->system->getElapsedTime();
+        return g_State.elapsedBaseUs + static_cast<uint32_t>(seconds * 1000000.0f);
+    }
+
+    // The audio context can't use the running base, as the main thread moves
+    // it, so it times off the raw elapsed time and drops anything spanning a
+    // reset instead.
+    uint32_t audioNow(Profiler::TimeSource source)
+    {
+        if (source != nullptr)
+            { return source(); }
+        return static_cast<uint32_t>(pdcpp::GlobalPlaydateAPI::getUninterposed()->system->getElapsedTime() * 1000000.0f);
+    }
+
+    void restartElapsedTime()
+    {
+        auto sys = pdcpp::GlobalPlaydateAPI::getUninterposed()->system;
+        g_State.elapsedBaseUs += static_cast<uint32_t>(sys->getElapsedTime() * 1000000.0f);
+        sys->resetElapsedTime();
+    }
+
+    Profiler::Stats summarize(const char* name, int nFrames, uint32_t (*timeOf)(const FrameRecord&, int), int index)
+    {
+        Profiler::Stats stats;
+        stats.name = name;
+
+        nFrames = nFrames <= 0 ? g_State.nFrames : std::min(nFrames, g_State.nFrames);
+        if (nFrames == 0)
+            { return stats; }
+
+        uint64_t total = 0;
+        uint64_t calls = 0;
+        stats.minUs = std::numeric_limits<uint32_t>::max();
+        for (int i = 1; i <= nFrames; ++i)
+        {
+            auto& frame = g_State.history[pdcpp::wrapIndex(g_State.nextFrame - i, Profiler::k_MaxFrames)];
+            auto us = timeOf(frame, index);
+            stats.minUs = std::min(stats.minUs, us);
+            stats.maxUs = std::max(stats.maxUs, us);
+            total += us;
+            calls += index < 0 ? 1 : frame.zoneCalls[index];
+        }
+
+        stats.avgUs = static_cast<uint32_t>(total / static_cast<uint64_t>(nFrames));
+        stats.avgCalls = float(calls) / float(nFrames);
+        return stats;
+    }
+}
+
+pdcpp::Profiler::Zone::Zone(const char* name)
+    : p_Name(name)
+    , m_Index(-1)
+{
+    if (g_State.nZones < k_MaxZones)
+    {
+        m_Index = g_State.nZones++;
+        g_State.zoneNames[m_Index] = p_Name;
+    }
+}
+
+pdcpp::Profiler::ScopedZone::ScopedZone(Zone& zone)
+    : r_Zone(zone)
+    , m_Start(0)
+{
+    if (r_Zone.m_Depth++ == 0)
+        { m_Start = now(); }
+}
+
+pdcpp::Profiler::ScopedZone::~ScopedZone()
+{
+    if (--r_Zone.m_Depth == 0)
+        { record(r_Zone, now() - m_Start); }
+}
+
+pdcpp::Profiler::AudioZone::AudioZone(const char* name)
+    : p_Name(name)
+{
+    auto slot = g_NumAudioZones.fetch_add(1, std::memory_order_relaxed);
+    if (slot < k_MaxAudioZones)
+        { g_AudioZones[slot].store(this, std::memory_order_release); }
+}
+
+pdcpp::Profiler::ScopedAudioZone::ScopedAudioZone(AudioZone& zone)
+    : r_Zone(zone)
+    , m_Start(0)
+{
+    if (r_Zone.m_Depth++ == 0)
+        { m_Start = audioNow(g_State.timeSource.load(std::memory_order_relaxed)); }
+}
+
+pdcpp::Profiler::ScopedAudioZone::~ScopedAudioZone()
+{
+    if (--r_Zone.m_Depth != 0)
+        { return; }
+
+    auto source = g_State.timeSource.load(std::memory_order_relaxed);
+    auto end = audioNow(source);
+    if (source == nullptr && end < m_Start)
+        { return; }
+
+    r_Zone.m_PendingUs.fetch_add(end - m_Start, std::memory_order_relaxed);
+    r_Zone.m_PendingCalls.fetch_add(1, std::memory_order_relaxed);
+}
+
+void pdcpp::Profiler::collectAudioZones()
+{
+    auto nAudioZones = std::min(g_NumAudioZones.load(std::memory_order_relaxed), k_MaxAudioZones);
+    for (int i = 0; i < nAudioZones; ++i)
+    {
+        auto zone = g_AudioZones[i].load(std::memory_order_acquire);
+        if (zone == nullptr)
+            { continue; }
+
+        if (zone->m_Index < 0 && g_State.nZones < k_MaxZones)
+        {
+            zone->m_Index = g_State.nZones++;
+            g_State.zoneNames[zone->m_Index] = zone->p_Name;
+        }
+
+        auto us = zone->m_PendingUs.exchange(0, std::memory_order_relaxed);
+        auto calls = zone->m_PendingCalls.exchange(0, std::memory_order_relaxed);
+        if (zone->m_Index < 0)
+            { continue; }
+
+        g_State.current.zoneUs[zone->m_Index] += us;
+        auto totalCalls = std::min<uint32_t>(g_State.current.zoneCalls[zone->m_Index] + calls,
+                                             std::numeric_limits<uint16_t>::max());
+        g_State.current.zoneCalls[zone->m_Index] = static_cast<uint16_t>(totalCalls);
+    }
+}
+
+void pdcpp::Profiler::record(Zone& zone, uint32_t elapsedUs)
+{
+    if (zone.m_Index < 0)
+        { return; }
+
+    g_State.current.zoneUs[zone.m_Index] += elapsedUs;
+    if (g_State.current.zoneCalls[zone.m_Index] < std::numeric_limits<uint16_t>::max())
+        { ++g_State.current.zoneCalls[zone.m_Index]; }
+}
+
+void pdcpp::Profiler::endFrame()
+{
+    auto end = now();
+    collectAudioZones();
+    if (g_State.frameStarted)
+    {
+        g_State.current.frameUs = end - g_State.frameStart;
+        g_State.history[g_State.nextFrame] = g_State.current;
+        g_State.nextFrame = (g_State.nextFrame + 1) % k_MaxFrames;
+        g_State.nFrames = std::min(g_State.nFrames + 1, k_MaxFrames);
+    }
+
+    g_State.current = {};
+    if (g_State.timeSource.load(std::memory_order_relaxed) == nullptr)
+        { restartElapsedTime(); }
+
+    g_State.frameStart = now();
+    g_State.frameStarted = true;
+}
+
+void pdcpp::Profiler::reset()
+{
+    collectAudioZones();
+    g_State.current = {};
+    g_State.nextFrame = 0;
+    g_State.nFrames = 0;
+    g_State.frameStarted = false;
+}
+
+void pdcpp::Profiler::setTimeSource(TimeSource source)
+{
+    g_State.timeSource.store(source, std::memory_order_relaxed);
+    reset();
+}
+
+uint32_t pdcpp::Profiler::now()
+{
+    auto source = g_State.timeSource.load(std::memory_order_relaxed);
+    return source != nullptr ? source() : elapsedTimeMicroseconds();
+}
+
+int pdcpp::Profiler::getNumZones() { return g_State.nZones; }
+
+int pdcpp::Profiler::getNumFrames() { return g_State.nFrames; }
+
+pdcpp::Profiler::Stats pdcpp::Profiler::getZoneStats(int zoneIndex, int nFrames)
+{
+    if (zoneIndex < 0 || zoneIndex >= g_State.nZones)
+        { return {}; }
+
+    return summarize(g_State.zoneNames[zoneIndex], nFrames,
+                     [](const FrameRecord& frame, int i) { return frame.zoneUs[i]; }, zoneIndex);
+}
+
+pdcpp::Profiler::Stats pdcpp::Profiler::getFrameStats(int nFrames)
+{
+    return summarize("frame", nFrames, [](const FrameRecord& frame, int) { return frame.frameUs; }, -1);
+}
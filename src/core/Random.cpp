@@ -11,23 +11,109 @@
 #include <pdcpp/core/Random.h>
 #include <pdcpp/core/GlobalPlaydateAPI.h>
 
+#include <tuple>
+#include <utility>
+
+namespace
+{
+    // Spreads the bits of a seed, so that similar seeds give unrelated
+    // states.
+    uint32_t splitMix32(uint32_t& x)
+    {
+        auto z = (x += 0x9e3779b9);
+        z = (z ^ (z >> 16)) * 0x85ebca6b;
+        z = (z ^ (z >> 13)) * 0xc2b2ae35;
+        return z ^ (z >> 16);
+    }
+
+    constexpr uint32_t k_Jump[4] = {0x8764000b, 0xf542d2d3, 0x6fa035c3, 0x77f2db5b};
+    constexpr uint32_t k_LongJump[4] = {0xb523952e, 0x0b6f099f, 0xccf5a0ef, 0x1c580662};
+}
+
 pdcpp::Random::Random()
-    : seed(pdcpp::GlobalPlaydateAPI::get()->system->getCurrentTimeMilliseconds())
+    : Random(pdcpp::GlobalPlaydateAPI::get()->system->getCurrentTimeMilliseconds())
 {}
 
 pdcpp::Random::Random(unsigned int user_seed)
-    : seed(user_seed)
-{}
+    { setSeed(user_seed); }
+
+void pdcpp::Random::setSeed(unsigned int seed)
+{
+    for (auto& word : m_State)
+        { word = splitMix32(seed); }
+
+    // The one state xoshiro can't leave.
+    if ((m_State[0] | m_State[1] | m_State[2] | m_State[3]) == 0)
+        { m_State[0] = 1; }
+}
+
+uint32_t pdcpp::Random::nextInt(uint32_t bound)
+{
+    // Lemire's multiply-and-shift, rejecting the few results which would
+    // bias the low values.
+    auto product = uint64_t(next()) * bound;
+    auto low = static_cast<uint32_t>(product);
+    if (low < bound)
+    {
+        const auto threshold = (0u - bound) % bound;
+        while (low < threshold)
+        {
+            product = uint64_t(next()) * bound;
+            low = static_cast<uint32_t>(product);
+        }
+    }
+    return static_cast<uint32_t>(product >> 32);
+}
 
-unsigned int pdcpp::Random::next()
+int32_t pdcpp::Random::nextIntInRange(int32_t minValue, int32_t maxValue)
 {
-    srand(seed);
-    seed = rand();
-    return seed;
+    if (maxValue < minValue)
+        { std::swap(minValue, maxValue); }
+
+    const auto span = static_cast<uint32_t>(maxValue) - static_cast<uint32_t>(minValue);
+    const auto offset = span == std::numeric_limits<uint32_t>::max() ? next() : nextInt(span + 1);
+    return static_cast<int32_t>(static_cast<uint32_t>(minValue) + offset);
+}
+
+void pdcpp::Random::fill(std::span<uint32_t> values)
+{
+    for (auto& value : values)
+        { value = next(); }
+}
+
+void pdcpp::Random::fill(std::span<float> values, float minValue, float maxValue)
+{
+    const auto scale = (maxValue - minValue) * 0x1.0p-24f;
+    for (auto& value : values)
+        { value = static_cast<float>(next() >> 8) * scale + minValue; }
 }
 
-float pdcpp::Random::nextFloatInRange(float minValue, float maxValue)
+void pdcpp::Random::fill(std::span<int32_t> values, int32_t minValue, int32_t maxValue)
 {
-    auto range = maxValue - minValue;
-    return (float(next()) / float(RAND_MAX)) * range + minValue;
+    for (auto& value : values)
+        { value = nextIntInRange(minValue, maxValue); }
+}
+
+void pdcpp::Random::jump() { jumpBy(k_Jump); }
+
+void pdcpp::Random::longJump() { jumpBy(k_LongJump); }
+
+void pdcpp::Random::jumpBy(const uint32_t (&polynomial)[4])
+{
+    uint32_t jumped[4] = {0, 0, 0, 0};
+    for (auto word : polynomial)
+    {
+        for (int bit = 0; bit < 32; ++bit)
+        {
+            if ((word & (1u << bit)) != 0)
+            {
+                for (int i = 0; i < 4; ++i)
+                    { jumped[i] ^= m_State[i]; }
+            }
+            std::ignore = next();
+        }
+    }
+
+    for (int i = 0; i < 4; ++i)
+        { m_State[i] = jumped[i]; }
 }
@@ -0,0 +1,63 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#include <pdcpp/core/Registry.h>
+
+pdcpp::Entity pdcpp::Registry::create()
+{
+    Entity index;
+    if (!m_FreeIds.empty())
+    {
+        index = m_FreeIds.back();
+        m_FreeIds.pop_back();
+    }
+    else
+    {
+        assert(m_Versions.size() < k_MaxEntities);
+        index = Entity(m_Versions.size());
+        m_Versions.push_back(0);
+    }
+
+    m_Alive.insert(index);
+    return entityAt(index);
+}
+
+void pdcpp::Registry::destroy(Entity entity)
+{
+    if (!isAlive(entity))
+        { return; }
+
+    auto index = indexOf(entity);
+    for (auto& pool : m_Pools)
+    {
+        if (pool != nullptr)
+            { pool->erase(index); }
+    }
+
+    m_Alive.erase(index);
+    m_Versions[index] = (m_Versions[index] + 1) & k_VersionMask;
+    m_FreeIds.push_back(index);
+}
+
+void pdcpp::Registry::clear()
+{
+    for (auto& pool : m_Pools)
+    {
+        if (pool != nullptr)
+            { pool->clear(); }
+    }
+
+    for (auto index : m_Alive)
+    {
+        m_Versions[index] = (m_Versions[index] + 1) & k_VersionMask;
+        m_FreeIds.push_back(index);
+    }
+    m_Alive.clear();
+}
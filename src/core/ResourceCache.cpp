@@ -0,0 +1,52 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#include <pdcpp/core/ResourceCache.h>
+
+#include <pdcpp/audio/AudioSample.h>
+#include <pdcpp/core/GlobalPlaydateAPI.h>
+#include <pdcpp/graphics/Font.h>
+#include <pdcpp/graphics/Image.h>
+#include <pdcpp/graphics/ImageTable.h>
+
+namespace
+{
+    size_t bitmapSize(LCDBitmap* bitmap)
+    {
+        if (bitmap == nullptr)
+            { return 0; }
+
+        int width, height, rowBytes;
+        uint8_t* mask = nullptr;
+        uint8_t* data = nullptr;
+        pdcpp::GlobalPlaydateAPI::get()->graphics->getBitmapData(bitmap, &width, &height, &rowBytes, &mask, &data);
+        auto bytes = static_cast<size_t>(rowBytes) * static_cast<size_t>(height);
+        return mask != nullptr ? bytes * 2 : bytes;
+    }
+}
+
+size_t pdcpp::getResourceSize(const Image& image) { return bitmapSize(image); }
+
+size_t pdcpp::getResourceSize(const ImageTable& table)
+{
+    if (static_cast<LCDBitmapTable*>(table) == nullptr)
+        { return 0; }
+
+    size_t bytes = 0;
+    auto count = table.getInfo().count;
+    for (int i = 0; i < count; ++i)
+        { bytes += bitmapSize(table[i]); }
+    return bytes;
+}
+
+size_t pdcpp::getResourceSize(const Font&) { return 0; }
+
+size_t pdcpp::getResourceSize(const AudioSample& sample)
+    { return static_cast<::AudioSample*>(sample) == nullptr ? 0 : sample.getLengthInBytes(); }
@@ -0,0 +1,200 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#include <pdcpp/core/Serializer.h>
+
+#include <pdcpp/core/File.h>
+#include <pdcpp/core/GlobalPlaydateAPI.h>
+#include <pdcpp/core/MemoryTracker.h>
+
+namespace
+{
+    void writeU32(uint8_t* bytes, uint32_t value)
+    {
+        for (int i = 0; i < 4; ++i)
+            { bytes[i] = uint8_t(value >> (8 * i)); }
+    }
+
+    uint32_t readU32(const uint8_t* bytes)
+        { return uint32_t(bytes[0]) | uint32_t(bytes[1]) << 8 | uint32_t(bytes[2]) << 16 | uint32_t(bytes[3]) << 24; }
+
+    // 32-bit FNV-1a: enough to catch a truncated or scribbled-on save.
+    uint32_t fnv1a(const uint8_t* data, size_t size, uint32_t hash=2166136261u)
+    {
+        for (size_t i = 0; i < size; ++i)
+        {
+            hash ^= data[i];
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    // Covers the version as well as the payload, which is everything in the
+    // buffer after the size and checksum themselves.
+    uint32_t checksum(const uint8_t* buffer, size_t size)
+        { return fnv1a(buffer + pdcpp::Serializer::k_HeaderSize, size - pdcpp::Serializer::k_HeaderSize, fnv1a(buffer + 4, 4)); }
+}
+
+pdcpp::Serializer::Serializer(uint32_t version)
+    : m_Data(k_HeaderSize)
+    , m_Version(version)
+{}
+
+void pdcpp::Serializer::writeBytes(const void* data, size_t size)
+{
+    pdcpp::ScopedMemoryTag tag(pdcpp::MemoryTag::Files);
+    auto bytes = static_cast<const uint8_t*>(data);
+    m_Data.insert(m_Data.end(), bytes, bytes + size);
+}
+
+void pdcpp::Serializer::writeLength(uint64_t length)
+{
+    uint8_t bytes[10];
+    size_t n = 0;
+    do
+    {
+        bytes[n] = uint8_t(length & 0x7f);
+        length >>= 7;
+        if (length != 0)
+            { bytes[n] |= 0x80; }
+        ++n;
+    } while (length != 0);
+    writeBytes(bytes, n);
+}
+
+const std::vector<uint8_t>& pdcpp::Serializer::finish()
+{
+    auto payload = m_Data.size() - k_HeaderSize;
+    writeU32(m_Data.data(), k_Magic);
+    writeU32(m_Data.data() + 4, m_Version);
+    writeU32(m_Data.data() + 8, uint32_t(payload));
+    writeU32(m_Data.data() + 12, checksum(m_Data.data(), m_Data.size()));
+    return m_Data;
+}
+
+bool pdcpp::Serializer::saveToFile(const std::string& path)
+{
+    auto& data = finish();
+    auto temporary = path + ".tmp";
+    {
+        pdcpp::FileHandle file(temporary, kFileWrite);
+        if (!file.isOpen())
+            { return false; }
+
+        if (file.write(const_cast<uint8_t*>(data.data()), static_cast<unsigned int>(data.size())) != int(data.size()))
+        {
+            pdcpp::FileHelpers::handleError("Failed to write " + temporary);
+            return false;
+        }
+    }
+
+    // The file is closed, and so complete, before it replaces the save.
+    if (pdcpp::FileHelpers::rename(temporary, path) != 0)
+    {
+        pdcpp::FileHelpers::handleError("Failed to replace " + path);
+        return false;
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+pdcpp::Deserializer::Deserializer(std::vector<uint8_t> data)
+    : m_Owned(std::move(data))
+    , p_Data(m_Owned.data())
+    , m_Size(m_Owned.size())
+{ readHeader(); }
+
+pdcpp::Deserializer::Deserializer(const void* data, size_t size)
+    : p_Data(static_cast<const uint8_t*>(data))
+    , m_Size(size)
+{ readHeader(); }
+
+pdcpp::Deserializer pdcpp::Deserializer::fromFile(const std::string& path)
+{
+    // No save yet isn't an error worth logging.
+    if (!pdcpp::FileHelpers::fileExists(path))
+        { return Deserializer(nullptr, 0); }
+
+    pdcpp::FileHandle file(path, kFileReadData);
+    if (!file.isOpen())
+        { return Deserializer(nullptr, 0); }
+
+    pdcpp::ScopedMemoryTag tag(pdcpp::MemoryTag::Files);
+    std::vector<uint8_t> data(file.getDetails().size);
+    if (file.read(data.data(), static_cast<unsigned int>(data.size())) != int(data.size()))
+        { return Deserializer(nullptr, 0); }
+
+    return Deserializer(std::move(data));
+}
+
+std::string_view pdcpp::Deserializer::readStringView()
+{
+    auto length = readLength();
+    if (m_Failed || length > getRemaining())
+    {
+        fail();
+        return {};
+    }
+
+    std::string_view view(reinterpret_cast<const char*>(p_Data + m_Position), size_t(length));
+    m_Position += size_t(length);
+    return view;
+}
+
+bool pdcpp::Deserializer::readBytes(void* destination, size_t size)
+{
+    if (m_Failed || size > getRemaining())
+        { return fail(); }
+
+    std::memcpy(destination, p_Data + m_Position, size);
+    m_Position += size;
+    return true;
+}
+
+uint64_t pdcpp::Deserializer::readLength()
+{
+    uint64_t length = 0;
+    for (int shift = 0; shift < 64; shift += 7)
+    {
+        if (m_Failed || m_Position >= m_Size)
+            { break; }
+
+        auto byte = p_Data[m_Position++];
+        length |= uint64_t(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0)
+            { return length; }
+    }
+
+    fail();
+    return 0;
+}
+
+void pdcpp::Deserializer::readHeader()
+{
+    if (m_Size < Serializer::k_HeaderSize
+        || readU32(p_Data) != Serializer::k_Magic
+        || readU32(p_Data + 8) != m_Size - Serializer::k_HeaderSize
+        || readU32(p_Data + 12) != checksum(p_Data, m_Size))
+    {
+        fail();
+        return;
+    }
+
+    m_Version = readU32(p_Data + 4);
+    m_Position = Serializer::k_HeaderSize;
+}
+
+bool pdcpp::Deserializer::fail()
+{
+    m_Failed = true;
+    m_Position = m_Size;
+    return false;
+}
@@ -10,6 +10,7 @@
 
 #include <pdcpp/core/SystemMenu.h>
 #include <pdcpp/core/GlobalPlaydateAPI.h>
+#include <pdcpp/core/Log.h>
 
 
 pdcpp::SystemMenu::ItemBase::~ItemBase()
@@ -25,15 +26,12 @@ void pdcpp::SystemMenu::ItemBase::setTitle(const std::string& title)
     { pdcpp::GlobalPlaydateAPI::get()->system->setMenuItemTitle(p_Item, title.c_str()); }
 
 
-pdcpp::SystemMenu::BasicItem::BasicItem(const std::string& title, std::function<void()> callbackIn)
+pdcpp::SystemMenu::BasicItem::BasicItem(const std::string& title, Callback callbackIn)
     : callback(std::move(callbackIn))
 {
     p_Item = pdcpp::GlobalPlaydateAPI::get()->system->addMenuItem(title.c_str(), shim, this);
     if (p_Item == nullptr)
-    {
-        auto err = "Failed to create menu item " + title;
-        pdcpp::GlobalPlaydateAPI::get()->system->error(err.c_str());
-    }
+        { PDCPP_LOG_ERROR("Failed to create menu item %s", title); }
 }
 
 void pdcpp::SystemMenu::BasicItem::shim(void* usrData)
@@ -43,15 +41,12 @@ void pdcpp::SystemMenu::BasicItem::shim(void* usrData)
 }
 
 
-pdcpp::SystemMenu::CheckmarkItem::CheckmarkItem(const std::string& title, bool isChecked, std::function<void(bool)> callbackIn)
+pdcpp::SystemMenu::CheckmarkItem::CheckmarkItem(const std::string& title, bool isChecked, Callback callbackIn)
     : callback(std::move(callbackIn))
 {
     p_Item = pdcpp::GlobalPlaydateAPI::get()->system->addCheckmarkMenuItem(title.c_str(), isChecked, shim, this);
     if (p_Item == nullptr)
-    {
-        auto err = "Failed to create menu item " + title;
-        pdcpp::GlobalPlaydateAPI::get()->system->error(err.c_str());
-    }
+        { PDCPP_LOG_ERROR("Failed to create menu item %s", title); }
 }
 
 bool pdcpp::SystemMenu::CheckmarkItem::isChecked() const
@@ -72,7 +67,7 @@ void pdcpp::SystemMenu::CheckmarkItem::shim(void* usrData)
 
 
 pdcpp::SystemMenu::OptionsItem::OptionsItem(
-const std::string& title, std::vector<std::string> options, std::function<void(const std::string&, int)> callbackIn, int startingIndex)
+const std::string& title, std::vector<std::string> options, Callback callbackIn, int startingIndex)
     : m_Options(std::move(options))
     , callback(std::move(callbackIn))
 {
@@ -83,10 +78,7 @@ const std::string& title, std::vector<std::string> options, std::function<void(c
 
     p_Item = pdcpp::GlobalPlaydateAPI::get()->system->addOptionsMenuItem(title.c_str(), m_CStrings.data(), int(m_CStrings.size()), shim, this);
     if (p_Item == nullptr)
-    {
-        auto err = "Failed to create menu item " + title;
-        pdcpp::GlobalPlaydateAPI::get()->system->error(err.c_str());
-    }
+        { PDCPP_LOG_ERROR("Failed to create menu item %s", title); }
 
     setSelectedIndex(startingIndex);
 }
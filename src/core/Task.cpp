@@ -0,0 +1,141 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#include <pdcpp/core/Task.h>
+
+#include <algorithm>
+#include <cassert>
+#include <pdcpp/core/Profiler.h>
+
+namespace
+{
+    std::unique_ptr<pdcpp::TaskScheduler> g_DefaultScheduler;
+
+    pdcpp::TaskScheduler& currentScheduler()
+    {
+        auto scheduler = pdcpp::TaskScheduler::getCurrent();
+        assert(scheduler != nullptr && "Tasks can only suspend while a TaskScheduler is running them");
+        return *scheduler;
+    }
+}
+
+pdcpp::TaskScheduler* pdcpp::TaskScheduler::s_Current = nullptr;
+
+std::coroutine_handle<> pdcpp::Task::FinalAwaiter::await_suspend(Handle finished) noexcept
+{
+    auto continuation = finished.promise().continuation;
+    return continuation ? continuation : std::noop_coroutine();
+}
+
+pdcpp::Task::~Task()
+{
+    if (m_Handle)
+        { m_Handle.destroy(); }
+}
+
+pdcpp::Task& pdcpp::Task::operator=(Task&& other) noexcept
+{
+    if (this != &other)
+    {
+        if (m_Handle)
+            { m_Handle.destroy(); }
+        m_Handle = std::exchange(other.m_Handle, {});
+    }
+    return *this;
+}
+
+std::coroutine_handle<> pdcpp::Task::await_suspend(std::coroutine_handle<> awaiting) noexcept
+{
+    m_Handle.promise().continuation = awaiting;
+    return m_Handle;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+pdcpp::TaskScheduler::TaskScheduler(float frameBudgetMs)
+    : m_Budget(frameBudgetMs)
+{}
+
+pdcpp::TaskScheduler::~TaskScheduler() { cancelAll(); }
+
+void pdcpp::TaskScheduler::spawn(Task task)
+{
+    if (task.isDone())
+        { return; }
+
+    m_Ready.push_back(task.m_Handle);
+    m_Tasks.push_back(std::move(task));
+}
+
+void pdcpp::TaskScheduler::update()
+{
+    PDCPP_PROFILE_SCOPE("TaskScheduler::update");
+
+    auto previous = std::exchange(s_Current, this);
+    m_Budget.start();
+
+    // Whatever's left over from last frame goes first, then whatever was
+    // waiting for this frame, then whatever's woken up.
+    m_Ready.erase(m_Ready.begin(), m_Ready.begin() + static_cast<std::ptrdiff_t>(m_NextReady));
+    m_NextReady = 0;
+    m_Ready.insert(m_Ready.end(), m_NextFrame.begin(), m_NextFrame.end());
+    m_NextFrame.clear();
+    m_Timers.update();
+
+    auto ranOne = false;
+    while (m_NextReady < m_Ready.size() && !(ranOne && isOverBudget()))
+    {
+        auto task = m_Ready[m_NextReady++];
+        task.resume();
+        ranOne = true;
+    }
+
+    s_Current = previous;
+
+    std::erase_if(m_Tasks, [](const Task& task) { return task.isDone(); });
+}
+
+void pdcpp::TaskScheduler::cancelAll()
+{
+    // Every suspended handle belongs to one of the tasks, so the queues must go
+    // before the frames do.
+    m_Ready.clear();
+    m_NextReady = 0;
+    m_NextFrame.clear();
+    m_Timers.cancelAll();
+    m_Tasks.clear();
+}
+
+void pdcpp::TaskScheduler::setFrameBudget(float budgetMs) { m_Budget.setBudget(budgetMs); }
+
+bool pdcpp::TaskScheduler::isOverBudget() const { return m_Budget.isSpent(); }
+
+pdcpp::TaskScheduler& pdcpp::TaskScheduler::getDefault()
+{
+    if (g_DefaultScheduler == nullptr)
+        { g_DefaultScheduler = std::make_unique<TaskScheduler>(); }
+    return *g_DefaultScheduler;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void pdcpp::NextFrameAwaiter::await_suspend(std::coroutine_handle<> task) const
+    { currentScheduler().m_NextFrame.push_back(task); }
+
+void pdcpp::WaitAwaiter::await_suspend(std::coroutine_handle<> task) const
+{
+    auto& scheduler = currentScheduler();
+    scheduler.m_Timers.after(delayMs, [&scheduler, task](){ scheduler.m_Ready.push_back(task); });
+}
+
+bool pdcpp::BudgetAwaiter::await_ready() const { return !currentScheduler().isOverBudget(); }
+
+void pdcpp::BudgetAwaiter::await_suspend(std::coroutine_handle<> task) const
+    { currentScheduler().m_Ready.push_back(task); }
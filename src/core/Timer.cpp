@@ -19,18 +19,43 @@ pdcpp::Timer::Timer(unsigned int intervalMs, bool startEnabled)
     m_LastMilliseconds = pd->system->getCurrentTimeMilliseconds();
 }
 
+pdcpp::Timer::~Timer() { m_Handle.cancel(); }
+
 void pdcpp::Timer::setInterval(unsigned int intervalMs, bool reset)
 {
+    auto changed = intervalMs != m_Interval;
     m_Interval = intervalMs;
     if (reset)
         { m_LastMilliseconds = pdcpp::GlobalPlaydateAPI::get()->system->getCurrentTimeMilliseconds(); }
+    if (changed || reset)
+        { schedule(); }
 }
 
-void pdcpp::Timer::enable(bool shouldEnable) { m_Enabled = shouldEnable; }
+void pdcpp::Timer::enable(bool shouldEnable)
+{
+    auto changed = shouldEnable != m_Enabled;
+    m_Enabled = shouldEnable;
+    if (changed)
+        { schedule(); }
+}
+
+void pdcpp::Timer::useService(TimerService& service)
+{
+    m_Handle.cancel();
+    p_Service = &service;
+    schedule();
+}
+
+void pdcpp::Timer::schedule()
+{
+    m_Handle.cancel();
+    if (p_Service != nullptr && m_Enabled)
+        { m_Handle = p_Service->every(m_Interval, [this](){ timerCallback(); }); }
+}
 
 void pdcpp::Timer::tick()
 {
-    if (!m_Enabled) { return; }
+    if (!m_Enabled || p_Service != nullptr) { return; }
     auto pd = pdcpp::GlobalPlaydateAPI::get();
     auto now = pd->system->getCurrentTimeMilliseconds();
     if (now - m_LastMilliseconds >= m_Interval)
@@ -48,18 +73,43 @@ pdcpp::FrameTimer::FrameTimer(unsigned int nFrames, bool startEnabled)
     , m_Enabled(startEnabled)
 {}
 
+pdcpp::FrameTimer::~FrameTimer() { m_Handle.cancel(); }
+
 void pdcpp::FrameTimer::setNFrames(unsigned int nFrames, bool reset)
 {
+    auto changed = nFrames != m_NFrames;
     m_NFrames = nFrames;
     if (reset)
         { m_FramesRemaining = m_NFrames; }
+    if (changed || reset)
+        { schedule(); }
 }
 
-void pdcpp::FrameTimer::enable(bool shouldEnable) { m_FramesRemaining = shouldEnable; }
+void pdcpp::FrameTimer::enable(bool shouldEnable)
+{
+    auto changed = shouldEnable != m_Enabled;
+    m_Enabled = shouldEnable;
+    if (changed)
+        { schedule(); }
+}
+
+void pdcpp::FrameTimer::useService(TimerService& service)
+{
+    m_Handle.cancel();
+    p_Service = &service;
+    schedule();
+}
+
+void pdcpp::FrameTimer::schedule()
+{
+    m_Handle.cancel();
+    if (p_Service != nullptr && m_Enabled)
+        { m_Handle = p_Service->everyFrames(m_NFrames, [this](){ timerCallback(); }); }
+}
 
 void pdcpp::FrameTimer::tick()
 {
-    if (!m_Enabled) { return; }
+    if (!m_Enabled || p_Service != nullptr) { return; }
     if (--m_FramesRemaining == 0)
     {
         timerCallback();
@@ -0,0 +1,409 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#include <pdcpp/core/TimerService.h>
+
+#include <algorithm>
+#include <array>
+#include <utility>
+#include <vector>
+#include <pdcpp/core/GlobalPlaydateAPI.h>
+#include <pdcpp/core/Profiler.h>
+
+namespace
+{
+    // Never destroyed, so timers which are themselves globals can still
+    // cancel with it on their way out, whatever order statics die in.
+    pdcpp::TimerService* g_DefaultService = nullptr;
+
+    // Each level of the wheel has 64 slots, each slot of a level spanning the
+    // whole of the level below it. Four levels cover 2^24 ticks, a little
+    // over four and a half hours in milliseconds. Anything further out waits
+    // in an overflow list, which is looked at each time the top level comes
+    // back round.
+    constexpr unsigned int k_SlotBits = 6;
+    constexpr unsigned int k_NSlots = 1u << k_SlotBits;
+    constexpr unsigned int k_SlotMask = k_NSlots - 1;
+    constexpr unsigned int k_NLevels = 4;
+    constexpr unsigned int k_Overflow = k_NLevels;
+    constexpr uint64_t k_WheelSpan = uint64_t(1) << (k_SlotBits * k_NLevels);
+
+    constexpr uint32_t k_None = UINT32_MAX;
+    constexpr uint64_t k_FrameWheelBit = uint64_t(1) << 32;
+
+    uint32_t indexOf(uint64_t id) { return static_cast<uint32_t>(id); }
+    constexpr uint32_t k_GenerationMask = 0x7fffffff;
+
+    uint32_t generationOf(uint64_t id) { return static_cast<uint32_t>(id >> 33); }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+class pdcpp::TimerService::Wheel
+{
+public:
+    explicit Wheel(bool isFrameWheel) : m_WheelBit(isFrameWheel ? k_FrameWheelBit : 0)
+    {
+        for (auto& level : m_Heads)
+            { level.fill(k_None); }
+    }
+
+    uint64_t add(uint32_t delay, uint32_t interval, Callback callback)
+    {
+        uint32_t index;
+        if (!m_FreeNodes.empty())
+        {
+            index = m_FreeNodes.back();
+            m_FreeNodes.pop_back();
+        }
+        else
+        {
+            index = static_cast<uint32_t>(m_Nodes.size());
+            m_Nodes.emplace_back();
+        }
+
+        auto& node = m_Nodes[index];
+        node.expiry = m_Now + std::max<uint32_t>(delay, 1);
+        node.interval = interval;
+        node.callback = std::move(callback);
+        node.state = State::Scheduled;
+        link(index);
+        ++m_NPending;
+        return idOf(index);
+    }
+
+    void cancel(uint64_t id)
+    {
+        auto index = indexOf(id);
+        if (!isLive(id))
+            { return; }
+
+        auto& node = m_Nodes[index];
+        if (node.state == State::Firing)
+        {
+            // It's already off the wheel, `fire` will free it when the
+            // callback returns.
+            node.state = State::Cancelled;
+            return;
+        }
+
+        unlink(index);
+        release(index);
+    }
+
+    void cancelAll()
+    {
+        for (uint32_t index = 0; index < m_Nodes.size(); ++index)
+        {
+            if (m_Nodes[index].state == State::Scheduled)
+                { cancel(idOf(index)); }
+            else if (m_Nodes[index].state == State::Firing)
+                { m_Nodes[index].state = State::Cancelled; }
+        }
+    }
+
+    [[ nodiscard ]] bool isPending(uint64_t id) const
+        { return isLive(id) && m_Nodes[indexOf(id)].state != State::Cancelled; }
+
+    [[ nodiscard ]] size_t getNumPending() const { return m_NPending; }
+
+    void advanceTo(uint64_t target)
+    {
+        m_Target = target;
+        while (m_Now < target)
+        {
+            if (m_NPending == 0)
+            {
+                m_Now = target;
+                break;
+            }
+
+            // Jump to just before the next occupied slot in this turn of the
+            // bottom level, or the end of the turn, whichever's first.
+            auto slot = static_cast<unsigned int>(m_Now & k_SlotMask);
+            auto ahead = slot == k_SlotMask ? 0 : m_Occupied >> (slot + 1) << (slot + 1);
+            auto next = ahead != 0 ? (m_Now & ~uint64_t(k_SlotMask)) + lowestBit(ahead) : (m_Now | k_SlotMask) + 1;
+            m_Now = std::min(next, target) - 1;
+
+            step();
+        }
+    }
+
+    [[ nodiscard ]] uint64_t getNow() const { return m_Now; }
+
+private:
+    enum class State : uint8_t
+    {
+        Free,
+        Scheduled,
+        Firing,
+        Cancelled
+    };
+
+    struct Node
+    {
+        uint64_t expiry = 0;
+        uint32_t interval = 0;
+        uint32_t generation = 1;
+        uint32_t prev = k_None;
+        uint32_t next = k_None;
+        Callback callback;
+        State state = State::Free;
+        uint8_t level = 0;
+        uint8_t slot = 0;
+    };
+
+    static unsigned int lowestBit(uint64_t bits)
+    {
+        unsigned int n = 0;
+        while ((bits & 1) == 0)
+        {
+            bits >>= 1;
+            ++n;
+        }
+        return n;
+    }
+
+    [[ nodiscard ]] uint64_t idOf(uint32_t index) const
+        { return (uint64_t(m_Nodes[index].generation & k_GenerationMask) << 33) | m_WheelBit | index; }
+
+    [[ nodiscard ]] bool isLive(uint64_t id) const
+    {
+        auto index = indexOf(id);
+        return index < m_Nodes.size()
+            && (m_Nodes[index].generation & k_GenerationMask) == generationOf(id)
+            && m_Nodes[index].state != State::Free;
+    }
+
+    uint32_t& headOf(uint8_t level, uint8_t slot) { return level == k_Overflow ? m_OverflowHead : m_Heads[level][slot]; }
+
+    // Puts the node in the slot of the lowest level whose span still reaches
+    // its expiry.
+    void link(uint32_t index)
+    {
+        auto& node = m_Nodes[index];
+        node.level = k_Overflow;
+        node.slot = 0;
+        for (unsigned int level = 0; level < k_NLevels; ++level)
+        {
+            auto above = k_SlotBits * (level + 1);
+            if ((node.expiry >> above) == (m_Now >> above))
+            {
+                node.level = static_cast<uint8_t>(level);
+                node.slot = static_cast<uint8_t>((node.expiry >> (k_SlotBits * level)) & k_SlotMask);
+                break;
+            }
+        }
+
+        auto& head = headOf(node.level, node.slot);
+        node.prev = k_None;
+        node.next = head;
+        if (head != k_None)
+            { m_Nodes[head].prev = index; }
+        head = index;
+
+        if (node.level == 0)
+            { m_Occupied |= uint64_t(1) << node.slot; }
+    }
+
+    void unlink(uint32_t index)
+    {
+        auto& node = m_Nodes[index];
+        auto& head = headOf(node.level, node.slot);
+        if (node.prev != k_None)
+            { m_Nodes[node.prev].next = node.next; }
+        else
+            { head = node.next; }
+        if (node.next != k_None)
+            { m_Nodes[node.next].prev = node.prev; }
+
+        if (node.level == 0 && head == k_None)
+            { m_Occupied &= ~(uint64_t(1) << node.slot); }
+
+        node.prev = k_None;
+        node.next = k_None;
+    }
+
+    void release(uint32_t index)
+    {
+        auto& node = m_Nodes[index];
+        node.callback = nullptr;
+        node.state = State::Free;
+        ++node.generation;
+        m_FreeNodes.push_back(index);
+        --m_NPending;
+    }
+
+    // Moves everything in a slot down to wherever it belongs now.
+    void cascade(uint8_t level, uint8_t slot)
+    {
+        auto index = std::exchange(headOf(level, slot), k_None);
+        while (index != k_None)
+        {
+            auto next = m_Nodes[index].next;
+            link(index);
+            index = next;
+        }
+    }
+
+    void step()
+    {
+        ++m_Now;
+
+        if ((m_Now & (k_WheelSpan - 1)) == 0)
+            { cascade(k_Overflow, 0); }
+
+        for (auto level = k_NLevels - 1; level > 0; --level)
+        {
+            auto below = k_SlotBits * level;
+            if ((m_Now & ((uint64_t(1) << below) - 1)) == 0)
+                { cascade(static_cast<uint8_t>(level), static_cast<uint8_t>((m_Now >> below) & k_SlotMask)); }
+        }
+
+        auto slot = static_cast<uint8_t>(m_Now & k_SlotMask);
+        while (m_Heads[0][slot] != k_None)
+            { fire(m_Heads[0][slot]); }
+    }
+
+    void fire(uint32_t index)
+    {
+        unlink(index);
+        m_Nodes[index].state = State::Firing;
+
+        // The callback may schedule more timers, which can move the nodes, so
+        // it's called from here rather than in place.
+        auto callback = std::move(m_Nodes[index].callback);
+        callback();
+
+        auto& node = m_Nodes[index];
+        if (node.state == State::Cancelled || node.interval == 0)
+        {
+            release(index);
+            return;
+        }
+
+        // Skip any whole periods already missed, so a late repeating timer
+        // fires once and keeps its phase.
+        auto expiry = node.expiry + node.interval;
+        if (expiry <= m_Target)
+            { expiry += ((m_Target - expiry) / node.interval + 1) * node.interval; }
+
+        node.expiry = expiry;
+        node.callback = std::move(callback);
+        node.state = State::Scheduled;
+        link(index);
+    }
+
+    std::vector<Node> m_Nodes;
+    std::vector<uint32_t> m_FreeNodes;
+    std::array<std::array<uint32_t, k_NSlots>, k_NLevels> m_Heads;
+    uint32_t m_OverflowHead = k_None;
+    uint64_t m_Occupied = 0;
+    uint64_t m_Now = 0;
+    uint64_t m_Target = 0;
+    size_t m_NPending = 0;
+    const uint64_t m_WheelBit;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+void pdcpp::TimerHandle::cancel()
+{
+    if (p_Service != nullptr)
+        { p_Service->cancel(*this); }
+}
+
+bool pdcpp::TimerHandle::isPending() const { return p_Service != nullptr && p_Service->isPending(*this); }
+
+////////////////////////////////////////////////////////////////////////////////
+
+pdcpp::TimerService::TimerService()
+    : p_Clock(std::make_unique<Wheel>(false))
+    , p_Frames(std::make_unique<Wheel>(true))
+    , m_LastMs(pdcpp::GlobalPlaydateAPI::get()->system->getCurrentTimeMilliseconds())
+{}
+
+pdcpp::TimerService::~TimerService() = default;
+
+pdcpp::TimerHandle pdcpp::TimerService::after(uint32_t delayMs, Callback callback)
+    { return schedule(*p_Clock, delayMs + getTimeSinceUpdate(), 0, std::move(callback)); }
+
+pdcpp::TimerHandle pdcpp::TimerService::every(uint32_t intervalMs, Callback callback)
+{
+    auto interval = std::max<uint32_t>(intervalMs, 1);
+    return schedule(*p_Clock, interval + getTimeSinceUpdate(), interval, std::move(callback));
+}
+
+pdcpp::TimerHandle pdcpp::TimerService::afterFrames(uint32_t nFrames, Callback callback)
+    { return schedule(*p_Frames, nFrames, 0, std::move(callback)); }
+
+pdcpp::TimerHandle pdcpp::TimerService::everyFrames(uint32_t nFrames, Callback callback)
+    { return schedule(*p_Frames, nFrames, std::max<uint32_t>(nFrames, 1), std::move(callback)); }
+
+pdcpp::TimerHandle pdcpp::TimerService::schedule(Wheel& wheel, uint32_t delay, uint32_t interval, Callback callback)
+    { return {this, wheel.add(delay, interval, std::move(callback))}; }
+
+void pdcpp::TimerService::cancel(const TimerHandle& handle)
+{
+    if (handle.p_Service == this)
+        { wheelFor(handle.m_Id)->cancel(handle.m_Id); }
+}
+
+bool pdcpp::TimerService::isPending(const TimerHandle& handle) const
+    { return handle.p_Service == this && wheelFor(handle.m_Id)->isPending(handle.m_Id); }
+
+void pdcpp::TimerService::cancelAll()
+{
+    p_Clock->cancelAll();
+    p_Frames->cancelAll();
+}
+
+void pdcpp::TimerService::update()
+{
+    m_OnSystemClock = true;
+    advance(pdcpp::GlobalPlaydateAPI::get()->system->getCurrentTimeMilliseconds());
+}
+
+void pdcpp::TimerService::update(uint32_t nowMs)
+{
+    m_OnSystemClock = false;
+    advance(nowMs);
+}
+
+void pdcpp::TimerService::advance(uint32_t nowMs)
+{
+    PDCPP_PROFILE_SCOPE("TimerService::update");
+
+    // Unsigned subtraction keeps this right across the clock wrapping.
+    auto elapsed = nowMs - m_LastMs;
+    m_LastMs = nowMs;
+
+    p_Clock->advanceTo(p_Clock->getNow() + elapsed);
+    p_Frames->advanceTo(p_Frames->getNow() + 1);
+}
+
+size_t pdcpp::TimerService::getNumPending() const { return p_Clock->getNumPending() + p_Frames->getNumPending(); }
+
+pdcpp::TimerService& pdcpp::TimerService::getDefault()
+{
+    if (g_DefaultService == nullptr)
+        { g_DefaultService = new TimerService(); }
+    return *g_DefaultService;
+}
+
+uint32_t pdcpp::TimerService::getTimeSinceUpdate() const
+{
+    if (!m_OnSystemClock)
+        { return 0; }
+    return pdcpp::GlobalPlaydateAPI::get()->system->getCurrentTimeMilliseconds() - m_LastMs;
+}
+
+pdcpp::TimerService::Wheel* pdcpp::TimerService::wheelFor(uint64_t id) const
+    { return (id & k_FrameWheelBit) != 0 ? p_Frames.get() : p_Clock.get(); }
@@ -8,9 +8,13 @@
  *  Original author: MrBZapp
  */
 
+#include <algorithm>
+#include <string_view>
 #include <vector>
 #include <pdcpp/graphics/Font.h>
+#include <pdcpp/core/FrameArena.h>
 #include <pdcpp/core/GlobalPlaydateAPI.h>
+#include <pdcpp/core/Log.h>
 #include "pdcpp/graphics/Image.h"
 
 pdcpp::Font::Font(const std::string& fontPath, int tracking, int leading)
@@ -22,7 +26,7 @@ pdcpp::Font::Font(const std::string& fontPath, int tracking, int leading)
     m_Font = pd->graphics->loadFont(fontPath.c_str(), &err);
 
     if (m_Font == nullptr)
-        { pd->system->error("Couldn't load font %s: %s", fontPath.c_str(), err); }
+        { PDCPP_LOG_ERROR("Couldn't load font %s: %s", fontPath, err); }
 }
 
 void pdcpp::Font::drawText(const std::string& text, int x, int y, PDStringEncoding encoding) const
@@ -46,74 +50,84 @@ int pdcpp::Font::getTextWidth(const std::string& toMeasure,  PDStringEncoding en
     return pd->graphics->getTextWidth(m_Font, toMeasure.data(), toMeasure.size(), encoding, m_Tracking);
 }
 
-std::vector<std::string> pdcpp::Font::wrapText(const std::string& text, int maxWidth) const
+template <typename Fn>
+void pdcpp::Font::forEachWrappedLine(std::string_view text, int maxWidth, Fn&& fn) const
 {
-    // Tokenize the string
-    std::vector<std::string> words;
-
-    size_t startPos = 0;
-    size_t pos = 0;
-    while ((pos = text.substr(startPos, std::string::npos).find(' ')) != std::string::npos)
+    // Lines are runs of the text, so they're found without building any
+    // strings: each word is measured along with the space after it, if one
+    // follows, and a line ends before the word that doesn't fit, or at a
+    // newline.
+    auto graphics = pdcpp::GlobalPlaydateAPI::get()->graphics;
+    size_t lineStart = 0;
+    size_t lineEnd = 0;
+    int lineWidth = 0;
+
+    size_t wordStart = 0;
+    while (true)
     {
-        std::string substr = text.substr(startPos, std::string::npos);
-        words.emplace_back(text.substr(startPos, pos));
-        startPos += pos + 1;
-    }
-
-    if (startPos < text.size()) { words.emplace_back(text.substr(startPos, std::string::npos)); }
-
-    // Make the lines
-    std::vector<std::string> rv;
-
-    int currentLineWidth = 0;
-    std::string recomposed = "";
-
-    auto make_new_line = [&]()
-    {
-        recomposed += "\n";
-        rv.emplace_back(recomposed);
-        recomposed = "";
-        currentLineWidth = 0;
-    };
-
-    auto process_word = [&](const std::string& word, bool includeSpace)
-    {
-        auto wordWidth = getTextWidth(word + (includeSpace ? " " : ""));
-
-        if (currentLineWidth + wordWidth > maxWidth)
+        auto pos = text.find_first_of(" \n", wordStart);
+        if (pos == std::string_view::npos && wordStart == text.size())
+            { break; }
+        auto wordEnd = pos != std::string_view::npos ? pos : text.size();
+
+        // A space at the very end of the text isn't kept.
+        auto includeSpace = pos != std::string_view::npos && text[pos] == ' ' && pos + 1 < text.size();
+        auto length = wordEnd - wordStart + (includeSpace ? 1 : 0);
+        auto wordWidth = graphics->getTextWidth(m_Font, text.data() + wordStart, length, kASCIIEncoding, m_Tracking);
+
+        // Avoid whitespace-only lines where sensible.
+        // TODO: Split words that are themselves too long.
+        if (lineWidth + wordWidth > maxWidth && lineWidth > 0)
         {
-            // Avoid whitespace-only lines where sensible
-            if (currentLineWidth > 0) { make_new_line(); }
-
-            // TODO: Split words that are themselves too long.
+            fn(text.substr(lineStart, lineEnd - lineStart), true);
+            lineStart = wordStart;
+            lineEnd = wordStart;
+            lineWidth = 0;
         }
-        recomposed += word + (includeSpace ? " " : "");
-        currentLineWidth += wordWidth;
-    };
+        if (length > 0)
+            { lineEnd = wordStart + length; }
+        lineWidth += wordWidth;
 
-    for (auto& word : words)
-    {
-        startPos = 0;
-        while ((pos = word.substr(startPos, std::string::npos).find('\n')) != std::string::npos)
+        if (pos == std::string_view::npos)
+            { break; }
+
+        if (text[pos] == '\n')
         {
-            auto sub_word = word.substr(startPos, pos);
-            process_word(sub_word, false);
-            make_new_line();
-            startPos += pos + 1;
+            fn(text.substr(lineStart, lineEnd - lineStart), true);
+            lineStart = pos + 1;
+            lineEnd = pos + 1;
+            lineWidth = 0;
         }
-
-        process_word(word.substr(startPos, std::string::npos), word != words.back());
+        wordStart = pos + 1;
     }
-    if (!recomposed.empty()) { rv.emplace_back(recomposed);}
+
+    if (lineEnd > lineStart)
+        { fn(text.substr(lineStart, lineEnd - lineStart), false); }
+}
+
+std::vector<std::string> pdcpp::Font::wrapText(const std::string& text, int maxWidth) const
+{
+    std::vector<std::string> rv;
+    forEachWrappedLine(text, maxWidth, [&](std::string_view line, bool broken)
+    {
+        auto& added = rv.emplace_back(line);
+        if (broken) { added += "\n"; }
+    });
     return rv;
 }
 
 int pdcpp::Font::drawWrappedText(const std::string& text, const pdcpp::Rectangle<float>& bounds, PDStringEncoding encoding) const
 {
+    auto graphics = pdcpp::GlobalPlaydateAPI::get()->graphics;
+    graphics->setFont(m_Font);
+    graphics->setTextLeading(m_Leading);
+    graphics->setTextTracking(m_Tracking);
+
+    const auto lineHeight = getFontHeight() + getTextLeading();
     int lineNum = 0;
-    for (auto& line : wrapText(text, bounds.width))
-        { drawText(line, bounds.x, bounds.y + (lineNum++ * (getFontHeight() + getTextLeading())), encoding); }
-    return lineNum * (getFontHeight() + getTextLeading());
+    forEachWrappedLine(text, int(bounds.width), [&](std::string_view line, bool)
+        { graphics->drawText(line.data(), line.size(), encoding, int(bounds.x), int(bounds.y) + lineNum++ * lineHeight); });
+    return lineNum * lineHeight;
 }
 
 pdcpp::Rectangle<float> pdcpp::Font::drawWrappedText(
@@ -122,22 +136,34 @@ pdcpp::Rectangle<float> pdcpp::Font::drawWrappedText(
     pdcpp::Font::VerticalJustification verticalJustification,
     PDStringEncoding encoding) const
 {
+    // Every line ends at a space, a newline, or the end of the text, so this
+    // is as many as there can be, and the vector is only allocated once.
+    pdcpp::ArenaVector<std::string_view> wrappedLines;
+    wrappedLines.reserve(1 + std::count_if(text.begin(), text.end(), [](char c) { return c == ' ' || c == '\n'; }));
+    forEachWrappedLine(text, bounds.toInt().width, [&](std::string_view line, bool)
+        { wrappedLines.push_back(line); });
+
     int lineNum = 0;
     int minX = bounds.getRight();
     int maxWidth = 0;
-    auto wrappedLines = wrapText(text, bounds.toInt().width);
+    const auto lineHeight = getFontHeight() + getTextLeading();
 
     auto vertOffset = 0;
-    const auto textBlockHeight = (getFontHeight() + getTextLeading()) * wrappedLines.size();
+    const auto textBlockHeight = lineHeight * wrappedLines.size();
 
     if (verticalJustification == Middle)
         { vertOffset = (bounds.height - textBlockHeight) / 2; }
     else if (verticalJustification == Bottom)
         { vertOffset = bounds.height - textBlockHeight; }
 
-    for (auto& line : wrappedLines)
+    auto graphics = pdcpp::GlobalPlaydateAPI::get()->graphics;
+    graphics->setFont(m_Font);
+    graphics->setTextLeading(m_Leading);
+    graphics->setTextTracking(m_Tracking);
+
+    for (auto line : wrappedLines)
     {
-        const auto lineBounds = getTextArea(line, encoding);
+        const auto lineWidth = graphics->getTextWidth(m_Font, line.data(), line.size(), encoding, m_Tracking);
         pdcpp::Point<float> point{0, 0};
 
         switch (justification)
@@ -146,16 +172,16 @@ pdcpp::Rectangle<float> pdcpp::Font::drawWrappedText(
                 point = bounds.getTopLeft();
                 break;
             case Center:
-                point = bounds.getTopLeft() + pdcpp::Point<float>((bounds.width - lineBounds.width) / 2.0f, 0);
+                point = bounds.getTopLeft() + pdcpp::Point<float>((bounds.width - lineWidth) / 2.0f, 0);
                 break;
             case Right:
-                point = bounds.getTopLeft() + pdcpp::Point<float>(bounds.width - lineBounds.width, 0);
+                point = bounds.getTopLeft() + pdcpp::Point<float>(bounds.width - lineWidth, 0);
                 break;
         }
 
-        maxWidth = std::max<float>(lineBounds.width, maxWidth);
+        maxWidth = std::max<float>(lineWidth, maxWidth);
         minX = std::min<float>(point.x, minX);
-        drawText(line, point.x, point.y + (lineNum++ * (getFontHeight() + getTextLeading())) + vertOffset, encoding);
+        graphics->drawText(line.data(), line.size(), encoding, int(point.x), int(point.y) + (lineNum++ * lineHeight) + vertOffset);
     }
 
     return {float(minX), vertOffset + bounds.y, float(maxWidth), float(textBlockHeight)};
@@ -9,6 +9,7 @@
  */
 
 #include <pdcpp/graphics/Graphics.h>
+#include <pdcpp/core/FrameArena.h>
 #include <pdcpp/core/GlobalPlaydateAPI.h>
 
 void pdcpp::Graphics::drawRoundedRectangle(const pdcpp::Rectangle<int>& bounds, int radius, int linePx, LCDColor color)
@@ -94,7 +95,8 @@ pdcpp::Rectangle<int> pdcpp::Graphics::getScreenBounds()
 
 void pdcpp::Graphics::fillPolygon(const std::vector<pdcpp::Point<float>>& points,  LCDColor color, LCDPolygonFillRule fillRule)
 {
-    std::vector<int> intPoints;
+    pdcpp::ArenaVector<int> intPoints;
+    intPoints.reserve(points.size() * 2);
     for (auto& point : points)
     {
         intPoints.push_back(point.x);
@@ -12,6 +12,8 @@
 
 #include <pdcpp/graphics/Image.h>
 #include <pdcpp/core/GlobalPlaydateAPI.h>
+#include <pdcpp/core/Log.h>
+#include <pdcpp/core/MemoryTracker.h>
 #include "pdcpp/graphics/ScopedGraphicsContext.h"
 
 
@@ -26,7 +28,7 @@ pdcpp::Image::Image(const std::string& imgPath)
     p_Data = pd->graphics->loadBitmap(imgPath.c_str(), &outErr);
 
     if (outErr != nullptr)
-        { pd->system->error("Error loading image: %s", std::string(outErr).c_str()); }
+        { PDCPP_LOG_ERROR("Error loading image: %s", outErr); }
 }
 
 pdcpp::Image::Image(LCDBitmap* data)
@@ -125,7 +127,7 @@ void pdcpp::Image::fill(LCDColor color)
     pdcpp::GlobalPlaydateAPI::get()->graphics->clearBitmap(p_Data, color);
 }
 
-pdcpp::Image pdcpp::Image::drawAsImage(const PDRect& bounds, const std::function<void()>& drawFunc, LCDSolidColor fillColor)
+pdcpp::Image pdcpp::Image::drawAsImage(const PDRect& bounds, const DrawFunction& drawFunc, LCDSolidColor fillColor)
 {
     // Using a raw graphics context here to avoid having to call for a copy
     auto pd = pdcpp::GlobalPlaydateAPI::get();
@@ -146,6 +148,7 @@ pdcpp::Rectangle<int> pdcpp::Image::getBounds() const
 
 pdcpp::Image::RawBitmapData pdcpp::Image::getBitmapData() const
 {
+    pdcpp::ScopedMemoryTag tag(pdcpp::MemoryTag::Graphics);
     RawBitmapData rv;
 
     int rb;
@@ -159,6 +162,13 @@ pdcpp::Image::RawBitmapData pdcpp::Image::getBitmapData() const
     return rv;
 }
 
+pdcpp::Image::BitmapDataView pdcpp::Image::getBitmapDataView() const
+{
+    BitmapDataView rv {{0, 0, 0, 0}, 0, nullptr, nullptr};
+    pdcpp::GlobalPlaydateAPI::get()->graphics->getBitmapData(p_Data, &rv.bounds.width, &rv.bounds.height, &rv.rowBytes, &rv.mask, &rv.data);
+    return rv;
+}
+
 pdcpp::Image::Image(const pdcpp::Rectangle<int>& bounds, uint8_t* data, uint8_t* mask, int rowStride)
     : p_Data(pdcpp::GlobalPlaydateAPI::get()->graphics->newBitmap(bounds.width, bounds.height, kColorClear))
 {
@@ -9,6 +9,7 @@
  */
 
 #include <pdcpp/core/GlobalPlaydateAPI.h>
+#include <pdcpp/core/Log.h>
 #include <pdcpp/graphics/ImageTable.h>
 
 
@@ -24,7 +25,7 @@ pdcpp::ImageTable::ImageTable(const std::string& imgPath)
     p_Table = pd->graphics->loadBitmapTable(truePath.c_str(), &outErr);
 
     if (outErr != nullptr)
-    { pd->system->error("Error loading image table: %s", std::string(outErr).c_str()); }
+        { PDCPP_LOG_ERROR("Error loading image table: %s", outErr); }
 }
 
 pdcpp::ImageTable::ImageTable(pdcpp::ImageTable&& other) noexcept
@@ -15,7 +15,10 @@
 #include "pdcpp/components/Slider.h"
 
 pdcpp::LookAndFeel* pdcpp::LookAndFeel::defaultLookAndFeel = nullptr;
-std::map<std::string, pdcpp::Font> pdcpp::LookAndFeel::g_Fonts = {};
+// Fonts are never evicted, and are kept even if they fail to load, so the
+// pointers handed out by `getFont` stay valid.
+pdcpp::ResourceCache<pdcpp::Font> pdcpp::LookAndFeel::g_Fonts(
+    0, [](const std::string& path) { return std::make_unique<pdcpp::Font>(path); });
 
 pdcpp::LookAndFeel::LookAndFeel()
     : m_DefaultFont("/System/Fonts/Asheville-Sans-14-Bold.pft")
@@ -109,18 +112,13 @@ void pdcpp::LookAndFeel::drawRotarySlider(const playdate_graphics* g, const pdcp
     auto pipBounds = pdcpp::Rectangle<int>(0,0, bounds.width * 0.2f, bounds.width * 0.2f);
     const auto center = bounds.getCenter();
     const auto pipPointAtHalf = pdcpp::Point<float>(center.x, center.y - bounds.reduced(4).height / 2.0f);
-    pipBounds = pipBounds.withCenter(pipPointAtHalf.rotated(center, pdcpp::degToRad(288 * ratio - 143)).toInt());
+    const auto pipCenter = pipPointAtHalf.rotated(center, pdcpp::degToRad(288 * ratio - 143), pdcpp::FastMath::useTables);
+    pipBounds = pipBounds.withCenter(pipCenter.toInt());
     pdcpp::Graphics::fillEllipse(pipBounds, 0, 0, pdcpp::Colors::white);
 }
 
 pdcpp::Font* pdcpp::LookAndFeel::getFont(const std::string& fontName)
-{
-    if (!g_Fonts.contains(fontName))
-    {
-        g_Fonts.emplace(std::piecewise_construct, std::forward_as_tuple(fontName), std::forward_as_tuple(fontName));
-    }
-    return &g_Fonts.at(fontName);
-}
+    { return g_Fonts.get(fontName).get(); }
 
 void pdcpp::LookAndFeel::drawNumericSlider(const playdate_graphics* g, const pdcpp::Slider* slider) const
 {
@@ -9,6 +9,7 @@
  */
 
 #include <pdcpp/core/GlobalPlaydateAPI.h>
+#include <pdcpp/core/Profiler.h>
 #include <pdcpp/graphics/Sprite.h>
 
 
@@ -228,6 +229,7 @@ pdcpp::Sprite* pdcpp::Sprite::castSprite(LCDSprite* toCast)
 
 void pdcpp::Sprite::updateAndRedrawAllSprites()
 {
+    PDCPP_PROFILE_SCOPE("Sprite::updateAndRedrawAllSprites");
     pdcpp::GlobalPlaydateAPI::get()->sprite->updateAndDrawSprites();
 }
 
@@ -0,0 +1,74 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#include <cmath>
+#include <utility>
+#include <pdcpp/core/GlobalPlaydateAPI.h>
+#include <pdcpp/core/Profiler.h>
+#include <pdcpp/graphics/SpriteSystem.h>
+
+pdcpp::SpriteComponent::SpriteComponent(LCDBitmap* image, int16_t zIndex, LCDBitmapFlip flip)
+    // NaN never compares equal, so the first sync always moves the sprite.
+    : m_SyncedX(NAN)
+    , m_SyncedY(NAN)
+{
+    auto pd = pdcpp::GlobalPlaydateAPI::get();
+    p_Sprite = pd->sprite->newSprite();
+    pd->sprite->setImage(p_Sprite, image, flip);
+    pd->sprite->setZIndex(p_Sprite, zIndex);
+    pd->sprite->addSprite(p_Sprite);
+}
+
+pdcpp::SpriteComponent::~SpriteComponent()
+{
+    if (p_Sprite != nullptr)
+    {
+        auto pd = pdcpp::GlobalPlaydateAPI::get();
+        pd->sprite->removeSprite(p_Sprite);
+        pd->sprite->freeSprite(p_Sprite);
+    }
+}
+
+pdcpp::SpriteComponent::SpriteComponent(SpriteComponent&& other) noexcept
+    : p_Sprite(std::exchange(other.p_Sprite, nullptr))
+    , m_SyncedX(other.m_SyncedX)
+    , m_SyncedY(other.m_SyncedY)
+{
+}
+
+pdcpp::SpriteComponent& pdcpp::SpriteComponent::operator=(SpriteComponent&& other) noexcept
+{
+    if (this != &other)
+    {
+        std::swap(p_Sprite, other.p_Sprite);
+        m_SyncedX = other.m_SyncedX;
+        m_SyncedY = other.m_SyncedY;
+    }
+    return *this;
+}
+
+size_t pdcpp::SpriteSystem::sync()
+{
+    PDCPP_PROFILE_SCOPE("SpriteSystem::sync");
+
+    auto moveTo = pdcpp::GlobalPlaydateAPI::get()->sprite->moveTo;
+    size_t nMoved = 0;
+    r_Registry.view<Transform, SpriteComponent>().each([&](Entity, const Transform& t, SpriteComponent& s)
+    {
+        if (t.x == s.m_SyncedX && t.y == s.m_SyncedY)
+            { return; }
+
+        moveTo(s.p_Sprite, t.x, t.y);
+        s.m_SyncedX = t.x;
+        s.m_SyncedY = t.y;
+        ++nMoved;
+    });
+    return nMoved;
+}
@@ -0,0 +1,134 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#include <string>
+#include <vector>
+#include <pdcpp/core/AssetLoader.h>
+#include "HostTest.h"
+
+namespace
+{
+    struct Asset
+    {
+        std::string path;
+    };
+
+    // Loads a stand-in asset, taking some of the host's manual clock, and
+    // remembers the order the loads happened in. Paths starting with "bad"
+    // fail.
+    class AssetLoaderTest
+        : public pdcpp::test::HostTest
+    {
+    protected:
+        pdcpp::AssetLoader::LoadFunction<Asset> loadTaking(uint32_t ms)
+        {
+            return [this, ms](const std::string& path) -> std::unique_ptr<Asset>
+            {
+                m_Host.advanceTime(ms);
+                m_Loaded.push_back(path);
+                if (path.starts_with("bad"))
+                    { return nullptr; }
+                return std::make_unique<Asset>(Asset{path});
+            };
+        }
+
+        std::vector<std::string> m_Loaded;
+    };
+}
+
+TEST_F(AssetLoaderTest, LoadsByPriorityThenOrder)
+{
+    pdcpp::AssetLoader loader(1000.0f);
+    auto a = loader.load<Asset>("a", loadTaking(0));
+    auto b = loader.load<Asset>("b", loadTaking(0), 5);
+    auto c = loader.load<Asset>("c", loadTaking(0));
+    EXPECT_TRUE(a.isQueued());
+    EXPECT_EQ(a.get(), nullptr);
+
+    loader.update();
+    EXPECT_EQ(m_Loaded, (std::vector<std::string>{"b", "a", "c"}));
+    ASSERT_TRUE(c.isReady());
+    EXPECT_EQ(c.get()->path, "c");
+    EXPECT_TRUE(loader.isIdle());
+}
+
+TEST_F(AssetLoaderTest, SharesLoadsOfTheSamePath)
+{
+    pdcpp::AssetLoader loader(1000.0f);
+    auto first = loader.load<Asset>("a", loadTaking(0));
+    auto other = loader.load<Asset>("b", loadTaking(0));
+
+    // Asking again with a higher priority moves the shared load up.
+    auto second = loader.load<Asset>("a", loadTaking(0), 5);
+    EXPECT_EQ(loader.getProgress().total, 2u);
+
+    loader.update();
+    EXPECT_EQ(m_Loaded, (std::vector<std::string>{"a", "b"}));
+    EXPECT_EQ(first.get(), second.get());
+
+    // Still held, so still shared.
+    auto third = loader.load<Asset>("a", loadTaking(0));
+    EXPECT_TRUE(third.isReady());
+    EXPECT_EQ(third.get(), first.get());
+}
+
+TEST_F(AssetLoaderTest, SkipsDroppedRequests)
+{
+    pdcpp::AssetLoader loader(1000.0f);
+    auto kept = loader.load<Asset>("kept", loadTaking(0));
+    {
+        auto dropped = loader.load<Asset>("dropped", loadTaking(0), 5);
+    }
+
+    loader.update();
+    EXPECT_EQ(m_Loaded, std::vector<std::string>{"kept"});
+    EXPECT_EQ(loader.getProgress().total, 1u);
+    EXPECT_EQ(loader.getProgress().getFraction(), 1.0f);
+}
+
+TEST_F(AssetLoaderTest, CountsFailures)
+{
+    pdcpp::AssetLoader loader(1000.0f);
+    auto good = loader.load<Asset>("good", loadTaking(0));
+    auto bad = loader.load<Asset>("bad", loadTaking(0));
+
+    loader.update();
+    EXPECT_TRUE(good.isReady());
+    EXPECT_TRUE(bad.isFailed());
+    EXPECT_EQ(bad.get(), nullptr);
+    EXPECT_EQ(loader.getProgress().completed, 2u);
+    EXPECT_EQ(loader.getProgress().failed, 1u);
+
+    // A default handle never loads.
+    EXPECT_TRUE(pdcpp::AssetLoader::Handle<Asset>().isFailed());
+}
+
+TEST_F(AssetLoaderTest, StopsAtTheBudget)
+{
+    pdcpp::AssetLoader loader(8.0f);
+    std::vector<pdcpp::AssetLoader::Handle<Asset>> handles;
+    for (auto path : {"a", "b", "c", "d", "e"})
+        { handles.push_back(loader.load<Asset>(path, loadTaking(5))); }
+
+    // Two 5ms loads spend an 8ms budget.
+    loader.update();
+    EXPECT_EQ(m_Loaded.size(), 2u);
+    EXPECT_FLOAT_EQ(loader.getProgress().getFraction(), 0.4f);
+
+    // With no budget at all, one load still happens each update.
+    loader.setFrameBudget(0.0f);
+    loader.update();
+    EXPECT_EQ(m_Loaded.size(), 3u);
+
+    loader.update();
+    loader.update();
+    EXPECT_TRUE(loader.isIdle());
+    EXPECT_EQ(loader.getProgress().completed, 5u);
+}
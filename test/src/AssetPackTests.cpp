@@ -0,0 +1,136 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#include <fstream>
+#include <numeric>
+#include <vector>
+#include <pdcpp/core/AssetPack.h>
+#include <pdcpp/host/AssetPacker.h>
+#include "HostTest.h"
+
+namespace
+{
+    // Packs are written into the host's data folder, where the game's file
+    // API finds them.
+    class AssetPackTest
+        : public pdcpp::test::HostTest
+    {
+    protected:
+        void SetUp() override
+        {
+            HostTest::SetUp();
+
+            m_Level.resize(1000);
+            std::iota(m_Level.begin(), m_Level.end(), uint8_t(0));
+
+            pdcpp::host::AssetPacker packer;
+            packer.addData({'h', 'i'}, "hello.txt");
+            packer.addData(m_Level, "levels/1.bin");
+            packer.addData({}, "empty");
+            ASSERT_TRUE(packer.write(m_Host.getDataDirectory() / "test.pdap")) << packer.getLastError();
+        }
+
+        // Overwrites a number in the pack, for corrupting it.
+        void poke(uint32_t offset, uint32_t value)
+        {
+            std::fstream file(m_Host.getDataDirectory() / "test.pdap", std::ios::in | std::ios::out | std::ios::binary);
+            file.seekp(offset);
+            for (int i = 0; i < 4; ++i)
+                { file.put(char((value >> (8 * i)) & 0xff)); }
+        }
+
+        std::vector<uint8_t> m_Level;
+    };
+}
+
+TEST_F(AssetPackTest, FindsAndReadsEntries)
+{
+    pdcpp::AssetPack pack("test.pdap");
+    ASSERT_TRUE(pack.isLoaded());
+    EXPECT_EQ(pack.getNumEntries(), 3u);
+    EXPECT_TRUE(pack.contains("hello.txt"));
+    EXPECT_FALSE(pack.contains("hello"));
+    EXPECT_FALSE(pack.open("missing").has_value());
+
+    EXPECT_EQ(pack.load("levels/1.bin"), m_Level);
+    EXPECT_EQ(pack.load("hello.txt"), (std::vector<uint8_t>{'h', 'i'}));
+    EXPECT_EQ(pack.load("empty"), std::vector<uint8_t>{});
+
+    for (size_t i = 0; i < pack.getNumEntries(); ++i)
+        { EXPECT_EQ(pack.getEntry(i).offset % 4, 0u); }
+}
+
+TEST_F(AssetPackTest, ReadsWithinAnEntry)
+{
+    pdcpp::AssetPack pack("test.pdap");
+    auto file = pack.open("levels/1.bin");
+    ASSERT_TRUE(file.has_value());
+    EXPECT_EQ(file->getSize(), 1000u);
+
+    uint8_t bytes[8];
+    EXPECT_EQ(file->seek(-4, pdcpp::FileHandle::END), 0);
+    EXPECT_EQ(file->read(bytes, sizeof(bytes)), 4);
+    EXPECT_EQ(bytes[0], uint8_t(996));
+    EXPECT_EQ(file->read(bytes, sizeof(bytes)), 0);
+
+    EXPECT_EQ(file->seek(10, pdcpp::FileHandle::SET), 0);
+    EXPECT_EQ(file->read(bytes, 2), 2);
+    EXPECT_EQ(bytes[1], 11);
+    EXPECT_EQ(file->tell(), 12);
+
+    // Nothing outside the entry is reachable.
+    EXPECT_EQ(file->seek(1001, pdcpp::FileHandle::SET), -1);
+    EXPECT_EQ(file->seek(-13, pdcpp::FileHandle::CURRENT), -1);
+    EXPECT_EQ(file->write(bytes, 1), -1);
+}
+
+TEST_F(AssetPackTest, RejectsAnythingButAPack)
+{
+    pdcpp::AssetPack missing("nothing.pdap");
+    EXPECT_FALSE(missing.isLoaded());
+    auto nErrors = m_Host.getErrorCount();
+
+    poke(0, 0x12345678);
+    pdcpp::AssetPack notAPack("test.pdap");
+    EXPECT_FALSE(notAPack.isLoaded());
+    EXPECT_FALSE(notAPack.contains("hello.txt"));
+    EXPECT_EQ(m_Host.getErrorCount(), nErrors + 1);
+}
+
+TEST_F(AssetPackTest, RejectsCountsBiggerThanTheFile)
+{
+    // The number of entries, then the size of the path table.
+    poke(8, 0x10000000);
+    pdcpp::AssetPack tooManyEntries("test.pdap");
+    EXPECT_FALSE(tooManyEntries.isLoaded());
+
+    poke(8, 3);
+    poke(12, 0xfffffff0);
+    pdcpp::AssetPack tooManyPaths("test.pdap");
+    EXPECT_FALSE(tooManyPaths.isLoaded());
+    EXPECT_EQ(m_Host.getErrorCount(), 2);
+}
+
+TEST_F(AssetPackTest, RejectsEntriesOutsideTheFile)
+{
+    // The first entry's data runs off the end.
+    constexpr auto firstEntry = pdcpp::AssetPack::k_HeaderSize;
+    poke(firstEntry + 16, 0xfffffff0);
+    pdcpp::AssetPack badData("test.pdap");
+    EXPECT_FALSE(badData.isLoaded());
+    EXPECT_EQ(badData.getNumEntries(), 0u);
+
+    // Its path runs off the end of the path table.
+    poke(firstEntry + 16, 0);
+    poke(firstEntry + 4, 0xfffffff0);
+    pdcpp::AssetPack badPath("test.pdap");
+    EXPECT_FALSE(badPath.isLoaded());
+    EXPECT_EQ(m_Host.getErrorCount(), 2);
+}
@@ -0,0 +1,81 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#include <algorithm>
+#include <vector>
+#include <pdcpp/core/BufferedFileHandle.h>
+#include "HostTest.h"
+
+namespace
+{
+    using BufferedFileHandleTest = pdcpp::test::HostTest;
+
+    constexpr const char* k_Path = "fields.bin";
+}
+
+TEST_F(BufferedFileHandleTest, RoundTripsFields)
+{
+    {
+        pdcpp::BufferedFileHandle file(k_Path, kFileWrite, 64);
+        ASSERT_TRUE(file.isOpen());
+        for (uint16_t i = 0; i < 1000; ++i)
+        {
+            EXPECT_TRUE(file.writeLE(i));
+            EXPECT_TRUE(file.writeLE(float(i) * 0.5f));
+        }
+        EXPECT_EQ(file.tell(), 6000);
+    }
+
+    pdcpp::BufferedFileHandle file(k_Path, kFileReadData, 64);
+    ASSERT_TRUE(file.isOpen());
+    EXPECT_EQ(file.getDetails().size, 6000u);
+    for (uint16_t i = 0; i < 1000; ++i)
+    {
+        EXPECT_EQ(file.readLE<uint16_t>(), i);
+        EXPECT_EQ(file.readLE<float>(), float(i) * 0.5f);
+    }
+    EXPECT_FALSE(file.hasFailed());
+
+    // Past the end is a short read, and sticks.
+    EXPECT_EQ(file.readLE<uint32_t>(), 0u);
+    EXPECT_TRUE(file.hasFailed());
+}
+
+TEST_F(BufferedFileHandleTest, SeeksAndReadsAroundTheBuffer)
+{
+    std::vector<uint8_t> data(10000);
+    for (size_t i = 0; i < data.size(); ++i)
+        { data[i] = uint8_t(i * 7); }
+    {
+        pdcpp::BufferedFileHandle file(k_Path, kFileWrite, 256);
+        ASSERT_EQ(file.write(data.data(), static_cast<unsigned int>(data.size())), int(data.size()));
+    }
+
+    pdcpp::BufferedFileHandle file(k_Path, kFileReadData, 256);
+    uint8_t small[10];
+    ASSERT_EQ(file.read(small, sizeof(small)), int(sizeof(small)));
+    EXPECT_EQ(small[9], data[9]);
+
+    // Within the read-ahead, then well past it.
+    ASSERT_EQ(file.seek(100, pdcpp::FileHandle::SET), 0);
+    EXPECT_EQ(file.readLE<uint8_t>(), data[100]);
+    ASSERT_EQ(file.seek(-10, pdcpp::FileHandle::END), 0);
+    EXPECT_EQ(file.tell(), 9990);
+    EXPECT_EQ(file.read(small, sizeof(small)), int(sizeof(small)));
+    EXPECT_EQ(small[0], data[9990]);
+
+    // Bigger than the buffer goes straight through.
+    std::vector<uint8_t> big(4000);
+    ASSERT_EQ(file.seek(1000, pdcpp::FileHandle::SET), 0);
+    ASSERT_EQ(file.read(big.data(), static_cast<unsigned int>(big.size())), int(big.size()));
+    EXPECT_TRUE(std::equal(big.begin(), big.end(), data.begin() + 1000));
+    EXPECT_EQ(file.tell(), 5000);
+    EXPECT_FALSE(file.hasFailed());
+}
@@ -0,0 +1,83 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#include <cstring>
+#include <vector>
+#include <pdcpp/core/Compression.h>
+#include "HostTest.h"
+
+namespace
+{
+    using CompressionTest = pdcpp::test::HostTest;
+
+    // Runs of text, which compress, between stretches of noise, which don't.
+    std::vector<uint8_t> makeData(size_t size)
+    {
+        std::vector<uint8_t> data(size);
+        uint32_t state = 12345;
+        const char* text = "the quick brown fox jumps over the lazy dog ";
+        for (size_t i = 0; i < size; ++i)
+        {
+            state = state * 1664525u + 1013904223u;
+            data[i] = (i / 512) % 2 == 0 ? uint8_t(text[i % std::strlen(text)]) : uint8_t(state >> 24);
+        }
+        return data;
+    }
+}
+
+TEST_F(CompressionTest, RoundTripsAFrame)
+{
+    auto data = makeData(10000);
+    auto frame = pdcpp::Compression::compress(data.data(), data.size(), 1024);
+    EXPECT_LT(frame.size(), data.size());
+
+    auto size = pdcpp::Compression::getDecompressedSize(frame.data(), frame.size());
+    ASSERT_TRUE(size.has_value());
+    EXPECT_EQ(*size, data.size());
+
+    std::vector<uint8_t> out(*size);
+    ASSERT_EQ(pdcpp::Compression::decompress(frame.data(), frame.size(), out.data(), out.size()), int(data.size()));
+    EXPECT_EQ(out, data);
+}
+
+TEST_F(CompressionTest, RejectsTruncatedAndUndersizedInput)
+{
+    auto data = makeData(5000);
+    auto frame = pdcpp::Compression::compress(data.data(), data.size(), 1024);
+
+    std::vector<uint8_t> out(data.size());
+    EXPECT_EQ(pdcpp::Compression::decompress(frame.data(), frame.size() / 2, out.data(), out.size()), -1);
+    EXPECT_EQ(pdcpp::Compression::decompress(frame.data(), frame.size(), out.data(), out.size() - 1), -1);
+    EXPECT_FALSE(pdcpp::Compression::getDecompressedSize(data.data(), data.size()).has_value());
+}
+
+TEST_F(CompressionTest, SavesLoadsAndSeeksInFiles)
+{
+    auto data = makeData(20000);
+    ASSERT_TRUE(pdcpp::Compression::saveFile("level.pdz", data.data(), data.size(), 4096));
+
+    auto loaded = pdcpp::Compression::loadFile("level.pdz");
+    ASSERT_TRUE(loaded.has_value());
+    EXPECT_EQ(*loaded, data);
+
+    pdcpp::Compression::Reader<> reader("level.pdz", kFileReadData);
+    ASSERT_TRUE(reader.isOpen());
+    EXPECT_EQ(reader.getDetails().size, data.size());
+
+    // Back and forth across block boundaries.
+    for (int position : {12000, 100, 4090, 16384})
+    {
+        ASSERT_EQ(reader.seek(position, pdcpp::FileHandle::SET), 0);
+        uint8_t bytes[300];
+        ASSERT_EQ(reader.read(bytes, sizeof(bytes)), int(sizeof(bytes)));
+        EXPECT_EQ(std::memcmp(bytes, data.data() + position, sizeof(bytes)), 0) << "at " << position;
+    }
+    EXPECT_EQ(m_Host.getErrorCount(), 0);
+}
@@ -0,0 +1,104 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <pdcpp/core/FastMath.h>
+#include <pdcpp/graphics/Point.h>
+#include "HostTest.h"
+
+namespace
+{
+    using FastMathTest = pdcpp::test::HostTest;
+
+    // The accuracy the FastMath documentation promises at the default
+    // resolution, "about" 3e-7 for atan2 being a little over at worst.
+    constexpr double k_TrigTolerance = 1e-5;
+    constexpr double k_AtanTolerance = 3.5e-7;
+}
+
+TEST_F(FastMathTest, SinAndCosAreAsAccurateAsDocumented)
+{
+    // Within a few turns of zero. Further out, the float has fewer bits left
+    // for the fraction of a turn.
+    for (int i = -20000; i <= 20000; ++i)
+    {
+        const auto radians = float(i) * 0.001f;
+        const auto sc = pdcpp::FastMath::sinCos(radians);
+        EXPECT_NEAR(pdcpp::FastMath::sin(radians), std::sin(double(radians)), k_TrigTolerance) << radians;
+        EXPECT_NEAR(pdcpp::FastMath::cos(radians), std::cos(double(radians)), k_TrigTolerance) << radians;
+        EXPECT_EQ(sc.sin, pdcpp::FastMath::sin(radians));
+        EXPECT_EQ(sc.cos, pdcpp::FastMath::cos(radians));
+    }
+}
+
+TEST_F(FastMathTest, Atan2IsAsAccurateAsDocumented)
+{
+    for (int i = 0; i < 4096; ++i)
+    {
+        const auto angle = float(i) * 0.00153f - 3.1f;
+        for (auto radius : {0.01f, 1.0f, 500.0f})
+        {
+            const auto x = radius * std::cos(angle);
+            const auto y = radius * std::sin(angle);
+            EXPECT_NEAR(pdcpp::FastMath::atan2(y, x), std::atan2(double(y), double(x)), k_AtanTolerance) << x << ", " << y;
+        }
+    }
+
+    // The axes, and the origin, which libm also calls 0.
+    EXPECT_EQ(pdcpp::FastMath::atan2(0.0f, 0.0f), 0.0f);
+    EXPECT_NEAR(pdcpp::FastMath::atan2(0.0f, -1.0f), std::numbers::pi, k_AtanTolerance);
+    EXPECT_NEAR(pdcpp::FastMath::atan2(1.0f, 0.0f), std::numbers::pi / 2, k_AtanTolerance);
+    EXPECT_NEAR(pdcpp::FastMath::atan2(-1.0f, 0.0f), -std::numbers::pi / 2, k_AtanTolerance);
+}
+
+TEST_F(FastMathTest, CoarserTablesAreLessAccurate)
+{
+    double worst = 0;
+    for (int i = 0; i < 10000; ++i)
+    {
+        const auto radians = float(i) * 0.000628f;
+        worst = std::max(worst, std::abs(pdcpp::FastMath::sin<6>(radians) - std::sin(double(radians))));
+    }
+
+    // Interpolation error grows with the square of the step.
+    EXPECT_GT(worst, 1e-4);
+    EXPECT_LT(worst, 2e-3);
+}
+
+TEST_F(FastMathTest, InvSqrtRefinesWithEachIteration)
+{
+    for (auto x : {0.01f, 0.5f, 1.0f, 2.0f, 1234.5f})
+    {
+        const auto exact = 1.0 / std::sqrt(double(x));
+        EXPECT_NEAR(pdcpp::FastMath::invSqrt(x), exact, exact * 2e-3);
+        EXPECT_NEAR(pdcpp::FastMath::invSqrt<2>(x), exact, exact * 5e-6);
+    }
+
+    EXPECT_EQ(pdcpp::FastMath::sqrt(0.0f), 0.0f);
+    EXPECT_EQ(pdcpp::FastMath::sqrt(-4.0f), 0.0f);
+}
+
+TEST_F(FastMathTest, RotatesPointsLikeLibm)
+{
+    const pdcpp::Point<float> center(200.0f, 120.0f);
+    const pdcpp::Point<float> hand(260.0f, 120.0f);
+    for (int i = 0; i < 360; ++i)
+    {
+        const auto radians = float(i) * float(std::numbers::pi / 180.0);
+        const auto exact = hand.rotated(center, radians);
+        const auto fast = hand.rotated(center, radians, pdcpp::FastMath::useTables);
+
+        // Well under a pixel at this radius.
+        EXPECT_NEAR(fast.x, exact.x, 1e-3f);
+        EXPECT_NEAR(fast.y, exact.y, 1e-3f);
+    }
+}
@@ -0,0 +1,126 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <tuple>
+#include <vector>
+#include <pdcpp/core/File.h>
+#include <pdcpp/core/FileSystemCache.h>
+#include "HostTest.h"
+
+namespace
+{
+    // Each test has a cache of its own, over a "saves" directory made behind
+    // pdcpp's back, so nothing invalidates it but the test.
+    class FileSystemCacheTest
+        : public pdcpp::test::HostTest
+    {
+    protected:
+        void SetUp() override
+        {
+            HostTest::SetUp();
+            auto saves = m_Host.getDataDirectory() / "saves";
+            std::filesystem::create_directories(saves / "old");
+            for (auto name : {"c.sav", "a.sav", ".hidden", "b.sav"})
+                { std::ofstream(saves / name) << "data"; }
+        }
+
+        std::vector<std::string> listFromTheSystem(const std::string& directory, bool showHidden)
+        {
+            std::vector<std::string> names;
+            m_Host.get()->file->listfiles(directory.c_str(), [](const char* name, void* userData)
+            {
+                static_cast<std::vector<std::string>*>(userData)->emplace_back(name);
+            }, &names, showHidden);
+            return names;
+        }
+
+        pdcpp::FileSystemCache m_Cache;
+    };
+}
+
+TEST_F(FileSystemCacheTest, ListsInTheSystemsOrder)
+{
+    auto listing = m_Cache.listFiles("saves");
+    ASSERT_NE(listing, nullptr);
+    EXPECT_EQ(*listing, listFromTheSystem("saves/", false));
+    EXPECT_EQ(listing->size(), 4u);
+
+    auto all = m_Cache.listFiles("saves/", true);
+    ASSERT_NE(all, nullptr);
+    EXPECT_EQ(*all, listFromTheSystem("saves/", true));
+    EXPECT_EQ(all->size(), 5u);
+}
+
+TEST_F(FileSystemCacheTest, AsksTheSystemOnce)
+{
+    std::ignore = m_Cache.listFiles("saves/");
+    std::ignore = m_Cache.listFiles("saves");
+    EXPECT_EQ(m_Cache.getNumApiCalls(), 1u);
+
+    // Hidden files weren't asked for the first time.
+    std::ignore = m_Cache.listFiles("saves/", true);
+    std::ignore = m_Cache.listFiles("saves/");
+    EXPECT_EQ(m_Cache.getNumApiCalls(), 2u);
+
+    auto stat = m_Cache.stat("saves/a.sav");
+    ASSERT_TRUE(stat.has_value());
+    EXPECT_EQ(stat->size, 4u);
+    EXPECT_TRUE(m_Cache.stat("saves/old/").has_value());
+    EXPECT_TRUE(m_Cache.stat("saves/a.sav").has_value());
+    EXPECT_EQ(m_Cache.getNumApiCalls(), 4u);
+
+    // The listing already says it isn't there.
+    EXPECT_FALSE(m_Cache.stat("saves/d.sav").has_value());
+    EXPECT_EQ(m_Cache.getNumApiCalls(), 4u);
+}
+
+TEST_F(FileSystemCacheTest, ForgetsWhatItsTold)
+{
+    std::ignore = m_Cache.listFiles("saves/");
+    std::ignore = m_Cache.stat("saves/old");
+    std::ofstream(m_Host.getDataDirectory() / "saves" / "d.sav") << "new";
+
+    m_Cache.invalidate("saves/d.sav");
+    auto listing = m_Cache.listFiles("saves/");
+    ASSERT_NE(listing, nullptr);
+    EXPECT_EQ(listing->size(), 5u);
+    EXPECT_TRUE(m_Cache.stat("saves/d.sav").has_value());
+
+    // Invalidating a directory forgets what's below it.
+    auto nCalls = m_Cache.getNumApiCalls();
+    m_Cache.invalidate("saves");
+    std::ignore = m_Cache.stat("saves/old");
+    EXPECT_EQ(m_Cache.getNumApiCalls(), nCalls + 1);
+}
+
+TEST_F(FileSystemCacheTest, KeepsNoMoreStatsThanAllowed)
+{
+    m_Cache.setMaxStats(1);
+    std::ignore = m_Cache.stat("saves/a.sav");
+    std::ignore = m_Cache.stat("saves/b.sav");
+    std::ignore = m_Cache.stat("saves/a.sav");
+    EXPECT_EQ(m_Cache.getNumApiCalls(), 3u);
+}
+
+TEST_F(FileSystemCacheTest, MissingDirectoriesAreQuiet)
+{
+    EXPECT_EQ(m_Cache.listFiles("nowhere/"), nullptr);
+    EXPECT_FALSE(m_Cache.stat("nowhere/file").has_value());
+    EXPECT_EQ(m_Host.getErrorCount(), 0);
+
+    // The default cache sees files written through pdcpp.
+    auto& cache = pdcpp::FileSystemCache::getDefault();
+    ASSERT_NE(cache.listFiles("saves/"), nullptr);
+    pdcpp::FileHandle("saves/e.sav", kFileWrite);
+    EXPECT_EQ(cache.listFiles("saves/")->size(), 5u);
+}
@@ -0,0 +1,109 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#include <cmath>
+#include <cstring>
+#include <pdcpp/core/FastMath.h>
+#include <pdcpp/graphics/Rectangle.h>
+#include "HostTest.h"
+
+// Fixed point and the FastMath tables exist so simulations give the same
+// answers everywhere. These goldens were taken from the implementation as it
+// stands, and any change to them is a change to every replay and save.
+namespace
+{
+    using FixedMathTest = pdcpp::test::HostTest;
+    using pdcpp::Fixed16;
+
+    uint32_t bitsOf(float value)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    // FNV-1a over the bytes of each value.
+    class Digest
+    {
+    public:
+        void add(uint32_t value)
+        {
+            for (int i = 0; i < 4; ++i)
+            {
+                m_Hash ^= (value >> (8 * i)) & 0xff;
+                m_Hash *= 16777619u;
+            }
+        }
+
+        [[ nodiscard ]] uint32_t get() const { return m_Hash; }
+
+    private:
+        uint32_t m_Hash = 2166136261u;
+    };
+}
+
+TEST_F(FixedMathTest, MatchesFixedGoldens)
+{
+    const Fixed16 a(3.25);
+    const Fixed16 b(-1.5);
+    EXPECT_EQ((a * b).raw(), -319488);
+    EXPECT_EQ((a / b).raw(), -141994);
+    EXPECT_EQ((a + b).raw(), 114688);
+    EXPECT_EQ(sqrt(a).raw(), 118146);
+    EXPECT_EQ(hypot(a, b).raw(), 234583);
+    EXPECT_EQ(sin(a).raw(), -7091);
+    EXPECT_EQ(cos(a).raw(), -65151);
+    EXPECT_EQ(pdcpp::FastMath::sin(a).raw(), -7091);
+    EXPECT_EQ(pdcpp::FastMath::cos(a).raw(), -65151);
+
+    Digest fixed;
+    Digest tables;
+    for (int i = -2048; i < 2048; ++i)
+    {
+        const auto x = Fixed16::fromRaw(i * 1237 + 17);
+        const auto y = Fixed16::fromRaw(i * -911 + 65536);
+        for (auto value : {x * y, x / y, sqrt(abs(x)), hypot(x, y), sin(x), cos(x)})
+            { fixed.add(uint32_t(value.raw())); }
+        tables.add(uint32_t(pdcpp::FastMath::sin(x).raw()));
+        tables.add(uint32_t(pdcpp::FastMath::cos(x).raw()));
+    }
+    EXPECT_EQ(fixed.get(), 0x97403c6eu);
+    EXPECT_EQ(tables.get(), 0x15abe29du);
+}
+
+TEST_F(FixedMathTest, MatchesFastMathGoldens)
+{
+    EXPECT_EQ(bitsOf(pdcpp::FastMath::sin(1.0f)), 0x3f576a9eu);
+    EXPECT_EQ(bitsOf(pdcpp::FastMath::cos(1.0f)), 0x3f0a513bu);
+    EXPECT_EQ(bitsOf(pdcpp::FastMath::atan2(1.0f, -2.0f)), 0x402b6374u);
+    EXPECT_EQ(bitsOf(pdcpp::FastMath::sqrt(2.0f)), 0x3fb4f957u);
+
+    Digest digest;
+    for (int i = -2048; i < 2048; ++i)
+    {
+        const auto r = float(i) / 256.0f;
+        const auto sc = pdcpp::FastMath::sinCos(r);
+        digest.add(bitsOf(sc.sin));
+        digest.add(bitsOf(sc.cos));
+        digest.add(bitsOf(pdcpp::FastMath::atan2(r, 1.5f - r)));
+        digest.add(bitsOf(pdcpp::FastMath::sqrt(std::abs(r))));
+    }
+    EXPECT_EQ(digest.get(), 0x05806d1bu);
+}
+
+TEST_F(FixedMathTest, PlacesFixedRectanglesInEllipses)
+{
+    const pdcpp::Rectangle<Fixed16> box(0, 0, 10, 6);
+    const pdcpp::Rectangle<Fixed16> ellipse(0, 0, 100, 80);
+    auto placed = pdcpp::Rectangle<Fixed16>(box).withEdgeInEllipse(ellipse, 0.7f);
+    auto expected = pdcpp::Rectangle<float>(0, 0, 10, 6).withEdgeInEllipse({0, 0, 100, 80}, 0.7f);
+    EXPECT_NEAR(float(placed.x), expected.x, 0.01f);
+    EXPECT_NEAR(float(placed.y), expected.y, 0.01f);
+}
@@ -0,0 +1,77 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#include <pdcpp/core/FrameArena.h>
+#include <pdcpp/core/Log.h>
+#include "HostTest.h"
+
+namespace
+{
+    using FrameArenaTest = pdcpp::test::HostTest;
+}
+
+TEST_F(FrameArenaTest, BumpsAndGivesBackTheTop)
+{
+    pdcpp::FrameArena arena(256);
+    auto a = arena.allocate(10, 1);
+    auto b = arena.allocate(16, 8);
+    EXPECT_TRUE(arena.owns(a));
+    EXPECT_TRUE(arena.owns(b));
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(b) % 8, 0u);
+    EXPECT_EQ(arena.getStats().bytesInUse, 32u);
+    EXPECT_EQ(arena.getNumLive(), 2u);
+
+    // Only the top comes back before a reset.
+    arena.deallocate(b, 16);
+    EXPECT_EQ(arena.getStats().bytesInUse, 10u);
+    EXPECT_EQ(arena.allocate(16, 8), b);
+
+    arena.reset();
+    EXPECT_EQ(arena.getStats().bytesInUse, 0u);
+    EXPECT_EQ(arena.getStats().allocations, 0u);
+    EXPECT_EQ(arena.getStats().highWaterMark, 32u);
+}
+
+TEST_F(FrameArenaTest, FallsBackToTheHeapLoudly)
+{
+    pdcpp::Log::getDefault().flush();
+    pdcpp::FrameArena arena(64);
+    pdcpp::ArenaVector<int> fits(pdcpp::ArenaAllocator<int>{arena});
+    fits.reserve(8);
+    EXPECT_TRUE(arena.owns(fits.data()));
+
+    pdcpp::ArenaVector<int> spills(pdcpp::ArenaAllocator<int>{arena});
+    spills.reserve(64);
+    spills.reserve(128);
+    EXPECT_FALSE(arena.owns(spills.data()));
+    EXPECT_EQ(arena.getStats().heapFallbacks, 2u);
+
+    // One warning per reset, however many times it spills.
+    EXPECT_EQ(pdcpp::Log::getDefault().getNumPending(), 1u);
+    arena.reset();
+    spills.reserve(256);
+    EXPECT_EQ(pdcpp::Log::getDefault().getNumPending(), 2u);
+    pdcpp::Log::getDefault().flush();
+}
+
+TEST_F(FrameArenaTest, RefusesToResizeWhileInUse)
+{
+    {
+        pdcpp::ArenaVector<float> scratch;
+        scratch.reserve(4);
+        EXPECT_FALSE(pdcpp::FrameArena::setDefaultCapacity(1024));
+        EXPECT_EQ(pdcpp::FrameArena::getDefault().getStats().capacity, pdcpp::FrameArena::k_DefaultCapacity);
+    }
+
+    EXPECT_EQ(pdcpp::FrameArena::getDefault().getNumLive(), 0u);
+    EXPECT_TRUE(pdcpp::FrameArena::setDefaultCapacity(1024));
+    EXPECT_EQ(pdcpp::FrameArena::getDefault().getStats().capacity, 1024u);
+    EXPECT_TRUE(pdcpp::FrameArena::setDefaultCapacity(pdcpp::FrameArena::k_DefaultCapacity));
+}
@@ -0,0 +1,149 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#include <filesystem>
+#include <vector>
+#include "HostTest.h"
+
+namespace
+{
+    struct ButtonEvent
+    {
+        PDButtons button;
+        bool down;
+        uint32_t when;
+    };
+
+    int recordButton(PDButtons button, int down, uint32_t when, void* userdata)
+    {
+        static_cast<std::vector<ButtonEvent>*>(userdata)->push_back({button, down != 0, when});
+        return 0;
+    }
+
+    int countFrame(void* userdata)
+    {
+        ++*static_cast<int*>(userdata);
+        return 0;
+    }
+
+    class HostPlaydateAPITest
+        : public pdcpp::test::HostTest
+    {
+    protected:
+        [[ nodiscard ]] const playdate_sys* sys() const { return m_Host.get()->system; }
+    };
+}
+
+TEST_F(HostPlaydateAPITest, DeliversEveryButtonToTheCallback)
+{
+    std::vector<ButtonEvent> events;
+    sys()->setButtonCallback(recordButton, &events, 0);
+    m_Host.advanceTime(250);
+
+    constexpr auto all = PDButtons(kButtonLeft | kButtonRight | kButtonUp | kButtonDown | kButtonB | kButtonA);
+    m_Host.setButtonState(all);
+    ASSERT_EQ(events.size(), 6u);
+    EXPECT_EQ(events.back().button, kButtonA);
+    EXPECT_TRUE(events.back().down);
+    EXPECT_EQ(events.back().when, 250u);
+
+    events.clear();
+    m_Host.releaseButtons(kButtonA);
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0].button, kButtonA);
+    EXPECT_FALSE(events[0].down);
+}
+
+TEST_F(HostPlaydateAPITest, KeepsPushedAndReleasedForAFrame)
+{
+    m_Host.pressButtons(kButtonA);
+    m_Host.pressButtons(kButtonB);
+    m_Host.releaseButtons(kButtonB);
+
+    PDButtons current, pushed, released;
+    sys()->getButtonState(&current, &pushed, &released);
+    EXPECT_EQ(current, kButtonA);
+    EXPECT_EQ(pushed, PDButtons(kButtonA | kButtonB));
+    EXPECT_EQ(released, kButtonB);
+
+    m_Host.runFrame();
+    sys()->getButtonState(&current, &pushed, &released);
+    EXPECT_EQ(current, kButtonA);
+    EXPECT_EQ(pushed, 0);
+    EXPECT_EQ(released, 0);
+}
+
+TEST_F(HostPlaydateAPITest, ManualClockOnlyMovesWhenTold)
+{
+    auto start = sys()->getCurrentTimeMilliseconds();
+    sys()->resetElapsedTime();
+    EXPECT_EQ(sys()->getCurrentTimeMilliseconds(), start);
+
+    m_Host.advanceTime(1500);
+    EXPECT_EQ(sys()->getCurrentTimeMilliseconds(), start + 1500);
+    EXPECT_FLOAT_EQ(sys()->getElapsedTime(), 1.5f);
+}
+
+TEST_F(HostPlaydateAPITest, RunsTheUpdateCallback)
+{
+    int frames = 0;
+    sys()->setUpdateCallback(countFrame, &frames);
+    m_Host.runFrames(3);
+    EXPECT_EQ(frames, 3);
+    EXPECT_EQ(m_Host.getFrameCount(), 3u);
+}
+
+TEST_F(HostPlaydateAPITest, WritesFilesToTheDataDirectory)
+{
+    auto file = m_Host.get()->file->open("saves/slot.bin", kFileWrite);
+    EXPECT_EQ(file, nullptr);
+
+    ASSERT_EQ(m_Host.get()->file->mkdir("saves"), 0);
+    file = m_Host.get()->file->open("saves/slot.bin", kFileWrite);
+    ASSERT_NE(file, nullptr);
+    const char data[] = "slot";
+    EXPECT_EQ(m_Host.get()->file->write(file, data, 4), 4);
+    EXPECT_EQ(m_Host.get()->file->close(file), 0);
+
+    auto onDisk = m_Host.getDataDirectory() / "saves" / "slot.bin";
+    ASSERT_TRUE(std::filesystem::exists(onDisk));
+    EXPECT_EQ(std::filesystem::file_size(onDisk), 4u);
+}
+
+TEST_F(HostPlaydateAPITest, CountsErrors)
+{
+    sys()->error("bad %d", 7);
+    EXPECT_EQ(m_Host.getErrorCount(), 1);
+    EXPECT_EQ(m_Host.getLastError(), "bad 7");
+}
+
+TEST_F(HostPlaydateAPITest, ConvertsTheEpoch)
+{
+    // The Playdate epoch is midnight, January 1st 2000, a Saturday.
+    PDDateTime date {};
+    sys()->convertEpochToDateTime(0, &date);
+    EXPECT_EQ(date.year, 2000);
+    EXPECT_EQ(date.month, 1);
+    EXPECT_EQ(date.day, 1);
+    EXPECT_EQ(date.weekday, 6);
+
+    date.year = 2026;
+    date.month = 10;
+    date.day = 17;
+    date.hour = 13;
+    date.minute = 45;
+    date.second = 30;
+    auto epoch = sys()->convertDateTimeToEpoch(&date);
+    PDDateTime back {};
+    sys()->convertEpochToDateTime(epoch, &back);
+    EXPECT_EQ(back.year, 2026);
+    EXPECT_EQ(back.hour, 13);
+    EXPECT_EQ(back.second, 30);
+}
@@ -0,0 +1,51 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#pragma once
+
+#include <gtest/gtest.h>
+#include <pdcpp/core/FileSystemCache.h>
+#include <pdcpp/core/GlobalPlaydateAPI.h>
+#include <pdcpp/host/HostPlaydateAPI.h>
+
+namespace pdcpp::test
+{
+    /**
+     * Runs each test against a fresh host backend, with an empty data folder
+     * and a manual clock, installed as the global API.
+     */
+    class HostTest
+        : public ::testing::Test
+    {
+    protected:
+        HostTest() : m_Host(makeOptions()) {}
+
+        void SetUp() override
+        {
+            pdcpp::GlobalPlaydateAPI::initialize(m_Host.get());
+
+            // The default cache outlives the previous test's data folder.
+            pdcpp::FileSystemCache::getDefault().clear();
+        }
+
+        void TearDown() override { pdcpp::GlobalPlaydateAPI::destroyInstance(); }
+
+        pdcpp::HostPlaydateAPI m_Host;
+
+    private:
+        static pdcpp::HostPlaydateAPI::Options makeOptions()
+        {
+            pdcpp::HostPlaydateAPI::Options options;
+            options.clockMode = pdcpp::HostPlaydateAPI::ClockMode::Manual;
+            options.echoLogs = false;
+            return options;
+        }
+    };
+}
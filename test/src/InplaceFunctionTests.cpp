@@ -0,0 +1,82 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#include <functional>
+#include <utility>
+#include <pdcpp/core/InplaceFunction.h>
+#include "HostTest.h"
+
+namespace
+{
+    using InplaceFunctionTest = pdcpp::test::HostTest;
+
+    // Counts how many of it are alive, to check copies and moves clean up.
+    struct Counted
+    {
+        Counted() { ++s_Alive; }
+        Counted(const Counted&) { ++s_Alive; }
+        Counted(Counted&&) noexcept { ++s_Alive; }
+        ~Counted() { --s_Alive; }
+        int operator()(int x) const { return x * 2; }
+
+        static inline int s_Alive = 0;
+    };
+
+    static_assert(pdcpp::InplaceFunction<void()>::k_Capacity == 32);
+}
+
+TEST_F(InplaceFunctionTest, CallsWhatItWraps)
+{
+    int total = 0;
+    pdcpp::InplaceFunction<void(int)> add = [&total](int x) { total += x; };
+    add(3);
+    add(4);
+    EXPECT_EQ(total, 7);
+
+    pdcpp::InplaceFunction<int(int)> doubled = [](int x) { return x * 2; };
+    EXPECT_EQ(doubled(21), 42);
+
+    // Four pointers' worth of capture fits on any platform.
+    int64_t a = 1, b = 2, c = 3, d = 4;
+    pdcpp::InplaceFunction<int64_t()> sum = [a, b, c, d]() { return a + b + c + d; };
+    EXPECT_EQ(sum(), 10);
+}
+
+TEST_F(InplaceFunctionTest, EmptiesFromNulls)
+{
+    pdcpp::InplaceFunction<void()> none;
+    EXPECT_FALSE(none);
+    EXPECT_TRUE(none == nullptr);
+
+    void (*pointer)() = nullptr;
+    EXPECT_FALSE(pdcpp::InplaceFunction<void()>(pointer));
+    EXPECT_FALSE(pdcpp::InplaceFunction<void()>(std::function<void()>()));
+}
+
+TEST_F(InplaceFunctionTest, CopiesMovesAndDestroys)
+{
+    {
+        pdcpp::InplaceFunction<int(int)> original = Counted();
+        EXPECT_EQ(Counted::s_Alive, 1);
+
+        auto copy = original;
+        EXPECT_EQ(Counted::s_Alive, 2);
+        EXPECT_EQ(copy(4), 8);
+
+        auto moved = std::move(original);
+        EXPECT_FALSE(original);
+        EXPECT_EQ(Counted::s_Alive, 2);
+        EXPECT_EQ(moved(5), 10);
+
+        copy = nullptr;
+        EXPECT_EQ(Counted::s_Alive, 1);
+    }
+    EXPECT_EQ(Counted::s_Alive, 0);
+}
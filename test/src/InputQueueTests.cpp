@@ -0,0 +1,177 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#include <vector>
+#include <pdcpp/core/InputContext.h>
+#include <pdcpp/core/InputQueue.h>
+#include "HostTest.h"
+
+namespace
+{
+    using InputQueueTest = pdcpp::test::HostTest;
+    using Type = pdcpp::InputEvent::Type;
+
+    constexpr auto k_None = PDButtons(0);
+
+    struct ButtonChange
+    {
+        PDButtons current, pressed, released;
+        bool operator==(const ButtonChange&) const = default;
+    };
+
+    // Remembers everything it's told, in order.
+    class RecordingContext
+        : public pdcpp::InputContext
+    {
+    public:
+        void inputEventReceived(const pdcpp::InputEvent& event) override { events.push_back(event); }
+
+        std::vector<pdcpp::InputEvent> events;
+        std::vector<ButtonChange> buttons;
+        std::vector<float> crankDeltas;
+
+    protected:
+        void buttonStateChanged(const PDButtons& current, const PDButtons& pressed, const PDButtons& released) override
+            { buttons.push_back({current, pressed, released}); }
+
+        void crankStateChanged(float /*absolute*/, float delta) override { crankDeltas.push_back(delta); }
+    };
+}
+
+TEST_F(InputQueueTest, KeepsEventsInOrderAndDropsWhenFull)
+{
+    pdcpp::InputQueue queue(3);
+    EXPECT_TRUE(queue.pushButton(kButtonA, true, 10));
+    EXPECT_TRUE(queue.pushCrank(90.0f, 15.0f, 11));
+    EXPECT_TRUE(queue.pushButton(kButtonA, false, 12));
+    EXPECT_FALSE(queue.pushButton(kButtonB, true, 13));
+    EXPECT_EQ(queue.getNumDropped(), 1u);
+    EXPECT_EQ(queue.size(), 3u);
+
+    ASSERT_NE(queue.peek(), nullptr);
+    EXPECT_EQ(queue.peek()->timeMs, 10u);
+
+    auto first = queue.pop();
+    ASSERT_TRUE(first.has_value());
+    EXPECT_EQ(first->type, Type::ButtonPressed);
+    EXPECT_EQ(first->button, kButtonA);
+
+    // Wraps around the end of the buffer.
+    EXPECT_TRUE(queue.pushButton(kButtonB, true, 14));
+    auto crank = queue.pop();
+    ASSERT_TRUE(crank.has_value());
+    EXPECT_FALSE(crank->isButton());
+    EXPECT_EQ(crank->crankDelta, 15.0f);
+    EXPECT_EQ(queue.pop()->type, Type::ButtonReleased);
+    EXPECT_EQ(queue.pop()->timeMs, 14u);
+    EXPECT_FALSE(queue.pop().has_value());
+    EXPECT_EQ(queue.peek(), nullptr);
+
+    queue.pushButton(kButtonUp, true, 15);
+    queue.clear();
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST_F(InputQueueTest, RecordsEveryPressWhenAttached)
+{
+    pdcpp::InputQueue queue;
+    queue.attach();
+    EXPECT_TRUE(queue.isAttached());
+
+    // Three changes to one button within a frame, each with its own time.
+    auto start = m_Host.get()->system->getCurrentTimeMilliseconds();
+    m_Host.pressButtons(kButtonA);
+    m_Host.advanceTime(5);
+    m_Host.releaseButtons(kButtonA);
+    m_Host.advanceTime(5);
+    m_Host.pressButtons(kButtonA);
+    queue.poll();
+
+    ASSERT_EQ(queue.size(), 3u);
+    EXPECT_EQ(queue.pop()->timeMs, start);
+    auto released = queue.pop();
+    EXPECT_EQ(released->type, Type::ButtonReleased);
+    EXPECT_EQ(released->timeMs, start + 5);
+    EXPECT_EQ(queue.pop()->timeMs, start + 10);
+
+    // Only one queue gets the callback.
+    pdcpp::InputQueue other;
+    other.attach();
+    EXPECT_FALSE(queue.isAttached());
+    m_Host.releaseButtons(kButtonA);
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(other.size(), 1u);
+}
+
+TEST_F(InputQueueTest, PollsWhenUnattached)
+{
+    pdcpp::InputQueue queue;
+    m_Host.pressButtons(kButtonB);
+    m_Host.releaseButtons(kButtonB);
+    m_Host.pressButtons(kButtonB);
+    m_Host.setCrankAngle(90.0f);
+    queue.poll();
+
+    // Polling only sees that B went both ways, and is now held.
+    ASSERT_EQ(queue.size(), 3u);
+    EXPECT_EQ(queue.pop()->type, Type::ButtonReleased);
+    EXPECT_EQ(queue.pop()->type, Type::ButtonPressed);
+    auto crank = queue.pop();
+    EXPECT_EQ(crank->type, Type::CrankMoved);
+    EXPECT_FLOAT_EQ(crank->crankAngle, 90.0f);
+    EXPECT_FLOAT_EQ(crank->crankDelta, 90.0f);
+}
+
+TEST_F(InputQueueTest, ContextsHearEachEvent)
+{
+    RecordingContext context;
+    pdcpp::InputContextManager manager(&context);
+    pdcpp::InputQueue queue;
+    queue.attach();
+    manager.useInputQueue(&queue);
+
+    m_Host.pressButtons(kButtonA);
+    m_Host.releaseButtons(kButtonA);
+    m_Host.pressButtons(kButtonA);
+    m_Host.setCrankAngle(30.0f);
+    manager.update();
+    m_Host.runFrame();
+
+    EXPECT_EQ(context.events.size(), 4u);
+    EXPECT_EQ(context.buttons, (std::vector<ButtonChange>{
+        {kButtonA, kButtonA, k_None},
+        {k_None, k_None, kButtonA},
+        {kButtonA, kButtonA, k_None}}));
+    EXPECT_EQ(context.crankDeltas, std::vector<float>{30.0f});
+
+    // A quiet frame still reports the held button, as polling does.
+    context.buttons.clear();
+    manager.update();
+    EXPECT_EQ(context.buttons, (std::vector<ButtonChange>{{kButtonA, k_None, k_None}}));
+}
+
+TEST_F(InputQueueTest, ContextsCatchUpOnDroppedEvents)
+{
+    RecordingContext context;
+    pdcpp::InputContextManager manager(&context);
+    pdcpp::InputQueue queue(1);
+    queue.attach();
+    manager.useInputQueue(&queue);
+
+    // B's press doesn't fit, but the context still ends up knowing it's held.
+    m_Host.pressButtons(kButtonA);
+    m_Host.pressButtons(kButtonB);
+    manager.update();
+
+    EXPECT_EQ(queue.getNumDropped(), 1u);
+    EXPECT_EQ(context.buttons, (std::vector<ButtonChange>{
+        {kButtonA, kButtonA, k_None},
+        {PDButtons(kButtonA | kButtonB), kButtonB, k_None}}));
+}
@@ -0,0 +1,82 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#include <pdcpp/core/FrameBudget.h>
+#include <pdcpp/core/InputRecorder.h>
+#include "HostTest.h"
+
+namespace
+{
+    constexpr const char* k_Path = "session.pdir";
+
+    class InputRecorderTest
+        : public pdcpp::test::HostTest
+    {
+    protected:
+        // Four frames, 20ms apart, with A held from the second.
+        void record()
+        {
+            pdcpp::InputRecorder recorder(k_Path, 42);
+            for (int i = 0; i < 4; ++i)
+            {
+                if (i == 1)
+                    { m_Host.pressButtons(kButtonA); }
+                m_Host.advanceTime(20);
+                recorder.update();
+                m_Host.runFrame();
+            }
+            EXPECT_EQ(recorder.getNumFrames(), 4u);
+        }
+
+        static uint32_t now() { return pdcpp::GlobalPlaydateAPI::get()->system->getCurrentTimeMilliseconds(); }
+    };
+}
+
+TEST_F(InputRecorderTest, ReplaysButtonsAndTime)
+{
+    record();
+    m_Host.releaseButtons(kButtonA);
+
+    pdcpp::InputPlayer player(k_Path);
+    ASSERT_TRUE(player.isLoaded());
+    EXPECT_EQ(player.getSeed(), 42u);
+
+    ASSERT_TRUE(player.update());
+    auto start = now();
+    for (uint32_t i = 1; i < 4; ++i)
+    {
+        ASSERT_TRUE(player.update());
+        EXPECT_EQ(now(), start + 20 * i);
+
+        PDButtons current;
+        pdcpp::GlobalPlaydateAPI::get()->system->getButtonState(&current, nullptr, nullptr);
+        EXPECT_NE(current & kButtonA, 0);
+    }
+    EXPECT_FALSE(player.update());
+    EXPECT_TRUE(player.isFinished());
+}
+
+TEST_F(InputRecorderTest, BudgetsRunOutDuringReplay)
+{
+    record();
+
+    pdcpp::InputPlayer player(k_Path);
+    ASSERT_TRUE(player.update());
+
+    pdcpp::FrameBudget budget(1.0f);
+    budget.start();
+    auto replayed = now();
+    m_Host.advanceTime(2);
+
+    // The replayed clock holds still for the frame, the budget's doesn't.
+    EXPECT_EQ(now(), replayed);
+    EXPECT_GE(budget.getElapsedUs(), 2000u);
+    EXPECT_TRUE(budget.isSpent());
+}
@@ -0,0 +1,165 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <pdcpp/core/Log.h>
+#include "HostTest.h"
+
+namespace
+{
+    using Level = pdcpp::Log::Level;
+
+    // Each test writes to a log of its own, which goes to a file rather than
+    // the console, so what it wrote can be read back.
+    class LogTest
+        : public pdcpp::test::HostTest
+    {
+    protected:
+        static std::unique_ptr<pdcpp::Log> makeLog(size_t capacity=pdcpp::Log::k_DefaultCapacity)
+        {
+            auto log = std::make_unique<pdcpp::Log>(capacity);
+            log->setConsoleEnabled(false);
+            log->setLogFile("log.txt");
+            return log;
+        }
+
+        // Closes the log file, and returns its lines.
+        std::vector<std::string> readLines(pdcpp::Log& log)
+        {
+            log.setLogFile("");
+            std::ifstream file(m_Host.getDataDirectory() / "log.txt");
+            std::vector<std::string> lines;
+            for (std::string line; std::getline(file, line);)
+                { lines.push_back(line); }
+            return lines;
+        }
+    };
+}
+
+TEST_F(LogTest, WaitsForTheFlush)
+{
+    auto log = makeLog();
+    log->write(Level::Info, "score %d for %s", 5, std::string("bob"));
+    log->write(Level::Warning, "%s", std::string_view("low battery"));
+    EXPECT_EQ(log->getNumPending(), 2u);
+
+    log->flush(1);
+    EXPECT_EQ(log->getNumPending(), 1u);
+    log->flush();
+    EXPECT_EQ(log->getNumPending(), 0u);
+
+    EXPECT_EQ(readLines(*log), (std::vector<std::string>{"score 5 for bob", "WARN: low battery"}));
+}
+
+TEST_F(LogTest, FormatsLikePrintf)
+{
+    auto log = makeLog();
+    const char* name = "str";
+    log->write(Level::Info, "%5.2f|%-4d|%x|%%|%s", 3.14159, 42, 255u, name);
+    log->write(Level::Info, "%zu %ld %lld %hhu", size_t(7), -3L, 1LL << 40, uint8_t(200));
+    log->write(Level::Debug, "%s", "detail");
+    log->flush();
+
+    EXPECT_EQ(readLines(*log), (std::vector<std::string>{
+        " 3.14|42  |ff|%|str",
+        "7 -3 1099511627776 200",
+        "DEBUG: detail"}));
+}
+
+TEST_F(LogTest, IgnoresMessagesBelowTheMinimum)
+{
+    auto log = makeLog();
+    log->setMinimumLevel(Level::Warning);
+    log->write(Level::Info, "quiet");
+    EXPECT_EQ(log->getNumPending(), 0u);
+
+    log->write(Level::Warning, "loud");
+    EXPECT_EQ(log->getNumPending(), 1u);
+
+#if PDCPP_LOG_LEVEL > 0
+    // Compiled out, arguments and all.
+    int nEvaluated = 0;
+    PDCPP_LOG_DEBUG("%d", ++nEvaluated);
+    EXPECT_EQ(nEvaluated, 0);
+#endif
+}
+
+TEST_F(LogTest, ReportsErrorsStraightAway)
+{
+    auto log = makeLog();
+    log->setConsoleEnabled(true);
+    log->write(Level::Info, "first");
+    log->write(Level::Error, "second %d", 2);
+
+    // What was waiting goes first, to keep the order.
+    EXPECT_EQ(log->getNumPending(), 0u);
+    EXPECT_EQ(m_Host.getErrorCount(), 1);
+    EXPECT_EQ(readLines(*log), (std::vector<std::string>{"first", "ERROR: second 2"}));
+}
+
+TEST_F(LogTest, CountsWhatItDrops)
+{
+    auto log = makeLog(64);
+    for (int i = 0; i < 10; ++i)
+        { log->write(Level::Info, "message %d", i); }
+
+    EXPECT_GT(log->getNumDropped(), 0u);
+    auto nKept = log->getNumPending();
+    log->flush();
+
+    auto lines = readLines(*log);
+    ASSERT_EQ(lines.size(), nKept + 1);
+    EXPECT_EQ(lines.front(), "message 0");
+    EXPECT_EQ(lines.back(), "WARN: " + std::to_string(log->getNumDropped()) + " log messages dropped");
+}
+
+TEST_F(LogTest, KeepsOrderAsTheBufferWraps)
+{
+    auto log = makeLog(200);
+
+    // Messages of varying size, flushed a few at a time, so that records
+    // wrap around the end of the buffer at different places. Whatever isn't
+    // dropped comes out in order.
+    std::vector<std::string> expected;
+    for (int i = 0; i < 300; ++i)
+    {
+        auto text = std::string(size_t(i % 37), char('a' + i % 26));
+        auto nDropped = log->getNumDropped();
+        log->write(Level::Info, "%d %s", i, text);
+        if (log->getNumDropped() == nDropped)
+            { expected.push_back(std::to_string(i) + " " + text); }
+
+        if (i % 3 == 0)
+            { log->flush(2); }
+    }
+    log->flush();
+
+    auto lines = readLines(*log);
+    std::erase_if(lines, [](const std::string& line) { return line.starts_with("WARN: "); });
+    EXPECT_EQ(lines, expected);
+    EXPECT_GT(expected.size(), 100u);
+}
+
+TEST_F(LogTest, TruncatesLongStrings)
+{
+    auto log = makeLog();
+    auto longString = std::string(1000, 'x');
+    log->write(Level::Info, "%s", longString);
+    log->write(Level::Info, "%s%s", longString, longString);
+    log->flush();
+
+    auto lines = readLines(*log);
+    ASSERT_EQ(lines.size(), 2u);
+    EXPECT_EQ(lines[0], std::string(pdcpp::Log::k_MaxStringLength, 'x'));
+    EXPECT_EQ(lines[1].size(), pdcpp::Log::k_MaxLineLength - 1);
+}
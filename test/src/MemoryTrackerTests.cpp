@@ -0,0 +1,77 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#include <cstring>
+#include <pdcpp/core/MemoryTracker.h>
+#include "HostTest.h"
+
+namespace
+{
+    using MemoryTrackerTest = pdcpp::test::HostTest;
+    using pdcpp::MemoryTag;
+    using pdcpp::MemoryTracker;
+
+    MemoryTag g_OverBudget = MemoryTag::NumTags;
+    void onOverBudget(MemoryTag tag, size_t) { g_OverBudget = tag; }
+}
+
+TEST_F(MemoryTrackerTest, AccountsToTags)
+{
+    const auto before = MemoryTracker::getStats(MemoryTag::Audio);
+    auto ptr = MemoryTracker::allocate(100, MemoryTag::Audio);
+    ASSERT_NE(ptr, nullptr);
+    EXPECT_EQ(MemoryTracker::getStats(MemoryTag::Audio).bytesInUse, before.bytesInUse + 100);
+    EXPECT_EQ(MemoryTracker::getStats(MemoryTag::Audio).allocations, before.allocations + 1);
+
+    MemoryTracker::deallocate(ptr);
+    EXPECT_EQ(MemoryTracker::getStats(MemoryTag::Audio).bytesInUse, before.bytesInUse);
+    EXPECT_EQ(MemoryTracker::getStats(MemoryTag::Audio).frees, before.frees + 1);
+}
+
+TEST_F(MemoryTrackerTest, AlignsPastTheDefault)
+{
+    const auto before = MemoryTracker::getStats(MemoryTag::Graphics).bytesInUse;
+    for (size_t alignment : {size_t(64), size_t(256), size_t(4096)})
+    {
+        auto ptr = MemoryTracker::allocate(10, alignment, MemoryTag::Graphics);
+        ASSERT_NE(ptr, nullptr);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % alignment, 0u);
+        std::memset(ptr, 0xab, 10);
+        EXPECT_EQ(MemoryTracker::getStats(MemoryTag::Graphics).bytesInUse, before + 10);
+        MemoryTracker::deallocate(ptr);
+    }
+    EXPECT_EQ(MemoryTracker::getStats(MemoryTag::Graphics).bytesInUse, before);
+}
+
+TEST_F(MemoryTrackerTest, CallsBackOnceOverBudget)
+{
+    g_OverBudget = MemoryTag::NumTags;
+    const auto inUse = MemoryTracker::getStats(MemoryTag::Files).bytesInUse;
+    MemoryTracker::setBudget(MemoryTag::Files, inUse + 150);
+    MemoryTracker::setBudgetCallback(onOverBudget);
+
+    auto first = MemoryTracker::allocate(100, MemoryTag::Files);
+    EXPECT_EQ(g_OverBudget, MemoryTag::NumTags);
+    auto second = MemoryTracker::allocate(100, MemoryTag::Files);
+    EXPECT_EQ(g_OverBudget, MemoryTag::Files);
+    EXPECT_TRUE(MemoryTracker::hasExceededBudget(MemoryTag::Files));
+
+    MemoryTracker::deallocate(first);
+    MemoryTracker::deallocate(second);
+    MemoryTracker::setBudgetCallback(nullptr);
+    MemoryTracker::setBudget(MemoryTag::Files, 0);
+    MemoryTracker::resetStats();
+}
+
+TEST_F(MemoryTrackerTest, AssertsOnForeignPointers)
+{
+    alignas(std::max_align_t) unsigned char foreign[64] {};
+    EXPECT_DEBUG_DEATH(MemoryTracker::deallocate(foreign + 32), "didn't allocate");
+}
@@ -0,0 +1,95 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <pdcpp/core/Profiler.h>
+#include "HostTest.h"
+
+namespace
+{
+    // Every read of the clock moves it on 10us.
+    std::atomic<uint32_t> g_Clock = 0;
+    uint32_t tickingClock() { return g_Clock.fetch_add(10) + 10; }
+
+    class ProfilerTest
+        : public pdcpp::test::HostTest
+    {
+    protected:
+        void SetUp() override
+        {
+            HostTest::SetUp();
+            pdcpp::Profiler::setTimeSource(tickingClock);
+        }
+
+        void TearDown() override
+        {
+            pdcpp::Profiler::setTimeSource(nullptr);
+            HostTest::TearDown();
+        }
+
+        static int findZone(const char* name)
+        {
+            for (int i = 0; i < pdcpp::Profiler::getNumZones(); ++i)
+            {
+                if (std::strcmp(pdcpp::Profiler::getZoneStats(i).name, name) == 0)
+                    { return i; }
+            }
+            return -1;
+        }
+    };
+}
+
+TEST_F(ProfilerTest, CountsNestedZonesOnce)
+{
+    static pdcpp::Profiler::Zone zone("nested");
+    pdcpp::Profiler::endFrame();
+    for (int frame = 0; frame < 3; ++frame)
+    {
+        pdcpp::Profiler::ScopedZone outer(zone);
+        pdcpp::Profiler::ScopedZone inner(zone);
+    }
+    pdcpp::Profiler::endFrame();
+
+    auto stats = pdcpp::Profiler::getZoneStats(findZone("nested"));
+    EXPECT_EQ(stats.avgCalls, 3.0f);
+    EXPECT_EQ(stats.avgUs, 30u);
+    EXPECT_EQ(pdcpp::Profiler::getNumFrames(), 1);
+}
+
+TEST_F(ProfilerTest, CollectsAudioZonesAtTheEndOfTheFrame)
+{
+    pdcpp::Profiler::endFrame();
+
+    // Zones are constructed and recorded on the other thread, as they would
+    // be from an audio callback.
+    std::thread audio([]()
+    {
+        static pdcpp::Profiler::AudioZone zone("audio");
+        for (int i = 0; i < 1000; ++i)
+            { pdcpp::Profiler::ScopedAudioZone scope(zone); }
+    });
+    for (int i = 0; i < 100; ++i)
+        { (void)pdcpp::Profiler::getFrameStats(); }
+    audio.join();
+    EXPECT_EQ(findZone("audio"), -1);
+
+    pdcpp::Profiler::endFrame();
+    auto index = findZone("audio");
+    ASSERT_NE(index, -1);
+    auto stats = pdcpp::Profiler::getZoneStats(index, 1);
+    EXPECT_EQ(stats.avgCalls, 1000.0f);
+    EXPECT_GE(stats.avgUs, 10000u);
+
+    // Collected once, not again the next frame.
+    pdcpp::Profiler::endFrame();
+    EXPECT_EQ(pdcpp::Profiler::getZoneStats(index, 1).avgCalls, 0.0f);
+}
@@ -0,0 +1,102 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#include <algorithm>
+#include <vector>
+#include <pdcpp/core/Registry.h>
+#include "HostTest.h"
+
+namespace
+{
+    using RegistryTest = pdcpp::test::HostTest;
+
+    struct Position { float x, y; };
+    struct Velocity { float dx, dy; };
+}
+
+TEST_F(RegistryTest, AddsAndRemovesComponents)
+{
+    pdcpp::Registry registry;
+    auto e = registry.create();
+    registry.emplace<Position>(e, 1.0f, 2.0f);
+
+    EXPECT_TRUE(registry.has<Position>(e));
+    EXPECT_FALSE(registry.has<Velocity>(e));
+    EXPECT_EQ(registry.get<Position>(e).y, 2.0f);
+    EXPECT_EQ(registry.tryGet<Velocity>(e), nullptr);
+
+    registry.emplace<Position>(e, 3.0f, 4.0f);
+    EXPECT_EQ(registry.get<Position>(e).x, 3.0f);
+    EXPECT_EQ(registry.pool<Position>().size(), 1u);
+
+    EXPECT_TRUE(registry.remove<Position>(e));
+    EXPECT_FALSE(registry.remove<Position>(e));
+    EXPECT_FALSE(registry.has<Position>(e));
+}
+
+TEST_F(RegistryTest, StaleHandlesStayDead)
+{
+    pdcpp::Registry registry;
+    auto first = registry.create();
+    registry.emplace<Position>(first, 1.0f, 1.0f);
+    registry.destroy(first);
+
+    // The index is reused, with a new version.
+    auto second = registry.create();
+    EXPECT_EQ(pdcpp::Registry::indexOf(second), pdcpp::Registry::indexOf(first));
+    EXPECT_NE(second, first);
+
+    EXPECT_FALSE(registry.isAlive(first));
+    EXPECT_TRUE(registry.isAlive(second));
+    EXPECT_FALSE(registry.has<Position>(second));
+    EXPECT_EQ(registry.tryGet<Position>(first), nullptr);
+    EXPECT_FALSE(registry.remove<Position>(first));
+
+    // Destroying the stale handle mustn't touch the new entity.
+    registry.emplace<Position>(second, 2.0f, 2.0f);
+    registry.destroy(first);
+    EXPECT_TRUE(registry.isAlive(second));
+    EXPECT_TRUE(registry.has<Position>(second));
+
+    registry.clear();
+    EXPECT_EQ(registry.size(), 0u);
+    EXPECT_FALSE(registry.isAlive(second));
+    EXPECT_TRUE(registry.pool<Position>().empty());
+}
+
+TEST_F(RegistryTest, ViewsVisitEntitiesWithEveryComponent)
+{
+    pdcpp::Registry registry;
+    std::vector<pdcpp::Entity> moving;
+    for (int i = 0; i < 20; ++i)
+    {
+        auto e = registry.create();
+        registry.emplace<Position>(e, float(i), 0.0f);
+        if (i % 3 == 0)
+        {
+            registry.emplace<Velocity>(e, 1.0f, 2.0f);
+            moving.push_back(e);
+        }
+    }
+
+    std::vector<pdcpp::Entity> visited;
+    registry.view<Position, Velocity>().each([&](pdcpp::Entity e, Position& p, Velocity& v)
+    {
+        p.x += v.dx;
+        p.y += v.dy;
+        visited.push_back(e);
+    });
+
+    std::sort(visited.begin(), visited.end());
+    EXPECT_EQ(visited, moving);
+    for (auto e : moving)
+        { EXPECT_EQ(registry.get<Position>(e).y, 2.0f); }
+    EXPECT_EQ(registry.get<Position>(moving[0] + 1).y, 0.0f);
+}
@@ -0,0 +1,106 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#include <memory>
+#include <string>
+#include <pdcpp/core/ResourceCache.h>
+#include "HostTest.h"
+
+namespace
+{
+    // A stand-in resource, 100 bytes apiece, which fails to load from any
+    // path starting with "missing".
+    struct Blob
+    {
+        std::string path;
+    };
+
+    class ResourceCacheTest
+        : public pdcpp::test::HostTest
+    {
+    protected:
+        static std::unique_ptr<Blob> load(const std::string& path)
+        {
+            ++s_Loads;
+            if (path.rfind("missing", 0) == 0)
+                { return nullptr; }
+            return std::make_unique<Blob>(Blob{path});
+        }
+
+        static size_t size(const Blob&) { return 100; }
+
+        void SetUp() override
+        {
+            HostTest::SetUp();
+            s_Loads = 0;
+        }
+
+        static inline int s_Loads = 0;
+    };
+}
+
+TEST_F(ResourceCacheTest, SharesLoads)
+{
+    pdcpp::ResourceCache<Blob> cache(0, load, size);
+    auto first = cache.get("a");
+    auto second = cache.get("a");
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(s_Loads, 1);
+    EXPECT_EQ(cache.getStats().hits, 1u);
+    EXPECT_EQ(cache.getStats().misses, 1u);
+
+    EXPECT_EQ(cache.get("missing"), nullptr);
+    EXPECT_EQ(cache.getStats().entries, 1u);
+}
+
+TEST_F(ResourceCacheTest, EvictsLeastRecentlyUsedFirst)
+{
+    pdcpp::ResourceCache<Blob> cache(300, load, size);
+    (void)cache.get("a");
+    (void)cache.get("b");
+    (void)cache.get("c");
+    (void)cache.find("a");
+
+    // Over budget, so "b", used longest ago, goes.
+    (void)cache.get("d");
+    EXPECT_EQ(cache.getStats().evictions, 1u);
+    EXPECT_EQ(cache.find("b"), nullptr);
+    EXPECT_NE(cache.find("a"), nullptr);
+    EXPECT_EQ(cache.getStats().bytesCached, 300u);
+}
+
+TEST_F(ResourceCacheTest, KeepsResourcesInUse)
+{
+    pdcpp::ResourceCache<Blob> cache(100, load, size);
+    auto held = cache.get("a");
+    auto other = cache.get("b");
+    EXPECT_EQ(cache.getStats().entries, 2u);
+    EXPECT_EQ(cache.getStats().evictions, 0u);
+
+    other.reset();
+    cache.trim();
+    EXPECT_EQ(cache.getStats().entries, 1u);
+    EXPECT_EQ(cache.find("a"), held);
+
+    held.reset();
+    cache.evictUnused();
+    EXPECT_EQ(cache.getStats().entries, 0u);
+}
+
+TEST_F(ResourceCacheTest, DoesNotCacheNull)
+{
+    pdcpp::ResourceCache<Blob> cache(0, load, size);
+    auto kept = cache.insert("a", std::make_shared<Blob>(Blob{"a"}));
+    EXPECT_EQ(cache.insert("a", nullptr), nullptr);
+    EXPECT_EQ(cache.insert("b", nullptr), nullptr);
+    EXPECT_EQ(cache.find("a"), kept);
+    EXPECT_EQ(cache.getStats().entries, 1u);
+    EXPECT_EQ(cache.getStats().bytesCached, 100u);
+}
@@ -0,0 +1,102 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#include <optional>
+#include <string>
+#include <vector>
+#include <pdcpp/core/Serializer.h>
+#include "HostTest.h"
+
+namespace
+{
+    using SerializerTest = pdcpp::test::HostTest;
+
+    struct Save
+    {
+        int32_t level = 0;
+        std::string name;
+        std::vector<uint16_t> inventory;
+        std::optional<float> bestTime;
+
+        void serialize(pdcpp::Serializer& out) const { out.write(level).write(name).write(inventory).write(bestTime); }
+
+        void deserialize(pdcpp::Deserializer& in)
+        {
+            in.read(level);
+            in.read(name);
+            in.readSince(2, inventory);
+            in.readSince(2, bestTime);
+        }
+
+        bool operator==(const Save&) const = default;
+    };
+
+    Save makeSave() { return {7, "Ada", {1, 2, 300}, 12.5f}; }
+}
+
+TEST_F(SerializerTest, RoundTripsInMemory)
+{
+    pdcpp::Serializer out(2);
+    out.write(makeSave());
+
+    pdcpp::Deserializer in(out.finish());
+    Save save;
+    in.read(save);
+    EXPECT_FALSE(in.hasFailed());
+    EXPECT_EQ(in.getVersion(), 2u);
+    EXPECT_EQ(save, makeSave());
+}
+
+TEST_F(SerializerTest, ReadsOlderVersions)
+{
+    pdcpp::Serializer out(1);
+    out.write(int32_t(3)).write(std::string("Old"));
+
+    pdcpp::Deserializer in(out.finish());
+    Save save;
+    save.inventory = {9};
+    in.read(save);
+    EXPECT_FALSE(in.hasFailed());
+    EXPECT_EQ(save.level, 3);
+    EXPECT_EQ(save.name, "Old");
+    EXPECT_EQ(save.inventory, std::vector<uint16_t>{9});
+}
+
+TEST_F(SerializerTest, FailsOnCorruptData)
+{
+    pdcpp::Serializer out(2);
+    out.write(makeSave());
+    auto data = out.finish();
+    data.back() ^= 0xff;
+
+    pdcpp::Deserializer in(data);
+    Save save;
+    in.read(save);
+    EXPECT_TRUE(in.hasFailed());
+    EXPECT_EQ(save, Save());
+}
+
+TEST_F(SerializerTest, SavesAndLoadsFiles)
+{
+    pdcpp::Serializer out(2);
+    out.write(makeSave());
+    ASSERT_TRUE(out.saveToFile("save.bin"));
+
+    auto in = pdcpp::Deserializer::fromFile("save.bin");
+    Save save;
+    in.read(save);
+    EXPECT_FALSE(in.hasFailed());
+    EXPECT_EQ(save, makeSave());
+
+    // No save yet fails quietly.
+    auto missing = pdcpp::Deserializer::fromFile("nothing.bin");
+    EXPECT_TRUE(missing.hasFailed());
+    EXPECT_EQ(m_Host.getErrorCount(), 0);
+}
@@ -0,0 +1,97 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#include <map>
+#include <pdcpp/core/SparseMap.h>
+#include "HostTest.h"
+
+namespace
+{
+    using SparseMapTest = pdcpp::test::HostTest;
+}
+
+TEST_F(SparseMapTest, InsertsFindsAndErases)
+{
+    pdcpp::SparseMap<uint32_t, int> map;
+    map.emplace(3, 30);
+    map.emplace(100000, 1);
+    map.emplace(7, 70);
+    map.emplace(3, 33);
+
+    EXPECT_EQ(map.size(), 3u);
+    EXPECT_EQ(map.get(3), 33);
+    ASSERT_NE(map.find(100000), nullptr);
+    EXPECT_EQ(map.find(4), nullptr);
+
+    // Erasing moves the last value into the hole, which mustn't lose it.
+    EXPECT_TRUE(map.erase(3));
+    EXPECT_FALSE(map.erase(3));
+    EXPECT_FALSE(map.has(3));
+    EXPECT_EQ(map.get(7), 70);
+    EXPECT_EQ(map.get(100000), 1);
+    EXPECT_EQ(map.size(), 2u);
+}
+
+TEST_F(SparseMapTest, MatchesAStdMap)
+{
+    pdcpp::SparseMap<uint16_t, uint32_t> map;
+    std::map<uint16_t, uint32_t> expected;
+    uint32_t state = 1;
+    for (int i = 0; i < 20000; ++i)
+    {
+        state = state * 1664525u + 1013904223u;
+        auto key = uint16_t(state >> 20);
+        if ((state & 3) == 0)
+        {
+            EXPECT_EQ(map.erase(key), expected.erase(key) == 1);
+        }
+        else
+        {
+            map.insert(key, state);
+            expected[key] = state;
+        }
+    }
+
+    ASSERT_EQ(map.size(), expected.size());
+    for (auto [key, value] : expected)
+        { EXPECT_EQ(map.get(key), value); }
+}
+
+TEST_F(SparseMapTest, FreesEmptyPages)
+{
+    pdcpp::SparseMap<uint32_t, int> map;
+    map.emplace(1, 1);
+    map.emplace(1000000, 2);
+    EXPECT_EQ(map.allocatedPages(), 2u);
+
+    map.erase(1000000);
+    EXPECT_EQ(map.allocatedPages(), 1u);
+    map.clear();
+    EXPECT_EQ(map.allocatedPages(), 0u);
+    EXPECT_TRUE(map.empty());
+}
+
+TEST_F(SparseMapTest, IntersectsMaps)
+{
+    pdcpp::SparseMap<uint32_t, int> positions;
+    pdcpp::SparseMap<uint32_t, int> velocities;
+    for (uint32_t i = 0; i < 10; ++i)
+        { positions.emplace(i, 0); }
+    velocities.emplace(2, 5);
+    velocities.emplace(8, -1);
+    velocities.emplace(50, 9);
+
+    int visited = 0;
+    pdcpp::intersect([&](uint32_t, int& p, int& v) { p += v; ++visited; }, positions, velocities);
+    EXPECT_EQ(visited, 2);
+    EXPECT_EQ(positions.get(2), 5);
+    EXPECT_EQ(positions.get(8), -1);
+    EXPECT_EQ(positions.get(3), 0);
+}
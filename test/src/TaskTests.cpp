@@ -0,0 +1,173 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#include <string>
+#include <pdcpp/core/Task.h>
+#include "HostTest.h"
+
+namespace
+{
+    using TaskTest = pdcpp::test::HostTest;
+
+    pdcpp::Task countFrames(int& count, int frames)
+    {
+        for (int i = 0; i < frames; ++i)
+        {
+            ++count;
+            co_await pdcpp::nextFrame();
+        }
+    }
+
+    pdcpp::Task waitThenSet(bool& flag, uint32_t delayMs)
+    {
+        co_await pdcpp::waitMs(delayMs);
+        flag = true;
+    }
+
+    // Each step takes 3ms of the host's manual clock.
+    pdcpp::Task work(pdcpp::HostPlaydateAPI& host, std::string& log, char id, int steps)
+    {
+        for (int i = 0; i < steps; ++i)
+        {
+            log += id;
+            host.advanceTime(3);
+            co_await pdcpp::yieldIfOverBudget();
+        }
+    }
+
+    pdcpp::Task append(std::string& log, std::string text)
+    {
+        log += text;
+        co_await pdcpp::nextFrame();
+        log += text;
+    }
+
+    pdcpp::Task awaitBoth(std::string& log)
+    {
+        co_await append(log, "a");
+        co_await append(log, "b");
+        log += "!";
+    }
+
+    // Counts how many are alive, to see that cancelled tasks are destroyed.
+    struct Tracked
+    {
+        explicit Tracked(int& alive) : r_Alive(alive) { ++r_Alive; }
+        ~Tracked() { --r_Alive; }
+        int& r_Alive;
+    };
+
+    pdcpp::Task holdForever(int& alive)
+    {
+        Tracked tracked(alive);
+        while (true)
+            { co_await pdcpp::nextFrame(); }
+    }
+}
+
+TEST_F(TaskTest, RunsAPieceEachFrame)
+{
+    pdcpp::TaskScheduler scheduler;
+    int count = 0;
+    scheduler.spawn(countFrames(count, 3));
+    EXPECT_EQ(count, 0);
+
+    for (int frame = 1; frame <= 3; ++frame)
+    {
+        scheduler.update();
+        EXPECT_EQ(count, frame);
+    }
+
+    EXPECT_EQ(scheduler.getNumTasks(), 1u);
+    scheduler.update();
+    EXPECT_EQ(scheduler.getNumTasks(), 0u);
+}
+
+TEST_F(TaskTest, WaitsForTheDelay)
+{
+    pdcpp::TaskScheduler scheduler;
+    bool done = false;
+    scheduler.spawn(waitThenSet(done, 100));
+
+    scheduler.update();
+    m_Host.advanceTime(50);
+    scheduler.update();
+    EXPECT_FALSE(done);
+
+    m_Host.advanceTime(60);
+    scheduler.update();
+    EXPECT_TRUE(done);
+    EXPECT_EQ(scheduler.getNumTasks(), 0u);
+}
+
+TEST_F(TaskTest, TakesTurnsWithinTheBudget)
+{
+    pdcpp::TaskScheduler scheduler(4.0f);
+    std::string log;
+    scheduler.spawn(work(m_Host, log, 'A', 4));
+    scheduler.spawn(work(m_Host, log, 'B', 4));
+
+    // Two 3ms steps spend a 4ms budget, and the other task goes first next
+    // frame.
+    scheduler.update();
+    EXPECT_EQ(log, "AA");
+    scheduler.update();
+    EXPECT_EQ(log, "AABB");
+
+    for (int i = 0; i < 10 && scheduler.getNumTasks() > 0; ++i)
+        { scheduler.update(); }
+    EXPECT_EQ(scheduler.getNumTasks(), 0u);
+    EXPECT_EQ(log.size(), 8u);
+}
+
+TEST_F(TaskTest, AlwaysRunsOneTask)
+{
+    pdcpp::TaskScheduler scheduler(0.0f);
+    std::string log;
+    scheduler.spawn(work(m_Host, log, 'A', 2));
+
+    scheduler.update();
+    EXPECT_EQ(log, "A");
+    scheduler.update();
+    EXPECT_EQ(log, "AA");
+}
+
+TEST_F(TaskTest, AwaitsOtherTasksToTheEnd)
+{
+    pdcpp::TaskScheduler scheduler;
+    std::string log;
+    scheduler.spawn(awaitBoth(log));
+
+    for (int i = 0; i < 5; ++i)
+        { scheduler.update(); }
+    EXPECT_EQ(log, "aabb!");
+    EXPECT_EQ(scheduler.getNumTasks(), 0u);
+}
+
+TEST_F(TaskTest, CancellingDestroysTasks)
+{
+    int alive = 0;
+    {
+        pdcpp::TaskScheduler scheduler;
+        scheduler.spawn(holdForever(alive));
+        scheduler.spawn(holdForever(alive));
+        scheduler.update();
+        EXPECT_EQ(alive, 2);
+
+        scheduler.cancelAll();
+        EXPECT_EQ(alive, 0);
+        EXPECT_EQ(scheduler.getNumTasks(), 0u);
+
+        scheduler.spawn(holdForever(alive));
+        scheduler.update();
+        EXPECT_EQ(alive, 1);
+    }
+    EXPECT_EQ(alive, 0);
+}
@@ -0,0 +1,147 @@
+/**
+ *  This file is part of the Playdate CPP Extensions library, and covered under
+ *  the license terms found in the LICENSE file at the root of the repository.
+ *
+ *  Copyright (c) 2023 - Metaphase
+ *
+ *  Created: 10/17/2026
+ *  Original author: MrBZapp
+ */
+
+#include <memory>
+#include <type_traits>
+#include <pdcpp/core/Timer.h>
+#include <pdcpp/core/TimerService.h>
+#include "HostTest.h"
+
+namespace
+{
+    // Timers read the host's manual clock, which only moves when told to.
+    class TimerServiceTest
+        : public pdcpp::test::HostTest
+    {
+    protected:
+        void advance(uint32_t ms)
+        {
+            m_Host.advanceTime(ms);
+            p_Timers->update();
+        }
+
+        void SetUp() override
+        {
+            HostTest::SetUp();
+            p_Timers = std::make_unique<pdcpp::TimerService>();
+        }
+
+        void TearDown() override
+        {
+            p_Timers.reset();
+            HostTest::TearDown();
+        }
+
+        std::unique_ptr<pdcpp::TimerService> p_Timers;
+    };
+
+    class CountingTimer
+        : public pdcpp::Timer
+    {
+    public:
+        CountingTimer() : pdcpp::Timer(100) {}
+        int fired = 0;
+
+    protected:
+        void timerCallback() override { ++fired; }
+    };
+
+    // The service calls back into the timer where it was scheduled.
+    static_assert(!std::is_copy_constructible_v<pdcpp::Timer> && !std::is_move_constructible_v<pdcpp::Timer>);
+    static_assert(!std::is_copy_constructible_v<pdcpp::FrameTimer> && !std::is_move_constructible_v<pdcpp::FrameTimer>);
+}
+
+TEST_F(TimerServiceTest, FiresOnceAfterTheDelay)
+{
+    int fired = 0;
+    auto handle = p_Timers->after(100, [&]() { ++fired; });
+    EXPECT_TRUE(handle.isPending());
+
+    advance(50);
+    EXPECT_EQ(fired, 0);
+    advance(60);
+    EXPECT_EQ(fired, 1);
+    advance(500);
+    EXPECT_EQ(fired, 1);
+    EXPECT_FALSE(handle.isPending());
+    EXPECT_EQ(p_Timers->getNumPending(), 0u);
+}
+
+TEST_F(TimerServiceTest, RepeatsWithoutCatchingUp)
+{
+    int fired = 0;
+    auto handle = p_Timers->every(100, [&]() { ++fired; });
+
+    for (int i = 0; i < 3; ++i)
+        { advance(100); }
+    EXPECT_EQ(fired, 3);
+
+    // Ten periods late is still only one call.
+    advance(1000);
+    EXPECT_EQ(fired, 4);
+    EXPECT_TRUE(handle.isPending());
+
+    handle.cancel();
+    advance(100);
+    EXPECT_EQ(fired, 4);
+    EXPECT_FALSE(handle.isPending());
+}
+
+TEST_F(TimerServiceTest, CountsFrames)
+{
+    int once = 0;
+    int repeating = 0;
+    p_Timers->afterFrames(3, [&]() { ++once; });
+    p_Timers->everyFrames(2, [&]() { ++repeating; });
+
+    for (int i = 0; i < 2; ++i)
+        { p_Timers->update(); }
+    EXPECT_EQ(once, 0);
+    EXPECT_EQ(repeating, 1);
+
+    for (int i = 0; i < 4; ++i)
+        { p_Timers->update(); }
+    EXPECT_EQ(once, 1);
+    EXPECT_EQ(repeating, 3);
+}
+
+TEST_F(TimerServiceTest, CancelsFromItsOwnCallback)
+{
+    int fired = 0;
+    pdcpp::TimerHandle handle;
+    handle = p_Timers->everyFrames(1, [&]()
+    {
+        if (++fired == 2)
+            { handle.cancel(); }
+    });
+
+    for (int i = 0; i < 5; ++i)
+        { p_Timers->update(); }
+    EXPECT_EQ(fired, 2);
+    EXPECT_FALSE(handle.isPending());
+
+    p_Timers->after(10, []() {});
+    p_Timers->cancelAll();
+    EXPECT_EQ(p_Timers->getNumPending(), 0u);
+}
+
+TEST_F(TimerServiceTest, DrivesTimers)
+{
+    auto timer = std::make_unique<CountingTimer>();
+    timer->useService(*p_Timers);
+    advance(100);
+    advance(100);
+    EXPECT_EQ(timer->fired, 2);
+
+    // Destroying the timer takes it out of the service.
+    timer.reset();
+    EXPECT_EQ(p_Timers->getNumPending(), 0u);
+    advance(100);
+}